@@ -5,7 +5,9 @@
 #include <chrono>
 #include <memory>
 #include <functional>
+#include <random>
 #include <spdlog/spdlog.h>
+#include "game/systems/scheduling/parallel_iteration.h"
 
 namespace mmorpg::game::combat {
 
@@ -156,7 +158,7 @@ public:
             
             // Check spread
             if (effect_.spread_type == DotSpreadType::ON_DAMAGE) {
-                float roll = static_cast<float>(rand() % 100);
+                float roll = static_cast<float>(RollPercent());
                 if (roll < effect_.spread_chance) {
                     result.should_spread = true;
                 }
@@ -168,16 +170,20 @@ public:
             remaining_ticks_--;
             total_damage_ += result.damage;
             tick_count_++;
-            
-            // Callback
-            if (effect_.on_tick_callback) {
-                effect_.on_tick_callback(target_id_);
-            }
         }
         
         return result;
     }
     
+    // [SEQUENCE: MVP19-429] Run by the owner of the effect's callbacks after a tick, not by ProcessTick,
+    // so ticking can run off the thread those callbacks expect
+    bool HasTickCallback() const { return static_cast<bool>(effect_.on_tick_callback); }
+    void RunTickCallback() const {
+        if (effect_.on_tick_callback) {
+            effect_.on_tick_callback(target_id_);
+        }
+    }
+    
     // [SEQUENCE: 1793] Refresh DoT (for pandemic mechanics)
     void Refresh(float new_sp = -1, float new_ap = -1) {
         auto now = std::chrono::system_clock::now();
@@ -310,7 +316,13 @@ private:
     bool RollCrit() {
         // TODO: Get actual crit chance
         float crit_chance = 20.0f;
-        return (rand() % 100) < crit_chance;
+        return RollPercent() < crit_chance;
+    }
+    
+    // [SEQUENCE: MVP19-394] 0-99 from a per-thread generator; DoTs tick on several threads at once
+    static int RollPercent() {
+        thread_local std::minstd_rand rng(std::random_device{}());
+        return static_cast<int>(rng() % 100);
     }
     
     float GetCritMultiplier() {
@@ -373,8 +385,10 @@ public:
         float total_damage = 0.0f;
         std::vector<uint64_t> expired_dots;
         std::vector<std::pair<uint32_t, uint64_t>> spread_targets;  // effect_id, source_id
+        std::vector<uint64_t> ticked_dots;  // Ticked DoTs with a tick callback, for RunTickCallbacks
     };
     
+    // Ticks every DoT without running their callbacks; pass the result to RunTickCallbacks for that
     ProcessResult ProcessDots() {
         ProcessResult result;
         
@@ -383,6 +397,9 @@ public:
             
             if (tick_result.should_tick) {
                 result.total_damage += tick_result.damage;
+                if (dot->HasTickCallback()) {
+                    result.ticked_dots.push_back(id);
+                }
                 
                 if (tick_result.should_spread) {
                     result.spread_targets.emplace_back(
@@ -404,6 +421,17 @@ public:
         return result;
     }
     
+    // [SEQUENCE: MVP19-430] Runs the tick callbacks of the DoTs a ProcessDots call ticked. A DoT that ticked
+    // has not expired in the same call, so each is still active unless removed since.
+    void RunTickCallbacks(const ProcessResult& result) const {
+        for (uint64_t id : result.ticked_dots) {
+            auto it = active_dots_.find(id);
+            if (it != active_dots_.end()) {
+                it->second->RunTickCallback();
+            }
+        }
+    }
+    
     // [SEQUENCE: 1801] Remove specific DoT
     void RemoveDot(uint64_t instance_id) {
         auto it = active_dots_.find(instance_id);
@@ -448,6 +476,8 @@ public:
         return dots;
     }
     
+    size_t GetActiveDotCount() const { return active_dots_.size(); }
+    
     bool HasDot(uint32_t effect_id) const {
         return std::any_of(active_dots_.begin(), active_dots_.end(),
             [effect_id](const auto& pair) {
@@ -525,6 +555,7 @@ public:
         if (it == entity_managers_.end()) {
             auto manager = std::make_shared<DotManager>(entity_id);
             entity_managers_[entity_id] = manager;
+            managers_changed_ = true;
             return manager;
         }
         return it->second;
@@ -536,11 +567,30 @@ public:
         return (it != dot_effects_.end()) ? &it->second : nullptr;
     }
     
+    // [SEQUENCE: MVP19-395] Pool entities' DoTs tick on; unset ticks them on the calling thread. Effect
+    // callbacks always run on the thread calling ProcessAll, after the pool has finished ticking.
+    void SetThreadPool(systems::scheduling::WorkStealingPool* pool) { pool_ = pool; }
+    
     // [SEQUENCE: 1810] Process all DoTs
     void ProcessAll() {
-        for (auto& [entity_id, manager] : entity_managers_) {
-            auto result = manager->ProcessDots();
-            
+        // [SEQUENCE: MVP19-396] Entities tick in chunks across the pool, over a dense list of their managers
+        // kept in step with the map; applying the results, tick callbacks included, stays on the calling thread.
+        // Managers are reached through pointers and own their DoTs in a map, so there is no contiguous per-entity
+        // footprint to size chunks by; a fixed count keeps each task long enough to pay for its scheduling.
+        if (managers_changed_) {
+            managers_.clear();
+            for (auto& [entity_id, manager] : entity_managers_) managers_.push_back(manager.get());
+            managers_changed_ = false;
+        }
+        results_.resize(managers_.size());
+        constexpr size_t kChunkSize = 64;
+        systems::scheduling::ParallelForChunks(pool_, managers_.size(), kChunkSize, [this](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) results_[i] = managers_[i]->ProcessDots();
+        });
+        
+        for (size_t i = 0; i < results_.size(); ++i) {
+            const auto& result = results_[i];
+            managers_[i]->RunTickCallbacks(result);
             if (result.total_damage > 0) {
                 // TODO: Apply damage through combat system
             }
@@ -552,9 +602,11 @@ public:
         }
         
         // Clean up empty managers
-        std::erase_if(entity_managers_, [](const auto& pair) {
-            return pair.second->GetActiveDots().empty();
-        });
+        if (std::erase_if(entity_managers_, [](const auto& pair) {
+                return pair.second->GetActiveDotCount() == 0;
+            }) > 0) {
+            managers_changed_ = true;
+        }
     }
     
 private:
@@ -562,6 +614,10 @@ private:
     
     std::unordered_map<uint32_t, DotEffect> dot_effects_;
     std::unordered_map<uint64_t, std::shared_ptr<DotManager>> entity_managers_;
+    systems::scheduling::WorkStealingPool* pool_ = nullptr;
+    std::vector<DotManager*> managers_;              // entity_managers_'s values, for chunked ticking
+    std::vector<DotManager::ProcessResult> results_;
+    bool managers_changed_ = true;
     
     // [SEQUENCE: 1811] Load effect definitions
     void LoadDotEffects() {
@@ -24,6 +24,8 @@ struct NetworkComponent {
     // Prediction/interpolation
     uint32_t last_acknowledged_input = 0;
     float interpolation_buffer = 0.1f; // 100ms buffer
+    // [SEQUENCE: MVP19-438] Server receive time of the last movement input applied to the entity
+    std::chrono::steady_clock::time_point last_input_time{};
     
     // [SEQUENCE: 2] Mark for update
     void MarkDirty() {
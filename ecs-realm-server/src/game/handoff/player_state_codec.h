@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "core/ecs/types.h"
+#include "game/components/combat_stats_component.h"
+#include "game/components/health_component.h"
+#include "game/components/transform_component.h"
+
+namespace mmorpg::game::handoff {
+
+// [SEQUENCE: MVP19-317] Serializes the components of one player entity for a live handoff to another server
+// process (network::SessionHandoffService), and recreates them there on a fresh entity.
+//
+// Layout: magic, component count, then per component its registered id, byte size and bytes. Ids are part of
+// the wire format and must never be reused. A receiver skips ids it does not know, so a node running a newer
+// build can hand players to an older one. Plain data components are copied bytewise, which assumes every node
+// runs on the same architecture; components holding pointers, containers or clock readings register their
+// own save and load functions.
+//
+// Works with any World that offers GetComponent<T> (returning a pointer, null when absent) and AddComponent<T>.
+template <typename World>
+class PlayerStateCodec {
+public:
+    using EntityId = core::ecs::EntityId;
+    using SaveFn = std::function<bool(World& world, EntityId entity, std::string& out)>;
+    using LoadFn = std::function<bool(World& world, EntityId entity, std::string_view bytes)>;
+
+    static constexpr uint32_t kMagic = 0x50534331;   // "PSC1"
+
+    template <typename T>
+    void RegisterComponent(uint16_t id) {
+        static_assert(std::is_trivially_copyable_v<T>, "register a save/load pair for non-trivial components");
+        RegisterComponent(
+            id,
+            [](World& world, EntityId entity, std::string& out) {
+                const T* component = world.template GetComponent<T>(entity);
+                if (!component) return false;
+                out.append(reinterpret_cast<const char*>(component), sizeof(T));
+                return true;
+            },
+            [](World& world, EntityId entity, std::string_view bytes) {
+                if (bytes.size() != sizeof(T)) return false;
+                T component;
+                std::memcpy(&component, bytes.data(), sizeof(T));
+                world.template AddComponent<T>(entity, component);
+                return true;
+            },
+            sizeof(T));
+    }
+
+    // fixed_size, when known, lets Decode reject a wrongly sized component before adding anything
+    void RegisterComponent(uint16_t id, SaveFn save, LoadFn load, size_t fixed_size = 0) {
+        m_components.push_back(Codec{id, fixed_size, std::move(save), std::move(load)});
+    }
+
+    // The player's registered components; ones the entity lacks are left out
+    std::string Encode(World& world, EntityId entity) const {
+        std::string out;
+        AppendRaw(out, kMagic);
+        AppendRaw(out, uint16_t{0});
+        uint16_t count = 0;
+        std::string bytes;
+        for (const Codec& codec : m_components) {
+            bytes.clear();
+            if (!codec.save(world, entity, bytes)) continue;
+            AppendRaw(out, codec.id);
+            AppendRaw(out, static_cast<uint32_t>(bytes.size()));
+            out.append(bytes);
+            ++count;
+        }
+        std::memcpy(out.data() + sizeof(kMagic), &count, sizeof(count));
+        return out;
+    }
+
+    // Adds the encoded components to entity. The whole state is validated before anything is added, so a
+    // malformed state leaves the entity untouched.
+    bool Decode(World& world, EntityId entity, std::string_view state) const {
+        struct Item {
+            const Codec* codec;
+            std::string_view bytes;
+        };
+        std::vector<Item> items;
+        size_t offset = 0;
+        uint32_t magic = 0;
+        uint16_t count = 0;
+        if (!ReadRaw(state, offset, magic) || magic != kMagic || !ReadRaw(state, offset, count)) return false;
+        for (uint16_t i = 0; i < count; ++i) {
+            uint16_t id = 0;
+            uint32_t size = 0;
+            if (!ReadRaw(state, offset, id) || !ReadRaw(state, offset, size) || state.size() - offset < size) {
+                return false;
+            }
+            const std::string_view bytes = state.substr(offset, size);
+            offset += size;
+            for (const Codec& codec : m_components) {
+                if (codec.id == id) {
+                    if (codec.fixed_size != 0 && codec.fixed_size != size) return false;
+                    items.push_back(Item{&codec, bytes});
+                    break;
+                }
+            }
+        }
+        if (offset != state.size()) return false;
+        for (const Item& item : items) {
+            if (!item.codec->load(world, entity, item.bytes)) return false;
+        }
+        return true;
+    }
+
+private:
+    struct Codec {
+        uint16_t id;
+        size_t fixed_size;
+        SaveFn save;
+        LoadFn load;
+    };
+
+    template <typename T>
+    static void AppendRaw(std::string& out, T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    static bool ReadRaw(std::string_view in, size_t& offset, T& value) {
+        if (in.size() - offset < sizeof(T)) return false;
+        std::memcpy(&value, in.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    std::vector<Codec> m_components;
+};
+
+// [SEQUENCE: MVP19-318] The components every game server hands off: position, motion, health and combat stats.
+// Ids 1-99 are reserved for this set.
+template <typename World>
+PlayerStateCodec<World> MakeDefaultPlayerStateCodec() {
+    PlayerStateCodec<World> codec;
+    codec.template RegisterComponent<components::TransformComponent>(1);
+    codec.template RegisterComponent<components::VelocityComponent>(2);
+    codec.template RegisterComponent<components::HealthComponent>(3);
+    codec.template RegisterComponent<components::CombatStatsComponent>(4);
+    return codec;
+}
+
+} // namespace mmorpg::game::handoff
@@ -13,6 +13,16 @@ namespace mmorpg::game::systems::combat {
 ActionCombatSystem::ActionCombatSystem() = default;
 ActionCombatSystem::~ActionCombatSystem() = default;
 
+// [SEQUENCE: MVP19-379] Moves projectiles, damages what they hit through the spatial grid and advances dodges.
+// Spent projectiles are destroyed during the update, so it is ordered against every other system.
+scheduling::SystemAccess ActionCombatSystem::GetComponentAccess() const {
+    return scheduling::SystemAccess()
+        .Reads<components::CombatStatsComponent, world::grid::WorldGrid>()
+        .Writes<components::TransformComponent, components::ProjectileComponent, components::HealthComponent,
+                components::DodgeComponent>()
+        .ChangesEntities();
+}
+
 // [SEQUENCE: MVP4-35] Implements the main update loop for the action combat system.
 void ActionCombatSystem::Update(float delta_time) {
     if (!m_world) return;
@@ -38,6 +48,8 @@ void ActionCombatSystem::UpdateProjectiles(float delta_time) {
     if (!m_world) return;
 
     std::vector<core::ecs::EntityId> to_remove;
+    projectile_entities_.clear();
+    projectile_queries_.clear();
 
     for (auto entity : m_world->GetEntitiesWith<components::ProjectileComponent, components::TransformComponent>()) {
         auto& proj = m_world->GetComponent<components::ProjectileComponent>(entity);
@@ -55,7 +67,20 @@ void ActionCombatSystem::UpdateProjectiles(float delta_time) {
             continue;
         }
 
-        CheckProjectileCollisions(entity, proj, transform.position);
+        uint64_t hit_key = (static_cast<uint64_t>(entity) << 32) | proj.skill_id;
+        if (hit_records_.find(hit_key) == hit_records_.end()) continue;
+        projectile_entities_.push_back(entity);
+        projectile_queries_.push_back({transform.position, proj.radius + config_.hitbox_padding});
+    }
+
+    // [SEQUENCE: MVP19-365] One batched spatial query for every live projectile, then the per-projectile hits
+    if (spatial_system_ && !projectile_queries_.empty()) {
+        spatial_system_->GetEntitiesInRadiusBatch(projectile_queries_, projectile_hits_);
+        for (size_t i = 0; i < projectile_entities_.size(); ++i) {
+            const auto entity = projectile_entities_[i];
+            CheckProjectileCollisions(entity, m_world->GetComponent<components::ProjectileComponent>(entity),
+                                      projectile_hits_[i]);
+        }
     }
 
     for (auto id : to_remove) {
@@ -66,17 +91,13 @@ void ActionCombatSystem::UpdateProjectiles(float delta_time) {
 // [SEQUENCE: MVP4-37] Checks for collisions between a projectile and other entities.
 void ActionCombatSystem::CheckProjectileCollisions(core::ecs::EntityId projectile,
                                                   const components::ProjectileComponent& proj,
-                                                  const core::utils::Vector3& position) {
-    if (!spatial_system_) return;
-
+                                                  std::span<const core::ecs::EntityId> nearby) {
     if (!m_world) return;
 
     uint64_t hit_key = (static_cast<uint64_t>(projectile) << 32) | proj.skill_id;
     auto hit_it = hit_records_.find(hit_key);
     if (hit_it == hit_records_.end()) return;
 
-    auto nearby = spatial_system_->GetEntitiesInRadius(position, proj.radius + config_.hitbox_padding);
-
     auto& owner_stats = m_world->GetComponent<components::CombatStatsComponent>(proj.owner);
 
     for (auto entity : nearby) {
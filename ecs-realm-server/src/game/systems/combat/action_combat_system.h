@@ -9,7 +9,9 @@
 #include "game/components/dodge_component.h"
 #include "core/utils/vector3.h"
 #include "game/systems/grid_spatial_system.h"
+#include "game/systems/scheduling/system_access.h"
 #include <memory>
+#include <span>
 #include <unordered_set>
 
 namespace mmorpg::game::systems::combat {
@@ -23,6 +25,9 @@ public:
     // [SEQUENCE: MVP4-31] Public API for managing action combat, skills, and movement.
     void Update(float delta_time) override;
     void SetSpatialSystem(mmorpg::game::systems::GridSpatialSystem* system) { spatial_system_ = system; }
+
+    // [SEQUENCE: MVP19-379] Component access for the system scheduler
+    scheduling::SystemAccess GetComponentAccess() const;
     
     bool UseSkillshot(core::ecs::EntityId caster, uint32_t skill_id,
                      const core::utils::Vector3& direction);
@@ -64,7 +69,7 @@ private:
     void UpdateProjectiles(float delta_time);
     void CheckProjectileCollisions(core::ecs::EntityId projectile,
                                   const components::ProjectileComponent& proj,
-                                  const core::utils::Vector3& position);
+                                  std::span<const core::ecs::EntityId> nearby);
     
     void ProcessSkillCasts(float delta_time);
     void ProcessSkillCooldowns(float delta_time);
@@ -98,6 +103,11 @@ private:
         std::chrono::steady_clock::time_point expire_time;
     };
     std::unordered_map<uint64_t, HitRecord> hit_records_;
+
+    // Per-tick projectile query batch, reused across ticks
+    std::vector<core::ecs::EntityId> projectile_entities_;
+    std::vector<world::RadiusQuery> projectile_queries_;
+    world::SpatialQueryResults projectile_hits_;
 };
 
 } // namespace mmorpg::game::systems::combat
\ No newline at end of file
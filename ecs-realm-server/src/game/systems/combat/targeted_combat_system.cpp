@@ -262,19 +262,25 @@ void TargetedCombatSystem::ProcessSkillCasts(float) {}
 void TargetedCombatSystem::ProcessSkillCooldowns(float delta_time) {
     if (!m_world) return;
 
-    for (auto& entity : m_entities) {
-        if (!m_world->HasComponent<components::SkillComponent>(entity)) continue;
-        auto& skill_comp = m_world->GetComponent<components::SkillComponent>(entity);
-        for (auto& it : skill_comp.skills) {
-            auto& skill = it.second;
-            if (skill.on_cooldown) {
-                skill.cooldown_timer -= delta_time;
-                if (skill.cooldown_timer <= 0) {
-                    skill.on_cooldown = false;
+    // [SEQUENCE: MVP19-393] The dense skill array in cache-sized chunks across the pool, rather than a lookup per
+    // system entity; every entity with skills ticks, whether or not it has a target.
+    auto* skill_array = m_world->GetComponentArray<components::SkillComponent>();
+    if (!skill_array) return;
+    auto* skill_comps = skill_array->GetDataArray();
+    constexpr size_t kChunkSize = scheduling::ChunkSize<components::SkillComponent>();
+    scheduling::ParallelForChunks(pool_, skill_array->GetSize(), kChunkSize, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            for (auto& it : skill_comps[i].skills) {
+                auto& skill = it.second;
+                if (skill.on_cooldown) {
+                    skill.cooldown_timer -= delta_time;
+                    if (skill.cooldown_timer <= 0) {
+                        skill.on_cooldown = false;
+                    }
                 }
             }
         }
-    }
+    });
 }
 
 // [SEQUENCE: MVP4-26] Placeholder for updating target validation.
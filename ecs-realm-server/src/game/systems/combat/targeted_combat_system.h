@@ -7,6 +7,7 @@
 #include "game/components/target_component.h"
 #include "game/components/transform_component.h"
 #include "game/systems/grid_spatial_system.h"
+#include "game/systems/scheduling/parallel_iteration.h"
 #include <memory>
 #include <unordered_set>
 
@@ -21,6 +22,8 @@ public:
     // [SEQUENCE: MVP4-8] Public API for managing combat state, skills, and targets.
     void Update(float delta_time) override;
     void SetSpatialSystem(mmorpg::game::systems::GridSpatialSystem* system) { spatial_system_ = system; }
+    // [SEQUENCE: MVP19-392] Pool cooldowns tick on; unset ticks them on the calling thread
+    void SetThreadPool(scheduling::WorkStealingPool* pool) { pool_ = pool; }
     
     bool SetTarget(core::ecs::EntityId attacker, core::ecs::EntityId target);
     bool ClearTarget(core::ecs::EntityId attacker);
@@ -60,6 +63,7 @@ private:
 
     // [SEQUENCE: MVP4-10] Private member variables for system state and configuration.
     class GridSpatialSystem* spatial_system_ = nullptr;
+    scheduling::WorkStealingPool* pool_ = nullptr;
     
     struct CombatConfig {
         float target_validation_interval = 0.5f;
@@ -16,12 +16,22 @@ GridSpatialSystem::GridSpatialSystem() {
     config.wrap_around = false;
     
     world_grid_ = std::make_unique<world::grid::WorldGrid>(config);
+    interest_manager_ = std::make_unique<world::grid::InterestManager>(
+        *world_grid_, world::grid::InterestManager::Config{});
 }
 
 // [SEQUENCE: MVP3-76] Implements the system lifecycle methods (currently empty).
 void GridSpatialSystem::OnSystemInit() {}
 void GridSpatialSystem::OnSystemShutdown() {}
 
+// [SEQUENCE: MVP19-378] OnEntityCreated and OnEntityDestroyed also write the grid, but run from the world's
+// entity changes, which the systems making them declare.
+scheduling::SystemAccess GridSpatialSystem::GetComponentAccess() const {
+    return scheduling::SystemAccess()
+        .Reads<components::TransformComponent>()
+        .Writes<world::grid::WorldGrid, world::grid::InterestManager>();
+}
+
 // [SEQUENCE: MVP3-77] Implements PostUpdate to process entity movements and update the grid.
 void GridSpatialSystem::PostUpdate([[maybe_unused]] float delta_time) {
     if (!m_world) return;
@@ -47,6 +57,7 @@ void GridSpatialSystem::PostUpdate([[maybe_unused]] float delta_time) {
             distance_squared > position_update_threshold_ * position_update_threshold_) {
             
             world_grid_->UpdateEntity(entity, spatial_data.last_position, current_pos);
+            interest_manager_->UpdateEntity(entity, current_pos);
             spatial_data.last_position = current_pos;
             spatial_data.needs_update = false;
             updates_processed++;
@@ -61,6 +72,7 @@ void GridSpatialSystem::OnEntityCreated(core::ecs::EntityId entity) {
     if (m_world->HasComponent<components::TransformComponent>(entity)){
         auto& transform = m_world->GetComponent<components::TransformComponent>(entity);
         world_grid_->AddEntity(entity, transform.position);
+        interest_manager_->AddEntity(entity, transform.position);
         EntitySpatialData data;
         data.last_position = transform.position;
         data.needs_update = false;
@@ -70,6 +82,7 @@ void GridSpatialSystem::OnEntityCreated(core::ecs::EntityId entity) {
 
 // [SEQUENCE: MVP3-79] Implements OnEntityDestroyed to remove entities from the grid.
 void GridSpatialSystem::OnEntityDestroyed(core::ecs::EntityId entity) {
+    interest_manager_->RemoveEntity(entity);
     world_grid_->RemoveEntity(entity);
     entity_spatial_data_.erase(entity);
 }
@@ -100,6 +113,36 @@ std::vector<core::ecs::EntityId> GridSpatialSystem::GetEntitiesInRadius(
     return result;
 }
 
+// The grid's broad phase fills results; the narrow phase then compacts each query's ids within its own range
+void GridSpatialSystem::GetEntitiesInRadiusBatch(std::span<const world::RadiusQuery> queries,
+                                                 world::SpatialQueryResults& results) const {
+    if (!world_grid_ || !m_world) {
+        results.ranges.assign(queries.size(), {0, 0});
+        results.ids.clear();
+        return;
+    }
+
+    world_grid_->QueryRadiusBatch(queries, results);
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto& range = results.ranges[i];
+        const auto& center = queries[i].center;
+        const float radius_sq = queries[i].radius * queries[i].radius;
+        uint32_t write = range.begin;
+        for (uint32_t k = range.begin; k < range.begin + range.count; ++k) {
+            const auto entity = results.ids[k];
+            auto& transform = m_world->GetComponent<components::TransformComponent>(entity);
+            float dx = center.x - transform.position.x;
+            float dy = center.y - transform.position.y;
+            float dz = center.z - transform.position.z;
+            if (dx * dx + dy * dy + dz * dz <= radius_sq) {
+                results.ids[write++] = entity;
+            }
+        }
+        range.count = write - range.begin;
+    }
+}
+
 // [SEQUENCE: MVP3-81] Implements GetEntitiesInView for observer-based queries.
 std::vector<core::ecs::EntityId> GridSpatialSystem::GetEntitiesInView(
     core::ecs::EntityId observer, float view_distance) const {
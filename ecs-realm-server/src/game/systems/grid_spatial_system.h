@@ -3,7 +3,10 @@
 #include "core/ecs/optimized/system.h"
 #include "core/ecs/optimized/optimized_world.h"
 #include "game/world/grid/world_grid.h"
+#include "game/world/grid/interest_manager.h"
+#include "game/systems/scheduling/system_access.h"
 #include <memory>
+#include <span>
 
 namespace mmorpg::game::systems {
 
@@ -17,6 +20,11 @@ public:
     void OnSystemInit();
     void OnSystemShutdown();
     void PostUpdate(float delta_time);
+
+    // [SEQUENCE: MVP19-378] Access of PostUpdate, for the system scheduler: it reads positions and writes the
+    // grid and interest sets, which systems querying the grid declare as reads. Schedule it with
+    // &GridSpatialSystem::PostUpdate as the stage.
+    scheduling::SystemAccess GetComponentAccess() const;
     
     // [SEQUENCE: MVP3-70] Entity lifecycle methods to keep the grid synchronized.
     void OnEntityCreated(core::ecs::EntityId entity);
@@ -26,6 +34,11 @@ public:
     std::vector<core::ecs::EntityId> GetEntitiesInRadius(
         const core::utils::Vector3& center, float radius) const;
     
+    // [SEQUENCE: MVP19-364] Batched form of GetEntitiesInRadius with the same narrow phase, for systems that
+    // query around many entities per tick.
+    void GetEntitiesInRadiusBatch(std::span<const world::RadiusQuery> queries,
+                                  world::SpatialQueryResults& results) const;
+    
     std::vector<core::ecs::EntityId> GetEntitiesInView(
         core::ecs::EntityId observer, float view_distance) const;
     
@@ -35,6 +48,9 @@ public:
     // [SEQUENCE: MVP3-72] Getter for direct access to the underlying WorldGrid.
     world::grid::WorldGrid* GetWorldGrid() { return world_grid_.get(); }
     const world::grid::WorldGrid* GetWorldGrid() const { return world_grid_.get(); }
+
+    // [SEQUENCE: MVP19-194] Interest sets kept in step with the grid; observers are registered by the caller.
+    world::grid::InterestManager* GetInterestManager() { return interest_manager_.get(); }
     
 private:
     // [SEQUENCE: MVP3-73] Internal struct to track an entity's spatial state.
@@ -45,6 +61,7 @@ private:
     
     // [SEQUENCE: MVP3-74] Private member variables for the system.
     std::unique_ptr<world::grid::WorldGrid> world_grid_;
+    std::unique_ptr<world::grid::InterestManager> interest_manager_;
     std::unordered_map<core::ecs::EntityId, EntitySpatialData> entity_spatial_data_;
     
     float position_update_threshold_ = 0.1f; // Minimum movement to trigger update
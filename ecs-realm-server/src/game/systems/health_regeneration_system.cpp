@@ -8,16 +8,33 @@ namespace mmorpg::game::systems {
 
 // [SEQUENCE: 1] System initialization
 void HealthRegenerationSystem::OnSystemInit() {
+    // [SEQUENCE: MVP19-390] On an OptimizedWorld, regenerate over the dense arrays
+    if (auto* optimized_world = dynamic_cast<core::ecs::optimized::OptimizedWorld*>(world_)) {
+        health_array_ = optimized_world->GetComponentArray<components::HealthComponent>();
+        network_array_ = optimized_world->GetComponentArray<components::NetworkComponent>();
+    }
     spdlog::info("HealthRegenerationSystem initialized");
 }
 
 // [SEQUENCE: 2] System shutdown
 void HealthRegenerationSystem::OnSystemShutdown() {
+    health_array_ = nullptr;
+    network_array_ = nullptr;
     spdlog::info("HealthRegenerationSystem shutdown");
 }
 
+// [SEQUENCE: MVP19-376] Heals, and flags healed entities for the next sync
+scheduling::SystemAccess HealthRegenerationSystem::GetComponentAccess() const {
+    return scheduling::SystemAccess().Writes<components::HealthComponent, components::NetworkComponent>();
+}
+
 // [SEQUENCE: 3] Update health regeneration
 void HealthRegenerationSystem::Update(float delta_time) {
+    if (health_array_) {
+        UpdateDense(delta_time);
+        return;
+    }
+    
     auto* storage = GetComponentStorage();
     if (!storage) return;
     
@@ -46,4 +63,40 @@ void HealthRegenerationSystem::Update(float delta_time) {
     }
 }
 
+// [SEQUENCE: MVP19-391] Cache-sized chunks of the health array across the pool. Only healed entities need
+// their network component, which the join finds without a lookup while the arrays keep their layout.
+void HealthRegenerationSystem::UpdateDense(float delta_time) {
+    const size_t count = health_array_->GetSize();
+    if (count == 0) return;
+    
+    auto* healths = health_array_->GetDataArray();
+    const std::span<const core::ecs::EntityId> health_entities(health_array_->GetEntityArray(), count);
+    std::span<const core::ecs::EntityId> network_entities;
+    components::NetworkComponent* networks = nullptr;
+    if (network_array_) {
+        networks = network_array_->GetDataArray();
+        network_entities = {network_array_->GetEntityArray(), network_array_->GetSize()};
+    }
+    auto find_network = [&](core::ecs::EntityId entity) {
+        const auto* network = network_array_->GetComponent(entity);
+        return network ? static_cast<uint32_t>(network - networks) : scheduling::ComponentJoin::kMissing;
+    };
+    
+    constexpr size_t kChunkSize = scheduling::ChunkSize<components::HealthComponent, core::ecs::EntityId>();
+    network_join_.Prepare(count);
+    scheduling::ParallelForChunks(pool_, count, kChunkSize, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto& health = healths[i];
+            if (health.is_dead || health.current_hp >= health.max_hp) continue;
+            
+            const float old_hp = health.current_hp;
+            health.Regenerate(delta_time);
+            if (health.current_hp == old_hp || !networks) continue;
+            
+            const uint32_t j = network_join_.IndexOf(i, health_entities, network_entities, find_network);
+            if (j != scheduling::ComponentJoin::kMissing) networks[j].MarkHealthDirty();
+        }
+    });
+}
+
 } // namespace mmorpg::game::systems
\ No newline at end of file
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "core/ecs/system.h"
+#include "core/ecs/optimized/optimized_world.h"
+#include "game/components/health_component.h"
+#include "game/components/network_component.h"
+#include "game/systems/scheduling/parallel_iteration.h"
+#include "game/systems/scheduling/system_access.h"
 
 namespace mmorpg::game::systems {
 
@@ -21,10 +26,24 @@ public:
         return core::ecs::SystemStage::UPDATE; 
     }
     int GetPriority() const override { return 300; } // After combat
+
+    // [SEQUENCE: MVP19-376] Component access for the system scheduler
+    scheduling::SystemAccess GetComponentAccess() const;
+
+    // [SEQUENCE: MVP19-389] Pool the dense update spreads its chunks over; unset runs them on the calling thread
+    void SetThreadPool(scheduling::WorkStealingPool* pool) { pool_ = pool; }
     
 private:
     // [SEQUENCE: 5] Configuration
     float regen_delay_after_damage_ = 5.0f; // Seconds before regen starts
+
+    // [SEQUENCE: MVP19-390] Dense arrays, when the world is an OptimizedWorld
+    core::ecs::optimized::ComponentArray<components::HealthComponent>* health_array_ = nullptr;
+    core::ecs::optimized::ComponentArray<components::NetworkComponent>* network_array_ = nullptr;
+    scheduling::WorkStealingPool* pool_ = nullptr;
+    scheduling::ComponentJoin network_join_;   // Health index -> network index
+
+    void UpdateDense(float delta_time);
 };
 
 } // namespace mmorpg::game::systems
\ No newline at end of file
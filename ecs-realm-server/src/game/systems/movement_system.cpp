@@ -1,6 +1,8 @@
 #include "game/systems/movement_system.h"
 #include "core/ecs/world.h"
+#include "game/components/network_component.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 namespace mmorpg::game::systems {
 
@@ -24,6 +26,8 @@ void MovementSystem::Update(float delta_time) {
     auto* velocity_storage = storage->GetStorage<components::VelocityComponent>();
     
     if (!transform_storage || !velocity_storage) return;
+
+    ApplyNetworkInputs();
     
     // Process entities with both components
     for (auto& [entity, velocity] : velocity_storage->GetAllComponents()) {
@@ -61,6 +65,57 @@ void MovementSystem::UpdateEntityMovement(
     if (transform.rotation.z < -3.14159f) transform.rotation.z += 6.28318f;
 }
 
+// [SEQUENCE: MVP19-78] Client velocity goes through ClampVelocity so a client cannot make the server
+// extrapolate faster than max_speed; client position goes through the reach check described at MVP19-439.
+void MovementSystem::ApplyNetworkInputs() {
+    if (!input_queue_ || input_queue_->DrainTick(pending_inputs_) == 0) return;
+
+    auto* storage = GetComponentStorage();
+    auto* network_storage = storage->GetStorage<components::NetworkComponent>();
+    auto* transform_storage = storage->GetStorage<components::TransformComponent>();
+    auto* velocity_storage = storage->GetStorage<components::VelocityComponent>();
+    if (!network_storage) return;
+
+    input_by_player_.clear();
+    for (size_t i = 0; i < pending_inputs_.size(); ++i) {
+        input_by_player_.emplace(pending_inputs_[i].player_id, i);
+    }
+
+    for (auto& [entity, network] : network_storage->GetAllComponents()) {
+        auto it = input_by_player_.find(network.owner_player_id);
+        if (it == input_by_player_.end()) continue;
+        const auto& input = pending_inputs_[it->second];
+        auto* velocity = velocity_storage->GetComponent(entity);
+
+        if (auto* transform = transform_storage->GetComponent(entity)) {
+            const float max_speed = velocity ? velocity->max_speed : components::VelocityComponent{}.max_speed;
+            const auto gap = std::min<std::chrono::steady_clock::duration>(
+                input.received_at - network.last_input_time, kMaxInputGap);
+            const float reach = max_speed * kInputSpeedTolerance * std::chrono::duration<float>(gap).count() + kInputSlack;
+
+            const core::utils::Vector3 claimed(input.sample.position[0], input.sample.position[1], input.sample.position[2]);
+            const core::utils::Vector3 offset = claimed - transform->position;
+            const float distance = offset.Length();
+            if (distance > reach) {
+                transform->position += offset * (reach / distance);
+                ++corrected_inputs_;
+                spdlog::debug("Corrected movement input {} of player {}: moved {:.2f} of claimed {:.2f}",
+                              input.sequence, network.owner_player_id, reach, distance);
+            } else {
+                transform->position = claimed;
+            }
+            transform->rotation.y = input.sample.yaw;
+        }
+        if (velocity) {
+            velocity->linear = core::utils::Vector3(input.sample.velocity[0], input.sample.velocity[1], input.sample.velocity[2]);
+            ClampVelocity(*velocity);
+        }
+        network.last_input_time = input.received_at;
+        network.last_acknowledged_input = input.sequence;
+        network.MarkPositionDirty();
+    }
+}
+
 // [SEQUENCE: 5] Apply velocity constraints
 void MovementSystem::ClampVelocity(components::VelocityComponent& velocity) {
     float speed = velocity.linear.Length();
@@ -3,6 +3,11 @@
 #include "core/ecs/system.h"
 #include "game/components/transform_component.h"
 #include "game/components/velocity_component.h"
+#include "network/movement_input_queue.h"
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
 
 namespace mmorpg::game::systems {
 
@@ -23,8 +28,23 @@ public:
         return core::ecs::SystemStage::UPDATE; 
     }
     int GetPriority() const override { return 100; } // Early in update
+
+    // [SEQUENCE: MVP19-76] Movement samples received over UDP are applied at the start of each update.
+    void SetInputQueue(network::MovementInputQueue* queue) { input_queue_ = queue; }
+
+    // [SEQUENCE: MVP19-439] A client position is accepted only if the entity could have covered the distance
+    // at its max_speed (times kInputSpeedTolerance, plus kInputSlack for quantization and timing jitter) in the
+    // time since its last accepted input, counted up to kMaxInputGap. Anything further is moved that far
+    // toward the claim and sent back to the client as a correction.
+    static constexpr float kInputSpeedTolerance = 1.1f;
+    static constexpr float kInputSlack = 0.5f;
+    static constexpr std::chrono::milliseconds kMaxInputGap{1000};
+    uint64_t GetCorrectedInputCount() const { return corrected_inputs_; }
     
 private:
+    // [SEQUENCE: MVP19-77] Drains this tick's inputs and writes them onto the owning entities.
+    void ApplyNetworkInputs();
+
     // [SEQUENCE: 5] Update single entity movement
     void UpdateEntityMovement(
         core::ecs::EntityId entity,
@@ -35,6 +55,11 @@ private:
     
     // [SEQUENCE: 6] Apply velocity limits
     void ClampVelocity(components::VelocityComponent& velocity);
+
+    network::MovementInputQueue* input_queue_ = nullptr;
+    std::vector<network::MovementInput> pending_inputs_;
+    std::unordered_map<uint64_t, size_t> input_by_player_;
+    uint64_t corrected_inputs_ = 0;
 };
 
 } // namespace mmorpg::game::systems
\ No newline at end of file
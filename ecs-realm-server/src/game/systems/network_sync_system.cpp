@@ -1,6 +1,9 @@
 #include "game/systems/network_sync_system.h"
 #include "core/ecs/world.h"
-#include "core/network/session_manager.h"
+#include "network/session_manager.h"
+#include "network/session.h"
+#include "network/packet_handler.h"
+#include "game/world/grid/interest_manager.h"
 #include "game/components/transform_component.h"
 #include "game/components/health_component.h"
 #include "game/components/network_component.h"
@@ -27,22 +30,42 @@ void NetworkSyncSystem::NetworkSync(float delta_time) {
     auto* network_storage = storage->GetStorage<components::NetworkComponent>();
     if (!network_storage) return;
     
-    // Group updates by session
-    std::unordered_map<uint64_t, std::vector<mmorpg::proto::EntityUpdate>> updates_by_session;
+    // [SEQUENCE: MVP19-149] Each dirty entity is encoded once into the tick's batcher; observers only add a
+    // reference to that record, and every session gets one framed EntityUpdateBatch at the end.
+    ++sync_tick_;
+    if (delta_sync_enabled_) {
+        ApplyPendingAcks();
+        PruneBaselines();
+        SyncDeltaSnapshots();
+    } else {
+        batcher_.BeginTick(sync_tick_);
+        if (interest_manager_) {
+            SyncByInterest();
+        }
+    }
     
     // Process all networked entities
     for (auto& [entity, network] : network_storage->GetAllComponents()) {
         if (!network.NeedsUpdate()) continue;
         
-        // Create update packet
-        auto update = CreateEntityUpdate(entity);
-        
-        // Send to all sessions that can see this entity
-        auto visible_to = GetVisibleEntities(entity);
-        for (auto observer : visible_to) {
-            auto* observer_network = world_->GetComponent<components::NetworkComponent>(observer);
-            if (observer_network && observer_network->owner_session_id > 0) {
-                updates_by_session[observer_network->owner_session_id].push_back(update);
+        // Entities nobody can see are not encoded at all. In delta mode the snapshots already carry the
+        // change, so only the flags are reset; with interest management movement follows the tier schedule.
+        auto visible = delta_sync_enabled_ || interest_manager_ ? visible_entities_.end() : visible_entities_.find(entity);
+        if (interest_manager_ && !delta_sync_enabled_ && (network.needs_full_update || network.needs_health_update)) {
+            QueueHealthUpdate(entity);
+        }
+        if (visible != visible_entities_.end() && !visible->second.empty()) {
+            // Create update packet
+            auto* update = batcher_.NewUpdate();
+            CreateEntityUpdate(entity, *update);
+            const auto record = batcher_.Encode(*update);
+            
+            // Send to all sessions that can see this entity
+            for (auto observer : visible->second) {
+                auto* observer_network = world_->GetComponent<components::NetworkComponent>(observer);
+                if (observer_network && observer_network->owner_session_id > 0) {
+                    batcher_.AddRecipient(observer_network->owner_session_id, record);
+                }
             }
         }
         
@@ -53,9 +76,151 @@ void NetworkSyncSystem::NetworkSync(float delta_time) {
     }
     
     // Send batched updates to each session
-    for (const auto& [session_id, updates] : updates_by_session) {
-        SendUpdatesToClient(session_id, updates);
+    if (delta_sync_enabled_) return;
+    batcher_.Flush([this](uint64_t session_id, const network::SharedPacketBuffer& batch) {
+        SendUpdatesToClient(session_id, batch);
+    });
+}
+
+// [SEQUENCE: MVP19-196] Every observer gets the targets InterestManager says are due, within its byte budget.
+// A target's movement is encoded at most once per tick however many observers take it, and only if some
+// observer's budget reached it.
+void NetworkSyncSystem::SyncByInterest() {
+    movement_records_.clear();
+    for (auto observer : interest_manager_->GetObservers()) {
+        auto* observer_network = world_->GetComponent<components::NetworkComponent>(observer);
+        if (!observer_network || observer_network->owner_session_id == 0) continue;
+        
+        interest_manager_->CollectDue(observer, sync_tick_, [this](core::ecs::EntityId target) {
+            return batcher_.GetRecordSize(GetMovementRecord(target));
+        }, due_scratch_);
+        for (auto target : due_scratch_) {
+            batcher_.AddRecipient(observer_network->owner_session_id, movement_records_[target]);
+        }
+    }
+}
+
+network::EntityUpdateBatcher::RecordId NetworkSyncSystem::GetMovementRecord(core::ecs::EntityId entity) {
+    auto [it, inserted] = movement_records_.try_emplace(entity);
+    if (inserted) {
+        auto* update = batcher_.NewUpdate();
+        update->set_entity_id(entity);
+        CreateMovementUpdate(entity, *update->mutable_movement());
+        it->second = batcher_.Encode(*update);
+    }
+    return it->second;
+}
+
+// Health changes do not wait for the entity's tier and are not counted against the budget.
+void NetworkSyncSystem::QueueHealthUpdate(core::ecs::EntityId entity) {
+    interest_manager_->GetInterestedObservers(entity, due_scratch_);
+    if (due_scratch_.empty()) return;
+    
+    auto* update = batcher_.NewUpdate();
+    update->set_entity_id(entity);
+    CreateHealthUpdate(entity, *update->mutable_health());
+    const auto record = batcher_.Encode(*update);
+    for (auto observer : due_scratch_) {
+        auto* observer_network = world_->GetComponent<components::NetworkComponent>(observer);
+        if (observer_network && observer_network->owner_session_id > 0) {
+            batcher_.AddRecipient(observer_network->owner_session_id, record);
+        }
+    }
+}
+
+// [SEQUENCE: MVP19-165] Delta mode ignores dirty flags: every observer's full visible set is snapshotted, and
+// the baseline comparison decides what is actually sent. Each entity is quantized at most once per tick.
+void NetworkSyncSystem::SyncDeltaSnapshots() {
+    tick_states_.clear();
+    for (const auto& [observer, targets] : visible_entities_) {
+        auto* observer_network = world_->GetComponent<components::NetworkComponent>(observer);
+        if (!observer_network || observer_network->owner_session_id == 0) continue;
+        
+        snapshot_scratch_.tick = sync_tick_;
+        snapshot_scratch_.entities.clear();
+        snapshot_scratch_.entities.push_back(GetSyncState(observer));
+        for (auto target : targets) {
+            if (target != observer) {
+                snapshot_scratch_.entities.push_back(GetSyncState(target));
+            }
+        }
+        snapshot_scratch_.SortById();
+        
+        const uint64_t session_id = observer_network->owner_session_id;
+        baselines_.try_emplace(session_id).first->second.Encode(snapshot_scratch_, delta_scratch_);
+        
+        mmorpg::proto::EntityDeltaSnapshot packet;
+        packet.set_data(delta_scratch_.data(), delta_scratch_.size());
+        SendUpdatesToClient(session_id, network::PacketSerializer::SerializeShared(packet));
+    }
+}
+
+const network::EntitySyncState& NetworkSyncSystem::GetSyncState(core::ecs::EntityId entity) {
+    auto [it, inserted] = tick_states_.try_emplace(entity);
+    network::EntitySyncState& state = it->second;
+    if (!inserted) return state;
+    
+    using network::SyncField;
+    state.entity_id = entity;
+    if (auto* transform = world_->GetComponent<components::TransformComponent>(entity)) {
+        state.Set(SyncField::PositionX, transform->position.x);
+        state.Set(SyncField::PositionY, transform->position.y);
+        state.Set(SyncField::PositionZ, transform->position.z);
+        state.Set(SyncField::RotationX, transform->rotation.x);
+        state.Set(SyncField::RotationY, transform->rotation.y);
+        state.Set(SyncField::RotationZ, transform->rotation.z);
+    }
+    if (auto* velocity = world_->GetComponent<components::VelocityComponent>(entity)) {
+        state.Set(SyncField::VelocityX, velocity->linear.x);
+        state.Set(SyncField::VelocityY, velocity->linear.y);
+        state.Set(SyncField::VelocityZ, velocity->linear.z);
+    }
+    if (auto* health = world_->GetComponent<components::HealthComponent>(entity)) {
+        state.Set(SyncField::Health, health->current_hp);
+        state.Set(SyncField::MaxHealth, health->max_hp);
+        state.Set(SyncField::Shield, health->shield);
+    }
+    return state;
+}
+
+void NetworkSyncSystem::OnSnapshotAck(uint64_t session_id, const mmorpg::proto::SnapshotAck& ack) {
+    auto it = baselines_.find(session_id);
+    if (it != baselines_.end()) {
+        it->second.Acknowledge(ack.tick());
+    }
+}
+
+void NetworkSyncSystem::RegisterHandlers(network::PacketHandler& packet_handler) {
+    packet_handler.RegisterHandler<mmorpg::proto::SnapshotAck>(
+        [this](std::shared_ptr<network::Session> session, const mmorpg::proto::SnapshotAck& ack) {
+            std::lock_guard lock(pending_acks_mutex_);
+            pending_acks_.emplace_back(session->GetSessionId(), ack.tick());
+        });
+}
+
+void NetworkSyncSystem::ApplyPendingAcks() {
+    {
+        std::lock_guard lock(pending_acks_mutex_);
+        acks_scratch_.swap(pending_acks_);
+    }
+    for (const auto& [session_id, tick] : acks_scratch_) {
+        auto it = baselines_.find(session_id);
+        if (it != baselines_.end()) {
+            it->second.Acknowledge(tick);
+        }
     }
+    acks_scratch_.clear();
+}
+
+// [SEQUENCE: MVP19-416] Nothing reports disconnects to this system, so every kBaselinePruneInterval ticks the
+// baselines of sessions that are gone from the session manager, or disconnected, are dropped.
+void NetworkSyncSystem::PruneBaselines() {
+    constexpr uint32_t kBaselinePruneInterval = 32;
+    if (!session_manager_ || sync_tick_ % kBaselinePruneInterval != 0) return;
+    std::erase_if(baselines_, [this](const auto& entry) {
+        auto session = session_manager_->GetSession(static_cast<uint32_t>(entry.first));
+        return !session || session->GetState() == network::SessionState::Disconnected;
+    });
 }
 
 // [SEQUENCE: 4] Update entity visibility
@@ -70,13 +235,12 @@ void NetworkSyncSystem::UpdateEntityVisibility(core::ecs::EntityId observer, cor
         target_transform->position
     );
     
+    // [SEQUENCE: MVP19-197] A hash set per observer, so membership is O(1) instead of a scan per pair.
     auto& visible_list = visible_entities_[observer];
-    auto it = std::find(visible_list.begin(), visible_list.end(), target);
     
     if (distance <= visibility_range_) {
         // Add to visible list if not already there
-        if (it == visible_list.end()) {
-            visible_list.push_back(target);
+        if (visible_list.insert(target).second) {
             
             // Mark target for full update to observer
             auto* network = world_->GetComponent<components::NetworkComponent>(target);
@@ -86,8 +250,7 @@ void NetworkSyncSystem::UpdateEntityVisibility(core::ecs::EntityId observer, cor
         }
     } else {
         // Remove from visible list
-        if (it != visible_list.end()) {
-            visible_list.erase(it);
+        if (visible_list.erase(target) > 0) {
             
             // Could send entity removal packet
         }
@@ -98,36 +261,30 @@ void NetworkSyncSystem::UpdateEntityVisibility(core::ecs::EntityId observer, cor
 std::vector<core::ecs::EntityId> NetworkSyncSystem::GetVisibleEntities(core::ecs::EntityId observer) {
     auto it = visible_entities_.find(observer);
     if (it != visible_entities_.end()) {
-        return it->second;
+        return std::vector<core::ecs::EntityId>(it->second.begin(), it->second.end());
     }
     return {};
 }
 
 // [SEQUENCE: 6] Create entity update packet
-mmorpg::proto::EntityUpdate NetworkSyncSystem::CreateEntityUpdate(core::ecs::EntityId entity) {
-    mmorpg::proto::EntityUpdate update;
+void NetworkSyncSystem::CreateEntityUpdate(core::ecs::EntityId entity, mmorpg::proto::EntityUpdate& update) {
     update.set_entity_id(entity);
     
     auto* network = world_->GetComponent<components::NetworkComponent>(entity);
-    if (!network) return update;
+    if (!network) return;
     
     // Add appropriate updates based on flags
     if (network->needs_full_update || network->needs_position_update) {
-        auto movement = CreateMovementUpdate(entity);
-        *update.mutable_movement() = movement;
+        CreateMovementUpdate(entity, *update.mutable_movement());
     }
     
     if (network->needs_full_update || network->needs_health_update) {
-        auto health = CreateHealthUpdate(entity);
-        *update.mutable_health() = health;
+        CreateHealthUpdate(entity, *update.mutable_health());
     }
-    
-    return update;
 }
 
 // [SEQUENCE: 7] Create movement update
-mmorpg::proto::MovementUpdate NetworkSyncSystem::CreateMovementUpdate(core::ecs::EntityId entity) {
-    mmorpg::proto::MovementUpdate update;
+void NetworkSyncSystem::CreateMovementUpdate(core::ecs::EntityId entity, mmorpg::proto::MovementUpdate& update) {
     update.set_entity_id(entity);
     update.set_timestamp(std::chrono::system_clock::now().time_since_epoch().count());
     
@@ -151,29 +308,22 @@ mmorpg::proto::MovementUpdate NetworkSyncSystem::CreateMovementUpdate(core::ecs:
         vel->set_y(velocity->linear.y);
         vel->set_z(velocity->linear.z);
     }
-    
-    return update;
 }
 
 // [SEQUENCE: 8] Create health update
-mmorpg::proto::HealthUpdate NetworkSyncSystem::CreateHealthUpdate(core::ecs::EntityId entity) {
-    mmorpg::proto::HealthUpdate update;
-    
+void NetworkSyncSystem::CreateHealthUpdate(core::ecs::EntityId entity, mmorpg::proto::HealthUpdate& update) {
     auto* health = world_->GetComponent<components::HealthComponent>(entity);
     if (health) {
         update.set_current_hp(health->current_hp);
         update.set_max_hp(health->max_hp);
         update.set_shield(health->shield);
     }
-    
-    return update;
 }
 
 // [SEQUENCE: 9] Send updates to client session
-void NetworkSyncSystem::SendUpdatesToClient(uint64_t session_id, const std::vector<mmorpg::proto::EntityUpdate>& updates) {
-    // TODO: Get session manager and send packet
-    // This would integrate with the networking layer from MVP1
-    spdlog::debug("Sending {} updates to session {}", updates.size(), session_id);
+void NetworkSyncSystem::SendUpdatesToClient(uint64_t session_id, const network::SharedPacketBuffer& batch) {
+    if (!session_manager_) return;
+    session_manager_->SendToSession(static_cast<uint32_t>(session_id), batch);
 }
 
 } // namespace mmorpg::game::systems
\ No newline at end of file
@@ -1,10 +1,24 @@
 #pragma once
 
 #include "core/ecs/system.h"
+#include "network/entity_update_batcher.h"
+#include "network/snapshot_delta.h"
 #include "proto/game.pb.h"
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+namespace mmorpg::network {
+class SessionManager;
+class PacketHandler;
+}
+
+namespace mmorpg::game::world::grid {
+class InterestManager;
+}
+
 namespace mmorpg::game::systems {
 
 // [SEQUENCE: 1] Network synchronization system
@@ -28,22 +42,69 @@ public:
     // [SEQUENCE: 5] Entity visibility
     void UpdateEntityVisibility(core::ecs::EntityId observer, core::ecs::EntityId target);
     std::vector<core::ecs::EntityId> GetVisibleEntities(core::ecs::EntityId observer);
+
+    // [SEQUENCE: MVP19-147] Where batched updates are delivered. Without one, NetworkSync only encodes.
+    // This system runs on the legacy core::ecs::World, which mmorpg_server does not host, so the file is in no
+    // build target; the server's owner of that world is expected to call this. Until then the server batches
+    // movement through network::MovementRelay.
+    void SetSessionManager(std::shared_ptr<network::SessionManager> session_manager) {
+        session_manager_ = std::move(session_manager);
+    }
+    const network::EntityUpdateBatchStats& GetLastTickStats() const { return batcher_.GetTickStats(); }
+
+    // [SEQUENCE: MVP19-164] Per-client delta sync: each session gets one EntityDeltaSnapshot per tick, encoded
+    // against the last snapshot it acknowledged, instead of dirty-flag EntityUpdateBatches.
+    void SetDeltaSyncEnabled(bool enabled) { delta_sync_enabled_ = enabled; }
+    void OnSnapshotAck(uint64_t session_id, const mmorpg::proto::SnapshotAck& ack);
+    void RemoveSession(uint64_t session_id) { baselines_.erase(session_id); }
+    // [SEQUENCE: MVP19-415] Routes PACKET_SNAPSHOT_ACK to OnSnapshotAck. Acks arrive on io threads, so they are
+    // queued and applied by NetworkSync on the game thread. The system must outlive the handler.
+    void RegisterHandlers(network::PacketHandler& packet_handler);
+
+    // [SEQUENCE: MVP19-195] Tiered, budgeted sync driven by the grid's interest sets (see
+    // GridSpatialSystem::GetInterestManager). Replaces visible_entities_ when set.
+    void SetInterestManager(world::grid::InterestManager* interest_manager) { interest_manager_ = interest_manager; }
     
 private:
     // [SEQUENCE: 6] Create update packets
-    mmorpg::proto::EntityUpdate CreateEntityUpdate(core::ecs::EntityId entity);
-    mmorpg::proto::MovementUpdate CreateMovementUpdate(core::ecs::EntityId entity);
-    mmorpg::proto::HealthUpdate CreateHealthUpdate(core::ecs::EntityId entity);
+    // [SEQUENCE: MVP19-148] Filled in place so the messages can live on the batcher's tick arena.
+    void CreateEntityUpdate(core::ecs::EntityId entity, mmorpg::proto::EntityUpdate& update);
+    void CreateMovementUpdate(core::ecs::EntityId entity, mmorpg::proto::MovementUpdate& update);
+    void CreateHealthUpdate(core::ecs::EntityId entity, mmorpg::proto::HealthUpdate& update);
+    void SyncDeltaSnapshots();
+    void ApplyPendingAcks();
+    void PruneBaselines();
+    void SyncByInterest();
+    network::EntityUpdateBatcher::RecordId GetMovementRecord(core::ecs::EntityId entity);
+    void QueueHealthUpdate(core::ecs::EntityId entity);
+    const network::EntitySyncState& GetSyncState(core::ecs::EntityId entity);
     
     // [SEQUENCE: 7] Send updates to clients
-    void SendUpdatesToClient(uint64_t session_id, const std::vector<mmorpg::proto::EntityUpdate>& updates);
+    void SendUpdatesToClient(uint64_t session_id, const network::SharedPacketBuffer& batch);
     
     // [SEQUENCE: 8] Visibility tracking
-    std::unordered_map<core::ecs::EntityId, std::vector<core::ecs::EntityId>> visible_entities_;
+    std::unordered_map<core::ecs::EntityId, std::unordered_set<core::ecs::EntityId>> visible_entities_;
     
     // [SEQUENCE: 9] Configuration
     float sync_rate_ = 30.0f; // Updates per second
     float visibility_range_ = 100.0f; // Units
+
+    network::EntityUpdateBatcher batcher_;
+    std::shared_ptr<network::SessionManager> session_manager_;
+    uint32_t sync_tick_ = 0;
+
+    bool delta_sync_enabled_ = false;
+    std::unordered_map<uint64_t, network::ClientBaselineTracker> baselines_;    // By session id
+    std::mutex pending_acks_mutex_;
+    std::vector<std::pair<uint64_t, uint32_t>> pending_acks_;    // (session id, tick), from io threads
+    std::vector<std::pair<uint64_t, uint32_t>> acks_scratch_;
+    std::unordered_map<core::ecs::EntityId, network::EntitySyncState> tick_states_;   // Quantized once per tick
+    network::SyncSnapshot snapshot_scratch_;
+    std::vector<std::byte> delta_scratch_;
+
+    world::grid::InterestManager* interest_manager_ = nullptr;
+    std::unordered_map<core::ecs::EntityId, network::EntityUpdateBatcher::RecordId> movement_records_;   // This tick
+    std::vector<core::ecs::EntityId> due_scratch_;
 };
 
 } // namespace mmorpg::game::systems
\ No newline at end of file
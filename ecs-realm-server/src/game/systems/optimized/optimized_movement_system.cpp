@@ -28,6 +28,11 @@ void OptimizedMovementSystem::OnSystemShutdown() {
     spdlog::info("OptimizedMovementSystem shutdown");
 }
 
+// [SEQUENCE: MVP19-375] Integrates velocities into transforms, clamping velocities on the way
+scheduling::SystemAccess OptimizedMovementSystem::GetComponentAccess() const {
+    return scheduling::SystemAccess().Writes<components::TransformComponent, components::VelocityComponent>();
+}
+
 // [SEQUENCE: 3] Optimized update with direct array iteration
 void OptimizedMovementSystem::Update(float delta_time) {
     if (!transform_array_ || !velocity_array_) {
@@ -38,30 +43,36 @@ void OptimizedMovementSystem::Update(float delta_time) {
     size_t velocity_count = velocity_array_->GetSize();
     if (velocity_count == 0) return;
     
-    // Process in cache-friendly batches
-    constexpr size_t BATCH_SIZE = 64; // Typical cache line count
+    // [SEQUENCE: MVP19-388] Process in cache-friendly batches, spread over the pool: each batch's velocities,
+    // transforms, both entity ids and its join entries fit in L1 together
+    constexpr size_t BATCH_SIZE = scheduling::ChunkSize<components::VelocityComponent, components::TransformComponent,
+                                                        EntityId, EntityId, uint32_t>();
     
-    for (size_t i = 0; i < velocity_count; i += BATCH_SIZE) {
-        size_t batch_end = std::min(i + BATCH_SIZE, velocity_count);
-        ProcessBatch(i, batch_end, delta_time);
-    }
+    transform_join_.Prepare(velocity_count);
+    scheduling::ParallelForChunks(pool_, velocity_count, BATCH_SIZE, [this, delta_time](size_t start, size_t end) {
+        ProcessBatch(start, end, delta_time);
+    });
 }
 
 // [SEQUENCE: 4] Process batch of entities
 void OptimizedMovementSystem::ProcessBatch(size_t start, size_t end, float delta_time) {
     // Get raw data arrays for direct access
     auto* velocities = velocity_array_->GetDataArray();
-    auto* velocity_entities = velocity_array_->GetEntityArray();
+    auto* transforms = transform_array_->GetDataArray();
+    const std::span<const EntityId> velocity_entities(velocity_array_->GetEntityArray(), velocity_array_->GetSize());
+    const std::span<const EntityId> transform_entities(transform_array_->GetEntityArray(), transform_array_->GetSize());
     
     // First pass: clamp velocities (can be SIMD optimized)
     ClampVelocityBatch(velocities + start, end - start);
     
-    // Second pass: update positions
-    for (size_t i = start; i < end; ++i) {
-        EntityId entity = velocity_entities[i];
-        auto* transform = transform_array_->GetComponent(entity);
-        
-        if (!transform) continue;
+    // Second pass: update positions, reaching each transform through the join; an entity is looked up only when
+    // its transform moved in the array since the last update
+    auto find_transform = [&](EntityId entity) {
+        const auto* transform = transform_array_->GetComponent(entity);
+        return transform ? static_cast<uint32_t>(transform - transforms) : scheduling::ComponentJoin::kMissing;
+    };
+    transform_join_.ForRange(start, end, velocity_entities, transform_entities, find_transform, [&](size_t i, size_t j) {
+        auto* transform = &transforms[j];
         
         // Direct memory access to velocity
         const auto& velocity = velocities[i];
@@ -83,7 +94,7 @@ void OptimizedMovementSystem::ProcessBatch(size_t start, size_t end, float delta
         if (transform->rotation.y < -3.14159f) transform->rotation.y += 6.28318f;
         if (transform->rotation.z > 3.14159f) transform->rotation.z -= 6.28318f;
         if (transform->rotation.z < -3.14159f) transform->rotation.z += 6.28318f;
-    }
+    });
 }
 
 // [SEQUENCE: 5] Batch velocity clamping (SIMD-friendly)
@@ -4,6 +4,8 @@
 #include "core/ecs/optimized/optimized_world.h"
 #include "game/components/transform_component.h"
 #include "game/components/velocity_component.h"
+#include "game/systems/scheduling/parallel_iteration.h"
+#include "game/systems/scheduling/system_access.h"
 
 namespace mmorpg::game::systems::optimized {
 
@@ -24,12 +26,20 @@ public:
         return core::ecs::SystemStage::UPDATE; 
     }
     int GetPriority() const override { return 100; }
+
+    // [SEQUENCE: MVP19-375] Component access for the system scheduler
+    scheduling::SystemAccess GetComponentAccess() const;
+
+    // [SEQUENCE: MVP19-387] Pool the update spreads its chunks over; unset runs them on the calling thread
+    void SetThreadPool(scheduling::WorkStealingPool* pool) { pool_ = pool; }
     
 private:
     // [SEQUENCE: 5] Cache pointers to component arrays
     core::ecs::optimized::ComponentArray<components::TransformComponent>* transform_array_ = nullptr;
     core::ecs::optimized::ComponentArray<components::VelocityComponent>* velocity_array_ = nullptr;
     core::ecs::optimized::OptimizedWorld* optimized_world_ = nullptr;
+    scheduling::WorkStealingPool* pool_ = nullptr;
+    scheduling::ComponentJoin transform_join_;   // Velocity index -> transform index
     
     // [SEQUENCE: 6] Process entities in batches for cache efficiency
     void ProcessBatch(size_t start, size_t end, float delta_time);
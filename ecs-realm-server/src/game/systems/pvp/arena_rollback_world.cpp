@@ -0,0 +1,132 @@
+#include "game/systems/pvp/arena_rollback_world.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mmorpg::game::systems::pvp {
+
+ArenaRollbackWorld::ArenaRollbackWorld(const network::RollbackConfig& config, const ArenaRules& rules)
+    : rules_(rules)
+    , session_(kPlayers,
+               [this](uint32_t, const network::TickInput* inputs, size_t) { Step(inputs); },
+               config) {
+    // Teams face each other across the arena, three abreast
+    for (size_t i = 0; i < kPlayers; ++i) {
+        auto& player = player_storage_[i];
+        player.team = static_cast<uint8_t>(i / 3);
+        player.health = rules_.max_health;
+        player.move.position.x = player.team == 0 ? -10.0f : 10.0f;
+        player.move.position.z = static_cast<float>(i % 3) * 4.0f - 4.0f;
+        player.move.yaw = player.team == 0 ? 1.5707964f : -1.5707964f;
+    }
+    players_ = session_.RegisterColumn(player_storage_.data(), player_storage_.size());
+    projectiles_ = session_.RegisterColumn(projectile_storage_.data(), projectile_storage_.size());
+}
+
+size_t ArenaRollbackWorld::GetActiveProjectileCount() const {
+    return static_cast<size_t>(std::count_if(projectile_storage_.begin(), projectile_storage_.end(),
+                                             [](const ArenaProjectile& p) { return p.active != 0; }));
+}
+
+void ArenaRollbackWorld::Step(const network::TickInput* inputs) {
+    UpdateMovement(inputs);
+    UpdateAttacks(inputs);
+    UpdateProjectiles();
+    UpdateRegeneration();
+}
+
+void ArenaRollbackWorld::UpdateMovement(const network::TickInput* inputs) {
+    for (size_t i = 0; i < kPlayers; ++i) {
+        if (!players_[i].alive) {
+            continue;
+        }
+        auto& player = players_.Write(i);
+        player.move = network::StepMovement(player.move, inputs[i], rules_.movement);
+        player.move.position.x = std::clamp(player.move.position.x, -rules_.half_extent, rules_.half_extent);
+        player.move.position.z = std::clamp(player.move.position.z, -rules_.half_extent, rules_.half_extent);
+    }
+}
+
+// [SEQUENCE: MVP19-253] Fires into the lowest free projectile slot, so slot use is a function of the inputs alone.
+void ArenaRollbackWorld::UpdateAttacks(const network::TickInput* inputs) {
+    for (size_t i = 0; i < kPlayers; ++i) {
+        const auto& player = players_[i];
+        if (!player.alive) {
+            continue;
+        }
+        if (player.cooldown_ticks > 0) {
+            --players_.Write(i).cooldown_ticks;
+            continue;
+        }
+        if (!(inputs[i].flags & network::TickInput::kPrimary)) {
+            continue;
+        }
+        size_t slot = 0;
+        while (slot < kMaxProjectiles && projectiles_[slot].active) {
+            ++slot;
+        }
+        if (slot == kMaxProjectiles) {
+            continue;
+        }
+        auto& projectile = projectiles_.Write(slot);
+        projectile.position = {player.move.position.x, player.move.position.y + 1.0f, player.move.position.z};
+        projectile.velocity = {std::sin(player.move.yaw) * rules_.projectile_speed, 0.0f,
+                               std::cos(player.move.yaw) * rules_.projectile_speed};
+        projectile.ttl_ticks = rules_.projectile_ttl_ticks;
+        projectile.owner = static_cast<uint8_t>(i);
+        projectile.active = 1;
+        players_.Write(i).cooldown_ticks = rules_.attack_cooldown_ticks;
+    }
+}
+
+void ArenaRollbackWorld::UpdateProjectiles() {
+    const float dt = rules_.movement.tick_seconds;
+    const float radius_sq = rules_.hit_radius * rules_.hit_radius;
+    for (size_t j = 0; j < kMaxProjectiles; ++j) {
+        if (!projectiles_[j].active) {
+            continue;
+        }
+        auto& projectile = projectiles_.Write(j);
+        projectile.position.x += projectile.velocity.x * dt;
+        projectile.position.y += projectile.velocity.y * dt;
+        projectile.position.z += projectile.velocity.z * dt;
+        if (--projectile.ttl_ticks == 0) {
+            projectile.active = 0;
+            continue;
+        }
+
+        const uint8_t team = players_[projectile.owner].team;
+        for (size_t k = 0; k < kPlayers; ++k) {
+            const auto& target = players_[k];
+            if (!target.alive || target.team == team) {
+                continue;
+            }
+            const float dx = projectile.position.x - target.move.position.x;
+            const float dy = projectile.position.y - (target.move.position.y + 1.0f);
+            const float dz = projectile.position.z - target.move.position.z;
+            if (dx * dx + dy * dy + dz * dz > radius_sq) {
+                continue;
+            }
+            auto& victim = players_.Write(k);
+            victim.health -= rules_.damage;
+            if (victim.health <= 0.0f) {
+                victim.health = 0.0f;
+                victim.alive = 0;
+            }
+            projectile.active = 0;
+            break;
+        }
+    }
+}
+
+void ArenaRollbackWorld::UpdateRegeneration() {
+    const float amount = rules_.regen_per_second * rules_.movement.tick_seconds;
+    for (size_t i = 0; i < kPlayers; ++i) {
+        const auto& player = players_[i];
+        if (player.alive && player.health < rules_.max_health) {
+            players_.Write(i).health = std::min(rules_.max_health, player.health + amount);
+        }
+    }
+}
+
+} // namespace mmorpg::game::systems::pvp
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "core/utils/vector3.h"
+#include "network/input_jitter_buffer.h"
+#include "network/rollback_session.h"
+
+namespace mmorpg::game::systems::pvp {
+
+// [SEQUENCE: MVP19-251] Arena match state, kept as plain data so a RollbackSession can page it.
+struct ArenaPlayer {
+    network::MoveState move;
+    float health = 100.0f;
+    uint16_t cooldown_ticks = 0;
+    uint8_t team = 0;
+    uint8_t alive = 1;
+};
+
+struct ArenaProjectile {
+    core::utils::Vector3 position;
+    core::utils::Vector3 velocity;
+    uint16_t ttl_ticks = 0;
+    uint8_t owner = 0;
+    uint8_t active = 0;
+};
+
+struct ArenaRules {
+    network::MovementParams movement;
+    float half_extent = 20.0f;   // The floor is a square of this half-width around the origin
+    float projectile_speed = 30.0f;
+    uint16_t projectile_ttl_ticks = 60;
+    uint16_t attack_cooldown_ticks = 20;
+    float hit_radius = 0.8f;
+    float damage = 12.0f;
+    float regen_per_second = 2.0f;
+    float max_health = 100.0f;
+};
+
+// [SEQUENCE: MVP19-252] A 3v3 arena simulated under rollback.
+//
+// The systems below are the only code that changes the match. Step runs them in a fixed order for one frame,
+// and the session calls Step both for a new frame and for every frame it resimulates after a late input, so
+// there is one code path to keep deterministic. Every write goes through the state columns, so a frame saves
+// only the pages it actually dirtied: the player block, plus whichever projectile pages hold live projectiles.
+class ArenaRollbackWorld {
+public:
+    static constexpr size_t kPlayers = 6;
+    static constexpr size_t kMaxProjectiles = 64;
+
+    explicit ArenaRollbackWorld(const network::RollbackConfig& config = {}, const ArenaRules& rules = {});
+
+    ArenaRollbackWorld(const ArenaRollbackWorld&) = delete;
+    ArenaRollbackWorld& operator=(const ArenaRollbackWorld&) = delete;
+
+    network::RollbackSession& Session() { return session_; }
+    const network::RollbackSession& Session() const { return session_; }
+    const ArenaPlayer& GetPlayer(size_t index) const { return players_[index]; }
+    size_t GetActiveProjectileCount() const;
+
+    void UpdateMovement(const network::TickInput* inputs);
+    void UpdateAttacks(const network::TickInput* inputs);
+    void UpdateProjectiles();
+    void UpdateRegeneration();
+
+private:
+    void Step(const network::TickInput* inputs);
+
+    const ArenaRules rules_;
+    std::array<ArenaPlayer, kPlayers> player_storage_{};
+    std::array<ArenaProjectile, kMaxProjectiles> projectile_storage_{};
+    network::RollbackSession session_;
+    network::RollbackColumn<ArenaPlayer> players_;
+    network::RollbackColumn<ArenaProjectile> projectiles_;
+};
+
+} // namespace mmorpg::game::systems::pvp
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "core/ecs/types.h"
+#include "game/systems/scheduling/work_stealing_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace mmorpg::game::systems::scheduling {
+
+// [SEQUENCE: MVP19-385] Parallel loops over dense component arrays. An array is cut into chunks sized so that
+// the slice of every array one chunk touches fits in L1 together; the chunks go to a WorkStealingPool, and
+// a busy core's remaining chunks are taken by idle ones.
+
+// L1 data cache budget per chunk
+inline constexpr size_t kChunkBytes = 32 * 1024;
+
+// Elements per chunk for a loop touching one element of each of Touched per index
+template <typename... Touched>
+constexpr size_t ChunkSize() {
+    constexpr size_t bytes = (sizeof(Touched) + ... + 0);
+    constexpr size_t elements = kChunkBytes / (bytes > 0 ? bytes : 1) / 16 * 16;
+    return elements < 64 ? 64 : elements;
+}
+
+// Calls body(begin, end) for consecutive ranges of chunk_size covering [0, count), concurrently on pool and
+// the calling thread, or all on the calling thread when pool is null.
+template <typename Body>
+void ParallelForChunks(WorkStealingPool* pool, size_t count, size_t chunk_size, Body&& body) {
+    if (count == 0) return;
+    chunk_size = std::max<size_t>(chunk_size, 1);
+    const size_t chunks = (count + chunk_size - 1) / chunk_size;
+    if (!pool || chunks == 1) {
+        for (size_t begin = 0; begin < count; begin += chunk_size) body(begin, std::min(begin + chunk_size, count));
+        return;
+    }
+    pool->ParallelFor(chunks, [&](size_t chunk) {
+        const size_t begin = chunk * chunk_size;
+        body(begin, std::min(begin + chunk_size, count));
+    });
+}
+
+// [SEQUENCE: MVP19-386] Pairs the elements of two dense component arrays that belong to the same entity, so
+// a joined loop reads the second array by index instead of looking each entity up. For every element of the
+// driving array the join keeps the index of the same entity's element in the other array. Each use checks the
+// pairing against the other array's entity ids, which the loop reads next to the component anyway, and looks
+// up only the pairs that went stale since the last pass, when the other array swapped or dropped elements.
+// Steady state, nothing is looked up.
+class ComponentJoin {
+public:
+    static constexpr uint32_t kMissing = UINT32_MAX;
+
+    // Sizes the join for the driving array; call once per pass, before ForRange
+    void Prepare(size_t driver_count) {
+        index_.resize(driver_count, kMissing);
+        lookups_.store(0, std::memory_order_relaxed);
+    }
+
+    // Calls body(i, j) for each i in [begin, end) whose entity driver[i] is other[j]. lookup(entity) returns
+    // the entity's index in the other array, or kMissing. Disjoint ranges may run concurrently.
+    template <typename Lookup, typename Body>
+    void ForRange(size_t begin, size_t end, std::span<const core::ecs::EntityId> driver,
+                  std::span<const core::ecs::EntityId> other, Lookup&& lookup, Body&& body) {
+        size_t lookups = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const uint32_t j = Resolve(i, driver, other, lookup, lookups);
+            if (j != kMissing) body(i, static_cast<size_t>(j));
+        }
+        if (lookups > 0) lookups_.fetch_add(lookups, std::memory_order_relaxed);
+    }
+
+    // The other array's index for driver[i] alone, or kMissing, for loops that need the other component for
+    // only some elements
+    template <typename Lookup>
+    uint32_t IndexOf(size_t i, std::span<const core::ecs::EntityId> driver,
+                     std::span<const core::ecs::EntityId> other, Lookup&& lookup) {
+        size_t lookups = 0;
+        const uint32_t j = Resolve(i, driver, other, lookup, lookups);
+        if (lookups > 0) lookups_.fetch_add(lookups, std::memory_order_relaxed);
+        return j;
+    }
+
+    // Both steps over the whole driving array, in chunks on pool
+    template <typename Lookup, typename Body>
+    void ForEach(WorkStealingPool* pool, size_t chunk_size, std::span<const core::ecs::EntityId> driver,
+                 std::span<const core::ecs::EntityId> other, Lookup&& lookup, Body&& body) {
+        Prepare(driver.size());
+        ParallelForChunks(pool, driver.size(), chunk_size, [&](size_t begin, size_t end) {
+            ForRange(begin, end, driver, other, lookup, body);
+        });
+    }
+
+    // Entities looked up in the last pass: the ones new to the driving array or moved in the other, plus
+    // those without an element in the other array, which are looked up every pass
+    size_t GetLastLookups() const { return lookups_.load(std::memory_order_relaxed); }
+
+private:
+    template <typename Lookup>
+    uint32_t Resolve(size_t i, std::span<const core::ecs::EntityId> driver, std::span<const core::ecs::EntityId> other,
+                     Lookup& lookup, size_t& lookups) {
+        uint32_t j = index_[i];
+        if (j < other.size() && other[j] == driver[i]) return j;
+        j = lookup(driver[i]);
+        index_[i] = j;
+        ++lookups;
+        return j;
+    }
+
+    std::vector<uint32_t> index_;
+    std::atomic<size_t> lookups_{0};
+};
+
+} // namespace mmorpg::game::systems::scheduling
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+namespace mmorpg::game::systems::scheduling {
+
+// [SEQUENCE: MVP19-370] What a system's update touches, for the scheduler to order it against the others:
+// component types it reads and writes, plus any shared state it reaches by type (the spatial grid, say). Two
+// systems conflict when one writes what the other reads or writes; conflicting systems run one after the
+// other, all others may run at once.
+class SystemAccess {
+public:
+    template <typename... T>
+    SystemAccess& Reads() {
+        (AddRead(typeid(T)), ...);
+        return *this;
+    }
+
+    // Writing implies reading
+    template <typename... T>
+    SystemAccess& Writes() {
+        (AddWrite(typeid(T)), ...);
+        return *this;
+    }
+
+    // Creating or destroying entities, or adding or removing components, changes what every other system
+    // iterates; a system doing so during its update is ordered against all others.
+    SystemAccess& ChangesEntities() {
+        changes_entities_ = true;
+        return *this;
+    }
+
+    bool ConflictsWith(const SystemAccess& other) const {
+        if (changes_entities_ || other.changes_entities_) return true;
+        return Intersects(writes_, other.writes_) || Intersects(writes_, other.reads_) ||
+               Intersects(reads_, other.writes_);
+    }
+
+    const std::vector<std::type_index>& GetReads() const { return reads_; }
+    const std::vector<std::type_index>& GetWrites() const { return writes_; }
+    bool GetChangesEntities() const { return changes_entities_; }
+
+private:
+    void AddRead(std::type_index type) {
+        if (!std::binary_search(writes_.begin(), writes_.end(), type)) Insert(reads_, type);
+    }
+
+    void AddWrite(std::type_index type) {
+        const auto it = std::lower_bound(reads_.begin(), reads_.end(), type);
+        if (it != reads_.end() && *it == type) reads_.erase(it);
+        Insert(writes_, type);
+    }
+
+    static void Insert(std::vector<std::type_index>& types, std::type_index type) {
+        const auto it = std::lower_bound(types.begin(), types.end(), type);
+        if (it == types.end() || *it != type) types.insert(it, type);
+    }
+
+    static bool Intersects(const std::vector<std::type_index>& a, const std::vector<std::type_index>& b) {
+        for (auto i = a.begin(), j = b.begin(); i != a.end() && j != b.end();) {
+            if (*i < *j) {
+                ++i;
+            } else if (*j < *i) {
+                ++j;
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::type_index> reads_;    // Sorted; a type written is not repeated here
+    std::vector<std::type_index> writes_;   // Sorted
+    bool changes_entities_ = false;
+};
+
+} // namespace mmorpg::game::systems::scheduling
@@ -0,0 +1,178 @@
+#include "game/systems/scheduling/system_scheduler.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace mmorpg::game::systems::scheduling {
+
+namespace {
+
+constexpr uint32_t kNoNode = UINT32_MAX;
+
+double MicrosBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+} // namespace
+
+SystemScheduler::SystemScheduler(WorkStealingPool& pool) : pool_(pool) {}
+
+SystemScheduler::SystemHandle SystemScheduler::AddSystem(std::string name, SystemAccess access, UpdateFunction update) {
+    System system;
+    system.name = std::move(name);
+    system.access = std::move(access);
+    system.update = std::move(update);
+    systems_.push_back(std::move(system));
+    return systems_.size() - 1;
+}
+
+void SystemScheduler::SetEnabled(SystemHandle system, bool enabled) {
+    systems_[system].enabled = enabled;
+}
+
+const std::vector<SystemScheduler::SystemHandle>& SystemScheduler::GetDependencies(SystemHandle system) const {
+    return systems_[system].dependencies;
+}
+
+// [SEQUENCE: MVP19-372] An edge from each system to every later one it conflicts with. Rebuilt every frame, as
+// systems are enabled and disabled; a frame has tens of systems, so the quadratic pass costs microseconds.
+void SystemScheduler::BuildGraph() {
+    size_t count = 0;
+    for (auto& system : systems_) {
+        system.dependencies.clear();
+        if (system.enabled) ++count;
+    }
+    nodes_.resize(count);
+    if (count > waiting_capacity_) {
+        waiting_ = std::make_unique<std::atomic<uint32_t>[]>(count);
+        waiting_capacity_ = count;
+    }
+
+    uint32_t n = 0;
+    for (SystemHandle s = 0; s < systems_.size(); ++s) {
+        if (!systems_[s].enabled) continue;
+        auto& node = nodes_[n];
+        node.system = s;
+        node.successors.clear();
+        node.predecessors.clear();
+        for (uint32_t earlier = 0; earlier < n; ++earlier) {
+            if (systems_[nodes_[earlier].system].access.ConflictsWith(systems_[s].access)) {
+                nodes_[earlier].successors.push_back(n);
+                node.predecessors.push_back(earlier);
+                systems_[s].dependencies.push_back(nodes_[earlier].system);
+            }
+        }
+        waiting_[n].store(static_cast<uint32_t>(node.predecessors.size()), std::memory_order_relaxed);
+        ++n;
+    }
+}
+
+void SystemScheduler::Update(float delta_time) {
+    BuildGraph();
+    delta_time_ = delta_time;
+    error_ = nullptr;
+    remaining_.store(nodes_.size(), std::memory_order_relaxed);
+
+    const auto frame_start = Clock::now();
+    uint32_t first_root = kNoNode;
+    for (uint32_t n = 0; n < nodes_.size(); ++n) {
+        if (!nodes_[n].predecessors.empty()) continue;
+        if (first_root == kNoNode) {
+            first_root = n;
+        } else {
+            pool_.Submit([this, n] { RunFrom(n); });
+        }
+    }
+    if (first_root != kNoNode) RunFrom(first_root);
+    while (remaining_.load(std::memory_order_acquire) > 0) {
+        if (!pool_.RunPendingTask()) std::this_thread::yield();
+    }
+
+    RecordFrame(frame_start);
+    if (error_) {
+        auto error = std::exchange(error_, nullptr);
+        std::rethrow_exception(error);
+    }
+}
+
+// [SEQUENCE: MVP19-373] Runs a system, releases its successors, and carries on with one of those it made ready
+// on this thread, where the data the system just wrote is still in cache; the others go to the pool.
+void SystemScheduler::RunFrom(uint32_t n) {
+    while (n != kNoNode) {
+        auto& node = nodes_[n];
+        node.start = Clock::now();
+        try {
+            systems_[node.system].update(delta_time_);
+        } catch (...) {
+            std::lock_guard lock(error_mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+        node.end = Clock::now();
+
+        uint32_t next = kNoNode;
+        for (const uint32_t successor : node.successors) {
+            if (waiting_[successor].fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+            if (next == kNoNode) {
+                next = successor;
+            } else {
+                pool_.Submit([this, successor] { RunFrom(successor); });
+            }
+        }
+        remaining_.fetch_sub(1, std::memory_order_release);
+        n = next;
+    }
+}
+
+// [SEQUENCE: MVP19-374] Per-system times, and the longest chain through the DAG weighted by this frame's
+// times. Nodes are in the order systems were added, which every edge follows, so one forward pass finds it.
+void SystemScheduler::RecordFrame(Clock::time_point frame_start) {
+    finish_us_.assign(nodes_.size(), 0.0);
+    via_.assign(nodes_.size(), kNoNode);
+    frame_.wall_us = 0.0;
+    frame_.serial_us = 0.0;
+    frame_.dependencies = 0;
+    uint32_t last = kNoNode;
+    for (uint32_t n = 0; n < nodes_.size(); ++n) {
+        const auto& node = nodes_[n];
+        const double us = MicrosBetween(node.start, node.end);
+        auto& timing = systems_[node.system].timing;
+        timing.last_us = us;
+        timing.start_us = MicrosBetween(frame_start, node.start);
+        timing.total_us += us;
+        timing.max_us = std::max(timing.max_us, us);
+        ++timing.runs;
+
+        frame_.wall_us = std::max(frame_.wall_us, MicrosBetween(frame_start, node.end));
+        frame_.serial_us += us;
+        frame_.dependencies += node.successors.size();
+
+        for (const uint32_t predecessor : node.predecessors) {
+            if (via_[n] == kNoNode || finish_us_[predecessor] > finish_us_[via_[n]]) via_[n] = predecessor;
+        }
+        finish_us_[n] = us + (via_[n] == kNoNode ? 0.0 : finish_us_[via_[n]]);
+        if (last == kNoNode || finish_us_[n] > finish_us_[last]) last = n;
+    }
+
+    frame_.critical_path.clear();
+    frame_.critical_path_us = last == kNoNode ? 0.0 : finish_us_[last];
+    for (uint32_t n = last; n != kNoNode; n = via_[n]) {
+        frame_.critical_path.push_back(nodes_[n].system);
+    }
+    std::reverse(frame_.critical_path.begin(), frame_.critical_path.end());
+    ++frame_.frames;
+}
+
+void SystemScheduler::ExportMetrics(monitoring::MetricsCollector& metrics) const {
+    metrics.RecordGauge("scheduler.frame_us", frame_.wall_us);
+    metrics.RecordGauge("scheduler.serial_us", frame_.serial_us);
+    metrics.RecordGauge("scheduler.critical_path_us", frame_.critical_path_us);
+    metrics.RecordGauge("scheduler.critical_path_length", static_cast<double>(frame_.critical_path.size()));
+    metrics.RecordGauge("scheduler.dependencies", static_cast<double>(frame_.dependencies));
+    metrics.RecordCounter("scheduler.frames", frame_.frames);
+    for (const auto& system : systems_) {
+        metrics.RecordGauge("scheduler.system." + system.name + "_us", system.timing.last_us);
+    }
+}
+
+} // namespace mmorpg::game::systems::scheduling
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "game/systems/scheduling/system_access.h"
+#include "game/systems/scheduling/work_stealing_pool.h"
+#include "monitoring/metrics_collector.h"
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mmorpg::game::systems::scheduling {
+
+// [SEQUENCE: MVP19-371] Runs a frame's systems on a WorkStealingPool instead of one after another. Each frame
+// the enabled systems form a DAG: a system depends on every earlier-added system its SystemAccess conflicts
+// with, so conflicting systems keep the order they were added in, which should be the order the sequential
+// loop ran them, and the rest run concurrently. A system starts as soon as the last system it depends on ends.
+//
+// The frame is bounded by its critical path, the longest chain of dependent systems, rather than by the sum
+// of all systems; both are measured every frame.
+class SystemScheduler {
+public:
+    using SystemHandle = size_t;
+    using UpdateFunction = std::function<void(float delta_time)>;
+
+    explicit SystemScheduler(WorkStealingPool& pool);
+
+    SystemHandle AddSystem(std::string name, SystemAccess access, UpdateFunction update);
+
+    // [SEQUENCE: MVP19-461] For systems that declare their own access through GetComponentAccess(). The stage
+    // to run is named explicitly, e.g. &GridSpatialSystem::PostUpdate, and must be the one that access
+    // describes: a system's other stages may touch other components.
+    template <typename SystemT, typename StageOwnerT>
+        requires std::derived_from<SystemT, StageOwnerT>
+    SystemHandle AddSystem(std::string name, SystemT& system, void (StageOwnerT::*stage)(float)) {
+        return AddSystem(std::move(name), system.GetComponentAccess(),
+                         [&system, stage](float delta_time) { (system.*stage)(delta_time); });
+    }
+
+    // Disabled systems are left out of the DAG from the next frame on
+    void SetEnabled(SystemHandle system, bool enabled);
+
+    // Runs every enabled system once and returns when all have finished, the calling thread working alongside
+    // the pool. A system that throws does not stop the others; the first exception is rethrown after the frame.
+    void Update(float delta_time);
+
+    // Systems the given one waited on in the last frame
+    const std::vector<SystemHandle>& GetDependencies(SystemHandle system) const;
+
+    struct SystemTiming {
+        double last_us = 0.0;       // Wall time of its update in the last frame it ran
+        double start_us = 0.0;      // When that update started, from the frame's start
+        double total_us = 0.0;
+        double max_us = 0.0;
+        uint64_t runs = 0;
+    };
+    const SystemTiming& GetTiming(SystemHandle system) const { return systems_[system].timing; }
+    const std::string& GetName(SystemHandle system) const { return systems_[system].name; }
+    size_t GetSystemCount() const { return systems_.size(); }
+
+    struct FrameStats {
+        double wall_us = 0.0;            // Frame start to the last system's end
+        double serial_us = 0.0;          // Sum of the systems' times: the sequential loop's frame
+        double critical_path_us = 0.0;   // Longest dependency chain by this frame's times: wall_us's floor
+        std::vector<SystemHandle> critical_path;
+        size_t dependencies = 0;         // Edges in the DAG
+        uint64_t frames = 0;
+    };
+    const FrameStats& GetFrameStats() const { return frame_; }
+
+    // Last frame's times as gauges under "scheduler.", per system as "scheduler.system.<name>_us"
+    void ExportMetrics(monitoring::MetricsCollector& metrics) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct System {
+        std::string name;
+        SystemAccess access;
+        UpdateFunction update;
+        bool enabled = true;
+        SystemTiming timing;
+        std::vector<SystemHandle> dependencies;   // Last frame's, as handles
+    };
+
+    // A system in this frame's DAG
+    struct Node {
+        SystemHandle system;
+        std::vector<uint32_t> successors;
+        std::vector<uint32_t> predecessors;
+        Clock::time_point start;
+        Clock::time_point end;
+    };
+
+    void BuildGraph();
+    void RunFrom(uint32_t node);   // Runs the node, then whichever successors it made ready
+    void RecordFrame(Clock::time_point frame_start);
+
+    WorkStealingPool& pool_;
+    std::vector<System> systems_;
+
+    std::vector<Node> nodes_;
+    std::unique_ptr<std::atomic<uint32_t>[]> waiting_;   // Per node, dependencies not yet finished
+    size_t waiting_capacity_ = 0;
+    std::atomic<size_t> remaining_{0};                   // Nodes not yet finished this frame
+    float delta_time_ = 0.0f;
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+
+    FrameStats frame_;
+    std::vector<double> finish_us_;    // Critical-path scratch: longest chain ending at each node
+    std::vector<uint32_t> via_;        // and the predecessor it came through
+};
+
+} // namespace mmorpg::game::systems::scheduling
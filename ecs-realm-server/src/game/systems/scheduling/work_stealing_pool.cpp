@@ -0,0 +1,187 @@
+#include "game/systems/scheduling/work_stealing_pool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace mmorpg::game::systems::scheduling {
+
+namespace {
+
+// The pool and deque of the worker running on this thread, if it is one
+thread_local const WorkStealingPool* tls_pool = nullptr;
+thread_local size_t tls_queue = 0;
+
+// Rounds a worker tries to steal before sleeping; a frame's tasks arrive in bursts
+constexpr int kSpinRounds = 64;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(size_t worker_count) {
+    queues_.reserve(std::max<size_t>(worker_count, 1));
+    for (size_t i = 0; i < std::max<size_t>(worker_count, 1); ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back([this, i] { WorkerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard lock(sleep_mutex_);
+        stopping_.store(true);
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+size_t WorkStealingPool::DefaultWorkerCount() {
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+void WorkStealingPool::Submit(Task task) {
+    const size_t queue = tls_pool == this ? tls_queue
+                                          : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+        std::lock_guard lock(queues_[queue]->mutex);
+        queues_[queue]->tasks.push_back(std::move(task));
+    }
+    // Paired with the sleeper raising sleeping_ before it rechecks pending_: one of the two sees the other
+    pending_.fetch_add(1);
+    if (sleeping_.load() > 0) {
+        { std::lock_guard lock(sleep_mutex_); }
+        wake_.notify_one();
+    }
+}
+
+bool WorkStealingPool::TryPop(size_t queue, Task& task) {
+    std::lock_guard lock(queues_[queue]->mutex);
+    auto& tasks = queues_[queue]->tasks;
+    if (tasks.empty()) return false;
+    task = std::move(tasks.back());
+    tasks.pop_back();
+    pending_.fetch_sub(1);
+    return true;
+}
+
+bool WorkStealingPool::TrySteal(size_t start, Task& task) {
+    for (size_t k = 0; k < queues_.size(); ++k) {
+        auto& queue = *queues_[(start + k) % queues_.size()];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        pending_.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::Run(Task& task, bool stolen) {
+    task();
+    task = nullptr;
+    executed_.fetch_add(1, std::memory_order_relaxed);
+    if (stolen) stolen_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool WorkStealingPool::RunPendingTask() {
+    if (pending_.load(std::memory_order_relaxed) == 0) return false;
+    Task task;
+    if (tls_pool == this) {
+        if (TryPop(tls_queue, task)) {
+            Run(task, false);
+            return true;
+        }
+        if (!TrySteal(tls_queue + 1, task)) return false;
+    } else if (!TrySteal(next_queue_.load(std::memory_order_relaxed), task)) {
+        return false;
+    }
+    Run(task, true);
+    return true;
+}
+
+void WorkStealingPool::WorkerLoop(size_t index) {
+    tls_pool = this;
+    tls_queue = index;
+    Task task;
+    int idle_rounds = 0;
+    while (!stopping_.load(std::memory_order_relaxed)) {
+        if (TryPop(index, task)) {
+            Run(task, false);
+            idle_rounds = 0;
+            continue;
+        }
+        if (TrySteal(index + 1, task)) {
+            Run(task, true);
+            idle_rounds = 0;
+            continue;
+        }
+        if (++idle_rounds < kSpinRounds) {
+            std::this_thread::yield();
+            continue;
+        }
+        idle_rounds = 0;
+        sleeping_.fetch_add(1);
+        {
+            std::unique_lock lock(sleep_mutex_);
+            wake_.wait(lock, [this] { return stopping_.load() || pending_.load() > 0; });
+        }
+        sleeping_.fetch_sub(1);
+    }
+}
+
+void WorkStealingPool::ParallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) return;
+    if (workers_.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) body(i);
+        return;
+    }
+
+    // Shared with the helper tasks, which may still be queued after the loop is done; they touch body only
+    // while an index below count is left, and so only while this call is still waiting.
+    struct Loop {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        size_t count = 0;
+        const std::function<void(size_t)>* body = nullptr;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+
+        void Drain() {
+            for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+                 i = next.fetch_add(1, std::memory_order_relaxed)) {
+                try {
+                    (*body)(i);
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                }
+                done.fetch_add(1, std::memory_order_release);
+            }
+        }
+    };
+    auto loop = std::make_shared<Loop>();
+    loop->count = count;
+    loop->body = &body;
+
+    const size_t helpers = std::min(count, GetConcurrency()) - 1;
+    for (size_t h = 0; h < helpers; ++h) {
+        Submit([loop] { loop->Drain(); });
+    }
+    loop->Drain();
+    while (loop->done.load(std::memory_order_acquire) < count) {
+        if (!RunPendingTask()) std::this_thread::yield();
+    }
+    if (loop->error) std::rethrow_exception(loop->error);
+}
+
+WorkStealingPool::Stats WorkStealingPool::GetStats() const {
+    Stats stats;
+    stats.executed = executed_.load(std::memory_order_relaxed);
+    stats.stolen = stolen_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace mmorpg::game::systems::scheduling
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mmorpg::game::systems::scheduling {
+
+// [SEQUENCE: MVP19-369] Thread pool the system scheduler and parallel component iteration run on. Each worker
+// owns a deque: it pushes and pops its own tasks at the back, so a task and the tasks it spawns stay on the
+// core whose cache they warmed, and an idle worker steals the oldest task from the front of another's deque.
+// A thread waiting on work it submitted runs queued tasks instead of blocking, so tasks may wait on tasks.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    // worker_count threads besides the callers'; 0 runs everything on threads that wait on the pool
+    explicit WorkStealingPool(size_t worker_count);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // One worker per hardware thread, less the caller's
+    static size_t DefaultWorkerCount();
+
+    size_t GetWorkerCount() const { return workers_.size(); }
+    // Threads a parallel loop spreads over: the workers and the calling thread
+    size_t GetConcurrency() const { return workers_.size() + 1; }
+
+    // Queues a task: on the calling worker's own deque, or round-robin from any other thread. Tasks must not
+    // throw; ParallelFor and the scheduler catch for the work they run.
+    void Submit(Task task);
+
+    // Runs one queued task on the calling thread if there is one, for threads waiting on submitted work
+    bool RunPendingTask();
+
+    // Runs body(0) .. body(count - 1) across the pool and the calling thread, returning once all have run;
+    // the first exception a call threw is rethrown here. Fits world::BatchQueryOptions::parallel_for.
+    void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    struct Stats {
+        uint64_t executed = 0;   // Tasks run
+        uint64_t stolen = 0;     // Of those, taken from another thread's deque
+    };
+    Stats GetStats() const;
+
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool TryPop(size_t queue, Task& task);       // Newest first, from a worker's own deque
+    bool TrySteal(size_t start, Task& task);     // Oldest first, trying every deque from start on
+    void Run(Task& task, bool stolen);
+    void WorkerLoop(size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues_;   // One per worker; with no workers, one the callers share
+    std::vector<std::thread> workers_;
+
+    std::atomic<size_t> pending_{0};   // Tasks queued and not yet taken
+    std::atomic<size_t> sleeping_{0};
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<bool> stopping_{false};
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+
+    std::atomic<uint64_t> executed_{0};
+    std::atomic<uint64_t> stolen_{0};
+};
+
+} // namespace mmorpg::game::systems::scheduling
@@ -2,6 +2,7 @@
 
 #include "core/ecs/system.h"
 #include "game/components/status_effect_component.h"
+#include "game/systems/scheduling/system_access.h"
 
 namespace mmorpg::game::systems {
 
@@ -13,6 +14,12 @@ public:
     // [SEQUENCE: MVP9-29] Update active effects, check durations
     void Update(float delta_time) override;
 
+    // [SEQUENCE: MVP19-377] Component access for the system scheduler. Update only expires effects in place;
+    // ApplyEffect adds components and is not called from a scheduled update.
+    scheduling::SystemAccess GetComponentAccess() const {
+        return scheduling::SystemAccess().Writes<components::StatusEffectComponent>();
+    }
+
     // [SEQUENCE: MVP9-30] Apply a status effect to an entity
     void ApplyEffect(core::ecs::EntityId target_id, uint32_t effect_id, core::ecs::EntityId caster_id);
 
@@ -0,0 +1,357 @@
+#include "game/world/grid/flat_world_grid.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mmorpg::game::world::grid {
+
+namespace {
+constexpr uint32_t kLanes = 4;
+}
+
+FlatWorldGrid::FlatWorldGrid(const Config& config)
+    : config_(config),
+      inv_cell_size_(1.0f / config.cell_size),
+      cell_count_(static_cast<size_t>(std::max(config.grid_width, 0)) * static_cast<size_t>(std::max(config.grid_height, 0))),
+      cell_start_(cell_count_ + 1, 0),
+      xs_(kPadding, 0.0f),
+      ys_(kPadding, 0.0f),
+      zs_(kPadding, 0.0f),
+      layers_(kPadding, 0),
+      cursor_(cell_count_, 0) {
+    spdlog::info("FlatWorldGrid initialized: {}x{} cells of size {}",
+                 config_.grid_width, config_.grid_height, config_.cell_size);
+}
+
+// [SEQUENCE: MVP19-338] Staging: a dense array plus an index, so updates are O(1) and removal is swap-and-pop
+void FlatWorldGrid::AddEntity(core::ecs::EntityId entity, const core::utils::Vector3& position) {
+    std::lock_guard<std::mutex> lock(staging_mutex_);
+    auto [it, inserted] = staged_slot_.try_emplace(entity, static_cast<uint32_t>(staged_.size()));
+    if (inserted) {
+        staged_.push_back({entity, position.x, position.y, position.z, kAllLayers});
+    } else {
+        Staged& entry = staged_[it->second];
+        entry.x = position.x;
+        entry.y = position.y;
+        entry.z = position.z;
+    }
+    dirty_ = true;
+}
+
+// Entities not added yet have no layers to set
+void FlatWorldGrid::SetEntityLayers(core::ecs::EntityId entity, uint32_t layers) {
+    std::lock_guard<std::mutex> lock(staging_mutex_);
+    auto it = staged_slot_.find(entity);
+    if (it == staged_slot_.end()) {
+        return;
+    }
+    staged_[it->second].layers = layers;
+    dirty_ = true;
+}
+
+void FlatWorldGrid::RemoveEntity(core::ecs::EntityId entity) {
+    std::lock_guard<std::mutex> lock(staging_mutex_);
+    auto it = staged_slot_.find(entity);
+    if (it == staged_slot_.end()) {
+        return;
+    }
+    const uint32_t slot = it->second;
+    staged_slot_.erase(it);
+    if (slot + 1 != staged_.size()) {
+        staged_[slot] = staged_.back();
+        staged_slot_[staged_[slot].entity] = slot;
+    }
+    staged_.pop_back();
+    dirty_ = true;
+}
+
+void FlatWorldGrid::UpdateEntity(core::ecs::EntityId entity,
+                                 [[maybe_unused]] const core::utils::Vector3& old_pos,
+                                 const core::utils::Vector3& new_pos) {
+    AddEntity(entity, new_pos);
+}
+
+// [SEQUENCE: MVP19-339] Counting sort by cell key: count per cell, prefix sum into span starts, scatter staging
+// indices into their slots, then gather ids and positions slot by slot. Scattering one index and gathering in
+// order costs one random access per entity where scattering straight into the four arrays costs four. Stable,
+// so entities keep their staging order within a cell.
+void FlatWorldGrid::Commit() {
+    std::lock_guard<std::mutex> lock(staging_mutex_);
+    if (!dirty_) {
+        return;
+    }
+    dirty_ = false;
+
+    std::fill(cell_start_.begin(), cell_start_.end(), 0);
+    keys_.resize(staged_.size());
+    size_t outside = 0;
+    for (size_t i = 0; i < staged_.size(); ++i) {
+        const uint32_t key = CellKey(staged_[i].x, staged_[i].y);
+        keys_[i] = key;
+        if (key == kOutside) {
+            ++outside;
+            continue;
+        }
+        ++cell_start_[key + 1];
+    }
+    for (size_t cell = 1; cell <= cell_count_; ++cell) {
+        cell_start_[cell] += cell_start_[cell - 1];
+    }
+
+    const size_t count = cell_start_[cell_count_];
+    std::copy(cell_start_.begin(), cell_start_.end() - 1, cursor_.begin());
+    order_.resize(count);
+    for (size_t i = 0; i < staged_.size(); ++i) {
+        if (keys_[i] == kOutside) continue;
+        order_[cursor_[keys_[i]]++] = static_cast<uint32_t>(i);
+    }
+
+    ids_.resize(count);
+    xs_.resize(count + kPadding);
+    ys_.resize(count + kPadding);
+    zs_.resize(count + kPadding);
+    layers_.resize(count + kPadding);
+    for (size_t slot = 0; slot < count; ++slot) {
+        const Staged& entry = staged_[order_[slot]];
+        ids_[slot] = entry.entity;
+        xs_[slot] = entry.x;
+        ys_[slot] = entry.y;
+        zs_[slot] = entry.z;
+        layers_[slot] = entry.layers;
+    }
+
+    if (outside > 0) {
+        spdlog::debug("FlatWorldGrid: {} entities outside grid bounds not indexed", outside);
+    }
+}
+
+std::vector<core::ecs::EntityId> FlatWorldGrid::GetEntitiesInRadius(const core::utils::Vector3& center,
+                                                                    float radius) const {
+    std::vector<core::ecs::EntityId> result;
+    QueryRadius(center, radius, result);
+    return result;
+}
+
+std::vector<core::ecs::EntityId> FlatWorldGrid::GetEntitiesInBox(const core::utils::Vector3& min,
+                                                                 const core::utils::Vector3& max) const {
+    std::vector<core::ecs::EntityId> result;
+    QueryBox(min, max, result);
+    return result;
+}
+
+void FlatWorldGrid::QueryRadius(const core::utils::Vector3& center, float radius,
+                                std::vector<core::ecs::EntityId>& out) const {
+    ScanRadius(center, radius, kAllLayers, out);
+}
+
+// [SEQUENCE: MVP19-340] One span per grid row: each row's x range is narrowed to the circle's chord at that
+// row, so corner cells outside the circle are never read.
+void FlatWorldGrid::ScanRadius(const core::utils::Vector3& center, float radius, uint32_t layer_mask,
+                               std::vector<core::ecs::EntityId>& out) const {
+    if (!(radius >= 0.0f) || ids_.empty()) {
+        return;
+    }
+    const float radius_sq = radius * radius;
+    const int y0 = std::max(0, CellY(center.y - radius));
+    const int y1 = std::min(config_.grid_height - 1, CellY(center.y + radius));
+    for (int y = y0; y <= y1; ++y) {
+        const float row_min = config_.world_min_y + static_cast<float>(y) * config_.cell_size;
+        const float row_max = row_min + config_.cell_size;
+        const float dy = std::max({0.0f, row_min - center.y, center.y - row_max});
+        if (dy * dy > radius_sq) continue;
+        const float half_chord = std::sqrt(radius_sq - dy * dy);
+        const int x0 = std::max(0, CellX(center.x - half_chord));
+        const int x1 = std::min(config_.grid_width - 1, CellX(center.x + half_chord));
+        if (x0 > x1) continue;
+        const size_t row = static_cast<size_t>(y) * static_cast<size_t>(config_.grid_width);
+        FilterRadius(cell_start_[row + x0], cell_start_[row + x1 + 1], center, radius_sq, layer_mask, out);
+    }
+}
+
+void FlatWorldGrid::QueryBox(const core::utils::Vector3& min, const core::utils::Vector3& max,
+                             std::vector<core::ecs::EntityId>& out) const {
+    if (ids_.empty()) {
+        return;
+    }
+    const int x0 = std::max(0, CellX(min.x));
+    const int x1 = std::min(config_.grid_width - 1, CellX(max.x));
+    const int y0 = std::max(0, CellY(min.y));
+    const int y1 = std::min(config_.grid_height - 1, CellY(max.y));
+    if (x0 > x1) {
+        return;
+    }
+    for (int y = y0; y <= y1; ++y) {
+        const size_t row = static_cast<size_t>(y) * static_cast<size_t>(config_.grid_width);
+        FilterBox(cell_start_[row + x0], cell_start_[row + x1 + 1], min, max, out);
+    }
+}
+
+// [SEQUENCE: MVP19-362] Queries are counting-sorted by the cell holding their centre and run in that order, so
+// queries that share cells visit them back to back: the first brings the row spans into cache and the rest
+// filter them from there. (Scanning a cell's queries in lockstep, testing each four-entity block against all of
+// them, measured slower: a second read of a cached block costs less than routing hits back to their queries.)
+// [SEQUENCE: MVP19-428] Run serially, the batch appends each query's results straight into results.ids in the
+// sorted order. In parallel, the sorted queries are cut into tasks that run through options.parallel_for; each
+// task appends into its own buffer, capped at queries_per_task queries, and the buffers are then appended to
+// results.ids whole, in task order. Nothing is copied back into query order: ranges say where each query landed.
+void FlatWorldGrid::QueryRadiusBatch(std::span<const RadiusQuery> queries, SpatialQueryResults& results,
+                                     const BatchQueryOptions& options) const {
+    auto& scratch = results.scratch;
+    const size_t query_count = queries.size();
+    const size_t bucket_count = cell_count_ + 1;   // Cells, then centres outside the grid
+    scratch.keys.resize(query_count);
+    scratch.bucket_start.assign(bucket_count + 1, 0);
+    for (size_t i = 0; i < query_count; ++i) {
+        const uint32_t key = CellKey(queries[i].center.x, queries[i].center.y);
+        scratch.keys[i] = key == kOutside ? static_cast<uint32_t>(cell_count_) : key;
+        ++scratch.bucket_start[scratch.keys[i] + 1];
+    }
+    for (size_t b = 1; b <= bucket_count; ++b) {
+        scratch.bucket_start[b] += scratch.bucket_start[b - 1];
+    }
+    scratch.order.resize(query_count);
+    for (size_t i = 0; i < query_count; ++i) {
+        scratch.order[scratch.bucket_start[scratch.keys[i]]++] = static_cast<uint32_t>(i);
+    }
+    results.ranges.resize(query_count);
+    results.ids.clear();
+
+    const size_t per_task = std::max<size_t>(options.queries_per_task, 1);
+    const size_t task_count = (query_count + per_task - 1) / per_task;
+    if (!options.parallel_for || task_count <= 1) {
+        RunBatchTask(queries, scratch.order, results.ids, results.ranges);
+        return;
+    }
+
+    if (scratch.tasks.size() < task_count) {
+        scratch.tasks.resize(task_count);
+    }
+    auto task_order = [&](size_t t) {
+        const size_t begin = t * per_task;
+        return std::span<const uint32_t>(scratch.order).subspan(begin, std::min(per_task, query_count - begin));
+    };
+    options.parallel_for(task_count, [&](size_t t) {
+        scratch.tasks[t].ids.clear();
+        RunBatchTask(queries, task_order(t), scratch.tasks[t].ids, results.ranges);
+    });
+
+    size_t total = 0;
+    for (size_t t = 0; t < task_count; ++t) total += scratch.tasks[t].ids.size();
+    results.ids.reserve(total);
+    for (size_t t = 0; t < task_count; ++t) {
+        const auto base = static_cast<uint32_t>(results.ids.size());
+        for (const uint32_t index : task_order(t)) results.ranges[index].begin += base;
+        const auto& ids = scratch.tasks[t].ids;
+        results.ids.insert(results.ids.end(), ids.begin(), ids.end());
+    }
+}
+
+// Appends the results of the queries in order to ids, recording where each landed
+void FlatWorldGrid::RunBatchTask(std::span<const RadiusQuery> queries, std::span<const uint32_t> order,
+                                 std::vector<core::ecs::EntityId>& ids,
+                                 std::vector<SpatialQueryResults::Range>& ranges) const {
+    for (const uint32_t index : order) {
+        const RadiusQuery& query = queries[index];
+        const size_t begin = ids.size();
+        if (query.layer_mask != 0) {
+            ScanRadius(query.center, query.radius, query.layer_mask, ids);
+        }
+        ranges[index] = {static_cast<uint32_t>(begin), static_cast<uint32_t>(ids.size() - begin)};
+    }
+}
+
+std::pair<int, int> FlatWorldGrid::GetCellCoordinates(const core::utils::Vector3& position) const {
+    return {CellX(position.x), CellY(position.y)};
+}
+
+// Negative offsets (and NaN) map to -1 rather than truncating into cell 0, and large ones stop one cell past the
+// grid, so any coordinate converts without int overflow.
+int FlatWorldGrid::CellX(float x) const {
+    const float cell = (x - config_.world_min_x) * inv_cell_size_;
+    return cell >= 0.0f ? static_cast<int>(std::min(cell, static_cast<float>(config_.grid_width))) : -1;
+}
+
+int FlatWorldGrid::CellY(float y) const {
+    const float cell = (y - config_.world_min_y) * inv_cell_size_;
+    return cell >= 0.0f ? static_cast<int>(std::min(cell, static_cast<float>(config_.grid_height))) : -1;
+}
+
+uint32_t FlatWorldGrid::CellKey(float x, float y) const {
+    const int cx = CellX(x);
+    const int cy = CellY(y);
+    if (cx < 0 || cx >= config_.grid_width || cy < 0 || cy >= config_.grid_height) {
+        return kOutside;
+    }
+    return static_cast<uint32_t>(cy) * static_cast<uint32_t>(config_.grid_width) + static_cast<uint32_t>(cx);
+}
+
+// [SEQUENCE: MVP19-341] Distance filter over a span, four entities per step. Lanes past the span's end read
+// the next span or the padding and are masked off. Layers are only read under a narrower mask than kAllLayers.
+void FlatWorldGrid::FilterRadius(uint32_t begin, uint32_t end, const core::utils::Vector3& center, float radius_sq,
+                                 uint32_t layer_mask, std::vector<core::ecs::EntityId>& out) const {
+#if defined(__SSE2__)
+    const __m128 cx = _mm_set1_ps(center.x), cy = _mm_set1_ps(center.y), cz = _mm_set1_ps(center.z);
+    const __m128 limit = _mm_set1_ps(radius_sq);
+    const __m128i wanted = _mm_set1_epi32(static_cast<int>(layer_mask));
+    for (uint32_t k = begin; k < end; k += kLanes) {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(&xs_[k]), cx);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(&ys_[k]), cy);
+        const __m128 dz = _mm_sub_ps(_mm_loadu_ps(&zs_[k]), cz);
+        const __m128 dist_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(dist_sq, limit)));
+        if (layer_mask != kAllLayers) {
+            const __m128i layers = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&layers_[k]));
+            const __m128i off_layer = _mm_cmpeq_epi32(_mm_and_si128(layers, wanted), _mm_setzero_si128());
+            mask &= ~static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(off_layer)));
+        }
+        if (end - k < kLanes) mask &= (1u << (end - k)) - 1;
+        while (mask != 0) {
+            out.push_back(ids_[k + std::countr_zero(mask)]);
+            mask &= mask - 1;
+        }
+    }
+#else
+    for (uint32_t k = begin; k < end; ++k) {
+        const float dx = xs_[k] - center.x, dy = ys_[k] - center.y, dz = zs_[k] - center.z;
+        if (dx * dx + dy * dy + dz * dz <= radius_sq &&
+            (layer_mask == kAllLayers || (layers_[k] & layer_mask) != 0)) {
+            out.push_back(ids_[k]);
+        }
+    }
+#endif
+}
+
+void FlatWorldGrid::FilterBox(uint32_t begin, uint32_t end, const core::utils::Vector3& min,
+                              const core::utils::Vector3& max, std::vector<core::ecs::EntityId>& out) const {
+#if defined(__SSE2__)
+    const __m128 lo_x = _mm_set1_ps(min.x), lo_y = _mm_set1_ps(min.y), lo_z = _mm_set1_ps(min.z);
+    const __m128 hi_x = _mm_set1_ps(max.x), hi_y = _mm_set1_ps(max.y), hi_z = _mm_set1_ps(max.z);
+    for (uint32_t k = begin; k < end; k += kLanes) {
+        const __m128 x = _mm_loadu_ps(&xs_[k]), y = _mm_loadu_ps(&ys_[k]), z = _mm_loadu_ps(&zs_[k]);
+        const __m128 inside = _mm_and_ps(
+            _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(x, lo_x), _mm_cmple_ps(x, hi_x)),
+                       _mm_and_ps(_mm_cmpge_ps(y, lo_y), _mm_cmple_ps(y, hi_y))),
+            _mm_and_ps(_mm_cmpge_ps(z, lo_z), _mm_cmple_ps(z, hi_z)));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_ps(inside));
+        if (end - k < kLanes) mask &= (1u << (end - k)) - 1;
+        while (mask != 0) {
+            out.push_back(ids_[k + std::countr_zero(mask)]);
+            mask &= mask - 1;
+        }
+    }
+#else
+    for (uint32_t k = begin; k < end; ++k) {
+        if (xs_[k] >= min.x && xs_[k] <= max.x && ys_[k] >= min.y && ys_[k] <= max.y && zs_[k] >= min.z &&
+            zs_[k] <= max.z) {
+            out.push_back(ids_[k]);
+        }
+    }
+#endif
+}
+
+} // namespace mmorpg::game::world::grid
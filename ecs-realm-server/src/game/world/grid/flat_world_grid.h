@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "core/ecs/types.h"
+#include "core/utils/vector3.h"
+#include "game/world/ispatial_index.h"
+
+namespace mmorpg::game::world::grid {
+
+// [SEQUENCE: MVP19-337] A uniform 2D grid kept in flat arrays: the ISpatialIndex backend for dense worlds.
+//
+// All indexed entities sit in one contiguous array sorted by cell key (row-major, y * grid_width + x), with
+// their positions stored inline as separate x/y/z arrays, and cell k owns the span [cell_start[k],
+// cell_start[k + 1]). The cells of one grid row are neighbours in that order, so a query reads one span per
+// row and filters it four entities at a time with SSE, where WorldGrid locks every cell it touches and walks
+// hash-set nodes. Queries are exact: only entities within the radius or box come back.
+//
+// Add, Remove and Update only stage a change, from any thread. Commit() publishes them by rebuilding the arrays
+// with a counting sort in O(entities + cells); call it once per tick after movement. Between commits the arrays
+// are immutable, so any number of threads query without taking a lock. Commit must not overlap queries.
+class FlatWorldGrid : public ISpatialIndex {
+public:
+    // Same cell layout as WorldGrid::Config
+    struct Config {
+        float cell_size = 100.0f;
+        int grid_width = 100;
+        int grid_height = 100;
+        float world_min_x = 0.0f;
+        float world_min_y = 0.0f;
+    };
+
+    explicit FlatWorldGrid(const Config& config);
+
+    // Entities outside the grid are kept staged but not indexed until they move back inside
+    void AddEntity(core::ecs::EntityId entity, const core::utils::Vector3& position) override;
+    void RemoveEntity(core::ecs::EntityId entity) override;
+    void UpdateEntity(core::ecs::EntityId entity, const core::utils::Vector3& old_pos,
+                      const core::utils::Vector3& new_pos) override;
+    void Commit() override;
+    void SetEntityLayers(core::ecs::EntityId entity, uint32_t layers) override;
+
+    // Entities within radius of center, by 3D distance
+    std::vector<core::ecs::EntityId> GetEntitiesInRadius(const core::utils::Vector3& center, float radius) const override;
+    std::vector<core::ecs::EntityId> GetEntitiesInBox(const core::utils::Vector3& min,
+                                                      const core::utils::Vector3& max) const override;
+
+    // Runs the queries in cell order, so queries that share cells read them while they are cached
+    void QueryRadiusBatch(std::span<const RadiusQuery> queries, SpatialQueryResults& results,
+                          const BatchQueryOptions& options = {}) const override;
+
+    // Appending forms, for callers that reuse one buffer across many queries
+    void QueryRadius(const core::utils::Vector3& center, float radius, std::vector<core::ecs::EntityId>& out) const;
+    void QueryBox(const core::utils::Vector3& min, const core::utils::Vector3& max,
+                  std::vector<core::ecs::EntityId>& out) const;
+
+    std::pair<int, int> GetCellCoordinates(const core::utils::Vector3& position) const;
+    // Entities visible to queries, as of the last Commit
+    size_t GetEntityCount() const { return ids_.size(); }
+
+private:
+    struct Staged {
+        core::ecs::EntityId entity;
+        float x, y, z;
+        uint32_t layers;
+    };
+
+    static constexpr uint32_t kOutside = UINT32_MAX;
+    // SIMD loads read up to three entries past a span's end; the arrays carry that much padding
+    static constexpr size_t kPadding = 3;
+
+    int CellX(float x) const;
+    int CellY(float y) const;
+    uint32_t CellKey(float x, float y) const;
+    void ScanRadius(const core::utils::Vector3& center, float radius, uint32_t layer_mask,
+                    std::vector<core::ecs::EntityId>& out) const;
+    void FilterRadius(uint32_t begin, uint32_t end, const core::utils::Vector3& center, float radius_sq,
+                      uint32_t layer_mask, std::vector<core::ecs::EntityId>& out) const;
+    void FilterBox(uint32_t begin, uint32_t end, const core::utils::Vector3& min, const core::utils::Vector3& max,
+                   std::vector<core::ecs::EntityId>& out) const;
+    void RunBatchTask(std::span<const RadiusQuery> queries, std::span<const uint32_t> order,
+                      std::vector<core::ecs::EntityId>& ids, std::vector<SpatialQueryResults::Range>& ranges) const;
+
+    Config config_;
+    float inv_cell_size_;
+    size_t cell_count_;
+
+    // Staged state, guarded by staging_mutex_
+    mutable std::mutex staging_mutex_;
+    std::vector<Staged> staged_;
+    std::unordered_map<core::ecs::EntityId, uint32_t> staged_slot_;
+    bool dirty_ = false;
+
+    // Published state, rebuilt by Commit
+    std::vector<uint32_t> cell_start_;   // cell_count_ + 1 entries
+    std::vector<core::ecs::EntityId> ids_;
+    std::vector<float> xs_, ys_, zs_;    // ids_.size() + kPadding entries
+    std::vector<uint32_t> layers_;       // ids_.size() + kPadding entries
+
+    // Commit scratch
+    std::vector<uint32_t> keys_;
+    std::vector<uint32_t> cursor_;
+    std::vector<uint32_t> order_;   // Staging index of each published slot
+};
+
+} // namespace mmorpg::game::world::grid
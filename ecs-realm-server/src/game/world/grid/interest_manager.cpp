@@ -0,0 +1,379 @@
+#include "game/world/grid/interest_manager.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+namespace mmorpg::game::world::grid {
+
+InterestManager::InterestManager(const WorldGrid& grid, const Config& config)
+    : grid_(grid), config_(config) {}
+
+bool InterestManager::Covers(const std::pair<int, int>& window_center, const std::pair<int, int>& cell) const {
+    return std::abs(cell.first - window_center.first) <= config_.view_cell_range &&
+           std::abs(cell.second - window_center.second) <= config_.view_cell_range;
+}
+
+const core::utils::Vector3* InterestManager::FindPosition(core::ecs::EntityId entity) const {
+    auto it = entity_slots_.find(entity);
+    return it != entity_slots_.end() ? &slot_positions_[it->second] : nullptr;
+}
+
+void InterestManager::AddReason(ObserverState& state, core::ecs::EntityId target, uint8_t reason) {
+    auto [it, inserted] = state.target_index.try_emplace(target, static_cast<uint32_t>(state.targets.size()));
+    if (inserted) {
+        auto slot = entity_slots_.find(target);
+        if (slot == entity_slots_.end()) {
+            state.target_index.erase(it);
+            return;   // In the grid but never added here
+        }
+        state.targets.push_back(TargetState{target, slot->second});
+    }
+    state.targets[it->second].reasons |= reason;
+}
+
+void InterestManager::DropReason(ObserverState& state, core::ecs::EntityId target, uint8_t reason) {
+    auto it = state.target_index.find(target);
+    if (it == state.target_index.end()) return;
+    const uint32_t index = it->second;
+    state.targets[index].reasons &= static_cast<uint8_t>(~reason);
+    if (state.targets[index].reasons != 0) return;
+
+    // Swap-remove, fixing the index of the entry that moved
+    state.target_index.erase(it);
+    if (index + 1 != state.targets.size()) {
+        state.targets[index] = state.targets.back();
+        state.target_index[state.targets[index].entity] = index;
+    }
+    state.targets.pop_back();
+}
+
+void InterestManager::UnwatchCell(core::ecs::EntityId observer, const std::pair<int, int>& cell) {
+    auto it = watchers_.find(MakeCellKey(cell.first, cell.second));
+    if (it == watchers_.end()) return;
+    auto& list = it->second;
+    auto pos = std::find(list.begin(), list.end(), observer);
+    if (pos != list.end()) {
+        *pos = list.back();
+        list.pop_back();
+    }
+    if (list.empty()) {
+        watchers_.erase(it);
+    }
+}
+
+// [SEQUENCE: MVP19-186] Moves an observer's window from old_center to state.cell. Only the cells that entered or
+// left the window are read from the grid, so walking inside a crowd costs one row or column of cells.
+void InterestManager::WatchWindow(core::ecs::EntityId observer, ObserverState& state,
+                                  const std::pair<int, int>& old_center, bool had_window) {
+    const int range = config_.view_cell_range;
+    for (int x = state.cell.first - range; x <= state.cell.first + range; ++x) {
+        for (int y = state.cell.second - range; y <= state.cell.second + range; ++y) {
+            if (!grid_.IsValidCell(x, y) || (had_window && Covers(old_center, {x, y}))) continue;
+            watchers_[MakeCellKey(x, y)].push_back(observer);
+            for (auto entity : grid_.GetEntitiesInCell(x, y)) {
+                if (entity != observer) {
+                    AddReason(state, entity, kInView);
+                }
+            }
+        }
+    }
+    if (!had_window) return;
+
+    for (int x = old_center.first - range; x <= old_center.first + range; ++x) {
+        for (int y = old_center.second - range; y <= old_center.second + range; ++y) {
+            if (!grid_.IsValidCell(x, y) || Covers(state.cell, {x, y})) continue;
+            UnwatchCell(observer, {x, y});
+            for (auto entity : grid_.GetEntitiesInCell(x, y)) {
+                DropReason(state, entity, kInView);
+            }
+        }
+    }
+}
+
+void InterestManager::AddEntity(core::ecs::EntityId entity, const core::utils::Vector3& position) {
+    auto [slot, inserted] = entity_slots_.try_emplace(entity, 0);
+    if (inserted) {
+        if (free_slots_.empty()) {
+            slot->second = static_cast<uint32_t>(slot_positions_.size());
+            slot_positions_.emplace_back();
+        } else {
+            slot->second = free_slots_.back();
+            free_slots_.pop_back();
+        }
+    }
+    slot_positions_[slot->second] = position;
+    const auto cell = grid_.GetCellCoordinates(position);
+    auto it = watchers_.find(MakeCellKey(cell.first, cell.second));
+    if (it == watchers_.end()) return;
+    for (auto observer : it->second) {
+        if (observer != entity) {
+            AddReason(observers_[observer], entity, kInView);
+        }
+    }
+}
+
+void InterestManager::RemoveEntity(core::ecs::EntityId entity) {
+    RemoveObserver(entity);
+
+    auto slot = entity_slots_.find(entity);
+    if (slot == entity_slots_.end()) return;
+    const auto cell = grid_.GetCellCoordinates(slot_positions_[slot->second]);
+
+    auto watchers = watchers_.find(MakeCellKey(cell.first, cell.second));
+    if (watchers != watchers_.end()) {
+        for (auto observer : watchers->second) {
+            DropReason(observers_[observer], entity, kInView);
+        }
+    }
+    // The pinning observers forget the entity too, so a later SetPartyMembers/SetCurrentTarget does not look
+    // for it in pinned_by_
+    auto pinned = pinned_by_.find(entity);
+    if (pinned != pinned_by_.end()) {
+        for (auto observer : pinned->second) {
+            auto& state = observers_[observer];
+            DropReason(state, entity, kPinned);
+            std::erase(state.party, entity);
+            if (state.current_target == entity) {
+                state.current_target = core::ecs::INVALID_ENTITY;
+            }
+        }
+        pinned_by_.erase(pinned);
+    }
+    free_slots_.push_back(slot->second);
+    entity_slots_.erase(slot);
+}
+
+// [SEQUENCE: MVP19-187] Within a cell only the stored position changes. On a crossing, observers watching exactly
+// one of the two cells gain or lose the entity, and if the entity is itself an observer its window moves.
+void InterestManager::UpdateEntity(core::ecs::EntityId entity, const core::utils::Vector3& new_position) {
+    auto slot = entity_slots_.find(entity);
+    if (slot == entity_slots_.end()) {
+        AddEntity(entity, new_position);
+        return;
+    }
+    auto& position = slot_positions_[slot->second];
+    const auto old_cell = grid_.GetCellCoordinates(position);
+    const auto new_cell = grid_.GetCellCoordinates(new_position);
+    position = new_position;
+    if (old_cell == new_cell) return;
+    ++stats_.cell_crossings;
+
+    if (auto it = watchers_.find(MakeCellKey(old_cell.first, old_cell.second)); it != watchers_.end()) {
+        for (auto observer : it->second) {
+            auto& state = observers_[observer];
+            if (observer != entity && !Covers(state.cell, new_cell)) {
+                DropReason(state, entity, kInView);
+            }
+        }
+    }
+    if (auto it = watchers_.find(MakeCellKey(new_cell.first, new_cell.second)); it != watchers_.end()) {
+        for (auto observer : it->second) {
+            auto& state = observers_[observer];
+            if (observer != entity && !Covers(state.cell, old_cell)) {
+                AddReason(state, entity, kInView);
+            }
+        }
+    }
+
+    auto observer = observers_.find(entity);
+    if (observer != observers_.end()) {
+        const auto old_center = observer->second.cell;
+        observer->second.cell = new_cell;
+        WatchWindow(entity, observer->second, old_center, true);
+    }
+}
+
+void InterestManager::AddObserver(core::ecs::EntityId observer) {
+    const auto* position = FindPosition(observer);
+    if (!position || observers_.count(observer)) return;
+    auto& state = observers_[observer];
+    state.cell = grid_.GetCellCoordinates(*position);
+    WatchWindow(observer, state, state.cell, false);
+}
+
+void InterestManager::RemoveObserver(core::ecs::EntityId observer) {
+    auto it = observers_.find(observer);
+    if (it == observers_.end()) return;
+
+    SetPartyMembers(observer, {});
+    SetCurrentTarget(observer, core::ecs::INVALID_ENTITY);
+    const int range = config_.view_cell_range;
+    const auto center = it->second.cell;
+    for (int x = center.first - range; x <= center.first + range; ++x) {
+        for (int y = center.second - range; y <= center.second + range; ++y) {
+            UnwatchCell(observer, {x, y});
+        }
+    }
+    observers_.erase(it);
+}
+
+// [SEQUENCE: MVP19-188] Pins are tracked in both directions so removing a pinned entity is not a full scan.
+void InterestManager::SetPartyMembers(core::ecs::EntityId observer, const std::vector<core::ecs::EntityId>& members) {
+    auto it = observers_.find(observer);
+    if (it == observers_.end()) return;
+    auto& state = it->second;
+
+    for (auto member : state.party) {
+        DropReason(state, member, kPinnedParty);
+        UnpinFrom(member, observer);
+    }
+    state.party.clear();
+    for (auto member : members) {
+        if (member == observer || !entity_slots_.count(member)) continue;
+        state.party.push_back(member);
+        AddReason(state, member, kPinnedParty);
+        pinned_by_[member].push_back(observer);
+    }
+}
+
+void InterestManager::SetCurrentTarget(core::ecs::EntityId observer, core::ecs::EntityId target) {
+    auto it = observers_.find(observer);
+    if (it == observers_.end()) return;
+    auto& state = it->second;
+
+    if (state.current_target != core::ecs::INVALID_ENTITY) {
+        DropReason(state, state.current_target, kPinnedTarget);
+        UnpinFrom(state.current_target, observer);
+        state.current_target = core::ecs::INVALID_ENTITY;
+    }
+    if (target != core::ecs::INVALID_ENTITY && target != observer && entity_slots_.count(target)) {
+        state.current_target = target;
+        AddReason(state, target, kPinnedTarget);
+        pinned_by_[target].push_back(observer);
+    }
+}
+
+void InterestManager::UnpinFrom(core::ecs::EntityId entity, core::ecs::EntityId observer) {
+    auto pinned = pinned_by_.find(entity);
+    if (pinned == pinned_by_.end()) return;
+    auto it = std::find(pinned->second.begin(), pinned->second.end(), observer);
+    if (it != pinned->second.end()) {
+        pinned->second.erase(it);
+    }
+    if (pinned->second.empty()) pinned_by_.erase(pinned);
+}
+
+InterestTier InterestManager::ClassifyTier(float distance_squared) const {
+    for (size_t tier = 0; tier + 1 < config_.tiers.size(); ++tier) {
+        const float max_distance = config_.tiers[tier].max_distance;
+        if (distance_squared <= max_distance * max_distance) {
+            return static_cast<InterestTier>(tier);
+        }
+    }
+    return InterestTier::Low;
+}
+
+// [SEQUENCE: MVP19-189] Rank = ticks since last sent / tier interval, so a Low target deferred for long enough
+// eventually outranks a High one that was just sent; never-sent targets rank first. Each candidate is one 64-bit
+// key (rank float bits, then tier, then position in the set), so ordering is a plain integer compare and ties
+// resolve deterministically. Only the prefix the budget can plausibly cover is selected and sorted.
+void InterestManager::CollectDue(core::ecs::EntityId observer, uint32_t tick, const UpdateCostFn& cost,
+                                 std::vector<core::ecs::EntityId>& out) {
+    out.clear();
+    auto it = observers_.find(observer);
+    const auto* observer_position = FindPosition(observer);
+    if (it == observers_.end() || !observer_position) return;
+    auto& targets = it->second.targets;
+
+    const float view_distance_squared = config_.view_distance * config_.view_distance;
+    candidates_.clear();
+    for (uint32_t index = 0; index < targets.size(); ++index) {
+        const auto& state = targets[index];
+        InterestTier tier = InterestTier::High;
+        if ((state.reasons & kPinned) == 0) {
+            const auto& target_position = slot_positions_[state.slot];
+            const float dx = target_position.x - observer_position->x;
+            const float dy = target_position.y - observer_position->y;
+            const float dz = target_position.z - observer_position->z;
+            const float distance_squared = dx * dx + dy * dy + dz * dz;
+            if (distance_squared > view_distance_squared) continue;
+            tier = ClassifyTier(distance_squared);
+        }
+        const uint32_t interval = std::max<uint32_t>(1, config_.tiers[static_cast<size_t>(tier)].interval_ticks);
+        const float overdue = state.ever_sent
+            ? static_cast<float>(tick - state.last_sent_tick) / static_cast<float>(interval)
+            : std::numeric_limits<float>::max();
+        if (overdue >= 1.0f) {
+            uint32_t overdue_bits;   // Non-negative floats order like their bit patterns
+            std::memcpy(&overdue_bits, &overdue, sizeof(overdue_bits));
+            const uint64_t tier_rank = static_cast<uint64_t>(InterestTier::Count) - static_cast<uint64_t>(tier);
+            candidates_.push_back((static_cast<uint64_t>(overdue_bits) << 32) | (tier_rank << 28) |
+                                  (0x0FFFFFFFu - index));
+        }
+    }
+    stats_.due += candidates_.size();
+    if (candidates_.empty()) return;
+
+    const size_t average_cost = stats_.sent > 0 ? std::max<size_t>(1, stats_.bytes / stats_.sent) : 16;
+    size_t sorted = std::min(candidates_.size(), config_.budget_bytes_per_tick / average_cost + 8);
+    std::nth_element(candidates_.begin(), candidates_.begin() + (sorted - 1), candidates_.end(), std::greater<>());
+    std::sort(candidates_.begin(), candidates_.begin() + sorted, std::greater<>());
+
+    size_t budget = config_.budget_bytes_per_tick;
+    size_t taken = 0;
+    for (; taken < candidates_.size(); ++taken) {
+        if (taken == sorted) {   // Cheaper updates than estimated: order the rest too
+            std::sort(candidates_.begin() + sorted, candidates_.end(), std::greater<>());
+            sorted = candidates_.size();
+        }
+        auto& state = targets[0x0FFFFFFFu - static_cast<uint32_t>(candidates_[taken] & 0x0FFFFFFFu)];
+        const size_t bytes = cost(state.entity);
+        // The first update always goes out so an oversized one cannot starve the client forever
+        if (bytes > budget && taken > 0) break;
+        budget -= std::min(bytes, budget);
+        state.ever_sent = true;
+        state.last_sent_tick = tick;
+        out.push_back(state.entity);
+        stats_.bytes += bytes;
+    }
+    stats_.deferred += candidates_.size() - taken;
+    stats_.sent += out.size();
+}
+
+void InterestManager::GetInterestedObservers(core::ecs::EntityId target, std::vector<core::ecs::EntityId>& out) const {
+    out.clear();
+    const auto* position = FindPosition(target);
+    if (!position) return;
+
+    const auto cell = grid_.GetCellCoordinates(*position);
+    if (auto it = watchers_.find(MakeCellKey(cell.first, cell.second)); it != watchers_.end()) {
+        for (auto observer : it->second) {
+            if (observer != target) {
+                out.push_back(observer);
+            }
+        }
+    }
+    if (auto it = pinned_by_.find(target); it != pinned_by_.end()) {
+        for (auto observer : it->second) {
+            const auto& state = observers_.at(observer);
+            auto index = state.target_index.find(target);
+            if (index != state.target_index.end() && (state.targets[index->second].reasons & kInView) == 0 &&
+                std::find(out.begin(), out.end(), observer) == out.end()) {
+                out.push_back(observer);
+            }
+        }
+    }
+}
+
+bool InterestManager::IsInterested(core::ecs::EntityId observer, core::ecs::EntityId target) const {
+    auto it = observers_.find(observer);
+    return it != observers_.end() && it->second.target_index.count(target) > 0;
+}
+
+size_t InterestManager::GetInterestSetSize(core::ecs::EntityId observer) const {
+    auto it = observers_.find(observer);
+    return it != observers_.end() ? it->second.targets.size() : 0;
+}
+
+std::vector<core::ecs::EntityId> InterestManager::GetObservers() const {
+    std::vector<core::ecs::EntityId> result;
+    result.reserve(observers_.size());
+    for (const auto& [observer, state] : observers_) {
+        result.push_back(observer);
+    }
+    return result;
+}
+
+} // namespace mmorpg::game::world::grid
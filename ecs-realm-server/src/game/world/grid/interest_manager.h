@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "core/ecs/types.h"
+#include "core/utils/vector3.h"
+#include "game/world/grid/world_grid.h"
+
+namespace mmorpg::game::world::grid {
+
+// [SEQUENCE: MVP19-183] Update-rate tiers. High is every sync tick; party members and the current target are
+// always High regardless of distance.
+enum class InterestTier : uint8_t {
+    High,
+    Medium,
+    Low,
+    Count
+};
+
+// [SEQUENCE: MVP19-184] Per-observer interest sets kept incrementally on top of a WorldGrid.
+//
+// An observer is interested in every entity in the square of cells within view_cell_range of its own cell.
+// The sets only change when an entity crosses a cell boundary: a target entering or leaving a cell touches the
+// observers watching that cell, and an observer moving its window reads just the cells that came into view from
+// the grid. Each sync tick CollectDue ranks an observer's targets by how overdue they are for their tier and
+// takes them in that order until the client's byte budget for the tick is spent; whatever does not fit stays
+// due and ranks higher next tick.
+//
+// The grid must already hold an entity's new position when UpdateEntity is called for it. Not thread-safe;
+// driven from the simulation thread like the grid's owner.
+class InterestManager {
+public:
+    struct TierConfig {
+        float max_distance;        // Beyond this the next tier applies
+        uint32_t interval_ticks;   // Send at most every N sync ticks
+    };
+
+    struct Config {
+        int view_cell_range = 1;                   // Window of (2r+1)^2 cells around the observer
+        float view_distance = 150.0f;              // Targets further away are not sent (unless pinned)
+        std::array<TierConfig, static_cast<size_t>(InterestTier::Count)> tiers = {{
+            {40.0f, 1},     // 60 Hz at a 60 Hz sync rate
+            {90.0f, 3},     // 20 Hz
+            {150.0f, 12},   // 5 Hz
+        }};
+        size_t budget_bytes_per_tick = 1600;       // ~96 KB/s at 60 Hz
+    };
+
+    // Bytes one update for target will cost on the wire. Called only for targets that are due, in rank order.
+    using UpdateCostFn = std::function<size_t(core::ecs::EntityId target)>;
+
+    struct Stats {
+        uint64_t due = 0;                // Targets whose tier interval had elapsed
+        uint64_t sent = 0;
+        uint64_t deferred = 0;           // Due but over the byte budget
+        uint64_t bytes = 0;
+        uint64_t cell_crossings = 0;
+    };
+
+    InterestManager(const WorldGrid& grid, const Config& config);
+
+    // Any entity the grid tracks. Observers are additionally registered with AddObserver.
+    void AddEntity(core::ecs::EntityId entity, const core::utils::Vector3& position);
+    void RemoveEntity(core::ecs::EntityId entity);
+    void UpdateEntity(core::ecs::EntityId entity, const core::utils::Vector3& new_position);
+
+    void AddObserver(core::ecs::EntityId observer);
+    void RemoveObserver(core::ecs::EntityId observer);
+
+    // Pinned targets stay in the set at High tier wherever they are.
+    void SetPartyMembers(core::ecs::EntityId observer, const std::vector<core::ecs::EntityId>& members);
+    void SetCurrentTarget(core::ecs::EntityId observer, core::ecs::EntityId target);
+
+    // [SEQUENCE: MVP19-185] Targets to send to observer this tick, highest rank first, within the byte budget.
+    void CollectDue(core::ecs::EntityId observer, uint32_t tick, const UpdateCostFn& cost,
+                    std::vector<core::ecs::EntityId>& out);
+
+    // Observers whose set currently contains target, e.g. for changes that must not wait for the tier.
+    void GetInterestedObservers(core::ecs::EntityId target, std::vector<core::ecs::EntityId>& out) const;
+
+    bool IsInterested(core::ecs::EntityId observer, core::ecs::EntityId target) const;
+    size_t GetInterestSetSize(core::ecs::EntityId observer) const;
+    std::vector<core::ecs::EntityId> GetObservers() const;
+
+    const Stats& GetStats() const { return stats_; }
+    void ResetStats() { stats_ = {}; }
+
+private:
+    using CellKey = uint64_t;
+
+    static constexpr uint8_t kInView = 1u << 0;
+    static constexpr uint8_t kPinnedParty = 1u << 1;
+    static constexpr uint8_t kPinnedTarget = 1u << 2;
+    static constexpr uint8_t kPinned = kPinnedParty | kPinnedTarget;
+
+    struct TargetState {
+        core::ecs::EntityId entity;
+        uint32_t slot;              // Into slot_positions_
+        uint8_t reasons = 0;
+        bool ever_sent = false;
+        uint32_t last_sent_tick = 0;
+    };
+
+    // Targets are a dense vector scanned every tick; the index is only touched when membership changes.
+    struct ObserverState {
+        std::pair<int, int> cell;
+        std::vector<TargetState> targets;
+        std::unordered_map<core::ecs::EntityId, uint32_t> target_index;
+        std::vector<core::ecs::EntityId> party;
+        core::ecs::EntityId current_target = core::ecs::INVALID_ENTITY;
+    };
+
+    static CellKey MakeCellKey(int x, int y) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+    bool Covers(const std::pair<int, int>& window_center, const std::pair<int, int>& cell) const;
+    void WatchWindow(core::ecs::EntityId observer, ObserverState& state, const std::pair<int, int>& old_center,
+                     bool had_window);
+    void UnwatchCell(core::ecs::EntityId observer, const std::pair<int, int>& cell);
+    void AddReason(ObserverState& state, core::ecs::EntityId target, uint8_t reason);
+    void DropReason(ObserverState& state, core::ecs::EntityId target, uint8_t reason);
+    // Takes observer off entity's pinned_by_ list; a no-op if it is not there
+    void UnpinFrom(core::ecs::EntityId entity, core::ecs::EntityId observer);
+    InterestTier ClassifyTier(float distance_squared) const;
+    const core::utils::Vector3* FindPosition(core::ecs::EntityId entity) const;
+
+    const WorldGrid& grid_;
+    Config config_;
+    std::unordered_map<core::ecs::EntityId, uint32_t> entity_slots_;
+    std::vector<core::utils::Vector3> slot_positions_;
+    std::vector<uint32_t> free_slots_;
+    std::unordered_map<core::ecs::EntityId, ObserverState> observers_;
+    std::unordered_map<CellKey, std::vector<core::ecs::EntityId>> watchers_;          // Observers per cell
+    std::unordered_map<core::ecs::EntityId, std::vector<core::ecs::EntityId>> pinned_by_;   // Target -> observers
+    std::vector<uint64_t> candidates_;   // Rank keys, see CollectDue
+    Stats stats_;
+};
+
+} // namespace mmorpg::game::world::grid
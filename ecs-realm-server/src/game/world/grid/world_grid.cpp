@@ -127,6 +127,27 @@ std::vector<core::ecs::EntityId> WorldGrid::GetEntitiesInRadius(
     return result;
 }
 
+void WorldGrid::QueryRadiusBatch(std::span<const RadiusQuery> queries, SpatialQueryResults& results,
+                                 [[maybe_unused]] const BatchQueryOptions& options) const {
+    results.ranges.resize(queries.size());
+    results.ids.clear();
+    std::vector<std::pair<int, int>> cells_to_check;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const auto begin = static_cast<uint32_t>(results.ids.size());
+        if (queries[i].layer_mask != 0) {
+            cells_to_check.clear();
+            GetCellsInRadius(queries[i].center, queries[i].radius, cells_to_check);
+            for (const auto& [cell_x, cell_y] : cells_to_check) {
+                if (!IsValidCell(cell_x, cell_y)) continue;
+                std::lock_guard<std::mutex> lock(grid_[cell_x][cell_y]->mutex);
+                results.ids.insert(results.ids.end(), grid_[cell_x][cell_y]->entities.begin(),
+                                   grid_[cell_x][cell_y]->entities.end());
+            }
+        }
+        results.ranges[i] = {begin, static_cast<uint32_t>(results.ids.size()) - begin};
+    }
+}
+
 // [SEQUENCE: MVP3-15] Implements GetEntitiesInBox for rectangular queries.
 std::vector<core::ecs::EntityId> WorldGrid::GetEntitiesInBox(
     const core::utils::Vector3& min, const core::utils::Vector3& max) const {
@@ -5,13 +5,15 @@
 #include <unordered_map>
 #include <array>
 #include <mutex>
+#include <memory>
 #include "core/ecs/types.h"
 #include "core/utils/vector3.h"
+#include "game/world/ispatial_index.h"
 
 namespace mmorpg::game::world::grid {
 
 // [SEQUENCE: MVP3-1] Defines the WorldGrid class, a spatial partitioning structure using a uniform 2D grid.
-class WorldGrid {
+class WorldGrid : public ISpatialIndex {
 public:
     // [SEQUENCE: MVP3-2] Configuration struct for WorldGrid initialization.
     struct Config {
@@ -25,20 +27,25 @@ public:
     
     // [SEQUENCE: MVP3-3] Constructor and destructor.
     explicit WorldGrid(const Config& config);
-    ~WorldGrid() = default;
+    ~WorldGrid() override = default;
     
     // [SEQUENCE: MVP3-4] Public API for entity management in the grid.
-    void AddEntity(core::ecs::EntityId entity, const core::utils::Vector3& position);
-    void RemoveEntity(core::ecs::EntityId entity);
+    void AddEntity(core::ecs::EntityId entity, const core::utils::Vector3& position) override;
+    void RemoveEntity(core::ecs::EntityId entity) override;
     void UpdateEntity(core::ecs::EntityId entity, const core::utils::Vector3& old_pos, 
-                     const core::utils::Vector3& new_pos);
+                     const core::utils::Vector3& new_pos) override;
     
     // [SEQUENCE: MVP3-5] Public API for performing spatial queries.
     std::vector<core::ecs::EntityId> GetEntitiesInRadius(
-        const core::utils::Vector3& center, float radius) const;
+        const core::utils::Vector3& center, float radius) const override;
     
     std::vector<core::ecs::EntityId> GetEntitiesInBox(
-        const core::utils::Vector3& min, const core::utils::Vector3& max) const;
+        const core::utils::Vector3& min, const core::utils::Vector3& max) const override;
+    
+    // [SEQUENCE: MVP19-363] Same broad phase as GetEntitiesInRadius, appended straight into the shared buffer.
+    // Layer masks other than 0 match everything, since the grid keeps no layers.
+    void QueryRadiusBatch(std::span<const RadiusQuery> queries, SpatialQueryResults& results,
+                          const BatchQueryOptions& options = {}) const override;
     
     std::vector<core::ecs::EntityId> GetEntitiesInCell(int x, int y) const;
     
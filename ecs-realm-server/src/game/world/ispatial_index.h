@@ -2,6 +2,8 @@
 
 #include "core/ecs/types.h"
 #include "core/utils/vector3.h"
+#include "game/world/spatial_query_batch.h"
+#include <span>
 #include <vector>
 
 namespace mmorpg::game::world {
@@ -13,9 +15,32 @@ public:
     virtual void AddEntity(core::ecs::EntityId entity, const core::utils::Vector3& position) = 0;
     virtual void RemoveEntity(core::ecs::EntityId entity) = 0;
     virtual void UpdateEntity(core::ecs::EntityId entity, const core::utils::Vector3& old_pos, const core::utils::Vector3& new_pos) = 0;
+    // [SEQUENCE: MVP19-336] Publishes the changes made since the last call to queries. Indexes that apply changes
+    // immediately have nothing to do; call it once per tick after movement either way.
+    virtual void Commit() {}
 
     virtual std::vector<core::ecs::EntityId> GetEntitiesInRadius(const core::utils::Vector3& center, float radius) const = 0;
     virtual std::vector<core::ecs::EntityId> GetEntitiesInBox(const core::utils::Vector3& min, const core::utils::Vector3& max) const = 0;
+
+    // [SEQUENCE: MVP19-361] Layers a batch query's layer_mask is matched against. Indexes that do not track
+    // layers ignore this and keep every entity on every layer.
+    virtual void SetEntityLayers([[maybe_unused]] core::ecs::EntityId entity, [[maybe_unused]] uint32_t layers) {}
+
+    // Answers every query into results, replacing its contents; query i finds what GetEntitiesInRadius would.
+    // The default runs the queries one by one; indexes override it to share work across queries.
+    virtual void QueryRadiusBatch(std::span<const RadiusQuery> queries, SpatialQueryResults& results,
+                                  [[maybe_unused]] const BatchQueryOptions& options = {}) const {
+        results.ranges.resize(queries.size());
+        results.ids.clear();
+        for (size_t i = 0; i < queries.size(); ++i) {
+            const auto begin = static_cast<uint32_t>(results.ids.size());
+            if (queries[i].layer_mask != 0) {
+                const auto found = GetEntitiesInRadius(queries[i].center, queries[i].radius);
+                results.ids.insert(results.ids.end(), found.begin(), found.end());
+            }
+            results.ranges[i] = {begin, static_cast<uint32_t>(results.ids.size()) - begin};
+        }
+    }
 };
 
 } // namespace mmorpg::game::world
@@ -0,0 +1,525 @@
+#include "game/world/octree/loose_octree.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <bit>
+#include <mutex>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mmorpg::game::world::octree {
+
+namespace {
+
+constexpr uint32_t kLanes = 4;
+
+int Octant(float cx, float cy, float cz, const core::utils::Vector3& p) {
+    return (p.x > cx ? 1 : 0) | (p.y > cy ? 2 : 0) | (p.z > cz ? 4 : 0);
+}
+
+// Keeps 1/d finite for axis-parallel rays, as in the hit validation slab test
+float SafeInverse(float d) {
+    return std::abs(d) > 1e-12f ? 1.0f / d : (d < 0.0f ? -1e12f : 1e12f);
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-348] Stackless depth-first walk. Children are consecutive and blocks start at 1 + 8k, so a
+// node is the last of its siblings when (index - 1) % 8 == 7; from there the walk climbs until it finds a node
+// with a next sibling, or reaches the root and stops.
+template <typename NodeTest, typename LeafVisit>
+void LooseOctree::Traverse(NodeTest&& node_test, LeafVisit&& leaf_visit) const {
+    uint32_t index = 0;
+    while (true) {
+        const Node& node = nodes_[index];
+        if (node_test(node)) {
+            if (node.first_child != kNone) {
+                index = node.first_child;
+                continue;
+            }
+            leaf_visit(node);
+        }
+        while (index != 0 && ((index - 1) & 7) == 7) {
+            index = nodes_[index].parent;
+        }
+        if (index == 0) return;
+        ++index;
+    }
+}
+
+template <typename EntityVisit>
+void LooseOctree::ForEachInLeaf(const Node& node, EntityVisit&& visit) const {
+    uint32_t remaining = node.count;
+    for (uint32_t b = node.first_bucket; b != kNone && remaining > 0; b = buckets_[b].next) {
+        const Bucket& bucket = buckets_[b];
+        const uint32_t n = std::min(remaining, kBucketCapacity);
+        for (uint32_t k = 0; k < n; ++k) {
+            visit(bucket.ids[k], bucket.xs[k], bucket.ys[k], bucket.zs[k]);
+        }
+        remaining -= n;
+    }
+}
+
+LooseOctree::LooseOctree(const Config& config)
+    : config_(config), loose_scale_(std::max(config.looseness, 1.0f)) {
+    Node root;
+    root.cx = (config.world_min.x + config.world_max.x) * 0.5f;
+    root.cy = (config.world_min.y + config.world_max.y) * 0.5f;
+    root.cz = (config.world_min.z + config.world_max.z) * 0.5f;
+    root.hx = (config.world_max.x - config.world_min.x) * 0.5f;
+    root.hy = (config.world_max.y - config.world_min.y) * 0.5f;
+    root.hz = (config.world_max.z - config.world_min.z) * 0.5f;
+    nodes_.push_back(root);
+
+    spdlog::info("LooseOctree initialized: bounds ({}, {}, {}) to ({}, {}, {}), max depth {}, looseness {}",
+                 config.world_min.x, config.world_min.y, config.world_min.z,
+                 config.world_max.x, config.world_max.y, config.world_max.z,
+                 config.max_depth, loose_scale_);
+}
+
+void LooseOctree::AddEntity(core::ecs::EntityId entity, const core::utils::Vector3& position) {
+    std::unique_lock lock(mutex_);
+    if (!InWorld(position)) {
+        spdlog::warn("Entity {} position ({}, {}, {}) outside world bounds", entity, position.x, position.y, position.z);
+        return;
+    }
+    if (auto it = locations_.find(entity); it != locations_.end()) {
+        const Location location = it->second;
+        RemoveAt(location);
+        locations_.erase(it);
+        TryMerge(nodes_[location.node].parent);
+    }
+    Insert(0, entity, position);
+}
+
+void LooseOctree::RemoveEntity(core::ecs::EntityId entity) {
+    std::unique_lock lock(mutex_);
+    auto it = locations_.find(entity);
+    if (it == locations_.end()) {
+        return;
+    }
+    const Location location = it->second;
+    RemoveAt(location);
+    locations_.erase(it);
+    TryMerge(nodes_[location.node].parent);
+}
+
+// [SEQUENCE: MVP19-349] The common case is one hash lookup, a bounds check and three stores. Past the loose
+// bounds the entity climbs to the nearest ancestor whose box holds it and descends from there.
+void LooseOctree::UpdateEntity(core::ecs::EntityId entity,
+                               [[maybe_unused]] const core::utils::Vector3& old_pos,
+                               const core::utils::Vector3& new_pos) {
+    std::unique_lock lock(mutex_);
+    auto it = locations_.find(entity);
+    if (it == locations_.end()) {
+        if (InWorld(new_pos)) Insert(0, entity, new_pos);
+        return;
+    }
+    const Location location = it->second;
+    const Node& leaf = nodes_[location.node];
+    if (LooseContains(leaf, new_pos) && InWorld(new_pos)) {
+        uint32_t slot;
+        Bucket& bucket = BucketAt(leaf, location.index, slot);
+        bucket.xs[slot] = new_pos.x;
+        bucket.ys[slot] = new_pos.y;
+        bucket.zs[slot] = new_pos.z;
+        return;
+    }
+
+    RemoveAt(location);
+    locations_.erase(it);
+    if (InWorld(new_pos)) {
+        ++stats_.relocations;
+        uint32_t start = location.node;
+        while (start != 0) {
+            const Node& node = nodes_[start];
+            if (std::abs(new_pos.x - node.cx) <= node.hx && std::abs(new_pos.y - node.cy) <= node.hy &&
+                std::abs(new_pos.z - node.cz) <= node.hz) {
+                break;
+            }
+            start = node.parent;
+        }
+        Insert(start, entity, new_pos);
+    }
+    TryMerge(nodes_[location.node].parent);
+}
+
+std::vector<core::ecs::EntityId> LooseOctree::GetEntitiesInRadius(const core::utils::Vector3& center,
+                                                                  float radius) const {
+    std::vector<core::ecs::EntityId> results;
+    const float radius_sq = radius * radius;
+    std::shared_lock lock(mutex_);
+    Traverse(
+        [&](const Node& node) {
+            const float dx = std::max(std::abs(center.x - node.cx) - node.hx * loose_scale_, 0.0f);
+            const float dy = std::max(std::abs(center.y - node.cy) - node.hy * loose_scale_, 0.0f);
+            const float dz = std::max(std::abs(center.z - node.cz) - node.hz * loose_scale_, 0.0f);
+            return dx * dx + dy * dy + dz * dz <= radius_sq;
+        },
+        [&](const Node& node) { FilterRadius(node, center, radius_sq, results); });
+    return results;
+}
+
+std::vector<core::ecs::EntityId> LooseOctree::GetEntitiesInBox(const core::utils::Vector3& min,
+                                                               const core::utils::Vector3& max) const {
+    std::vector<core::ecs::EntityId> results;
+    std::shared_lock lock(mutex_);
+    Traverse(
+        [&](const Node& node) {
+            const float hx = node.hx * loose_scale_, hy = node.hy * loose_scale_, hz = node.hz * loose_scale_;
+            return !(max.x < node.cx - hx || min.x > node.cx + hx || max.y < node.cy - hy || min.y > node.cy + hy ||
+                     max.z < node.cz - hz || min.z > node.cz + hz);
+        },
+        [&](const Node& node) { FilterBox(node, min, max, results); });
+    return results;
+}
+
+// [SEQUENCE: MVP19-350] Cone test by signed distance to the cone's surface, perp * cos - along * sin. Behind the
+// apex that value underestimates the true distance, so culling nodes with it never drops an entity.
+std::vector<core::ecs::EntityId> LooseOctree::GetEntitiesInFrustum(const core::utils::Vector3& origin,
+                                                                   const core::utils::Vector3& direction, float fov,
+                                                                   float near_dist, float far_dist) const {
+    std::vector<core::ecs::EntityId> results;
+    const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+    if (length <= 0.0f || !(fov > 0.0f) || far_dist < near_dist) {
+        return results;
+    }
+    const float ux = direction.x / length, uy = direction.y / length, uz = direction.z / length;
+    const float half_angle = std::min(fov * 0.5f, 1.5707f);
+    const float sin_half = std::sin(half_angle), cos_half = std::cos(half_angle);
+    auto in_cone = [&](float x, float y, float z, float radius) {
+        const float vx = x - origin.x, vy = y - origin.y, vz = z - origin.z;
+        const float along = vx * ux + vy * uy + vz * uz;
+        if (along < near_dist - radius || along > far_dist + radius) return false;
+        const float perp = std::sqrt(std::max(vx * vx + vy * vy + vz * vz - along * along, 0.0f));
+        return perp * cos_half - along * sin_half <= radius;
+    };
+
+    std::shared_lock lock(mutex_);
+    Traverse(
+        [&](const Node& node) {
+            const float hx = node.hx * loose_scale_, hy = node.hy * loose_scale_, hz = node.hz * loose_scale_;
+            return in_cone(node.cx, node.cy, node.cz, std::sqrt(hx * hx + hy * hy + hz * hz) + config_.entity_radius);
+        },
+        [&](const Node& node) {
+            ForEachInLeaf(node, [&](core::ecs::EntityId id, float x, float y, float z) {
+                if (in_cone(x, y, z, config_.entity_radius)) results.push_back(id);
+            });
+        });
+    return results;
+}
+
+// [SEQUENCE: MVP19-351] Slab test against each node's loose box grown by entity_radius, then the distance from
+// each entity to the segment.
+std::vector<core::ecs::EntityId> LooseOctree::GetEntitiesAlongRay(const core::utils::Vector3& origin,
+                                                                  const core::utils::Vector3& direction,
+                                                                  float max_distance) const {
+    std::vector<core::ecs::EntityId> results;
+    const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+    if (length <= 0.0f || !(max_distance >= 0.0f)) {
+        return results;
+    }
+    const float ux = direction.x / length, uy = direction.y / length, uz = direction.z / length;
+    const float ix = SafeInverse(ux), iy = SafeInverse(uy), iz = SafeInverse(uz);
+    const float radius = config_.entity_radius;
+    const float radius_sq = radius * radius;
+    std::vector<std::pair<float, core::ecs::EntityId>> hits;
+
+    std::shared_lock lock(mutex_);
+    Traverse(
+        [&](const Node& node) {
+            const float hx = node.hx * loose_scale_ + radius, hy = node.hy * loose_scale_ + radius,
+                        hz = node.hz * loose_scale_ + radius;
+            const float x0 = (node.cx - hx - origin.x) * ix, x1 = (node.cx + hx - origin.x) * ix;
+            const float y0 = (node.cy - hy - origin.y) * iy, y1 = (node.cy + hy - origin.y) * iy;
+            const float z0 = (node.cz - hz - origin.z) * iz, z1 = (node.cz + hz - origin.z) * iz;
+            const float near = std::max({0.0f, std::min(x0, x1), std::min(y0, y1), std::min(z0, z1)});
+            const float far = std::min({max_distance, std::max(x0, x1), std::max(y0, y1), std::max(z0, z1)});
+            return near <= far;
+        },
+        [&](const Node& node) {
+            ForEachInLeaf(node, [&](core::ecs::EntityId id, float x, float y, float z) {
+                const float vx = x - origin.x, vy = y - origin.y, vz = z - origin.z;
+                const float t = std::clamp(vx * ux + vy * uy + vz * uz, 0.0f, max_distance);
+                const float dx = vx - ux * t, dy = vy - uy * t, dz = vz - uz * t;
+                if (dx * dx + dy * dy + dz * dz <= radius_sq) hits.emplace_back(t, id);
+            });
+        });
+    lock.unlock();
+
+    std::sort(hits.begin(), hits.end());
+    results.reserve(hits.size());
+    for (const auto& hit : hits) results.push_back(hit.second);
+    return results;
+}
+
+size_t LooseOctree::GetEntityCount() const {
+    std::shared_lock lock(mutex_);
+    return locations_.size();
+}
+
+void LooseOctree::GetTreeStats(size_t& total_nodes, size_t& leaf_nodes, size_t& entities) const {
+    total_nodes = 0;
+    leaf_nodes = 0;
+    entities = 0;
+    std::shared_lock lock(mutex_);
+    Traverse(
+        [&](const Node&) {
+            ++total_nodes;
+            return true;
+        },
+        [&](const Node& node) {
+            ++leaf_nodes;
+            entities += node.count;
+        });
+}
+
+LooseOctree::Stats LooseOctree::GetStats() const {
+    std::shared_lock lock(mutex_);
+    return stats_;
+}
+
+// [SEQUENCE: MVP19-352] Leaf filters for the ISpatialIndex queries, four entities per step over each bucket.
+// Buckets are fixed-size, so lanes past the leaf's count read stale slots and are masked off.
+void LooseOctree::FilterRadius(const Node& node, const core::utils::Vector3& center, float radius_sq,
+                               std::vector<core::ecs::EntityId>& out) const {
+#if defined(__SSE2__)
+    const __m128 cx = _mm_set1_ps(center.x), cy = _mm_set1_ps(center.y), cz = _mm_set1_ps(center.z);
+    const __m128 limit = _mm_set1_ps(radius_sq);
+    uint32_t remaining = node.count;
+    for (uint32_t b = node.first_bucket; b != kNone && remaining > 0; b = buckets_[b].next) {
+        const Bucket& bucket = buckets_[b];
+        const uint32_t n = std::min(remaining, kBucketCapacity);
+        for (uint32_t k = 0; k < n; k += kLanes) {
+            const __m128 dx = _mm_sub_ps(_mm_loadu_ps(&bucket.xs[k]), cx);
+            const __m128 dy = _mm_sub_ps(_mm_loadu_ps(&bucket.ys[k]), cy);
+            const __m128 dz = _mm_sub_ps(_mm_loadu_ps(&bucket.zs[k]), cz);
+            const __m128 dist_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(dist_sq, limit)));
+            if (n - k < kLanes) mask &= (1u << (n - k)) - 1;
+            while (mask != 0) {
+                out.push_back(bucket.ids[k + std::countr_zero(mask)]);
+                mask &= mask - 1;
+            }
+        }
+        remaining -= n;
+    }
+#else
+    ForEachInLeaf(node, [&](core::ecs::EntityId id, float x, float y, float z) {
+        const float dx = x - center.x, dy = y - center.y, dz = z - center.z;
+        if (dx * dx + dy * dy + dz * dz <= radius_sq) out.push_back(id);
+    });
+#endif
+}
+
+void LooseOctree::FilterBox(const Node& node, const core::utils::Vector3& min, const core::utils::Vector3& max,
+                            std::vector<core::ecs::EntityId>& out) const {
+#if defined(__SSE2__)
+    const __m128 lo_x = _mm_set1_ps(min.x), lo_y = _mm_set1_ps(min.y), lo_z = _mm_set1_ps(min.z);
+    const __m128 hi_x = _mm_set1_ps(max.x), hi_y = _mm_set1_ps(max.y), hi_z = _mm_set1_ps(max.z);
+    uint32_t remaining = node.count;
+    for (uint32_t b = node.first_bucket; b != kNone && remaining > 0; b = buckets_[b].next) {
+        const Bucket& bucket = buckets_[b];
+        const uint32_t n = std::min(remaining, kBucketCapacity);
+        for (uint32_t k = 0; k < n; k += kLanes) {
+            const __m128 x = _mm_loadu_ps(&bucket.xs[k]), y = _mm_loadu_ps(&bucket.ys[k]), z = _mm_loadu_ps(&bucket.zs[k]);
+            const __m128 inside = _mm_and_ps(
+                _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(x, lo_x), _mm_cmple_ps(x, hi_x)),
+                           _mm_and_ps(_mm_cmpge_ps(y, lo_y), _mm_cmple_ps(y, hi_y))),
+                _mm_and_ps(_mm_cmpge_ps(z, lo_z), _mm_cmple_ps(z, hi_z)));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_ps(inside));
+            if (n - k < kLanes) mask &= (1u << (n - k)) - 1;
+            while (mask != 0) {
+                out.push_back(bucket.ids[k + std::countr_zero(mask)]);
+                mask &= mask - 1;
+            }
+        }
+        remaining -= n;
+    }
+#else
+    ForEachInLeaf(node, [&](core::ecs::EntityId id, float x, float y, float z) {
+        if (x >= min.x && x <= max.x && y >= min.y && y <= max.y && z >= min.z && z <= max.z) out.push_back(id);
+    });
+#endif
+}
+
+bool LooseOctree::InWorld(const core::utils::Vector3& p) const {
+    return p.x >= config_.world_min.x && p.x <= config_.world_max.x &&
+           p.y >= config_.world_min.y && p.y <= config_.world_max.y &&
+           p.z >= config_.world_min.z && p.z <= config_.world_max.z;
+}
+
+bool LooseOctree::LooseContains(const Node& node, const core::utils::Vector3& p) const {
+    return std::abs(p.x - node.cx) <= node.hx * loose_scale_ && std::abs(p.y - node.cy) <= node.hy * loose_scale_ &&
+           std::abs(p.z - node.cz) <= node.hz * loose_scale_;
+}
+
+bool LooseOctree::CanSplit(const Node& node) const {
+    return node.depth < config_.max_depth && 2.0f * std::min({node.hx, node.hy, node.hz}) > config_.min_node_size;
+}
+
+uint32_t LooseOctree::Descend(uint32_t index, const core::utils::Vector3& p) const {
+    while (nodes_[index].first_child != kNone) {
+        const Node& node = nodes_[index];
+        index = node.first_child + static_cast<uint32_t>(Octant(node.cx, node.cy, node.cz, p));
+    }
+    return index;
+}
+
+void LooseOctree::Insert(uint32_t start, core::ecs::EntityId entity, const core::utils::Vector3& p) {
+    const uint32_t leaf = Descend(start, p);
+    Append(leaf, entity, p);
+    if (nodes_[leaf].count > config_.max_entities_per_node && CanSplit(nodes_[leaf])) {
+        Split(leaf);
+    }
+}
+
+void LooseOctree::Append(uint32_t leaf, core::ecs::EntityId entity, const core::utils::Vector3& p) {
+    const uint32_t index = nodes_[leaf].count;
+    if (index % kBucketCapacity == 0) {
+        const uint32_t bucket = AllocateBucket();
+        Node& node = nodes_[leaf];
+        if (node.first_bucket == kNone) {
+            node.first_bucket = bucket;
+        } else {
+            uint32_t last = node.first_bucket;
+            while (buckets_[last].next != kNone) last = buckets_[last].next;
+            buckets_[last].next = bucket;
+        }
+    }
+    Node& node = nodes_[leaf];
+    uint32_t slot;
+    Bucket& bucket = BucketAt(node, index, slot);
+    bucket.ids[slot] = entity;
+    bucket.xs[slot] = p.x;
+    bucket.ys[slot] = p.y;
+    bucket.zs[slot] = p.z;
+    ++node.count;
+    locations_[entity] = {leaf, index};
+}
+
+// Swap-with-last, then frees the last bucket once it is empty. The caller drops the entity's location.
+void LooseOctree::RemoveAt(const Location& location) {
+    Node& node = nodes_[location.node];
+    const uint32_t last = node.count - 1;
+    if (location.index != last) {
+        uint32_t from_slot, to_slot;
+        Bucket& from = BucketAt(node, last, from_slot);
+        Bucket& to = BucketAt(node, location.index, to_slot);
+        to.ids[to_slot] = from.ids[from_slot];
+        to.xs[to_slot] = from.xs[from_slot];
+        to.ys[to_slot] = from.ys[from_slot];
+        to.zs[to_slot] = from.zs[from_slot];
+        locations_[to.ids[to_slot]].index = location.index;
+    }
+    --node.count;
+    if (node.count % kBucketCapacity == 0) {
+        if (node.count == 0) {
+            free_buckets_.push_back(node.first_bucket);
+            node.first_bucket = kNone;
+        } else {
+            uint32_t previous = node.first_bucket;
+            for (uint32_t i = node.count / kBucketCapacity - 1; i > 0; --i) previous = buckets_[previous].next;
+            free_buckets_.push_back(buckets_[previous].next);
+            buckets_[previous].next = kNone;
+        }
+    }
+}
+
+// [SEQUENCE: MVP19-353] Entities go to the child of their octant. One that sits in the leaf's loose margin can
+// be outside that child's loose bounds; it is reinserted from the root, which places it in the leaf whose box
+// actually holds it.
+void LooseOctree::Split(uint32_t leaf) {
+    std::vector<Entry> entries;
+    TakeEntries(leaf, entries);
+    const uint32_t first = AllocateChildren();
+    const Node parent = nodes_[leaf];
+    for (uint32_t i = 0; i < 8; ++i) {
+        Node& child = nodes_[first + i];
+        child = Node{};
+        child.hx = parent.hx * 0.5f;
+        child.hy = parent.hy * 0.5f;
+        child.hz = parent.hz * 0.5f;
+        child.cx = parent.cx + ((i & 1) ? child.hx : -child.hx);
+        child.cy = parent.cy + ((i & 2) ? child.hy : -child.hy);
+        child.cz = parent.cz + ((i & 4) ? child.hz : -child.hz);
+        child.parent = leaf;
+        child.depth = parent.depth + 1;
+    }
+    nodes_[leaf].first_child = first;
+    ++stats_.splits;
+
+    for (const Entry& entry : entries) {
+        const uint32_t child = first + static_cast<uint32_t>(Octant(parent.cx, parent.cy, parent.cz, entry.position));
+        Insert(LooseContains(nodes_[child], entry.position) ? child : 0, entry.entity, entry.position);
+    }
+}
+
+void LooseOctree::TryMerge(uint32_t index) {
+    while (index != kNone) {
+        const uint32_t first = nodes_[index].first_child;
+        if (first == kNone) return;
+        uint32_t total = 0;
+        for (uint32_t i = 0; i < 8; ++i) {
+            if (nodes_[first + i].first_child != kNone) return;
+            total += nodes_[first + i].count;
+        }
+        if (total > config_.max_entities_per_node / 2) return;
+
+        std::vector<Entry> entries;
+        for (uint32_t i = 0; i < 8; ++i) TakeEntries(first + i, entries);
+        nodes_[index].first_child = kNone;
+        free_blocks_.push_back(first);
+        for (const Entry& entry : entries) Append(index, entry.entity, entry.position);
+        ++stats_.merges;
+        index = nodes_[index].parent;
+    }
+}
+
+void LooseOctree::TakeEntries(uint32_t leaf, std::vector<Entry>& out) {
+    Node& node = nodes_[leaf];
+    ForEachInLeaf(node, [&](core::ecs::EntityId id, float x, float y, float z) {
+        out.push_back({id, core::utils::Vector3(x, y, z)});
+    });
+    for (uint32_t b = node.first_bucket; b != kNone;) {
+        const uint32_t next = buckets_[b].next;
+        buckets_[b].next = kNone;
+        free_buckets_.push_back(b);
+        b = next;
+    }
+    node.first_bucket = kNone;
+    node.count = 0;
+}
+
+uint32_t LooseOctree::AllocateBucket() {
+    if (!free_buckets_.empty()) {
+        const uint32_t bucket = free_buckets_.back();
+        free_buckets_.pop_back();
+        buckets_[bucket].next = kNone;
+        return bucket;
+    }
+    buckets_.emplace_back();
+    return static_cast<uint32_t>(buckets_.size() - 1);
+}
+
+uint32_t LooseOctree::AllocateChildren() {
+    if (!free_blocks_.empty()) {
+        const uint32_t first = free_blocks_.back();
+        free_blocks_.pop_back();
+        return first;
+    }
+    const auto first = static_cast<uint32_t>(nodes_.size());
+    nodes_.resize(nodes_.size() + 8);
+    return first;
+}
+
+LooseOctree::Bucket& LooseOctree::BucketAt(const Node& node, uint32_t index, uint32_t& slot) {
+    uint32_t bucket = node.first_bucket;
+    for (uint32_t i = index / kBucketCapacity; i > 0; --i) bucket = buckets_[bucket].next;
+    slot = index % kBucketCapacity;
+    return buckets_[bucket];
+}
+
+} // namespace mmorpg::game::world::octree
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "core/ecs/types.h"
+#include "core/utils/vector3.h"
+#include "game/world/ispatial_index.h"
+
+namespace mmorpg::game::world::octree {
+
+// [SEQUENCE: MVP19-347] A loose octree: the OctreeWorld variant for worlds where many entities move every tick.
+//
+// Nodes live in one pool and refer to each other by 32-bit index. The eight children of a node are allocated
+// as one block of consecutive indices, so a child is first_child + octant and the next sibling is the next
+// index. Leaves keep their entities in pooled buckets of inline SoA arrays (ids, x, y, z), chained when a leaf
+// at the depth limit outgrows one bucket.
+//
+// An entity goes to the leaf whose bounds contain it, but it only has to stay within the leaf's loose bounds:
+// the node's box scaled by `looseness` around its centre. A small move therefore rewrites the position in place
+// and only a move past the loose bounds relocates the entity; entities walking along a node boundary no longer
+// bounce between leaves, and splits and merges stop churning. Queries test nodes against their loose bounds.
+//
+// Every query walks the tree without a stack: descend to the first child, else step to the next sibling,
+// climbing through parents after the last one. Ray and frustum queries treat entities as spheres of
+// entity_radius. Thread-safe: changes take the lock exclusively, queries share it.
+class LooseOctree : public ISpatialIndex {
+public:
+    struct Config {
+        core::utils::Vector3 world_min;
+        core::utils::Vector3 world_max;
+        size_t max_depth = 8;
+        size_t max_entities_per_node = 32;   // A leaf splits past this and merges back at half of it
+        float min_node_size = 12.5f;
+        float looseness = 1.5f;              // Loose bounds as a multiple of the node's box, at least 1
+        float entity_radius = 0.5f;          // Entity size for ray and frustum queries
+    };
+
+    struct Stats {
+        uint64_t relocations = 0;   // Updates that moved an entity to another leaf
+        uint64_t splits = 0;
+        uint64_t merges = 0;
+    };
+
+    explicit LooseOctree(const Config& config);
+
+    // Positions outside the world bounds are not indexed; moving outside removes the entity
+    void AddEntity(core::ecs::EntityId entity, const core::utils::Vector3& position) override;
+    void RemoveEntity(core::ecs::EntityId entity) override;
+    void UpdateEntity(core::ecs::EntityId entity, const core::utils::Vector3& old_pos,
+                      const core::utils::Vector3& new_pos) override;
+
+    std::vector<core::ecs::EntityId> GetEntitiesInRadius(const core::utils::Vector3& center, float radius) const override;
+    std::vector<core::ecs::EntityId> GetEntitiesInBox(const core::utils::Vector3& min,
+                                                      const core::utils::Vector3& max) const override;
+    // Entities in a cone of full angle fov (radians) along direction, between near_dist and far_dist from origin
+    std::vector<core::ecs::EntityId> GetEntitiesInFrustum(const core::utils::Vector3& origin,
+                                                          const core::utils::Vector3& direction, float fov,
+                                                          float near_dist, float far_dist) const;
+    // Entities the segment from origin along direction passes within entity_radius of, nearest first
+    std::vector<core::ecs::EntityId> GetEntitiesAlongRay(const core::utils::Vector3& origin,
+                                                         const core::utils::Vector3& direction,
+                                                         float max_distance) const;
+
+    size_t GetEntityCount() const;
+    void GetTreeStats(size_t& total_nodes, size_t& leaf_nodes, size_t& entities) const;
+    Stats GetStats() const;
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+    static constexpr uint32_t kBucketCapacity = 16;
+
+    struct Node {
+        float cx, cy, cz;          // Centre
+        float hx, hy, hz;          // Half extents of the (tight) box
+        uint32_t parent = kNone;
+        uint32_t first_child = kNone;
+        uint32_t first_bucket = kNone;   // Leaves only
+        uint32_t count = 0;              // Entities in this leaf
+        uint32_t depth = 0;
+    };
+
+    struct Bucket {
+        core::ecs::EntityId ids[kBucketCapacity];
+        float xs[kBucketCapacity];
+        float ys[kBucketCapacity];
+        float zs[kBucketCapacity];
+        uint32_t next = kNone;
+    };
+
+    struct Location {
+        uint32_t node;
+        uint32_t index;   // Within the leaf
+    };
+
+    struct Entry {
+        core::ecs::EntityId entity;
+        core::utils::Vector3 position;
+    };
+
+    template <typename NodeTest, typename LeafVisit>
+    void Traverse(NodeTest&& node_test, LeafVisit&& leaf_visit) const;
+    template <typename EntityVisit>
+    void ForEachInLeaf(const Node& node, EntityVisit&& visit) const;
+    void FilterRadius(const Node& node, const core::utils::Vector3& center, float radius_sq,
+                      std::vector<core::ecs::EntityId>& out) const;
+    void FilterBox(const Node& node, const core::utils::Vector3& min, const core::utils::Vector3& max,
+                   std::vector<core::ecs::EntityId>& out) const;
+
+    bool InWorld(const core::utils::Vector3& p) const;
+    bool LooseContains(const Node& node, const core::utils::Vector3& p) const;
+    bool CanSplit(const Node& node) const;
+    uint32_t Descend(uint32_t node, const core::utils::Vector3& p) const;
+
+    void Insert(uint32_t start, core::ecs::EntityId entity, const core::utils::Vector3& p);
+    void Append(uint32_t leaf, core::ecs::EntityId entity, const core::utils::Vector3& p);
+    void RemoveAt(const Location& location);
+    void Split(uint32_t leaf);
+    // Merges node's children back into it while they hold few enough entities, then tries its parent
+    void TryMerge(uint32_t node);
+    void TakeEntries(uint32_t leaf, std::vector<Entry>& out);
+
+    uint32_t AllocateBucket();
+    uint32_t AllocateChildren();
+    Bucket& BucketAt(const Node& node, uint32_t index, uint32_t& slot);
+
+    Config config_;
+    float loose_scale_;
+
+    mutable std::shared_mutex mutex_;
+    std::vector<Node> nodes_;             // Root at 0, child blocks at 1 + 8k
+    std::vector<Bucket> buckets_;
+    std::vector<uint32_t> free_blocks_;
+    std::vector<uint32_t> free_buckets_;
+    std::unordered_map<core::ecs::EntityId, Location> locations_;
+    Stats stats_;
+};
+
+} // namespace mmorpg::game::world::octree
@@ -79,15 +79,15 @@ void OctreeWorld::AddEntity(core::ecs::EntityId entity, const core::utils::Vecto
         return;
     }
     
-    // Insert into tree
-    InsertEntity(root_.get(), entity, position);
-    
-    // Track entity data
+    // Track entity data first: insertion records the entity's node in it, and a split reads its position
     {
         std::lock_guard<std::mutex> lock(entity_map_mutex_);
         entity_data_[entity] = {position, nullptr}; // Node pointer set during insertion
     }
     
+    // Insert into tree
+    InsertEntity(root_.get(), entity, position);
+    
     spdlog::debug("Added entity {} to octree at position ({}, {}, {})",
                  entity, position.x, position.y, position.z);
 }
@@ -7,11 +7,12 @@
 #include <mutex>
 #include "core/ecs/types.h"
 #include "core/utils/vector3.h"
+#include "game/world/ispatial_index.h"
 
 namespace mmorpg::game::world::octree {
 
 // [SEQUENCE: MVP3-27] Defines the OctreeWorld class, a recursive spatial partitioning structure for 3D space.
-class OctreeWorld {
+class OctreeWorld : public ISpatialIndex {
 public:
     // [SEQUENCE: MVP3-28] Configuration struct for OctreeWorld initialization.
     struct Config {
@@ -33,20 +34,20 @@ public:
 
     // [SEQUENCE: MVP3-30] Constructor and destructor.
     explicit OctreeWorld(const Config& config);
-    ~OctreeWorld();
+    ~OctreeWorld() override;
     
     // [SEQUENCE: MVP3-31] Public API for entity management in the octree.
-    void AddEntity(core::ecs::EntityId entity, const core::utils::Vector3& position);
-    void RemoveEntity(core::ecs::EntityId entity);
+    void AddEntity(core::ecs::EntityId entity, const core::utils::Vector3& position) override;
+    void RemoveEntity(core::ecs::EntityId entity) override;
     void UpdateEntity(core::ecs::EntityId entity, const core::utils::Vector3& old_pos, 
-                     const core::utils::Vector3& new_pos);
+                     const core::utils::Vector3& new_pos) override;
     
     // [SEQUENCE: MVP3-32] Public API for performing spatial queries.
     std::vector<core::ecs::EntityId> GetEntitiesInRadius(
-        const core::utils::Vector3& center, float radius) const;
+        const core::utils::Vector3& center, float radius) const override;
     
     std::vector<core::ecs::EntityId> GetEntitiesInBox(
-        const core::utils::Vector3& min, const core::utils::Vector3& max) const;
+        const core::utils::Vector3& min, const core::utils::Vector3& max) const override;
     
     std::vector<core::ecs::EntityId> GetEntitiesInFrustum(
         const core::utils::Vector3& origin, const core::utils::Vector3& direction,
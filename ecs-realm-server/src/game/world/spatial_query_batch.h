@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+#include "core/ecs/types.h"
+#include "core/utils/vector3.h"
+
+namespace mmorpg::game::world {
+
+// [SEQUENCE: MVP19-360] Batched radius queries, for systems that query around every entity they update each
+// tick (AI perception, projectile collision, visibility). The caller submits all of a tick's queries at once
+// and gets every result in one buffer it owns, instead of one freshly allocated vector per query.
+
+// Entities start on every layer; an index that tracks layers narrows them with ISpatialIndex::SetEntityLayers
+constexpr uint32_t kAllLayers = UINT32_MAX;
+
+struct RadiusQuery {
+    core::utils::Vector3 center;
+    float radius = 0.0f;
+    uint32_t layer_mask = kAllLayers;   // Entities on any of these layers; kAllLayers is every entity, 0 none
+};
+
+struct BatchQueryOptions {
+    // Runs task(0) .. task(task_count - 1), possibly concurrently, and returns once all have finished. Unset
+    // runs the whole batch on the calling thread.
+    std::function<void(size_t task_count, const std::function<void(size_t)>& task)> parallel_for;
+    size_t queries_per_task = 512;
+};
+
+// Query i found ids[ranges[i].begin] .. ids[ranges[i].begin + ranges[i].count - 1]. The ranges sit in ids in the
+// order the index ran the queries, which need not be query order. Keep one per system and reuse it every tick;
+// the buffers only grow, so a batch of a steady size allocates nothing.
+// [SEQUENCE: MVP19-427] Ranges replace CSR offsets so an index that reorders queries can append each result
+// where it lands instead of staging every result and copying it back into query order.
+struct SpatialQueryResults {
+    struct Range {
+        uint32_t begin;
+        uint32_t count;
+    };
+    std::vector<Range> ranges;
+    std::vector<core::ecs::EntityId> ids;
+
+    size_t QueryCount() const { return ranges.size(); }
+    std::span<const core::ecs::EntityId> operator[](size_t query) const {
+        return {ids.data() + ranges[query].begin, ranges[query].count};
+    }
+
+    // Working buffers for the index answering the batch, kept here so they are reused too
+    struct Task {
+        std::vector<core::ecs::EntityId> ids;   // This task's results, query by query
+    };
+    struct Scratch {
+        std::vector<uint32_t> keys;           // Per query, the index's bucket for it (a grid cell, say)
+        std::vector<uint32_t> bucket_start;   // Counting sort of queries by key
+        std::vector<uint32_t> order;          // Queries sorted by key
+        std::vector<Task> tasks;
+    } scratch;
+};
+
+} // namespace mmorpg::game::world
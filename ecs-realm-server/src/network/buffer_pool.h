@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <mutex>
+#include <cstddef>
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-24] A process-wide free list of byte buffers for outbound packets.
+// Buffers keep their capacity when released, so a warmed-up server serializes into recycled memory
+// instead of allocating a fresh vector per Send(). Oversized buffers are dropped rather than retained
+// so a single large snapshot does not pin memory forever.
+// [SEQUENCE: MVP19-434] Each thread acquires from and releases to its own cache first, and only takes the shared
+// lock to move kTransferCount buffers at a time: a thread that releases more than it acquires (an io_context
+// thread completing writes) spills to the shared list, and one that acquires more (the game thread serializing)
+// refills from it. The io_context and UDP worker threads therefore no longer meet on one mutex per packet.
+class BufferPool {
+public:
+    static BufferPool& Instance() {
+        static BufferPool instance;
+        return instance;
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    std::vector<std::byte> Acquire() {
+        auto& cache = LocalCache();
+        if (cache.buffers.empty()) {
+            Refill(cache);
+            if (cache.buffers.empty()) {
+                return {};
+            }
+        }
+        std::vector<std::byte> buffer = std::move(cache.buffers.back());
+        cache.buffers.pop_back();
+        return buffer;
+    }
+
+    void Release(std::vector<std::byte>&& buffer) {
+        if (buffer.capacity() == 0 || buffer.capacity() > kMaxRetainedCapacity) return;
+        buffer.clear();
+        auto& cache = LocalCache();
+        if (cache.buffers.size() >= kCacheCapacity) {
+            Spill(cache, kTransferCount);
+        }
+        cache.buffers.push_back(std::move(buffer));
+    }
+
+    // Buffers on the shared list; those sitting in thread caches are not counted
+    size_t GetPooledCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_free.size();
+    }
+
+    static constexpr size_t kMaxPooledBuffers = 4096;
+    static constexpr size_t kCacheCapacity = 64;
+    static constexpr size_t kTransferCount = kCacheCapacity / 2;
+
+private:
+    // A thread's cache hands its buffers back to the shared list when the thread exits
+    struct ThreadCache {
+        std::vector<std::vector<std::byte>> buffers;
+
+        ThreadCache() { buffers.reserve(kCacheCapacity); }
+        ~ThreadCache() { BufferPool::Instance().Spill(*this, buffers.size()); }
+    };
+
+    BufferPool() { m_free.reserve(kMaxPooledBuffers); }
+
+    static ThreadCache& LocalCache() {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    void Refill(ThreadCache& cache) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const size_t count = std::min(kTransferCount, m_free.size());
+        for (size_t i = 0; i < count; ++i) {
+            cache.buffers.push_back(std::move(m_free.back()));
+            m_free.pop_back();
+        }
+    }
+
+    // Moves count buffers from the cache to the shared list, freeing any the list has no room for
+    void Spill(ThreadCache& cache, size_t count) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < count; ++i) {
+            if (m_free.size() < kMaxPooledBuffers) {
+                m_free.push_back(std::move(cache.buffers.back()));
+            }
+            cache.buffers.pop_back();
+        }
+    }
+
+    static constexpr size_t kMaxRetainedCapacity = 64 * 1024;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::vector<std::byte>> m_free;
+};
+
+} // namespace mmorpg::network
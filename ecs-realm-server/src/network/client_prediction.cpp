@@ -47,46 +47,11 @@ void ClientPrediction::ProcessInput(const PlayerInput& input) {
 }
 
 void ClientPrediction::ApplyInput(const PlayerInput& input, PredictedState& state) {
-    const float delta_time = 1.0f / 60.0f;  // Fixed timestep
-    
-    // Movement prediction
-    Vector3 acceleration = input.move_direction * 20.0f;  // Base acceleration
-    
-    if (input.is_sprinting) {
-        acceleration *= 1.5f;
-    } else if (input.is_crouching) {
-        acceleration *= 0.5f;
-    }
-    
-    // Update velocity
-    state.velocity += acceleration * delta_time;
-    
-    // Apply friction
-    if (input.move_direction.Length() < 0.01f) {
-        state.velocity *= 0.9f;  // Deceleration
-    }
-    
-    // Clamp velocity
-    float max_speed = input.is_sprinting ? 15.0f : 10.0f;
-    if (state.velocity.Length() > max_speed) {
-        state.velocity = state.velocity.Normalized() * max_speed;
-    }
-    
-    // Update position
-    state.position += state.velocity * delta_time;
-    
-    // Update rotation
-    state.rotation = input.yaw;
-    
-    // Jumping
-    if (input.is_jumping && character_controller_->IsGrounded()) {
-        state.velocity.y = 10.0f;  // Jump velocity
-    }
-    
-    // Apply gravity
-    if (!character_controller_->IsGrounded()) {
-        state.velocity.y -= 9.81f * delta_time;
-    }
+    // Same fixed step the server resimulates with, so a prediction only diverges when inputs do
+    MoveState next = StepMovement(PredictionUtils::ToMoveState(state), PredictionUtils::ToTickInput(input));
+    state.position = next.position;
+    state.velocity = next.velocity;
+    state.rotation = next.yaw;
     
     // Update tick
     state.tick = input.tick;
@@ -303,17 +268,23 @@ void PredictionManager::ProcessPlayerInput(uint64_t player_id, const PlayerInput
     
     std::unique_lock lock(mutex_);
     
-    // Store input
-    input_buffers_[player_id].push_back(input);
-    
-    // Limit buffer size
-    auto& buffer = input_buffers_[player_id];
-    while (buffer.size() > 120) {
-        buffer.pop_front();
+    // [SEQUENCE: MVP19-242] Buffer by sequence; AdvanceTick applies it on its turn, not on arrival
+    auto now = std::chrono::steady_clock::now();
+    auto channel_it = input_channels_.find(player_id);
+    if (channel_it == input_channels_.end()) {
+        auto state_it = player_states_.find(player_id);
+        const MoveState start = state_it != player_states_.end()
+            ? PredictionUtils::ToMoveState(state_it->second.state) : MoveState{};
+        channel_it = input_channels_.try_emplace(player_id, start).first;
+    }
+    auto& channel = channel_it->second;
+    double arrival = std::chrono::duration<double>(now.time_since_epoch()).count();
+    if (channel.GetBuffer().Push(PredictionUtils::ToTickInput(input), arrival) !=
+        InputJitterBuffer::PushResult::Accepted) {
+        return;
     }
     
     // Update latency tracking
-    auto now = std::chrono::steady_clock::now();
     auto latency = std::chrono::duration<float, std::milli>(
         now - input.timestamp).count();
     global_stats_.player_latencies[player_id] = latency;
@@ -329,26 +300,74 @@ void PredictionManager::ProcessPlayerInput(uint64_t player_id, const PlayerInput
     global_stats_.total_inputs_processed++;
 }
 
+// [SEQUENCE: MVP19-243] Fixed-step: one consume-and-simulate per elapsed tick interval, however late this is called
 void PredictionManager::AdvanceTick() {
     auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration<float>(
-        now - last_tick_time_).count();
+    const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / tick_rate_));
+    tick_accumulator_ += now - last_tick_time_;
+    last_tick_time_ = now;
     
-    if (elapsed >= 1.0f / tick_rate_) {
+    std::unique_lock lock(mutex_);
+    while (tick_accumulator_ >= interval) {
+        tick_accumulator_ -= interval;
         current_tick_++;
-        last_tick_time_ = now;
         
-        // Process pending inputs for all players
-        std::shared_lock lock(mutex_);
-        for (auto& [player_id, buffer] : input_buffers_) {
-            // Process inputs up to current tick
-            while (!buffer.empty() && buffer.front().tick <= current_tick_) {
-                // Apply input to player state
-                // TODO: Apply physics simulation
-                buffer.pop_front();
+        for (auto& [player_id, channel] : input_channels_) {
+            if (!channel.AdvanceTick(consumed_)) {
+                continue;
             }
+            
+            const MoveState& moved = channel.GetState();
+            auto& authoritative = player_states_[player_id];
+            authoritative.tick = current_tick_;
+            authoritative.last_processed_input = channel.GetLastProcessedInput();
+            authoritative.state.tick = current_tick_;
+            authoritative.state.position = moved.position;
+            authoritative.state.velocity = moved.velocity;
+            authoritative.state.rotation = moved.yaw;
+            authoritative.timestamp = now;
+        }
+    }
+}
+
+// Spawn, teleport or reconciliation from the game side. Inputs still buffered continue from the new state.
+void PredictionManager::UpdatePlayerState(uint64_t player_id, const PredictedState& state) {
+    std::unique_lock lock(mutex_);
+    auto& authoritative = player_states_[player_id];
+    authoritative.tick = current_tick_;
+    authoritative.state = state;
+    authoritative.timestamp = std::chrono::steady_clock::now();
+    
+    auto it = input_channels_.find(player_id);
+    if (it != input_channels_.end()) {
+        authoritative.last_processed_input = it->second.GetLastProcessedInput();
+        it->second.Reset(PredictionUtils::ToMoveState(state));
+    }
+}
+
+AuthoritativeState PredictionManager::GetAuthoritativeState(uint64_t player_id) {
+    std::shared_lock lock(mutex_);
+    auto it = player_states_.find(player_id);
+    return it != player_states_.end() ? it->second : AuthoritativeState{};
+}
+
+void PredictionManager::RemovePlayer(uint64_t player_id) {
+    std::unique_lock lock(mutex_);
+    input_channels_.erase(player_id);
+    player_states_.erase(player_id);
+    global_stats_.player_latencies.erase(player_id);
+}
+
+void PredictionManager::ExportMetrics(monitoring::MetricsCollector& metrics) const {
+    InputBufferSummary summary;
+    {
+        std::shared_lock lock(mutex_);
+        for (const auto& [player_id, channel] : input_channels_) {
+            summary.Add(channel.GetBuffer());
         }
     }
+    summary.ExportMetrics(metrics);
 }
 
 bool PredictionManager::IsMovementValid(const Vector3& velocity, float delta_time) {
@@ -366,16 +385,15 @@ bool PredictionManager::IsMovementValid(const Vector3& velocity, float delta_tim
 }
 
 bool PredictionManager::IsInputSequenceValid(uint64_t player_id, uint32_t sequence_number) {
-    auto it = input_buffers_.find(player_id);
-    if (it == input_buffers_.end() || it->second.empty()) {
-        return true;  // First input
+    std::shared_lock lock(mutex_);
+    auto it = input_channels_.find(player_id);
+    if (it == input_channels_.end() || !it->second.GetBuffer().IsPrimed()) {
+        return true;  // First inputs
     }
     
-    uint32_t last_sequence = it->second.back().sequence_number;
-    
-    // Allow some out-of-order packets
-    if (sequence_number <= last_sequence && 
-        last_sequence - sequence_number > 10) {
+    // Allow some out-of-order packets; anything already simulated is dropped by the buffer
+    uint32_t next_sequence = it->second.GetBuffer().GetNextSequence();
+    if (sequence_number < next_sequence && next_sequence - sequence_number > 10) {
         return false;  // Too old
     }
     
@@ -465,6 +483,26 @@ PredictedState ClientPredictionHandler::GetRenderState() {
 // [SEQUENCE: 3744] Prediction utilities implementation
 namespace PredictionUtils {
 
+TickInput ToTickInput(const PlayerInput& input) {
+    TickInput tick_input;
+    tick_input.sequence = input.sequence_number;
+    tick_input.move_x = input.move_direction.x;
+    tick_input.move_z = input.move_direction.z;
+    tick_input.yaw = input.yaw;
+    if (input.is_jumping) tick_input.flags |= TickInput::kJump;
+    if (input.is_sprinting) tick_input.flags |= TickInput::kSprint;
+    if (input.is_crouching) tick_input.flags |= TickInput::kCrouch;
+    return tick_input;
+}
+
+MoveState ToMoveState(const PredictedState& state) {
+    MoveState move;
+    move.position = state.position;
+    move.velocity = state.velocity;
+    move.yaw = state.rotation;
+    return move;
+}
+
 std::vector<uint8_t> CompressInput(const PlayerInput& input) {
     // Simple compression: pack bits for boolean values
     std::vector<uint8_t> compressed;
@@ -10,6 +10,7 @@
 #include "../player/player.h"
 #include "../physics/physics.h"
 #include "packet.h"
+#include "input_jitter_buffer.h"
 
 namespace mmorpg::network {
 
@@ -191,6 +192,10 @@ public:
     std::vector<PlayerInput> GetUnprocessedInputs(uint64_t player_id,
                                                  uint32_t since_sequence);
     void AcknowledgeInput(uint64_t player_id, uint32_t sequence_number);
+    void RemovePlayer(uint64_t player_id);
+    
+    // [SEQUENCE: MVP19-239] Buffer depth, jitter and correction rate over all players, under "prediction."
+    void ExportMetrics(monitoring::MetricsCollector& metrics) const;
     
     // Anti-cheat
     struct ValidationResult {
@@ -219,13 +224,18 @@ private:
     PredictionManager();
     
     // Player states
+    // [SEQUENCE: MVP19-240] Per-player jitter buffer and the movement state resimulated from it, one input per tick
+    // [SEQUENCE: MVP19-452] A channel starts from the player's authoritative state and UpdatePlayerState
+    // re-places it, so resimulation never drags a player back to the origin.
     std::unordered_map<uint64_t, AuthoritativeState> player_states_;
-    std::unordered_map<uint64_t, std::deque<PlayerInput>> input_buffers_;
+    std::unordered_map<uint64_t, ResimulatedMovement> input_channels_;
+    std::vector<InputJitterBuffer::ConsumedInput> consumed_;   // Scratch for AdvanceTick
     
     // Tick management
     uint32_t current_tick_{0};
     uint32_t tick_rate_{60};
     std::chrono::steady_clock::time_point last_tick_time_;
+    std::chrono::steady_clock::duration tick_accumulator_{};
     
     // Statistics
     GlobalPredictionStats global_stats_;
@@ -281,6 +291,10 @@ private:
 
 // [SEQUENCE: 3734] Prediction utilities
 namespace PredictionUtils {
+    // [SEQUENCE: MVP19-241] Client and server both step movement through StepMovement on these
+    TickInput ToTickInput(const PlayerInput& input);
+    MoveState ToMoveState(const PredictedState& state);
+    
     // Input compression
     std::vector<uint8_t> CompressInput(const PlayerInput& input);
     PlayerInput DecompressInput(const std::vector<uint8_t>& data);
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "network/packet_dispatch.h"
+#include "network/packet_serializer.h"
+
+namespace mmorpg::network::cluster_framing {
+
+// [SEQUENCE: MVP19-307] Node-to-node messages use the client framing (4-byte big-endian length, then the Packet
+// envelope), one frame per UDP datagram or per request on a TCP connection.
+
+// Body size from a length prefix
+inline uint32_t FrameBodySize(const std::byte* prefix) {
+    return (static_cast<uint32_t>(prefix[0]) << 24) | (static_cast<uint32_t>(prefix[1]) << 16) |
+           (static_cast<uint32_t>(prefix[2]) << 8) | static_cast<uint32_t>(prefix[3]);
+}
+
+// Parses an envelope body (no length prefix) that must carry a T
+template <typename T>
+bool ParseBody(const std::byte* body, size_t size, T& message) {
+    PacketSerializer::PacketEnvelope envelope;
+    if (!PacketSerializer::ParseEnvelope(body, size, envelope) || envelope.type != PacketTraits<T>::kType) {
+        return false;
+    }
+    return message.ParseFromArray(envelope.payload, static_cast<int>(envelope.payload_size));
+}
+
+// Parses one whole frame, length prefix included, that must carry a T
+template <typename T>
+bool ParseFrame(const std::byte* data, size_t size, T& message) {
+    if (size <= 4 || FrameBodySize(data) != size - 4) return false;
+    return ParseBody(data + 4, size - 4, message);
+}
+
+} // namespace mmorpg::network::cluster_framing
@@ -0,0 +1,108 @@
+#include "network/entity_update_batcher.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <cstring>
+
+namespace mmorpg::network {
+
+namespace {
+
+using google::protobuf::internal::WireFormatLite;
+using google::protobuf::io::CodedOutputStream;
+
+google::protobuf::ArenaOptions MakeArenaOptions(char* block, size_t size) {
+    google::protobuf::ArenaOptions options;
+    options.initial_block = block;
+    options.initial_block_size = size;
+    return options;
+}
+
+} // namespace
+
+EntityUpdateBatcher::EntityUpdateBatcher(size_t arena_block_size)
+    : m_arenaBlock(std::make_unique<char[]>(arena_block_size)),
+      m_arena(MakeArenaOptions(m_arenaBlock.get(), arena_block_size)) {}
+
+void EntityUpdateBatcher::BeginTick(uint32_t tick) {
+    m_arena.Reset();
+    m_tick = tick;
+    m_encoded.clear();
+    m_records.clear();
+    m_stats = {};
+}
+
+mmorpg::proto::EntityUpdate* EntityUpdateBatcher::NewUpdate() {
+    return google::protobuf::Arena::CreateMessage<mmorpg::proto::EntityUpdate>(&m_arena);
+}
+
+// [SEQUENCE: MVP19-144] A record is the complete wire form of one element of EntityUpdateBatch.updates (tag,
+// length, message), so a batch payload is just the tick field followed by its records.
+EntityUpdateBatcher::RecordId EntityUpdateBatcher::Encode(const mmorpg::proto::EntityUpdate& update) {
+    const size_t message_size = update.ByteSizeLong();
+    const size_t record_size =
+        WireFormatLite::TagSize(mmorpg::proto::EntityUpdateBatch::kUpdatesFieldNumber, WireFormatLite::TYPE_MESSAGE) +
+        CodedOutputStream::VarintSize32(static_cast<uint32_t>(message_size)) + message_size;
+
+    const size_t offset = m_encoded.size();
+    m_encoded.resize(offset + record_size);
+    uint8_t* target = reinterpret_cast<uint8_t*>(m_encoded.data() + offset);
+    target = WireFormatLite::WriteTagToArray(mmorpg::proto::EntityUpdateBatch::kUpdatesFieldNumber,
+                                             WireFormatLite::WIRETYPE_LENGTH_DELIMITED, target);
+    target = CodedOutputStream::WriteVarint32ToArray(static_cast<uint32_t>(message_size), target);
+    update.SerializeWithCachedSizesToArray(target);
+
+    m_records.push_back(Record{static_cast<uint32_t>(offset), static_cast<uint32_t>(record_size)});
+    ++m_stats.records_encoded;
+    m_stats.record_bytes += record_size;
+    return static_cast<RecordId>(m_records.size() - 1);
+}
+
+void EntityUpdateBatcher::AddRecipient(uint64_t session_id, RecordId record) {
+    m_recipients[session_id].push_back(record);
+}
+
+// [SEQUENCE: MVP19-145] Per session: size the payload from the record table, frame once, then memcpy the
+// records into place. No protobuf object is touched here.
+void EntityUpdateBatcher::Flush(const PacketSink& sink) {
+    const size_t tick_field_size = m_tick == 0 ? 0 :
+        WireFormatLite::TagSize(mmorpg::proto::EntityUpdateBatch::kTickFieldNumber, WireFormatLite::TYPE_UINT32) +
+        CodedOutputStream::VarintSize32(m_tick);
+
+    for (auto it = m_recipients.begin(); it != m_recipients.end();) {
+        auto& records = it->second;
+        if (records.empty()) {
+            it = m_recipients.erase(it);
+            continue;
+        }
+
+        size_t payload_size = tick_field_size;
+        for (RecordId id : records) {
+            payload_size += m_records[id].size;
+        }
+
+        auto packet = std::make_shared<std::vector<std::byte>>();
+        std::byte* out = PacketSerializer::BeginFrame(mmorpg::proto::PACKET_ENTITY_UPDATE_BATCH, payload_size, *packet);
+        if (tick_field_size > 0) {
+            uint8_t* target = reinterpret_cast<uint8_t*>(out);
+            target = WireFormatLite::WriteUInt32ToArray(mmorpg::proto::EntityUpdateBatch::kTickFieldNumber, m_tick, target);
+            out = reinterpret_cast<std::byte*>(target);
+        }
+        for (RecordId id : records) {
+            const Record& record = m_records[id];
+            std::memcpy(out, m_encoded.data() + record.offset, record.size);
+            out += record.size;
+        }
+
+        m_stats.record_references += records.size();
+        ++m_stats.packets_built;
+        m_stats.packet_bytes += packet->size();
+        records.clear();
+
+        sink(it->first, packet);
+        ++it;
+    }
+}
+
+} // namespace mmorpg::network
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <google/protobuf/arena.h>
+
+#include "network/packet_serializer.h"
+#include "proto/game.pb.h"
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-142] Counters for the last flushed tick.
+struct EntityUpdateBatchStats {
+    uint64_t records_encoded = 0;   // Entity updates serialized (once each, however many observers)
+    uint64_t record_bytes = 0;
+    uint64_t record_references = 0; // Sum over sessions of records in their batch
+    uint64_t packets_built = 0;     // One per session with at least one record
+    uint64_t packet_bytes = 0;
+};
+
+// [SEQUENCE: MVP19-143] Builds one EntityUpdateBatch packet per session per sync tick without per-observer
+// protobuf copies. Updates are allocated on a tick-scoped arena, encoded exactly once as ready-made
+// "repeated EntityUpdate updates" field records, and each session's batch is the framed concatenation of
+// the records it should see. The arena's first block and all buffers are reused across ticks, so a steady
+// tick allocates only the outgoing packets.
+//
+// Not thread-safe; owned by the sync system and used from the simulation thread.
+class EntityUpdateBatcher {
+public:
+    using RecordId = uint32_t;
+    using PacketSink = std::function<void(uint64_t session_id, const SharedPacketBuffer& packet)>;
+
+    static constexpr size_t kDefaultArenaBlockSize = 256 * 1024;
+
+    explicit EntityUpdateBatcher(size_t arena_block_size = kDefaultArenaBlockSize);
+
+    EntityUpdateBatcher(const EntityUpdateBatcher&) = delete;
+    EntityUpdateBatcher& operator=(const EntityUpdateBatcher&) = delete;
+
+    // Drops the previous tick's messages and records. Updates from NewUpdate() are invalid afterwards.
+    void BeginTick(uint32_t tick);
+
+    // An empty update owned by the tick arena.
+    mmorpg::proto::EntityUpdate* NewUpdate();
+
+    // Serializes the update once and returns a handle that any number of sessions can reference.
+    RecordId Encode(const mmorpg::proto::EntityUpdate& update);
+
+    void AddRecipient(uint64_t session_id, RecordId record);
+
+    // Encoded size of a record, i.e. what each recipient's batch grows by.
+    size_t GetRecordSize(RecordId record) const { return m_records[record].size; }
+
+    // Frames each session's batch and hands it to sink, in no particular session order. Sessions that
+    // received nothing this tick get no packet and are forgotten.
+    void Flush(const PacketSink& sink);
+
+    const EntityUpdateBatchStats& GetTickStats() const { return m_stats; }
+
+private:
+    struct Record {
+        uint32_t offset = 0;
+        uint32_t size = 0;
+    };
+
+    std::unique_ptr<char[]> m_arenaBlock;
+    google::protobuf::Arena m_arena;
+    uint32_t m_tick = 0;
+    std::vector<std::byte> m_encoded;      // All records of the tick back to back
+    std::vector<Record> m_records;
+    std::unordered_map<uint64_t, std::vector<RecordId>> m_recipients;   // Vectors keep their capacity across ticks
+    EntityUpdateBatchStats m_stats;
+};
+
+} // namespace mmorpg::network
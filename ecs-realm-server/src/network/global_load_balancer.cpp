@@ -0,0 +1,300 @@
+#include "network/global_load_balancer.h"
+
+#include "monitoring/metrics_collector.h"
+#include "proto/cluster.pb.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace mmorpg::network {
+
+double GlobalLoadBalancer::ServerNode::TickLoad() const {
+    return tick_budget_ms > 0.0 ? tick_ms / tick_budget_ms : 0.0;
+}
+
+double GlobalLoadBalancer::ServerNode::SessionLoad() const {
+    return max_sessions > 0 ? static_cast<double>(sessions) / max_sessions : 1.0;
+}
+
+double GlobalLoadBalancer::ServerNode::EgressLoad() const {
+    return egress_capacity_bytes_per_second > 0.0 ? egress_bytes_per_second / egress_capacity_bytes_per_second
+                                                  : 0.0;
+}
+
+double GlobalLoadBalancer::ServerNode::GetLoadScore() const {
+    return std::max({TickLoad(), SessionLoad(), EgressLoad()});
+}
+
+double GlobalLoadBalancer::ServerNode::ProjectedLoad(uint32_t extra_sessions) const {
+    const double after = static_cast<double>(sessions) + pending_sessions + extra_sessions;
+    const double growth = sessions > 0 ? after / sessions : 1.0;
+    const double session_load = max_sessions > 0 ? after / max_sessions : 1.0;
+    return std::max({TickLoad() * growth, session_load, EgressLoad() * growth});
+}
+
+GlobalLoadBalancer::GlobalLoadBalancer(LoadBalancerConfig config)
+    : m_config(config), m_rng(config.seed != 0 ? config.seed : std::random_device{}()) {}
+
+// [SEQUENCE: MVP19-304] A report replaces everything the balancer knew about the node, including the pending
+// count: sessions routed before the report was taken are in its session count by now, or never arrived.
+bool GlobalLoadBalancer::UpdateNodeLoad(const mmorpg::proto::NodeLoadReport& report, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto [it, inserted] = m_nodes.try_emplace(report.node_id());
+    ServerNode& node = it->second;
+    if (!inserted && report.sequence() <= node.last_sequence) {
+        ++m_staleReports;
+        return false;
+    }
+    node.server_id = report.node_id();
+    node.region = report.region();
+    node.hostname = report.host();
+    node.port = static_cast<uint16_t>(report.game_port());
+    node.handoff_port = static_cast<uint16_t>(report.handoff_port());
+    node.tick_ms = report.tick_ms();
+    node.tick_budget_ms = report.tick_budget_ms();
+    node.sessions = report.sessions();
+    node.max_sessions = report.max_sessions();
+    node.egress_bytes_per_second = report.egress_bytes_per_second();
+    node.egress_capacity_bytes_per_second = report.egress_capacity_bytes_per_second();
+    node.draining = report.draining();
+    node.pending_sessions = 0;
+    node.last_sequence = report.sequence();
+    node.last_report = now;
+    ++m_reports;
+    return true;
+}
+
+bool GlobalLoadBalancer::UnregisterServer(const std::string& server_id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nodes.erase(server_id) > 0;
+}
+
+void GlobalLoadBalancer::SetServerHealthStatus(const std::string& server_id, bool is_healthy) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_nodes.find(server_id);
+    if (it != m_nodes.end()) {
+        it->second.is_healthy = is_healthy;
+    }
+}
+
+// [SEQUENCE: MVP19-305] Sticky node first, then two random choices within the preferred region, then across
+// all regions. Candidate lists are rebuilt per call: a cluster has tens of nodes, not thousands.
+GlobalLoadBalancer::RoutingResult GlobalLoadBalancer::RouteClient(const std::string& client_id,
+                                                                  const std::string& preferred_region,
+                                                                  Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_routingRequests;
+
+    if (m_config.enable_sticky_sessions && !client_id.empty()) {
+        auto affinity = m_affinity.find(client_id);
+        if (affinity != m_affinity.end()) {
+            auto node = m_nodes.find(affinity->second.server_id);
+            if (affinity->second.expires > now && node != m_nodes.end() && IsAvailable(node->second, now)) {
+                ++node->second.pending_sessions;
+                affinity->second.expires = now + m_config.session_affinity_duration;
+                ++m_routed;
+                ++m_stickyRouted;
+                return MakeResult(node->second, "sticky");
+            }
+            m_affinity.erase(affinity);
+        }
+    }
+
+    std::vector<ServerNode*> candidates;
+    const char* reason = "two_choices";
+    if (!preferred_region.empty()) {
+        for (auto& [id, node] : m_nodes) {
+            if (node.region == preferred_region && IsAvailable(node, now)) candidates.push_back(&node);
+        }
+        if (candidates.empty()) reason = "two_choices_other_region";
+    }
+    if (candidates.empty()) {
+        for (auto& [id, node] : m_nodes) {
+            if (IsAvailable(node, now)) candidates.push_back(&node);
+        }
+    }
+    if (candidates.empty()) {
+        RoutingResult result;
+        result.routing_reason = "no_available_node";
+        return result;
+    }
+
+    ServerNode* chosen = PickTwoChoices(candidates);
+    ++m_routed;
+    if (m_config.enable_sticky_sessions && !client_id.empty()) {
+        if (m_affinity.size() >= m_config.max_affinity_entries) {
+            std::erase_if(m_affinity, [now](const auto& entry) { return entry.second.expires <= now; });
+            if (m_affinity.size() >= m_config.max_affinity_entries) m_affinity.clear();
+        }
+        m_affinity[client_id] = Affinity{chosen->server_id, now + m_config.session_affinity_duration};
+    }
+    return MakeResult(*chosen, reason);
+}
+
+// [SEQUENCE: MVP19-306] Handoff targets come from the same pool as new sessions, minus the source. The margin
+// check compares the target's load with one more session against the source's load now.
+GlobalLoadBalancer::RoutingResult GlobalLoadBalancer::SelectHandoffTarget(const std::string& from_server_id,
+                                                                          Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto source = m_nodes.find(from_server_id);
+    // An unknown or draining source sheds regardless of load
+    const double source_load = source == m_nodes.end() || source->second.draining
+                                   ? std::numeric_limits<double>::infinity()
+                                   : source->second.GetLoadScore();
+
+    std::vector<ServerNode*> same_region;
+    std::vector<ServerNode*> other_regions;
+    for (auto& [id, node] : m_nodes) {
+        if (id == from_server_id || !IsAvailable(node, now)) continue;
+        if (node.ProjectedLoad(1) + m_config.handoff_margin > source_load) continue;
+        if (source != m_nodes.end() && node.region == source->second.region) {
+            same_region.push_back(&node);
+        } else {
+            other_regions.push_back(&node);
+        }
+    }
+    auto& candidates = same_region.empty() ? other_regions : same_region;
+    if (candidates.empty()) {
+        ++m_failedHandoffTargets;
+        RoutingResult result;
+        result.routing_reason = "no_less_loaded_node";
+        return result;
+    }
+    ServerNode* chosen = PickTwoChoices(candidates);
+    ++m_handoffTargets;
+    return MakeResult(*chosen, same_region.empty() ? "handoff_other_region" : "handoff");
+}
+
+std::vector<GlobalLoadBalancer::ScalingRecommendation> GlobalLoadBalancer::AnalyzeScalingNeeds(
+    Clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    struct RegionLoad {
+        uint32_t nodes = 0;
+        uint32_t reporting = 0;
+        double total_load = 0.0;
+    };
+    std::unordered_map<std::string, RegionLoad> regions;
+    for (const auto& [id, node] : m_nodes) {
+        RegionLoad& region = regions[node.region];
+        ++region.nodes;
+        if (node.is_healthy && now - node.last_report <= m_config.report_timeout) {
+            ++region.reporting;
+            region.total_load += node.GetLoadScore();
+        }
+    }
+
+    std::vector<ScalingRecommendation> recommendations;
+    for (const auto& [name, region] : regions) {
+        ScalingRecommendation rec;
+        rec.region = name;
+        rec.current_server_count = region.nodes;
+        if (region.reporting == 0) {
+            rec.action = "scale_up";
+            rec.recommended_server_count = static_cast<uint32_t>(m_config.min_servers_per_region);
+            rec.reasoning = "No healthy servers in region";
+            recommendations.push_back(rec);
+            continue;
+        }
+        const double average_load = region.total_load / region.reporting;
+        rec.current_load_percentage = average_load * 100.0;
+        if (average_load > m_config.load_threshold_scale_up) {
+            rec.action = "scale_up";
+            rec.recommended_server_count = std::min(static_cast<uint32_t>(region.reporting * 1.5 + 0.5),
+                                                    static_cast<uint32_t>(m_config.max_servers_per_region));
+            rec.reasoning = "High load detected: " + std::to_string(average_load * 100) + "%";
+        } else if (average_load < m_config.load_threshold_scale_down &&
+                   region.reporting > m_config.min_servers_per_region) {
+            rec.action = "scale_down";
+            rec.recommended_server_count = std::max(static_cast<uint32_t>(region.reporting * 0.8),
+                                                    static_cast<uint32_t>(m_config.min_servers_per_region));
+            rec.reasoning = "Low load detected: " + std::to_string(average_load * 100) + "%";
+        } else {
+            rec.action = "maintain";
+            rec.recommended_server_count = region.reporting;
+            rec.reasoning = "Load within acceptable range";
+        }
+        recommendations.push_back(rec);
+    }
+    return recommendations;
+}
+
+std::vector<GlobalLoadBalancer::ServerNode> GlobalLoadBalancer::GetNodes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<ServerNode> nodes;
+    nodes.reserve(m_nodes.size());
+    for (const auto& [id, node] : m_nodes) nodes.push_back(node);
+    return nodes;
+}
+
+GlobalLoadBalancer::LoadBalancerStats GlobalLoadBalancer::GetStatistics(Clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    LoadBalancerStats stats;
+    double total_load = 0.0;
+    for (const auto& [id, node] : m_nodes) {
+        ++stats.total_servers;
+        stats.total_sessions += node.sessions;
+        if (IsAvailable(node, now)) ++stats.available_servers;
+        const double load = node.GetLoadScore();
+        total_load += load;
+        stats.max_server_load = std::max(stats.max_server_load, load);
+    }
+    if (stats.total_servers > 0) stats.average_server_load = total_load / stats.total_servers;
+    stats.reports = m_reports;
+    stats.stale_reports = m_staleReports;
+    stats.total_routing_requests = m_routingRequests;
+    stats.successful_routings = m_routed;
+    stats.sticky_routings = m_stickyRouted;
+    stats.handoff_targets = m_handoffTargets;
+    stats.failed_handoff_targets = m_failedHandoffTargets;
+    return stats;
+}
+
+void GlobalLoadBalancer::ExportMetrics(monitoring::MetricsCollector& metrics) const {
+    const LoadBalancerStats stats = GetStatistics();
+    metrics.RecordGauge("lb.servers", static_cast<double>(stats.total_servers));
+    metrics.RecordGauge("lb.available_servers", static_cast<double>(stats.available_servers));
+    metrics.RecordGauge("lb.sessions", static_cast<double>(stats.total_sessions));
+    metrics.RecordGauge("lb.average_load", stats.average_server_load);
+    metrics.RecordGauge("lb.max_load", stats.max_server_load);
+    metrics.RecordCounter("lb.reports", stats.reports);
+    metrics.RecordCounter("lb.stale_reports", stats.stale_reports);
+    metrics.RecordCounter("lb.routing_requests", stats.total_routing_requests);
+    metrics.RecordCounter("lb.routed", stats.successful_routings);
+    metrics.RecordCounter("lb.sticky_routed", stats.sticky_routings);
+    metrics.RecordCounter("lb.handoff_targets", stats.handoff_targets);
+    metrics.RecordCounter("lb.failed_handoff_targets", stats.failed_handoff_targets);
+}
+
+bool GlobalLoadBalancer::IsAvailable(const ServerNode& node, Clock::time_point now) const {
+    return node.is_healthy && !node.draining && node.last_report != Clock::time_point{} &&
+           now - node.last_report <= m_config.report_timeout && node.ProjectedLoad(1) <= m_config.max_load;
+}
+
+GlobalLoadBalancer::ServerNode* GlobalLoadBalancer::PickTwoChoices(std::vector<ServerNode*>& candidates) {
+    ServerNode* chosen = candidates.front();
+    if (candidates.size() > 1) {
+        const size_t first = m_rng() % candidates.size();
+        size_t second = m_rng() % (candidates.size() - 1);
+        if (second >= first) ++second;
+        ServerNode* a = candidates[first];
+        ServerNode* b = candidates[second];
+        chosen = b->ProjectedLoad(1) < a->ProjectedLoad(1) ? b : a;
+    }
+    ++chosen->pending_sessions;
+    return chosen;
+}
+
+GlobalLoadBalancer::RoutingResult GlobalLoadBalancer::MakeResult(const ServerNode& node, const char* reason) {
+    RoutingResult result;
+    result.success = true;
+    result.selected_server_id = node.server_id;
+    result.server_hostname = node.hostname;
+    result.server_port = node.port;
+    result.handoff_port = node.handoff_port;
+    result.load_score = node.ProjectedLoad(0);
+    result.routing_reason = reason;
+    return result;
+}
+
+} // namespace mmorpg::network
@@ -0,0 +1,367 @@
+#include "network/hit_validation_pipeline.h"
+#include "monitoring/metrics_collector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mmorpg::network {
+
+namespace {
+
+constexpr size_t kLanes = 4;
+constexpr size_t kClaimsPerTask = 16;
+
+// Keeps 1/d finite for axis-parallel rays; the slab test then degenerates to an inside/outside check on that axis.
+float SafeInverse(float d) {
+    constexpr float kTiny = 1e-30f;
+    return 1.0f / (std::abs(d) < kTiny ? (d < 0.0f ? -kTiny : kTiny) : d);
+}
+
+double MicrosSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Ray {
+    float ox, oy, oz;
+    float ux, uy, uz;         // Unit direction
+    float ix, iy, iz;         // SafeInverse of the unit direction
+    float max_distance;
+};
+
+std::optional<Ray> MakeRay(const HitClaim& claim) {
+    const auto& d = claim.direction;
+    const float length = std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+    if (!(length > 0.0f) || !(claim.max_range > 0.0f)) return std::nullopt;
+    Ray ray{claim.origin.x, claim.origin.y, claim.origin.z, d.x / length, d.y / length, d.z / length,
+            0.0f, 0.0f, 0.0f, claim.max_range};
+    ray.ix = SafeInverse(ray.ux);
+    ray.iy = SafeInverse(ray.uy);
+    ray.iz = SafeInverse(ray.uz);
+    return ray;
+}
+
+// Entry distance of ray into [lo, hi], if within [0, max_distance]; the same arithmetic as one SIMD lane.
+bool SlabTest(const Ray& ray, float lo_x, float lo_y, float lo_z, float hi_x, float hi_y, float hi_z, float& entry) {
+    const float x0 = (lo_x - ray.ox) * ray.ix, x1 = (hi_x - ray.ox) * ray.ix;
+    const float y0 = (lo_y - ray.oy) * ray.iy, y1 = (hi_y - ray.oy) * ray.iy;
+    const float z0 = (lo_z - ray.oz) * ray.iz, z1 = (hi_z - ray.oz) * ray.iz;
+    const float near = std::max({0.0f, std::min(x0, x1), std::min(y0, y1), std::min(z0, z1)});
+    const float far = std::min({ray.max_distance, std::max(x0, x1), std::max(y0, y1), std::max(z0, z1)});
+    entry = near;
+    return near <= far;
+}
+
+} // namespace
+
+const char* ToString(HitRejection rejection) {
+    switch (rejection) {
+        case HitRejection::None: return "none";
+        case HitRejection::NoHistory: return "no_history";
+        case HitRejection::Missed: return "missed";
+        case HitRejection::VictimNotFound: return "victim_not_found";
+        case HitRejection::VictimDead: return "victim_dead";
+    }
+    return "unknown";
+}
+
+HitValidationPipeline::HitValidationPipeline(const RewindHistory& history, const HitValidationConfig& config)
+    : m_history(history), m_config(config) {
+    m_workers.reserve(m_config.worker_count);
+    for (size_t i = 0; i < m_config.worker_count; ++i) {
+        m_workers.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+HitValidationPipeline::~HitValidationPipeline() {
+    {
+        std::lock_guard lock(m_poolMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void HitValidationPipeline::Submit(const HitClaim& claim) {
+    std::lock_guard lock(m_submitMutex);
+    m_pending.push_back(claim);
+}
+
+size_t HitValidationPipeline::GetPendingCount() const {
+    std::lock_guard lock(m_submitMutex);
+    return m_pending.size();
+}
+
+// [SEQUENCE: MVP19-217] Stage 1: stable sort by quantized time keeps submission order within a group, then each
+// distinct time is located in the history once.
+void HitValidationPipeline::BuildGroups() {
+    const auto quantum = std::max<Clock::duration>(Clock::duration(1), m_config.time_quantum);
+    auto quantize = [quantum](Clock::time_point time) {
+        auto since = time.time_since_epoch();
+        auto floored = since - ((since % quantum) + quantum) % quantum;
+        return Clock::time_point(floored);
+    };
+
+    m_order.resize(m_batch.size());
+    for (uint32_t i = 0; i < m_order.size(); ++i) m_order[i] = i;
+    std::stable_sort(m_order.begin(), m_order.end(), [&](uint32_t a, uint32_t b) {
+        return quantize(m_batch[a].rewind_time) < quantize(m_batch[b].rewind_time);
+    });
+
+    m_groupCount = 0;
+    m_groupOf.resize(m_batch.size());
+    for (size_t i = 0; i < m_order.size(); ++i) {
+        const auto time = quantize(m_batch[m_order[i]].rewind_time);
+        if (m_groupCount == 0 || m_groups[m_groupCount - 1].time != time) {
+            if (m_groups.size() == m_groupCount) m_groups.emplace_back();
+            auto& group = m_groups[m_groupCount++];
+            group.time = time;
+            group.first = i;
+            group.count = 0;
+            group.frame = m_history.Locate(time);
+        }
+        ++m_groups[m_groupCount - 1].count;
+        m_groupOf[m_order[i]] = m_groupCount - 1;
+    }
+}
+
+// [SEQUENCE: MVP19-218] Stage 2: the areas of all the group's unnamed-victim rays go through the history's broad
+// phase together, so the slot columns are read once per group, and every slot it returns is rewound exactly once.
+void HitValidationPipeline::RewindGroup(Group& group) {
+    group.box_count = 0;
+    group.areas.clear();
+    group.slots.clear();
+    if (!group.frame) return;
+
+    for (size_t i = group.first; i < group.first + group.count; ++i) {
+        const auto& claim = m_batch[m_order[i]];
+        const auto ray = MakeRay(claim);
+        if (claim.victim_id != 0 || !ray) continue;
+        const float end_x = ray->ox + ray->ux * ray->max_distance;
+        const float end_y = ray->oy + ray->uy * ray->max_distance;
+        group.areas.push_back({std::min(ray->ox, end_x), std::min(ray->oy, end_y), std::max(ray->ox, end_x),
+                               std::max(ray->oy, end_y)});
+    }
+    if (group.areas.empty()) return;
+    m_history.CollectNear(*group.frame, group.areas.data(), group.areas.size(), group.slots);
+
+    const size_t capacity = (group.slots.size() + kLanes - 1) / kLanes * kLanes;
+    group.ids.assign(capacity, 0);
+    for (auto* column : {&group.lo_x, &group.lo_y, &group.lo_z, &group.hi_x, &group.hi_y, &group.hi_z}) {
+        column->assign(capacity, 0.0f);
+    }
+    for (auto slot : group.slots) {
+        RewoundEntity entity;
+        if (!m_history.RewindSlot(*group.frame, slot, entity) || !entity.alive) continue;
+        const size_t k = group.box_count++;
+        group.ids[k] = entity.entity_id;
+        group.lo_x[k] = entity.position.x - entity.half_extents.x;
+        group.lo_y[k] = entity.position.y - entity.half_extents.y;
+        group.lo_z[k] = entity.position.z - entity.half_extents.z;
+        group.hi_x[k] = entity.position.x + entity.half_extents.x;
+        group.hi_y[k] = entity.position.y + entity.half_extents.y;
+        group.hi_z[k] = entity.position.z + entity.half_extents.z;
+    }
+}
+
+// [SEQUENCE: MVP19-219] Stage 3 for one claim. Lanes past box_count are masked off; of the lanes that hit, the
+// nearest wins and equal distances go to the lower id.
+void HitValidationPipeline::ValidateClaim(const Group& group, const HitClaim& claim, HitVerdict& out) const {
+    out = HitVerdict{};
+    out.claim_id = claim.claim_id;
+    out.victim_id = claim.victim_id;
+    if (!group.frame) {
+        out.rejection = HitRejection::NoHistory;
+        return;
+    }
+    const auto ray = MakeRay(claim);
+    if (!ray) {
+        out.rejection = HitRejection::Missed;
+        return;
+    }
+
+    float best = std::numeric_limits<float>::infinity();
+    uint64_t best_id = 0;
+    if (claim.victim_id != 0) {
+        const auto slot = m_history.FindSlot(claim.victim_id);
+        RewoundEntity victim;
+        if (!slot || !m_history.RewindSlot(*group.frame, *slot, victim) || victim.entity_id != claim.victim_id) {
+            out.rejection = HitRejection::VictimNotFound;
+            return;
+        }
+        if (!victim.alive) {
+            out.rejection = HitRejection::VictimDead;
+            return;
+        }
+        float entry;
+        if (SlabTest(*ray, victim.position.x - victim.half_extents.x, victim.position.y - victim.half_extents.y,
+                     victim.position.z - victim.half_extents.z, victim.position.x + victim.half_extents.x,
+                     victim.position.y + victim.half_extents.y, victim.position.z + victim.half_extents.z, entry)) {
+            best = entry;
+            best_id = claim.victim_id;
+        }
+    } else {
+        auto consider = [&](size_t k, float entry) {
+            const uint64_t id = group.ids[k];
+            if (id == claim.attacker_id) return;
+            if (entry < best || (entry == best && id < best_id)) {
+                best = entry;
+                best_id = id;
+            }
+        };
+#if defined(__SSE2__)
+        const __m128 ox = _mm_set1_ps(ray->ox), oy = _mm_set1_ps(ray->oy), oz = _mm_set1_ps(ray->oz);
+        const __m128 ix = _mm_set1_ps(ray->ix), iy = _mm_set1_ps(ray->iy), iz = _mm_set1_ps(ray->iz);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 range = _mm_set1_ps(ray->max_distance);
+        for (size_t k = 0; k < group.box_count; k += kLanes) {
+            const __m128 x0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&group.lo_x[k]), ox), ix);
+            const __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&group.hi_x[k]), ox), ix);
+            const __m128 y0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&group.lo_y[k]), oy), iy);
+            const __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&group.hi_y[k]), oy), iy);
+            const __m128 z0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&group.lo_z[k]), oz), iz);
+            const __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&group.hi_z[k]), oz), iz);
+            const __m128 near = _mm_max_ps(_mm_max_ps(zero, _mm_min_ps(x0, x1)),
+                                           _mm_max_ps(_mm_min_ps(y0, y1), _mm_min_ps(z0, z1)));
+            const __m128 far = _mm_min_ps(_mm_min_ps(range, _mm_max_ps(x0, x1)),
+                                          _mm_min_ps(_mm_max_ps(y0, y1), _mm_max_ps(z0, z1)));
+            int mask = _mm_movemask_ps(_mm_cmple_ps(near, far));
+            if (group.box_count - k < kLanes) mask &= (1 << (group.box_count - k)) - 1;
+            if (mask == 0) continue;
+            alignas(16) float entries[kLanes];
+            _mm_store_ps(entries, near);
+            for (size_t lane = 0; lane < kLanes; ++lane) {
+                if (mask & (1 << lane)) consider(k + lane, entries[lane]);
+            }
+        }
+#else
+        for (size_t k = 0; k < group.box_count; ++k) {
+            float entry;
+            if (SlabTest(*ray, group.lo_x[k], group.lo_y[k], group.lo_z[k], group.hi_x[k], group.hi_y[k],
+                         group.hi_z[k], entry)) {
+                consider(k, entry);
+            }
+        }
+#endif
+    }
+
+    if (best_id == 0) {
+        out.rejection = HitRejection::Missed;
+        return;
+    }
+    out.valid = true;
+    out.victim_id = best_id;
+    out.distance = best;
+    out.point = {ray->ox + ray->ux * best, ray->oy + ray->uy * best, ray->oz + ray->uz * best};
+}
+
+void HitValidationPipeline::ValidatePending(std::vector<HitVerdict>& out) {
+    const auto start = std::chrono::steady_clock::now();
+    m_batch.clear();
+    {
+        std::lock_guard lock(m_submitMutex);
+        m_batch.swap(m_pending);
+    }
+    out.resize(m_batch.size());
+    if (m_batch.empty()) return;
+
+    BuildGroups();
+    const auto grouped = std::chrono::steady_clock::now();
+
+    ParallelFor(m_groupCount, [this](size_t g) { RewindGroup(m_groups[g]); });
+    const auto rewound = std::chrono::steady_clock::now();
+
+    const size_t tasks = (m_batch.size() + kClaimsPerTask - 1) / kClaimsPerTask;
+    ParallelFor(tasks, [this, &out](size_t task) {
+        const size_t end = std::min(m_batch.size(), (task + 1) * kClaimsPerTask);
+        for (size_t i = task * kClaimsPerTask; i < end; ++i) {
+            ValidateClaim(m_groups[m_groupOf[i]], m_batch[i], out[i]);
+        }
+    });
+
+    // [SEQUENCE: MVP19-220] Stage timings and counters
+    StageTimes times;
+    times.group_us = std::chrono::duration<double, std::micro>(grouped - start).count();
+    times.rewind_us = std::chrono::duration<double, std::micro>(rewound - grouped).count();
+    times.narrow_us = MicrosSince(rewound);
+    times.total_us = MicrosSince(start);
+    m_stats.last = times;
+    m_stats.total.group_us += times.group_us;
+    m_stats.total.rewind_us += times.rewind_us;
+    m_stats.total.narrow_us += times.narrow_us;
+    m_stats.total.total_us += times.total_us;
+    ++m_stats.batches;
+    m_stats.claims += m_batch.size();
+    m_stats.groups += m_groupCount;
+    for (size_t g = 0; g < m_groupCount; ++g) {
+        m_stats.entities_rewound += m_groups[g].box_count;
+    }
+    for (const auto& verdict : out) {
+        ++(verdict.valid ? m_stats.valid : m_stats.rejected);
+    }
+}
+
+void HitValidationPipeline::ExportMetrics(monitoring::MetricsCollector& metrics) const {
+    metrics.RecordGauge("hit_validation.group_us", m_stats.last.group_us);
+    metrics.RecordGauge("hit_validation.rewind_us", m_stats.last.rewind_us);
+    metrics.RecordGauge("hit_validation.narrow_us", m_stats.last.narrow_us);
+    metrics.RecordGauge("hit_validation.total_us", m_stats.last.total_us);
+    metrics.RecordCounter("hit_validation.batches", m_stats.batches);
+    metrics.RecordCounter("hit_validation.claims", m_stats.claims);
+    metrics.RecordCounter("hit_validation.groups", m_stats.groups);
+    metrics.RecordCounter("hit_validation.entities_rewound", m_stats.entities_rewound);
+    metrics.RecordCounter("hit_validation.valid", m_stats.valid);
+    metrics.RecordCounter("hit_validation.rejected", m_stats.rejected);
+}
+
+// [SEQUENCE: MVP19-221] A fixed set of workers woken per job; tasks are handed out through an atomic counter and
+// the calling thread works alongside them.
+void HitValidationPipeline::ParallelFor(size_t count, const std::function<void(size_t)>& fn) {
+    if (m_workers.empty() || count < 2) {
+        for (size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+    {
+        std::lock_guard lock(m_poolMutex);
+        m_job = &fn;
+        m_jobCount = count;
+        m_nextTask.store(0, std::memory_order_relaxed);
+        m_activeWorkers = m_workers.size();
+        ++m_generation;
+    }
+    m_wake.notify_all();
+    RunJob();
+    std::unique_lock lock(m_poolMutex);
+    m_done.wait(lock, [this] { return m_activeWorkers == 0; });
+    m_job = nullptr;
+}
+
+void HitValidationPipeline::RunJob() {
+    for (size_t i = m_nextTask.fetch_add(1, std::memory_order_relaxed); i < m_jobCount;
+         i = m_nextTask.fetch_add(1, std::memory_order_relaxed)) {
+        (*m_job)(i);
+    }
+}
+
+void HitValidationPipeline::WorkerLoop() {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock lock(m_poolMutex);
+            m_wake.wait(lock, [&] { return m_stopping || m_generation != seen; });
+            if (m_stopping) return;
+            seen = m_generation;
+        }
+        RunJob();
+        std::lock_guard lock(m_poolMutex);
+        if (--m_activeWorkers == 0) m_done.notify_one();
+    }
+}
+
+} // namespace mmorpg::network
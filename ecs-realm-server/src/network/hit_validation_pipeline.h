@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "core/utils/vector3.h"
+#include "network/rewind_history.h"
+
+namespace mmorpg::monitoring {
+class MetricsCollector;
+}
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-215] Why a claim was turned down.
+enum class HitRejection : uint8_t {
+    None,
+    NoHistory,        // Nothing recorded to rewind to
+    Missed,           // The ray reaches no (or not the claimed) live hitbox within range
+    VictimNotFound,   // The claimed victim was not in the world at that time
+    VictimDead,
+};
+
+const char* ToString(HitRejection rejection);
+
+// One shot to validate. rewind_time is the server time the shooter was looking at, latency already applied.
+struct HitClaim {
+    uint64_t claim_id = 0;
+    uint64_t attacker_id = 0;
+    uint64_t victim_id = 0;   // 0 = whatever the ray reaches first
+    core::utils::Vector3 origin;
+    core::utils::Vector3 direction;
+    float max_range = 100.0f;
+    RewindHistory::Clock::time_point rewind_time;
+};
+
+struct HitVerdict {
+    uint64_t claim_id = 0;
+    uint64_t victim_id = 0;
+    bool valid = false;
+    HitRejection rejection = HitRejection::None;
+    float distance = 0.0f;
+    core::utils::Vector3 point;
+};
+
+struct HitValidationConfig {
+    size_t worker_count = 0;   // Threads besides the caller's; 0 validates on the calling thread only
+    // Rewind times are floored to this; claims in the same quantum share one rewound state
+    std::chrono::microseconds time_quantum{1000};
+};
+
+// [SEQUENCE: MVP19-216] Tick-batched hit validation against a RewindHistory.
+//
+// Claims are submitted as they arrive and validated together once per tick, in three stages:
+//   group   - sort the claims by quantized rewind time and locate each distinct time in the history once
+//   rewind  - per group (in parallel): one pass over the slot columns gathers every entity near any of the
+//             group's rays, and each is rewound once into a structure-of-arrays box list
+//   narrow  - per claim (in parallel): the ray is slab-tested against the group's boxes four at a time (SSE2
+//             where available); a claim naming its victim tests that victim's rewound box only
+// Each claim's verdict depends only on the claim and the history, ties go to the lower entity id, and verdicts are
+// returned in submission order, so the result is the same for any worker count.
+//
+// Submit may be called from any thread. ValidatePending must not overlap recording into the history.
+class HitValidationPipeline {
+public:
+    // Wall time of each stage, microseconds
+    struct StageTimes {
+        double group_us = 0.0;
+        double rewind_us = 0.0;
+        double narrow_us = 0.0;
+        double total_us = 0.0;
+    };
+
+    struct Stats {
+        uint64_t batches = 0;
+        uint64_t claims = 0;
+        uint64_t groups = 0;
+        uint64_t entities_rewound = 0;
+        uint64_t valid = 0;
+        uint64_t rejected = 0;
+        StageTimes last;    // Most recent batch
+        StageTimes total;   // Summed over all batches
+    };
+
+    HitValidationPipeline(const RewindHistory& history, const HitValidationConfig& config = {});
+    ~HitValidationPipeline();
+
+    HitValidationPipeline(const HitValidationPipeline&) = delete;
+    HitValidationPipeline& operator=(const HitValidationPipeline&) = delete;
+
+    void Submit(const HitClaim& claim);
+    size_t GetPendingCount() const;
+
+    // Validates every claim submitted since the last call. out[i] answers the i-th of them.
+    void ValidatePending(std::vector<HitVerdict>& out);
+
+    const Stats& GetStats() const { return m_stats; }
+    // Per-stage timings of the last batch as gauges, totals as counters, under "hit_validation.".
+    void ExportMetrics(monitoring::MetricsCollector& metrics) const;
+
+private:
+    using Clock = RewindHistory::Clock;
+
+    // Rewound live hitboxes near a group's rays, padded with empty lanes to a multiple of four
+    struct Group {
+        Clock::time_point time;
+        size_t first = 0;   // Range in m_order
+        size_t count = 0;
+        std::optional<RewindHistory::FrameRef> frame;
+        std::vector<RewindHistory::Area> areas;
+        std::vector<uint32_t> slots;
+        std::vector<uint64_t> ids;
+        std::vector<float> lo_x, lo_y, lo_z, hi_x, hi_y, hi_z;
+        size_t box_count = 0;
+    };
+
+    void BuildGroups();
+    void RewindGroup(Group& group);
+    void ValidateClaim(const Group& group, const HitClaim& claim, HitVerdict& out) const;
+
+    // Runs fn(0..count-1) across the workers and the calling thread; returns when all are done.
+    void ParallelFor(size_t count, const std::function<void(size_t)>& fn);
+    void RunJob();
+    void WorkerLoop();
+
+    const RewindHistory& m_history;
+    const HitValidationConfig m_config;
+
+    mutable std::mutex m_submitMutex;
+    std::vector<HitClaim> m_pending;
+    std::vector<HitClaim> m_batch;   // Claims being validated, swapped out of m_pending
+    std::vector<uint32_t> m_order;   // Batch indices sorted by quantized rewind time
+    std::vector<Group> m_groups;     // Reused across batches
+    size_t m_groupCount = 0;
+    std::vector<size_t> m_groupOf;   // Batch index -> group
+    Stats m_stats;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_poolMutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(size_t)>* m_job = nullptr;
+    size_t m_jobCount = 0;
+    std::atomic<size_t> m_nextTask{0};
+    size_t m_activeWorkers = 0;
+    uint64_t m_generation = 0;
+    bool m_stopping = false;
+};
+
+} // namespace mmorpg::network
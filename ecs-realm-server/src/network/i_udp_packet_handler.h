@@ -1,6 +1,7 @@
 #pragma once
 
 #include <boost/asio/ip/udp.hpp>
+#include <chrono>
 #include <memory>
 #include <vector>
 #include <cstddef>
@@ -18,6 +19,12 @@ class IUdpPacketHandler {
 public:
     virtual ~IUdpPacketHandler() = default;
     virtual void Handle(std::shared_ptr<Session> session, const boost::asio::ip::udp::endpoint& endpoint, const std::vector<std::byte>& buffer, size_t size) = 0;
+
+    // [SEQUENCE: MVP19-273] Called by every ingest worker once per reliability tick, so handlers that own
+    // connection state can run their timers. A handler shards its connections by worker_index / worker_count
+    // so each is ticked by exactly one worker.
+    virtual void OnWorkerTick([[maybe_unused]] size_t worker_index, [[maybe_unused]] size_t worker_count,
+                              [[maybe_unused]] std::chrono::steady_clock::time_point now) {}
 };
 
 }
\ No newline at end of file
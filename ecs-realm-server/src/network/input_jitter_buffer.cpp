@@ -0,0 +1,274 @@
+#include "network/input_jitter_buffer.h"
+#include "monitoring/metrics_collector.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace mmorpg::network {
+
+MoveState StepMovement(const MoveState& state, const TickInput& input, const MovementParams& params) {
+    const float dt = params.tick_seconds;
+    const bool sprinting = (input.flags & TickInput::kSprint) != 0;
+
+    float acceleration = params.acceleration;
+    if (sprinting) {
+        acceleration *= params.sprint_factor;
+    } else if (input.flags & TickInput::kCrouch) {
+        acceleration *= params.crouch_factor;
+    }
+
+    float vx = state.velocity.x + input.move_x * acceleration * dt;
+    float vz = state.velocity.z + input.move_z * acceleration * dt;
+    if (input.move_x * input.move_x + input.move_z * input.move_z < 1e-4f) {
+        vx *= params.idle_friction;
+        vz *= params.idle_friction;
+    }
+    const float max_speed = sprinting ? params.sprint_speed : params.run_speed;
+    const float speed_sq = vx * vx + vz * vz;
+    if (speed_sq > max_speed * max_speed) {
+        const float scale = max_speed / std::sqrt(speed_sq);
+        vx *= scale;
+        vz *= scale;
+    }
+
+    float vy = state.velocity.y;
+    if (state.position.y <= params.ground_height) {
+        vy = (input.flags & TickInput::kJump) ? params.jump_velocity : 0.0f;
+    } else {
+        vy -= params.gravity * dt;
+    }
+
+    MoveState next = state;
+    next.position.x = state.position.x + vx * dt;
+    next.position.y = state.position.y + vy * dt;
+    next.position.z = state.position.z + vz * dt;
+    if (next.position.y < params.ground_height) {   // Landed
+        next.position.y = params.ground_height;
+        vy = 0.0f;
+    }
+    next.velocity.x = vx;
+    next.velocity.y = vy;
+    next.velocity.z = vz;
+    next.yaw = input.yaw;
+    return next;
+}
+
+InputJitterBuffer::InputJitterBuffer(const InputJitterBufferConfig& config)
+    : m_config(config)
+    , m_slots(std::bit_ceil(std::max<size_t>(config.capacity, 2)))
+    , m_mask(static_cast<uint32_t>(m_slots.size() - 1))
+    , m_target(std::max<size_t>(config.min_depth, 1)) {
+    if (config.first_sequence) {
+        m_seenAny = true;
+        m_next = *config.first_sequence;
+        m_highest = m_next;
+    }
+}
+
+// [SEQUENCE: MVP19-232] Files an input under its sequence number; a late input for a replayed tick settles whether
+// the stand-in was right.
+InputJitterBuffer::PushResult InputJitterBuffer::Push(const TickInput& input, double arrival_seconds) {
+    ++m_stats.received;
+    const uint32_t sequence = input.sequence;
+    if (!m_seenAny) {
+        m_seenAny = true;
+        m_next = sequence;
+        m_highest = sequence;
+    }
+
+    if (sequence < m_next) {
+        if (!m_primed && !m_config.first_sequence && m_highest - sequence < m_slots.size()) {
+            m_next = sequence;   // Still priming: start from the earliest input seen
+        } else {
+            Slot& slot = SlotFor(sequence);
+            if (slot.state == SlotState::Replayed && slot.input.sequence == sequence) {
+                if (!(slot.input == input)) {
+                    ++m_stats.corrections;
+                }
+                slot.state = SlotState::Empty;
+            }
+            ++m_stats.late;
+            return PushResult::Late;
+        }
+    }
+    if (sequence - m_next >= m_slots.size()) {
+        ++m_stats.too_far_ahead;
+        return PushResult::TooFarAhead;
+    }
+
+    Slot& slot = SlotFor(sequence);
+    if (slot.state == SlotState::Buffered && slot.input.sequence == sequence) {
+        ++m_stats.duplicates;
+        return PushResult::Duplicate;
+    }
+    slot.input = input;
+    slot.state = SlotState::Buffered;
+    ++m_buffered;
+    m_highest = std::max(m_highest, sequence);
+    UpdateJitter(sequence, arrival_seconds);
+    return PushResult::Accepted;
+}
+
+// [SEQUENCE: MVP19-233] RFC 3550 interarrival jitter, with the sequence number as the send timestamp in ticks.
+void InputJitterBuffer::UpdateJitter(uint32_t sequence, double arrival_seconds) {
+    if (m_haveTransit) {
+        const double arrival_ticks = (arrival_seconds - m_lastArrival) / m_config.tick_seconds;
+        const double sent_ticks = static_cast<double>(sequence) - static_cast<double>(m_lastSequence);
+        const float deviation = static_cast<float>(std::abs(arrival_ticks - sent_ticks));
+        m_jitter += (deviation - m_jitter) / 16.0f;
+    }
+    m_haveTransit = true;
+    m_lastSequence = sequence;
+    m_lastArrival = arrival_seconds;
+}
+
+void InputJitterBuffer::UpdateTarget() {
+    const size_t min_depth = std::max<size_t>(m_config.min_depth, 1);
+    const size_t max_depth = std::max(m_config.max_depth, min_depth);
+    const size_t wanted = std::clamp<size_t>(
+        min_depth + static_cast<size_t>(std::lround(m_jitter * m_config.jitter_multiplier)), min_depth, max_depth);
+    if (wanted > m_target) {
+        m_target = wanted;
+        m_shrinkTicks = 0;
+    } else if (wanted < m_target) {
+        if (++m_shrinkTicks >= m_config.shrink_delay_ticks) {
+            --m_target;
+            m_shrinkTicks = 0;
+        }
+    } else {
+        m_shrinkTicks = 0;
+    }
+}
+
+// [SEQUENCE: MVP19-234] One server tick: the next input in sequence, plus one more while draining surplus depth;
+// nothing while priming or briefly waiting for a gap to fill.
+void InputJitterBuffer::ConsumeTick(std::vector<ConsumedInput>& out) {
+    out.clear();
+    if (!m_seenAny) {
+        return;
+    }
+    ++m_stats.ticks;
+    UpdateTarget();
+
+    if (!m_primed) {
+        const Slot& first = SlotFor(m_next);
+        if (m_buffered < m_target || first.state != SlotState::Buffered || first.input.sequence != m_next) {
+            return;
+        }
+        m_primed = true;
+        m_windowTicks = 0;
+        m_windowMin = std::numeric_limits<size_t>::max();
+    }
+
+    m_windowMin = std::min(m_windowMin, m_buffered);
+    if (++m_windowTicks >= m_config.drain_window_ticks) {
+        if (m_windowMin > m_target) {
+            m_drainPending = m_windowMin - m_target;
+        }
+        m_windowTicks = 0;
+        m_windowMin = std::numeric_limits<size_t>::max();
+    }
+
+    const Slot& next = SlotFor(m_next);
+    if (next.state == SlotState::Buffered && next.input.sequence == m_next) {
+        m_waitTicks = 0;
+        m_grewThisWait = false;
+        Take(out, false);
+        const Slot& extra = SlotFor(m_next);
+        if (m_drainPending > 0 && extra.state == SlotState::Buffered && extra.input.sequence == m_next) {
+            Take(out, false);
+            --m_drainPending;
+            ++m_stats.drained;
+        }
+        return;
+    }
+
+    // The next input is missing. Grow once per gap, wait a little for it, then replay the last input in its
+    // place if later ones are already here; with nothing buffered the client is not sending, so keep waiting.
+    m_drainPending = 0;
+    if (!m_grewThisWait) {
+        m_target = std::min(m_target + 1, std::max(m_config.max_depth, m_config.min_depth));
+        m_shrinkTicks = 0;
+        m_grewThisWait = true;
+    }
+    if (m_buffered > 0 && ++m_waitTicks > m_config.max_wait_ticks) {
+        Slot& slot = SlotFor(m_next);
+        slot.input = m_last;
+        slot.input.sequence = m_next;
+        slot.state = SlotState::Replayed;
+        m_waitTicks = 0;
+        Take(out, true);
+        return;
+    }
+    ++m_stats.stall_ticks;
+}
+
+void InputJitterBuffer::Take(std::vector<ConsumedInput>& out, bool replayed) {
+    Slot& slot = SlotFor(m_next);
+    out.push_back({slot.input, replayed});
+    m_last = slot.input;
+    if (replayed) {
+        ++m_stats.replayed;   // The slot keeps the stand-in until the real input turns up or the ring wraps
+    } else {
+        slot.state = SlotState::Empty;
+        --m_buffered;
+    }
+    ++m_next;
+    ++m_stats.consumed;
+}
+
+bool ResimulatedMovement::AdvanceTick(std::vector<InputJitterBuffer::ConsumedInput>& scratch) {
+    m_buffer.ConsumeTick(scratch);
+    for (const auto& consumed : scratch) {
+        m_state = StepMovement(m_state, consumed.input, m_params);
+        m_lastProcessed = consumed.input.sequence;
+    }
+    return !scratch.empty();
+}
+
+void InputBufferSummary::Add(const InputJitterBuffer& buffer) {
+    ++buffers;
+    depth_sum += static_cast<double>(buffer.GetBufferedCount());
+    target_sum += static_cast<double>(buffer.GetTargetDepth());
+    jitter_sum += buffer.GetJitterTicks();
+    max_depth = std::max(max_depth, buffer.GetBufferedCount());
+    max_target = std::max(max_target, buffer.GetTargetDepth());
+
+    const auto& stats = buffer.GetStats();
+    totals.received += stats.received;
+    totals.duplicates += stats.duplicates;
+    totals.late += stats.late;
+    totals.too_far_ahead += stats.too_far_ahead;
+    totals.ticks += stats.ticks;
+    totals.consumed += stats.consumed;
+    totals.replayed += stats.replayed;
+    totals.corrections += stats.corrections;
+    totals.stall_ticks += stats.stall_ticks;
+    totals.drained += stats.drained;
+}
+
+double InputBufferSummary::CorrectionRate() const {
+    return totals.consumed == 0 ? 0.0
+        : static_cast<double>(totals.corrections) / static_cast<double>(totals.consumed);
+}
+
+void InputBufferSummary::ExportMetrics(monitoring::MetricsCollector& metrics) const {
+    const double count = buffers == 0 ? 1.0 : static_cast<double>(buffers);
+    metrics.RecordGauge("prediction.buffer_depth_avg", depth_sum / count);
+    metrics.RecordGauge("prediction.buffer_depth_max", static_cast<double>(max_depth));
+    metrics.RecordGauge("prediction.target_depth_avg", target_sum / count);
+    metrics.RecordGauge("prediction.target_depth_max", static_cast<double>(max_target));
+    metrics.RecordGauge("prediction.jitter_ticks_avg", jitter_sum / count);
+    metrics.RecordGauge("prediction.correction_rate", CorrectionRate());
+    metrics.RecordCounter("prediction.inputs_received", totals.received);
+    metrics.RecordCounter("prediction.inputs_late", totals.late);
+    metrics.RecordCounter("prediction.inputs_consumed", totals.consumed);
+    metrics.RecordCounter("prediction.inputs_replayed", totals.replayed);
+    metrics.RecordCounter("prediction.corrections", totals.corrections);
+    metrics.RecordCounter("prediction.stall_ticks", totals.stall_ticks);
+    metrics.RecordCounter("prediction.drained", totals.drained);
+}
+
+} // namespace mmorpg::network
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "core/utils/vector3.h"
+
+namespace mmorpg::monitoring {
+class MetricsCollector;
+}
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-228] The movement-relevant part of one client input, one per client tick.
+struct TickInput {
+    enum Flags : uint8_t {
+        kJump = 0x01,
+        kSprint = 0x02,
+        kCrouch = 0x04,
+        kPrimary = 0x08,   // Primary attack held
+    };
+
+    uint32_t sequence = 0;
+    float move_x = 0.0f;   // Horizontal move direction; y is up and not steerable
+    float move_z = 0.0f;
+    float yaw = 0.0f;
+    uint8_t flags = 0;
+
+    bool operator==(const TickInput&) const = default;
+};
+
+struct MoveState {
+    core::utils::Vector3 position;
+    core::utils::Vector3 velocity;
+    float yaw = 0.0f;
+};
+
+struct MovementParams {
+    float tick_seconds = 1.0f / 60.0f;
+    float acceleration = 20.0f;
+    float sprint_factor = 1.5f;
+    float crouch_factor = 0.5f;
+    float idle_friction = 0.9f;   // Horizontal velocity kept per tick with no move input
+    float run_speed = 10.0f;
+    float sprint_speed = 15.0f;
+    float jump_velocity = 10.0f;
+    float gravity = 9.81f;
+    float ground_height = 0.0f;
+};
+
+// [SEQUENCE: MVP19-229] One fixed step of player movement. A pure function of its arguments with a fixed order of
+// float operations, so the client predicting and the server resimulating the same inputs from the same state
+// reach bit-identical states on the same build.
+MoveState StepMovement(const MoveState& state, const TickInput& input, const MovementParams& params = {});
+
+struct InputJitterBufferConfig {
+    double tick_seconds = 1.0 / 60.0;   // Client input rate, which is also the server's consume rate
+    size_t capacity = 64;          // Inputs held ahead of the next one to simulate; rounded up to a power of two
+    size_t min_depth = 1;          // Target depth in ticks is kept within [min_depth, max_depth]
+    size_t max_depth = 8;
+    float jitter_multiplier = 2.0f;      // Target depth = min_depth + round(jitter * multiplier)
+    uint32_t shrink_delay_ticks = 120;   // The target only drops after wanting to this many ticks in a row
+    uint32_t drain_window_ticks = 60;    // Depth beyond the target for a whole window is drained
+    uint32_t max_wait_ticks = 2;         // Ticks to wait for a missing input before replaying the last one
+    std::optional<uint32_t> first_sequence;   // Where the client starts counting; unset starts at the lowest seen
+};
+
+// [SEQUENCE: MVP19-230] Per-player input jitter buffer for fixed-step server simulation.
+//
+// Inputs are pushed as they arrive, in any order, into a ring indexed by sequence number, and consumed once per
+// server tick strictly in sequence order, so the server applies the client's inputs at the client's rate no
+// matter how the network bunched them. Consumption starts once target-depth inputs are buffered, beginning with
+// first_sequence if it is known.
+//
+// Target depth follows the measured jitter: the interarrival jitter estimator of RFC 3550, in ticks, over the
+// difference between arrival spacing and sequence spacing. It grows as soon as the jitter calls for it or the
+// buffer runs dry, and shrinks only after the jitter has stayed low for shrink_delay_ticks. The buffer tracks how
+// far it stays above the target: if it never dropped to the target within a drain window, the surplus is drained
+// by consuming one extra input on each of the next ticks.
+//
+// Every sequence number is consumed exactly once. A tick with the next input missing waits (nothing is
+// consumed, the player stands still) and, if later inputs are already here, replays the last input in place of
+// the missing one after max_wait_ticks. If the real input shows up later and differs from the replayed one, the
+// client's prediction diverged and is counted as a correction.
+//
+// Not thread-safe; the owner serializes Push and ConsumeTick.
+class InputJitterBuffer {
+public:
+    enum class PushResult : uint8_t {
+        Accepted,
+        Duplicate,     // Already buffered
+        Late,          // Its tick was already simulated
+        TooFarAhead,   // Further ahead than the ring holds
+    };
+
+    struct ConsumedInput {
+        TickInput input;
+        bool replayed = false;   // Stood in for a missing input
+    };
+
+    struct Stats {
+        uint64_t received = 0;
+        uint64_t duplicates = 0;
+        uint64_t late = 0;
+        uint64_t too_far_ahead = 0;
+        uint64_t ticks = 0;
+        uint64_t consumed = 0;
+        uint64_t replayed = 0;
+        uint64_t corrections = 0;   // Late inputs that differed from the replayed stand-in
+        uint64_t stall_ticks = 0;   // Ticks after priming that consumed nothing
+        uint64_t drained = 0;       // Extra inputs consumed to shrink the buffer
+    };
+
+    explicit InputJitterBuffer(const InputJitterBufferConfig& config = {});
+
+    // arrival_seconds is the receive time on any monotonic clock
+    PushResult Push(const TickInput& input, double arrival_seconds);
+
+    // Appends this tick's inputs to out (after clearing it) in sequence order: one normally, none while priming
+    // or waiting, two while draining.
+    void ConsumeTick(std::vector<ConsumedInput>& out);
+
+    bool IsPrimed() const { return m_primed; }
+    uint32_t GetNextSequence() const { return m_next; }
+    size_t GetBufferedCount() const { return m_buffered; }
+    size_t GetTargetDepth() const { return m_target; }
+    float GetJitterTicks() const { return m_jitter; }
+    const Stats& GetStats() const { return m_stats; }
+    const InputJitterBufferConfig& GetConfig() const { return m_config; }
+
+private:
+    enum class SlotState : uint8_t { Empty, Buffered, Replayed };
+
+    struct Slot {
+        TickInput input;
+        SlotState state = SlotState::Empty;
+    };
+
+    Slot& SlotFor(uint32_t sequence) { return m_slots[sequence & m_mask]; }
+    void UpdateJitter(uint32_t sequence, double arrival_seconds);
+    void UpdateTarget();
+    void Take(std::vector<ConsumedInput>& out, bool replayed);
+
+    const InputJitterBufferConfig m_config;
+    std::vector<Slot> m_slots;
+    uint32_t m_mask = 0;
+    uint32_t m_next = 0;          // Next sequence to simulate; before priming, the lowest seen
+    uint32_t m_highest = 0;
+    size_t m_buffered = 0;
+    bool m_seenAny = false;
+    bool m_primed = false;
+
+    TickInput m_last;             // Last consumed input, replayed for a missing one
+    uint32_t m_waitTicks = 0;
+    bool m_grewThisWait = false;
+
+    float m_jitter = 0.0f;        // Ticks
+    bool m_haveTransit = false;
+    uint32_t m_lastSequence = 0;
+    double m_lastArrival = 0.0;
+
+    size_t m_target = 1;
+    uint32_t m_shrinkTicks = 0;
+    uint32_t m_windowTicks = 0;
+    size_t m_windowMin = 0;
+    size_t m_drainPending = 0;
+
+    Stats m_stats;
+};
+
+// [SEQUENCE: MVP19-451] One player's jitter buffer and the movement state resimulated from it. The state starts
+// where the authority placed the player, not at the origin, and only consumed inputs move it from there; Reset
+// places it again after a spawn, teleport or other authoritative correction.
+//
+// Not thread-safe, like the buffer it owns.
+class ResimulatedMovement {
+public:
+    explicit ResimulatedMovement(const MoveState& start, const InputJitterBufferConfig& config = {},
+                                 const MovementParams& params = {})
+        : m_buffer(config), m_params(params), m_state(start) {}
+
+    InputJitterBuffer& GetBuffer() { return m_buffer; }
+    const InputJitterBuffer& GetBuffer() const { return m_buffer; }
+
+    void Reset(const MoveState& state) { m_state = state; }
+
+    // Consumes this tick's inputs and steps the state through each. Returns false if none was consumed.
+    bool AdvanceTick(std::vector<InputJitterBuffer::ConsumedInput>& scratch);
+
+    const MoveState& GetState() const { return m_state; }
+    uint32_t GetLastProcessedInput() const { return m_lastProcessed; }
+
+private:
+    InputJitterBuffer m_buffer;
+    const MovementParams m_params;
+    MoveState m_state;
+    uint32_t m_lastProcessed = 0;
+};
+
+// [SEQUENCE: MVP19-231] Aggregate of many players' buffers for tuning the latency/smoothness trade-off. Gauges
+// under "prediction." give the current average and maximum depth, target and jitter; counters give the summed
+// stats, and correction_rate is corrections per consumed input.
+struct InputBufferSummary {
+    size_t buffers = 0;
+    double depth_sum = 0.0;
+    double target_sum = 0.0;
+    double jitter_sum = 0.0;
+    size_t max_depth = 0;
+    size_t max_target = 0;
+    InputJitterBuffer::Stats totals;
+
+    void Add(const InputJitterBuffer& buffer);
+    double CorrectionRate() const;
+    void ExportMetrics(monitoring::MetricsCollector& metrics) const;
+};
+
+} // namespace mmorpg::network
@@ -0,0 +1,81 @@
+#include "network/io_context_pool.h"
+#include "core/logger.h"
+
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+
+namespace mmorpg::network {
+
+namespace {
+
+size_t ResolveThreadCount(size_t requested) {
+    if (requested > 0) return requested;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+} // namespace
+
+IoContextPool::IoContextPool(const Config& config)
+    : m_config(config),
+      m_threadCount(ResolveThreadCount(config.thread_count)) {
+    const size_t context_count = m_config.mode == Mode::PerCore ? m_threadCount : 1;
+    for (size_t i = 0; i < context_count; ++i) {
+        // A per-core context is only ever run by one thread, and the hint tells asio so. asio still locks its
+        // scheduler: Post() reaches the context from other threads, and only BOOST_ASIO_CONCURRENCY_HINT_UNSAFE
+        // would drop the locking.
+        const int concurrency_hint = m_config.mode == Mode::PerCore ? 1 : static_cast<int>(m_threadCount);
+        m_contexts.push_back(std::make_unique<boost::asio::io_context>(concurrency_hint));
+        m_workGuards.emplace_back(m_contexts.back()->get_executor());
+    }
+}
+
+IoContextPool::~IoContextPool() {
+    Stop();
+    Join();
+}
+
+// [SEQUENCE: MVP19-133] Thread i runs context (i % context_count): every thread on the one context when Shared,
+// its own context when PerCore.
+void IoContextPool::Run() {
+    if (m_running.exchange(true)) return;
+
+    for (size_t i = 0; i < m_threadCount; ++i) {
+        boost::asio::io_context& context = *m_contexts[i % m_contexts.size()];
+        m_threads.emplace_back([&context]() { context.run(); });
+        if (m_config.pin_threads) {
+            PinThread(m_threads.back(), i);
+        }
+    }
+
+    LOG_INFO("[IoContextPool] Running {} thread(s) on {} io_context(s){}", m_threadCount, m_contexts.size(),
+             m_config.pin_threads ? ", pinned" : "");
+}
+
+void IoContextPool::Stop() {
+    m_running = false;
+    for (auto& context : m_contexts) {
+        context->stop();
+    }
+}
+
+void IoContextPool::Join() {
+    for (auto& thread : m_threads) {
+        if (thread.joinable() && thread.get_id() != std::this_thread::get_id()) {
+            thread.join();
+        }
+    }
+    m_threads.clear();
+}
+
+void IoContextPool::PinThread(std::thread& thread, size_t index) {
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(index % cores, &cpuset);
+    if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpuset), &cpuset) != 0) {
+        LOG_ERROR("[IoContextPool] Failed to pin thread {} to core {}", index, index % cores);
+    }
+}
+
+} // namespace mmorpg::network
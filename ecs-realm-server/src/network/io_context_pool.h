@@ -0,0 +1,71 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-131] Owns the io_contexts the TCP side runs on, in one of two shapes:
+//   Shared  - one io_context run by thread_count threads; every strand competes for one scheduler queue.
+//   PerCore - thread_count io_contexts with one thread each. A socket accepted on context i is served by
+//             thread i for its whole life, so its handlers never migrate and never contend with other cores.
+// Work for another core is handed over explicitly with Post(); nothing else crosses contexts.
+class IoContextPool {
+public:
+    enum class Mode {
+        Shared,
+        PerCore,
+    };
+
+    struct Config {
+        Mode mode = Mode::Shared;
+        size_t thread_count = 0;    // 0 = std::thread::hardware_concurrency()
+        bool pin_threads = false;   // Pin thread i to core (i % hardware_concurrency)
+    };
+
+    explicit IoContextPool(const Config& config);
+    ~IoContextPool();
+
+    IoContextPool(const IoContextPool&) = delete;
+    IoContextPool& operator=(const IoContextPool&) = delete;
+
+    // Starts the threads. The pool keeps running until Stop(), even with no pending work.
+    void Run();
+    // Stops every context; handlers stop being run. Does not wait for the threads. Not async-signal-safe:
+    // io_context::stop() takes the scheduler's mutex, so a signal handler should set a flag and let a normal
+    // thread call this.
+    void Stop();
+    // Waits for the threads to exit after Stop().
+    void Join();
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    Mode GetMode() const { return m_config.mode; }
+    size_t GetContextCount() const { return m_contexts.size(); }
+    size_t GetThreadCount() const { return m_threadCount; }
+    boost::asio::io_context& GetContext(size_t index) { return *m_contexts[index % m_contexts.size()]; }
+
+    // [SEQUENCE: MVP19-132] Cross-core hand-off: runs fn on context index's thread.
+    template <typename Fn>
+    void Post(size_t index, Fn&& fn) {
+        boost::asio::post(GetContext(index), std::forward<Fn>(fn));
+    }
+
+private:
+    using WorkGuard = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
+
+    void PinThread(std::thread& thread, size_t index);
+
+    const Config m_config;
+    const size_t m_threadCount;
+    std::vector<std::unique_ptr<boost::asio::io_context>> m_contexts;
+    std::vector<WorkGuard> m_workGuards;
+    std::vector<std::thread> m_threads;
+    std::atomic<bool> m_running{false};
+};
+
+} // namespace mmorpg::network
@@ -0,0 +1,347 @@
+#include "network/kernel_tls.h"
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+
+#include <cstring>
+#include <string_view>
+
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+
+namespace mmorpg::network {
+
+const char* ToString(KernelTlsStatus status) {
+    switch (status) {
+        case KernelTlsStatus::Disabled: return "disabled";
+        case KernelTlsStatus::Enabled: return "enabled";
+        case KernelTlsStatus::UnsupportedProtocol: return "unsupported protocol";
+        case KernelTlsStatus::UnsupportedCipher: return "unsupported cipher";
+        case KernelTlsStatus::SecretsUnavailable: return "secrets unavailable";
+        case KernelTlsStatus::PendingInput: return "pending input";
+        case KernelTlsStatus::KernelUnsupported: return "kernel unsupported";
+        case KernelTlsStatus::KeyInstallFailed: return "key install failed";
+    }
+    return "unknown";
+}
+
+void KernelTlsSecrets::Clear() {
+    OPENSSL_cleanse(client.data(), client.size());
+    OPENSSL_cleanse(server.data(), server.size());
+    client_size = 0;
+    server_size = 0;
+}
+
+namespace kernel_tls {
+
+namespace {
+
+constexpr std::string_view kClientSecretLabel = "CLIENT_TRAFFIC_SECRET_0";
+constexpr std::string_view kServerSecretLabel = "SERVER_TRAFFIC_SECRET_0";
+
+int SecretsIndex() {
+    static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    return index;
+}
+
+int HexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool DecodeHex(std::string_view hex, uint8_t* out, size_t capacity, size_t& size) {
+    if (hex.size() % 2 != 0 || hex.size() / 2 > capacity) return false;
+    for (size_t i = 0; i < hex.size() / 2; ++i) {
+        const int high = HexValue(hex[2 * i]);
+        const int low = HexValue(hex[2 * i + 1]);
+        if (high < 0 || low < 0) return false;
+        out[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    size = hex.size() / 2;
+    return true;
+}
+
+// [SEQUENCE: MVP19-120] Key log lines are "<LABEL> <client_random hex> <secret hex>". Only the two application
+// traffic secrets are kept; handshake and exporter secrets are ignored.
+void OnKeyLog(const SSL* ssl, const char* line) {
+    auto* secrets = static_cast<KernelTlsSecrets*>(SSL_get_ex_data(ssl, SecretsIndex()));
+    if (!secrets) return;
+
+    const std::string_view text(line);
+    const size_t first_space = text.find(' ');
+    const size_t second_space = first_space == std::string_view::npos ? first_space : text.find(' ', first_space + 1);
+    if (second_space == std::string_view::npos) return;
+
+    const std::string_view label = text.substr(0, first_space);
+    const std::string_view secret = text.substr(second_space + 1);
+    if (label == kClientSecretLabel) {
+        DecodeHex(secret, secrets->client.data(), secrets->client.size(), secrets->client_size);
+    } else if (label == kServerSecretLabel) {
+        DecodeHex(secret, secrets->server.data(), secrets->server.size(), secrets->server_size);
+    }
+}
+
+// RFC 8446 7.1 HKDF-Expand-Label with an empty context.
+bool ExpandLabel(const EVP_MD* digest, const uint8_t* secret, size_t secret_size, std::string_view label,
+                 uint8_t* out, size_t out_size) {
+    constexpr std::string_view kPrefix = "tls13 ";
+    uint8_t info[2 + 1 + 255 + 1];
+    size_t info_size = 0;
+    info[info_size++] = static_cast<uint8_t>(out_size >> 8);
+    info[info_size++] = static_cast<uint8_t>(out_size & 0xFF);
+    info[info_size++] = static_cast<uint8_t>(kPrefix.size() + label.size());
+    std::memcpy(info + info_size, kPrefix.data(), kPrefix.size());
+    info_size += kPrefix.size();
+    std::memcpy(info + info_size, label.data(), label.size());
+    info_size += label.size();
+    info[info_size++] = 0;   // Empty context
+
+    EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr);
+    if (!context) return false;
+    size_t derived = out_size;
+    const bool ok = EVP_PKEY_derive_init(context) > 0 &&
+                    EVP_PKEY_CTX_set_hkdf_mode(context, EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) > 0 &&
+                    EVP_PKEY_CTX_set_hkdf_md(context, digest) > 0 &&
+                    EVP_PKEY_CTX_set1_hkdf_key(context, secret, static_cast<int>(secret_size)) > 0 &&
+                    EVP_PKEY_CTX_add1_hkdf_info(context, info, static_cast<int>(info_size)) > 0 &&
+                    EVP_PKEY_derive(context, out, &derived) > 0 &&
+                    derived == out_size;
+    EVP_PKEY_CTX_free(context);
+    return ok;
+}
+
+// The kernel takes one crypto_info struct per direction. GCM splits the 12-byte TLS 1.3 IV into a 4-byte salt
+// and an 8-byte explicit part; ChaCha20 takes it whole. The record sequence starts at zero in both directions.
+union CryptoInfo {
+    tls12_crypto_info_aes_gcm_128 aes_128;
+    tls12_crypto_info_aes_gcm_256 aes_256;
+    tls12_crypto_info_chacha20_poly1305 chacha;
+};
+
+struct CipherSpec {
+    uint16_t kernel_cipher = 0;
+    size_t key_size = 0;
+    size_t crypto_info_size = 0;
+    const EVP_MD* digest = nullptr;
+};
+
+bool LookupCipher(const SSL_CIPHER* cipher, CipherSpec& spec) {
+    switch (SSL_CIPHER_get_protocol_id(cipher)) {
+        case 0x1301:   // TLS_AES_128_GCM_SHA256
+            spec = {TLS_CIPHER_AES_GCM_128, TLS_CIPHER_AES_GCM_128_KEY_SIZE, sizeof(tls12_crypto_info_aes_gcm_128), EVP_sha256()};
+            return true;
+        case 0x1302:   // TLS_AES_256_GCM_SHA384
+            spec = {TLS_CIPHER_AES_GCM_256, TLS_CIPHER_AES_GCM_256_KEY_SIZE, sizeof(tls12_crypto_info_aes_gcm_256), EVP_sha384()};
+            return true;
+        case 0x1303:   // TLS_CHACHA20_POLY1305_SHA256
+            spec = {TLS_CIPHER_CHACHA20_POLY1305, TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE, sizeof(tls12_crypto_info_chacha20_poly1305), EVP_sha256()};
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool BuildCryptoInfo(const CipherSpec& spec, const uint8_t* secret, size_t secret_size, CryptoInfo& info) {
+    uint8_t key[32];
+    uint8_t iv[12];
+    const bool derived = ExpandLabel(spec.digest, secret, secret_size, "key", key, spec.key_size) &&
+                         ExpandLabel(spec.digest, secret, secret_size, "iv", iv, sizeof(iv));
+    if (derived) {
+        std::memset(&info, 0, sizeof(info));
+        switch (spec.kernel_cipher) {
+            case TLS_CIPHER_AES_GCM_128:
+                info.aes_128.info = {TLS_1_3_VERSION, TLS_CIPHER_AES_GCM_128};
+                std::memcpy(info.aes_128.salt, iv, TLS_CIPHER_AES_GCM_128_SALT_SIZE);
+                std::memcpy(info.aes_128.iv, iv + TLS_CIPHER_AES_GCM_128_SALT_SIZE, TLS_CIPHER_AES_GCM_128_IV_SIZE);
+                std::memcpy(info.aes_128.key, key, TLS_CIPHER_AES_GCM_128_KEY_SIZE);
+                break;
+            case TLS_CIPHER_AES_GCM_256:
+                info.aes_256.info = {TLS_1_3_VERSION, TLS_CIPHER_AES_GCM_256};
+                std::memcpy(info.aes_256.salt, iv, TLS_CIPHER_AES_GCM_256_SALT_SIZE);
+                std::memcpy(info.aes_256.iv, iv + TLS_CIPHER_AES_GCM_256_SALT_SIZE, TLS_CIPHER_AES_GCM_256_IV_SIZE);
+                std::memcpy(info.aes_256.key, key, TLS_CIPHER_AES_GCM_256_KEY_SIZE);
+                break;
+            default:
+                info.chacha.info = {TLS_1_3_VERSION, TLS_CIPHER_CHACHA20_POLY1305};
+                std::memcpy(info.chacha.iv, iv, TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE);
+                std::memcpy(info.chacha.key, key, TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE);
+                break;
+        }
+    }
+    OPENSSL_cleanse(key, sizeof(key));
+    OPENSSL_cleanse(iv, sizeof(iv));
+    return derived;
+}
+
+bool Supports(const KernelTlsSupport& support, uint16_t kernel_cipher) {
+    switch (kernel_cipher) {
+        case TLS_CIPHER_AES_GCM_128: return support.aes_128_gcm;
+        case TLS_CIPHER_AES_GCM_256: return support.aes_256_gcm;
+        case TLS_CIPHER_CHACHA20_POLY1305: return support.chacha20_poly1305;
+        default: return false;
+    }
+}
+
+struct ScopedFd {
+    int fd = -1;
+    ~ScopedFd() {
+        if (fd >= 0) close(fd);
+    }
+};
+
+// The ULP can only be attached to an established connection, so the probe needs a real loopback pair
+bool ConnectLoopback(ScopedFd& client, ScopedFd& server) {
+    ScopedFd listener{socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    if (listener.fd < 0) return false;
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t address_size = sizeof(address);
+    if (bind(listener.fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listener.fd, 1) != 0 ||
+        getsockname(listener.fd, reinterpret_cast<sockaddr*>(&address), &address_size) != 0) {
+        return false;
+    }
+
+    client.fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (client.fd < 0 || connect(client.fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        return false;
+    }
+    server.fd = accept4(listener.fd, nullptr, nullptr, SOCK_CLOEXEC);
+    return server.fd >= 0;
+}
+
+// TLS_TX and TLS_RX can each be set only once per socket, so every cipher gets its own connection. The keys
+// are zero; no record is ever sent.
+bool ProbeCipher(uint16_t kernel_cipher, size_t crypto_info_size, bool& ulp) {
+    ScopedFd client;
+    ScopedFd server;
+    if (!ConnectLoopback(client, server)) return false;
+
+    static constexpr char kUlp[] = "tls";
+    if (setsockopt(client.fd, IPPROTO_TCP, TCP_ULP, kUlp, sizeof(kUlp)) != 0) return false;
+    ulp = true;
+
+    CryptoInfo info;
+    std::memset(&info, 0, sizeof(info));
+    info.aes_128.info = {TLS_1_3_VERSION, kernel_cipher};   // Every crypto_info starts with the same header
+    const auto size = static_cast<socklen_t>(crypto_info_size);
+    return setsockopt(client.fd, SOL_TLS, TLS_TX, &info, size) == 0 &&
+           setsockopt(client.fd, SOL_TLS, TLS_RX, &info, size) == 0;
+}
+
+} // namespace
+
+const KernelTlsSupport& ProbeSupport() {
+    static const KernelTlsSupport support = [] {
+        KernelTlsSupport result;
+        result.aes_128_gcm = ProbeCipher(TLS_CIPHER_AES_GCM_128, sizeof(tls12_crypto_info_aes_gcm_128), result.ulp);
+        result.aes_256_gcm = ProbeCipher(TLS_CIPHER_AES_GCM_256, sizeof(tls12_crypto_info_aes_gcm_256), result.ulp);
+        result.chacha20_poly1305 = ProbeCipher(TLS_CIPHER_CHACHA20_POLY1305,
+                                               sizeof(tls12_crypto_info_chacha20_poly1305), result.ulp);
+        return result;
+    }();
+    return support;
+}
+
+void InstallSecretCapture(SSL_CTX* context) {
+    SecretsIndex();
+    SSL_CTX_set_keylog_callback(context, &OnKeyLog);
+}
+
+void PrepareSession(SSL* ssl, KernelTlsSecrets* secrets) {
+    SSL_set_ex_data(ssl, SecretsIndex(), secrets);
+    SSL_set_num_tickets(ssl, 0);
+}
+
+// [SEQUENCE: MVP19-121] Everything that can fail without touching the socket is checked first, so the only
+// unrecoverable outcome is the kernel rejecting keys after the ULP is already attached.
+// [SEQUENCE: MVP19-443] The probe result screens out ciphers and kernels that would reject the keys. TLS_TX goes
+// first: a socket whose TLS_TX was refused still passes plain bytes through the ULP, so userspace TLS carries on.
+// Only TLS_RX failing after TLS_TX succeeded, which the probe makes a kernel bug rather than a missing feature,
+// still closes the session.
+KernelTlsStatus EnableKernelTls(int fd, SSL* ssl, KernelTlsSecrets& secrets) {
+    SSL_set_ex_data(ssl, SecretsIndex(), nullptr);
+    struct Wipe {
+        KernelTlsSecrets& secrets;
+        ~Wipe() { secrets.Clear(); }
+    } wipe{secrets};
+
+    if (SSL_version(ssl) != TLS1_3_VERSION) return KernelTlsStatus::UnsupportedProtocol;
+
+    CipherSpec spec;
+    const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+    if (!cipher || !LookupCipher(cipher, spec)) return KernelTlsStatus::UnsupportedCipher;
+    const KernelTlsSupport& support = ProbeSupport();
+    if (!support.ulp) return KernelTlsStatus::KernelUnsupported;
+    if (!Supports(support, spec.kernel_cipher)) return KernelTlsStatus::UnsupportedCipher;
+    if (secrets.client_size == 0 || secrets.server_size == 0) return KernelTlsStatus::SecretsUnavailable;
+
+    // Records the client sent right behind its Finished may already sit in the BIO pair; they were numbered
+    // under the userspace state and the kernel would start the receive sequence from the wrong place.
+    if (SSL_has_pending(ssl) || BIO_ctrl_pending(SSL_get_rbio(ssl)) > 0) return KernelTlsStatus::PendingInput;
+
+    CryptoInfo tx;
+    CryptoInfo rx;
+    const bool built = BuildCryptoInfo(spec, secrets.server.data(), secrets.server_size, tx) &&
+                       BuildCryptoInfo(spec, secrets.client.data(), secrets.client_size, rx);
+    struct WipeInfo {
+        CryptoInfo& tx;
+        CryptoInfo& rx;
+        ~WipeInfo() {
+            OPENSSL_cleanse(&tx, sizeof(tx));
+            OPENSSL_cleanse(&rx, sizeof(rx));
+        }
+    } wipe_info{tx, rx};
+    if (!built) return KernelTlsStatus::SecretsUnavailable;
+
+    static constexpr char kUlp[] = "tls";
+    if (setsockopt(fd, IPPROTO_TCP, TCP_ULP, kUlp, sizeof(kUlp)) != 0) return KernelTlsStatus::KernelUnsupported;
+
+    if (setsockopt(fd, SOL_TLS, TLS_TX, &tx, static_cast<socklen_t>(spec.crypto_info_size)) != 0) {
+        return KernelTlsStatus::UnsupportedCipher;
+    }
+    if (setsockopt(fd, SOL_TLS, TLS_RX, &rx, static_cast<socklen_t>(spec.crypto_info_size)) != 0) {
+        return KernelTlsStatus::KeyInstallFailed;
+    }
+    return KernelTlsStatus::Enabled;
+}
+
+void SendCloseNotify(int fd) {
+    static constexpr uint8_t kAlertRecordType = 21;
+    uint8_t alert[2] = {1, 0};   // warning, close_notify
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(kAlertRecordType))] = {};
+
+    iovec iov{alert, sizeof(alert)};
+    msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_TLS;
+    header->cmsg_type = TLS_SET_RECORD_TYPE;
+    header->cmsg_len = CMSG_LEN(sizeof(kAlertRecordType));
+    std::memcpy(CMSG_DATA(header), &kAlertRecordType, sizeof(kAlertRecordType));
+
+    (void)sendmsg(fd, &message, MSG_DONTWAIT | MSG_NOSIGNAL);
+}
+
+} // namespace kernel_tls
+
+} // namespace mmorpg::network
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <openssl/ssl.h>
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-117] Outcome of trying to move a session's record layer into the kernel.
+// Anything other than Enabled leaves the session on the userspace ssl::stream path, except where noted.
+enum class KernelTlsStatus : uint8_t {
+    Disabled = 0,            // Not requested for this session
+    Enabled,                 // TLS_TX and TLS_RX installed; reads and writes go straight to the socket
+    UnsupportedProtocol,     // Negotiated something other than TLS 1.3
+    UnsupportedCipher,       // Cipher suite the kernel has no offload for, or TLS_TX was rejected for it
+    SecretsUnavailable,      // Traffic secrets were not captured (context not prepared with InstallSecretCapture)
+    PendingInput,            // Client records were already buffered in userspace; their sequence is unknown
+    KernelUnsupported,       // The "tls" ULP could not be attached (module missing or kernel too old)
+    KeyInstallFailed,        // TLS_TX installed but TLS_RX rejected; the session cannot continue
+};
+
+const char* ToString(KernelTlsStatus status);
+
+// [SEQUENCE: MVP19-118] Application traffic secrets captured from OpenSSL's key log callback during the handshake.
+// asio drives OpenSSL through a memory BIO pair, so OpenSSL's built-in kTLS (SSL_OP_ENABLE_KTLS) never sees the
+// socket; the keys have to be derived here and handed to the kernel directly.
+struct KernelTlsSecrets {
+    static constexpr size_t kMaxSecretSize = 48;   // SHA-384
+
+    std::array<uint8_t, kMaxSecretSize> client{};
+    std::array<uint8_t, kMaxSecretSize> server{};
+    size_t client_size = 0;
+    size_t server_size = 0;
+
+    void Clear();
+};
+
+// [SEQUENCE: MVP19-442] Which TLS 1.3 ciphers the running kernel accepted keys for in both directions on a
+// throwaway loopback connection. Kernels differ: TLS_RX arrived after TLS_TX, TLS 1.3 needs 5.1 and
+// ChaCha20-Poly1305 5.11, and any of them can be configured out.
+struct KernelTlsSupport {
+    bool ulp = false;
+    bool aes_128_gcm = false;
+    bool aes_256_gcm = false;
+    bool chacha20_poly1305 = false;
+
+    bool Any() const { return aes_128_gcm || aes_256_gcm || chacha20_poly1305; }
+};
+
+// [SEQUENCE: MVP19-119] TLS 1.3 only (AES-128-GCM, AES-256-GCM, ChaCha20-Poly1305).
+// Usage: InstallSecretCapture once on the server context, PrepareSession on each SSL before its handshake, then
+// EnableKernelTls on the socket once the handshake has completed and before any application record is exchanged.
+namespace kernel_tls {
+
+// Registers the key log callback that feeds KernelTlsSecrets. Sessions without PrepareSession are ignored.
+void InstallSecretCapture(SSL_CTX* context);
+
+// Binds the secrets holder to the connection and turns off session tickets, so no application-key record is
+// written by OpenSSL before the kernel takes over and the transmit sequence number starts at zero.
+void PrepareSession(SSL* ssl, KernelTlsSecrets* secrets);
+
+// Runs the probe on first call and returns the cached result afterwards. Call it at startup so the first
+// session does not pay for it.
+const KernelTlsSupport& ProbeSupport();
+
+// Installs TLS_TX and TLS_RX on fd, or leaves fd on userspace TLS when the probe found no offload for the
+// negotiated cipher. Clears the captured secrets whatever the outcome.
+KernelTlsStatus EnableKernelTls(int fd, SSL* ssl, KernelTlsSecrets& secrets);
+
+// Sends a close_notify alert through the kernel record layer. Best effort; the socket is about to be closed.
+void SendCloseNotify(int fd);
+
+} // namespace kernel_tls
+
+} // namespace mmorpg::network
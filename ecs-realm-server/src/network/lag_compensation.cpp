@@ -5,13 +5,26 @@
 #include <spdlog/spdlog.h>
 #include <algorithm>
 #include <cmath>
+#include <thread>
 
 namespace mmorpg::network {
 
 // [SEQUENCE: 3762] Lag compensation constructor
 LagCompensation::LagCompensation() {
     last_snapshot_time_ = std::chrono::steady_clock::now();
-    spdlog::info("[LagCompensation] System initialized");
+    ResizeHistory();
+    spdlog::info("[LagCompensation] System initialized ({} MB rewind history)",
+                 history_->GetMemoryFootprint() / (1024 * 1024));
+}
+
+// [SEQUENCE: MVP19-211] The ring holds max_rewind_time_ worth of frames plus a small margin; it is rebuilt (and
+// emptied) only when the rewind window or snapshot rate changes.
+void LagCompensation::ResizeHistory() {
+    RewindHistoryConfig config;
+    const auto interval = std::max<int64_t>(1, snapshot_interval_.count());
+    config.frame_capacity = static_cast<size_t>(max_rewind_time_.count() / interval) + 8;
+    config.extrapolation_limit = extrapolation_limit_;
+    history_ = std::make_unique<RewindHistory>(config);
 }
 
 // [SEQUENCE: 3763] Record world snapshot
@@ -28,155 +41,21 @@ void LagCompensation::RecordSnapshot() {
     
     std::unique_lock lock(mutex_);
     
-    // Create new snapshot
-    WorldSnapshot snapshot;
-    snapshot.tick = world::WorldManager::Instance().GetCurrentTick();
-    snapshot.timestamp = now;
-    
-    // Record all entity states
+    // [SEQUENCE: MVP19-212] Write every entity into the next ring frame; the oldest frame is recycled in place.
+    history_->BeginFrame(now);
     auto& world = world::WorldManager::Instance();
     for (const auto& entity : world.GetAllEntities()) {
-        WorldSnapshot::EntityState state;
-        state.entity_id = entity->GetId();
-        state.position = entity->GetPosition();
-        state.velocity = entity->GetVelocity();
-        state.rotation = entity->GetRotation();
-        state.hitbox = entity->GetHitbox();
-        state.health = entity->GetHealth();
-        state.is_alive = entity->IsAlive();
-        
-        snapshot.entity_states[state.entity_id] = state;
-    }
-    
-    // Record projectile states
-    for (const auto& projectile : world.GetActiveProjectiles()) {
-        WorldSnapshot::ProjectileState proj_state;
-        proj_state.projectile_id = projectile->GetId();
-        proj_state.position = projectile->GetPosition();
-        proj_state.velocity = projectile->GetVelocity();
-        proj_state.radius = projectile->GetRadius();
-        proj_state.owner_id = projectile->GetOwnerId();
-        
-        snapshot.projectile_states.push_back(proj_state);
+        const BoundingBox hitbox = entity->GetHitbox();
+        history_->Record(entity->GetId(), entity->GetPosition(), entity->GetVelocity(),
+                         (hitbox.max - hitbox.min) * 0.5f, entity->IsAlive());
     }
     
-    // Add to history
-    snapshots_.push_back(std::move(snapshot));
     last_snapshot_time_ = now;
-    
-    // Cleanup old snapshots
-    CleanupOldSnapshots();
-}
-
-void LagCompensation::CleanupOldSnapshots() {
-    auto now = std::chrono::steady_clock::now();
-    auto cutoff_time = now - max_rewind_time_ - std::chrono::milliseconds(100);  // Buffer
-    
-    while (!snapshots_.empty() && snapshots_.front().timestamp < cutoff_time) {
-        snapshots_.pop_front();
-    }
-    
-    // Ensure we don't exceed max snapshots
-    while (snapshots_.size() > MAX_SNAPSHOTS) {
-        snapshots_.pop_front();
-    }
-}
-
-// [SEQUENCE: 3764] Get snapshot at specific time
-std::optional<WorldSnapshot> LagCompensation::GetSnapshotAtTime(
-    std::chrono::steady_clock::time_point target_time) {
-    
-    std::shared_lock lock(mutex_);
-    
-    if (snapshots_.empty()) {
-        return std::nullopt;
-    }
-    
-    // Check if time is valid
-    if (!IsTimeValid(target_time)) {
-        spdlog::warn("[LagCompensation] Invalid rewind time requested");
-        return std::nullopt;
-    }
-    
-    // Find surrounding snapshots
-    const WorldSnapshot* before = nullptr;
-    const WorldSnapshot* after = nullptr;
-    
-    for (size_t i = 0; i < snapshots_.size() - 1; ++i) {
-        if (snapshots_[i].timestamp <= target_time &&
-            snapshots_[i + 1].timestamp > target_time) {
-            before = &snapshots_[i];
-            after = &snapshots_[i + 1];
-            break;
-        }
-    }
-    
-    // Exact match
-    if (before && before->timestamp == target_time) {
-        return *before;
-    }
-    
-    // Interpolation needed
-    if (before && after && interpolation_enabled_) {
-        return InterpolateSnapshots(*before, *after, target_time);
-    }
-    
-    // Return closest
-    if (target_time <= snapshots_.front().timestamp) {
-        return snapshots_.front();
-    } else if (target_time >= snapshots_.back().timestamp) {
-        // Extrapolation with limit
-        auto time_diff = std::chrono::duration_cast<std::chrono::milliseconds>(
-            target_time - snapshots_.back().timestamp);
-        
-        if (time_diff <= extrapolation_limit_) {
-            // Simple extrapolation
-            WorldSnapshot extrapolated = snapshots_.back();
-            float dt = time_diff.count() / 1000.0f;
-            
-            for (auto& [id, state] : extrapolated.entity_states) {
-                state.position += state.velocity * dt;
-            }
-            
-            return extrapolated;
-        }
-        
-        return snapshots_.back();
-    }
-    
-    return std::nullopt;
 }
 
-// [SEQUENCE: 3765] Interpolate between snapshots
-WorldSnapshot LagCompensation::InterpolateSnapshots(
-    const WorldSnapshot& before,
-    const WorldSnapshot& after,
-    std::chrono::steady_clock::time_point target_time) {
-    
-    float t = InterpolationUtils::CalculateInterpolationFactor(
-        before.timestamp, after.timestamp, target_time);
-    
-    WorldSnapshot interpolated;
-    interpolated.tick = before.tick;  // Use earlier tick
-    interpolated.timestamp = target_time;
-    
-    // Interpolate entity states
-    for (const auto& [id, before_state] : before.entity_states) {
-        auto after_it = after.entity_states.find(id);
-        if (after_it != after.entity_states.end()) {
-            interpolated.entity_states[id] = InterpolationUtils::InterpolateEntityState(
-                before_state, after_it->second, t);
-        } else {
-            // Entity disappeared, use last known state
-            interpolated.entity_states[id] = before_state;
-        }
-    }
-    
-    // Handle projectiles (no interpolation, too fast)
-    interpolated.projectile_states = t < 0.5f ? 
-        before.projectile_states : after.projectile_states;
-    
-    return interpolated;
+void LagCompensation::OnEntityRemoved(uint64_t entity_id) {
+    std::unique_lock lock(mutex_);
+    history_->RemoveEntity(entity_id);
 }
 
 // [SEQUENCE: 3766] Validate hit with lag compensation
@@ -200,42 +79,51 @@ HitValidation LagCompensation::ValidateHit(
     // Calculate server time when shot was fired
     auto server_shot_time = shot_time - std::chrono::milliseconds(static_cast<int>(latency));
     
-    // Get world state at that time
-    auto snapshot_opt = GetSnapshotAtTime(server_shot_time);
-    if (!snapshot_opt) {
-        result.rejection_reason = "No snapshot available";
-        return result;
-    }
-    
-    const auto& snapshot = *snapshot_opt;
-    
-    // Find victim state
-    auto victim_it = snapshot.entity_states.find(victim_id);
-    if (victim_it == snapshot.entity_states.end()) {
-        result.rejection_reason = "Victim not found in snapshot";
-        return result;
-    }
-    
-    const auto& victim_state = victim_it->second;
-    
-    // Check if victim was alive
-    if (!victim_state.is_alive) {
-        result.rejection_reason = "Victim was already dead";
+    if (!IsTimeValid(server_shot_time)) {
+        result.rejection_reason = "Invalid rewind time";
         return result;
     }
     
-    // Perform raycast in rewound world
+    // [SEQUENCE: MVP19-213] Rewind only what the shot needs: the claimed victim, or the entities near the ray
+    // when the client did not name one.
+    std::shared_lock lock(mutex_);
     physics::RaycastHit hit;
-    bool hit_something = physics::Raycast(
-        shot_origin,
-        shot_direction,
-        max_range,
-        victim_state.hitbox,
-        hit);
-    
-    if (!hit_something) {
-        result.rejection_reason = "Raycast missed";
-        return result;
+    if (victim_id == 0) {
+        auto ray_hit = history_->RaycastAt(server_shot_time, shot_origin, shot_direction, max_range, attacker_id);
+        if (!ray_hit) {
+            result.rejection_reason = "Raycast missed";
+            return result;
+        }
+        victim_id = ray_hit->entity_id;
+        hit.point = ray_hit->point;
+    } else {
+        auto victim_state = history_->GetEntityAt(victim_id, server_shot_time);
+        if (!victim_state) {
+            result.rejection_reason = "Victim not found in snapshot";
+            return result;
+        }
+        
+        // Check if victim was alive
+        if (!victim_state->alive) {
+            result.rejection_reason = "Victim was already dead";
+            return result;
+        }
+        
+        // Perform raycast in rewound world
+        BoundingBox hitbox;
+        hitbox.min = victim_state->position - victim_state->half_extents;
+        hitbox.max = victim_state->position + victim_state->half_extents;
+        bool hit_something = physics::Raycast(
+            shot_origin,
+            shot_direction,
+            max_range,
+            hitbox,
+            hit);
+        
+        if (!hit_something) {
+            result.rejection_reason = "Raycast missed";
+            return result;
+        }
     }
     
     // Validate hit distance
@@ -280,17 +168,10 @@ bool LagCompensation::ValidateMovement(
     std::chrono::steady_clock::time_point from_time,
     std::chrono::steady_clock::time_point to_time) {
     
-    // Get snapshots at both times
-    auto from_snapshot = GetSnapshotAtTime(from_time);
-    auto to_snapshot = GetSnapshotAtTime(to_time);
-    
-    if (!from_snapshot || !to_snapshot) {
-        return false;  // Can't validate without data
-    }
+    std::shared_lock lock(mutex_);
     
-    // Check player state at start
-    auto from_it = from_snapshot->entity_states.find(player_id);
-    if (from_it == from_snapshot->entity_states.end()) {
+    // The player must have been in the world at the start of the move
+    if (!history_->GetEntityAt(player_id, from_time)) {
         return false;
     }
     
@@ -348,10 +229,10 @@ float LagCompensation::GetPlayerLatency(uint64_t player_id) const {
 
 // [SEQUENCE: 3769] Rewind context implementation
 RewindContext::RewindContext(std::chrono::steady_clock::time_point target_time)
-    : target_time_(target_time) {
+    : history_(LagCompensation::Instance().GetHistory())
+    , target_time_(target_time) {
     
-    snapshot_ = LagCompensation::Instance().GetSnapshotAtTime(target_time);
-    if (!snapshot_) {
+    if (history_.GetFrameCount() == 0) {
         spdlog::warn("[RewindContext] Failed to get snapshot for rewind");
     }
 }
@@ -361,19 +242,10 @@ RewindContext::~RewindContext() {
     // For now, we're just reading, not modifying
 }
 
-std::optional<WorldSnapshot::EntityState> RewindContext::GetEntityState(
+std::optional<RewoundEntity> RewindContext::GetEntityState(
     uint64_t entity_id) const {
     
-    if (!snapshot_) {
-        return std::nullopt;
-    }
-    
-    auto it = snapshot_->entity_states.find(entity_id);
-    if (it != snapshot_->entity_states.end()) {
-        return it->second;
-    }
-    
-    return std::nullopt;
+    return history_.GetEntityAt(entity_id, target_time_);
 }
 
 bool RewindContext::PerformRaycast(
@@ -383,32 +255,14 @@ bool RewindContext::PerformRaycast(
     uint64_t ignore_entity,
     physics::RaycastHit& hit) {
     
-    if (!snapshot_) {
+    auto ray_hit = history_.RaycastAt(target_time_, origin, direction, max_distance, ignore_entity);
+    if (!ray_hit) {
         return false;
     }
     
-    // Check against all entities in snapshot
-    float closest_distance = max_distance;
-    bool hit_something = false;
-    
-    for (const auto& [id, state] : snapshot_->entity_states) {
-        if (id == ignore_entity || !state.is_alive) {
-            continue;
-        }
-        
-        physics::RaycastHit temp_hit;
-        if (physics::RaycastBox(origin, direction, state.hitbox, temp_hit)) {
-            float distance = Vector3::Distance(origin, temp_hit.point);
-            if (distance < closest_distance) {
-                closest_distance = distance;
-                hit = temp_hit;
-                hit.entity_id = id;
-                hit_something = true;
-            }
-        }
-    }
-    
-    return hit_something;
+    hit.point = ray_hit->point;
+    hit.entity_id = ray_hit->entity_id;
+    return true;
 }
 
 // [SEQUENCE: 3770] Hit registration implementation
@@ -428,6 +282,50 @@ HitValidation HitRegistration::ProcessHitRequest(const HitRequest& request) {
         server_time);
 }
 
+void HitRegistration::QueueHitRequest(const HitRequest& request, uint64_t victim_id) {
+    if (!pipeline_) {
+        HitValidationConfig config;
+        config.worker_count = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        pipeline_ = std::make_unique<HitValidationPipeline>(LagCompensation::Instance().GetHistory(), config);
+    }
+    
+    float latency = LagCompensation::Instance().GetPlayerLatency(request.attacker_id);
+    HitClaim claim;
+    claim.claim_id = request.request_id;
+    claim.attacker_id = request.attacker_id;
+    claim.victim_id = victim_id;
+    claim.origin = request.shot_origin;
+    claim.direction = request.shot_direction;
+    claim.max_range = 100.0f;  // Max range from weapon
+    claim.rewind_time = LagCompensationUtils::ClientToServerTime(request.timestamp, latency);
+    queued_latency_[request.request_id] = latency;
+    pipeline_->Submit(claim);
+}
+
+std::vector<HitValidation> HitRegistration::ValidateQueuedHits() {
+    std::vector<HitValidation> results;
+    if (!pipeline_) {
+        return results;
+    }
+    
+    pipeline_->ValidatePending(verdicts_);
+    results.reserve(verdicts_.size());
+    for (const auto& verdict : verdicts_) {
+        HitValidation result;
+        result.is_valid = verdict.valid;
+        result.victim_id = verdict.victim_id;
+        result.impact_point = verdict.point;
+        if (verdict.valid) {
+            result.confidence = std::clamp(1.0f - queued_latency_[verdict.claim_id] / 1000.0f, 0.0f, 1.0f);
+        } else {
+            result.rejection_reason = ToString(verdict.rejection);
+        }
+        results.push_back(std::move(result));
+    }
+    queued_latency_.clear();
+    return results;
+}
+
 HitValidation HitRegistration::ValidateMeleeHit(
     uint64_t attacker_id,
     uint64_t victim_id,
@@ -460,7 +358,7 @@ HitValidation HitRegistration::ValidateMeleeHit(
     }
     
     // Check if victim was alive
-    if (!victim_state->is_alive) {
+    if (!victim_state->alive) {
         result.rejection_reason = "Victim was dead";
         return result;
     }
@@ -676,82 +574,44 @@ float CalculateSpreadAtDistance(
 } // namespace LagCompensationUtils
 
 // [SEQUENCE: 3774] Rollback networking implementation
-void RollbackNetworking::AdvanceFrame() {
-    current_frame_++;
-    
-    // Create state for this frame
-    RollbackState state;
-    state.frame = current_frame_;
-    state.snapshot = CreateCurrentSnapshot();
-    
-    // Collect inputs for this frame
-    for (auto& [player_id, buffer] : input_buffers_) {
-        if (!buffer.empty() && buffer.front().tick == current_frame_) {
-            state.inputs[player_id] = buffer.front();
-            buffer.pop_front();
-        } else {
-            // Predict input if missing
-            state.inputs[player_id] = PredictInput(player_id, current_frame_);
-        }
+RollbackNetworking::RollbackNetworking(const std::vector<uint64_t>& player_ids, const RollbackConfig& config)
+    : player_ids_(player_ids)
+    , session_(player_ids.size(),
+               [this](uint32_t, const TickInput* inputs, size_t) { SimulateFrame(inputs); },
+               config) {
+    for (size_t slot = 0; slot < player_ids_.size(); ++slot) {
+        player_slots_[player_ids_[slot]] = slot;
     }
-    
-    // Store state
-    state_history_.push_back(state);
-    
-    // Limit history size
-    while (state_history_.size() > MAX_ROLLBACK_FRAMES) {
-        state_history_.pop_front();
-    }
-    
-    // Simulate frame
-    SimulateFrame(current_frame_);
 }
 
-void RollbackNetworking::Rollback(uint32_t to_frame) {
-    if (to_frame >= current_frame_) {
-        return;  // Can't rollback to future
-    }
+void RollbackNetworking::AdvanceFrame() {
+    session_.AdvanceFrame();
     
-    // Find state to rollback to
-    for (const auto& state : state_history_) {
-        if (state.frame == to_frame) {
-            // Restore world state
-            RestoreWorldState(state.snapshot);
-            confirmed_frame_ = to_frame;
-            break;
-        }
-    }
-}
-
-void RollbackNetworking::Resimulate(uint32_t from_frame, uint32_t to_frame) {
-    for (uint32_t frame = from_frame + 1; frame <= to_frame; ++frame) {
-        // Find inputs for this frame
-        for (const auto& state : state_history_) {
-            if (state.frame == frame) {
-                ApplyInputs(state.inputs);
-                SimulateFrame(frame);
-                break;
-            }
-        }
+    const auto& stats = session_.GetStats();
+    if (stats.last_advance_us > 1000.0) {
+        spdlog::warn("[Rollback] Frame {} took {:.0f} us ({} frames resimulated so far)",
+                     session_.GetCurrentFrame() - 1, stats.last_advance_us, stats.frames_resimulated);
     }
 }
 
-PlayerInput RollbackNetworking::PredictInput(uint64_t player_id, uint32_t frame) {
-    // Simple prediction: use last known input
-    auto it = input_buffers_.find(player_id);
-    if (it != input_buffers_.end() && !it->second.empty()) {
-        PlayerInput predicted = it->second.back();
-        predicted.tick = frame;
-        return predicted;
+RollbackSession::InputResult RollbackNetworking::ReceiveInput(uint64_t player_id, const PlayerInput& input,
+                                                              uint32_t frame) {
+    auto it = player_slots_.find(player_id);
+    if (it == player_slots_.end()) {
+        return RollbackSession::InputResult::TooFarAhead;
     }
     
-    // Return empty input
-    PlayerInput empty;
-    empty.tick = frame;
-    return empty;
+    auto result = session_.AddInput(it->second, frame, PredictionUtils::ToTickInput(input));
+    if (result == RollbackSession::InputResult::BeyondBudget) {
+        spdlog::debug("[Rollback] Input for frame {} from player {} is past the rollback budget",
+                      frame, player_id);
+    }
+    return result;
 }
 
-void RollbackNetworking::SimulateFrame(uint32_t frame) {
+void RollbackNetworking::SimulateFrame(const TickInput* inputs) {
+    ApplyInputs(inputs);
+    
     // Apply physics simulation
     physics::PhysicsWorld::Instance().Step(1.0f / 60.0f);
     
@@ -10,6 +10,9 @@
 #include "../player/player.h"
 #include "../combat/combat.h"
 #include "client_prediction.h"
+#include "rewind_history.h"
+#include "hit_validation_pipeline.h"
+#include "rollback_session.h"
 
 namespace mmorpg::network {
 
@@ -59,14 +62,11 @@ public:
     // [SEQUENCE: 3749] Snapshot management
     void RecordSnapshot();
     void SetSnapshotInterval(std::chrono::milliseconds interval);
+    void OnEntityRemoved(uint64_t entity_id);
     
     // Time rewind
-    std::optional<WorldSnapshot> GetSnapshotAtTime(
-        std::chrono::steady_clock::time_point target_time);
-    WorldSnapshot InterpolateSnapshots(
-        const WorldSnapshot& before,
-        const WorldSnapshot& after,
-        std::chrono::steady_clock::time_point target_time);
+    // [SEQUENCE: MVP19-210] Rewound state is read straight from the columnar ring; nothing is copied per query.
+    const RewindHistory& GetHistory() const { return *history_; }
     
     // [SEQUENCE: 3750] Hit validation
     HitValidation ValidateHit(
@@ -116,9 +116,8 @@ private:
     friend class Singleton<LagCompensation>;
     LagCompensation();
     
-    // Snapshot storage
-    std::deque<WorldSnapshot> snapshots_;
-    static constexpr size_t MAX_SNAPSHOTS = 300;  // 5 seconds at 60 Hz
+    // Snapshot storage, sized for max_rewind_time_ at snapshot_interval_
+    std::unique_ptr<RewindHistory> history_;
     std::chrono::milliseconds snapshot_interval_{16};  // ~60 Hz
     std::chrono::steady_clock::time_point last_snapshot_time_;
     
@@ -135,7 +134,7 @@ private:
     mutable std::shared_mutex mutex_;
     
     // Helper methods
-    void CleanupOldSnapshots();
+    void ResizeHistory();
     bool IsTimeValid(std::chrono::steady_clock::time_point time) const;
     float CalculateHitProbability(const Vector3& origin,
                                  const Vector3& target,
@@ -150,7 +149,7 @@ public:
     ~RewindContext();
     
     // Get rewound entity state
-    std::optional<WorldSnapshot::EntityState> GetEntityState(uint64_t entity_id) const;
+    std::optional<RewoundEntity> GetEntityState(uint64_t entity_id) const;
     
     // Perform operations in rewound time
     bool PerformRaycast(const Vector3& origin,
@@ -164,7 +163,7 @@ public:
                        std::vector<uint64_t>& colliding_entities);
     
 private:
-    std::optional<WorldSnapshot> snapshot_;
+    const RewindHistory& history_;
     std::chrono::steady_clock::time_point target_time_;
 };
 
@@ -185,6 +184,11 @@ public:
     // Process hit request with lag compensation
     HitValidation ProcessHitRequest(const HitRequest& request);
     
+    // [SEQUENCE: MVP19-228] Batched path: requests queued during a tick are validated together at its end,
+    // grouped by rewind time and spread over the pipeline's workers. Results follow queue order.
+    void QueueHitRequest(const HitRequest& request, uint64_t victim_id = 0);
+    std::vector<HitValidation> ValidateQueuedHits();
+    
     // Validate melee hit
     HitValidation ValidateMeleeHit(
         uint64_t attacker_id,
@@ -210,6 +214,10 @@ private:
                         const Vector3& to,
                         float max_distance,
                         float tolerance = 0.1f);
+    
+    std::unique_ptr<HitValidationPipeline> pipeline_;
+    std::vector<HitVerdict> verdicts_;
+    std::unordered_map<uint64_t, float> queued_latency_;   // Request id -> attacker latency, for confidence
 };
 
 // [SEQUENCE: 3755] Interpolation utilities
@@ -310,49 +318,30 @@ private:
 };
 
 // [SEQUENCE: 3759] Rollback networking
+// [SEQUENCE: MVP19-259] Arena-scoped: the match registers its state columns on GetSession() before the first
+// frame. AdvanceFrame rolls back and resimulates through the same SimulateFrame when a late input changed the past.
 class RollbackNetworking {
 public:
-    // [SEQUENCE: 3760] Rollback state
-    struct RollbackState {
-        uint32_t frame;
-        std::unordered_map<uint64_t, PlayerInput> inputs;
-        WorldSnapshot snapshot;
-        std::vector<combat::CombatEvent> events;
-    };
+    explicit RollbackNetworking(const std::vector<uint64_t>& player_ids, const RollbackConfig& config = {});
     
     // Frame management
     void AdvanceFrame();
-    uint32_t GetCurrentFrame() const { return current_frame_; }
+    uint32_t GetCurrentFrame() const { return session_.GetCurrentFrame(); }
     
     // Input handling
-    void ReceiveInput(uint64_t player_id, const PlayerInput& input, uint32_t frame);
-    void ConfirmInput(uint64_t player_id, uint32_t frame);
-    
-    // Rollback and resimulation
-    void Rollback(uint32_t to_frame);
-    void Resimulate(uint32_t from_frame, uint32_t to_frame);
+    RollbackSession::InputResult ReceiveInput(uint64_t player_id, const PlayerInput& input, uint32_t frame);
     
-    // State synchronization
-    void BroadcastConfirmedState(uint32_t frame);
-    void ReceiveConfirmedState(const RollbackState& state);
-    
-    // Prediction
-    PlayerInput PredictInput(uint64_t player_id, uint32_t frame);
+    RollbackSession& GetSession() { return session_; }
+    const RollbackSession::Stats& GetStats() const { return session_.GetStats(); }
     
 private:
-    uint32_t current_frame_{0};
-    uint32_t confirmed_frame_{0};
-    
-    // State history
-    std::deque<RollbackState> state_history_;
-    static constexpr size_t MAX_ROLLBACK_FRAMES = 8;  // ~133ms at 60fps
-    
-    // Input buffers
-    std::unordered_map<uint64_t, std::deque<PlayerInput>> input_buffers_;
+    std::vector<uint64_t> player_ids_;
+    std::unordered_map<uint64_t, size_t> player_slots_;
+    RollbackSession session_;
     
     // Simulation
-    void SimulateFrame(uint32_t frame);
-    void ApplyInputs(const std::unordered_map<uint64_t, PlayerInput>& inputs);
+    void SimulateFrame(const TickInput* inputs);
+    void ApplyInputs(const TickInput* inputs);
 };
 
 // [SEQUENCE: 3761] Lag compensation utilities
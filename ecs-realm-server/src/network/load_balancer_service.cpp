@@ -0,0 +1,264 @@
+#include "network/load_balancer_service.h"
+
+#include "core/logger.h"
+#include "network/cluster_framing.h"
+#include "network/global_load_balancer.h"
+#include "network/packet_serializer.h"
+
+namespace mmorpg::network {
+
+LoadBalancerService::LoadBalancerService(boost::asio::io_context& io_context, GlobalLoadBalancer& balancer)
+    : m_balancer(balancer), m_socket(boost::asio::make_strand(io_context)) {}
+
+bool LoadBalancerService::Start(const boost::asio::ip::udp::endpoint& endpoint) {
+    boost::system::error_code ec;
+    m_socket.open(endpoint.protocol(), ec);
+    if (!ec) m_socket.bind(endpoint, ec);
+    if (ec) {
+        LOG_ERROR("[LoadBalancer] Failed to bind {}:{}: {}", endpoint.address().to_string(), endpoint.port(),
+                  ec.message());
+        return false;
+    }
+    DoReceive();
+    return true;
+}
+
+void LoadBalancerService::Stop() {
+    boost::asio::post(m_socket.get_executor(), [self = shared_from_this()] {
+        boost::system::error_code ignored;
+        self->m_socket.close(ignored);
+    });
+}
+
+boost::asio::ip::udp::endpoint LoadBalancerService::GetLocalEndpoint() const {
+    boost::system::error_code ec;
+    return m_socket.local_endpoint(ec);
+}
+
+LoadBalancerService::Stats LoadBalancerService::GetStats() const {
+    Stats stats;
+    stats.reports = m_statReports.load(std::memory_order_relaxed);
+    stats.route_requests = m_statRouteRequests.load(std::memory_order_relaxed);
+    stats.handoff_requests = m_statHandoffRequests.load(std::memory_order_relaxed);
+    stats.malformed = m_statMalformed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void LoadBalancerService::DoReceive() {
+    m_socket.async_receive_from(
+        boost::asio::buffer(m_receiveBuffer), m_sender,
+        [self = shared_from_this()](const boost::system::error_code& ec, size_t size) {
+            if (ec == boost::asio::error::operation_aborted || !self->m_socket.is_open()) return;
+            if (!ec) self->HandleDatagram(size);
+            self->DoReceive();
+        });
+}
+
+void LoadBalancerService::HandleDatagram(size_t size) {
+    const std::byte* data = m_receiveBuffer.data();
+    if (size <= 4 || cluster_framing::FrameBodySize(data) != size - 4) {
+        m_statMalformed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    PacketSerializer::PacketEnvelope envelope;
+    if (!PacketSerializer::ParseEnvelope(data + 4, size - 4, envelope)) {
+        m_statMalformed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (envelope.type == mmorpg::proto::PACKET_NODE_LOAD_REPORT) {
+        mmorpg::proto::NodeLoadReport report;
+        if (!report.ParseFromArray(envelope.payload, static_cast<int>(envelope.payload_size)) ||
+            report.node_id().empty()) {
+            m_statMalformed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_statReports.fetch_add(1, std::memory_order_relaxed);
+        m_balancer.UpdateNodeLoad(report);
+        return;
+    }
+
+    if (envelope.type == mmorpg::proto::PACKET_ROUTE_REQUEST) {
+        mmorpg::proto::RouteRequest request;
+        if (!request.ParseFromArray(envelope.payload, static_cast<int>(envelope.payload_size))) {
+            m_statMalformed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        GlobalLoadBalancer::RoutingResult result;
+        if (request.exclude_node().empty()) {
+            m_statRouteRequests.fetch_add(1, std::memory_order_relaxed);
+            result = m_balancer.RouteClient(request.client_id(), request.preferred_region());
+        } else {
+            m_statHandoffRequests.fetch_add(1, std::memory_order_relaxed);
+            result = m_balancer.SelectHandoffTarget(request.exclude_node());
+        }
+        mmorpg::proto::RouteResponse response;
+        response.set_request_id(request.request_id());
+        response.set_success(result.success);
+        response.set_node_id(result.selected_server_id);
+        response.set_host(result.server_hostname);
+        response.set_port(result.server_port);
+        response.set_handoff_port(result.handoff_port);
+        response.set_reason(result.routing_reason);
+        Reply(response);
+        return;
+    }
+
+    m_statMalformed.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LoadBalancerService::Reply(const google::protobuf::Message& message) {
+    if (!PacketSerializer::SerializeInto(message, m_sendBuffer)) return;
+    // Responses are tiny; a full socket buffer just drops one, which the requester retries
+    boost::system::error_code ignored;
+    m_socket.send_to(boost::asio::buffer(m_sendBuffer), m_sender, 0, ignored);
+}
+
+NodeLoadReporter::NodeLoadReporter(boost::asio::io_context& io_context, Config config,
+                                   boost::asio::ip::udp::endpoint balancer, Sampler sampler)
+    : m_config(std::move(config)),
+      m_balancer(std::move(balancer)),
+      m_sampler(std::move(sampler)),
+      m_strand(boost::asio::make_strand(io_context)),
+      m_socket(m_strand),
+      m_reportTimer(m_strand) {}
+
+bool NodeLoadReporter::Start() {
+    boost::system::error_code ec;
+    m_socket.open(m_balancer.protocol(), ec);
+    if (!ec) m_socket.connect(m_balancer, ec);
+    if (ec) {
+        LOG_ERROR("[NodeLoadReporter] Node {} failed to open its socket: {}", m_config.node_id, ec.message());
+        return false;
+    }
+    boost::asio::post(m_strand, [self = shared_from_this()] {
+        self->DoReceive();
+        self->SendReport();
+        self->ScheduleReport();
+    });
+    return true;
+}
+
+void NodeLoadReporter::Stop() {
+    boost::asio::post(m_strand, [self = shared_from_this()] {
+        self->m_stopped = true;
+        self->m_reportTimer.cancel();
+        boost::system::error_code ignored;
+        self->m_socket.close(ignored);
+        auto pending = std::move(self->m_pending);
+        self->m_pending.clear();
+        for (auto& [id, request] : pending) {
+            request.timeout->cancel();
+            mmorpg::proto::RouteResponse response;
+            response.set_request_id(id);
+            response.set_reason("stopped");
+            request.done(response);
+        }
+    });
+}
+
+void NodeLoadReporter::ReportNow() {
+    boost::asio::post(m_strand, [self = shared_from_this()] {
+        if (!self->m_stopped) self->SendReport();
+    });
+}
+
+void NodeLoadReporter::RequestHandoffTarget(RouteCallback done) {
+    boost::asio::post(m_strand, [self = shared_from_this(), done = std::move(done)]() mutable {
+        const uint64_t id = self->m_nextRequestId++;
+        mmorpg::proto::RouteResponse failure;
+        failure.set_request_id(id);
+        if (self->m_stopped) {
+            failure.set_reason("stopped");
+            done(failure);
+            return;
+        }
+        auto timer = std::make_unique<boost::asio::steady_timer>(self->m_strand, self->m_config.request_timeout);
+        timer->async_wait([self, id](const boost::system::error_code& ec) {
+            if (ec) return;
+            auto it = self->m_pending.find(id);
+            if (it == self->m_pending.end()) return;
+            RouteCallback callback = std::move(it->second.done);
+            self->m_pending.erase(it);
+            mmorpg::proto::RouteResponse timeout;
+            timeout.set_request_id(id);
+            timeout.set_reason("timeout");
+            callback(timeout);
+        });
+        self->m_pending.emplace(id, PendingRequest{std::move(done), std::move(timer)});
+
+        mmorpg::proto::RouteRequest request;
+        request.set_request_id(id);
+        request.set_exclude_node(self->m_config.node_id);
+        request.set_preferred_region(self->m_config.region);
+        self->Send(request);
+    });
+}
+
+void NodeLoadReporter::ScheduleReport() {
+    m_reportTimer.expires_after(m_config.interval);
+    m_reportTimer.async_wait([self = shared_from_this()](const boost::system::error_code& ec) {
+        if (ec || self->m_stopped) return;
+        self->SendReport();
+        self->ScheduleReport();
+    });
+}
+
+// [SEQUENCE: MVP19-311] Egress is the byte counter's growth since the previous report, so the rate covers the
+// whole interval rather than the instant of sampling
+void NodeLoadReporter::SendReport() {
+    const NodeLoadSample sample = m_sampler();
+    const auto now = std::chrono::steady_clock::now();
+    double egress_rate = 0.0;
+    if (m_lastSample != std::chrono::steady_clock::time_point{} && sample.egress_bytes_total >= m_lastEgressBytes) {
+        const double seconds = std::chrono::duration<double>(now - m_lastSample).count();
+        if (seconds > 0.0) egress_rate = static_cast<double>(sample.egress_bytes_total - m_lastEgressBytes) / seconds;
+    }
+    m_lastEgressBytes = sample.egress_bytes_total;
+    m_lastSample = now;
+
+    mmorpg::proto::NodeLoadReport report;
+    report.set_node_id(m_config.node_id);
+    report.set_region(m_config.region);
+    report.set_host(m_config.host);
+    report.set_game_port(m_config.game_port);
+    report.set_handoff_port(m_config.handoff_port);
+    report.set_sequence(++m_sequence);
+    report.set_tick_ms(sample.tick_ms);
+    report.set_tick_budget_ms(m_config.tick_budget_ms);
+    report.set_sessions(sample.sessions);
+    report.set_max_sessions(m_config.max_sessions);
+    report.set_egress_bytes_per_second(egress_rate);
+    report.set_egress_capacity_bytes_per_second(m_config.egress_capacity_bytes_per_second);
+    report.set_draining(sample.draining);
+    Send(report);
+}
+
+void NodeLoadReporter::DoReceive() {
+    m_socket.async_receive(boost::asio::buffer(m_receiveBuffer),
+                           [self = shared_from_this()](const boost::system::error_code& ec, size_t size) {
+                               if (ec == boost::asio::error::operation_aborted || self->m_stopped) return;
+                               // Connection refused (no balancer yet) surfaces here; keep listening
+                               if (!ec) self->HandleResponse(size);
+                               self->DoReceive();
+                           });
+}
+
+void NodeLoadReporter::HandleResponse(size_t size) {
+    mmorpg::proto::RouteResponse response;
+    if (!cluster_framing::ParseFrame(m_receiveBuffer.data(), size, response)) return;
+    auto it = m_pending.find(response.request_id());
+    if (it == m_pending.end()) return;
+    RouteCallback done = std::move(it->second.done);
+    it->second.timeout->cancel();
+    m_pending.erase(it);
+    done(response);
+}
+
+void NodeLoadReporter::Send(const google::protobuf::Message& message) {
+    if (!PacketSerializer::SerializeInto(message, m_sendBuffer)) return;
+    boost::system::error_code ignored;
+    m_socket.send(boost::asio::buffer(m_sendBuffer), 0, ignored);
+}
+
+} // namespace mmorpg::network
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "proto/cluster.pb.h"
+
+namespace mmorpg::network {
+
+class GlobalLoadBalancer;
+
+// [SEQUENCE: MVP19-308] The balancer's network face: one UDP socket that takes NodeLoadReports from game
+// servers and answers RouteRequests. A request with exclude_node set asks for a handoff target away from that
+// node; otherwise it places a new session. Datagrams are single frames, so a lost report is simply superseded
+// by the next one and a lost request is retried by its sender.
+class LoadBalancerService : public std::enable_shared_from_this<LoadBalancerService> {
+public:
+    struct Stats {
+        uint64_t reports = 0;
+        uint64_t route_requests = 0;
+        uint64_t handoff_requests = 0;
+        uint64_t malformed = 0;
+    };
+
+    LoadBalancerService(boost::asio::io_context& io_context, GlobalLoadBalancer& balancer);
+
+    // Binds and starts receiving. Port 0 picks a free port, see GetLocalEndpoint.
+    bool Start(const boost::asio::ip::udp::endpoint& endpoint);
+    void Stop();
+    boost::asio::ip::udp::endpoint GetLocalEndpoint() const;
+    Stats GetStats() const;
+
+private:
+    void DoReceive();
+    void HandleDatagram(size_t size);
+    void Reply(const google::protobuf::Message& message);
+
+    GlobalLoadBalancer& m_balancer;
+    boost::asio::ip::udp::socket m_socket;
+    boost::asio::ip::udp::endpoint m_sender;
+    std::array<std::byte, 2048> m_receiveBuffer{};
+    std::vector<std::byte> m_sendBuffer;
+
+    std::atomic<uint64_t> m_statReports{0};
+    std::atomic<uint64_t> m_statRouteRequests{0};
+    std::atomic<uint64_t> m_statHandoffRequests{0};
+    std::atomic<uint64_t> m_statMalformed{0};
+};
+
+// [SEQUENCE: MVP19-309] What a game server measures about itself for its load report
+struct NodeLoadSample {
+    double tick_ms = 0.0;              // Recent tick time, e.g. a moving average
+    uint32_t sessions = 0;
+    uint64_t egress_bytes_total = 0;   // Cumulative; the reporter turns it into a rate
+    bool draining = false;
+};
+
+// [SEQUENCE: MVP19-310] Game server side of the balancer protocol: sends a NodeLoadReport every interval and
+// asks the balancer for handoff targets. Runs on the given io_context under its own strand.
+class NodeLoadReporter : public std::enable_shared_from_this<NodeLoadReporter> {
+public:
+    struct Config {
+        std::string node_id;
+        std::string region = "local";
+        std::string host = "127.0.0.1";   // Advertised to clients
+        uint16_t game_port = 0;
+        uint16_t handoff_port = 0;
+        double tick_budget_ms = 16.0;
+        uint32_t max_sessions = 5000;
+        double egress_capacity_bytes_per_second = 0.0;   // 0: not reported as a constraint
+        std::chrono::milliseconds interval{1000};
+        std::chrono::milliseconds request_timeout{1000};
+    };
+
+    using Sampler = std::function<NodeLoadSample()>;
+    // Receives the balancer's answer, or success = false with reason "timeout"
+    using RouteCallback = std::function<void(const mmorpg::proto::RouteResponse& response)>;
+
+    NodeLoadReporter(boost::asio::io_context& io_context, Config config,
+                     boost::asio::ip::udp::endpoint balancer, Sampler sampler);
+
+    bool Start();
+    void Stop();
+    // Sends a report now instead of at the next interval, e.g. right after starting to drain
+    void ReportNow();
+    // Asks for a node to hand one of this node's sessions to
+    void RequestHandoffTarget(RouteCallback done);
+
+private:
+    void ScheduleReport();
+    void SendReport();
+    void DoReceive();
+    void HandleResponse(size_t size);
+    void Send(const google::protobuf::Message& message);
+
+    const Config m_config;
+    const boost::asio::ip::udp::endpoint m_balancer;
+    const Sampler m_sampler;
+    boost::asio::strand<boost::asio::io_context::executor_type> m_strand;
+    boost::asio::ip::udp::socket m_socket;
+    boost::asio::steady_timer m_reportTimer;
+    std::array<std::byte, 2048> m_receiveBuffer{};
+    std::vector<std::byte> m_sendBuffer;
+
+    // Strand-only state
+    uint64_t m_sequence = 0;
+    uint64_t m_lastEgressBytes = 0;
+    std::chrono::steady_clock::time_point m_lastSample{};
+    uint64_t m_nextRequestId = 1;
+    struct PendingRequest {
+        RouteCallback done;
+        std::unique_ptr<boost::asio::steady_timer> timeout;
+    };
+    std::unordered_map<uint64_t, PendingRequest> m_pending;
+    bool m_stopped = false;
+};
+
+} // namespace mmorpg::network
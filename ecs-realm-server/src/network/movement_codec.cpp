@@ -0,0 +1,356 @@
+#include "network/movement_codec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mmorpg::network {
+
+namespace {
+
+constexpr float kTwoPi = 6.28318530717958647692f;
+constexpr float kYawScale = 256.0f / kTwoPi;
+constexpr float kOffsetScale = 65535.0f;
+constexpr float kVelocityScale = 1.0f / MovementCodec::kVelocityResolution;
+constexpr float kVelocityLimit = 32767.0f;
+
+constexpr uint8_t kFlagCellChanged = 1u << 0;
+constexpr uint8_t kFlagMoving = 1u << 1;
+
+// Minimum record: one-byte id gap, one-byte sequence, flags, offsets/height, yaw.
+constexpr size_t kMinRecordSize = 1 + 1 + 1 + 6 + 1;
+
+uint64_t ZigZag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value) {
+    return static_cast<int64_t>((value >> 1) ^ (0 - (value & 1)));
+}
+
+uint8_t* WriteVarint(uint8_t* out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    return out;
+}
+
+bool ReadVarint(const uint8_t*& in, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && in < end; shift += 7) {
+        const uint8_t byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t* WriteU16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    return out + 2;
+}
+
+uint16_t ReadU16(const uint8_t* in) {
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+int32_t RoundToInt(float value) {
+    return static_cast<int32_t>(std::nearbyint(value));
+}
+
+#if defined(__SSE2__)
+// SSE2 has no floor instruction: truncate, then step down where truncation rounded up (negative inputs).
+__m128i FloorToInt(__m128 value) {
+    const __m128i truncated = _mm_cvttps_epi32(value);
+    const __m128 rounded_up = _mm_cmpgt_ps(_mm_cvtepi32_ps(truncated), value);
+    return _mm_add_epi32(truncated, _mm_castps_si128(rounded_up));
+}
+
+// Four int32 lanes in [0, 65535] to uint16. SSE2 only packs with signed saturation, so bias into int16 range.
+void StoreU16x4(uint16_t* out, __m128i value) {
+    __m128i packed = _mm_packs_epi32(_mm_sub_epi32(value, _mm_set1_epi32(32768)), _mm_setzero_si128());
+    packed = _mm_xor_si128(packed, _mm_set1_epi16(static_cast<short>(0x8000)));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+}
+
+void StoreI16x4(int16_t* out, __m128i value) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packs_epi32(value, _mm_setzero_si128()));
+}
+
+void StoreU8x4(uint8_t* out, __m128i value) {
+    const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(value, _mm_setzero_si128()), _mm_setzero_si128());
+    const int packed = _mm_cvtsi128_si32(bytes);
+    std::memcpy(out, &packed, 4);
+}
+
+__m128i LoadU16x4(const uint16_t* in) {
+    return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in)), _mm_setzero_si128());
+}
+
+__m128i LoadI16x4(const int16_t* in) {
+    const __m128i raw = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in));
+    return _mm_srai_epi32(_mm_unpacklo_epi16(raw, raw), 16);
+}
+
+__m128i LoadU8x4(const uint8_t* in) {
+    int packed;
+    std::memcpy(&packed, in, 4);
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+}
+
+__m128 Clamp(__m128 value, float low, float high) {
+    return _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(low)), _mm_set1_ps(high));
+}
+#endif
+
+} // namespace
+
+void MovementBatch::Resize(size_t count) {
+    entity_ids.resize(count);
+    sequences.resize(count);
+    for (auto* column : {&x, &y, &z, &yaw, &vx, &vy, &vz}) {
+        column->resize(count);
+    }
+}
+
+MovementCodec::MovementCodec(const MovementCodecConfig& config)
+    : m_config(config),
+      m_inverseCellSize(1.0f / config.cell_size),
+      m_heightScale(kOffsetScale / (config.max_height - config.min_height)),
+      m_inverseHeightScale((config.max_height - config.min_height) / kOffsetScale) {}
+
+void MovementCodec::ResizeColumns(size_t count) {
+    m_cellX.resize(count);
+    m_cellY.resize(count);
+    m_offsetX.resize(count);
+    m_offsetY.resize(count);
+    m_height.resize(count);
+    m_yaw.resize(count);
+    m_velX.resize(count);
+    m_velY.resize(count);
+    m_velZ.resize(count);
+}
+
+// [SEQUENCE: MVP19-176] The scalar forms are the reference semantics; the SSE2 passes compute the same thing
+// four entities at a time and the scalar form handles the tail.
+void MovementCodec::QuantizeOne(const MovementBatch& batch, size_t i) {
+    const float cell_x = (batch.x[i] - m_config.world_min_x) * m_inverseCellSize;
+    const float cell_y = (batch.y[i] - m_config.world_min_y) * m_inverseCellSize;
+    m_cellX[i] = static_cast<int32_t>(std::floor(cell_x));
+    m_cellY[i] = static_cast<int32_t>(std::floor(cell_y));
+    m_offsetX[i] = static_cast<uint16_t>(RoundToInt(std::clamp((cell_x - m_cellX[i]) * kOffsetScale, 0.0f, kOffsetScale)));
+    m_offsetY[i] = static_cast<uint16_t>(RoundToInt(std::clamp((cell_y - m_cellY[i]) * kOffsetScale, 0.0f, kOffsetScale)));
+    m_height[i] = static_cast<uint16_t>(RoundToInt(
+        std::clamp((batch.z[i] - m_config.min_height) * m_heightScale, 0.0f, kOffsetScale)));
+    m_yaw[i] = static_cast<uint8_t>(RoundToInt(batch.yaw[i] * kYawScale) & 0xFF);
+    m_velX[i] = static_cast<int16_t>(RoundToInt(std::clamp(batch.vx[i] * kVelocityScale, -kVelocityLimit, kVelocityLimit)));
+    m_velY[i] = static_cast<int16_t>(RoundToInt(std::clamp(batch.vy[i] * kVelocityScale, -kVelocityLimit, kVelocityLimit)));
+    m_velZ[i] = static_cast<int16_t>(RoundToInt(std::clamp(batch.vz[i] * kVelocityScale, -kVelocityLimit, kVelocityLimit)));
+}
+
+void MovementCodec::Quantize(const MovementBatch& batch) {
+    const size_t count = batch.Size();
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 min_x = _mm_set1_ps(m_config.world_min_x);
+    const __m128 min_y = _mm_set1_ps(m_config.world_min_y);
+    const __m128 min_height = _mm_set1_ps(m_config.min_height);
+    const __m128 inverse_cell = _mm_set1_ps(m_inverseCellSize);
+    const __m128 offset_scale = _mm_set1_ps(kOffsetScale);
+    const __m128 height_scale = _mm_set1_ps(m_heightScale);
+    const __m128 yaw_scale = _mm_set1_ps(kYawScale);
+    const __m128 velocity_scale = _mm_set1_ps(kVelocityScale);
+    const __m128i byte_mask = _mm_set1_epi32(0xFF);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 cell_x = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&batch.x[i]), min_x), inverse_cell);
+        const __m128 cell_y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&batch.y[i]), min_y), inverse_cell);
+        const __m128i floor_x = FloorToInt(cell_x);
+        const __m128i floor_y = FloorToInt(cell_y);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_cellX[i]), floor_x);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_cellY[i]), floor_y);
+
+        const __m128 offset_x = _mm_mul_ps(_mm_sub_ps(cell_x, _mm_cvtepi32_ps(floor_x)), offset_scale);
+        const __m128 offset_y = _mm_mul_ps(_mm_sub_ps(cell_y, _mm_cvtepi32_ps(floor_y)), offset_scale);
+        StoreU16x4(&m_offsetX[i], _mm_cvtps_epi32(Clamp(offset_x, 0.0f, kOffsetScale)));
+        StoreU16x4(&m_offsetY[i], _mm_cvtps_epi32(Clamp(offset_y, 0.0f, kOffsetScale)));
+
+        const __m128 height = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&batch.z[i]), min_height), height_scale);
+        StoreU16x4(&m_height[i], _mm_cvtps_epi32(Clamp(height, 0.0f, kOffsetScale)));
+
+        const __m128i yaw = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&batch.yaw[i]), yaw_scale));
+        StoreU8x4(&m_yaw[i], _mm_and_si128(yaw, byte_mask));
+
+        StoreI16x4(&m_velX[i], _mm_cvtps_epi32(Clamp(_mm_mul_ps(_mm_loadu_ps(&batch.vx[i]), velocity_scale),
+                                                     -kVelocityLimit, kVelocityLimit)));
+        StoreI16x4(&m_velY[i], _mm_cvtps_epi32(Clamp(_mm_mul_ps(_mm_loadu_ps(&batch.vy[i]), velocity_scale),
+                                                     -kVelocityLimit, kVelocityLimit)));
+        StoreI16x4(&m_velZ[i], _mm_cvtps_epi32(Clamp(_mm_mul_ps(_mm_loadu_ps(&batch.vz[i]), velocity_scale),
+                                                     -kVelocityLimit, kVelocityLimit)));
+    }
+#endif
+    for (; i < count; ++i) {
+        QuantizeOne(batch, i);
+    }
+}
+
+void MovementCodec::DequantizeOne(MovementBatch& batch, size_t i) const {
+    batch.x[i] = m_config.world_min_x +
+        (static_cast<float>(m_cellX[i]) + m_offsetX[i] * (1.0f / kOffsetScale)) * m_config.cell_size;
+    batch.y[i] = m_config.world_min_y +
+        (static_cast<float>(m_cellY[i]) + m_offsetY[i] * (1.0f / kOffsetScale)) * m_config.cell_size;
+    batch.z[i] = m_config.min_height + m_height[i] * m_inverseHeightScale;
+    batch.yaw[i] = m_yaw[i] * (1.0f / kYawScale);
+    batch.vx[i] = m_velX[i] * kVelocityResolution;
+    batch.vy[i] = m_velY[i] * kVelocityResolution;
+    batch.vz[i] = m_velZ[i] * kVelocityResolution;
+}
+
+void MovementCodec::Dequantize(MovementBatch& batch) const {
+    const size_t count = batch.Size();
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 min_x = _mm_set1_ps(m_config.world_min_x);
+    const __m128 min_y = _mm_set1_ps(m_config.world_min_y);
+    const __m128 min_height = _mm_set1_ps(m_config.min_height);
+    const __m128 cell_size = _mm_set1_ps(m_config.cell_size);
+    const __m128 inverse_offset = _mm_set1_ps(1.0f / kOffsetScale);
+    const __m128 inverse_height = _mm_set1_ps(m_inverseHeightScale);
+    const __m128 inverse_yaw = _mm_set1_ps(1.0f / kYawScale);
+    const __m128 velocity_resolution = _mm_set1_ps(kVelocityResolution);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 cell_x = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_cellX[i])));
+        const __m128 cell_y = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_cellY[i])));
+        const __m128 offset_x = _mm_mul_ps(_mm_cvtepi32_ps(LoadU16x4(&m_offsetX[i])), inverse_offset);
+        const __m128 offset_y = _mm_mul_ps(_mm_cvtepi32_ps(LoadU16x4(&m_offsetY[i])), inverse_offset);
+        _mm_storeu_ps(&batch.x[i], _mm_add_ps(min_x, _mm_mul_ps(_mm_add_ps(cell_x, offset_x), cell_size)));
+        _mm_storeu_ps(&batch.y[i], _mm_add_ps(min_y, _mm_mul_ps(_mm_add_ps(cell_y, offset_y), cell_size)));
+        _mm_storeu_ps(&batch.z[i],
+                      _mm_add_ps(min_height, _mm_mul_ps(_mm_cvtepi32_ps(LoadU16x4(&m_height[i])), inverse_height)));
+        _mm_storeu_ps(&batch.yaw[i], _mm_mul_ps(_mm_cvtepi32_ps(LoadU8x4(&m_yaw[i])), inverse_yaw));
+        _mm_storeu_ps(&batch.vx[i], _mm_mul_ps(_mm_cvtepi32_ps(LoadI16x4(&m_velX[i])), velocity_resolution));
+        _mm_storeu_ps(&batch.vy[i], _mm_mul_ps(_mm_cvtepi32_ps(LoadI16x4(&m_velY[i])), velocity_resolution));
+        _mm_storeu_ps(&batch.vz[i], _mm_mul_ps(_mm_cvtepi32_ps(LoadI16x4(&m_velZ[i])), velocity_resolution));
+    }
+#endif
+    for (; i < count; ++i) {
+        DequantizeOne(batch, i);
+    }
+}
+
+// [SEQUENCE: MVP19-177] The output is sized for the worst case once, then written through a raw pointer and
+// trimmed, so the per-entity loop has no capacity checks.
+void MovementCodec::Encode(const MovementBatch& batch, std::vector<std::byte>& out) {
+    const size_t count = batch.Size();
+    ResizeColumns(count);
+    Quantize(batch);
+
+    out.resize(20 + count * kMaxRecordSize);
+    uint8_t* const begin = reinterpret_cast<uint8_t*>(out.data());
+    uint8_t* p = begin;
+    const uint32_t base_sequence = count > 0 ? batch.sequences[0] : 0;
+    p = WriteVarint(p, count);
+    p = WriteVarint(p, base_sequence);
+
+    uint64_t previous_id = 0;
+    int32_t previous_cell_x = 0;
+    int32_t previous_cell_y = 0;
+    for (size_t i = 0; i < count; ++i) {
+        p = WriteVarint(p, ZigZag(static_cast<int64_t>(batch.entity_ids[i] - previous_id)));
+        p = WriteVarint(p, ZigZag(static_cast<int32_t>(batch.sequences[i] - base_sequence)));
+        previous_id = batch.entity_ids[i];
+
+        const bool cell_changed = m_cellX[i] != previous_cell_x || m_cellY[i] != previous_cell_y;
+        const bool moving = (m_velX[i] | m_velY[i] | m_velZ[i]) != 0;
+        *p++ = static_cast<uint8_t>((cell_changed ? kFlagCellChanged : 0) | (moving ? kFlagMoving : 0));
+        if (cell_changed) {
+            p = WriteVarint(p, ZigZag(static_cast<int64_t>(m_cellX[i]) - previous_cell_x));
+            p = WriteVarint(p, ZigZag(static_cast<int64_t>(m_cellY[i]) - previous_cell_y));
+            previous_cell_x = m_cellX[i];
+            previous_cell_y = m_cellY[i];
+        }
+        p = WriteU16(p, m_offsetX[i]);
+        p = WriteU16(p, m_offsetY[i]);
+        p = WriteU16(p, m_height[i]);
+        *p++ = m_yaw[i];
+        if (moving) {
+            p = WriteU16(p, static_cast<uint16_t>(m_velX[i]));
+            p = WriteU16(p, static_cast<uint16_t>(m_velY[i]));
+            p = WriteU16(p, static_cast<uint16_t>(m_velZ[i]));
+        }
+    }
+    out.resize(static_cast<size_t>(p - begin));
+}
+
+bool MovementCodec::Decode(const std::byte* data, size_t size, MovementBatch& out) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+    const uint8_t* const end = p + size;
+    uint64_t count = 0;
+    uint64_t base_sequence = 0;
+    if (!ReadVarint(p, end, count) || !ReadVarint(p, end, base_sequence) ||
+        count > static_cast<uint64_t>(end - p) / kMinRecordSize) {
+        return false;
+    }
+
+    out.Resize(count);
+    ResizeColumns(count);
+    uint64_t id = 0;
+    int64_t cell_x = 0;
+    int64_t cell_y = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t id_gap = 0;
+        uint64_t sequence_delta = 0;
+        if (!ReadVarint(p, end, id_gap) || !ReadVarint(p, end, sequence_delta) || p == end) {
+            return false;
+        }
+        id += static_cast<uint64_t>(UnZigZag(id_gap));
+        out.entity_ids[i] = id;
+        out.sequences[i] = static_cast<uint32_t>(base_sequence + static_cast<uint64_t>(UnZigZag(sequence_delta)));
+
+        const uint8_t flags = *p++;
+        if (flags & kFlagCellChanged) {
+            uint64_t delta_x = 0;
+            uint64_t delta_y = 0;
+            if (!ReadVarint(p, end, delta_x) || !ReadVarint(p, end, delta_y)) {
+                return false;
+            }
+            cell_x += UnZigZag(delta_x);
+            cell_y += UnZigZag(delta_y);
+        }
+        const size_t fixed_size = 7 + ((flags & kFlagMoving) ? 6 : 0);
+        if (static_cast<size_t>(end - p) < fixed_size) {
+            return false;
+        }
+        m_cellX[i] = static_cast<int32_t>(cell_x);
+        m_cellY[i] = static_cast<int32_t>(cell_y);
+        m_offsetX[i] = ReadU16(p);
+        m_offsetY[i] = ReadU16(p + 2);
+        m_height[i] = ReadU16(p + 4);
+        m_yaw[i] = p[6];
+        p += 7;
+        if (flags & kFlagMoving) {
+            m_velX[i] = static_cast<int16_t>(ReadU16(p));
+            m_velY[i] = static_cast<int16_t>(ReadU16(p + 2));
+            m_velZ[i] = static_cast<int16_t>(ReadU16(p + 4));
+            p += 6;
+        } else {
+            m_velX[i] = m_velY[i] = m_velZ[i] = 0;
+        }
+    }
+
+    Dequantize(out);
+    return true;
+}
+
+} // namespace mmorpg::network
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-173] Quantization frame shared by server and client. The ground plane is x/y in cells of
+// cell_size, as in WorldGrid::Config; z is height within [min_height, max_height].
+struct MovementCodecConfig {
+    float cell_size = 100.0f;
+    float world_min_x = 0.0f;
+    float world_min_y = 0.0f;
+    float min_height = -512.0f;
+    float max_height = 1536.0f;
+};
+
+// [SEQUENCE: MVP19-174] Movement for a list of entities in structure-of-arrays form, so the quantization passes
+// can load four entities per register. yaw is the rotation about the vertical axis in radians.
+struct MovementBatch {
+    std::vector<uint64_t> entity_ids;
+    std::vector<uint32_t> sequences;
+    std::vector<float> x, y, z;
+    std::vector<float> yaw;
+    std::vector<float> vx, vy, vz;
+
+    size_t Size() const { return entity_ids.size(); }
+    void Resize(size_t count);
+    void Clear() { Resize(0); }
+};
+
+// [SEQUENCE: MVP19-175] Compact movement encoding. Per entity:
+//   varint  zigzag(entity id - previous id)
+//   varint  zigzag(sequence - batch base sequence)
+//   u8      flags: bit 0 cell differs from the previous entity's, bit 1 velocity present
+//   varint  zigzag(cell x delta), zigzag(cell y delta)        (if bit 0)
+//   u16 x3  x/y offset within the cell, height                 (1/65535 of cell / height range)
+//   u8      yaw                                                 (2*pi/256)
+//   i16 x3  velocity                                            (1 cm/s, saturating at +-327 m/s)     (if bit 1)
+// preceded by varint count and varint base sequence. A standing entity in the previous entity's cell is about
+// ten bytes, a moving one sixteen, against roughly fifty for a MovementUpdate message.
+//
+// Quantization and dequantization run as SSE2 passes over the whole batch; only the byte emission is serial.
+// Not thread-safe: the scratch columns are reused across calls.
+class MovementCodec {
+public:
+    // Velocity step. A velocity whose three components all round to zero is omitted from the record.
+    static constexpr float kVelocityResolution = 0.01f;
+    // Worst case per entity: id, sequence, flags, two cell deltas, fixed fields, velocity.
+    static constexpr size_t kMaxRecordSize = 10 + 5 + 1 + 5 + 5 + 7 + 6;
+
+    explicit MovementCodec(const MovementCodecConfig& config = {});
+
+    void Encode(const MovementBatch& batch, std::vector<std::byte>& out);
+
+    // Returns false on a truncated or malformed buffer; out is then unspecified.
+    bool Decode(const std::byte* data, size_t size, MovementBatch& out);
+
+    const MovementCodecConfig& GetConfig() const { return m_config; }
+
+private:
+    void ResizeColumns(size_t count);
+    void Quantize(const MovementBatch& batch);
+    void QuantizeOne(const MovementBatch& batch, size_t i);
+    void Dequantize(MovementBatch& batch) const;
+    void DequantizeOne(MovementBatch& batch, size_t i) const;
+
+    MovementCodecConfig m_config;
+    float m_inverseCellSize;
+    float m_heightScale;          // Height units -> 0..65535
+    float m_inverseHeightScale;
+
+    // Quantized columns of the batch being encoded or decoded
+    std::vector<int32_t> m_cellX, m_cellY;
+    std::vector<uint16_t> m_offsetX, m_offsetY, m_height;
+    std::vector<uint8_t> m_yaw;
+    std::vector<int16_t> m_velX, m_velY, m_velZ;
+};
+
+} // namespace mmorpg::network
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "network/udp_datagram.h"
+#include "core/concurrent/lock_free_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-65] A decoded movement sample tagged with who sent it.
+struct MovementInput {
+    uint64_t player_id = 0;
+    uint32_t session_id = 0;
+    uint16_t sequence = 0;
+    MovementSample sample;
+    std::chrono::steady_clock::time_point received_at;
+};
+
+// [SEQUENCE: MVP19-66] Hand-off between the UDP ingest workers (producers) and the simulation tick (consumer).
+// Producers push lock-free; once per tick the simulation drains everything that arrived since the last tick.
+// Only the newest sample per player survives the drain, because a later position supersedes an earlier one.
+// If the simulation stalls, pushes beyond max_pending are dropped instead of growing the queue without bound.
+class MovementInputQueue {
+public:
+    explicit MovementInputQueue(size_t max_pending = 65536) : m_maxPending(max_pending) {}
+
+    MovementInputQueue(const MovementInputQueue&) = delete;
+    MovementInputQueue& operator=(const MovementInputQueue&) = delete;
+
+    // Thread-safe. Returns false if the input was dropped because the queue is full.
+    bool Push(MovementInput input) {
+        if (m_pending.fetch_add(1, std::memory_order_relaxed) >= m_maxPending) {
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        m_queue.Enqueue(std::move(input));
+        return true;
+    }
+
+    // Single consumer. Replaces the contents of out with the newest input per player. Returns the number
+    // of raw inputs consumed (>= out.size()).
+    size_t DrainTick(std::vector<MovementInput>& out) {
+        out.clear();
+        m_indexByPlayer.clear();
+        size_t consumed = 0;
+        MovementInput input;
+        while (m_queue.Dequeue(input)) {
+            ++consumed;
+            auto [it, inserted] = m_indexByPlayer.try_emplace(input.player_id, out.size());
+            if (inserted) {
+                out.push_back(input);
+            } else if (SequenceGreaterThan(input.sequence, out[it->second].sequence)) {
+                out[it->second] = input;
+            }
+        }
+        m_pending.fetch_sub(consumed, std::memory_order_relaxed);
+        m_superseded.fetch_add(consumed - out.size(), std::memory_order_relaxed);
+        return consumed;
+    }
+
+    size_t GetPendingCount() const { return m_pending.load(std::memory_order_relaxed); }
+    uint64_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+    uint64_t GetSupersededCount() const { return m_superseded.load(std::memory_order_relaxed); }
+
+private:
+    concurrent::LockFreeQueue<MovementInput> m_queue;
+    const size_t m_maxPending;
+    std::atomic<size_t> m_pending{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_superseded{0};
+
+    // Consumer-only scratch, kept to avoid rehashing every tick.
+    std::unordered_map<uint64_t, size_t> m_indexByPlayer;
+};
+
+} // namespace mmorpg::network
@@ -0,0 +1,55 @@
+#include "network/movement_relay.h"
+
+#include <utility>
+
+namespace mmorpg::network {
+
+MovementRelay::MovementRelay(const Config& config, EntityUpdateBatcher::PacketSink sink)
+    : m_config(config), m_sink(std::move(sink)) {}
+
+// [SEQUENCE: MVP19-447] Positions are refreshed from the whole tick before any recipient is chosen, so two
+// players who moved toward each other this tick see each other's update in the same tick.
+void MovementRelay::Tick(const std::vector<MovementInput>& inputs, std::chrono::steady_clock::time_point now) {
+    for (const auto& input : inputs) {
+        auto& player = m_players[input.player_id];
+        player.session_id = input.session_id;
+        for (int axis = 0; axis < 3; ++axis) {
+            player.position[axis] = input.sample.position[axis];
+        }
+        player.last_input = now;
+    }
+    std::erase_if(m_players, [&](const auto& entry) { return now - entry.second.last_input > m_config.forget_after; });
+
+    m_batcher.BeginTick(++m_tick);
+    const float radius_squared = m_config.relay_radius * m_config.relay_radius;
+    for (const auto& input : inputs) {
+        const auto& sample = input.sample;
+        auto* update = m_batcher.NewUpdate();
+        update->set_entity_id(input.player_id);
+        auto* movement = update->mutable_movement();
+        movement->set_entity_id(input.player_id);
+        movement->mutable_position()->set_x(sample.position[0]);
+        movement->mutable_position()->set_y(sample.position[1]);
+        movement->mutable_position()->set_z(sample.position[2]);
+        movement->mutable_velocity()->set_x(sample.velocity[0]);
+        movement->mutable_velocity()->set_y(sample.velocity[1]);
+        movement->mutable_velocity()->set_z(sample.velocity[2]);
+        movement->mutable_rotation()->set_y(sample.yaw);
+        movement->set_timestamp(static_cast<float>(sample.client_time_ms) / 1000.0f);
+        movement->set_sequence_number(input.sequence);
+        const auto record = m_batcher.Encode(*update);
+
+        for (const auto& [player_id, player] : m_players) {
+            if (player_id == input.player_id) continue;
+            const float dx = player.position[0] - sample.position[0];
+            const float dy = player.position[1] - sample.position[1];
+            const float dz = player.position[2] - sample.position[2];
+            if (dx * dx + dy * dy + dz * dz <= radius_squared) {
+                m_batcher.AddRecipient(player.session_id, record);
+            }
+        }
+    }
+    m_batcher.Flush(m_sink);
+}
+
+} // namespace mmorpg::network
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "network/entity_update_batcher.h"
+#include "network/movement_input_queue.h"
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-446] Per-tick movement fan-out for a node that hosts no ECS world. Each tick's newest input
+// per player is encoded once through EntityUpdateBatcher and referenced from the batch of every other player
+// within relay_radius of the mover, so each session gets at most one PACKET_ENTITY_UPDATE_BATCH per tick.
+// A player becomes a recipient once it has moved, at its last reported position, and is forgotten after
+// forget_after without input. Positions are relayed as the clients reported them; validating them takes the
+// world's MovementSystem, and a world-hosting server syncs through NetworkSyncSystem instead.
+//
+// Not thread-safe; owned by the tick loop.
+class MovementRelay {
+public:
+    struct Config {
+        float relay_radius = 100.0f;
+        std::chrono::milliseconds forget_after{5000};
+    };
+
+    MovementRelay(const Config& config, EntityUpdateBatcher::PacketSink sink);
+
+    MovementRelay(const MovementRelay&) = delete;
+    MovementRelay& operator=(const MovementRelay&) = delete;
+
+    // inputs is one tick's MovementInputQueue::DrainTick output
+    void Tick(const std::vector<MovementInput>& inputs, std::chrono::steady_clock::time_point now);
+
+    size_t GetTrackedPlayerCount() const { return m_players.size(); }
+    const EntityUpdateBatchStats& GetLastTickStats() const { return m_batcher.GetTickStats(); }
+
+private:
+    struct Player {
+        uint32_t session_id = 0;
+        float position[3] = {0.0f, 0.0f, 0.0f};
+        std::chrono::steady_clock::time_point last_input;
+    };
+
+    const Config m_config;
+    EntityUpdateBatcher::PacketSink m_sink;
+    EntityUpdateBatcher m_batcher;
+    uint32_t m_tick = 0;
+    std::unordered_map<uint64_t, Player> m_players;   // By player id
+};
+
+} // namespace mmorpg::network
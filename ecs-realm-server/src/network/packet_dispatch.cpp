@@ -0,0 +1,45 @@
+#include "network/packet_dispatch.h"
+
+#include <google/protobuf/message.h>
+
+namespace mmorpg::network {
+
+namespace {
+
+template <size_t... I>
+std::array<const google::protobuf::Message*, kPacketSlotCount> BuildPrototypeTable(std::index_sequence<I...>) {
+    return {&std::tuple_element_t<I, DispatchableMessages>::default_instance()...};
+}
+
+template <size_t... I>
+constexpr std::array<mmorpg::proto::PacketType, kPacketSlotCount> BuildTypeTable(std::index_sequence<I...>) {
+    return {PacketTraits<std::tuple_element_t<I, DispatchableMessages>>::kType...};
+}
+
+constexpr auto kSlotTypes = BuildTypeTable(std::make_index_sequence<kPacketSlotCount>{});
+
+} // namespace
+
+// [SEQUENCE: MVP19-5] Prototype table indexed by dense slot, built once from DispatchableMessages.
+const google::protobuf::Message* GetPacketPrototype(int slot) {
+    static const auto prototypes = BuildPrototypeTable(std::make_index_sequence<kPacketSlotCount>{});
+    if (slot < 0 || static_cast<size_t>(slot) >= kPacketSlotCount) return nullptr;
+    return prototypes[slot];
+}
+
+mmorpg::proto::PacketType PacketTypeForSlot(int slot) {
+    if (slot < 0 || static_cast<size_t>(slot) >= kPacketSlotCount) return mmorpg::proto::PACKET_UNKNOWN;
+    return kSlotTypes[slot];
+}
+
+// A linear scan over a handful of pointers; cheaper than hashing the type name.
+int PacketSlotForDescriptor(const google::protobuf::Descriptor* descriptor) {
+    for (size_t slot = 0; slot < kPacketSlotCount; ++slot) {
+        if (GetPacketPrototype(static_cast<int>(slot))->GetDescriptor() == descriptor) {
+            return static_cast<int>(slot);
+        }
+    }
+    return kInvalidPacketSlot;
+}
+
+} // namespace mmorpg::network
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+#include "proto/packet.pb.h"
+#include "proto/auth.pb.h"
+#include "proto/game.pb.h"
+#include "proto/cluster.pb.h"
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-1] Compile-time mapping from a Protobuf message type to its PacketType.
+// Only messages listed here can be dispatched through the dense table; everything else is rejected
+// before any allocation happens.
+template <typename T>
+struct PacketTraits;
+
+#define MMORPG_PACKET_TRAITS(MessageType, PacketTypeValue)                      \
+    template <>                                                                 \
+    struct PacketTraits<MessageType> {                                          \
+        static constexpr mmorpg::proto::PacketType kType = PacketTypeValue;     \
+    }
+
+MMORPG_PACKET_TRAITS(mmorpg::proto::LoginRequest, mmorpg::proto::PACKET_LOGIN_REQUEST);
+MMORPG_PACKET_TRAITS(mmorpg::proto::LoginResponse, mmorpg::proto::PACKET_LOGIN_RESPONSE);
+MMORPG_PACKET_TRAITS(mmorpg::proto::LogoutRequest, mmorpg::proto::PACKET_LOGOUT_REQUEST);
+MMORPG_PACKET_TRAITS(mmorpg::proto::LogoutResponse, mmorpg::proto::PACKET_LOGOUT_RESPONSE);
+MMORPG_PACKET_TRAITS(mmorpg::proto::HeartbeatRequest, mmorpg::proto::PACKET_HEARTBEAT_REQUEST);
+MMORPG_PACKET_TRAITS(mmorpg::proto::HeartbeatResponse, mmorpg::proto::PACKET_HEARTBEAT_RESPONSE);
+MMORPG_PACKET_TRAITS(mmorpg::proto::EnterWorldRequest, mmorpg::proto::PACKET_ENTER_WORLD_REQUEST);
+MMORPG_PACKET_TRAITS(mmorpg::proto::EnterWorldResponse, mmorpg::proto::PACKET_ENTER_WORLD_RESPONSE);
+MMORPG_PACKET_TRAITS(mmorpg::proto::MovementUpdate, mmorpg::proto::PACKET_MOVEMENT_UPDATE);
+MMORPG_PACKET_TRAITS(mmorpg::proto::EntityUpdate, mmorpg::proto::PACKET_ENTITY_UPDATE);
+MMORPG_PACKET_TRAITS(mmorpg::proto::EntityUpdateBatch, mmorpg::proto::PACKET_ENTITY_UPDATE_BATCH);
+MMORPG_PACKET_TRAITS(mmorpg::proto::EntityDeltaSnapshot, mmorpg::proto::PACKET_ENTITY_DELTA_SNAPSHOT);
+MMORPG_PACKET_TRAITS(mmorpg::proto::SnapshotAck, mmorpg::proto::PACKET_SNAPSHOT_ACK);
+MMORPG_PACKET_TRAITS(mmorpg::proto::CombatAction, mmorpg::proto::PACKET_COMBAT_ACTION);
+MMORPG_PACKET_TRAITS(mmorpg::proto::CombatResult, mmorpg::proto::PACKET_COMBAT_RESULT);
+MMORPG_PACKET_TRAITS(mmorpg::proto::ChatMessage, mmorpg::proto::PACKET_CHAT_MESSAGE);
+MMORPG_PACKET_TRAITS(mmorpg::proto::GuildCreateRequest, mmorpg::proto::PACKET_GUILD_CREATE_REQUEST);
+MMORPG_PACKET_TRAITS(mmorpg::proto::GuildInviteRequest, mmorpg::proto::PACKET_GUILD_INVITE_REQUEST);
+MMORPG_PACKET_TRAITS(mmorpg::proto::GuildInviteAcceptRequest, mmorpg::proto::PACKET_GUILD_INVITE_ACCEPT_REQUEST);
+MMORPG_PACKET_TRAITS(mmorpg::proto::GuildLeaveRequest, mmorpg::proto::PACKET_GUILD_LEAVE_REQUEST);
+MMORPG_PACKET_TRAITS(mmorpg::proto::DuelAcceptRequest, mmorpg::proto::PACKET_DUEL_ACCEPT_REQUEST);
+MMORPG_PACKET_TRAITS(mmorpg::proto::DuelDeclineRequest, mmorpg::proto::PACKET_DUEL_DECLINE_REQUEST);
+MMORPG_PACKET_TRAITS(mmorpg::proto::NodeLoadReport, mmorpg::proto::PACKET_NODE_LOAD_REPORT);
+MMORPG_PACKET_TRAITS(mmorpg::proto::RouteRequest, mmorpg::proto::PACKET_ROUTE_REQUEST);
+MMORPG_PACKET_TRAITS(mmorpg::proto::RouteResponse, mmorpg::proto::PACKET_ROUTE_RESPONSE);
+MMORPG_PACKET_TRAITS(mmorpg::proto::HandoffOffer, mmorpg::proto::PACKET_HANDOFF_OFFER);
+MMORPG_PACKET_TRAITS(mmorpg::proto::HandoffAccept, mmorpg::proto::PACKET_HANDOFF_ACCEPT);
+MMORPG_PACKET_TRAITS(mmorpg::proto::HandoffRedirect, mmorpg::proto::PACKET_HANDOFF_REDIRECT);
+MMORPG_PACKET_TRAITS(mmorpg::proto::HandoffClaim, mmorpg::proto::PACKET_HANDOFF_CLAIM);
+MMORPG_PACKET_TRAITS(mmorpg::proto::HandoffClaimResponse, mmorpg::proto::PACKET_HANDOFF_CLAIM_RESPONSE);
+
+#undef MMORPG_PACKET_TRAITS
+
+// [SEQUENCE: MVP19-2] The ordered list of dispatchable messages. A message's index in this list is its dense slot.
+using DispatchableMessages = std::tuple<
+    mmorpg::proto::LoginRequest,
+    mmorpg::proto::LoginResponse,
+    mmorpg::proto::LogoutRequest,
+    mmorpg::proto::LogoutResponse,
+    mmorpg::proto::HeartbeatRequest,
+    mmorpg::proto::HeartbeatResponse,
+    mmorpg::proto::EnterWorldRequest,
+    mmorpg::proto::EnterWorldResponse,
+    mmorpg::proto::MovementUpdate,
+    mmorpg::proto::EntityUpdate,
+    mmorpg::proto::EntityUpdateBatch,
+    mmorpg::proto::EntityDeltaSnapshot,
+    mmorpg::proto::SnapshotAck,
+    mmorpg::proto::CombatAction,
+    mmorpg::proto::CombatResult,
+    mmorpg::proto::ChatMessage,
+    mmorpg::proto::GuildCreateRequest,
+    mmorpg::proto::GuildInviteRequest,
+    mmorpg::proto::GuildInviteAcceptRequest,
+    mmorpg::proto::GuildLeaveRequest,
+    mmorpg::proto::DuelAcceptRequest,
+    mmorpg::proto::DuelDeclineRequest,
+    mmorpg::proto::NodeLoadReport,
+    mmorpg::proto::RouteRequest,
+    mmorpg::proto::RouteResponse,
+    mmorpg::proto::HandoffOffer,
+    mmorpg::proto::HandoffAccept,
+    mmorpg::proto::HandoffRedirect,
+    mmorpg::proto::HandoffClaim,
+    mmorpg::proto::HandoffClaimResponse>;
+
+inline constexpr size_t kPacketSlotCount = std::tuple_size_v<DispatchableMessages>;
+inline constexpr int kInvalidPacketSlot = -1;
+
+namespace detail {
+
+// PacketType values are grouped in blocks of 1000 (auth, game, guild, cluster). Each block is small,
+// so a [block][offset] table gives an O(1) lookup without hashing.
+inline constexpr int kPacketBlockCount = 5;
+inline constexpr int kPacketBlockWidth = 16;
+using PacketSlotTable = std::array<std::array<int8_t, kPacketBlockWidth>, kPacketBlockCount>;
+
+template <size_t... I>
+constexpr PacketSlotTable BuildPacketSlotTable(std::index_sequence<I...>) {
+    PacketSlotTable table{};
+    for (auto& block : table) {
+        block.fill(static_cast<int8_t>(kInvalidPacketSlot));
+    }
+    constexpr std::array<int, sizeof...(I)> types = {
+        static_cast<int>(PacketTraits<std::tuple_element_t<I, DispatchableMessages>>::kType)...};
+    for (size_t slot = 0; slot < types.size(); ++slot) {
+        const int block = types[slot] / 1000;
+        const int offset = types[slot] % 1000;
+        if (block >= kPacketBlockCount || offset >= kPacketBlockWidth) {
+            throw "PacketType does not fit into the dispatch table";  // Compile-time error in constexpr context.
+        }
+        table[block][offset] = static_cast<int8_t>(slot);
+    }
+    return table;
+}
+
+inline constexpr PacketSlotTable kPacketSlotTable =
+    BuildPacketSlotTable(std::make_index_sequence<kPacketSlotCount>{});
+
+template <typename T, size_t... I>
+constexpr int SlotOfImpl(std::index_sequence<I...>) {
+    int slot = kInvalidPacketSlot;
+    ((std::is_same_v<T, std::tuple_element_t<I, DispatchableMessages>> ? (slot = static_cast<int>(I)) : 0), ...);
+    return slot;
+}
+
+} // namespace detail
+
+// [SEQUENCE: MVP19-3] Resolves a PacketType received on the wire to its dense slot, or kInvalidPacketSlot.
+constexpr int PacketSlot(mmorpg::proto::PacketType type) {
+    const int value = static_cast<int>(type);
+    if (value < 0) return kInvalidPacketSlot;
+    const int block = value / 1000;
+    const int offset = value % 1000;
+    if (block >= detail::kPacketBlockCount || offset >= detail::kPacketBlockWidth) {
+        return kInvalidPacketSlot;
+    }
+    return detail::kPacketSlotTable[block][offset];
+}
+
+// Resolves a message type to its dense slot at compile time.
+template <typename T>
+constexpr int PacketSlotOf() {
+    constexpr int slot = detail::SlotOfImpl<T>(std::make_index_sequence<kPacketSlotCount>{});
+    static_assert(slot != kInvalidPacketSlot, "Message type is not listed in DispatchableMessages");
+    static_assert(PacketSlot(PacketTraits<T>::kType) == slot, "PacketTraits and DispatchableMessages disagree");
+    return slot;
+}
+
+// Returns the generated default instance for a slot. Used as the prototype for New().
+const google::protobuf::Message* GetPacketPrototype(int slot);
+
+// [SEQUENCE: MVP19-26] Reverse lookups used on the send path.
+mmorpg::proto::PacketType PacketTypeForSlot(int slot);
+int PacketSlotForDescriptor(const google::protobuf::Descriptor* descriptor);
+
+// [SEQUENCE: MVP19-4] Per-session cache of reusable message objects, one per dispatchable slot.
+// Messages are created lazily on first use and then re-parsed in place, so steady-state traffic
+// does not allocate: ParseFromArray clears the message but keeps string and repeated-field capacity.
+// A session's reads are serialized on its strand, so the cache needs no locking.
+class PacketMessageCache {
+public:
+    PacketMessageCache() = default;
+    PacketMessageCache(const PacketMessageCache&) = delete;
+    PacketMessageCache& operator=(const PacketMessageCache&) = delete;
+
+    google::protobuf::Message* Acquire(int slot) {
+        if (slot < 0 || static_cast<size_t>(slot) >= kPacketSlotCount) return nullptr;
+        auto& message = m_messages[slot];
+        if (!message) {
+            message.reset(GetPacketPrototype(slot)->New());
+        }
+        return message.get();
+    }
+
+private:
+    std::array<std::unique_ptr<google::protobuf::Message>, kPacketSlotCount> m_messages;
+};
+
+} // namespace mmorpg::network
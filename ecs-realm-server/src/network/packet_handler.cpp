@@ -1,11 +1,22 @@
 #include "network/packet_handler.h"
 #include "network/session.h"
+#include "monitoring/metrics_collector.h"
 
-#include <iostream>
+#include <chrono>
 #include <google/protobuf/message.h>
+#include <google/protobuf/descriptor.h>
+#include <spdlog/spdlog.h>
 
 namespace mmorpg::network {
 
+// [SEQUENCE: MVP19-11] Default dispatch: parse into the session's reusable message, then use the virtual Handle().
+void IPacketHandler::Dispatch(const std::shared_ptr<Session>& session, mmorpg::proto::PacketType type,
+                              const std::byte* payload, size_t size, PacketMessageCache& cache) {
+    auto* message = cache.Acquire(PacketSlot(type));
+    if (!message || !message->ParseFromArray(payload, static_cast<int>(size))) return;
+    Handle(session, *message);
+}
+
 // [SEQUENCE: MVP1-16] Dispatches a received message to the appropriate registered handler.
 void PacketHandler::Handle(std::shared_ptr<Session> session, const google::protobuf::Message& message) {
     const auto* descriptor = message.GetDescriptor();
@@ -13,19 +24,58 @@ void PacketHandler::Handle(std::shared_ptr<Session> session, const google::proto
     if (it != m_handlers.end()) {
         it->second(session, message);
     } else {
-        // TODO: Replace with a proper logging system like spdlog
-        std::cerr << "Error: No handler registered for message type '" << descriptor->full_name() << "'.\n";
+        DropUnhandled(-1);
+    }
+}
+
+// [SEQUENCE: MVP19-12] Hot-path dispatch: one table index, one in-place parse, no string or heap work.
+void PacketHandler::Dispatch(const std::shared_ptr<Session>& session, mmorpg::proto::PacketType type,
+                             const std::byte* payload, size_t size, PacketMessageCache& cache) {
+    const int slot = PacketSlot(type);
+    if (slot == kInvalidPacketSlot || !m_dispatchTable[slot]) {
+        DropUnhandled(static_cast<int>(type));
+        return;
+    }
+
+    auto* message = cache.Acquire(slot);
+    if (!message->ParseFromArray(payload, static_cast<int>(size))) return;
+    m_dispatchTable[slot](session, *message);
+}
+
+// [SEQUENCE: MVP19-432] Counts the drop; one thread per interval wins the exchange and logs how many were
+// dropped since the last line. type is -1 when the message arrived through Handle.
+void PacketHandler::DropUnhandled(int type) {
+    m_unhandled.fetch_add(1, std::memory_order_relaxed);
+    m_unhandledSinceLog.fetch_add(1, std::memory_order_relaxed);
+    const int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t logged_at = m_unhandledLoggedAtMs.load(std::memory_order_relaxed);
+    if (now_ms - logged_at < kUnhandledLogIntervalMs ||
+        !m_unhandledLoggedAtMs.compare_exchange_strong(logged_at, now_ms, std::memory_order_relaxed)) {
+        return;
     }
+    spdlog::warn("Dropped {} packets with no registered handler (latest type {})",
+                 m_unhandledSinceLog.exchange(0, std::memory_order_relaxed), type);
+}
+
+void PacketHandler::ExportMetrics(monitoring::MetricsCollector& metrics) const {
+    metrics.RecordCounter("packets.unhandled", GetUnhandledCount());
 }
 
 // [SEQUENCE: MVP1-15] Registers a callback for a specific Protobuf message type.
 void PacketHandler::RegisterHandler(const google::protobuf::Descriptor* descriptor, PacketHandlerCallback handler) {
+    RegisterSlot(PacketSlotForDescriptor(descriptor), descriptor, std::move(handler));
+}
 
+// [SEQUENCE: MVP19-13] Stores the callback in both the descriptor map (for Handle) and the dense table (for Dispatch).
+void PacketHandler::RegisterSlot(int slot, const google::protobuf::Descriptor* descriptor, PacketHandlerCallback handler) {
     if (!m_handlers.try_emplace(descriptor, handler).second) {
-        // TODO: Replace with a proper logging system
-        std::cerr << "Warning: Handler for message type '" << descriptor->full_name() << "' was already registered. Overwriting.\n";
+        spdlog::warn("Handler for message type '{}' was already registered. Overwriting.", descriptor->full_name());
         m_handlers[descriptor] = handler;
     }
+    if (slot != kInvalidPacketSlot) {
+        m_dispatchTable[slot] = std::move(handler);
+    }
 }
 
-}
\ No newline at end of file
+}
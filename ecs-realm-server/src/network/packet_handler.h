@@ -3,8 +3,13 @@
 #include <functional>
 #include <atomic>
 #include <memory>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <unordered_map>
 
+#include "network/packet_dispatch.h"
+
 // Forward declarations
 namespace google::protobuf {
 class Message;
@@ -13,6 +18,9 @@ class Descriptor;
 namespace mmorpg::network {
 class Session;
 }
+namespace mmorpg::monitoring {
+class MetricsCollector;
+}
 
 namespace mmorpg::network {
 
@@ -24,6 +32,12 @@ public:
     virtual ~IPacketHandler() = default;
     virtual void Handle(std::shared_ptr<Session> session, const google::protobuf::Message& message) = 0;
     virtual void RegisterHandler(const google::protobuf::Descriptor* descriptor, PacketHandlerCallback handler) = 0;
+
+    // [SEQUENCE: MVP19-8] Parses a raw payload into the session's cached message for the given type and handles it.
+    // The default implementation reuses the cached message and forwards to Handle(); PacketHandler overrides it
+    // with a dense table lookup.
+    virtual void Dispatch(const std::shared_ptr<Session>& session, mmorpg::proto::PacketType type,
+                          const std::byte* payload, size_t size, PacketMessageCache& cache);
 };
 
 // [SEQUENCE: MVP1-14] A basic implementation of the packet handler interface.
@@ -31,9 +45,37 @@ class PacketHandler : public IPacketHandler {
 public:
     void Handle(std::shared_ptr<Session> session, const google::protobuf::Message& message) override;
     void RegisterHandler(const google::protobuf::Descriptor* descriptor, PacketHandlerCallback handler) override;
+    void Dispatch(const std::shared_ptr<Session>& session, mmorpg::proto::PacketType type,
+                  const std::byte* payload, size_t size, PacketMessageCache& cache) override;
+
+    // [SEQUENCE: MVP19-9] Typed registration. The slot is resolved at compile time and the callback receives
+    // the concrete message type, so handlers no longer need a static_cast.
+    template <typename T>
+    void RegisterHandler(std::function<void(std::shared_ptr<Session>, const T&)> handler) {
+        constexpr int slot = PacketSlotOf<T>();
+        RegisterSlot(slot, T::descriptor(),
+            [handler = std::move(handler)](std::shared_ptr<Session> session, const google::protobuf::Message& message) {
+                handler(std::move(session), static_cast<const T&>(message));
+            });
+    }
+
+    // [SEQUENCE: MVP19-431] Packets dropped because no handler is registered for their type. The type is chosen
+    // by the client, so these are counted and logged at most once per kUnhandledLogIntervalMs, never per packet.
+    static constexpr int64_t kUnhandledLogIntervalMs = 1000;
+    uint64_t GetUnhandledCount() const { return m_unhandled.load(std::memory_order_relaxed); }
+    void ExportMetrics(monitoring::MetricsCollector& metrics) const;
 
 private:
+    void RegisterSlot(int slot, const google::protobuf::Descriptor* descriptor, PacketHandlerCallback handler);
+    void DropUnhandled(int type);
+
     std::unordered_map<const google::protobuf::Descriptor*, PacketHandlerCallback> m_handlers;
+    // [SEQUENCE: MVP19-10] Handlers indexed by dense packet slot for the hot receive path.
+    std::array<PacketHandlerCallback, kPacketSlotCount> m_dispatchTable;
+
+    std::atomic<uint64_t> m_unhandled{0};
+    std::atomic<uint64_t> m_unhandledSinceLog{0};
+    std::atomic<int64_t> m_unhandledLoggedAtMs{0};
 };
 
 }
@@ -1,8 +1,11 @@
 #include "network/packet_serializer.h"
+#include "network/packet_dispatch.h"
 #include "proto/packet.pb.h"
 #include "proto/packet.pb.h"
 
 #include <google/protobuf/message.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
 #include <arpa/inet.h> // For htonl, ntohl
 #include <map>
 
@@ -20,6 +23,9 @@ std::map<std::string, mmorpg::proto::PacketType> type_name_to_packet_type_map =
     {"mmorpg.proto.EnterWorldResponse", mmorpg::proto::PACKET_ENTER_WORLD_RESPONSE},
     {"mmorpg.proto.MovementUpdate", mmorpg::proto::PACKET_MOVEMENT_UPDATE},
     {"mmorpg.proto.EntityUpdate", mmorpg::proto::PACKET_ENTITY_UPDATE},
+    {"mmorpg.proto.EntityUpdateBatch", mmorpg::proto::PACKET_ENTITY_UPDATE_BATCH},
+    {"mmorpg.proto.EntityDeltaSnapshot", mmorpg::proto::PACKET_ENTITY_DELTA_SNAPSHOT},
+    {"mmorpg.proto.SnapshotAck", mmorpg::proto::PACKET_SNAPSHOT_ACK},
     {"mmorpg.proto.CombatAction", mmorpg::proto::PACKET_COMBAT_ACTION},
     {"mmorpg.proto.CombatResult", mmorpg::proto::PACKET_COMBAT_RESULT},
     {"mmorpg.proto.ChatMessage", mmorpg::proto::PACKET_CHAT_MESSAGE},
@@ -33,29 +39,72 @@ std::map<std::string, mmorpg::proto::PacketType> type_name_to_packet_type_map =
 
 // [SEQUENCE: MVP1-11] Serializes a message into a byte vector with a 4-byte size header.
 std::vector<std::byte> Serialize(const google::protobuf::Message& message) {
-    proto::Packet packet;
-    auto* header = packet.mutable_header();
-
-    auto it = type_name_to_packet_type_map.find(message.GetTypeName());
-    if (it == type_name_to_packet_type_map.end()) {
+    std::vector<std::byte> buffer;
+    if (!SerializeInto(message, buffer)) {
         return {};
     }
-    header->set_type(it->second);
+    return buffer;
+}
 
-    if (!message.SerializeToString(packet.mutable_payload())) {
-        return {};
+// [SEQUENCE: MVP19-25] Writes the Packet wire format directly into the caller's buffer.
+// The payload is serialized straight into place instead of through an intermediate payload string,
+// and the type is resolved via the dispatch table's descriptor rather than a type-name string.
+bool SerializeInto(const google::protobuf::Message& message, std::vector<std::byte>& buffer) {
+    proto::PacketType type = proto::PACKET_UNKNOWN;
+    const int slot = PacketSlotForDescriptor(message.GetDescriptor());
+    if (slot != kInvalidPacketSlot) {
+        type = PacketTypeForSlot(slot);
+    } else {
+        auto it = type_name_to_packet_type_map.find(message.GetTypeName());
+        if (it == type_name_to_packet_type_map.end()) {
+            return false;
+        }
+        type = it->second;
     }
 
-    const size_t packet_size = packet.ByteSizeLong();
-    std::vector<std::byte> buffer(4 + packet_size);
+    const size_t payload_size = message.ByteSizeLong();
+    std::byte* payload = BeginFrame(type, payload_size, buffer);
+    uint8_t* target = message.SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t*>(payload));
+
+    return target == reinterpret_cast<uint8_t*>(buffer.data() + buffer.size());
+}
+
+// [SEQUENCE: MVP19-141] Length prefix, Packet.header and the Packet.payload tag/length, sized for a payload of
+// payload_size bytes. Shared by SerializeInto and callers that assemble the payload from pre-encoded pieces.
+std::byte* BeginFrame(proto::PacketType type, size_t payload_size, std::vector<std::byte>& buffer) {
+    using google::protobuf::internal::WireFormatLite;
+    using google::protobuf::io::CodedOutputStream;
+
+    proto::PacketHeader header;
+    header.set_type(type);
+    const size_t header_size = header.ByteSizeLong();
+
+    const size_t packet_size =
+        WireFormatLite::TagSize(proto::Packet::kHeaderFieldNumber, WireFormatLite::TYPE_MESSAGE) +
+        CodedOutputStream::VarintSize32(static_cast<uint32_t>(header_size)) + header_size +
+        WireFormatLite::TagSize(proto::Packet::kPayloadFieldNumber, WireFormatLite::TYPE_BYTES) +
+        CodedOutputStream::VarintSize32(static_cast<uint32_t>(payload_size)) + payload_size;
+
+    buffer.resize(4 + packet_size);
 
     uint32_t net_packet_size = htonl(static_cast<uint32_t>(packet_size));
     memcpy(buffer.data(), &net_packet_size, sizeof(net_packet_size));
 
-    if (!packet.SerializeToArray(buffer.data() + 4, packet_size)) {
-        return {};
-    }
+    uint8_t* target = reinterpret_cast<uint8_t*>(buffer.data() + 4);
+    target = WireFormatLite::WriteTagToArray(proto::Packet::kHeaderFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, target);
+    target = CodedOutputStream::WriteVarint32ToArray(static_cast<uint32_t>(header_size), target);
+    target = header.SerializeWithCachedSizesToArray(target);
+    target = WireFormatLite::WriteTagToArray(proto::Packet::kPayloadFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, target);
+    target = CodedOutputStream::WriteVarint32ToArray(static_cast<uint32_t>(payload_size), target);
+    return reinterpret_cast<std::byte*>(target);
+}
 
+// [SEQUENCE: MVP19-34] Framed once, then shared read-only by every recipient's write queue.
+SharedPacketBuffer SerializeShared(const google::protobuf::Message& message) {
+    auto buffer = std::make_shared<std::vector<std::byte>>();
+    if (!SerializeInto(message, *buffer)) {
+        return nullptr;
+    }
     return buffer;
 }
 
@@ -69,5 +118,48 @@ std::unique_ptr<proto::Packet> Deserialize(const std::byte* data, size_t size) {
     return nullptr;
 }
 
+// [SEQUENCE: MVP19-7] Walks the Packet wire format directly: header.type is read as a varint and the
+// payload is returned as a pointer into the caller's buffer, so the message body is parsed exactly once.
+bool ParseEnvelope(const std::byte* data, size_t size, PacketEnvelope& envelope) {
+    using google::protobuf::internal::WireFormatLite;
+
+    envelope = PacketEnvelope{};
+    google::protobuf::io::CodedInputStream input(reinterpret_cast<const uint8_t*>(data), static_cast<int>(size));
+
+    while (uint32_t tag = input.ReadTag()) {
+        const int field = WireFormatLite::GetTagFieldNumber(tag);
+        const auto wire_type = WireFormatLite::GetTagWireType(tag);
+
+        if (field == proto::Packet::kHeaderFieldNumber && wire_type == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+            uint32_t header_size = 0;
+            if (!input.ReadVarint32(&header_size)) return false;
+            auto limit = input.PushLimit(static_cast<int>(header_size));
+            while (uint32_t header_tag = input.ReadTag()) {
+                if (WireFormatLite::GetTagFieldNumber(header_tag) == proto::PacketHeader::kTypeFieldNumber &&
+                    WireFormatLite::GetTagWireType(header_tag) == WireFormatLite::WIRETYPE_VARINT) {
+                    uint32_t type = 0;
+                    if (!input.ReadVarint32(&type)) return false;
+                    envelope.type = static_cast<proto::PacketType>(type);
+                } else if (!WireFormatLite::SkipField(&input, header_tag)) {
+                    return false;
+                }
+            }
+            if (!input.ConsumedEntireMessage()) return false;
+            input.PopLimit(limit);
+        } else if (field == proto::Packet::kPayloadFieldNumber && wire_type == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+            uint32_t payload_size = 0;
+            if (!input.ReadVarint32(&payload_size)) return false;
+            const int offset = input.CurrentPosition();
+            if (!input.Skip(static_cast<int>(payload_size))) return false;
+            envelope.payload = data + offset;
+            envelope.payload_size = payload_size;
+        } else if (!WireFormatLite::SkipField(&input, tag)) {
+            return false;
+        }
+    }
+
+    return input.ConsumedEntireMessage();
+}
+
 } // namespace PacketSerializer
 } // namespace mmorpg::network
\ No newline at end of file
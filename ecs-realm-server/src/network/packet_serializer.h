@@ -13,14 +13,38 @@ class Message;
 
 namespace mmorpg::network {
 
+// [SEQUENCE: MVP19-33] An immutable, reference-counted framed packet. Broadcasts serialize once into one of
+// these and every target session queues the same buffer.
+using SharedPacketBuffer = std::shared_ptr<const std::vector<std::byte>>;
+
 // [SEQUENCE: MVP1-10] PacketSerializer: A utility for serializing and deserializing Protobuf messages.
 namespace PacketSerializer {
 
     // Serializes a Protobuf message into a byte vector with a 4-byte length prefix.
     std::vector<std::byte> Serialize(const google::protobuf::Message& message);
 
+    // Serializes into an existing buffer, reusing its capacity. Returns false for unknown message types.
+    bool SerializeInto(const google::protobuf::Message& message, std::vector<std::byte>& buffer);
+
+    // Resizes buffer to a full frame for a payload_size-byte payload of the given type, writes everything but
+    // the payload, and returns where the payload goes. The payload must fill the rest of the buffer exactly.
+    std::byte* BeginFrame(mmorpg::proto::PacketType type, size_t payload_size, std::vector<std::byte>& buffer);
+
+    // Serializes once into a shared immutable buffer. Returns nullptr for unknown message types.
+    SharedPacketBuffer SerializeShared(const google::protobuf::Message& message);
+
     // Deserializes a byte array into a Packet message.
     std::unique_ptr<mmorpg::proto::Packet> Deserialize(const std::byte* data, size_t size);
 
+    // [SEQUENCE: MVP19-6] A non-owning view of a Packet envelope. The payload points into the source buffer.
+    struct PacketEnvelope {
+        mmorpg::proto::PacketType type = mmorpg::proto::PACKET_UNKNOWN;
+        const std::byte* payload = nullptr;
+        size_t payload_size = 0;
+    };
+
+    // Parses the Packet envelope in place without materializing a proto::Packet or copying the payload.
+    bool ParseEnvelope(const std::byte* data, size_t size, PacketEnvelope& envelope);
+
 } // namespace PacketSerializer
 } // namespace mmorpg::network
\ No newline at end of file
@@ -0,0 +1,1524 @@
+#include "network/quic_connection.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mmorpg::network {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr uint8_t kClientHello = 0x01;
+constexpr uint8_t kServerHello = 0x02;
+constexpr uint8_t kHelloFlagResumed = 0x01;
+constexpr size_t kMaxCryptoBytes = 4096;
+constexpr size_t kMaxAckRanges = 32;
+constexpr uint64_t kPacketThreshold = 3;
+constexpr uint64_t kMaxStreamId = (1ull << 62) - 1;
+constexpr size_t kMaxProbes = 2;
+constexpr size_t kStreamFrameOverhead = 1 + 8 + 8 + 2;   // type, id, offset, 2-byte length
+
+// Salt for Initial secrets; the RFC 9001 value, kept so the derivation reads the same
+constexpr uint8_t kInitialSalt[] = {0x38, 0x76, 0x2c, 0xf7, 0xf5, 0x59, 0x34, 0xb3, 0x4d, 0x17,
+                                    0x9a, 0xe6, 0xa4, 0xc8, 0x0c, 0xad, 0xcc, 0xbb, 0x7f, 0x0a};
+
+const uint8_t* AsBytes(const std::byte* data) {
+    return reinterpret_cast<const uint8_t*>(data);
+}
+
+void AppendBytes(std::vector<std::byte>& out, const uint8_t* data, size_t size) {
+    const auto* begin = reinterpret_cast<const std::byte*>(data);
+    out.insert(out.end(), begin, begin + size);
+}
+
+void WriteFrameType(std::vector<std::byte>& out, QuicFrameType type) {
+    quic_wire::WriteVarint(out, static_cast<uint64_t>(type));
+}
+
+// Handshake message: type(1) length(2) body
+std::vector<std::byte> MakeHandshakeMessage(uint8_t type, const std::vector<std::byte>& body) {
+    std::vector<std::byte> message;
+    message.reserve(3 + body.size());
+    message.push_back(static_cast<std::byte>(type));
+    message.push_back(static_cast<std::byte>(body.size() >> 8));
+    message.push_back(static_cast<std::byte>(body.size()));
+    message.insert(message.end(), body.begin(), body.end());
+    return message;
+}
+
+QuicSecret TranscriptHash(const std::vector<std::byte>& client_hello, const std::vector<std::byte>& server_hello) {
+    std::vector<uint8_t> transcript;
+    transcript.reserve(client_hello.size() + server_hello.size());
+    transcript.insert(transcript.end(), AsBytes(client_hello.data()), AsBytes(client_hello.data()) + client_hello.size());
+    transcript.insert(transcript.end(), AsBytes(server_hello.data()), AsBytes(server_hello.data()) + server_hello.size());
+    return quic_crypto::Sha256(transcript.data(), transcript.size());
+}
+
+// master = Extract(salt, DH(e, s) || DH(e, e')); with a PSK the salt is derived from the early secret
+QuicSecret MasterSecret(const QuicSecret& static_shared, const QuicSecret& ephemeral_shared,
+                        const QuicSecret* early_secret) {
+    uint8_t ikm[64];
+    std::memcpy(ikm, static_shared.data(), 32);
+    std::memcpy(ikm + 32, ephemeral_shared.data(), 32);
+    if (!early_secret) return quic_crypto::Extract(nullptr, 0, ikm, sizeof(ikm));
+    const QuicSecret salt = quic_crypto::ExpandLabel(*early_secret, "derived", QuicSecret{});
+    return quic_crypto::Extract(salt.data(), salt.size(), ikm, sizeof(ikm));
+}
+
+QuicSecret EarlySecret(const QuicSecret& resumption_secret) {
+    return quic_crypto::Extract(nullptr, 0, resumption_secret.data(), resumption_secret.size());
+}
+
+double Seconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+} // namespace
+
+QuicConnection::QuicConnection(const QuicConfig& config, const QuicPublicKey& server_key, const Endpoint& server,
+                               Clock::time_point now, const QuicResumption* resumption)
+    : m_config(config), m_role(Role::Client) {
+    m_serverStaticKey = server_key;
+    m_path.peer = server;
+    m_path.validated = true;
+    m_originalDcid = quic_crypto::RandomU64();
+    m_peerCid = m_originalDcid;
+    m_localCids.push_back(quic_crypto::RandomU64());
+    InitCommon(now);
+    InstallInitialKeys(m_originalDcid);
+
+    quic_crypto::GenerateKeyPair(m_ephemeral);
+    if (resumption && !resumption->ticket.empty()) {
+        m_resumptionIn = *resumption;
+        m_peerStreamWindow = resumption->peer_stream_window;
+    }
+    BuildClientHello();
+
+    if (m_resumptionIn) {
+        m_earlySecret = EarlySecret(m_resumptionIn->secret);
+        const QuicSecret hello_hash = quic_crypto::Sha256(AsBytes(m_clientHello.data()), m_clientHello.size());
+        m_earlySeal.Install(quic_crypto::ExpandLabel(m_earlySecret, "c e traffic", hello_hash), true);
+    }
+}
+
+QuicConnection::QuicConnection(const QuicConfig& config, QuicServerContext& context, const Endpoint& client,
+                               uint64_t original_dcid, Clock::time_point now)
+    : m_config(config), m_role(Role::Server), m_serverContext(&context) {
+    m_path.peer = client;
+    m_originalDcid = original_dcid;
+    m_localCids.push_back(quic_crypto::RandomU64());
+    InitCommon(now);
+    InstallInitialKeys(original_dcid);
+}
+
+QuicConnection::~QuicConnection() = default;
+
+void QuicConnection::InitCommon(Clock::time_point now) {
+    m_congestionWindow = m_config.initial_window_packets * m_config.max_datagram_size;
+    m_pacerTokens = static_cast<double>(m_congestionWindow);
+    m_pacerLast = now;
+    m_lastReceived = now;
+    m_nextCidSequence = 1;
+    m_payload.reserve(m_config.max_datagram_size);
+    m_packet.reserve(m_config.max_datagram_size);
+}
+
+void QuicConnection::InstallInitialKeys(uint64_t original_dcid) {
+    uint8_t cid[kQuicConnectionIdSize];
+    for (size_t i = 0; i < kQuicConnectionIdSize; ++i) cid[i] = static_cast<uint8_t>(original_dcid >> (56 - 8 * i));
+    const QuicSecret initial = quic_crypto::Extract(kInitialSalt, sizeof(kInitialSalt), cid, sizeof(cid));
+    QuicSecret client_secret{};
+    QuicSecret server_secret{};
+    quic_crypto::ExpandLabel(initial, "client in", nullptr, 0, client_secret.data(), client_secret.size());
+    quic_crypto::ExpandLabel(initial, "server in", nullptr, 0, server_secret.data(), server_secret.size());
+    const bool client = m_role == Role::Client;
+    m_initialSeal.Install(client ? client_secret : server_secret, true);
+    m_initialOpen.Install(client ? server_secret : client_secret, false);
+}
+
+// ClientHello body: ephemeral(32) stream_window(varint) ticket_length(varint) ticket
+void QuicConnection::BuildClientHello() {
+    std::vector<std::byte> body;
+    AppendBytes(body, m_ephemeral.public_key.data(), m_ephemeral.public_key.size());
+    quic_wire::WriteVarint(body, m_config.stream_receive_window);
+    const size_t ticket_size = m_resumptionIn ? m_resumptionIn->ticket.size() : 0;
+    quic_wire::WriteVarint(body, ticket_size);
+    if (ticket_size) body.insert(body.end(), m_resumptionIn->ticket.begin(), m_resumptionIn->ticket.end());
+    m_clientHello = MakeHandshakeMessage(kClientHello, body);
+
+    auto& crypto = m_spaces[kInitialSpace].crypto_send;
+    crypto.buffer.insert(crypto.buffer.end(), m_clientHello.begin(), m_clientHello.end());
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// Receive path
+
+void QuicConnection::OnDatagram(const std::byte* data, size_t size, const Endpoint& from, Clock::time_point now,
+                                const EventSink& events) {
+    std::unique_lock lock(m_mutex);
+    if (m_state != QuicConnectionState::Closed) {
+        m_stats.bytes_received += size;
+        if (from == m_path.peer) m_path.bytes_received += size;
+
+        size_t offset = 0;
+        while (offset < size && m_state != QuicConnectionState::Closed) {
+            QuicPacketHeader header;
+            if (!quic_wire::DecodeHeader(data + offset, size - offset, header)) {
+                ++m_stats.packets_dropped;
+                break;
+            }
+            ProcessPacketLocked(data + offset, header, from, size, now);
+            offset += header.packet_size;
+        }
+    }
+    DrainEvents(lock, events);
+}
+
+void QuicConnection::ProcessPacketLocked(const std::byte* data, const QuicPacketHeader& header, const Endpoint& from,
+                                         size_t datagram_size, Clock::time_point now) {
+    SpaceId space_id = kAppSpace;
+    QuicPacketProtection* open = &m_appOpen;
+    if (header.type == QuicPacketType::Initial) {
+        space_id = kInitialSpace;
+        open = &m_initialOpen;
+    } else if (header.type == QuicPacketType::ZeroRtt) {
+        if (m_role != Role::Server) open = nullptr;
+        else open = &m_earlyOpen;
+    }
+    PacketSpace& space = m_spaces[space_id];
+
+    bool cid_known = std::find(m_localCids.begin(), m_localCids.end(), header.destination_cid) != m_localCids.end();
+    if (!cid_known && m_role == Role::Server && header.type != QuicPacketType::OneRtt) {
+        cid_known = header.destination_cid == m_originalDcid;
+    }
+    if (!open || !open->IsInstalled() || space.discarded || !cid_known ||
+        header.packet_size < header.header_size + QuicPacketProtection::kTagSize) {
+        ++m_stats.packets_dropped;
+        return;
+    }
+
+    const uint64_t expected = space.largest_received ? *space.largest_received + 1 : 0;
+    const uint64_t packet_number = quic_wire::DecodePacketNumber(expected, header.packet_number);
+    const size_t protected_size = header.packet_size - header.header_size;
+    m_plain.resize(protected_size - QuicPacketProtection::kTagSize);
+    if (!open->Open(packet_number, data, header.header_size, data + header.header_size, protected_size,
+                    m_plain.data()) ||
+        !RecordReceivedLocked(space, packet_number, now)) {
+        ++m_stats.packets_dropped;
+        return;
+    }
+
+    ++m_stats.packets_received;
+    m_lastReceived = now;
+    if (header.type != QuicPacketType::OneRtt && !m_peerCidKnown) {
+        m_peerCid = header.source_cid;
+        m_peerCidKnown = true;
+    }
+    const bool is_largest = packet_number == *space.largest_received;
+    // A 1-RTT packet that opened proves the client has the keys; confirming first keeps HandshakeComplete
+    // ahead of the stream data the packet carries
+    if (m_role == Role::Server && header.type == QuicPacketType::OneRtt) OnHandshakeConfirmedLocked();
+    // [SEQUENCE: MVP19-421] Likewise a 0-RTT packet that opened proves the client holds the ticket's resumption
+    // secret, not just the ticket, so the resumed session may start before the handshake is confirmed
+    if (m_role == Role::Server && header.type == QuicPacketType::ZeroRtt && !m_handshakeEventSent) {
+        m_state = QuicConnectionState::Established;
+        m_handshakeEventSent = true;
+        PushEvent(QuicEvent::Type::HandshakeComplete);
+    }
+
+    bool ack_eliciting = false;
+    bool probing_only = true;
+    if (!ProcessFramesLocked(space_id, m_plain.data(), m_plain.size(), from, now, ack_eliciting, probing_only)) {
+        CloseLocked(QuicError::FrameEncodingError, true);
+        return;
+    }
+    if (m_state == QuicConnectionState::Closed) return;
+
+    if (ack_eliciting) {
+        if (space.unacked_eliciting == 0) space.first_unacked_time = now;
+        ++space.unacked_eliciting;
+        space.ack_pending = true;
+    }
+
+    if (m_role == Role::Server && header.type == QuicPacketType::OneRtt && is_largest && !probing_only &&
+        from != m_path.peer) {
+        OnPeerAddressLocked(from, datagram_size);
+    }
+}
+
+bool QuicConnection::ProcessFramesLocked(SpaceId space, const std::byte* data, size_t size, const Endpoint& from,
+                                         Clock::time_point now, bool& ack_eliciting, bool& probing_only) {
+    (void)from;
+    quic_wire::Reader reader(data, size);
+    while (!reader.Empty()) {
+        uint64_t type = 0;
+        if (!reader.Varint(type)) return false;
+        const auto frame = static_cast<QuicFrameType>(type >= 0x08 && type <= 0x0f ? 0x08 : type);
+
+        if (frame != QuicFrameType::Padding && frame != QuicFrameType::Ack &&
+            frame != QuicFrameType::ConnectionClose) {
+            ack_eliciting = true;
+        }
+        if (frame != QuicFrameType::Padding && frame != QuicFrameType::PathChallenge &&
+            frame != QuicFrameType::PathResponse && frame != QuicFrameType::NewConnectionId) {
+            probing_only = false;
+        }
+        if (space == kInitialSpace && frame != QuicFrameType::Padding && frame != QuicFrameType::Ping &&
+            frame != QuicFrameType::Ack && frame != QuicFrameType::Crypto && frame != QuicFrameType::ConnectionClose) {
+            return false;
+        }
+
+        switch (frame) {
+        case QuicFrameType::Padding:
+        case QuicFrameType::Ping:
+            break;
+        case QuicFrameType::Ack:
+            if (!OnAckFrameLocked(space, reader, now)) return false;
+            break;
+        case QuicFrameType::Crypto: {
+            uint64_t offset = 0;
+            uint64_t length = 0;
+            const std::byte* bytes = nullptr;
+            if (!reader.Varint(offset) || !reader.Varint(length) || !reader.Bytes(length, bytes)) return false;
+            if (!OnCryptoFrameLocked(space, offset, bytes, length, now)) return false;
+            break;
+        }
+        case QuicFrameType::NewToken: {
+            uint64_t length = 0;
+            const std::byte* bytes = nullptr;
+            if (m_role != Role::Client || !reader.Varint(length) || length == 0 || !reader.Bytes(length, bytes)) {
+                return false;
+            }
+            QuicResumption resumption;
+            resumption.ticket.assign(bytes, bytes + length);
+            resumption.secret = m_resumptionSecret;
+            resumption.peer_stream_window = m_peerStreamWindow;
+            m_resumptionOut = std::move(resumption);
+            PushEvent(QuicEvent::Type::TicketReceived);
+            break;
+        }
+        case QuicFrameType::Stream: {
+            uint64_t stream_id = 0;
+            uint64_t offset = 0;
+            uint64_t length = 0;
+            const std::byte* bytes = nullptr;
+            if (!reader.Varint(stream_id)) return false;
+            if ((type & 0x04) && !reader.Varint(offset)) return false;
+            if (type & 0x02) {
+                if (!reader.Varint(length)) return false;
+            } else {
+                length = reader.Remaining();
+            }
+            if (!reader.Bytes(length, bytes) || stream_id > kMaxStreamId) return false;
+            if (!OnStreamFrameLocked(stream_id, offset, bytes, length, (type & 0x01) != 0)) return true;
+            break;
+        }
+        case QuicFrameType::MaxStreamData: {
+            uint64_t stream_id = 0;
+            uint64_t limit = 0;
+            if (!reader.Varint(stream_id) || !reader.Varint(limit)) return false;
+            auto it = m_streams.find(stream_id);
+            if (it != m_streams.end()) it->second.send.peer_limit = std::max(it->second.send.peer_limit, limit);
+            break;
+        }
+        case QuicFrameType::NewConnectionId: {
+            uint64_t sequence = 0;
+            uint64_t cid = 0;
+            if (m_role != Role::Client || !reader.Varint(sequence) || !reader.U64(cid)) return false;
+            if (cid != m_peerCid && std::find(m_peerCids.begin(), m_peerCids.end(), cid) == m_peerCids.end()) {
+                m_peerCids.push_back(cid);
+            }
+            break;
+        }
+        case QuicFrameType::PathChallenge: {
+            const std::byte* bytes = nullptr;
+            if (!reader.Bytes(8, bytes)) return false;
+            std::array<std::byte, 8> challenge;
+            std::copy(bytes, bytes + 8, challenge.begin());
+            m_responsesToSend.push_back(challenge);
+            break;
+        }
+        case QuicFrameType::PathResponse: {
+            const std::byte* bytes = nullptr;
+            if (!reader.Bytes(8, bytes)) return false;
+            if (m_challengeOutstanding && std::equal(bytes, bytes + 8, m_challengeOutstanding->begin())) {
+                m_path.validated = true;
+                m_previousPath.reset();
+                m_challengeOutstanding.reset();
+            }
+            break;
+        }
+        case QuicFrameType::ConnectionClose: {
+            uint64_t error = 0;
+            uint64_t frame_type = 0;
+            uint64_t reason_length = 0;
+            const std::byte* reason = nullptr;
+            if (!reader.Varint(error) || !reader.Varint(frame_type) || !reader.Varint(reason_length) ||
+                !reader.Bytes(reason_length, reason)) {
+                return false;
+            }
+            CloseLocked(static_cast<QuicError>(error), false);
+            return true;
+        }
+        case QuicFrameType::HandshakeDone:
+            if (m_role != Role::Client) return false;
+            OnHandshakeConfirmedLocked();
+            break;
+        case QuicFrameType::Datagram: {
+            uint64_t length = 0;
+            const std::byte* bytes = nullptr;
+            if (!reader.Varint(length) || !reader.Bytes(length, bytes)) return false;
+            ++m_stats.datagrams_received;
+            PushEvent(QuicEvent::Type::Datagram, 0, 0, bytes, length);
+            break;
+        }
+        default:
+            return false;
+        }
+        if (m_state == QuicConnectionState::Closed) return true;
+    }
+    return true;
+}
+
+// ACK: largest, delay, range_count, first_range, then (gap, length) pairs, all varints (RFC 9000 §19.3)
+bool QuicConnection::OnAckFrameLocked(SpaceId space_id, quic_wire::Reader& reader, Clock::time_point now) {
+    uint64_t largest = 0;
+    uint64_t delay = 0;
+    uint64_t range_count = 0;
+    uint64_t first_range = 0;
+    if (!reader.Varint(largest) || !reader.Varint(delay) || !reader.Varint(range_count) ||
+        !reader.Varint(first_range) || first_range > largest) {
+        return false;
+    }
+    PacketSpace& space = m_spaces[space_id];
+    if (largest >= space.next_packet_number) return false;
+
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;   // [low, high], descending
+    ranges.reserve(std::min<uint64_t>(range_count, kMaxAckRanges) + 1);
+    uint64_t low = largest - first_range;
+    ranges.emplace_back(low, largest);
+    for (uint64_t i = 0; i < range_count; ++i) {
+        uint64_t gap = 0;
+        uint64_t length = 0;
+        if (!reader.Varint(gap) || !reader.Varint(length) || low < gap + 2) return false;
+        const uint64_t high = low - gap - 2;
+        if (high < length) return false;
+        low = high - length;
+        ranges.emplace_back(low, high);
+    }
+
+    bool largest_newly_acked = false;
+    Clock::time_point largest_sent_time{};
+    std::vector<uint64_t> acked;
+    for (const auto& [range_low, range_high] : ranges) {
+        for (auto it = space.sent.lower_bound(range_low); it != space.sent.end() && it->first <= range_high; ++it) {
+            acked.push_back(it->first);
+            if (it->first == largest) {
+                largest_newly_acked = true;
+                largest_sent_time = it->second.time_sent;
+            }
+        }
+    }
+    if (acked.empty()) return true;
+
+    if (!space.largest_acked || largest > *space.largest_acked) space.largest_acked = largest;
+    if (largest_newly_acked) {
+        UpdateRttLocked(now - largest_sent_time, std::chrono::microseconds(delay << 3), space_id == kAppSpace);
+    }
+    for (uint64_t packet_number : acked) {
+        auto it = space.sent.find(packet_number);
+        OnPacketAckedLocked(it->second);
+        space.sent.erase(it);
+    }
+    DetectLossLocked(space_id, now);
+    m_ptoCount = 0;
+    m_probesPending = 0;
+    return true;
+}
+
+bool QuicConnection::OnStreamFrameLocked(uint64_t stream_id, uint64_t offset, const std::byte* data, size_t size,
+                                         bool fin) {
+    bool limit_exceeded = false;
+    StreamState* stream = GetOrCreateStream(stream_id, limit_exceeded);
+    if (!stream) {
+        CloseLocked(QuicError::StreamLimitError, true);
+        return false;
+    }
+    RecvStreamState& recv = stream->recv;
+    const uint64_t end = offset + size;
+    if (end > recv.limit) {
+        CloseLocked(QuicError::FlowControlError, true);
+        return false;
+    }
+    if ((recv.final_size && (end > *recv.final_size || (fin && end != *recv.final_size))) ||
+        (fin && end < recv.delivered)) {
+        CloseLocked(QuicError::ProtocolViolation, true);
+        return false;
+    }
+    if (fin) recv.final_size = end;
+    InsertSegment(recv, offset, data, size);
+    DeliverStreamLocked(stream_id, recv);
+    return true;
+}
+
+bool QuicConnection::OnCryptoFrameLocked(SpaceId space_id, uint64_t offset, const std::byte* data, size_t size,
+                                         Clock::time_point now) {
+    if (offset + size > kMaxCryptoBytes) return false;
+    RecvStreamState& recv = m_spaces[space_id].crypto_recv;
+    InsertSegment(recv, offset, data, size);
+    DrainContiguous(recv, m_cryptoIn);
+
+    if (m_cryptoIn.size() < 3) return true;
+    const uint8_t type = std::to_integer<uint8_t>(m_cryptoIn[0]);
+    const size_t length = (std::to_integer<size_t>(m_cryptoIn[1]) << 8) | std::to_integer<size_t>(m_cryptoIn[2]);
+    if (m_cryptoIn.size() < 3 + length) return true;
+
+    bool ok = false;
+    if (m_role == Role::Server && type == kClientHello && !m_appSeal.IsInstalled()) {
+        ok = OnClientHelloLocked(m_cryptoIn.data(), 3 + length, now);
+    } else if (m_role == Role::Client && type == kServerHello && !m_appSeal.IsInstalled()) {
+        ok = OnServerHelloLocked(m_cryptoIn.data(), 3 + length);
+    } else {
+        return false;
+    }
+    m_cryptoIn.clear();
+    if (!ok) CloseLocked(QuicError::CryptoError, true);
+    return true;
+}
+
+bool QuicConnection::OnClientHelloLocked(const std::byte* data, size_t size, Clock::time_point now) {
+    quic_wire::Reader reader(data + 3, size - 3);
+    const std::byte* ephemeral = nullptr;
+    uint64_t window = 0;
+    uint64_t ticket_size = 0;
+    const std::byte* ticket = nullptr;
+    if (!reader.Bytes(32, ephemeral) || !reader.Varint(window) || !reader.Varint(ticket_size) ||
+        !reader.Bytes(ticket_size, ticket) || !reader.Empty()) {
+        return false;
+    }
+    m_clientHello.assign(data, data + size);
+    m_peerStreamWindow = window;
+
+    QuicPublicKey client_ephemeral;
+    std::memcpy(client_ephemeral.data(), ephemeral, client_ephemeral.size());
+
+    std::optional<QuicSecret> early_secret;
+    if (ticket_size > 0) {
+        QuicTicket redeemed;
+        if (m_serverContext->RedeemTicket(ticket, ticket_size, now, redeemed) ==
+            QuicServerContext::TicketResult::Accepted) {
+            early_secret = EarlySecret(redeemed.resumption_secret);
+            m_resumed = true;
+            m_zeroRttAccepted = true;
+            m_resumedPlayerId = redeemed.player_id;
+            const QuicSecret hello_hash = quic_crypto::Sha256(AsBytes(data), size);
+            m_earlyOpen.Install(quic_crypto::ExpandLabel(*early_secret, "c e traffic", hello_hash), false);
+        }
+    }
+
+    QuicSecret static_shared{};
+    QuicSecret ephemeral_shared{};
+    if (!quic_crypto::GenerateKeyPair(m_ephemeral) ||
+        !quic_crypto::Dh(m_serverContext->GetStaticKey().private_key, client_ephemeral, static_shared) ||
+        !quic_crypto::Dh(m_ephemeral.private_key, client_ephemeral, ephemeral_shared)) {
+        return false;
+    }
+
+    // ServerHello body: ephemeral(32) stream_window(varint) flags(1)
+    std::vector<std::byte> body;
+    AppendBytes(body, m_ephemeral.public_key.data(), m_ephemeral.public_key.size());
+    quic_wire::WriteVarint(body, m_config.stream_receive_window);
+    body.push_back(static_cast<std::byte>(m_zeroRttAccepted ? kHelloFlagResumed : 0));
+    const std::vector<std::byte> server_hello = MakeHandshakeMessage(kServerHello, body);
+
+    const QuicSecret transcript = TranscriptHash(m_clientHello, server_hello);
+    const QuicSecret master = MasterSecret(static_shared, ephemeral_shared, early_secret ? &*early_secret : nullptr);
+    m_appSeal.Install(quic_crypto::ExpandLabel(master, "s ap traffic", transcript), true);
+    m_appOpen.Install(quic_crypto::ExpandLabel(master, "c ap traffic", transcript), false);
+    m_resumptionSecret = quic_crypto::ExpandLabel(master, "res master", transcript);
+
+    auto& crypto = m_spaces[kInitialSpace].crypto_send;
+    crypto.buffer.insert(crypto.buffer.end(), server_hello.begin(), server_hello.end());
+    // Redeeming the ticket proves nothing about the sender: anyone who saw it on the wire can replay it. The
+    // connection completes on the first 0-RTT or 1-RTT packet that opens (see ProcessPacketLocked).
+    return true;
+}
+
+bool QuicConnection::OnServerHelloLocked(const std::byte* data, size_t size) {
+    quic_wire::Reader reader(data + 3, size - 3);
+    const std::byte* ephemeral = nullptr;
+    uint64_t window = 0;
+    uint8_t flags = 0;
+    if (!reader.Bytes(32, ephemeral) || !reader.Varint(window) || !reader.U8(flags) || !reader.Empty()) return false;
+
+    QuicPublicKey server_ephemeral;
+    std::memcpy(server_ephemeral.data(), ephemeral, server_ephemeral.size());
+    QuicSecret static_shared{};
+    QuicSecret ephemeral_shared{};
+    if (!quic_crypto::Dh(m_ephemeral.private_key, m_serverStaticKey, static_shared) ||
+        !quic_crypto::Dh(m_ephemeral.private_key, server_ephemeral, ephemeral_shared)) {
+        return false;
+    }
+
+    const bool accepted = m_resumptionIn && (flags & kHelloFlagResumed);
+    const std::vector<std::byte> server_hello(data, data + size);
+    const QuicSecret transcript = TranscriptHash(m_clientHello, server_hello);
+    const QuicSecret master = MasterSecret(static_shared, ephemeral_shared, accepted ? &m_earlySecret : nullptr);
+    m_appSeal.Install(quic_crypto::ExpandLabel(master, "c ap traffic", transcript), true);
+    m_appOpen.Install(quic_crypto::ExpandLabel(master, "s ap traffic", transcript), false);
+    m_resumptionSecret = quic_crypto::ExpandLabel(master, "res master", transcript);
+
+    m_peerStreamWindow = window;
+    for (auto& [stream_id, stream] : m_streams) stream.send.peer_limit = window;
+
+    if (m_resumptionIn && !accepted) {
+        // The server discarded our 0-RTT packets: everything they carried goes out again under 1-RTT keys
+        PacketSpace& app = m_spaces[kAppSpace];
+        for (auto& [packet_number, packet] : app.sent) {
+            m_bytesInFlight -= packet.size;
+            RequeueFramesLocked(packet.frames);
+        }
+        app.sent.clear();
+        app.loss_time.reset();
+    }
+    m_earlySeal.Reset();
+    m_resumed = accepted;
+    m_zeroRttAccepted = accepted;
+
+    // Something must go out under 1-RTT keys promptly: it is what confirms the handshake to the server
+    m_pingPending = true;
+    m_state = QuicConnectionState::Established;
+    m_handshakeEventSent = true;
+    PushEvent(QuicEvent::Type::HandshakeComplete);
+    return true;
+}
+
+void QuicConnection::OnHandshakeConfirmedLocked() {
+    if (m_handshakeConfirmed) return;
+    m_handshakeConfirmed = true;
+    DiscardSpaceLocked(kInitialSpace);
+
+    if (m_role == Role::Server) {
+        m_earlyOpen.Reset();
+        m_path.validated = true;
+        m_handshakeDonePending = true;
+        for (size_t i = 0; i < m_config.extra_connection_ids; ++i) {
+            const uint64_t cid = quic_crypto::RandomU64();
+            m_localCids.push_back(cid);
+            m_cidsToAdvertise.push_back(m_localCids.size() - 1);
+            PushEvent(QuicEvent::Type::ConnectionIdIssued, cid);
+        }
+        if (!m_handshakeEventSent) {
+            m_state = QuicConnectionState::Established;
+            m_handshakeEventSent = true;
+            PushEvent(QuicEvent::Type::HandshakeComplete);
+        }
+    }
+}
+
+// The newest non-probing packet came from somewhere else: follow it, but challenge the new path and keep
+// within the amplification limit until it answers
+void QuicConnection::OnPeerAddressLocked(const Endpoint& from, size_t datagram_size) {
+    const bool same_address = from.address() == m_path.peer.address();
+    if (m_path.validated) m_previousPath = m_path;
+    m_path = Path{from, false, datagram_size, 0};
+
+    if (same_address) {
+        ++m_stats.rebindings;
+    } else {
+        ++m_stats.migrations;
+        ResetRecoveryLocked();
+    }
+
+    std::array<std::byte, 8> challenge;
+    quic_crypto::RandomBytes(reinterpret_cast<uint8_t*>(challenge.data()), challenge.size());
+    m_challengeToSend = challenge;
+    m_challengeOutstanding.reset();
+    PushEvent(QuicEvent::Type::PathChanged, same_address ? 0 : 1);
+}
+
+// Returns false for a duplicate, or for a packet too old to tell
+bool QuicConnection::RecordReceivedLocked(PacketSpace& space, uint64_t packet_number, Clock::time_point now) {
+    auto& ranges = space.received;
+    for (const auto& [low, high] : ranges) {
+        if (packet_number >= low && packet_number <= high) return false;
+    }
+    if (ranges.size() >= kMaxAckRanges && packet_number < ranges.back().first) return false;
+
+    auto it = std::find_if(ranges.begin(), ranges.end(),
+                           [packet_number](const auto& range) { return range.second < packet_number; });
+    it = ranges.insert(it, {packet_number, packet_number});
+    // Merge with the neighbours, which sit above (lower index) and below (higher index)
+    const size_t index = static_cast<size_t>(it - ranges.begin());
+    if (index + 1 < ranges.size() && ranges[index + 1].second + 1 == packet_number) {
+        ranges[index].first = ranges[index + 1].first;
+        ranges.erase(ranges.begin() + static_cast<std::ptrdiff_t>(index + 1));
+    }
+    if (index > 0 && ranges[index - 1].first == packet_number + 1) {
+        ranges[index - 1].first = ranges[index].first;
+        ranges.erase(ranges.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+    if (ranges.size() > kMaxAckRanges) ranges.pop_back();
+
+    if (!space.largest_received || packet_number > *space.largest_received) {
+        space.largest_received = packet_number;
+        space.largest_received_time = now;
+    }
+    return true;
+}
+
+bool QuicConnection::InsertSegment(RecvStreamState& recv, uint64_t offset, const std::byte* data, size_t size) {
+    const uint64_t end = offset + size;
+    if (end <= recv.delivered) return false;
+    if (offset < recv.delivered) {
+        data += recv.delivered - offset;
+        offset = recv.delivered;
+    }
+    auto& segment = recv.pending[offset];
+    if (segment.size() < end - offset) segment.assign(data, data + (end - offset));
+    return true;
+}
+
+void QuicConnection::DrainContiguous(RecvStreamState& recv, std::vector<std::byte>& out) {
+    while (!recv.pending.empty() && recv.pending.begin()->first <= recv.delivered) {
+        auto it = recv.pending.begin();
+        const uint64_t skip = recv.delivered - it->first;
+        if (skip < it->second.size()) {
+            out.insert(out.end(), it->second.begin() + static_cast<std::ptrdiff_t>(skip), it->second.end());
+            recv.delivered = it->first + it->second.size();
+        }
+        recv.pending.erase(it);
+    }
+}
+
+void QuicConnection::DeliverStreamLocked(uint64_t stream_id, RecvStreamState& recv) {
+    PendingEvent pending;
+    DrainContiguous(recv, pending.bytes);
+    const bool fin = recv.final_size && recv.delivered == *recv.final_size && !recv.fin_delivered;
+    if (pending.bytes.empty() && !fin) return;
+    if (fin) recv.fin_delivered = true;
+
+    m_stats.stream_bytes_delivered += pending.bytes.size();
+    pending.event.type = QuicEvent::Type::StreamData;
+    pending.event.stream_id = stream_id;
+    pending.event.fin = fin;
+    m_events.push_back(std::move(pending));
+
+    const uint64_t window = m_config.stream_receive_window;
+    if (!recv.final_size && recv.limit - recv.delivered < window / 2) {
+        recv.limit = recv.delivered + window;
+        recv.limit_pending = true;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// Send path
+
+void QuicConnection::Flush(Clock::time_point now, const DatagramSink& sink) {
+    std::lock_guard lock(m_mutex);
+    FlushLocked(now, sink);
+}
+
+void QuicConnection::FlushLocked(Clock::time_point now, const DatagramSink& sink) {
+    if (m_state == QuicConnectionState::Closed) {
+        if (m_closePending) SendCloseLocked(sink);
+        return;
+    }
+    const bool app_keys = m_appSeal.IsInstalled() || m_earlySeal.IsInstalled();
+    // Bounded so one flush cannot monopolise a worker; the pacer and cwnd normally stop it much earlier
+    for (size_t packets = 0; packets < 256; ++packets) {
+        bool sent = false;
+        PacketSpace& initial = m_spaces[kInitialSpace];
+        if (!initial.discarded && (AckDue(initial, now) || HasEliciting(kInitialSpace))) {
+            sent = SendPacketLocked(kInitialSpace, now, sink);
+        }
+        PacketSpace& app = m_spaces[kAppSpace];
+        if (!sent && app_keys && (AckDue(app, now) || HasEliciting(kAppSpace))) {
+            sent = SendPacketLocked(kAppSpace, now, sink);
+        }
+        if (!sent) break;
+    }
+}
+
+bool QuicConnection::SendPacketLocked(SpaceId space_id, Clock::time_point now, const DatagramSink& sink) {
+    PacketSpace& space = m_spaces[space_id];
+    const bool zero_rtt = space_id == kAppSpace && !m_appSeal.IsInstalled();
+    if (zero_rtt && (m_role != Role::Client || !m_earlySeal.IsInstalled())) return false;
+    QuicPacketProtection& seal = space_id == kInitialSpace ? m_initialSeal : zero_rtt ? m_earlySeal : m_appSeal;
+    const bool long_header = space_id == kInitialSpace || zero_rtt;
+    const size_t header_size = long_header ? kQuicLongHeaderSize : kQuicShortHeaderSize;
+
+    size_t datagram_limit = m_config.max_datagram_size;
+    if (m_role == Role::Server && !m_path.validated) {
+        const uint64_t budget = 3 * m_path.bytes_received;
+        const uint64_t available = budget > m_path.bytes_sent ? budget - m_path.bytes_sent : 0;
+        if (available < header_size + QuicPacketProtection::kTagSize + 32) return false;
+        datagram_limit = static_cast<size_t>(std::min<uint64_t>(datagram_limit, available));
+    }
+    const size_t capacity = datagram_limit - header_size - QuicPacketProtection::kTagSize;
+
+    const bool has_eliciting = HasEliciting(space_id);
+    bool eliciting_allowed = false;
+    if (has_eliciting) {
+        if (m_probesPending > 0) {
+            eliciting_allowed = true;
+        } else if (m_bytesInFlight + m_config.max_datagram_size <= m_congestionWindow) {
+            eliciting_allowed = PacerAllowsLocked(now, m_config.max_datagram_size);
+            if (!eliciting_allowed) ++m_stats.pacing_waits;
+        }
+    }
+    const bool ack_due = AckDue(space, now);
+    if (!ack_due && !eliciting_allowed) return false;
+
+    m_payload.clear();
+    std::vector<SentFrame> frames;
+    bool ack_written = false;
+    bool eliciting = false;
+    if (space.ack_pending || ack_due) ack_written = WriteAckFrameLocked(space, now, capacity);
+
+    if (eliciting_allowed) {
+        if (space_id == kInitialSpace) {
+            eliciting |= WriteCryptoFrameLocked(space, capacity, frames);
+        } else {
+            if (m_handshakeDonePending && m_role == Role::Server && !zero_rtt) {
+                WriteFrameType(m_payload, QuicFrameType::HandshakeDone);
+                frames.push_back({FrameKind::HandshakeDone});
+                m_handshakeDonePending = false;
+                eliciting = true;
+            }
+            if (m_ticketPending && !zero_rtt && m_payload.size() + 3 + m_ticketToSend.size() <= capacity) {
+                WriteFrameType(m_payload, QuicFrameType::NewToken);
+                quic_wire::WriteVarint(m_payload, m_ticketToSend.size());
+                m_payload.insert(m_payload.end(), m_ticketToSend.begin(), m_ticketToSend.end());
+                frames.push_back({FrameKind::NewToken});
+                m_ticketPending = false;
+                eliciting = true;
+            }
+            while (!m_cidsToAdvertise.empty() && !zero_rtt && m_payload.size() + 20 <= capacity) {
+                const size_t index = m_cidsToAdvertise.back();
+                m_cidsToAdvertise.pop_back();
+                WriteFrameType(m_payload, QuicFrameType::NewConnectionId);
+                quic_wire::WriteVarint(m_payload, index);
+                quic_wire::WriteU64(m_payload, m_localCids[index]);
+                frames.push_back({FrameKind::NewConnectionId, 0, index});
+                eliciting = true;
+            }
+            if (m_challengeToSend && !zero_rtt && m_payload.size() + 9 <= capacity) {
+                WriteFrameType(m_payload, QuicFrameType::PathChallenge);
+                m_payload.insert(m_payload.end(), m_challengeToSend->begin(), m_challengeToSend->end());
+                m_challengeOutstanding = m_challengeToSend;
+                m_challengeToSend.reset();
+                m_challengeSentAt = now;
+                eliciting = true;
+            }
+            while (!m_responsesToSend.empty() && !zero_rtt && m_payload.size() + 9 <= capacity) {
+                WriteFrameType(m_payload, QuicFrameType::PathResponse);
+                m_payload.insert(m_payload.end(), m_responsesToSend.back().begin(), m_responsesToSend.back().end());
+                m_responsesToSend.pop_back();
+                eliciting = true;
+            }
+            for (auto& [stream_id, stream] : m_streams) {
+                if (!stream.recv.limit_pending || zero_rtt || m_payload.size() + 17 > capacity) continue;
+                WriteFrameType(m_payload, QuicFrameType::MaxStreamData);
+                quic_wire::WriteVarint(m_payload, stream_id);
+                quic_wire::WriteVarint(m_payload, stream.recv.limit);
+                frames.push_back({FrameKind::MaxStreamData, stream_id});
+                stream.recv.limit_pending = false;
+                eliciting = true;
+            }
+            // Datagrams go ahead of stream data: they carry the freshest, most latency-sensitive state
+            while (!m_datagrams.empty()) {
+                const auto& datagram = m_datagrams.front();
+                if (m_payload.size() + 1 + quic_wire::VarintSize(datagram.size()) + datagram.size() > capacity) break;
+                WriteFrameType(m_payload, QuicFrameType::Datagram);
+                quic_wire::WriteVarint(m_payload, datagram.size());
+                m_payload.insert(m_payload.end(), datagram.begin(), datagram.end());
+                m_datagrams.pop_front();
+                ++m_stats.datagrams_sent;
+                eliciting = true;
+            }
+            eliciting |= WriteStreamFramesLocked(capacity, frames);
+        }
+        if (!eliciting && (m_probesPending > 0 || (m_pingPending && space_id == kAppSpace && !zero_rtt))) {
+            WriteFrameType(m_payload, QuicFrameType::Ping);
+            eliciting = true;
+        }
+        if (space_id == kAppSpace && !zero_rtt) m_pingPending = false;
+    }
+    if (m_payload.empty()) return false;
+
+    // Every client datagram carrying an Initial is padded to the minimum, which is what lets the server answer
+    // before the path is validated
+    if (space_id == kInitialSpace && m_role == Role::Client) m_payload.resize(capacity, std::byte{0});
+    // The AEAD needs a few bytes of payload beyond the packet number for a short packet to be well formed
+    if (m_payload.size() < 4) m_payload.resize(4, std::byte{0});
+
+    const uint64_t packet_number = space.next_packet_number++;
+    m_packet.clear();
+    const uint64_t destination = m_peerCid;
+    if (long_header) {
+        quic_wire::WriteLongHeader(m_packet, space_id == kInitialSpace ? QuicPacketType::Initial : QuicPacketType::ZeroRtt,
+                                   destination, m_localCids.front(), static_cast<uint32_t>(packet_number));
+        quic_wire::PatchLongHeaderLength(m_packet, 0, m_payload.size() + QuicPacketProtection::kTagSize);
+    } else {
+        quic_wire::WriteShortHeader(m_packet, destination, static_cast<uint32_t>(packet_number));
+    }
+    m_packet.resize(header_size + m_payload.size() + QuicPacketProtection::kTagSize);
+    if (!seal.Seal(packet_number, m_packet.data(), header_size, m_payload.data(), m_payload.size(),
+                   m_packet.data() + header_size)) {
+        CloseLocked(QuicError::InternalError, false);
+        return false;
+    }
+    sink(m_path.peer, m_packet.data(), m_packet.size());
+
+    ++m_stats.packets_sent;
+    m_stats.bytes_sent += m_packet.size();
+    m_path.bytes_sent += m_packet.size();
+    if (ack_written) {
+        space.ack_pending = false;
+        space.unacked_eliciting = 0;
+    }
+    if (eliciting) {
+        SentPacket& sent = space.sent[packet_number];
+        sent.time_sent = now;
+        sent.size = m_packet.size();
+        sent.zero_rtt = zero_rtt;
+        sent.frames = std::move(frames);
+        m_bytesInFlight += m_packet.size();
+        space.last_ack_eliciting_sent = now;
+        if (m_probesPending > 0) {
+            --m_probesPending;
+        } else {
+            m_pacerTokens -= static_cast<double>(m_packet.size());
+        }
+    }
+    return true;
+}
+
+bool QuicConnection::WriteAckFrameLocked(PacketSpace& space, Clock::time_point now, size_t capacity) {
+    const auto& ranges = space.received;
+    if (ranges.empty()) return false;
+    const size_t start = m_payload.size();
+    const auto delay = std::chrono::duration_cast<std::chrono::microseconds>(now - space.largest_received_time);
+
+    WriteFrameType(m_payload, QuicFrameType::Ack);
+    quic_wire::WriteVarint(m_payload, ranges[0].second);
+    quic_wire::WriteVarint(m_payload, static_cast<uint64_t>(std::max<int64_t>(delay.count(), 0)) >> 3);
+    quic_wire::WriteVarint(m_payload, ranges.size() - 1);
+    quic_wire::WriteVarint(m_payload, ranges[0].second - ranges[0].first);
+    for (size_t i = 1; i < ranges.size(); ++i) {
+        quic_wire::WriteVarint(m_payload, ranges[i - 1].first - ranges[i].second - 2);
+        quic_wire::WriteVarint(m_payload, ranges[i].second - ranges[i].first);
+    }
+    if (m_payload.size() > capacity) {
+        m_payload.resize(start);
+        return false;
+    }
+    return true;
+}
+
+bool QuicConnection::NextSendRange(const SendStreamState& send, uint64_t max_length, uint64_t& offset,
+                                   uint64_t& length, bool& retransmit) {
+    if (!send.lost.empty()) {
+        offset = send.lost.begin()->first;
+        length = std::min(send.lost.begin()->second - offset, max_length);
+        retransmit = true;
+        return true;
+    }
+    retransmit = false;
+    offset = send.next_offset;
+    const uint64_t limit = std::min(send.End(), send.peer_limit);
+    length = limit > offset ? std::min(limit - offset, max_length) : 0;
+    return length > 0 || (send.fin && send.next_offset == send.End() && (!send.fin_sent || send.fin_lost));
+}
+
+void QuicConnection::CopySendBytes(const SendStreamState& send, uint64_t offset, uint64_t length,
+                                   std::vector<std::byte>& out) {
+    const auto begin = send.buffer.begin() + static_cast<std::ptrdiff_t>(offset - send.acked_base);
+    out.insert(out.end(), begin, begin + static_cast<std::ptrdiff_t>(length));
+}
+
+bool QuicConnection::StreamHasData(const SendStreamState& send) {
+    if (!send.lost.empty()) return true;
+    if (send.next_offset < std::min(send.End(), send.peer_limit)) return true;
+    return send.fin && send.next_offset == send.End() && (!send.fin_sent || send.fin_lost);
+}
+
+// Round-robin, one frame per stream per pass, so a bulk stream cannot starve the others of a packet
+bool QuicConnection::WriteStreamFramesLocked(size_t capacity, std::vector<SentFrame>& frames) {
+    bool wrote = false;
+    bool progress = true;
+    while (progress && m_payload.size() + kStreamFrameOverhead < capacity) {
+        progress = false;
+        auto it = m_streams.lower_bound(m_streamCursor);
+        for (size_t visited = 0; visited < m_streams.size(); ++visited, ++it) {
+            if (it == m_streams.end()) it = m_streams.begin();
+            if (m_payload.size() + kStreamFrameOverhead >= capacity) break;
+            auto& [stream_id, stream] = *it;
+            SendStreamState& send = stream.send;
+            if (!StreamHasData(send)) continue;
+
+            const uint64_t room = capacity - m_payload.size() - kStreamFrameOverhead;
+            uint64_t offset = 0;
+            uint64_t length = 0;
+            bool retransmit = false;
+            if (!NextSendRange(send, room, offset, length, retransmit)) continue;
+            const bool fin = send.fin && offset + length == send.End() && !send.fin_acked;
+
+            WriteFrameType(m_payload, static_cast<QuicFrameType>(0x08 | 0x04 | 0x02 | (fin ? 0x01 : 0x00)));
+            quic_wire::WriteVarint(m_payload, stream_id);
+            quic_wire::WriteVarint(m_payload, offset);
+            quic_wire::WriteVarint(m_payload, length);
+            CopySendBytes(send, offset, length, m_payload);
+            frames.push_back({FrameKind::Stream, stream_id, offset, length, fin});
+
+            if (retransmit) {
+                RemoveRange(send.lost, offset, offset + length);
+                m_stats.stream_bytes_retransmitted += length;
+            } else {
+                send.next_offset = offset + length;
+            }
+            if (fin) {
+                send.fin_sent = true;
+                send.fin_lost = false;
+            }
+            m_stats.stream_bytes_sent += length;
+            m_streamCursor = stream_id + 1;
+            wrote = true;
+            progress = true;
+        }
+    }
+    return wrote;
+}
+
+bool QuicConnection::WriteCryptoFrameLocked(PacketSpace& space, size_t capacity, std::vector<SentFrame>& frames) {
+    bool wrote = false;
+    SendStreamState& send = space.crypto_send;
+    while (m_payload.size() + kStreamFrameOverhead < capacity) {
+        uint64_t offset = 0;
+        uint64_t length = 0;
+        bool retransmit = false;
+        if (!NextSendRange(send, capacity - m_payload.size() - kStreamFrameOverhead, offset, length, retransmit) ||
+            length == 0) {
+            break;
+        }
+        WriteFrameType(m_payload, QuicFrameType::Crypto);
+        quic_wire::WriteVarint(m_payload, offset);
+        quic_wire::WriteVarint(m_payload, length);
+        CopySendBytes(send, offset, length, m_payload);
+        frames.push_back({FrameKind::Crypto, 0, offset, length});
+        if (retransmit) {
+            RemoveRange(send.lost, offset, offset + length);
+        } else {
+            send.next_offset = offset + length;
+        }
+        wrote = true;
+    }
+    return wrote;
+}
+
+bool QuicConnection::HasSendableStreamData() const {
+    return std::any_of(m_streams.begin(), m_streams.end(),
+                       [](const auto& entry) { return StreamHasData(entry.second.send); });
+}
+
+bool QuicConnection::HasEliciting(SpaceId space_id) const {
+    const PacketSpace& space = m_spaces[space_id];
+    if (space.discarded) return false;
+    if (m_probesPending > 0 && !space.sent.empty()) return true;
+    if (space_id == kInitialSpace) return StreamHasData(space.crypto_send);
+
+    const bool one_rtt = m_appSeal.IsInstalled();
+    if (one_rtt && (m_handshakeDonePending || m_ticketPending || !m_cidsToAdvertise.empty() || m_challengeToSend ||
+                    !m_responsesToSend.empty() || m_pingPending)) {
+        return true;
+    }
+    if (one_rtt && std::any_of(m_streams.begin(), m_streams.end(),
+                               [](const auto& entry) { return entry.second.recv.limit_pending; })) {
+        return true;
+    }
+    return !m_datagrams.empty() || HasSendableStreamData();
+}
+
+bool QuicConnection::AckDue(const PacketSpace& space, Clock::time_point now) const {
+    if (!space.ack_pending || space.discarded) return false;
+    if (&space == &m_spaces[kInitialSpace]) return true;
+    return space.unacked_eliciting >= 2 || now - space.first_unacked_time >= m_config.max_ack_delay;
+}
+
+void QuicConnection::SendCloseLocked(const DatagramSink& sink) {
+    m_closePending = false;
+    const bool one_rtt = m_appSeal.IsInstalled();
+    if (!one_rtt && !m_initialSeal.IsInstalled()) return;
+
+    m_payload.clear();
+    WriteFrameType(m_payload, QuicFrameType::ConnectionClose);
+    quic_wire::WriteVarint(m_payload, static_cast<uint64_t>(m_closeError));
+    quic_wire::WriteVarint(m_payload, 0);
+    quic_wire::WriteVarint(m_payload, 0);
+    if (!one_rtt && m_role == Role::Client) m_payload.resize(m_config.max_datagram_size - kQuicLongHeaderSize -
+                                                             QuicPacketProtection::kTagSize, std::byte{0});
+
+    PacketSpace& space = m_spaces[one_rtt ? kAppSpace : kInitialSpace];
+    const uint64_t packet_number = space.next_packet_number++;
+    const size_t header_size = one_rtt ? kQuicShortHeaderSize : kQuicLongHeaderSize;
+    m_packet.clear();
+    if (one_rtt) {
+        quic_wire::WriteShortHeader(m_packet, m_peerCid, static_cast<uint32_t>(packet_number));
+    } else {
+        quic_wire::WriteLongHeader(m_packet, QuicPacketType::Initial, m_peerCid, m_localCids.front(),
+                                   static_cast<uint32_t>(packet_number));
+        quic_wire::PatchLongHeaderLength(m_packet, 0, m_payload.size() + QuicPacketProtection::kTagSize);
+    }
+    m_packet.resize(header_size + m_payload.size() + QuicPacketProtection::kTagSize);
+    QuicPacketProtection& seal = one_rtt ? m_appSeal : m_initialSeal;
+    if (seal.Seal(packet_number, m_packet.data(), header_size, m_payload.data(), m_payload.size(),
+                  m_packet.data() + header_size)) {
+        sink(m_path.peer, m_packet.data(), m_packet.size());
+        ++m_stats.packets_sent;
+        m_stats.bytes_sent += m_packet.size();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// Recovery
+
+void QuicConnection::OnPacketAckedLocked(const SentPacket& packet) {
+    m_bytesInFlight -= std::min(m_bytesInFlight, packet.size);
+    for (const SentFrame& frame : packet.frames) {
+        if (frame.kind == FrameKind::Stream) {
+            auto it = m_streams.find(frame.stream_id);
+            if (it == m_streams.end()) continue;
+            AckSendRange(it->second.send, frame.offset, frame.offset + frame.length);
+            if (frame.fin) {
+                it->second.send.fin_acked = true;
+                it->second.send.fin_lost = false;
+            }
+        } else if (frame.kind == FrameKind::Crypto && !m_spaces[kInitialSpace].discarded) {
+            AckSendRange(m_spaces[kInitialSpace].crypto_send, frame.offset, frame.offset + frame.length);
+        }
+    }
+
+    // NewReno: no growth for packets sent before the current recovery period started
+    if (m_recoveryStart && packet.time_sent <= *m_recoveryStart) return;
+    if (m_congestionWindow < m_ssthresh) {
+        m_congestionWindow += packet.size;
+    } else {
+        m_congestionWindow += m_config.max_datagram_size * packet.size / m_congestionWindow;
+    }
+}
+
+void QuicConnection::OnPacketLostLocked(const SentPacket& packet) {
+    m_bytesInFlight -= std::min(m_bytesInFlight, packet.size);
+    ++m_stats.packets_lost;
+    RequeueFramesLocked(packet.frames);
+}
+
+void QuicConnection::RequeueFramesLocked(const std::vector<SentFrame>& frames) {
+    auto requeue_range = [](SendStreamState& send, uint64_t start, uint64_t end) {
+        start = std::max(start, send.acked_base);
+        if (start >= end) return;
+        AddRange(send.lost, start, end);
+        for (auto it = send.acked.lower_bound(start); it != send.acked.end() && it->first < end; ++it) {
+            RemoveRange(send.lost, it->first, it->second);
+        }
+        // An acked range that starts before start can still overlap it
+        auto before = send.acked.upper_bound(start);
+        if (before != send.acked.begin()) {
+            --before;
+            if (before->second > start) RemoveRange(send.lost, start, before->second);
+        }
+    };
+
+    for (const SentFrame& frame : frames) {
+        switch (frame.kind) {
+        case FrameKind::Stream: {
+            auto it = m_streams.find(frame.stream_id);
+            if (it == m_streams.end()) break;
+            SendStreamState& send = it->second.send;
+            requeue_range(send, frame.offset, frame.offset + frame.length);
+            if (frame.fin && !send.fin_acked) send.fin_lost = true;
+            break;
+        }
+        case FrameKind::Crypto:
+            if (!m_spaces[kInitialSpace].discarded) {
+                requeue_range(m_spaces[kInitialSpace].crypto_send, frame.offset, frame.offset + frame.length);
+            }
+            break;
+        case FrameKind::HandshakeDone:
+            m_handshakeDonePending = true;
+            break;
+        case FrameKind::NewToken:
+            m_ticketPending = !m_ticketToSend.empty();
+            break;
+        case FrameKind::NewConnectionId:
+            m_cidsToAdvertise.push_back(static_cast<size_t>(frame.offset));
+            break;
+        case FrameKind::MaxStreamData: {
+            auto it = m_streams.find(frame.stream_id);
+            if (it != m_streams.end()) it->second.recv.limit_pending = true;
+            break;
+        }
+        }
+    }
+}
+
+// Packet threshold 3, time threshold 9/8 RTT (RFC 9002 §6.1)
+void QuicConnection::DetectLossLocked(SpaceId space_id, Clock::time_point now) {
+    PacketSpace& space = m_spaces[space_id];
+    space.loss_time.reset();
+    if (!space.largest_acked) return;
+
+    const Clock::duration rtt = m_hasRtt ? std::max(m_latestRtt, m_srtt) : Clock::duration(m_config.initial_rtt);
+    const Clock::duration loss_delay = std::max<Clock::duration>(rtt * 9 / 8, 1ms);
+    const Clock::time_point lost_before = now - loss_delay;
+
+    std::optional<Clock::time_point> latest_lost;
+    for (auto it = space.sent.begin(); it != space.sent.end() && it->first < *space.largest_acked;) {
+        if (it->second.time_sent <= lost_before || *space.largest_acked >= it->first + kPacketThreshold) {
+            if (!latest_lost || it->second.time_sent > *latest_lost) latest_lost = it->second.time_sent;
+            OnPacketLostLocked(it->second);
+            it = space.sent.erase(it);
+        } else {
+            const Clock::time_point when = it->second.time_sent + loss_delay;
+            if (!space.loss_time || when < *space.loss_time) space.loss_time = when;
+            ++it;
+        }
+    }
+    if (latest_lost) OnCongestionEventLocked(*latest_lost, now);
+}
+
+void QuicConnection::OnCongestionEventLocked(Clock::time_point time_sent, Clock::time_point now) {
+    if (m_recoveryStart && time_sent <= *m_recoveryStart) return;
+    m_recoveryStart = now;
+    ++m_stats.congestion_events;
+    const size_t minimum = m_config.minimum_window_packets * m_config.max_datagram_size;
+    m_ssthresh = std::max(m_congestionWindow / 2, minimum);
+    m_congestionWindow = m_ssthresh;
+}
+
+void QuicConnection::UpdateRttLocked(Clock::duration latest, Clock::duration ack_delay, bool app_space) {
+    m_latestRtt = latest;
+    if (!m_hasRtt) {
+        m_hasRtt = true;
+        m_minRtt = latest;
+        m_srtt = latest;
+        m_rttVar = latest / 2;
+        return;
+    }
+    m_minRtt = std::min(m_minRtt, latest);
+    ack_delay = app_space ? std::min<Clock::duration>(ack_delay, m_config.max_ack_delay) : Clock::duration::zero();
+    Clock::duration adjusted = latest;
+    if (latest >= m_minRtt + ack_delay) adjusted = latest - ack_delay;
+    const Clock::duration deviation = m_srtt > adjusted ? m_srtt - adjusted : adjusted - m_srtt;
+    m_rttVar = (m_rttVar * 3 + deviation) / 4;
+    m_srtt = (m_srtt * 7 + adjusted) / 8;
+}
+
+QuicConnection::Clock::duration QuicConnection::PtoLocked(bool app_space) const {
+    const Clock::duration srtt = m_hasRtt ? m_srtt : Clock::duration(m_config.initial_rtt);
+    const Clock::duration rttvar = m_hasRtt ? m_rttVar : Clock::duration(m_config.initial_rtt) / 2;
+    Clock::duration pto = srtt + std::max<Clock::duration>(rttvar * 4, 1ms);
+    if (app_space && m_handshakeConfirmed) pto += m_config.max_ack_delay;
+    return pto;
+}
+
+// No ack within the probe timeout: resend the oldest packet's contents in up to two probes that bypass cwnd
+void QuicConnection::OnPtoLocked(SpaceId space_id) {
+    PacketSpace& space = m_spaces[space_id];
+    ++m_ptoCount;
+    ++m_stats.pto_count;
+    m_probesPending = kMaxProbes;
+    if (!space.sent.empty()) RequeueFramesLocked(space.sent.begin()->second.frames);
+}
+
+void QuicConnection::DiscardSpaceLocked(SpaceId space_id) {
+    PacketSpace& space = m_spaces[space_id];
+    if (space.discarded) return;
+    for (const auto& [packet_number, packet] : space.sent) {
+        m_bytesInFlight -= std::min(m_bytesInFlight, packet.size);
+    }
+    space.sent.clear();
+    space.loss_time.reset();
+    space.ack_pending = false;
+    space.crypto_send = SendStreamState{};
+    space.crypto_recv = RecvStreamState{};
+    space.discarded = true;
+    if (space_id == kInitialSpace) {
+        m_initialSeal.Reset();
+        m_initialOpen.Reset();
+    }
+    m_ptoCount = 0;
+}
+
+void QuicConnection::ResetRecoveryLocked() {
+    m_hasRtt = false;
+    m_latestRtt = m_minRtt = m_srtt = m_rttVar = Clock::duration::zero();
+    m_congestionWindow = m_config.initial_window_packets * m_config.max_datagram_size;
+    m_ssthresh = SIZE_MAX;
+    m_recoveryStart.reset();
+    m_pacerTokens = static_cast<double>(m_congestionWindow);
+    m_ptoCount = 0;
+}
+
+bool QuicConnection::PacerAllowsLocked(Clock::time_point now, size_t size) {
+    if (!m_config.pacing) return true;
+    const double burst = static_cast<double>(
+        std::min(m_congestionWindow, m_config.initial_window_packets * m_config.max_datagram_size));
+    if (now > m_pacerLast) {
+        m_pacerTokens = std::min(burst, m_pacerTokens + PacingRateLocked() * Seconds(now - m_pacerLast));
+        m_pacerLast = now;
+    }
+    return m_pacerTokens >= static_cast<double>(size);
+}
+
+double QuicConnection::PacingRateLocked() const {
+    const Clock::duration srtt = m_hasRtt ? m_srtt : Clock::duration(m_config.initial_rtt);
+    return 1.25 * static_cast<double>(m_congestionWindow) / std::max(Seconds(srtt), 1e-6);
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// Timers
+
+void QuicConnection::Update(Clock::time_point now, const DatagramSink& sink, const EventSink& events) {
+    std::unique_lock lock(m_mutex);
+    if (m_state != QuicConnectionState::Closed && now - m_lastReceived > m_config.idle_timeout) {
+        CloseLocked(QuicError::NoError, false);
+    }
+    if (m_state != QuicConnectionState::Closed) {
+        for (size_t id = 0; id < kSpaceCount; ++id) {
+            const PacketSpace& space = m_spaces[id];
+            if (!space.discarded && space.loss_time && now >= *space.loss_time) {
+                DetectLossLocked(static_cast<SpaceId>(id), now);
+            }
+        }
+
+        const uint32_t backoff = 1u << std::min<uint32_t>(m_ptoCount, 10);
+        for (size_t id = 0; id < kSpaceCount; ++id) {
+            const PacketSpace& space = m_spaces[id];
+            if (space.discarded || space.sent.empty()) continue;
+            if (now >= space.last_ack_eliciting_sent + PtoLocked(id == kAppSpace) * backoff) {
+                OnPtoLocked(static_cast<SpaceId>(id));
+                break;
+            }
+        }
+
+        // An unanswered challenge means the new address is not the peer after all: go back to the old path
+        if (m_challengeOutstanding && now - m_challengeSentAt > PtoLocked(true) * 3) {
+            m_challengeOutstanding.reset();
+            if (m_previousPath) {
+                m_path = *m_previousPath;
+                m_previousPath.reset();
+            } else {
+                quic_crypto::RandomBytes(reinterpret_cast<uint8_t*>(m_challengeToSend.emplace().data()), 8);
+            }
+        }
+    }
+    FlushLocked(now, sink);
+    DrainEvents(lock, events);
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// Application interface
+
+bool QuicConnection::SendStream(uint64_t stream_id, const std::byte* data, size_t size, bool fin) {
+    std::lock_guard lock(m_mutex);
+    if (m_state == QuicConnectionState::Closed || stream_id > kMaxStreamId) return false;
+    if (!m_appSeal.IsInstalled() && !(m_role == Role::Client && m_earlySeal.IsInstalled())) return false;
+
+    bool limit_exceeded = false;
+    StreamState* stream = GetOrCreateStream(stream_id, limit_exceeded);
+    if (!stream) return false;
+    SendStreamState& send = stream->send;
+    if (send.fin || send.buffer.size() + size > m_config.max_stream_send_buffer) return false;
+    send.buffer.insert(send.buffer.end(), data, data + size);
+    send.fin = fin;
+    return true;
+}
+
+bool QuicConnection::SendDatagram(const std::byte* data, size_t size) {
+    std::lock_guard lock(m_mutex);
+    if (m_state == QuicConnectionState::Closed) return false;
+    if (!m_appSeal.IsInstalled() && !(m_role == Role::Client && m_earlySeal.IsInstalled())) return false;
+    const size_t room = m_config.max_datagram_size - kQuicLongHeaderSize - QuicPacketProtection::kTagSize;
+    if (1 + quic_wire::VarintSize(size) + size > room) return false;
+
+    if (m_datagrams.size() >= m_config.max_queued_datagrams) {
+        m_datagrams.pop_front();
+        ++m_stats.datagrams_dropped;
+    }
+    m_datagrams.emplace_back(data, data + size);
+    return true;
+}
+
+void QuicConnection::Close(QuicError error) {
+    std::lock_guard lock(m_mutex);
+    CloseLocked(error, true);
+}
+
+bool QuicConnection::IssueTicket(uint64_t player_id, Clock::time_point now) {
+    std::lock_guard lock(m_mutex);
+    if (m_role != Role::Server || m_state == QuicConnectionState::Closed || !m_appSeal.IsInstalled()) return false;
+    QuicTicket ticket;
+    ticket.resumption_secret = m_resumptionSecret;
+    ticket.player_id = player_id;
+    ticket.issued_at_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    m_ticketToSend = m_serverContext->SealTicket(ticket);
+    m_ticketPending = !m_ticketToSend.empty();
+    return m_ticketPending;
+}
+
+bool QuicConnection::IsResumed() const {
+    std::lock_guard lock(m_mutex);
+    return m_resumed;
+}
+
+uint64_t QuicConnection::GetResumedPlayerId() const {
+    std::lock_guard lock(m_mutex);
+    return m_resumedPlayerId;
+}
+
+bool QuicConnection::RotateConnectionId() {
+    std::lock_guard lock(m_mutex);
+    if (m_role != Role::Client || m_peerCidIndex >= m_peerCids.size()) return false;
+    m_peerCid = m_peerCids[m_peerCidIndex++];
+    return true;
+}
+
+std::optional<QuicResumption> QuicConnection::GetResumption() const {
+    std::lock_guard lock(m_mutex);
+    return m_resumptionOut;
+}
+
+QuicConnectionState QuicConnection::GetState() const {
+    std::lock_guard lock(m_mutex);
+    return m_state;
+}
+
+QuicConnection::Endpoint QuicConnection::GetPeerEndpoint() const {
+    std::lock_guard lock(m_mutex);
+    return m_path.peer;
+}
+
+std::vector<uint64_t> QuicConnection::GetLocalConnectionIds() const {
+    std::lock_guard lock(m_mutex);
+    return m_localCids;
+}
+
+QuicConnectionStats QuicConnection::GetStats() const {
+    std::lock_guard lock(m_mutex);
+    QuicConnectionStats stats = m_stats;
+    stats.resumed = m_resumed;
+    stats.zero_rtt_accepted = m_zeroRttAccepted;
+    stats.congestion_window = m_congestionWindow;
+    stats.bytes_in_flight = m_bytesInFlight;
+    stats.srtt_ms = std::chrono::duration<double, std::milli>(m_srtt).count();
+    stats.min_rtt_ms = std::chrono::duration<double, std::milli>(m_minRtt).count();
+    stats.pacing_rate_bytes_per_s = PacingRateLocked();
+    return stats;
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// Helpers
+
+void QuicConnection::CloseLocked(QuicError error, bool send_close) {
+    if (m_state == QuicConnectionState::Closed) return;
+    m_state = QuicConnectionState::Closed;
+    m_closePending = send_close;
+    m_closeError = error;
+    PushEvent(QuicEvent::Type::Closed, static_cast<uint64_t>(error));
+}
+
+void QuicConnection::PushEvent(QuicEvent::Type type, uint64_t value, uint64_t stream_id, const std::byte* data,
+                               size_t size, bool fin) {
+    PendingEvent pending;
+    pending.event.type = type;
+    pending.event.value = value;
+    pending.event.stream_id = stream_id;
+    pending.event.fin = fin;
+    if (size) pending.bytes.assign(data, data + size);
+    m_events.push_back(std::move(pending));
+}
+
+void QuicConnection::DrainEvents(std::unique_lock<std::mutex>& lock, const EventSink& events) {
+    if (m_events.empty()) return;
+    std::vector<PendingEvent> pending;
+    pending.swap(m_events);
+    lock.unlock();
+    if (!events) return;
+    for (PendingEvent& entry : pending) {
+        entry.event.data = entry.bytes.data();
+        entry.event.size = entry.bytes.size();
+        events(entry.event);
+    }
+}
+
+QuicConnection::StreamState* QuicConnection::GetOrCreateStream(uint64_t stream_id, bool& limit_exceeded) {
+    auto it = m_streams.find(stream_id);
+    if (it != m_streams.end()) return &it->second;
+    if (m_streams.size() >= m_config.max_streams) {
+        limit_exceeded = true;
+        return nullptr;
+    }
+    StreamState& stream = m_streams[stream_id];
+    stream.send.peer_limit = m_peerStreamWindow;
+    stream.recv.limit = m_config.stream_receive_window;
+    return &stream;
+}
+
+void QuicConnection::AddRange(RangeSet& set, uint64_t start, uint64_t end) {
+    if (start >= end) return;
+    auto it = set.upper_bound(start);
+    if (it != set.begin()) {
+        auto previous = std::prev(it);
+        if (previous->second >= start) {
+            start = previous->first;
+            end = std::max(end, previous->second);
+            it = set.erase(previous);
+        }
+    }
+    while (it != set.end() && it->first <= end) {
+        end = std::max(end, it->second);
+        it = set.erase(it);
+    }
+    set.emplace(start, end);
+}
+
+void QuicConnection::RemoveRange(RangeSet& set, uint64_t start, uint64_t end) {
+    if (start >= end) return;
+    auto it = set.upper_bound(start);
+    if (it != set.begin()) --it;
+    while (it != set.end() && it->first < end) {
+        const uint64_t range_start = it->first;
+        const uint64_t range_end = it->second;
+        if (range_end <= start) {
+            ++it;
+            continue;
+        }
+        it = set.erase(it);
+        if (range_start < start) set.emplace(range_start, start);
+        if (range_end > end) {
+            set.emplace(end, range_end);
+            break;
+        }
+    }
+}
+
+// Marks [start, end) acknowledged and releases the buffer up to the first byte still unacknowledged
+void QuicConnection::AckSendRange(SendStreamState& send, uint64_t start, uint64_t end) {
+    start = std::max(start, send.acked_base);
+    if (start >= end) return;
+    AddRange(send.acked, start, end);
+    RemoveRange(send.lost, start, end);
+    auto first = send.acked.begin();
+    if (first != send.acked.end() && first->first <= send.acked_base) {
+        const uint64_t release = first->second - send.acked_base;
+        send.buffer.erase(send.buffer.begin(), send.buffer.begin() + static_cast<std::ptrdiff_t>(release));
+        send.acked_base = first->second;
+        send.acked.erase(first);
+    }
+}
+
+} // namespace mmorpg::network
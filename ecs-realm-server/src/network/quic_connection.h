@@ -0,0 +1,406 @@
+#pragma once
+
+#include "network/quic_crypto.h"
+#include "network/quic_wire.h"
+
+#include <boost/asio/ip/udp.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-266] Tuning for one QUIC connection. Recovery constants follow RFC 9002.
+struct QuicConfig {
+    size_t max_datagram_size = 1200;
+    std::chrono::milliseconds idle_timeout{30000};
+    std::chrono::milliseconds max_ack_delay{25};
+    std::chrono::milliseconds initial_rtt{333};
+    size_t initial_window_packets = 10;
+    size_t minimum_window_packets = 2;
+    uint64_t stream_receive_window = 256 * 1024;   // Per stream; advertised to the peer in the handshake
+    size_t max_stream_send_buffer = 1024 * 1024;   // Unacked bytes per stream before SendStream refuses more
+    size_t max_streams = 32;
+    size_t max_queued_datagrams = 64;              // Oldest queued DATAGRAM is dropped beyond this
+    size_t extra_connection_ids = 2;               // Spare ids the server issues for the client to migrate to
+    bool pacing = true;
+};
+
+// [SEQUENCE: MVP19-267] What a client keeps between connections to resume with 0-RTT.
+struct QuicResumption {
+    std::vector<std::byte> ticket;
+    QuicSecret secret{};
+    uint64_t peer_stream_window = 0;   // The server's stream window from last time, so 0-RTT data can be sized
+};
+
+enum class QuicConnectionState : uint8_t {
+    Handshaking,
+    Established,   // Keys agreed; application data flows both ways
+    Closed,
+};
+
+// [SEQUENCE: MVP19-268] Something the application must act on. data points into connection-owned memory and is
+// only valid for the duration of the callback.
+struct QuicEvent {
+    enum class Type : uint8_t {
+        HandshakeComplete,
+        StreamData,         // In order per stream; fin marks the end of the stream
+        Datagram,
+        TicketReceived,     // Client: GetResumption() now has a ticket
+        ConnectionIdIssued, // Server: value is a new local id the endpoint must route to this connection
+        PathChanged,        // Server: value is 1 for a migration to a new address, 0 for a NAT rebinding
+        Closed,             // value is the error code
+    };
+
+    Type type = Type::StreamData;
+    uint64_t stream_id = 0;
+    uint64_t value = 0;
+    bool fin = false;
+    const std::byte* data = nullptr;
+    size_t size = 0;
+};
+
+struct QuicConnectionStats {
+    uint64_t packets_sent = 0;
+    uint64_t packets_received = 0;
+    uint64_t packets_lost = 0;
+    uint64_t packets_dropped = 0;       // Undecryptable, duplicate or for a discarded key phase
+    uint64_t bytes_sent = 0;
+    uint64_t bytes_received = 0;
+    uint64_t stream_bytes_sent = 0;     // Retransmissions included
+    uint64_t stream_bytes_retransmitted = 0;
+    uint64_t stream_bytes_delivered = 0;
+    uint64_t datagrams_sent = 0;
+    uint64_t datagrams_received = 0;
+    uint64_t datagrams_dropped = 0;     // Queue overflow on the send side
+    uint64_t pto_count = 0;
+    uint64_t congestion_events = 0;
+    uint64_t pacing_waits = 0;          // Flushes that stopped with data ready because the pacer had no budget
+    uint64_t migrations = 0;
+    uint64_t rebindings = 0;
+    bool resumed = false;
+    bool zero_rtt_accepted = false;
+    size_t congestion_window = 0;
+    size_t bytes_in_flight = 0;
+    double srtt_ms = 0.0;
+    double min_rtt_ms = 0.0;
+    double pacing_rate_bytes_per_s = 0.0;
+};
+
+// [SEQUENCE: MVP19-269] One QUIC connection, client or server, with no I/O of its own: datagrams go in through
+// OnDatagram, come out through the sink passed to Flush/Update, and the caller supplies the clock.
+//
+// Handshake. There is no TLS 1.3 stack with a QUIC interface to build on here (OpenSSL 3.0), so the CRYPTO
+// stream carries a compact X25519 exchange in the shape of Noise NK: the client knows the server's long-term
+// public key, and the 1-RTT secrets mix DH(client ephemeral, server static) with DH(client ephemeral, server
+// ephemeral), so only the real server can complete it and the keys are forward secret. Traffic secrets are
+// expanded with the TLS 1.3 labels over a hash of both hellos, and packets are sealed with AES-128-GCM exactly as
+// RFC 9001 derives them. Initial packets use keys derived from the client's first destination id, which, as in
+// QUIC, only guards against off-path tampering.
+//
+// Resumption. The server can hand the client a ticket (NEW_TOKEN) sealing the resumption secret and the
+// player's identity. A client reconnecting with it sends application data in 0-RTT packets right behind its
+// first Initial, and the server delivers that data as soon as the first flight lands. A ticket is redeemed once,
+// so a replayed first flight falls back to a full handshake and its 0-RTT data is discarded; the client then
+// resends it as ordinary 1-RTT data.
+//
+// Streams. Every stream is reliable and ordered on its own, with its own retransmission ranges and flow-control
+// window, so a loss on one stream never holds back delivery on another. DATAGRAM frames are sent once and
+// never retransmitted.
+//
+// Paths. Packets are routed by connection id, not by address. When the server sees the newest packet arrive from
+// a new address it moves to that address at once, challenges it, and holds sends to three times what it has
+// received there until the challenge is answered. A new port on the same address is a NAT rebinding and keeps
+// the congestion state; a new address starts congestion control and RTT estimation over.
+//
+// Recovery follows RFC 9002: packet- and time-threshold loss detection, PTO probes and NewReno. Sends are paced
+// at 1.25 x cwnd / srtt, with bursts of up to the initial window.
+//
+// Thread-safe: every public method takes the connection lock. Datagram sinks are invoked with it held and must
+// not call back into the connection; event sinks are invoked after it has been released.
+class QuicConnection {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Endpoint = boost::asio::ip::udp::endpoint;
+    using DatagramSink = std::function<void(const Endpoint& to, const std::byte* data, size_t size)>;
+    using EventSink = std::function<void(const QuicEvent& event)>;
+
+    enum class Role : uint8_t { Client, Server };
+
+    // Client. Pass the ticket from an earlier connection to this server to attempt 0-RTT.
+    QuicConnection(const QuicConfig& config, const QuicPublicKey& server_key, const Endpoint& server,
+                   Clock::time_point now, const QuicResumption* resumption = nullptr);
+    // Server, for a client Initial addressed to original_dcid
+    QuicConnection(const QuicConfig& config, QuicServerContext& context, const Endpoint& client,
+                   uint64_t original_dcid, Clock::time_point now);
+    ~QuicConnection();
+
+    QuicConnection(const QuicConnection&) = delete;
+    QuicConnection& operator=(const QuicConnection&) = delete;
+
+    void OnDatagram(const std::byte* data, size_t size, const Endpoint& from, Clock::time_point now,
+                    const EventSink& events);
+    // Runs loss, PTO, path and idle timers, then flushes. Call every few milliseconds.
+    void Update(Clock::time_point now, const DatagramSink& sink, const EventSink& events);
+    // Sends whatever congestion control and pacing allow right now
+    void Flush(Clock::time_point now, const DatagramSink& sink);
+
+    // Queues bytes on a stream. Returns false once the connection is closed, the stream's unacked bytes would
+    // exceed max_stream_send_buffer, a new stream would exceed max_streams, or (client) before keys exist to send it.
+    bool SendStream(uint64_t stream_id, const std::byte* data, size_t size, bool fin = false);
+    // Queues an unreliable datagram. Returns false if it cannot fit in one packet or nothing can be sent yet.
+    bool SendDatagram(const std::byte* data, size_t size);
+    // Sends CONNECTION_CLOSE on the next flush and stops the connection
+    void Close(QuicError error = QuicError::NoError);
+
+    // Server: seals a resumption ticket for player_id and sends it to the client
+    bool IssueTicket(uint64_t player_id, Clock::time_point now);
+    bool IsResumed() const;
+    uint64_t GetResumedPlayerId() const;
+
+    // Client: moves to an unused server-issued connection id, so a new network path is not linkable to the old
+    // one. Returns false if none is left.
+    bool RotateConnectionId();
+    std::optional<QuicResumption> GetResumption() const;
+
+    Role GetRole() const { return m_role; }
+    QuicConnectionState GetState() const;
+    Endpoint GetPeerEndpoint() const;
+    std::vector<uint64_t> GetLocalConnectionIds() const;
+    QuicConnectionStats GetStats() const;
+
+private:
+    enum SpaceId : size_t { kInitialSpace = 0, kAppSpace = 1, kSpaceCount = 2 };
+
+    // Byte ranges [start, end) keyed by start, kept merged
+    using RangeSet = std::map<uint64_t, uint64_t>;
+
+    struct SendStreamState {
+        std::deque<std::byte> buffer;   // Bytes [acked_base, acked_base + buffer.size())
+        uint64_t acked_base = 0;
+        uint64_t next_offset = 0;       // First byte never sent
+        RangeSet lost;
+        RangeSet acked;                 // Above acked_base
+        uint64_t peer_limit = UINT64_MAX;
+        bool fin = false;
+        bool fin_sent = false;
+        bool fin_acked = false;
+        bool fin_lost = false;
+
+        uint64_t End() const { return acked_base + buffer.size(); }
+    };
+
+    struct RecvStreamState {
+        uint64_t delivered = 0;
+        std::map<uint64_t, std::vector<std::byte>> pending;   // Out-of-order segments by offset
+        uint64_t limit = 0;             // Highest offset the peer may send up to
+        std::optional<uint64_t> final_size;
+        bool fin_delivered = false;
+        bool limit_pending = false;     // A MAX_STREAM_DATA is owed
+    };
+
+    struct StreamState {
+        SendStreamState send;
+        RecvStreamState recv;
+    };
+
+    enum class FrameKind : uint8_t { Stream, Crypto, HandshakeDone, NewToken, NewConnectionId, MaxStreamData };
+
+    // What a packet carried that must be resent if it is lost
+    struct SentFrame {
+        FrameKind kind = FrameKind::Stream;
+        uint64_t stream_id = 0;
+        uint64_t offset = 0;
+        uint64_t length = 0;
+        bool fin = false;
+    };
+
+    struct SentPacket {
+        Clock::time_point time_sent;
+        size_t size = 0;
+        bool zero_rtt = false;
+        std::vector<SentFrame> frames;
+    };
+
+    struct PacketSpace {
+        uint64_t next_packet_number = 0;
+        std::map<uint64_t, SentPacket> sent;   // Ack-eliciting packets in flight
+        std::optional<uint64_t> largest_acked;
+        Clock::time_point last_ack_eliciting_sent{};
+        std::optional<Clock::time_point> loss_time;
+
+        std::vector<std::pair<uint64_t, uint64_t>> received;   // [low, high], descending, bounded
+        std::optional<uint64_t> largest_received;
+        Clock::time_point largest_received_time{};
+        bool ack_pending = false;
+        size_t unacked_eliciting = 0;
+        Clock::time_point first_unacked_time{};
+
+        SendStreamState crypto_send;
+        RecvStreamState crypto_recv;
+        bool discarded = false;
+    };
+
+    struct Path {
+        Endpoint peer;
+        bool validated = false;
+        uint64_t bytes_received = 0;
+        uint64_t bytes_sent = 0;
+    };
+
+    struct PendingEvent {
+        QuicEvent event;
+        std::vector<std::byte> bytes;
+    };
+
+    void InitCommon(Clock::time_point now);
+    void InstallInitialKeys(uint64_t original_dcid);
+    void BuildClientHello();
+
+    // Receive path
+    void ProcessPacketLocked(const std::byte* data, const QuicPacketHeader& header, const Endpoint& from,
+                             size_t datagram_size, Clock::time_point now);
+    bool ProcessFramesLocked(SpaceId space, const std::byte* data, size_t size, const Endpoint& from,
+                             Clock::time_point now, bool& ack_eliciting, bool& probing_only);
+    bool OnAckFrameLocked(SpaceId space, quic_wire::Reader& reader, Clock::time_point now);
+    bool OnStreamFrameLocked(uint64_t stream_id, uint64_t offset, const std::byte* data, size_t size, bool fin);
+    bool OnCryptoFrameLocked(SpaceId space, uint64_t offset, const std::byte* data, size_t size, Clock::time_point now);
+    bool OnClientHelloLocked(const std::byte* data, size_t size, Clock::time_point now);
+    bool OnServerHelloLocked(const std::byte* data, size_t size);
+    void OnHandshakeConfirmedLocked();
+    void OnPeerAddressLocked(const Endpoint& from, size_t datagram_size);
+    bool RecordReceivedLocked(PacketSpace& space, uint64_t packet_number, Clock::time_point now);
+    void DeliverStreamLocked(uint64_t stream_id, RecvStreamState& recv);
+    static bool InsertSegment(RecvStreamState& recv, uint64_t offset, const std::byte* data, size_t size);
+    static void DrainContiguous(RecvStreamState& recv, std::vector<std::byte>& out);
+
+    // Send path
+    void FlushLocked(Clock::time_point now, const DatagramSink& sink);
+    bool SendPacketLocked(SpaceId space, Clock::time_point now, const DatagramSink& sink);
+    bool WriteAckFrameLocked(PacketSpace& space, Clock::time_point now, size_t capacity);
+    bool WriteStreamFramesLocked(size_t capacity, std::vector<SentFrame>& frames);
+    bool WriteCryptoFrameLocked(PacketSpace& space, size_t capacity, std::vector<SentFrame>& frames);
+    // Next range of a send stream to put on the wire: lost bytes first, then new bytes within the peer's limit
+    static bool NextSendRange(const SendStreamState& send, uint64_t max_length, uint64_t& offset, uint64_t& length,
+                              bool& retransmit);
+    static void CopySendBytes(const SendStreamState& send, uint64_t offset, uint64_t length, std::vector<std::byte>& out);
+    static bool StreamHasData(const SendStreamState& send);
+    bool HasEliciting(SpaceId space) const;
+    bool HasSendableStreamData() const;
+    bool AckDue(const PacketSpace& space, Clock::time_point now) const;
+    void SendCloseLocked(const DatagramSink& sink);
+
+    // Recovery
+    void OnPacketAckedLocked(const SentPacket& packet);
+    void OnPacketLostLocked(const SentPacket& packet);
+    void RequeueFramesLocked(const std::vector<SentFrame>& frames);
+    void DetectLossLocked(SpaceId space, Clock::time_point now);
+    void OnCongestionEventLocked(Clock::time_point time_sent, Clock::time_point now);
+    void UpdateRttLocked(Clock::duration latest, Clock::duration ack_delay, bool app_space);
+    Clock::duration PtoLocked(bool app_space) const;
+    void OnPtoLocked(SpaceId space);
+    void DiscardSpaceLocked(SpaceId space);
+    void ResetRecoveryLocked();
+    bool PacerAllowsLocked(Clock::time_point now, size_t size);
+    double PacingRateLocked() const;
+
+    void CloseLocked(QuicError error, bool send_close);
+    void PushEvent(QuicEvent::Type type, uint64_t value = 0, uint64_t stream_id = 0,
+                   const std::byte* data = nullptr, size_t size = 0, bool fin = false);
+    void DrainEvents(std::unique_lock<std::mutex>& lock, const EventSink& events);
+    StreamState* GetOrCreateStream(uint64_t stream_id, bool& limit_exceeded);
+
+    static void AddRange(RangeSet& set, uint64_t start, uint64_t end);
+    static void RemoveRange(RangeSet& set, uint64_t start, uint64_t end);
+    static void AckSendRange(SendStreamState& send, uint64_t start, uint64_t end);
+
+    const QuicConfig m_config;
+    const Role m_role;
+    QuicServerContext* const m_serverContext = nullptr;
+
+    mutable std::mutex m_mutex;
+    QuicConnectionState m_state = QuicConnectionState::Handshaking;
+    bool m_handshakeConfirmed = false;
+    bool m_handshakeEventSent = false;
+    bool m_closePending = false;
+    QuicError m_closeError = QuicError::NoError;
+
+    // Connection ids
+    uint64_t m_originalDcid = 0;
+    std::vector<uint64_t> m_localCids;            // Front is the one put in long headers
+    std::vector<uint64_t> m_peerCids;             // Server-issued ids a client may move to
+    size_t m_peerCidIndex = 0;
+    uint64_t m_peerCid = 0;
+    bool m_peerCidKnown = false;
+    std::vector<uint64_t> m_cidsToAdvertise;      // Indices into m_localCids
+    uint64_t m_nextCidSequence = 0;
+
+    // Handshake
+    QuicKeyPair m_ephemeral;
+    QuicPublicKey m_serverStaticKey{};
+    std::vector<std::byte> m_clientHello;
+    std::optional<QuicResumption> m_resumptionIn;    // Client: ticket being used
+    std::optional<QuicResumption> m_resumptionOut;   // Client: ticket received on this connection
+    QuicSecret m_resumptionSecret{};
+    QuicSecret m_earlySecret{};
+    bool m_resumed = false;
+    bool m_zeroRttAccepted = false;
+    uint64_t m_resumedPlayerId = 0;
+    uint64_t m_peerStreamWindow = 0;
+    std::vector<std::byte> m_ticketToSend;
+    bool m_ticketPending = false;
+    bool m_handshakeDonePending = false;
+    bool m_pingPending = false;
+    std::vector<std::byte> m_cryptoIn;   // Contiguous CRYPTO bytes received so far
+
+    QuicPacketProtection m_initialSeal;
+    QuicPacketProtection m_initialOpen;
+    QuicPacketProtection m_earlySeal;     // Client 0-RTT
+    QuicPacketProtection m_earlyOpen;     // Server 0-RTT
+    QuicPacketProtection m_appSeal;
+    QuicPacketProtection m_appOpen;
+
+    std::array<PacketSpace, kSpaceCount> m_spaces;
+    std::map<uint64_t, StreamState> m_streams;
+    uint64_t m_streamCursor = 0;                    // Round-robin position among streams with data
+    std::deque<std::vector<std::byte>> m_datagrams;
+
+    // Paths
+    Path m_path;
+    std::optional<Path> m_previousPath;
+    std::optional<std::array<std::byte, 8>> m_challengeToSend;
+    std::optional<std::array<std::byte, 8>> m_challengeOutstanding;
+    Clock::time_point m_challengeSentAt{};
+    std::vector<std::array<std::byte, 8>> m_responsesToSend;
+
+    // Recovery and congestion control
+    bool m_hasRtt = false;
+    Clock::duration m_latestRtt{};
+    Clock::duration m_minRtt{};
+    Clock::duration m_srtt{};
+    Clock::duration m_rttVar{};
+    uint32_t m_ptoCount = 0;
+    size_t m_probesPending = 0;
+    size_t m_bytesInFlight = 0;
+    size_t m_congestionWindow = 0;
+    size_t m_ssthresh = SIZE_MAX;
+    std::optional<Clock::time_point> m_recoveryStart;
+    double m_pacerTokens = 0.0;
+    Clock::time_point m_pacerLast{};
+    Clock::time_point m_lastReceived{};
+
+    std::vector<std::byte> m_payload;   // Frames of the packet being built
+    std::vector<std::byte> m_packet;    // Header + sealed payload
+    std::vector<std::byte> m_plain;     // Opened payload of the packet being processed
+    std::vector<PendingEvent> m_events;
+    QuicConnectionStats m_stats;
+};
+
+} // namespace mmorpg::network
@@ -0,0 +1,278 @@
+#include "network/quic_crypto.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+
+namespace mmorpg::network {
+
+namespace quic_crypto {
+
+namespace {
+
+struct PkeyDeleter {
+    void operator()(EVP_PKEY* key) const { EVP_PKEY_free(key); }
+};
+struct PkeyContextDeleter {
+    void operator()(EVP_PKEY_CTX* context) const { EVP_PKEY_CTX_free(context); }
+};
+using PkeyPtr = std::unique_ptr<EVP_PKEY, PkeyDeleter>;
+using PkeyContextPtr = std::unique_ptr<EVP_PKEY_CTX, PkeyContextDeleter>;
+
+} // namespace
+
+bool GenerateKeyPair(QuicKeyPair& out) {
+    RandomBytes(out.private_key.data(), out.private_key.size());
+    return DerivePublicKey(out.private_key, out.public_key);
+}
+
+bool DerivePublicKey(const QuicSecret& private_key, QuicPublicKey& public_key) {
+    PkeyPtr key(EVP_PKEY_new_raw_private_key(EVP_PKEY_X25519, nullptr, private_key.data(), private_key.size()));
+    size_t size = public_key.size();
+    return key && EVP_PKEY_get_raw_public_key(key.get(), public_key.data(), &size) == 1 && size == public_key.size();
+}
+
+bool Dh(const QuicSecret& private_key, const QuicPublicKey& peer_public, QuicSecret& shared) {
+    PkeyPtr key(EVP_PKEY_new_raw_private_key(EVP_PKEY_X25519, nullptr, private_key.data(), private_key.size()));
+    PkeyPtr peer(EVP_PKEY_new_raw_public_key(EVP_PKEY_X25519, nullptr, peer_public.data(), peer_public.size()));
+    if (!key || !peer) return false;
+    PkeyContextPtr context(EVP_PKEY_CTX_new(key.get(), nullptr));
+    size_t size = shared.size();
+    // Derive fails on a low-order peer point (all-zero output), which rejects small-subgroup keys
+    return context && EVP_PKEY_derive_init(context.get()) == 1 &&
+           EVP_PKEY_derive_set_peer(context.get(), peer.get()) == 1 &&
+           EVP_PKEY_derive(context.get(), shared.data(), &size) == 1 && size == shared.size();
+}
+
+QuicSecret Sha256(const uint8_t* data, size_t size) {
+    QuicSecret digest{};
+    unsigned int length = 0;
+    EVP_Digest(data, size, digest.data(), &length, EVP_sha256(), nullptr);
+    return digest;
+}
+
+QuicSecret HmacSha256(const uint8_t* key, size_t key_size, const uint8_t* data, size_t size) {
+    QuicSecret mac{};
+    unsigned int length = 0;
+    HMAC(EVP_sha256(), key, static_cast<int>(key_size), data, size, mac.data(), &length);
+    return mac;
+}
+
+QuicSecret Extract(const uint8_t* salt, size_t salt_size, const uint8_t* ikm, size_t ikm_size) {
+    static const uint8_t kZeroSalt[32] = {};
+    if (salt_size == 0) {
+        salt = kZeroSalt;
+        salt_size = sizeof(kZeroSalt);
+    }
+    QuicSecret prk{};
+    unsigned int length = 0;
+    HMAC(EVP_sha256(), salt, static_cast<int>(salt_size), ikm, ikm_size, prk.data(), &length);
+    return prk;
+}
+
+// HkdfLabel = length(2) || "tls13 " + label (1-byte length) || context (1-byte length), per RFC 8446 §7.1
+void ExpandLabel(const QuicSecret& prk, std::string_view label, const uint8_t* context, size_t context_size,
+                 uint8_t* out, size_t out_size) {
+    static constexpr std::string_view kPrefix = "tls13 ";
+    std::vector<uint8_t> info;
+    info.reserve(4 + kPrefix.size() + label.size() + context_size);
+    info.push_back(static_cast<uint8_t>(out_size >> 8));
+    info.push_back(static_cast<uint8_t>(out_size));
+    info.push_back(static_cast<uint8_t>(kPrefix.size() + label.size()));
+    info.insert(info.end(), kPrefix.begin(), kPrefix.end());
+    info.insert(info.end(), label.begin(), label.end());
+    info.push_back(static_cast<uint8_t>(context_size));
+    info.insert(info.end(), context, context + context_size);
+
+    uint8_t block[32];
+    size_t produced = 0;
+    for (uint8_t counter = 1; produced < out_size; ++counter) {
+        std::vector<uint8_t> input;
+        if (counter > 1) input.insert(input.end(), block, block + sizeof(block));
+        input.insert(input.end(), info.begin(), info.end());
+        input.push_back(counter);
+        unsigned int length = 0;
+        HMAC(EVP_sha256(), prk.data(), static_cast<int>(prk.size()), input.data(), input.size(), block, &length);
+        const size_t take = std::min(sizeof(block), out_size - produced);
+        std::memcpy(out + produced, block, take);
+        produced += take;
+    }
+}
+
+QuicSecret ExpandLabel(const QuicSecret& prk, std::string_view label, const QuicSecret& context) {
+    QuicSecret out{};
+    ExpandLabel(prk, label, context.data(), context.size(), out.data(), out.size());
+    return out;
+}
+
+void RandomBytes(uint8_t* out, size_t size) {
+    RAND_bytes(out, static_cast<int>(size));
+}
+
+uint64_t RandomU64() {
+    uint64_t value = 0;
+    RandomBytes(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+    return value;
+}
+
+} // namespace quic_crypto
+
+void QuicPacketProtection::ContextDeleter::operator()(evp_cipher_ctx_st* context) const {
+    EVP_CIPHER_CTX_free(context);
+}
+
+QuicPacketProtection::QuicPacketProtection() = default;
+QuicPacketProtection::~QuicPacketProtection() = default;
+QuicPacketProtection::QuicPacketProtection(QuicPacketProtection&&) noexcept = default;
+QuicPacketProtection& QuicPacketProtection::operator=(QuicPacketProtection&&) noexcept = default;
+
+bool QuicPacketProtection::Install(const QuicSecret& secret, bool encrypt) {
+    uint8_t key[16];
+    quic_crypto::ExpandLabel(secret, "quic key", nullptr, 0, key, sizeof(key));
+    quic_crypto::ExpandLabel(secret, "quic iv", nullptr, 0, m_iv.data(), m_iv.size());
+
+    m_context.reset(EVP_CIPHER_CTX_new());
+    m_encrypt = encrypt;
+    const bool ok = m_context &&
+        (encrypt ? EVP_EncryptInit_ex(m_context.get(), EVP_aes_128_gcm(), nullptr, key, nullptr)
+                 : EVP_DecryptInit_ex(m_context.get(), EVP_aes_128_gcm(), nullptr, key, nullptr)) == 1;
+    OPENSSL_cleanse(key, sizeof(key));
+    if (!ok) m_context.reset();
+    return ok;
+}
+
+void QuicPacketProtection::Reset() {
+    m_context.reset();
+    OPENSSL_cleanse(m_iv.data(), m_iv.size());
+}
+
+void QuicPacketProtection::MakeNonce(uint64_t packet_number, uint8_t* nonce) const {
+    std::memcpy(nonce, m_iv.data(), m_iv.size());
+    for (size_t i = 0; i < 8; ++i) {
+        nonce[m_iv.size() - 1 - i] ^= static_cast<uint8_t>(packet_number >> (8 * i));
+    }
+}
+
+bool QuicPacketProtection::Seal(uint64_t packet_number, const std::byte* aad, size_t aad_size,
+                                const std::byte* plain, size_t size, std::byte* out) {
+    if (!m_context || !m_encrypt) return false;
+    uint8_t nonce[12];
+    MakeNonce(packet_number, nonce);
+    auto* context = m_context.get();
+    auto* out_bytes = reinterpret_cast<unsigned char*>(out);
+    int length = 0;
+    int final_length = 0;
+    return EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, nonce) == 1 &&
+           EVP_EncryptUpdate(context, nullptr, &length, reinterpret_cast<const unsigned char*>(aad),
+                             static_cast<int>(aad_size)) == 1 &&
+           EVP_EncryptUpdate(context, out_bytes, &length, reinterpret_cast<const unsigned char*>(plain),
+                             static_cast<int>(size)) == 1 &&
+           EVP_EncryptFinal_ex(context, out_bytes + length, &final_length) == 1 &&
+           EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_GET_TAG, kTagSize, out_bytes + size) == 1;
+}
+
+bool QuicPacketProtection::Open(uint64_t packet_number, const std::byte* aad, size_t aad_size,
+                                const std::byte* cipher, size_t size, std::byte* out) {
+    if (!m_context || m_encrypt || size < kTagSize) return false;
+    uint8_t nonce[12];
+    MakeNonce(packet_number, nonce);
+    auto* context = m_context.get();
+    const size_t body = size - kTagSize;
+    auto* out_bytes = reinterpret_cast<unsigned char*>(out);
+    uint8_t tag[kTagSize];
+    std::memcpy(tag, cipher + body, kTagSize);
+    int length = 0;
+    int final_length = 0;
+    return EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, nonce) == 1 &&
+           EVP_DecryptUpdate(context, nullptr, &length, reinterpret_cast<const unsigned char*>(aad),
+                             static_cast<int>(aad_size)) == 1 &&
+           EVP_DecryptUpdate(context, out_bytes, &length, reinterpret_cast<const unsigned char*>(cipher),
+                             static_cast<int>(body)) == 1 &&
+           EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_SET_TAG, kTagSize, tag) == 1 &&
+           EVP_DecryptFinal_ex(context, out_bytes + length, &final_length) == 1;
+}
+
+namespace {
+
+constexpr size_t kTicketIdSize = 8;
+constexpr size_t kTicketBodySize = 32 + 8 + 8;
+
+void PutU64(std::byte* out, uint64_t value) {
+    for (size_t i = 0; i < 8; ++i) out[i] = static_cast<std::byte>(value >> (8 * i));
+}
+
+uint64_t GetU64(const std::byte* in) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i) value |= static_cast<uint64_t>(std::to_integer<uint8_t>(in[i])) << (8 * i);
+    return value;
+}
+
+} // namespace
+
+QuicServerContext::QuicServerContext(const QuicKeyPair& static_key, std::chrono::seconds ticket_lifetime,
+                                     size_t max_redeemed_tickets)
+    : m_staticKey(static_key), m_ticketLifetime(ticket_lifetime), m_maxRedeemed(max_redeemed_tickets) {
+    QuicSecret ticket_key{};
+    quic_crypto::RandomBytes(ticket_key.data(), ticket_key.size());
+    m_ticketSeal.Install(ticket_key, true);
+    m_ticketOpen.Install(ticket_key, false);
+    OPENSSL_cleanse(ticket_key.data(), ticket_key.size());
+}
+
+// Layout: ticket_id(8, clear, also the nonce input) || AEAD(resumption_secret || player_id || issued_at_ms)
+std::vector<std::byte> QuicServerContext::SealTicket(QuicTicket& ticket) {
+    ticket.ticket_id = quic_crypto::RandomU64();
+    std::array<std::byte, kTicketBodySize> body{};
+    std::memcpy(body.data(), ticket.resumption_secret.data(), 32);
+    PutU64(body.data() + 32, ticket.player_id);
+    PutU64(body.data() + 40, static_cast<uint64_t>(ticket.issued_at_ms));
+
+    std::vector<std::byte> sealed(kTicketIdSize + kTicketBodySize + QuicPacketProtection::kTagSize);
+    PutU64(sealed.data(), ticket.ticket_id);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_ticketSeal.Seal(ticket.ticket_id, sealed.data(), kTicketIdSize, body.data(), body.size(),
+                           sealed.data() + kTicketIdSize)) {
+        sealed.clear();
+    }
+    OPENSSL_cleanse(body.data(), body.size());
+    return sealed;
+}
+
+QuicServerContext::TicketResult QuicServerContext::RedeemTicket(const std::byte* data, size_t size,
+                                                                Clock::time_point now, QuicTicket& out) {
+    if (size != kTicketIdSize + kTicketBodySize + QuicPacketProtection::kTagSize) return TicketResult::Invalid;
+    std::array<std::byte, kTicketBodySize> body{};
+    const uint64_t ticket_id = GetU64(data);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_ticketOpen.Open(ticket_id, data, kTicketIdSize, data + kTicketIdSize, size - kTicketIdSize, body.data())) {
+        return TicketResult::Invalid;
+    }
+    out.ticket_id = ticket_id;
+    std::memcpy(out.resumption_secret.data(), body.data(), 32);
+    out.player_id = GetU64(body.data() + 32);
+    out.issued_at_ms = static_cast<int64_t>(GetU64(body.data() + 40));
+    OPENSSL_cleanse(body.data(), body.size());
+
+    const auto issued = Clock::time_point(std::chrono::milliseconds(out.issued_at_ms));
+    if (now < issued || now - issued > m_ticketLifetime) return TicketResult::Expired;
+
+    PruneRedeemedLocked(now);
+    if (m_redeemed.size() >= m_maxRedeemed) return TicketResult::Replayed;   // Fail closed rather than forget
+    if (!m_redeemed.emplace(ticket_id, issued + m_ticketLifetime).second) return TicketResult::Replayed;
+    return TicketResult::Accepted;
+}
+
+// Expired tickets are rejected on their timestamp alone, so their ids can be forgotten
+void QuicServerContext::PruneRedeemedLocked(Clock::time_point now) {
+    if (now - m_lastPrune < std::chrono::seconds(10) && m_redeemed.size() < m_maxRedeemed) return;
+    m_lastPrune = now;
+    for (auto it = m_redeemed.begin(); it != m_redeemed.end();) {
+        it = it->second <= now ? m_redeemed.erase(it) : std::next(it);
+    }
+}
+
+} // namespace mmorpg::network
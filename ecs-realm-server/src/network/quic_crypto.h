@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+struct evp_cipher_ctx_st;
+
+namespace mmorpg::network {
+
+using QuicSecret = std::array<uint8_t, 32>;
+using QuicPublicKey = std::array<uint8_t, 32>;
+
+// [SEQUENCE: MVP19-260] X25519 key pair. The server's long-term pair authenticates it to clients, which are built
+// with its public half pinned; every handshake also uses a fresh ephemeral pair on both sides.
+struct QuicKeyPair {
+    QuicSecret private_key{};
+    QuicPublicKey public_key{};
+};
+
+// [SEQUENCE: MVP19-261] Primitives behind the QUIC handshake and packet protection: X25519, SHA-256 and the TLS 1.3
+// HKDF-Expand-Label construction, all on OpenSSL's EVP interface.
+// The handshake built from them is custom and unreviewed; see QUICProtocolHandler for its status.
+namespace quic_crypto {
+
+bool GenerateKeyPair(QuicKeyPair& out);
+// Rebuilds the public half from a stored private key
+bool DerivePublicKey(const QuicSecret& private_key, QuicPublicKey& public_key);
+bool Dh(const QuicSecret& private_key, const QuicPublicKey& peer_public, QuicSecret& shared);
+
+QuicSecret Sha256(const uint8_t* data, size_t size);
+// Keyed with an arbitrary secret, e.g. to authenticate cluster messages (Extract substitutes a zero salt for an
+// empty one)
+QuicSecret HmacSha256(const uint8_t* key, size_t key_size, const uint8_t* data, size_t size);
+QuicSecret Extract(const uint8_t* salt, size_t salt_size, const uint8_t* ikm, size_t ikm_size);
+void ExpandLabel(const QuicSecret& prk, std::string_view label, const uint8_t* context, size_t context_size,
+                 uint8_t* out, size_t out_size);
+QuicSecret ExpandLabel(const QuicSecret& prk, std::string_view label, const QuicSecret& context);
+
+void RandomBytes(uint8_t* out, size_t size);
+uint64_t RandomU64();
+
+} // namespace quic_crypto
+
+// [SEQUENCE: MVP19-262] AES-128-GCM protection for one direction of one key phase. Key and IV come from the traffic
+// secret as in RFC 9001 §5.1; the nonce is the IV XORed with the packet number, and the packet header is the AAD.
+// The cipher context is keyed once and reused, so sealing a packet allocates nothing. Not thread-safe.
+class QuicPacketProtection {
+public:
+    static constexpr size_t kTagSize = 16;
+
+    QuicPacketProtection();
+    ~QuicPacketProtection();
+    QuicPacketProtection(QuicPacketProtection&&) noexcept;
+    QuicPacketProtection& operator=(QuicPacketProtection&&) noexcept;
+
+    // encrypt selects the direction the context is keyed for; a protection only ever seals or only ever opens
+    bool Install(const QuicSecret& secret, bool encrypt);
+    void Reset();
+    bool IsInstalled() const { return m_context != nullptr; }
+
+    // out receives size + kTagSize bytes
+    bool Seal(uint64_t packet_number, const std::byte* aad, size_t aad_size, const std::byte* plain, size_t size,
+              std::byte* out);
+    // size includes the tag; out receives size - kTagSize bytes
+    bool Open(uint64_t packet_number, const std::byte* aad, size_t aad_size, const std::byte* cipher, size_t size,
+              std::byte* out);
+
+private:
+    struct ContextDeleter {
+        void operator()(evp_cipher_ctx_st* context) const;
+    };
+
+    void MakeNonce(uint64_t packet_number, uint8_t* nonce) const;
+
+    std::unique_ptr<evp_cipher_ctx_st, ContextDeleter> m_context;
+    std::array<uint8_t, 12> m_iv{};
+    bool m_encrypt = false;
+};
+
+// [SEQUENCE: MVP19-263] What a resumption ticket vouches for. player_id is the identity the previous connection
+// was logged in as, so a resumed connection skips login as well as the full handshake.
+struct QuicTicket {
+    uint64_t ticket_id = 0;
+    QuicSecret resumption_secret{};
+    uint64_t player_id = 0;
+    int64_t issued_at_ms = 0;   // steady_clock, so tickets are only redeemable in the process that sealed them
+};
+
+// [SEQUENCE: MVP19-264] Server-wide handshake state shared by every server connection: the long-term key, the
+// ticket key and the 0-RTT anti-replay register. A ticket opens at most once within its lifetime, so captured
+// early data cannot be replayed against this server. Thread-safe.
+class QuicServerContext {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class TicketResult : uint8_t {
+        Accepted,
+        Invalid,    // Did not authenticate under the ticket key
+        Expired,
+        Replayed,   // Already redeemed, or the replay register is full
+    };
+
+    explicit QuicServerContext(const QuicKeyPair& static_key,
+                               std::chrono::seconds ticket_lifetime = std::chrono::hours(12),
+                               size_t max_redeemed_tickets = 1 << 20);
+
+    const QuicKeyPair& GetStaticKey() const { return m_staticKey; }
+
+    // Assigns ticket.ticket_id and returns the opaque ticket handed to the client
+    std::vector<std::byte> SealTicket(QuicTicket& ticket);
+    TicketResult RedeemTicket(const std::byte* data, size_t size, Clock::time_point now, QuicTicket& out);
+
+private:
+    void PruneRedeemedLocked(Clock::time_point now);
+
+    const QuicKeyPair m_staticKey;
+    const std::chrono::seconds m_ticketLifetime;
+    const size_t m_maxRedeemed;
+
+    std::mutex m_mutex;
+    QuicPacketProtection m_ticketSeal;
+    QuicPacketProtection m_ticketOpen;
+    std::unordered_map<uint64_t, Clock::time_point> m_redeemed;   // ticket id -> expiry
+    Clock::time_point m_lastPrune{};
+};
+
+} // namespace mmorpg::network
@@ -0,0 +1,363 @@
+#include "network/quic_protocol_handler.h"
+#include "network/session.h"
+#include "network/session_manager.h"
+#include "network/movement_input_queue.h"
+#include "monitoring/metrics_collector.h"
+#include "core/logger.h"
+
+#include <cstring>
+#include <mutex>
+#include <arpa/inet.h>
+
+namespace mmorpg::network {
+
+// One QUIC connection and, once its handshake is done, the Session it carries. The entry is the session's
+// transport, so packets the game sends go out on the connection's streams.
+struct QUICProtocolHandler::Entry : SessionTransport {
+    Entry(uint64_t entry_id, std::unique_ptr<QuicConnection> quic, DatagramSender datagram_sender)
+        : id(entry_id), connection(std::move(quic)), sender(std::move(datagram_sender)) {}
+
+    void SendPacket(mmorpg::proto::PacketType type, const std::byte* data, size_t size) override {
+        // A stream refusing more means the client has stopped reading; it will not catch up
+        if (!connection->SendStream(StreamForPacket(type), data, size)) {
+            connection->Close(QuicError::InternalError);
+        }
+        connection->Flush(Clock::now(), Sink());
+    }
+
+    void Close() override {
+        connection->Close();
+        connection->Flush(Clock::now(), Sink());
+    }
+
+    std::string GetRemoteAddress() const override { return connection->GetPeerEndpoint().address().to_string(); }
+    SessionTransportKind GetKind() const override { return SessionTransportKind::Quic; }
+
+    QuicConnection::DatagramSink Sink() const {
+        return [this](const Endpoint& to, const std::byte* data, size_t size) {
+            if (sender) sender(to, data, size);
+        };
+    }
+
+    const uint64_t id;
+    const std::unique_ptr<QuicConnection> connection;
+    const DatagramSender sender;
+
+    // Serializes datagram processing, timers and event delivery for this connection
+    std::mutex receive_mutex;
+    std::shared_ptr<Session> session;
+    std::unordered_map<uint64_t, std::vector<std::byte>> partial;   // Stream id -> bytes of an incomplete packet
+    uint16_t last_movement_sequence = 0;
+    bool has_movement = false;
+
+    // Guarded by the handler's m_mutex
+    std::vector<uint64_t> connection_ids;
+    bool removed = false;
+};
+
+QUICProtocolHandler::QUICProtocolHandler(const QuicKeyPair& static_key, SessionManager& session_manager,
+                                         std::shared_ptr<IPacketHandler> packet_handler,
+                                         boost::asio::any_io_executor executor, Config config)
+    : m_context(static_key),
+      m_sessionManager(session_manager),
+      m_packetHandler(std::move(packet_handler)),
+      m_executor(std::move(executor)),
+      m_config(config) {}
+
+QUICProtocolHandler::~QUICProtocolHandler() {
+    std::unordered_map<uint64_t, std::shared_ptr<Entry>> connections;
+    {
+        std::unique_lock lock(m_mutex);
+        connections.swap(m_connections);
+        m_routes.clear();
+    }
+    // Sessions hold their entry as transport and entries hold their session; break the cycle
+    for (auto& [id, entry] : connections) {
+        std::lock_guard entry_lock(entry->receive_mutex);
+        entry->session.reset();
+    }
+}
+
+uint64_t QUICProtocolHandler::StreamForPacket(mmorpg::proto::PacketType type) {
+    using namespace mmorpg::proto;
+    switch (type) {
+    case PACKET_MOVEMENT_UPDATE:
+    case PACKET_ENTITY_UPDATE:
+    case PACKET_ENTITY_UPDATE_BATCH:
+    case PACKET_ENTITY_DELTA_SNAPSHOT:
+    case PACKET_SNAPSHOT_ACK:
+        return kWorldStream;
+    case PACKET_COMBAT_ACTION:
+    case PACKET_COMBAT_RESULT:
+        return kCombatStream;
+    case PACKET_CHAT_MESSAGE:
+        return kChatStream;
+    case PACKET_GUILD_CREATE_REQUEST:
+    case PACKET_GUILD_CREATE_RESPONSE:
+    case PACKET_GUILD_INVITE_REQUEST:
+    case PACKET_GUILD_INVITE_RESPONSE:
+    case PACKET_GUILD_WAR_REQUEST:
+    case PACKET_GUILD_WAR_RESPONSE:
+    case PACKET_GUILD_INVITE_ACCEPT_REQUEST:
+    case PACKET_GUILD_LEAVE_REQUEST:
+    case PACKET_DUEL_ACCEPT_REQUEST:
+    case PACKET_DUEL_DECLINE_REQUEST:
+        return kSocialStream;
+    default:
+        return kControlStream;
+    }
+}
+
+void QUICProtocolHandler::Handle([[maybe_unused]] std::shared_ptr<Session> session, const Endpoint& endpoint,
+                                 const std::vector<std::byte>& buffer, size_t size) {
+    const auto now = Clock::now();
+    uint64_t destination = 0;
+    bool is_initial = false;
+    if (!quic_wire::PeekDestination(buffer.data(), size, destination, is_initial)) {
+        m_droppedUnrouted.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::shared_ptr<Entry> entry;
+    {
+        std::shared_lock lock(m_mutex);
+        auto it = m_routes.find(destination);
+        if (it != m_routes.end()) entry = it->second;
+    }
+    if (!entry) {
+        // Only a padded Initial may open a connection, which bounds what a spoofed source can make us send
+        if (!is_initial || size < kQuicMinInitialDatagram) {
+            m_droppedUnrouted.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        std::unique_lock lock(m_mutex);
+        auto it = m_routes.find(destination);
+        if (it != m_routes.end()) {
+            entry = it->second;
+        } else {
+            if (m_connections.size() >= m_config.max_connections) {
+                m_refused.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            entry = std::make_shared<Entry>(
+                ++m_nextEntryId,
+                std::make_unique<QuicConnection>(m_config.connection, m_context, endpoint, destination, now),
+                m_sender);
+            entry->connection_ids.push_back(destination);
+            for (uint64_t id : entry->connection->GetLocalConnectionIds()) entry->connection_ids.push_back(id);
+            for (uint64_t id : entry->connection_ids) m_routes[id] = entry;
+            m_connections.emplace(entry->id, entry);
+            m_accepted.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    HandleDatagram(entry, buffer.data(), size, endpoint, now);
+}
+
+void QUICProtocolHandler::HandleDatagram(const std::shared_ptr<Entry>& entry, const std::byte* data, size_t size,
+                                         const Endpoint& from, Clock::time_point now) {
+    std::lock_guard lock(entry->receive_mutex);
+    entry->connection->OnDatagram(data, size, from, now,
+                                  [&](const QuicEvent& event) { OnEvent(entry, event, now); });
+    // Acks, and anything the packet handler sent in reply, leave right away
+    entry->connection->Flush(now, entry->Sink());
+}
+
+// [SEQUENCE: MVP19-281] Timers for the connections this worker owns. The entry list is copied under the shared
+// lock so ticking never blocks the receive path of other workers.
+void QUICProtocolHandler::OnWorkerTick(size_t worker_index, size_t worker_count, Clock::time_point now) {
+    thread_local std::vector<std::shared_ptr<Entry>> owned;
+    owned.clear();
+    {
+        std::shared_lock lock(m_mutex);
+        for (const auto& [id, entry] : m_connections) {
+            if (worker_count == 0 || id % worker_count == worker_index) owned.push_back(entry);
+        }
+    }
+    for (const auto& entry : owned) {
+        std::lock_guard lock(entry->receive_mutex);
+        entry->connection->Update(now, entry->Sink(), [&](const QuicEvent& event) { OnEvent(entry, event, now); });
+    }
+    owned.clear();
+}
+
+void QUICProtocolHandler::OnEvent(const std::shared_ptr<Entry>& entry, const QuicEvent& event, Clock::time_point now) {
+    switch (event.type) {
+    case QuicEvent::Type::HandshakeComplete:
+        OnHandshakeComplete(entry, now);
+        break;
+    case QuicEvent::Type::StreamData:
+        OnStreamData(*entry, event);
+        break;
+    case QuicEvent::Type::Datagram:
+        OnMovementDatagram(*entry, event, now);
+        break;
+    case QuicEvent::Type::ConnectionIdIssued: {
+        std::unique_lock lock(m_mutex);
+        if (entry->removed) break;
+        entry->connection_ids.push_back(event.value);
+        m_routes[event.value] = entry;
+        break;
+    }
+    case QuicEvent::Type::PathChanged:
+        (event.value ? m_migrations : m_rebindings).fetch_add(1, std::memory_order_relaxed);
+        break;
+    case QuicEvent::Type::Closed:
+        RemoveEntry(entry);
+        break;
+    case QuicEvent::Type::TicketReceived:
+        break;
+    }
+}
+
+void QUICProtocolHandler::OnHandshakeComplete(const std::shared_ptr<Entry>& entry, Clock::time_point now) {
+    if (entry->session) return;
+    const uint32_t session_id = m_sessionManager.get_next_session_id();
+    auto session = std::make_shared<Session>(m_executor, session_id, m_packetHandler, entry);
+    session->Start();
+    entry->session = session;
+    {
+        std::unique_lock lock(m_mutex);
+        m_bySession[session_id] = entry;
+    }
+    m_sessionManager.Register(session);
+    m_sessionsCreated.fetch_add(1, std::memory_order_relaxed);
+
+    // The ticket vouches for who this client logged in as last time. The connection only completes once a packet
+    // sealed with keys from the ticket's secret has opened, so a replayed ticket alone gets nowhere. The ticket
+    // itself is spent, so a fresh one goes back for the next reconnect
+    const uint64_t player_id = entry->connection->IsResumed() ? entry->connection->GetResumedPlayerId() : 0;
+    if (player_id != 0) {
+        session->SetPlayerId(player_id);
+        session->Authenticate();
+        m_sessionManager.SetPlayerIdForSession(session_id, player_id);
+        m_sessionsResumed.fetch_add(1, std::memory_order_relaxed);
+        if (entry->connection->IssueTicket(player_id, now)) m_ticketsIssued.fetch_add(1, std::memory_order_relaxed);
+        LOG_INFO("[QUIC] Session {} resumed for player {} from {}", session_id, player_id, session->GetRemoteAddress());
+    }
+}
+
+// Packets keep the TCP framing (4-byte big-endian length, then the envelope) so a stream is just the TCP byte
+// stream of one traffic class
+void QUICProtocolHandler::OnStreamData(Entry& entry, const QuicEvent& event) {
+    if (!entry.session || event.size == 0) return;
+    auto& buffer = entry.partial[event.stream_id];
+    buffer.insert(buffer.end(), event.data, event.data + event.size);
+
+    size_t offset = 0;
+    while (buffer.size() - offset >= 4) {
+        uint32_t body_size = 0;
+        std::memcpy(&body_size, buffer.data() + offset, sizeof(body_size));
+        body_size = ntohl(body_size);
+        if (body_size == 0 || body_size > m_config.max_packet_size) {
+            m_droppedMalformed.fetch_add(1, std::memory_order_relaxed);
+            buffer.clear();
+            entry.connection->Close(QuicError::ProtocolViolation);
+            return;
+        }
+        if (buffer.size() - offset - 4 < body_size) break;
+        entry.session->DeliverTransportPacket(buffer.data() + offset + 4, body_size);
+        offset += 4 + body_size;
+    }
+    buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+}
+
+// DATAGRAM payload: sequence(u16 LE) QuantizedMovement. Newest wins, as on the plain UDP path.
+void QUICProtocolHandler::OnMovementDatagram(Entry& entry, const QuicEvent& event, Clock::time_point now) {
+    if (!entry.session) return;
+    MovementInput input;
+    if (event.size != 2 + kQuantizedMovementSize || !DecodeMovement(event.data + 2, kQuantizedMovementSize, input.sample)) {
+        m_droppedMalformed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const uint16_t sequence = static_cast<uint16_t>(std::to_integer<uint16_t>(event.data[0]) |
+                                                    (std::to_integer<uint16_t>(event.data[1]) << 8));
+    if (entry.has_movement && !SequenceGreaterThan(sequence, entry.last_movement_sequence)) {
+        m_movementStale.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    entry.has_movement = true;
+    entry.last_movement_sequence = sequence;
+    if (!m_movementQueue) return;
+
+    input.player_id = entry.session->GetPlayerId();
+    input.session_id = entry.session->GetSessionId();
+    input.sequence = sequence;
+    input.received_at = now;
+    if (m_movementQueue->Push(std::move(input))) {
+        m_movementAccepted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void QUICProtocolHandler::RemoveEntry(const std::shared_ptr<Entry>& entry) {
+    {
+        std::unique_lock lock(m_mutex);
+        if (entry->removed) return;
+        entry->removed = true;
+        for (uint64_t id : entry->connection_ids) {
+            auto it = m_routes.find(id);
+            if (it != m_routes.end() && it->second == entry) m_routes.erase(it);
+        }
+        m_connections.erase(entry->id);
+        if (entry->session) m_bySession.erase(entry->session->GetSessionId());
+    }
+    m_closed.fetch_add(1, std::memory_order_relaxed);
+    if (auto session = std::move(entry->session)) {
+        session->Disconnect();
+        m_sessionManager.Unregister(session->GetSessionId());
+    }
+    entry->partial.clear();
+}
+
+bool QUICProtocolHandler::IssueResumptionTicket(const Session& session) {
+    if (session.GetPlayerId() == 0) return false;
+    std::shared_ptr<Entry> entry;
+    {
+        std::shared_lock lock(m_mutex);
+        auto it = m_bySession.find(session.GetSessionId());
+        if (it != m_bySession.end()) entry = it->second.lock();
+    }
+    if (!entry) return false;
+    const auto now = Clock::now();
+    if (!entry->connection->IssueTicket(session.GetPlayerId(), now)) return false;
+    entry->connection->Flush(now, entry->Sink());
+    m_ticketsIssued.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+QUICProtocolHandler::Stats QUICProtocolHandler::GetStats() const {
+    Stats stats;
+    stats.connections_accepted = m_accepted.load(std::memory_order_relaxed);
+    stats.connections_refused = m_refused.load(std::memory_order_relaxed);
+    stats.connections_closed = m_closed.load(std::memory_order_relaxed);
+    stats.sessions_created = m_sessionsCreated.load(std::memory_order_relaxed);
+    stats.sessions_resumed = m_sessionsResumed.load(std::memory_order_relaxed);
+    stats.tickets_issued = m_ticketsIssued.load(std::memory_order_relaxed);
+    stats.dropped_unrouted = m_droppedUnrouted.load(std::memory_order_relaxed);
+    stats.dropped_malformed = m_droppedMalformed.load(std::memory_order_relaxed);
+    stats.movement_accepted = m_movementAccepted.load(std::memory_order_relaxed);
+    stats.movement_stale = m_movementStale.load(std::memory_order_relaxed);
+    stats.migrations = m_migrations.load(std::memory_order_relaxed);
+    stats.rebindings = m_rebindings.load(std::memory_order_relaxed);
+    std::shared_lock lock(m_mutex);
+    stats.active_connections = m_connections.size();
+    return stats;
+}
+
+void QUICProtocolHandler::ExportMetrics(monitoring::MetricsCollector& metrics) const {
+    const Stats stats = GetStats();
+    metrics.RecordGauge("quic.active_connections", static_cast<double>(stats.active_connections));
+    metrics.RecordCounter("quic.connections_accepted", stats.connections_accepted);
+    metrics.RecordCounter("quic.connections_refused", stats.connections_refused);
+    metrics.RecordCounter("quic.connections_closed", stats.connections_closed);
+    metrics.RecordCounter("quic.sessions_created", stats.sessions_created);
+    metrics.RecordCounter("quic.sessions_resumed", stats.sessions_resumed);
+    metrics.RecordCounter("quic.tickets_issued", stats.tickets_issued);
+    metrics.RecordCounter("quic.dropped_unrouted", stats.dropped_unrouted);
+    metrics.RecordCounter("quic.dropped_malformed", stats.dropped_malformed);
+    metrics.RecordCounter("quic.movement_accepted", stats.movement_accepted);
+    metrics.RecordCounter("quic.movement_stale", stats.movement_stale);
+    metrics.RecordCounter("quic.migrations", stats.migrations);
+    metrics.RecordCounter("quic.rebindings", stats.rebindings);
+}
+
+} // namespace mmorpg::network
@@ -0,0 +1,177 @@
+#include "network/quic_wire.h"
+
+namespace mmorpg::network::quic_wire {
+
+namespace {
+
+constexpr uint8_t kLongHeaderBit = 0x80;
+constexpr uint8_t kFixedBit = 0x40;
+
+uint8_t ByteAt(const std::byte* data, size_t index) {
+    return std::to_integer<uint8_t>(data[index]);
+}
+
+uint64_t ReadBigEndian(const std::byte* data, size_t count) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < count; ++i) value = (value << 8) | ByteAt(data, i);
+    return value;
+}
+
+} // namespace
+
+size_t VarintSize(uint64_t value) {
+    if (value < (1ull << 6)) return 1;
+    if (value < (1ull << 14)) return 2;
+    if (value < (1ull << 30)) return 4;
+    return 8;
+}
+
+void WriteVarint(std::vector<std::byte>& out, uint64_t value) {
+    const size_t size = VarintSize(value);
+    const uint8_t prefix = size == 1 ? 0x00 : size == 2 ? 0x40 : size == 4 ? 0x80 : 0xC0;
+    for (size_t i = 0; i < size; ++i) {
+        uint8_t byte = static_cast<uint8_t>(value >> (8 * (size - 1 - i)));
+        if (i == 0) byte |= prefix;
+        out.push_back(static_cast<std::byte>(byte));
+    }
+}
+
+void WriteVarint2(std::byte* out, uint64_t value) {
+    out[0] = static_cast<std::byte>(0x40 | ((value >> 8) & 0x3F));
+    out[1] = static_cast<std::byte>(value & 0xFF);
+}
+
+void WriteU32(std::vector<std::byte>& out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<std::byte>(value >> shift));
+}
+
+void WriteU64(std::vector<std::byte>& out, uint64_t value) {
+    for (int shift = 56; shift >= 0; shift -= 8) out.push_back(static_cast<std::byte>(value >> shift));
+}
+
+bool Reader::Varint(uint64_t& value) {
+    if (m_offset >= m_size) return false;
+    const uint8_t first = ByteAt(m_data, m_offset);
+    const size_t size = size_t{1} << (first >> 6);
+    if (m_size - m_offset < size) return false;
+    value = first & 0x3F;
+    for (size_t i = 1; i < size; ++i) value = (value << 8) | ByteAt(m_data, m_offset + i);
+    m_offset += size;
+    return true;
+}
+
+bool Reader::U8(uint8_t& value) {
+    if (m_offset >= m_size) return false;
+    value = ByteAt(m_data, m_offset++);
+    return true;
+}
+
+bool Reader::U32(uint32_t& value) {
+    if (m_size - m_offset < 4) return false;
+    value = static_cast<uint32_t>(ReadBigEndian(m_data + m_offset, 4));
+    m_offset += 4;
+    return true;
+}
+
+bool Reader::U64(uint64_t& value) {
+    if (m_size - m_offset < 8) return false;
+    value = ReadBigEndian(m_data + m_offset, 8);
+    m_offset += 8;
+    return true;
+}
+
+bool Reader::Bytes(size_t count, const std::byte*& out) {
+    if (m_size - m_offset < count) return false;
+    out = m_data + m_offset;
+    m_offset += count;
+    return true;
+}
+
+// first(1) version(4) dcid_len(1) dcid(8) scid_len(1) scid(8) length(2) packet_number(4)
+void WriteLongHeader(std::vector<std::byte>& out, QuicPacketType type, uint64_t destination_cid, uint64_t source_cid,
+                     uint32_t packet_number) {
+    out.push_back(static_cast<std::byte>(kLongHeaderBit | kFixedBit | (static_cast<uint8_t>(type) << 4) | 0x03));
+    WriteU32(out, kQuicVersion);
+    out.push_back(static_cast<std::byte>(kQuicConnectionIdSize));
+    WriteU64(out, destination_cid);
+    out.push_back(static_cast<std::byte>(kQuicConnectionIdSize));
+    WriteU64(out, source_cid);
+    out.push_back(std::byte{0x40});
+    out.push_back(std::byte{0x00});
+    WriteU32(out, packet_number);
+}
+
+// The length field counts the packet number and the protected payload, tag included
+void PatchLongHeaderLength(std::vector<std::byte>& packet, size_t header_offset, size_t protected_size) {
+    WriteVarint2(packet.data() + header_offset + kQuicLongHeaderSize - 6, 4 + protected_size);
+}
+
+// first(1) dcid(8) packet_number(4)
+void WriteShortHeader(std::vector<std::byte>& out, uint64_t destination_cid, uint32_t packet_number) {
+    out.push_back(static_cast<std::byte>(kFixedBit | 0x03));
+    WriteU64(out, destination_cid);
+    WriteU32(out, packet_number);
+}
+
+bool DecodeHeader(const std::byte* data, size_t size, QuicPacketHeader& header) {
+    if (size == 0) return false;
+    const uint8_t first = ByteAt(data, 0);
+    if (!(first & kFixedBit)) return false;
+
+    Reader reader(data + 1, size - 1);
+    if (!(first & kLongHeaderBit)) {
+        uint32_t packet_number = 0;
+        if (!reader.U64(header.destination_cid) || !reader.U32(packet_number)) return false;
+        header.type = QuicPacketType::OneRtt;
+        header.source_cid = 0;
+        header.packet_number = packet_number;
+        header.header_size = kQuicShortHeaderSize;
+        header.packet_size = size;
+        return true;
+    }
+
+    const uint8_t type = (first >> 4) & 0x03;
+    if (type > static_cast<uint8_t>(QuicPacketType::ZeroRtt)) return false;
+    uint32_t version = 0;
+    uint8_t dcid_size = 0;
+    uint8_t scid_size = 0;
+    uint64_t length = 0;
+    uint32_t packet_number = 0;
+    if (!reader.U32(version) || version != kQuicVersion) return false;
+    if (!reader.U8(dcid_size) || dcid_size != kQuicConnectionIdSize || !reader.U64(header.destination_cid)) return false;
+    if (!reader.U8(scid_size) || scid_size != kQuicConnectionIdSize || !reader.U64(header.source_cid)) return false;
+    if (!reader.Varint(length) || length < 4 || length > reader.Remaining()) return false;
+    if (!reader.U32(packet_number)) return false;
+
+    header.type = static_cast<QuicPacketType>(type);
+    header.packet_number = packet_number;
+    header.header_size = 1 + reader.Offset();
+    header.packet_size = header.header_size + static_cast<size_t>(length) - 4;
+    return true;
+}
+
+bool PeekDestination(const std::byte* data, size_t size, uint64_t& destination_cid, bool& is_initial) {
+    if (size < kQuicShortHeaderSize) return false;
+    const uint8_t first = ByteAt(data, 0);
+    if (!(first & kFixedBit)) return false;
+    if (!(first & kLongHeaderBit)) {
+        destination_cid = ReadBigEndian(data + 1, kQuicConnectionIdSize);
+        is_initial = false;
+        return true;
+    }
+    if (size < kQuicLongHeaderSize || ByteAt(data, 5) != kQuicConnectionIdSize) return false;
+    destination_cid = ReadBigEndian(data + 6, kQuicConnectionIdSize);
+    is_initial = ((first >> 4) & 0x03) == static_cast<uint8_t>(QuicPacketType::Initial);
+    return true;
+}
+
+uint64_t DecodePacketNumber(uint64_t expected, uint32_t truncated) {
+    constexpr uint64_t kWindow = 1ull << 32;
+    constexpr uint64_t kHalf = kWindow / 2;
+    const uint64_t candidate = (expected & ~(kWindow - 1)) | truncated;
+    if (candidate + kHalf <= expected && candidate < (1ull << 62) - kWindow) return candidate + kWindow;
+    if (candidate > expected + kHalf && candidate >= kWindow) return candidate - kWindow;
+    return candidate;
+}
+
+} // namespace mmorpg::network::quic_wire
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-265] Wire format of the QUIC transport. It follows RFC 9000 closely enough to be read with the
+// RFC at hand: long headers for the Initial and 0-RTT packets of the handshake, short headers afterwards, RFC
+// varints and frame type numbers. It is not interoperable with other QUIC stacks: connection ids are fixed at
+// 8 bytes, the packet number is always sent as its low 32 bits, the Initial token field is absent, and headers
+// are authenticated as AAD but not masked (no header protection).
+inline constexpr uint32_t kQuicVersion = 0x4D520001;
+inline constexpr size_t kQuicConnectionIdSize = 8;
+inline constexpr size_t kQuicShortHeaderSize = 1 + kQuicConnectionIdSize + 4;
+inline constexpr size_t kQuicLongHeaderSize = 1 + 4 + 1 + kQuicConnectionIdSize + 1 + kQuicConnectionIdSize + 2 + 4;
+inline constexpr size_t kQuicMinInitialDatagram = 1200;
+
+enum class QuicPacketType : uint8_t {
+    Initial = 0,
+    ZeroRtt = 1,
+    OneRtt = 0xFF,   // Short header
+};
+
+enum class QuicFrameType : uint64_t {
+    Padding = 0x00,
+    Ping = 0x01,
+    Ack = 0x02,
+    Crypto = 0x06,
+    NewToken = 0x07,
+    Stream = 0x08,          // 0x08..0x0f; low bits OFF(0x04) LEN(0x02) FIN(0x01)
+    MaxStreamData = 0x11,
+    NewConnectionId = 0x18,
+    PathChallenge = 0x1a,
+    PathResponse = 0x1b,
+    ConnectionClose = 0x1c,
+    HandshakeDone = 0x1e,
+    Datagram = 0x31,        // RFC 9221, with length
+};
+
+// Transport error codes carried in CONNECTION_CLOSE (RFC 9000 §20.1)
+enum class QuicError : uint64_t {
+    NoError = 0x00,
+    InternalError = 0x01,
+    FlowControlError = 0x03,
+    StreamLimitError = 0x04,
+    FrameEncodingError = 0x07,
+    ProtocolViolation = 0x0a,
+    CryptoError = 0x100,
+};
+
+struct QuicPacketHeader {
+    QuicPacketType type = QuicPacketType::OneRtt;
+    uint64_t destination_cid = 0;
+    uint64_t source_cid = 0;        // Long header only
+    uint32_t packet_number = 0;     // Low 32 bits
+    size_t header_size = 0;         // Bytes covered as AAD, packet number included
+    size_t packet_size = 0;         // Whole packet; a long header can be followed by a coalesced packet
+};
+
+namespace quic_wire {
+
+size_t VarintSize(uint64_t value);
+void WriteVarint(std::vector<std::byte>& out, uint64_t value);
+// Always two bytes, for length fields patched after the fact. value must be below 16384.
+void WriteVarint2(std::byte* out, uint64_t value);
+void WriteU32(std::vector<std::byte>& out, uint32_t value);
+void WriteU64(std::vector<std::byte>& out, uint64_t value);
+
+// Bounds-checked cursor over a received payload. Every read fails once the cursor would run past the end.
+class Reader {
+public:
+    Reader(const std::byte* data, size_t size) : m_data(data), m_size(size) {}
+
+    bool Varint(uint64_t& value);
+    bool U8(uint8_t& value);
+    bool U32(uint32_t& value);
+    bool U64(uint64_t& value);
+    bool Bytes(size_t count, const std::byte*& out);
+    size_t Remaining() const { return m_size - m_offset; }
+    size_t Offset() const { return m_offset; }
+    bool Empty() const { return m_offset == m_size; }
+
+private:
+    const std::byte* m_data;
+    size_t m_size;
+    size_t m_offset = 0;
+};
+
+// Writes a header with the length field left as zero; PatchLongHeaderLength fills it in once the payload is sealed.
+void WriteLongHeader(std::vector<std::byte>& out, QuicPacketType type, uint64_t destination_cid, uint64_t source_cid,
+                     uint32_t packet_number);
+void PatchLongHeaderLength(std::vector<std::byte>& packet, size_t header_offset, size_t protected_size);
+void WriteShortHeader(std::vector<std::byte>& out, uint64_t destination_cid, uint32_t packet_number);
+
+// Decodes the header of the packet starting at data. For long headers packet_size comes from the length field.
+bool DecodeHeader(const std::byte* data, size_t size, QuicPacketHeader& header);
+// Cheap routing peek: destination connection id and whether the first packet is an Initial
+bool PeekDestination(const std::byte* data, size_t size, uint64_t& destination_cid, bool& is_initial);
+
+// Expands a 32-bit truncated packet number to the full value closest to expected (RFC 9000 §A.3)
+uint64_t DecodePacketNumber(uint64_t expected, uint32_t truncated);
+
+} // namespace quic_wire
+
+} // namespace mmorpg::network
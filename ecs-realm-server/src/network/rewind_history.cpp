@@ -0,0 +1,319 @@
+#include "network/rewind_history.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mmorpg::network {
+
+namespace {
+
+// Slots tested per broad-phase block; the flags stay on the stack so concurrent queries share nothing. Frames are
+// padded to whole blocks (the padding's id is always 0), so the flag loop has a fixed trip count.
+constexpr size_t kBlockSize = 64;
+
+float Lerp(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+// Entry distance of the ray into the box, if within [0, max_distance]. Starting inside counts as zero.
+bool RayBox(const core::utils::Vector3& origin, const core::utils::Vector3& direction, float max_distance,
+            const core::utils::Vector3& lo, const core::utils::Vector3& hi, float& entry) {
+    float near = 0.0f;
+    float far = max_distance;
+    const float o[3] = {origin.x, origin.y, origin.z};
+    const float d[3] = {direction.x, direction.y, direction.z};
+    const float l[3] = {lo.x, lo.y, lo.z};
+    const float h[3] = {hi.x, hi.y, hi.z};
+    for (int axis = 0; axis < 3; ++axis) {
+        if (d[axis] == 0.0f) {
+            if (o[axis] < l[axis] || o[axis] > h[axis]) return false;
+            continue;
+        }
+        const float inverse = 1.0f / d[axis];
+        float t0 = (l[axis] - o[axis]) * inverse;
+        float t1 = (h[axis] - o[axis]) * inverse;
+        if (t0 > t1) std::swap(t0, t1);
+        near = std::max(near, t0);
+        far = std::min(far, t1);
+        if (near > far) return false;
+    }
+    entry = near;
+    return true;
+}
+
+} // namespace
+
+RewindHistory::RewindHistory(const RewindHistoryConfig& config)
+    : m_config(config) {
+    m_config.frame_capacity = std::max<size_t>(2, m_config.frame_capacity);
+    m_config.max_entities = std::max<size_t>(1, m_config.max_entities);
+    m_stride = (m_config.max_entities + kBlockSize - 1) / kBlockSize * kBlockSize;
+
+    const size_t cells = m_config.frame_capacity * m_stride;
+    m_timestamps.resize(m_config.frame_capacity);
+    m_maxExtent.assign(m_config.frame_capacity, 0.0f);
+    m_maxStep.assign(m_config.frame_capacity, 0.0f);
+    m_maxSpeed.assign(m_config.frame_capacity, 0.0f);
+    m_entityIds.assign(cells, 0);
+    for (auto* column : {&m_posX, &m_posY, &m_posZ, &m_velX, &m_velY, &m_velZ, &m_extX, &m_extY, &m_extZ}) {
+        column->assign(cells, 0.0f);
+    }
+    m_alive.assign(cells, 0);
+    m_slots.reserve(m_config.max_entities);
+    m_freeSlots.reserve(m_config.max_entities);
+}
+
+// [SEQUENCE: MVP19-202] Recycle the oldest frame once full. Only the id column needs clearing, and only up to the
+// high-water slot: stale values in the other columns are never read for a slot whose id does not match.
+void RewindHistory::BeginFrame(Clock::time_point timestamp) {
+    if (m_frameCount < m_config.frame_capacity) {
+        m_current = Physical(m_frameCount);
+        ++m_frameCount;
+    } else {
+        m_current = m_head;
+        m_head = (m_head + 1) % m_config.frame_capacity;
+    }
+    m_timestamps[m_current] = timestamp;
+    m_maxExtent[m_current] = 0.0f;
+    m_maxStep[m_current] = 0.0f;
+    m_maxSpeed[m_current] = 0.0f;
+    std::fill_n(m_entityIds.begin() + static_cast<std::ptrdiff_t>(Column(m_current, 0)), m_slotHighWater, 0);
+    ++m_framesRecorded;
+}
+
+bool RewindHistory::Record(uint64_t entity_id, const core::utils::Vector3& position,
+                           const core::utils::Vector3& velocity, const core::utils::Vector3& half_extents,
+                           bool alive) {
+    if (m_frameCount == 0 || entity_id == 0) return false;
+
+    auto [it, inserted] = m_slots.try_emplace(entity_id, 0);
+    if (inserted) {
+        if (!m_freeSlots.empty()) {
+            it->second = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else if (m_slotHighWater < m_config.max_entities) {
+            it->second = m_slotHighWater++;
+        } else {
+            m_slots.erase(it);
+            ++m_slotsExhausted;
+            return false;
+        }
+    }
+
+    const size_t column = Column(m_current, it->second);
+    m_entityIds[column] = entity_id;
+    m_posX[column] = position.x;
+    m_posY[column] = position.y;
+    m_posZ[column] = position.z;
+    m_velX[column] = velocity.x;
+    m_velY[column] = velocity.y;
+    m_velZ[column] = velocity.z;
+    m_extX[column] = half_extents.x;
+    m_extY[column] = half_extents.y;
+    m_extZ[column] = half_extents.z;
+    m_alive[column] = alive ? 1 : 0;
+
+    const float extent = std::max({half_extents.x, half_extents.y, half_extents.z});
+    const float speed = std::max({std::abs(velocity.x), std::abs(velocity.y), std::abs(velocity.z)});
+    m_maxExtent[m_current] = std::max(m_maxExtent[m_current], extent);
+    m_maxSpeed[m_current] = std::max(m_maxSpeed[m_current], speed);
+    if (m_frameCount > 1) {
+        const size_t previous = Column(Physical(m_frameCount - 2), it->second);
+        if (m_entityIds[previous] == entity_id) {
+            const float step = std::max({std::abs(position.x - m_posX[previous]),
+                                         std::abs(position.y - m_posY[previous]),
+                                         std::abs(position.z - m_posZ[previous])});
+            m_maxStep[m_current] = std::max(m_maxStep[m_current], step);
+        }
+    }
+    return true;
+}
+
+void RewindHistory::RemoveEntity(uint64_t entity_id) {
+    auto it = m_slots.find(entity_id);
+    if (it == m_slots.end()) return;
+    m_freeSlots.push_back(it->second);
+    m_slots.erase(it);
+}
+
+// [SEQUENCE: MVP19-203] Frames are in timestamp order from m_head, so the pair around time is a binary search over
+// logical indices. Before the oldest frame clamps to it; past the newest extrapolates by velocity up to the limit.
+std::optional<RewindHistory::FrameRef> RewindHistory::Locate(Clock::time_point time) const {
+    if (m_frameCount == 0) return std::nullopt;
+
+    const size_t oldest = Physical(0);
+    const size_t newest = Physical(m_frameCount - 1);
+    if (time <= m_timestamps[oldest]) {
+        return FrameRef{oldest, oldest, 0.0f, 0.0f};
+    }
+    if (time >= m_timestamps[newest]) {
+        const auto ahead = std::min<Clock::duration>(time - m_timestamps[newest], m_config.extrapolation_limit);
+        return FrameRef{newest, newest, 0.0f, std::chrono::duration<float>(ahead).count()};
+    }
+
+    size_t lo = 0;                  // timestamps[lo] <= time
+    size_t hi = m_frameCount - 1;   // timestamps[hi] > time
+    while (hi - lo > 1) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (m_timestamps[Physical(mid)] <= time) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    const size_t before = Physical(lo);
+    const size_t after = Physical(hi);
+    const float span = std::chrono::duration<float>(m_timestamps[after] - m_timestamps[before]).count();
+    const float elapsed = std::chrono::duration<float>(time - m_timestamps[before]).count();
+    return FrameRef{before, after, span > 0.0f ? std::clamp(elapsed / span, 0.0f, 1.0f) : 0.0f, 0.0f};
+}
+
+// As with the old snapshot interpolation, an entity must be in the earlier frame; if it is missing from the later
+// one (despawned in between) the earlier state holds for the whole interval.
+bool RewindHistory::Rewind(const FrameRef& frame, uint32_t slot, uint64_t entity_id, RewoundEntity& out) const {
+    const size_t from = Column(frame.before, slot);
+    if (m_entityIds[from] != entity_id) return false;
+    const size_t after = Column(frame.after, slot);
+    const size_t to = m_entityIds[after] == entity_id ? after : from;
+
+    const float t = frame.t;
+    out.entity_id = entity_id;
+    out.position = {Lerp(m_posX[from], m_posX[to], t), Lerp(m_posY[from], m_posY[to], t),
+                    Lerp(m_posZ[from], m_posZ[to], t)};
+    out.velocity = {Lerp(m_velX[from], m_velX[to], t), Lerp(m_velY[from], m_velY[to], t),
+                    Lerp(m_velZ[from], m_velZ[to], t)};
+    out.half_extents = {Lerp(m_extX[from], m_extX[to], t), Lerp(m_extY[from], m_extY[to], t),
+                        Lerp(m_extZ[from], m_extZ[to], t)};
+    out.alive = m_alive[to] != 0;
+    if (frame.extrapolate_seconds > 0.0f) {
+        out.position.x += out.velocity.x * frame.extrapolate_seconds;
+        out.position.y += out.velocity.y * frame.extrapolate_seconds;
+        out.position.z += out.velocity.z * frame.extrapolate_seconds;
+    }
+    m_entitiesRewound.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+std::optional<RewoundEntity> RewindHistory::GetEntityAt(uint64_t entity_id, Clock::time_point time) const {
+    m_queries.fetch_add(1, std::memory_order_relaxed);
+    auto it = m_slots.find(entity_id);
+    const auto frame = Locate(time);
+    if (it == m_slots.end() || !frame) return std::nullopt;
+
+    RewoundEntity entity;
+    if (!Rewind(*frame, it->second, entity_id, entity)) return std::nullopt;
+    return entity;
+}
+
+// [SEQUENCE: MVP19-204] Broad phase: an entity's interpolated hitbox lies within its earlier-frame position
+// padded by the largest extent and the largest move into the later frame (plus the extrapolation distance), so
+// slots whose earlier position falls outside every area grown by that padding cannot overlap any of them. The flag
+// loop reads the x and y columns only and has no branches, so it vectorizes; fn runs for flagged slots alone.
+template <typename Fn>
+void RewindHistory::ForEachNear(const FrameRef& frame, const Area* areas, size_t area_count, Fn&& fn) const {
+    const float margin = std::max(m_maxExtent[frame.before], m_maxExtent[frame.after]) +
+                         (frame.after != frame.before ? m_maxStep[frame.after] : 0.0f) +
+                         m_maxSpeed[frame.after] * frame.extrapolate_seconds;
+    const float* xs = m_posX.data() + Column(frame.before, 0);
+    const float* ys = m_posY.data() + Column(frame.before, 0);
+
+    uint8_t near[kBlockSize];
+    for (size_t block = 0; block < m_slotHighWater; block += kBlockSize) {
+        const float* x = xs + block;
+        const float* y = ys + block;
+        std::fill_n(near, kBlockSize, 0);
+        for (size_t k = 0; k < area_count; ++k) {
+            const float lo_x = areas[k].min_x - margin, hi_x = areas[k].max_x + margin;
+            const float lo_y = areas[k].min_y - margin, hi_y = areas[k].max_y + margin;
+            for (size_t i = 0; i < kBlockSize; ++i) {
+                near[i] |= static_cast<uint8_t>((x[i] >= lo_x) & (x[i] <= hi_x) & (y[i] >= lo_y) & (y[i] <= hi_y));
+            }
+        }
+        for (size_t i = 0; i < kBlockSize; ++i) {
+            if (near[i]) fn(static_cast<uint32_t>(block + i));
+        }
+    }
+}
+
+void RewindHistory::CollectNear(const FrameRef& frame, const Area* areas, size_t area_count,
+                                std::vector<uint32_t>& slots) const {
+    ForEachNear(frame, areas, area_count, [&](uint32_t slot) {
+        if (m_entityIds[Column(frame.before, slot)] != 0) slots.push_back(slot);
+    });
+}
+
+bool RewindHistory::RewindSlot(const FrameRef& frame, uint32_t slot, RewoundEntity& out) const {
+    const uint64_t entity_id = m_entityIds[Column(frame.before, slot)];
+    return entity_id != 0 && Rewind(frame, slot, entity_id, out);
+}
+
+std::optional<uint32_t> RewindHistory::FindSlot(uint64_t entity_id) const {
+    auto it = m_slots.find(entity_id);
+    if (it == m_slots.end()) return std::nullopt;
+    return it->second;
+}
+
+// Ties go to the lower entity id so the result does not depend on slot assignment.
+std::optional<RewindRayHit> RewindHistory::RaycastAt(Clock::time_point time, const core::utils::Vector3& origin,
+                                                     const core::utils::Vector3& direction, float max_distance,
+                                                     uint64_t ignore_entity) const {
+    m_queries.fetch_add(1, std::memory_order_relaxed);
+    const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+    const auto frame = Locate(time);
+    if (!frame || length <= 0.0f || max_distance <= 0.0f) return std::nullopt;
+
+    const core::utils::Vector3 unit{direction.x / length, direction.y / length, direction.z / length};
+    const float end_x = origin.x + unit.x * max_distance;
+    const float end_y = origin.y + unit.y * max_distance;
+    const Area segment{std::min(origin.x, end_x), std::min(origin.y, end_y), std::max(origin.x, end_x),
+                       std::max(origin.y, end_y)};
+
+    std::optional<RewindRayHit> best;
+    float best_distance = max_distance;
+    ForEachNear(*frame, &segment, 1, [&](uint32_t slot) {
+        RewoundEntity entity;
+        if (!RewindSlot(*frame, slot, entity) || entity.entity_id == ignore_entity || !entity.alive) return;
+
+        const core::utils::Vector3 box_lo{entity.position.x - entity.half_extents.x,
+                                          entity.position.y - entity.half_extents.y,
+                                          entity.position.z - entity.half_extents.z};
+        const core::utils::Vector3 box_hi{entity.position.x + entity.half_extents.x,
+                                          entity.position.y + entity.half_extents.y,
+                                          entity.position.z + entity.half_extents.z};
+        float entry;
+        if (RayBox(origin, unit, best_distance, box_lo, box_hi, entry) &&
+            (!best || entry < best_distance || (entry == best_distance && entity.entity_id < best->entity_id))) {
+            best_distance = entry;
+            best = RewindRayHit{entity.entity_id, entry,
+                                {origin.x + unit.x * entry, origin.y + unit.y * entry, origin.z + unit.z * entry}};
+        }
+    });
+    return best;
+}
+
+std::optional<RewindHistory::Clock::time_point> RewindHistory::GetOldestTime() const {
+    if (m_frameCount == 0) return std::nullopt;
+    return m_timestamps[Physical(0)];
+}
+
+std::optional<RewindHistory::Clock::time_point> RewindHistory::GetNewestTime() const {
+    if (m_frameCount == 0) return std::nullopt;
+    return m_timestamps[Physical(m_frameCount - 1)];
+}
+
+size_t RewindHistory::GetMemoryFootprint() const {
+    const size_t cells = m_config.frame_capacity * m_stride;
+    return cells * (sizeof(uint64_t) + 9 * sizeof(float) + sizeof(uint8_t)) +
+           m_config.frame_capacity * (sizeof(Clock::time_point) + 3 * sizeof(float));
+}
+
+RewindHistory::Stats RewindHistory::GetStats() const {
+    Stats stats;
+    stats.frames_recorded = m_framesRecorded;
+    stats.queries = m_queries.load(std::memory_order_relaxed);
+    stats.entities_rewound = m_entitiesRewound.load(std::memory_order_relaxed);
+    stats.slots_exhausted = m_slotsExhausted;
+    return stats;
+}
+
+} // namespace mmorpg::network
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "core/utils/vector3.h"
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-199] Sizing for RewindHistory. Everything is allocated up front from these; recording never
+// allocates. The defaults hold a little over one second of 60 Hz frames for 5000 entities.
+struct RewindHistoryConfig {
+    size_t frame_capacity = 72;
+    size_t max_entities = 5000;
+    std::chrono::milliseconds extrapolation_limit{200};   // Past the newest frame, move by velocity at most this long
+};
+
+// [SEQUENCE: MVP19-200] One entity as it was at a rewound time. The hitbox is position +- half_extents.
+struct RewoundEntity {
+    uint64_t entity_id = 0;
+    core::utils::Vector3 position;
+    core::utils::Vector3 velocity;
+    core::utils::Vector3 half_extents;
+    bool alive = false;
+};
+
+struct RewindRayHit {
+    uint64_t entity_id = 0;
+    float distance = 0.0f;   // Along the normalized direction from the ray origin
+    core::utils::Vector3 point;
+};
+
+// [SEQUENCE: MVP19-201] Fixed ring of recent frames for lag-compensated hit validation, stored column-wise.
+//
+// Each entity owns a dense slot for as long as it is tracked, and every frame has one column per field indexed
+// by slot (entity id, position, velocity, hitbox half extents, alive), so recording a frame is a write per
+// entity with no allocation and no per-frame map. A frame only holds the entities recorded into it; a slot's id
+// column tells whether the entity in it was present then, so slots can be reused without invalidating old frames.
+//
+// Queries binary-search the ring on timestamp and interpolate between the two frames around the requested time.
+// GetEntityAt rewinds one entity. RaycastAt reads only the earlier frame's x and y columns, testing each slot
+// branch-free against the ray's bounding box padded by how far any hitbox reached or moved in that interval, and
+// interpolates and ray-tests only the entities that pass. A teleport widens the padding for the frames around it.
+//
+// Recording and queries must not overlap; queries are const and may run concurrently with each other.
+class RewindHistory {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        uint64_t frames_recorded = 0;
+        uint64_t queries = 0;
+        uint64_t entities_rewound = 0;   // Interpolated in a query; a broad-phase reject does not count
+        uint64_t slots_exhausted = 0;    // Records dropped because max_entities were already tracked
+    };
+
+    explicit RewindHistory(const RewindHistoryConfig& config = {});
+
+    // Starts a frame, overwriting the oldest once the ring is full. Timestamps must not decrease.
+    void BeginFrame(Clock::time_point timestamp);
+
+    // Records entity into the current frame, assigning it a slot on first sight. Returns false if no slot is free.
+    bool Record(uint64_t entity_id, const core::utils::Vector3& position, const core::utils::Vector3& velocity,
+                const core::utils::Vector3& half_extents, bool alive);
+
+    // Frees the entity's slot. Frames already recorded keep their copy, which RaycastAt still sees, but the
+    // entity can no longer be rewound by id.
+    void RemoveEntity(uint64_t entity_id);
+
+    std::optional<RewoundEntity> GetEntityAt(uint64_t entity_id, Clock::time_point time) const;
+
+    // Nearest live hitbox the ray enters within max_distance at time, skipping ignore_entity.
+    std::optional<RewindRayHit> RaycastAt(Clock::time_point time, const core::utils::Vector3& origin,
+                                          const core::utils::Vector3& direction, float max_distance,
+                                          uint64_t ignore_entity = 0) const;
+
+    // [SEQUENCE: MVP19-214] Building blocks for batched queries: locate a time once, gather the slots near a set of
+    // ground-plane areas in one pass over the columns, then rewind those slots. Same thread-safety as above.
+    struct FrameRef {
+        size_t before;
+        size_t after;
+        float t;                     // Blend from before to after; before == after when no blending is needed
+        float extrapolate_seconds;   // > 0 only past the newest frame
+    };
+
+    struct Area {
+        float min_x, min_y, max_x, max_y;
+    };
+
+    std::optional<FrameRef> Locate(Clock::time_point time) const;
+    // Appends, in ascending order, every slot whose occupant at frame may overlap at least one of the areas.
+    void CollectNear(const FrameRef& frame, const Area* areas, size_t area_count, std::vector<uint32_t>& slots) const;
+    // Rewinds whoever occupied slot in the frame's earlier snapshot; false if nobody did.
+    bool RewindSlot(const FrameRef& frame, uint32_t slot, RewoundEntity& out) const;
+    std::optional<uint32_t> FindSlot(uint64_t entity_id) const;
+
+    size_t GetFrameCount() const { return m_frameCount; }
+    std::optional<Clock::time_point> GetOldestTime() const;
+    std::optional<Clock::time_point> GetNewestTime() const;
+    size_t GetTrackedEntityCount() const { return m_slots.size(); }
+    size_t GetMemoryFootprint() const;
+    const RewindHistoryConfig& GetConfig() const { return m_config; }
+
+    Stats GetStats() const;
+
+private:
+    template <typename Fn>
+    void ForEachNear(const FrameRef& frame, const Area* areas, size_t area_count, Fn&& fn) const;
+    size_t Physical(size_t logical) const { return (m_head + logical) % m_config.frame_capacity; }
+    size_t Column(size_t frame, size_t slot) const { return frame * m_stride + slot; }
+    bool Rewind(const FrameRef& frame, uint32_t slot, uint64_t entity_id, RewoundEntity& out) const;
+
+    RewindHistoryConfig m_config;
+    size_t m_stride;   // Slots per frame, max_entities rounded up to whole broad-phase blocks
+
+    // Ring of frames, m_head the oldest
+    std::vector<Clock::time_point> m_timestamps;
+    // Per frame: largest half extent, largest per-axis move since the previous frame, largest per-axis speed
+    std::vector<float> m_maxExtent, m_maxStep, m_maxSpeed;
+    size_t m_head = 0;
+    size_t m_frameCount = 0;
+    size_t m_current = 0;
+
+    // Columns of frame_capacity * m_stride, frame-major
+    std::vector<uint64_t> m_entityIds;   // 0 = slot empty in that frame
+    std::vector<float> m_posX, m_posY, m_posZ;
+    std::vector<float> m_velX, m_velY, m_velZ;
+    std::vector<float> m_extX, m_extY, m_extZ;
+    std::vector<uint8_t> m_alive;
+
+    std::unordered_map<uint64_t, uint32_t> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    uint32_t m_slotHighWater = 0;   // Queries scan [0, high water)
+
+    uint64_t m_framesRecorded = 0;
+    uint64_t m_slotsExhausted = 0;
+    mutable std::atomic<uint64_t> m_queries{0};
+    mutable std::atomic<uint64_t> m_entitiesRewound{0};
+};
+
+} // namespace mmorpg::network
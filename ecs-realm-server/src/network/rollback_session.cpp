@@ -0,0 +1,234 @@
+#include "network/rollback_session.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+
+namespace mmorpg::network {
+
+namespace {
+constexpr uint32_t kNoFrame = UINT32_MAX;
+}
+
+RollbackSession::RollbackSession(size_t player_count, StepFn step, const RollbackConfig& config)
+    : m_config(config)
+    , m_players(player_count)
+    , m_step(std::move(step))
+    , m_pageSize(std::bit_ceil(std::max<size_t>(config.page_size, 16)))
+    , m_pageShift(static_cast<uint32_t>(std::countr_zero(m_pageSize)))
+    , m_lastKnown(player_count)
+    , m_lastKnownFrame(player_count, kNoFrame)
+    , m_frameInputs(player_count) {
+    const size_t history = std::max<size_t>(config.max_rollback_frames, 1);
+    const size_t window = std::bit_ceil(std::max(config.input_window, history * 2));
+    m_inputs.resize(window * m_players);
+    m_inputMask = static_cast<uint32_t>(window - 1);
+    m_records.resize(history);
+}
+
+size_t RollbackSession::RegisterRegion(void* data, size_t bytes) {
+    Region region;
+    region.data = static_cast<std::byte*>(data);
+    region.bytes = bytes;
+    region.virtual_offset = m_virtualBytes;
+    const size_t pages = (bytes + m_pageSize - 1) >> m_pageShift;
+    m_pageRegion.insert(m_pageRegion.end(), pages, static_cast<uint32_t>(m_regions.size()));
+    m_virtualBytes += pages << m_pageShift;
+    m_regions.push_back(region);
+    Allocate();
+    return m_regions.size() - 1;
+}
+
+void RollbackSession::Allocate() {
+    const size_t pages = m_pageRegion.size();
+    for (auto& record : m_records) {
+        record.pages.resize(pages);
+        record.data.resize(pages << m_pageShift);
+    }
+    m_dirty.assign((pages + 63) / 64, 0);
+}
+
+// [SEQUENCE: MVP19-247] Write barrier: the first write to a page in a frame saves what the page held before it.
+void RollbackSession::Touch(size_t virtual_offset, size_t bytes) {
+    if (!m_recording) {
+        return;   // Setup before the first frame
+    }
+    const size_t first = virtual_offset >> m_pageShift;
+    const size_t last = (virtual_offset + bytes - 1) >> m_pageShift;
+    for (size_t page = first; page <= last; ++page) {
+        const uint64_t bit = uint64_t{1} << (page & 63);
+        if (!(m_dirty[page >> 6] & bit)) {
+            m_dirty[page >> 6] |= bit;
+            SavePage(static_cast<uint32_t>(page));
+        }
+    }
+}
+
+void RollbackSession::SavePage(uint32_t page) {
+    const Region& region = m_regions[m_pageRegion[page]];
+    const size_t start = (static_cast<size_t>(page) << m_pageShift) - region.virtual_offset;
+    const size_t length = std::min(m_pageSize, region.bytes - start);
+    FrameRecord& record = *m_recording;
+    std::memcpy(record.data.data() + (record.page_count << m_pageShift), region.data + start, length);
+    record.pages[record.page_count++] = page;
+    ++m_stats.pages_saved;
+}
+
+// [SEQUENCE: MVP19-248] Undoes frames newest-first down to and including `frame`, leaving the state it started from.
+void RollbackSession::RestoreTo(uint32_t frame) {
+    for (uint32_t undo = m_current; undo-- > frame;) {
+        const FrameRecord& record = m_records[undo % m_records.size()];
+        for (size_t i = 0; i < record.page_count; ++i) {
+            const uint32_t page = record.pages[i];
+            const Region& region = m_regions[m_pageRegion[page]];
+            const size_t start = (static_cast<size_t>(page) << m_pageShift) - region.virtual_offset;
+            std::memcpy(region.data + start, record.data.data() + (i << m_pageShift),
+                        std::min(m_pageSize, region.bytes - start));
+        }
+    }
+}
+
+uint32_t RollbackSession::GetOldestRestorableFrame() const {
+    const uint32_t history = static_cast<uint32_t>(m_records.size());
+    return m_current > history ? m_current - history : 0;
+}
+
+TickInput RollbackSession::Predict(size_t player, uint32_t frame) const {
+    // The latest earlier confirmed input still in the window, else the newest ever seen if it is older
+    const uint32_t window = m_inputMask + 1;
+    const uint32_t floor = frame > window ? frame - window : 0;
+    for (uint32_t earlier = frame; earlier-- > floor;) {
+        const InputSlot& slot = SlotFor(player, earlier);
+        if (slot.frame == earlier && slot.confirmed) {
+            TickInput predicted = slot.input;
+            predicted.sequence = frame;
+            return predicted;
+        }
+    }
+    TickInput predicted;
+    if (m_lastKnownFrame[player] != kNoFrame && m_lastKnownFrame[player] < frame) {
+        predicted = m_lastKnown[player];
+    }
+    predicted.sequence = frame;
+    return predicted;
+}
+
+// [SEQUENCE: MVP19-249] A late input either confirms the prediction or marks its frame for resimulation.
+RollbackSession::InputResult RollbackSession::AddInput(size_t player, uint32_t frame, const TickInput& input) {
+    const uint32_t window = m_inputMask + 1;
+    const uint32_t history = static_cast<uint32_t>(m_records.size());
+    if (player >= m_players || frame >= m_current + window - history) {
+        return InputResult::TooFarAhead;
+    }
+    TickInput stamped = input;
+    stamped.sequence = frame;   // Within a session, inputs are identified by frame
+
+    if (m_lastKnownFrame[player] == kNoFrame || frame > m_lastKnownFrame[player]) {
+        m_lastKnown[player] = stamped;
+        m_lastKnownFrame[player] = frame;
+    }
+
+    const uint32_t oldest = GetOldestRestorableFrame();
+    if (frame < oldest) {
+        ++m_stats.beyond_budget;
+        m_rollbackFrom = std::min(m_rollbackFrom, oldest);   // Re-predict what is still held from this input
+        return InputResult::BeyondBudget;
+    }
+
+    InputSlot& slot = SlotFor(player, frame);
+    if (slot.frame == frame && slot.confirmed) {
+        return InputResult::Duplicate;
+    }
+    if (frame >= m_current) {
+        slot = InputSlot{};
+        slot.frame = frame;
+        slot.confirmed = true;
+        slot.input = stamped;
+        return InputResult::Accepted;
+    }
+
+    slot.confirmed = true;
+    slot.input = stamped;
+    if (slot.used == stamped) {
+        return InputResult::Accepted;
+    }
+    ++m_stats.mispredictions;
+    m_rollbackFrom = std::min(m_rollbackFrom, frame);
+    return InputResult::Mispredicted;
+}
+
+void RollbackSession::SimulateFrame(uint32_t frame) {
+    FrameRecord& record = m_records[frame % m_records.size()];
+    record.frame = frame;
+    record.page_count = 0;
+    std::fill(m_dirty.begin(), m_dirty.end(), 0);
+
+    for (size_t player = 0; player < m_players; ++player) {
+        InputSlot& slot = SlotFor(player, frame);
+        if (slot.frame != frame) {
+            slot = InputSlot{};
+            slot.frame = frame;
+        }
+        slot.used = slot.confirmed ? slot.input : Predict(player, frame);
+        m_frameInputs[player] = slot.used;
+    }
+
+    m_recording = &record;
+    m_step(frame, m_frameInputs.data(), m_players);
+    m_recording = nullptr;
+}
+
+// [SEQUENCE: MVP19-250] One tick: repair the past if an input changed it, then simulate the present.
+void RollbackSession::AdvanceFrame() {
+    const auto start = std::chrono::steady_clock::now();
+    m_started = true;
+
+    if (m_rollbackFrom < m_current) {
+        const uint32_t from = std::max(m_rollbackFrom, GetOldestRestorableFrame());
+        RestoreTo(from);
+        for (uint32_t frame = from; frame < m_current; ++frame) {
+            SimulateFrame(frame);
+        }
+        ++m_stats.rollbacks;
+        m_stats.frames_resimulated += m_current - from;
+        m_stats.max_rollback_depth = std::max(m_stats.max_rollback_depth, m_current - from);
+    }
+    m_rollbackFrom = kNoFrame;
+
+    SimulateFrame(m_current);
+    ++m_current;
+    ++m_stats.frames;
+    m_stats.last_advance_us =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+TickInput RollbackSession::GetInputUsed(size_t player, uint32_t frame) const {
+    const InputSlot& slot = SlotFor(player, frame);
+    return slot.frame == frame ? slot.used : TickInput{};
+}
+
+bool RollbackSession::IsConfirmed(size_t player, uint32_t frame) const {
+    const InputSlot& slot = SlotFor(player, frame);
+    return slot.frame == frame && slot.confirmed;
+}
+
+uint64_t RollbackSession::ComputeChecksum() const {
+    uint64_t hash = 14695981039346656037ull;
+    for (const auto& region : m_regions) {
+        for (size_t i = 0; i < region.bytes; ++i) {
+            hash = (hash ^ static_cast<uint8_t>(region.data[i])) * 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+size_t RollbackSession::GetMemoryFootprint() const {
+    size_t bytes = m_inputs.size() * sizeof(InputSlot) + m_dirty.size() * sizeof(uint64_t);
+    for (const auto& record : m_records) {
+        bytes += record.pages.size() * sizeof(uint32_t) + record.data.size();
+    }
+    return bytes;
+}
+
+} // namespace mmorpg::network
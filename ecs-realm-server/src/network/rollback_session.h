@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "network/input_jitter_buffer.h"
+
+namespace mmorpg::network {
+
+class RollbackSession;
+
+// [SEQUENCE: MVP19-244] Sizing for a RollbackSession. History is allocated as columns are registered; running
+// frames never allocates.
+struct RollbackConfig {
+    size_t max_rollback_frames = 8;   // How far back a late input can still be applied exactly
+    size_t input_window = 64;         // Frames of inputs held, past and future; rounded up to a power of two
+    size_t page_size = 128;           // Copy-on-write granularity in bytes; rounded up to a power of two
+};
+
+// [SEQUENCE: MVP19-245] A registered array of simulation state. Reads are plain; writes go through Write(), which
+// saves the touched page's pre-frame contents the first time it is dirtied in a frame.
+template <typename T>
+class RollbackColumn {
+    static_assert(std::is_trivially_copyable_v<T>, "Rollback state must be plain data");
+
+public:
+    RollbackColumn() = default;
+
+    size_t size() const { return m_count; }
+    const T& operator[](size_t index) const { return m_data[index]; }
+    T& Write(size_t index);
+
+private:
+    friend class RollbackSession;
+    RollbackColumn(RollbackSession* session, T* data, size_t count, size_t virtual_offset)
+        : m_session(session), m_data(data), m_count(count), m_virtualOffset(virtual_offset) {}
+
+    RollbackSession* m_session = nullptr;
+    T* m_data = nullptr;
+    size_t m_count = 0;
+    size_t m_virtualOffset = 0;
+};
+
+// [SEQUENCE: MVP19-246] Rollback engine for a small fixed-membership match, such as an arena.
+//
+// The match state lives in plain arrays owned by the caller and registered as columns. Each frame, every
+// player's input for it is fed to a single step function. Confirmed inputs are used as they are, and missing
+// ones are predicted by repeating the player's latest earlier input. A frame keeps a compact record in a fixed
+// ring of max_rollback_frames: the inputs it used and the pre-images of only those pages of state it dirtied.
+//
+// An input arriving for an earlier frame that differs from what was predicted marks that frame. The next
+// AdvanceFrame restores the state as it was before that frame by replaying the page pre-images newest-first.
+// It then runs the same step function over the frames since, with the corrected inputs, before simulating the
+// new frame. Resimulation and the first run are the same code path, so a deterministic step reproduces the
+// result of having had every input on time.
+//
+// Past max_rollback_frames the session degrades instead of stalling. A too-old input cannot be applied to its
+// own frame, so it becomes the player's latest known input, and the session resimulates from the oldest frame
+// it still holds. The divergence is counted so the caller can send a full-state correction.
+class RollbackSession {
+public:
+    // frame is the frame being simulated; inputs[p] is player p's input for it
+    using StepFn = std::function<void(uint32_t frame, const TickInput* inputs, size_t player_count)>;
+
+    enum class InputResult : uint8_t {
+        Accepted,       // For the current frame or later, or matched the prediction used
+        Mispredicted,   // Differs from what frame was simulated with; rolled back at the next AdvanceFrame
+        BeyondBudget,   // Older than the history held; applied from the oldest frame held instead
+        TooFarAhead,
+        Duplicate,
+    };
+
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t rollbacks = 0;
+        uint64_t frames_resimulated = 0;
+        uint64_t pages_saved = 0;
+        uint64_t mispredictions = 0;
+        uint64_t beyond_budget = 0;
+        uint32_t max_rollback_depth = 0;
+        double last_advance_us = 0.0;
+    };
+
+    RollbackSession(size_t player_count, StepFn step, const RollbackConfig& config = {});
+
+    RollbackSession(const RollbackSession&) = delete;
+    RollbackSession& operator=(const RollbackSession&) = delete;
+
+    // Registers count elements at data as rollback state. Only before the first AdvanceFrame: later calls throw
+    // std::logic_error, since frames already recorded could not restore the new state. count 0 returns an
+    // empty column.
+    template <typename T>
+    RollbackColumn<T> RegisterColumn(T* data, size_t count);
+
+    InputResult AddInput(size_t player, uint32_t frame, const TickInput& input);
+
+    // Rolls back and resimulates if any past input changed, then simulates GetCurrentFrame() and advances it.
+    void AdvanceFrame();
+
+    uint32_t GetCurrentFrame() const { return m_current; }
+    // Oldest frame a late input can still be applied to exactly
+    uint32_t GetOldestRestorableFrame() const;
+    // The input frame was (or will be) simulated with for player
+    TickInput GetInputUsed(size_t player, uint32_t frame) const;
+    bool IsConfirmed(size_t player, uint32_t frame) const;
+
+    // FNV-1a over every registered column, for determinism checks
+    uint64_t ComputeChecksum() const;
+    size_t GetMemoryFootprint() const;
+    const Stats& GetStats() const { return m_stats; }
+    const RollbackConfig& GetConfig() const { return m_config; }
+
+private:
+    template <typename T>
+    friend class RollbackColumn;
+
+    struct Region {
+        std::byte* data = nullptr;
+        size_t bytes = 0;
+        size_t virtual_offset = 0;   // Page-aligned start in the combined page space
+    };
+
+    struct InputSlot {
+        TickInput input;    // Confirmed input, if confirmed
+        TickInput used;     // What the frame was simulated with
+        uint32_t frame = UINT32_MAX;
+        bool confirmed = false;
+    };
+
+    // Copy-on-write undo record of one simulated frame
+    struct FrameRecord {
+        uint32_t frame = UINT32_MAX;
+        size_t page_count = 0;
+        std::vector<uint32_t> pages;
+        std::vector<std::byte> data;   // page_count pre-images, page_size apart
+    };
+
+    size_t RegisterRegion(void* data, size_t bytes);
+    void Touch(size_t virtual_offset, size_t bytes);
+    void SavePage(uint32_t page);
+    void Allocate();
+    void SimulateFrame(uint32_t frame);
+    void RestoreTo(uint32_t frame);
+    InputSlot& SlotFor(size_t player, uint32_t frame) { return m_inputs[(frame & m_inputMask) * m_players + player]; }
+    const InputSlot& SlotFor(size_t player, uint32_t frame) const {
+        return m_inputs[(frame & m_inputMask) * m_players + player];
+    }
+    TickInput Predict(size_t player, uint32_t frame) const;
+
+    const RollbackConfig m_config;
+    const size_t m_players;
+    StepFn m_step;
+    size_t m_pageSize = 0;
+    uint32_t m_pageShift = 0;
+
+    std::vector<Region> m_regions;
+    std::vector<uint32_t> m_pageRegion;   // Page -> region
+    size_t m_virtualBytes = 0;
+    bool m_started = false;
+
+    std::vector<FrameRecord> m_records;   // Ring, frame % max_rollback_frames
+    FrameRecord* m_recording = nullptr;
+    std::vector<uint64_t> m_dirty;        // Pages saved in the frame being simulated
+
+    std::vector<InputSlot> m_inputs;      // Ring of input_window frames, player-minor
+    uint32_t m_inputMask = 0;
+    std::vector<TickInput> m_lastKnown;   // Newest confirmed input by frame, per player
+    std::vector<uint32_t> m_lastKnownFrame;
+    std::vector<TickInput> m_frameInputs; // Scratch handed to the step function
+
+    uint32_t m_current = 0;
+    uint32_t m_rollbackFrom = UINT32_MAX;
+    Stats m_stats;
+};
+
+template <typename T>
+T& RollbackColumn<T>::Write(size_t index) {
+    m_session->Touch(m_virtualOffset + index * sizeof(T), sizeof(T));
+    return m_data[index];
+}
+
+template <typename T>
+RollbackColumn<T> RollbackSession::RegisterColumn(T* data, size_t count) {
+    if (m_started) {
+        throw std::logic_error("RollbackSession::RegisterColumn after the first AdvanceFrame");
+    }
+    if (count == 0) {
+        return {};
+    }
+    const size_t offset = m_regions[RegisterRegion(data, count * sizeof(T))].virtual_offset;
+    return RollbackColumn<T>(this, data, count, offset);
+}
+
+} // namespace mmorpg::network
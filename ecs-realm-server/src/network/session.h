@@ -5,13 +5,20 @@
 #include <boost/asio/ip/udp.hpp>
 #include <memory>
 #include <vector>
-#include <deque>
 #include <atomic>
 #include <string>
 #include <cstdint>
 #include <optional>
+#include <mutex>
+#include <array>
 
 #include "proto/packet.pb.h"
+#include "network/packet_dispatch.h"
+#include "network/packet_serializer.h"
+#include "network/udp_datagram.h"
+#include "network/udp_reliability.h"
+#include "network/kernel_tls.h"
+#include "network/session_send_queue.h"
 
 // Forward declarations
 namespace google::protobuf {
@@ -26,6 +33,37 @@ namespace mmorpg::network {
 using boost::asio::ip::tcp;
 using boost::asio::ip::udp;
 
+// [SEQUENCE: MVP19-27] Caps for coalescing queued packets into a single write.
+// A flush takes queued packets until either cap would be exceeded; a single packet larger than
+// max_flush_bytes is still sent on its own.
+struct SessionWriteConfig {
+    size_t max_flush_bytes = 64 * 1024;
+    size_t max_flush_messages = 256;
+    // [SEQUENCE: MVP19-122] Move the TLS record layer into the kernel after the handshake. Needs the server
+    // context prepared with kernel_tls::InstallSecretCapture; sessions that cannot offload stay on ssl::stream.
+    bool kernel_tls = false;
+    // [SEQUENCE: MVP19-289] Priority classes, superseding, pacing and the memory cap for the outbound queue
+    SessionSendQueueConfig send_queue;
+};
+
+// [SEQUENCE: MVP19-28] Snapshot of a session's outbound counters.
+struct SessionWriteStats {
+    uint64_t flushes = 0;              // Number of async_write calls issued
+    uint64_t messages_flushed = 0;     // Packets written across all flushes
+    uint64_t bytes_flushed = 0;
+    uint64_t max_flush_messages = 0;   // Largest batch seen in a single flush
+    uint64_t max_queue_depth = 0;      // Peak number of packets waiting behind an in-flight write
+    uint64_t queue_depth = 0;          // Packets currently queued
+    // [SEQUENCE: MVP19-290] Scheduler counters, see SessionSendQueueStats
+    uint64_t queued_bytes = 0;
+    uint64_t max_queued_bytes = 0;
+    uint64_t superseded = 0;
+    uint64_t promoted = 0;
+    uint64_t throttled = 0;
+    uint64_t send_rate = 0;            // Token bucket rate, bytes per second
+    bool overflowed = false;           // Disconnected for exceeding the queue's memory cap
+};
+
 enum class SessionState {
     Connecting,
     Handshake,
@@ -33,14 +71,39 @@ enum class SessionState {
     Disconnected
 };
 
+// [SEQUENCE: MVP19-270] Which transport carries a session's packets.
+enum class SessionTransportKind : uint8_t {
+    TcpTls,
+    Quic,
+};
+
+// [SEQUENCE: MVP19-271] A packet transport other than the session's own TLS stream. The session hands it whole
+// framed packets (length prefix + envelope, as SerializeInto produces them) and it decides how they travel;
+// inbound packets come back through Session::DeliverTransportPacket. Implementations must be thread-safe.
+class SessionTransport {
+public:
+    virtual ~SessionTransport() = default;
+    virtual void SendPacket(mmorpg::proto::PacketType type, const std::byte* data, size_t size) = 0;
+    virtual void Close() = 0;
+    virtual std::string GetRemoteAddress() const = 0;
+    virtual SessionTransportKind GetKind() const = 0;
+};
+
 class Session : public std::enable_shared_from_this<Session> {
 public:
-    Session(tcp::socket socket, boost::asio::ssl::context& context, uint32_t session_id, std::shared_ptr<IPacketHandler> handler);
+    Session(tcp::socket socket, boost::asio::ssl::context& context, uint32_t session_id, std::shared_ptr<IPacketHandler> handler,
+            SessionWriteConfig write_config = {});
+    // [SEQUENCE: MVP19-272] A session carried by another transport. Packet handlers see the same Session API;
+    // Send and Disconnect go to the transport, and the TLS stream is never used.
+    Session(boost::asio::any_io_executor executor, uint32_t session_id, std::shared_ptr<IPacketHandler> handler,
+            std::shared_ptr<SessionTransport> transport);
     ~Session();
 
     void Start();
     void Disconnect();
     void Send(const google::protobuf::Message& message);
+    // [SEQUENCE: MVP19-35] Queues an already-framed packet shared with other sessions. No serialization or copy.
+    void SendShared(SharedPacketBuffer packet);
 
     tcp::socket& GetSocket() { return m_ssl_stream.next_layer(); }
     uint32_t GetSessionId() const { return m_sessionId; }
@@ -50,33 +113,106 @@ public:
     void SetAuthenticated(bool authenticated) { m_isAuthenticated = authenticated; }
     void Authenticate();
     void SetPlayerId(uint64_t player_id);
+    uint64_t GetPlayerId() const { return m_player_id.load(std::memory_order_acquire); }
 
     // [SEQUENCE: MVP6-26] Methods for UDP endpoint management within the session.
     void SetUdpEndpoint(const udp::endpoint& endpoint);
     std::optional<udp::endpoint> GetUdpEndpoint() const;
+    // [SEQUENCE: MVP19-436] The endpoint is read by UDP workers and by SessionManager while a re-registration may
+    // be changing it, so the accessors lock it. SessionManager also holds this mutex across a change and the
+    // endpoint-table updates that go with it, so two registrations (or one and Unregister) cannot interleave.
+    std::mutex& GetUdpEndpointChangeMutex() const { return m_udpEndpointChangeMutex; }
+
+    // [SEQUENCE: MVP19-67] Random per-session secret carried in every gameplay datagram header, and the
+    // session's UDP sequence/ack state. Both are safe to use from the UDP ingest workers.
+    uint64_t GetUdpToken() const { return m_udpToken; }
+    UdpChannelState& GetUdpChannel() { return m_udpChannel; }
+    // [SEQUENCE: MVP19-99] Per-session reliability layer on top of the UDP sequence state.
+    UdpReliableConnection& GetUdpConnection() { return m_udpConnection; }
+
+    SessionWriteStats GetWriteStats() const;
+    // [SEQUENCE: MVP19-312] Bytes flushed to sockets by every TLS session in the process, for load reports
+    static uint64_t GetProcessBytesFlushed();
+
+    // [SEQUENCE: MVP19-123] Once Enabled, reads and writes bypass ssl::stream and the socket carries plaintext
+    // for the kernel to frame, which also makes sendfile/splice usable for bulk transfers.
+    KernelTlsStatus GetKernelTlsStatus() const { return m_kernelTlsStatus.load(std::memory_order_acquire); }
+    bool IsKernelTlsActive() const { return GetKernelTlsStatus() == KernelTlsStatus::Enabled; }
+
+    SessionTransportKind GetTransportKind() const {
+        return m_transport ? m_transport->GetKind() : SessionTransportKind::TcpTls;
+    }
+    // Hands one packet (envelope, without the length prefix) from the transport to the packet handler. The
+    // transport must not call it concurrently for the same session.
+    void DeliverTransportPacket(const std::byte* data, size_t size);
 
 private:
     void DoHandshake();
+    // Returns false if the session cannot continue (keys were half-installed).
+    bool TryEnableKernelTls();
     void DoReadHeader();
     void DoReadBody(uint32_t body_size);
-    void ProcessPacket(std::vector<std::byte>&& buffer);
+    void ProcessPacket(const std::byte* data, size_t size);
     void DoWrite();
+    void SendViaTransport(const std::vector<std::byte>& packet);
+    static mmorpg::proto::PacketType FramedPacketType(const std::vector<std::byte>& packet);
+    // [SEQUENCE: MVP19-36] A queued packet is either a buffer owned by this session or a shared broadcast buffer.
+    using OutboundPacket = SessionSendQueue::Packet;
+    void EnqueueWrite(OutboundPacket&& packet);
+    void PublishQueueStats();
     void HandleError(const boost::system::error_code& ec);
 
     boost::asio::ssl::stream<tcp::socket> m_ssl_stream;
     boost::asio::strand<boost::asio::any_io_executor> m_strand;
+    const std::shared_ptr<SessionTransport> m_transport;
     std::atomic<SessionState> m_state;
     const uint32_t m_sessionId;
     std::shared_ptr<IPacketHandler> m_packetHandler;
 
+    // [SEQUENCE: MVP19-14] The header and body buffers are reused across packets, and decoded messages
+    // live in a per-session cache, so steady-state reads do not allocate.
+    std::array<std::byte, 4> m_headerBuffer{};
     std::vector<std::byte> m_readBuffer;
-    std::deque<std::vector<std::byte>> m_writeQueue;
+    PacketMessageCache m_messageCache;
+
+    // [SEQUENCE: MVP19-29] Write coalescing state. Only touched on the strand.
+    // Packets queued while a write is in flight are drained into m_flushBuffer by the next DoWrite.
+    SessionWriteConfig m_writeConfig;
+    std::vector<std::byte> m_flushBuffer;
+    bool m_writeInProgress = false;
+    SessionSendQueue m_sendQueue;
+    boost::asio::steady_timer m_sendTimer;   // Wakes DoWrite when the token bucket is empty
+    std::chrono::steady_clock::time_point m_writeStartedAt;
+
+    // [SEQUENCE: MVP19-124] Captured during the handshake and wiped as soon as the offload attempt is over.
+    KernelTlsSecrets m_kernelTlsSecrets;
+    std::atomic<KernelTlsStatus> m_kernelTlsStatus{KernelTlsStatus::Disabled};
+    bool m_kernelTls = false;   // Strand-only mirror of the status, read on every I/O call
+
+    std::atomic<uint64_t> m_statFlushes{0};
+    std::atomic<uint64_t> m_statMessagesFlushed{0};
+    std::atomic<uint64_t> m_statBytesFlushed{0};
+    std::atomic<uint64_t> m_statMaxFlushMessages{0};
+    std::atomic<uint64_t> m_statMaxQueueDepth{0};
+    std::atomic<uint64_t> m_statQueueDepth{0};
+    std::atomic<uint64_t> m_statQueuedBytes{0};
+    std::atomic<uint64_t> m_statMaxQueuedBytes{0};
+    std::atomic<uint64_t> m_statSuperseded{0};
+    std::atomic<uint64_t> m_statPromoted{0};
+    std::atomic<uint64_t> m_statThrottled{0};
+    std::atomic<uint64_t> m_statSendRate{0};
+    std::atomic<bool> m_statOverflowed{false};
 
     std::atomic<bool> m_isAuthenticated;
-    uint64_t m_player_id = 0;
+    std::atomic<uint64_t> m_player_id{0};
 
     // [SEQUENCE: MVP6-25] Stores the associated UDP endpoint for this session after a successful handshake.
     std::optional<udp::endpoint> m_udp_endpoint;
+    mutable std::mutex m_udpEndpointMutex;
+    mutable std::mutex m_udpEndpointChangeMutex;
+    const uint64_t m_udpToken;
+    UdpChannelState m_udpChannel;
+    UdpReliableConnection m_udpConnection;
 };
 
 }
@@ -0,0 +1,483 @@
+#include "network/session_handoff.h"
+
+#include "core/logger.h"
+#include "monitoring/metrics_collector.h"
+#include "network/cluster_framing.h"
+#include "network/packet_serializer.h"
+#include "network/quic_crypto.h"
+#include "network/session.h"
+#include "network/session_manager.h"
+
+#include <openssl/crypto.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+namespace mmorpg::network {
+
+namespace {
+
+// An accept carries no state, only a token and an address
+constexpr size_t kMaxAcceptBytes = 4096;
+// Room for the offer's other fields around the state
+constexpr size_t kOfferOverheadBytes = 4096;
+
+bool MacMatches(const std::string& expected, const std::string& presented) {
+    return expected.size() == presented.size() &&
+           CRYPTO_memcmp(expected.data(), presented.data(), expected.size()) == 0;
+}
+
+// Signed fields are fixed width or length prefixed, so two different messages never sign the same bytes
+void AppendU64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+void AppendString(std::vector<uint8_t>& out, std::string_view value) {
+    AppendU64(out, value.size());
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+std::string Mac(const std::string& secret, const std::vector<uint8_t>& signed_bytes) {
+    const QuicSecret mac = quic_crypto::HmacSha256(reinterpret_cast<const uint8_t*>(secret.data()), secret.size(),
+                                                   signed_bytes.data(), signed_bytes.size());
+    return std::string(reinterpret_cast<const char*>(mac.data()), mac.size());
+}
+
+uint64_t WallClockMs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+struct SessionHandoffService::Outgoing {
+    explicit Outgoing(const boost::asio::strand<boost::asio::io_context::executor_type>& strand)
+        : socket(strand), timer(strand) {}
+
+    boost::asio::ip::tcp::socket socket;
+    boost::asio::steady_timer timer;
+    std::vector<std::byte> offer;
+    std::array<std::byte, 4> header{};
+    std::vector<std::byte> body;
+    uint64_t handoff_id = 0;
+    uint64_t player_id = 0;
+    std::weak_ptr<Session> session;
+    HandOffDone done;
+    bool timed_out = false;
+    bool finished = false;
+};
+
+struct SessionHandoffService::Incoming {
+    Incoming(boost::asio::ip::tcp::socket&& accepted,
+             const boost::asio::strand<boost::asio::io_context::executor_type>& strand)
+        : socket(std::move(accepted)), timer(strand) {}
+
+    boost::asio::ip::tcp::socket socket;
+    boost::asio::steady_timer timer;
+    std::array<std::byte, 4> header{};
+    std::vector<std::byte> body;
+    std::vector<std::byte> reply;
+};
+
+SessionHandoffService::SessionHandoffService(boost::asio::io_context& io_context, SessionManager& session_manager,
+                                             SessionHandoffConfig config)
+    : m_sessionManager(session_manager),
+      m_config(std::move(config)),
+      m_strand(boost::asio::make_strand(io_context)),
+      m_acceptor(m_strand) {}
+
+bool SessionHandoffService::Listen(const boost::asio::ip::tcp::endpoint& endpoint) {
+    if (m_config.cluster_secret.empty()) {
+        LOG_ERROR("[SessionHandoff] Node {} has no cluster secret; not accepting offers", m_config.node_id);
+        return false;
+    }
+    boost::system::error_code ec;
+    m_acceptor.open(endpoint.protocol(), ec);
+    if (!ec) m_acceptor.set_option(boost::asio::socket_base::reuse_address(true), ec);
+    if (!ec) m_acceptor.bind(endpoint, ec);
+    if (!ec) m_acceptor.listen(boost::asio::socket_base::max_listen_connections, ec);
+    if (ec) {
+        LOG_ERROR("[SessionHandoff] Node {} failed to listen on {}:{}: {}", m_config.node_id,
+                  endpoint.address().to_string(), endpoint.port(), ec.message());
+        return false;
+    }
+    boost::asio::post(m_strand, [self = shared_from_this()] { self->DoAccept(); });
+    return true;
+}
+
+uint16_t SessionHandoffService::GetListenPort() const {
+    boost::system::error_code ec;
+    return m_acceptor.local_endpoint(ec).port();
+}
+
+void SessionHandoffService::Stop() {
+    boost::asio::post(m_strand, [self = shared_from_this()] {
+        boost::system::error_code ignored;
+        self->m_acceptor.close(ignored);
+        for (auto& [token, parked] : self->m_parked) parked.expiry->cancel();
+        self->m_parked.clear();
+        self->m_statParked.store(0, std::memory_order_relaxed);
+    });
+}
+
+// [SEQUENCE: MVP19-314] Source side. The state is exported before anything is sent, so the offer carries the
+// player exactly as it was when the handoff began; one timer bounds connect, write and the accept read.
+void SessionHandoffService::HandOff(uint64_t player_id, const boost::asio::ip::tcp::endpoint& target,
+                                    HandOffDone done) {
+    boost::asio::post(m_strand, [self = shared_from_this(), player_id, target, done = std::move(done)]() mutable {
+        auto outgoing = std::make_shared<Outgoing>(self->m_strand);
+        outgoing->player_id = player_id;
+        outgoing->done = std::move(done);
+        if (self->m_config.cluster_secret.empty()) {
+            self->FinishOutgoing(outgoing, false, "no_secret");
+            return;
+        }
+
+        auto session = self->m_sessionManager.GetSessionByPlayerId(player_id);
+        if (!session) {
+            self->FinishOutgoing(outgoing, false, "no_session");
+            return;
+        }
+        outgoing->session = session;
+        std::optional<std::string> state = self->m_exporter ? self->m_exporter(player_id) : std::nullopt;
+        if (!state) {
+            self->FinishOutgoing(outgoing, false, "export_failed");
+            return;
+        }
+        if (state->size() > self->m_config.max_state_bytes) {
+            self->FinishOutgoing(outgoing, false, "state_too_large");
+            return;
+        }
+
+        mmorpg::proto::HandoffOffer offer;
+        outgoing->handoff_id = self->m_nextHandoffId++;
+        offer.set_handoff_id(outgoing->handoff_id);
+        offer.set_source_node(self->m_config.node_id);
+        offer.set_player_id(player_id);
+        offer.set_entity_state(std::move(*state));
+        offer.set_timestamp_ms(WallClockMs());
+        offer.set_mac(OfferMac(self->m_config.cluster_secret, offer));
+        PacketSerializer::SerializeInto(offer, outgoing->offer);
+        self->m_statOffersSent.fetch_add(1, std::memory_order_relaxed);
+
+        outgoing->timer.expires_after(self->m_config.offer_timeout);
+        outgoing->timer.async_wait([outgoing](const boost::system::error_code& ec) {
+            if (ec || outgoing->finished) return;
+            outgoing->timed_out = true;
+            boost::system::error_code ignored;
+            outgoing->socket.close(ignored);
+        });
+
+        auto fail = [self, outgoing](const char* reason) {
+            self->FinishOutgoing(outgoing, false, outgoing->timed_out ? "timeout" : reason);
+        };
+        outgoing->socket.async_connect(target, [self, outgoing, fail](const boost::system::error_code& ec) {
+            if (ec) return fail("connect_failed");
+            boost::asio::async_write(outgoing->socket, boost::asio::buffer(outgoing->offer),
+                [self, outgoing, fail](const boost::system::error_code& ec, size_t) {
+                    if (ec) return fail("write_failed");
+                    boost::asio::async_read(outgoing->socket, boost::asio::buffer(outgoing->header),
+                        [self, outgoing, fail](const boost::system::error_code& ec, size_t) {
+                            if (ec) return fail("no_accept");
+                            const uint32_t size = cluster_framing::FrameBodySize(outgoing->header.data());
+                            if (size == 0 || size > kMaxAcceptBytes) return fail("bad_accept");
+                            outgoing->body.resize(size);
+                            boost::asio::async_read(outgoing->socket, boost::asio::buffer(outgoing->body),
+                                [self, outgoing, fail](const boost::system::error_code& ec, size_t) {
+                                    if (ec) return fail("no_accept");
+                                    mmorpg::proto::HandoffAccept accept;
+                                    if (!cluster_framing::ParseBody(outgoing->body.data(), outgoing->body.size(),
+                                                                    accept) ||
+                                        accept.handoff_id() != outgoing->handoff_id) {
+                                        return fail("bad_accept");
+                                    }
+                                    if (!accept.accepted()) {
+                                        self->FinishOutgoing(outgoing, false, accept.reason());
+                                        return;
+                                    }
+                                    // A refusal only keeps the player here, but the redirect must come from a node
+                                    // holding the secret
+                                    if (!MacMatches(AcceptMac(self->m_config.cluster_secret, accept), accept.mac())) {
+                                        return fail("bad_accept_mac");
+                                    }
+                                    auto session = outgoing->session.lock();
+                                    if (!session || session->GetState() == SessionState::Disconnected) {
+                                        // The parked player expires on the target
+                                        return fail("session_closed");
+                                    }
+                                    mmorpg::proto::HandoffRedirect redirect;
+                                    redirect.set_host(accept.host());
+                                    redirect.set_port(accept.port());
+                                    redirect.set_token(accept.token());
+                                    redirect.set_player_id(outgoing->player_id);
+                                    session->Send(redirect);
+                                    // [SEQUENCE: MVP19-457] The player belongs to the target now. Unbinding it
+                                    // keeps a draining node from offering it again; the connection stays open
+                                    // until the client drops it after its claim succeeds.
+                                    session->SetPlayerId(0);
+                                    self->m_sessionManager.SetPlayerIdForSession(session->GetSessionId(), 0);
+                                    if (self->m_handedOff) self->m_handedOff(outgoing->player_id, accept.node_id());
+                                    self->FinishOutgoing(outgoing, true, accept.node_id());
+                                });
+                        });
+                });
+        });
+    });
+}
+
+void SessionHandoffService::FinishOutgoing(const std::shared_ptr<Outgoing>& outgoing, bool success,
+                                           const std::string& reason) {
+    if (outgoing->finished) return;
+    outgoing->finished = true;
+    outgoing->timer.cancel();
+    boost::system::error_code ignored;
+    outgoing->socket.close(ignored);
+    if (success) {
+        m_statCompleted.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        m_statFailed.fetch_add(1, std::memory_order_relaxed);
+        LOG_ERROR("[SessionHandoff] Handoff of player {} from {} failed: {}", outgoing->player_id, m_config.node_id,
+                  reason);
+    }
+    if (outgoing->done) outgoing->done(success, reason);
+}
+
+void SessionHandoffService::DoAccept() {
+    m_acceptor.async_accept(m_strand, [self = shared_from_this()](const boost::system::error_code& ec,
+                                                                   boost::asio::ip::tcp::socket socket) {
+        if (ec == boost::asio::error::operation_aborted || !self->m_acceptor.is_open()) return;
+        if (!ec) self->ReadOffer(std::make_shared<Incoming>(std::move(socket), self->m_strand));
+        self->DoAccept();
+    });
+}
+
+// [SEQUENCE: MVP19-315] Target side: one offer per connection, answered and closed
+void SessionHandoffService::ReadOffer(const std::shared_ptr<Incoming>& incoming) {
+    incoming->timer.expires_after(m_config.offer_timeout);
+    incoming->timer.async_wait([incoming](const boost::system::error_code& ec) {
+        if (ec) return;
+        boost::system::error_code ignored;
+        incoming->socket.close(ignored);
+    });
+
+    auto self = shared_from_this();
+    boost::asio::async_read(incoming->socket, boost::asio::buffer(incoming->header),
+        [self, incoming](const boost::system::error_code& ec, size_t) {
+            if (ec) return;
+            const uint32_t size = cluster_framing::FrameBodySize(incoming->header.data());
+            if (size == 0 || size > self->m_config.max_state_bytes + kOfferOverheadBytes) {
+                self->m_statOffersRefused.fetch_add(1, std::memory_order_relaxed);
+                boost::system::error_code ignored;
+                incoming->socket.close(ignored);
+                return;
+            }
+            incoming->body.resize(size);
+            boost::asio::async_read(incoming->socket, boost::asio::buffer(incoming->body),
+                [self, incoming](const boost::system::error_code& ec, size_t) {
+                    if (ec) return;
+                    mmorpg::proto::HandoffOffer offer;
+                    if (!cluster_framing::ParseBody(incoming->body.data(), incoming->body.size(), offer)) {
+                        self->m_statOffersRefused.fetch_add(1, std::memory_order_relaxed);
+                        boost::system::error_code ignored;
+                        incoming->socket.close(ignored);
+                        return;
+                    }
+                    PacketSerializer::SerializeInto(self->EvaluateOffer(offer), incoming->reply);
+                    boost::asio::async_write(incoming->socket, boost::asio::buffer(incoming->reply),
+                        [incoming](const boost::system::error_code&, size_t) {
+                            incoming->timer.cancel();
+                            boost::system::error_code ignored;
+                            incoming->socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+                            incoming->socket.close(ignored);
+                        });
+                });
+        });
+}
+
+mmorpg::proto::HandoffAccept SessionHandoffService::EvaluateOffer(const mmorpg::proto::HandoffOffer& offer) {
+    m_statOffersReceived.fetch_add(1, std::memory_order_relaxed);
+    mmorpg::proto::HandoffAccept accept;
+    accept.set_handoff_id(offer.handoff_id());
+    accept.set_node_id(m_config.node_id);
+    accept.set_host(m_config.advertised_host);
+    accept.set_port(m_config.advertised_port);
+
+    // A signed offer replays only within offer_max_age of its timestamp either way, so its MAC is remembered
+    // for twice that
+    const auto now = std::chrono::steady_clock::now();
+    std::erase_if(m_seenOffers, [now](const auto& seen) { return seen.second <= now; });
+    const int64_t age_ms = static_cast<int64_t>(WallClockMs() - offer.timestamp_ms());
+
+    const char* refusal = nullptr;
+    if (m_config.cluster_secret.empty() || !MacMatches(OfferMac(m_config.cluster_secret, offer), offer.mac())) {
+        refusal = "bad_secret";
+    } else if (std::abs(age_ms) > m_config.offer_max_age.count()) {
+        refusal = "stale";
+    } else if (!m_seenOffers.emplace(offer.mac(), now + 2 * m_config.offer_max_age).second) {
+        refusal = "replayed";
+    } else if (offer.player_id() == 0) {
+        refusal = "no_player";
+    } else if (m_parked.size() >= m_config.max_parked) {
+        refusal = "busy";
+    } else if (m_sessionManager.GetSessionByPlayerId(offer.player_id())) {
+        refusal = "already_here";
+    } else if (!m_importer || !m_importer(offer.player_id(), offer.entity_state())) {
+        refusal = "import_failed";
+    }
+    if (refusal) {
+        m_statOffersRefused.fetch_add(1, std::memory_order_relaxed);
+        LOG_ERROR("[SessionHandoff] Node {} refused player {} from {}: {}", m_config.node_id, offer.player_id(),
+                  offer.source_node(), refusal);
+        accept.set_reason(refusal);
+        return accept;
+    }
+
+    uint64_t token = 0;
+    while (token == 0 || m_parked.count(token) != 0) token = quic_crypto::RandomU64();
+    Parked& parked = m_parked[token];
+    parked.player_id = offer.player_id();
+    parked.expiry = std::make_unique<boost::asio::steady_timer>(m_strand, m_config.claim_timeout);
+    parked.expiry->async_wait([self = shared_from_this(), token](const boost::system::error_code& ec) {
+        if (ec) return;
+        auto it = self->m_parked.find(token);
+        if (it == self->m_parked.end()) return;
+        const uint64_t player_id = it->second.player_id;
+        self->m_parked.erase(it);
+        self->m_statParked.store(self->m_parked.size(), std::memory_order_relaxed);
+        self->m_statClaimsExpired.fetch_add(1, std::memory_order_relaxed);
+        if (self->m_discarder) self->m_discarder(player_id);
+    });
+    m_statParked.store(m_parked.size(), std::memory_order_relaxed);
+
+    accept.set_accepted(true);
+    accept.set_token(token);
+    accept.set_claim_timeout_ms(static_cast<uint32_t>(m_config.claim_timeout.count()));
+    accept.set_mac(AcceptMac(m_config.cluster_secret, accept));
+    return accept;
+}
+
+std::string SessionHandoffService::OfferMac(const std::string& secret, const mmorpg::proto::HandoffOffer& offer) {
+    std::vector<uint8_t> signed_bytes;
+    AppendString(signed_bytes, "handoff-offer");
+    AppendU64(signed_bytes, offer.handoff_id());
+    AppendString(signed_bytes, offer.source_node());
+    AppendU64(signed_bytes, offer.player_id());
+    AppendU64(signed_bytes, offer.timestamp_ms());
+    // The state can be large; its digest stands in for it
+    const QuicSecret state_digest = quic_crypto::Sha256(
+        reinterpret_cast<const uint8_t*>(offer.entity_state().data()), offer.entity_state().size());
+    signed_bytes.insert(signed_bytes.end(), state_digest.begin(), state_digest.end());
+    return Mac(secret, signed_bytes);
+}
+
+std::string SessionHandoffService::AcceptMac(const std::string& secret, const mmorpg::proto::HandoffAccept& accept) {
+    std::vector<uint8_t> signed_bytes;
+    AppendString(signed_bytes, "handoff-accept");
+    AppendU64(signed_bytes, accept.handoff_id());
+    AppendU64(signed_bytes, accept.accepted());
+    AppendU64(signed_bytes, accept.token());
+    AppendU64(signed_bytes, accept.claim_timeout_ms());
+    AppendString(signed_bytes, accept.reason());
+    AppendString(signed_bytes, accept.node_id());
+    AppendString(signed_bytes, accept.host());
+    AppendU64(signed_bytes, accept.port());
+    return Mac(secret, signed_bytes);
+}
+
+void SessionHandoffService::HandleClaim(const std::shared_ptr<Session>& session,
+                                        const mmorpg::proto::HandoffClaim& claim) {
+    boost::asio::post(m_strand, [self = shared_from_this(), session, claim] { self->ApplyClaim(session, claim); });
+}
+
+// [SEQUENCE: MVP19-316] The token is single use and only valid for the player it was issued for, on a connection
+// that is not already playing someone
+void SessionHandoffService::ApplyClaim(const std::shared_ptr<Session>& session,
+                                       const mmorpg::proto::HandoffClaim& claim) {
+    m_statClaims.fetch_add(1, std::memory_order_relaxed);
+    mmorpg::proto::HandoffClaimResponse response;
+    response.set_player_id(claim.player_id());
+
+    auto it = m_parked.find(claim.token());
+    if (it == m_parked.end() || it->second.player_id != claim.player_id() || session->GetPlayerId() != 0) {
+        m_statClaimsRefused.fetch_add(1, std::memory_order_relaxed);
+        response.set_success(false);
+        session->Send(response);
+        return;
+    }
+    const uint64_t player_id = it->second.player_id;
+    it->second.expiry->cancel();
+    m_parked.erase(it);
+    m_statParked.store(m_parked.size(), std::memory_order_relaxed);
+
+    session->SetPlayerId(player_id);
+    session->Authenticate();
+    m_sessionManager.SetPlayerIdForSession(session->GetSessionId(), player_id);
+    response.set_success(true);
+    session->Send(response);
+    if (m_claimed) m_claimed(session, player_id);
+}
+
+SessionHandoffService::Stats SessionHandoffService::GetStats() const {
+    Stats stats;
+    stats.offers_sent = m_statOffersSent.load(std::memory_order_relaxed);
+    stats.handoffs_completed = m_statCompleted.load(std::memory_order_relaxed);
+    stats.handoffs_failed = m_statFailed.load(std::memory_order_relaxed);
+    stats.offers_received = m_statOffersReceived.load(std::memory_order_relaxed);
+    stats.offers_refused = m_statOffersRefused.load(std::memory_order_relaxed);
+    stats.claims = m_statClaims.load(std::memory_order_relaxed);
+    stats.claims_refused = m_statClaimsRefused.load(std::memory_order_relaxed);
+    stats.claims_expired = m_statClaimsExpired.load(std::memory_order_relaxed);
+    stats.parked = m_statParked.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SessionHandoffService::ExportMetrics(monitoring::MetricsCollector& metrics) const {
+    const Stats stats = GetStats();
+    metrics.RecordCounter("handoff.offers_sent", stats.offers_sent);
+    metrics.RecordCounter("handoff.completed", stats.handoffs_completed);
+    metrics.RecordCounter("handoff.failed", stats.handoffs_failed);
+    metrics.RecordCounter("handoff.offers_received", stats.offers_received);
+    metrics.RecordCounter("handoff.offers_refused", stats.offers_refused);
+    metrics.RecordCounter("handoff.claims", stats.claims);
+    metrics.RecordCounter("handoff.claims_refused", stats.claims_refused);
+    metrics.RecordCounter("handoff.claims_expired", stats.claims_expired);
+    metrics.RecordGauge("handoff.parked", static_cast<double>(stats.parked));
+}
+
+HandoffDrainer::HandoffDrainer(std::shared_ptr<SessionHandoffService> service, SessionManager& session_manager,
+                               size_t max_in_flight, TargetRequest request_target)
+    : m_service(std::move(service)),
+      m_sessionManager(session_manager),
+      m_maxInFlight(max_in_flight),
+      m_requestTarget(std::move(request_target)),
+      m_inFlight(std::make_shared<std::atomic<size_t>>(0)) {}
+
+// [SEQUENCE: MVP19-459] A round is counted in full before any request goes out, since a target or a failure
+// can come back before the loop ends. Players whose handoff failed are still bound; starting each round where
+// the last one stopped keeps them from taking every slot of every round.
+void HandoffDrainer::Tick() {
+    if (m_inFlight->load() != 0) return;
+    const auto players = m_sessionManager.GetPlayerIds();
+    if (players.empty()) return;
+
+    const size_t start = m_nextIndex % players.size();
+    const size_t count = std::min(players.size(), m_maxInFlight);
+    m_nextIndex = start + count;
+    m_inFlight->store(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t player_id = players[(start + i) % players.size()];
+        m_requestTarget([service = m_service, in_flight = m_inFlight, player_id](
+                            std::optional<boost::asio::ip::tcp::endpoint> target) {
+            if (!target) {
+                in_flight->fetch_sub(1);
+                return;
+            }
+            service->HandOff(player_id, *target, [in_flight](bool, const std::string&) { in_flight->fetch_sub(1); });
+        });
+    }
+}
+
+} // namespace mmorpg::network
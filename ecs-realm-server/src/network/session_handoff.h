@@ -0,0 +1,174 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "proto/cluster.pb.h"
+
+// Forward declarations
+namespace mmorpg::monitoring {
+class MetricsCollector;
+}
+
+namespace mmorpg::network {
+
+class Session;
+class SessionManager;
+
+struct SessionHandoffConfig {
+    std::string node_id;
+    std::string cluster_secret;                      // Shared by every node; keys the offer and accept MACs
+    std::string advertised_host = "127.0.0.1";       // Where this node's clients connect
+    uint16_t advertised_port = 0;
+    std::chrono::milliseconds offer_timeout{3000};   // Connect, offer and accept, end to end
+    std::chrono::milliseconds claim_timeout{10000};  // How long a parked player waits for its client
+    std::chrono::milliseconds offer_max_age{30000};  // Clock skew allowed; older offers are refused as replays
+    size_t max_state_bytes = 256 * 1024;
+    size_t max_parked = 4096;
+};
+
+// [SEQUENCE: MVP19-313] Moves a logged-in player from one game server process to another while the client
+// keeps playing.
+//
+//  1. Source: HandOff exports the player's ECS state and offers it to the target node's handoff port over TCP,
+//     signed with the cluster secret. The target refuses offers with a bad MAC, older than offer_max_age, or
+//     seen before, and signs its accept in turn.
+//  2. Target: the importer materializes the player, which is parked under a random single-use token until its
+//     client claims it or claim_timeout passes (then the discarder removes it again). The token goes back in
+//     a HandoffAccept along with the target's client address.
+//  3. Source: sends the client a HandoffRedirect, unbinds the player from its session and reports it as handed
+//     off, after which the source simulates it no longer.
+//  4. Client: opens a connection to the target in the background and sends HandoffClaim as its first packet,
+//     in place of a login. HandleClaim binds the connection to the player. The client switches over once the
+//     claim succeeds and only then drops the old connection, so the player never sees a loading screen or
+//     a login; the cost is whatever input the source received during the one round trip of step 1.
+//
+// A failed offer leaves the player where it was. All state lives on one strand of the given io_context.
+// Nothing on the connection is encrypted, so the handoff port belongs on a cluster-internal address: the MACs
+// stop forged offers, but a token read off the wire could still be claimed.
+class SessionHandoffService : public std::enable_shared_from_this<SessionHandoffService> {
+public:
+    // Source: the player's state, or nullopt if it cannot move right now
+    using StateExporter = std::function<std::optional<std::string>(uint64_t player_id)>;
+    // Target: creates the player from exported state; false refuses the offer
+    using StateImporter = std::function<bool(uint64_t player_id, const std::string& state)>;
+    // Target: removes an imported player whose client never claimed it
+    using StateDiscarder = std::function<void(uint64_t player_id)>;
+    // Source: the player now lives on target_node
+    using HandedOffCallback = std::function<void(uint64_t player_id, const std::string& target_node)>;
+    // Target: a client claimed its player on session
+    using ClaimedCallback = std::function<void(const std::shared_ptr<Session>& session, uint64_t player_id)>;
+    using HandOffDone = std::function<void(bool success, const std::string& reason)>;
+
+    struct Stats {
+        uint64_t offers_sent = 0;
+        uint64_t handoffs_completed = 0;   // Accepted and redirected
+        uint64_t handoffs_failed = 0;
+        uint64_t offers_received = 0;
+        uint64_t offers_refused = 0;       // Bad MAC, stale or replayed, import failure, too many parked
+        uint64_t claims = 0;
+        uint64_t claims_refused = 0;       // Unknown token or wrong player
+        uint64_t claims_expired = 0;
+        size_t parked = 0;
+    };
+
+    SessionHandoffService(boost::asio::io_context& io_context, SessionManager& session_manager,
+                          SessionHandoffConfig config);
+
+    void SetStateExporter(StateExporter exporter) { m_exporter = std::move(exporter); }
+    void SetStateImporter(StateImporter importer) { m_importer = std::move(importer); }
+    void SetStateDiscarder(StateDiscarder discarder) { m_discarder = std::move(discarder); }
+    void SetHandedOffCallback(HandedOffCallback callback) { m_handedOff = std::move(callback); }
+    void SetClaimedCallback(ClaimedCallback callback) { m_claimed = std::move(callback); }
+
+    // Accepts offers from other nodes. Port 0 picks a free port, see GetListenPort. Refuses to listen without a
+    // cluster secret.
+    bool Listen(const boost::asio::ip::tcp::endpoint& endpoint);
+    uint16_t GetListenPort() const;
+    void Stop();
+
+    // Source side: moves player_id to the node whose handoff port is target. done runs on the service strand.
+    void HandOff(uint64_t player_id, const boost::asio::ip::tcp::endpoint& target, HandOffDone done);
+    // Target side: the HandoffClaim handler, registered with the node's PacketHandler
+    void HandleClaim(const std::shared_ptr<Session>& session, const mmorpg::proto::HandoffClaim& claim);
+
+    Stats GetStats() const;
+    void ExportMetrics(monitoring::MetricsCollector& metrics) const;
+
+    // [SEQUENCE: MVP19-424] HMAC-SHA256 under secret over every field but the mac itself
+    static std::string OfferMac(const std::string& secret, const mmorpg::proto::HandoffOffer& offer);
+    static std::string AcceptMac(const std::string& secret, const mmorpg::proto::HandoffAccept& accept);
+
+private:
+    struct Outgoing;
+    struct Incoming;
+    struct Parked {
+        uint64_t player_id = 0;
+        std::unique_ptr<boost::asio::steady_timer> expiry;
+    };
+
+    void DoAccept();
+    void FinishOutgoing(const std::shared_ptr<Outgoing>& outgoing, bool success, const std::string& reason);
+    void ReadOffer(const std::shared_ptr<Incoming>& incoming);
+    mmorpg::proto::HandoffAccept EvaluateOffer(const mmorpg::proto::HandoffOffer& offer);
+    void ApplyClaim(const std::shared_ptr<Session>& session, const mmorpg::proto::HandoffClaim& claim);
+
+    SessionManager& m_sessionManager;
+    const SessionHandoffConfig m_config;
+    boost::asio::strand<boost::asio::io_context::executor_type> m_strand;
+    boost::asio::ip::tcp::acceptor m_acceptor;
+
+    StateExporter m_exporter;
+    StateImporter m_importer;
+    StateDiscarder m_discarder;
+    HandedOffCallback m_handedOff;
+    ClaimedCallback m_claimed;
+
+    // Strand-only state
+    std::unordered_map<uint64_t, Parked> m_parked;   // token -> player
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> m_seenOffers;   // MAC -> expiry
+    uint64_t m_nextHandoffId = 1;
+
+    std::atomic<uint64_t> m_statOffersSent{0};
+    std::atomic<uint64_t> m_statCompleted{0};
+    std::atomic<uint64_t> m_statFailed{0};
+    std::atomic<uint64_t> m_statOffersReceived{0};
+    std::atomic<uint64_t> m_statOffersRefused{0};
+    std::atomic<uint64_t> m_statClaims{0};
+    std::atomic<uint64_t> m_statClaimsRefused{0};
+    std::atomic<uint64_t> m_statClaimsExpired{0};
+    std::atomic<size_t> m_statParked{0};
+};
+
+// [SEQUENCE: MVP19-458] Empties a draining node: each Tick, once the previous round has finished, asks for a
+// target for up to max_in_flight bound players and hands each one off there. A handed-off player is unbound
+// from its session, so rounds move on to the rest until no player is left. Tick runs on the caller's thread;
+// request_target may answer on any thread, with nullopt when no node can take the player.
+class HandoffDrainer {
+public:
+    using TargetCallback = std::function<void(std::optional<boost::asio::ip::tcp::endpoint> target)>;
+    using TargetRequest = std::function<void(TargetCallback callback)>;
+
+    HandoffDrainer(std::shared_ptr<SessionHandoffService> service, SessionManager& session_manager,
+                   size_t max_in_flight, TargetRequest request_target);
+
+    void Tick();
+    size_t GetInFlight() const { return m_inFlight->load(); }
+
+private:
+    std::shared_ptr<SessionHandoffService> m_service;
+    SessionManager& m_sessionManager;
+    const size_t m_maxInFlight;
+    TargetRequest m_requestTarget;
+    std::shared_ptr<std::atomic<size_t>> m_inFlight;   // Shared with the callbacks of the current round
+    size_t m_nextIndex = 0;
+};
+
+} // namespace mmorpg::network
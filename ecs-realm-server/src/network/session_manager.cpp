@@ -2,42 +2,145 @@
 #include "network/session.h"
 
 #include <google/protobuf/message.h>
-#include <shared_mutex>
+
+#include <algorithm>
 
 namespace mmorpg::network {
 
+SessionManager::SessionManager(size_t shard_count)
+    : m_next_session_id(0),
+      m_shard_count(std::max<size_t>(1, shard_count)),
+      m_session_shards(std::make_unique<Shard<SessionTable>[]>(m_shard_count)),
+      m_player_shards(std::make_unique<Shard<PlayerTable>[]>(m_shard_count)),
+      m_udp_shards(std::make_unique<UdpShard[]>(m_shard_count)) {
+}
+
+SessionManager::Shard<SessionManager::SessionTable>& SessionManager::SessionShardFor(uint32_t session_id) const {
+    return m_session_shards[session_id % m_shard_count];
+}
+
+SessionManager::Shard<SessionManager::PlayerTable>& SessionManager::PlayerShardFor(uint64_t player_id) const {
+    return m_player_shards[std::hash<uint64_t>{}(player_id) % m_shard_count];
+}
+
+// [SEQUENCE: MVP19-107] try_lock first so contention is counted without timing every acquisition.
+template <typename Table>
+std::unique_lock<std::mutex> SessionManager::LockShard(Shard<Table>& shard) {
+    std::unique_lock<std::mutex> lock(shard.write_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        shard.contentions.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+    shard.writes.fetch_add(1, std::memory_order_relaxed);
+    return lock;
+}
+
+template <typename Table, typename Mutate>
+void SessionManager::UpdateShardLocked(Shard<Table>& shard, Mutate&& mutate) {
+    auto current = shard.table.load(std::memory_order_acquire);
+    auto next = std::make_shared<Table>(*current);
+    shard.copied_entries.fetch_add(current->size(), std::memory_order_relaxed);
+    mutate(*next);
+    shard.table.store(std::move(next), std::memory_order_release);
+}
+
 void SessionManager::Register(const std::shared_ptr<Session>& session) {
     if (!session) return;
-    std::unique_lock lock(m_mutex);
-    m_sessions[session->GetSessionId()] = session;
+    auto& shard = SessionShardFor(session->GetSessionId());
+    auto lock = LockShard(shard);
+    UpdateShardLocked(shard, [&](SessionTable& table) {
+        auto [it, inserted] = table.insert_or_assign(session->GetSessionId(), SessionEntry{session, 0});
+        if (inserted) {
+            m_session_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
 }
 
 // [SEQUENCE: MVP6-24] When a session is unregistered, its UDP endpoint mapping must also be removed to prevent stale entries.
+// [SEQUENCE: MVP19-108] Lock order is session shard -> player shard -> UDP shard, everywhere.
 void SessionManager::Unregister(uint32_t session_id) {
-    std::unique_lock lock(m_mutex);
-    auto it = m_sessions.find(session_id);
-    if (it != m_sessions.end()) {
-        if (auto udp_endpoint = it->second->GetUdpEndpoint(); udp_endpoint) {
-            m_udp_endpoint_to_session_id.erase(*udp_endpoint);
+    auto& shard = SessionShardFor(session_id);
+    auto lock = LockShard(shard);
+    const auto table = shard.table.load(std::memory_order_acquire);
+    auto it = table->find(session_id);
+    if (it == table->end()) return;
+    const SessionEntry entry = it->second;
+
+    UpdateShardLocked(shard, [&](SessionTable& next) { next.erase(session_id); });
+    m_session_count.fetch_sub(1, std::memory_order_relaxed);
+
+    if (entry.player_id != 0) {
+        auto& player_shard = PlayerShardFor(entry.player_id);
+        auto player_lock = LockShard(player_shard);
+        const auto players = player_shard.table.load(std::memory_order_acquire);
+        auto player_it = players->find(entry.player_id);
+        // Only drop the binding if it still points at this session; the player may have logged in again.
+        if (player_it != players->end() && player_it->second == entry.session) {
+            UpdateShardLocked(player_shard, [&](PlayerTable& next) { next.erase(entry.player_id); });
         }
-        m_sessions.erase(it);
     }
-    m_session_to_player_id.erase(session_id);
+
+    // The session is already out of its table, so a RegisterUdpEndpoint that has not bound it yet will not;
+    // one that has is finished once this lock is ours, and its endpoint is read below.
+    std::lock_guard endpoint_lock(entry.session->GetUdpEndpointChangeMutex());
+    if (auto udp_endpoint = entry.session->GetUdpEndpoint(); udp_endpoint) {
+        EraseUdpEndpoint(*udp_endpoint, entry.session);
+    }
 }
 
 std::shared_ptr<Session> SessionManager::GetSession(uint32_t session_id) const {
-    std::shared_lock lock(m_mutex);
-    auto it = m_sessions.find(session_id);
-    return (it != m_sessions.end()) ? it->second : nullptr;
+    const auto table = SessionShardFor(session_id).table.load(std::memory_order_acquire);
+    auto it = table->find(session_id);
+    return (it != table->end()) ? it->second.session : nullptr;
 }
 
 void SessionManager::Broadcast(const google::protobuf::Message& message) {
-    std::shared_lock lock(m_mutex);
-    for (const auto& [id, session] : m_sessions) {
-        if (session && session->GetState() == SessionState::Connected && session->IsAuthenticated()) {
-            session->Send(message);
+    Broadcast(PacketSerializer::SerializeShared(message));
+}
+
+// [SEQUENCE: MVP19-38] Snapshot the targets, drop the lock, then hand each session the shared buffer.
+// Holding the shared lock across thousands of Send() calls used to block Register/Unregister for the whole fan-out.
+// With sharded snapshots there is no lock left to hold; each shard's table is read as of one instant.
+void SessionManager::Broadcast(const SharedPacketBuffer& packet) {
+    if (!packet) return;
+
+    thread_local std::vector<std::shared_ptr<Session>> targets;
+    targets.clear();
+    targets.reserve(m_session_count.load(std::memory_order_relaxed));
+    for (size_t i = 0; i < m_shard_count; ++i) {
+        const auto table = m_session_shards[i].table.load(std::memory_order_acquire);
+        for (const auto& [id, entry] : *table) {
+            if (IsBroadcastTarget(entry.session)) {
+                targets.push_back(entry.session);
+            }
         }
     }
+
+    for (const auto& session : targets) {
+        session->SendShared(packet);
+    }
+    targets.clear();
+}
+
+void SessionManager::Multicast(const std::vector<uint32_t>& session_ids, const google::protobuf::Message& message) {
+    if (session_ids.empty()) return;
+    Multicast(session_ids, PacketSerializer::SerializeShared(message));
+}
+
+// [SEQUENCE: MVP19-39] Multicast to an explicit session list (zone, guild, party). Same serialize-once contract as Broadcast.
+void SessionManager::Multicast(const std::vector<uint32_t>& session_ids, const SharedPacketBuffer& packet) {
+    if (!packet || session_ids.empty()) return;
+
+    for (uint32_t session_id : session_ids) {
+        auto session = GetSession(session_id);
+        if (IsBroadcastTarget(session)) {
+            session->SendShared(packet);
+        }
+    }
+}
+
+bool SessionManager::IsBroadcastTarget(const std::shared_ptr<Session>& session) {
+    return session && session->GetState() == SessionState::Connected && session->IsAuthenticated();
 }
 
 void SessionManager::SendToSession(uint32_t session_id, const google::protobuf::Message& message) {
@@ -47,50 +150,156 @@ void SessionManager::SendToSession(uint32_t session_id, const google::protobuf::
     }
 }
 
+void SessionManager::SendToSession(uint32_t session_id, const SharedPacketBuffer& packet) {
+    auto session = GetSession(session_id);
+    if (session && session->GetState() == SessionState::Connected) {
+        session->SendShared(packet);
+    }
+}
+
 size_t SessionManager::GetSessionCount() const {
-    std::shared_lock lock(m_mutex);
-    return m_sessions.size();
+    return m_session_count.load(std::memory_order_relaxed);
 }
 
+// [SEQUENCE: MVP19-109] Updates both directions of the player <-> session index. A previous player bound to this
+// session and a previous session bound to this player are both unlinked.
 void SessionManager::SetPlayerIdForSession(uint32_t session_id, uint64_t player_id) {
-    std::unique_lock lock(m_mutex);
-    m_session_to_player_id[session_id] = player_id;
+    auto& shard = SessionShardFor(session_id);
+    auto lock = LockShard(shard);
+    const auto table = shard.table.load(std::memory_order_acquire);
+    auto it = table->find(session_id);
+    if (it == table->end()) return;
+    const SessionEntry entry = it->second;
+    if (entry.player_id == player_id) return;
+
+    UpdateShardLocked(shard, [&](SessionTable& next) { next[session_id].player_id = player_id; });
+
+    if (entry.player_id != 0) {
+        auto& old_shard = PlayerShardFor(entry.player_id);
+        auto old_lock = LockShard(old_shard);
+        UpdateShardLocked(old_shard, [&](PlayerTable& next) {
+            auto old_it = next.find(entry.player_id);
+            if (old_it != next.end() && old_it->second == entry.session) {
+                next.erase(old_it);
+            }
+        });
+    }
+    if (player_id != 0) {
+        auto& player_shard = PlayerShardFor(player_id);
+        auto player_lock = LockShard(player_shard);
+        std::shared_ptr<Session> displaced;
+        UpdateShardLocked(player_shard, [&](PlayerTable& next) {
+            auto& slot = next[player_id];
+            displaced = std::move(slot);
+            slot = entry.session;
+        });
+        player_lock.unlock();
+        lock.unlock();
+
+        // The displaced session keeps its shard entry but must forget the player id.
+        if (displaced && displaced != entry.session) {
+            auto& displaced_shard = SessionShardFor(displaced->GetSessionId());
+            auto displaced_lock = LockShard(displaced_shard);
+            UpdateShardLocked(displaced_shard, [&](SessionTable& next) {
+                auto displaced_it = next.find(displaced->GetSessionId());
+                if (displaced_it != next.end() && displaced_it->second.player_id == player_id) {
+                    displaced_it->second.player_id = 0;
+                }
+            });
+        }
+    }
 }
 
 uint64_t SessionManager::GetPlayerIdForSession(uint32_t session_id) const {
-    std::shared_lock lock(m_mutex);
-    auto it = m_session_to_player_id.find(session_id);
-    return (it != m_session_to_player_id.end()) ? it->second : 0;
+    const auto table = SessionShardFor(session_id).table.load(std::memory_order_acquire);
+    auto it = table->find(session_id);
+    return (it != table->end()) ? it->second.player_id : 0;
 }
 
+// [SEQUENCE: MVP19-110] One snapshot load and one hash lookup. Previously a linear scan over every session
+// followed by a recursive shared lock through GetSession.
 std::shared_ptr<Session> SessionManager::GetSessionByPlayerId(uint64_t player_id) const {
-    std::shared_lock lock(m_mutex);
-    for (const auto& pair : m_session_to_player_id) {
-        if (pair.second == player_id) {
-            return GetSession(pair.first);
-        }
+    const auto table = PlayerShardFor(player_id).table.load(std::memory_order_acquire);
+    auto it = table->find(player_id);
+    return (it != table->end()) ? it->second : nullptr;
+}
+
+std::vector<uint64_t> SessionManager::GetPlayerIds() const {
+    std::vector<uint64_t> player_ids;
+    for (size_t i = 0; i < m_shard_count; ++i) {
+        const auto table = m_player_shards[i].table.load(std::memory_order_acquire);
+        for (const auto& [player_id, session] : *table) player_ids.push_back(player_id);
     }
-    return nullptr;
+    return player_ids;
 }
 
 // [SEQUENCE: MVP6-22] Associates a UDP endpoint with a session ID after a successful handshake.
 void SessionManager::RegisterUdpEndpoint(uint32_t session_id, const boost::asio::ip::udp::endpoint& endpoint) {
-    std::unique_lock lock(m_mutex);
-    auto it = m_sessions.find(session_id);
-    if (it != m_sessions.end()) {
-        it->second->SetUdpEndpoint(endpoint);
-        m_udp_endpoint_to_session_id[endpoint] = session_id;
+    auto session = GetSession(session_id);
+    if (!session) return;
+
+    std::lock_guard endpoint_lock(session->GetUdpEndpointChangeMutex());
+    // Unregister may have run since the lookup; binding now would leave an entry nothing erases
+    if (GetSession(session_id) != session) return;
+    // The previous endpoint may hash to another shard; each shard is locked on its own
+    if (auto previous = session->GetUdpEndpoint(); previous && *previous != endpoint) {
+        EraseUdpEndpoint(*previous, session);
     }
+    auto& shard = m_udp_shards[UdpShardFor(endpoint)];
+    std::lock_guard udp_lock(shard.write_mutex);
+    session->SetUdpEndpoint(endpoint);
+    shard.endpoints[endpoint] = session;
+    PublishUdpSnapshotLocked(shard);
+}
+
+// Drops the endpoint's binding if it still belongs to session; the endpoint may have been reused since.
+void SessionManager::EraseUdpEndpoint(const boost::asio::ip::udp::endpoint& endpoint, const std::shared_ptr<Session>& session) {
+    auto& shard = m_udp_shards[UdpShardFor(endpoint)];
+    std::lock_guard udp_lock(shard.write_mutex);
+    auto it = shard.endpoints.find(endpoint);
+    if (it == shard.endpoints.end()) return;
+    if (auto bound = it->second.lock(); bound && bound != session) return;
+    shard.endpoints.erase(it);
+    PublishUdpSnapshotLocked(shard);
 }
 
 // [SEQUENCE: MVP6-23] Finds a session based on its UDP endpoint.
 std::shared_ptr<Session> SessionManager::GetSessionByUdpEndpoint(const boost::asio::ip::udp::endpoint& endpoint) const {
-    std::shared_lock lock(m_mutex);
-    auto it = m_udp_endpoint_to_session_id.find(endpoint);
-    if (it != m_udp_endpoint_to_session_id.end()) {
-        return GetSession(it->second);
+    const auto snapshot = GetUdpEndpointSnapshot(UdpShardFor(endpoint));
+    auto it = snapshot->sessions.find(endpoint);
+    return (it != snapshot->sessions.end()) ? it->second.lock() : nullptr;
+}
+
+// [SEQUENCE: MVP19-44] Rebuilds one shard's endpoint snapshot. Called with the shard's lock held, so its writers
+// are serialized. The copy is one shard's endpoints, not the whole table, so a login storm costs O(N / shards)
+// per registration. The shard version is stored before the global one, so a reader that sees the global
+// version move also sees which shard moved.
+void SessionManager::PublishUdpSnapshotLocked(UdpShard& shard) {
+    auto snapshot = std::make_shared<UdpEndpointSnapshot>();
+    snapshot->version = shard.version.load(std::memory_order_relaxed) + 1;
+    snapshot->sessions = shard.endpoints;
+    shard.copied_entries.fetch_add(shard.endpoints.size(), std::memory_order_relaxed);
+    const uint64_t version = snapshot->version;
+    shard.snapshot.store(std::move(snapshot), std::memory_order_release);
+    shard.version.store(version, std::memory_order_release);
+    m_udp_snapshot_version.fetch_add(1, std::memory_order_acq_rel);
+}
+
+SessionManagerStats SessionManager::GetStats() const {
+    SessionManagerStats stats;
+    stats.shard_count = m_shard_count;
+    stats.session_count = GetSessionCount();
+    auto accumulate = [&stats](const auto& shard) {
+        stats.writes += shard.writes.load(std::memory_order_relaxed);
+        stats.write_contentions += shard.contentions.load(std::memory_order_relaxed);
+        stats.copied_entries += shard.copied_entries.load(std::memory_order_relaxed);
+    };
+    for (size_t i = 0; i < m_shard_count; ++i) {
+        accumulate(m_session_shards[i]);
+        accumulate(m_player_shards[i]);
+        stats.copied_entries += m_udp_shards[i].copied_entries.load(std::memory_order_relaxed);
     }
-    return nullptr;
+    return stats;
 }
 
-}
\ No newline at end of file
+}
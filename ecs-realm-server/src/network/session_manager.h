@@ -4,8 +4,12 @@
 #include <boost/functional/hash.hpp>
 #include <memory>
 #include <unordered_map>
-#include <shared_mutex>
+#include <mutex>
+#include <atomic>
 #include <cstdint>
+#include <vector>
+
+#include "network/packet_serializer.h"
 
 // Forward declarations
 namespace google::protobuf {
@@ -27,9 +31,34 @@ struct UdpEndpointHasher {
     }
 };
 
+// [SEQUENCE: MVP19-42] An immutable endpoint -> session table, republished on every UDP registration change.
+// UDP workers keep a per-thread pointer to the latest snapshot and only reload it when the version moves,
+// so the datagram hot path never takes a lock.
+// [SEQUENCE: MVP19-405] One snapshot per UDP shard; version counts that shard's publishes.
+struct UdpEndpointSnapshot {
+    uint64_t version = 0;
+    std::unordered_map<boost::asio::ip::udp::endpoint, std::weak_ptr<Session>, UdpEndpointHasher> sessions;
+};
+
+// [SEQUENCE: MVP19-103] Aggregate counters across shards. writes counts shard lock acquisitions, contentions
+// the ones that found the lock already held; copied_entries is the total copy-on-write cost paid by writers to keep reads lock-free.
+struct SessionManagerStats {
+    size_t shard_count = 0;
+    size_t session_count = 0;
+    uint64_t writes = 0;
+    uint64_t write_contentions = 0;
+    uint64_t copied_entries = 0;
+};
+
+// [SEQUENCE: MVP19-104] Sessions are spread over N shards by session id, and the player -> session index over
+// N shards by player id. Each shard serializes its writers with a mutex and publishes an immutable copy of its
+// table; readers load the current copy atomically and never take a lock (read-copy-update). Writers pay a copy
+// of one shard, which stays small at the default shard count (20k sessions / 64 shards ~ 300 entries).
 class SessionManager {
 public:
-    SessionManager() : m_next_session_id(0) {}
+    static constexpr size_t kDefaultShardCount = 64;
+
+    explicit SessionManager(size_t shard_count = kDefaultShardCount);
     ~SessionManager() = default;
 
     uint32_t get_next_session_id() {
@@ -45,25 +74,101 @@ public:
     void Unregister(uint32_t session_id);
     std::shared_ptr<Session> GetSession(uint32_t session_id) const;
     void Broadcast(const google::protobuf::Message& message);
+    // [SEQUENCE: MVP19-37] Serialize-once fan-out. The packet is framed a single time and every target queues
+    // the same immutable buffer. Targets are collected from the shard snapshots first, then sent to.
+    void Broadcast(const SharedPacketBuffer& packet);
+    void Multicast(const std::vector<uint32_t>& session_ids, const google::protobuf::Message& message);
+    void Multicast(const std::vector<uint32_t>& session_ids, const SharedPacketBuffer& packet);
     void SendToSession(uint32_t session_id, const google::protobuf::Message& message);
+    // [SEQUENCE: MVP19-146] Queues an already-framed packet, e.g. a per-session batch built by EntityUpdateBatcher.
+    void SendToSession(uint32_t session_id, const SharedPacketBuffer& packet);
     size_t GetSessionCount() const;
 
+    // A player id maps to at most one session; binding it to a new session replaces the old binding.
     void SetPlayerIdForSession(uint32_t session_id, uint64_t player_id);
     uint64_t GetPlayerIdForSession(uint32_t session_id) const;
     std::shared_ptr<Session> GetSessionByPlayerId(uint64_t player_id) const;
+    // [SEQUENCE: MVP19-327] Every player bound to a session, e.g. to pick sessions to hand off when draining
+    std::vector<uint64_t> GetPlayerIds() const;
 
     // [SEQUENCE: MVP6-21] Methods for UDP endpoint management.
     void RegisterUdpEndpoint(uint32_t session_id, const boost::asio::ip::udp::endpoint& endpoint);
     std::shared_ptr<Session> GetSessionByUdpEndpoint(const boost::asio::ip::udp::endpoint& endpoint) const;
 
+    // [SEQUENCE: MVP19-43] Lock-free read side of the UDP endpoint table.
+    // [SEQUENCE: MVP19-406] The table is split into shards by endpoint hash, like the session tables, so a
+    // registration copies one shard instead of every endpoint. GetUdpEndpointVersion moves on any shard's
+    // publish; a reader that sees it move reloads only the shards whose own version changed.
+    size_t GetUdpShardCount() const { return m_shard_count; }
+    size_t UdpShardFor(const boost::asio::ip::udp::endpoint& endpoint) const {
+        return UdpEndpointHasher{}(endpoint) % m_shard_count;
+    }
+    std::shared_ptr<const UdpEndpointSnapshot> GetUdpEndpointSnapshot(size_t shard) const {
+        return m_udp_shards[shard].snapshot.load(std::memory_order_acquire);
+    }
+    uint64_t GetUdpShardVersion(size_t shard) const {
+        return m_udp_shards[shard].version.load(std::memory_order_acquire);
+    }
+    uint64_t GetUdpEndpointVersion() const {
+        return m_udp_snapshot_version.load(std::memory_order_acquire);
+    }
+
+    SessionManagerStats GetStats() const;
+
 private:
+    // [SEQUENCE: MVP19-105] One session-shard entry holds both directions of the player binding's session side.
+    struct SessionEntry {
+        std::shared_ptr<Session> session;
+        uint64_t player_id = 0;
+    };
+    using SessionTable = std::unordered_map<uint32_t, SessionEntry>;
+    using PlayerTable = std::unordered_map<uint64_t, std::shared_ptr<Session>>;
+
+    // A shard's published table plus the writer lock and counters. Aligned so neighbouring shards do not
+    // share a cache line.
+    template <typename Table>
+    struct alignas(64) Shard {
+        std::mutex write_mutex;
+        std::atomic<std::shared_ptr<const Table>> table{std::make_shared<const Table>()};
+        std::atomic<uint64_t> writes{0};
+        std::atomic<uint64_t> contentions{0};
+        std::atomic<uint64_t> copied_entries{0};
+    };
+
+    template <typename Table>
+    static std::unique_lock<std::mutex> LockShard(Shard<Table>& shard);
+    // Copies the shard's table, applies mutate to the copy and publishes it. Caller holds the shard lock.
+    template <typename Table, typename Mutate>
+    static void UpdateShardLocked(Shard<Table>& shard, Mutate&& mutate);
+
+    Shard<SessionTable>& SessionShardFor(uint32_t session_id) const;
+    Shard<PlayerTable>& PlayerShardFor(uint64_t player_id) const;
+
+    // The writer-side endpoint table of one UDP shard and its published copy
+    using UdpTable = std::unordered_map<boost::asio::ip::udp::endpoint, std::weak_ptr<Session>, UdpEndpointHasher>;
+    struct alignas(64) UdpShard {
+        std::mutex write_mutex;
+        UdpTable endpoints;
+        std::atomic<std::shared_ptr<const UdpEndpointSnapshot>> snapshot{std::make_shared<const UdpEndpointSnapshot>()};
+        std::atomic<uint64_t> version{0};
+        std::atomic<uint64_t> copied_entries{0};
+    };
+
+    static bool IsBroadcastTarget(const std::shared_ptr<Session>& session);
+    void EraseUdpEndpoint(const boost::asio::ip::udp::endpoint& endpoint, const std::shared_ptr<Session>& session);
+    void PublishUdpSnapshotLocked(UdpShard& shard);
+
     std::atomic<uint32_t> m_next_session_id;
-    mutable std::shared_mutex m_mutex;
-    std::unordered_map<uint32_t, std::shared_ptr<Session>> m_sessions;
-    std::unordered_map<uint32_t, uint64_t> m_session_to_player_id;
+    std::atomic<size_t> m_session_count{0};
+    const size_t m_shard_count;
+    std::unique_ptr<Shard<SessionTable>[]> m_session_shards;
+    std::unique_ptr<Shard<PlayerTable>[]> m_player_shards;
 
     // [SEQUENCE: MVP6-20] A map from a UDP endpoint to a session ID enables quick O(1) lookup of the session associated with an incoming UDP packet.
-    std::unordered_map<boost::asio::ip::udp::endpoint, uint32_t, UdpEndpointHasher> m_udp_endpoint_to_session_id;
+    // [SEQUENCE: MVP19-106] Kept under their own locks so logins and logouts never block UDP endpoint changes,
+    // and vice versa.
+    std::unique_ptr<UdpShard[]> m_udp_shards;
+    std::atomic<uint64_t> m_udp_snapshot_version{0};
 };
 
 }
@@ -0,0 +1,220 @@
+#include "network/session_send_queue.h"
+
+#include <algorithm>
+
+namespace mmorpg::network {
+
+SendClass ClassifyPacket(mmorpg::proto::PacketType type) {
+    using namespace mmorpg::proto;
+    switch (type) {
+    case PACKET_LOGIN_RESPONSE:
+    case PACKET_LOGOUT_RESPONSE:
+    case PACKET_HEARTBEAT_RESPONSE:
+    case PACKET_ENTER_WORLD_RESPONSE:
+    case PACKET_HANDOFF_REDIRECT:
+    case PACKET_HANDOFF_CLAIM_RESPONSE:
+        return {SendPriority::Critical, false};
+    case PACKET_COMBAT_ACTION:
+    case PACKET_COMBAT_RESULT:
+        return {SendPriority::Combat, false};
+    case PACKET_ENTITY_DELTA_SNAPSHOT:
+        // Encoded against a baseline the client has acknowledged, so the newest one carries everything an
+        // unsent older one would
+        return {SendPriority::Movement, true};
+    case PACKET_MOVEMENT_UPDATE:
+    case PACKET_ENTITY_UPDATE:
+    case PACKET_ENTITY_UPDATE_BATCH:
+        return {SendPriority::Movement, false};
+    default:
+        return {SendPriority::Bulk, false};
+    }
+}
+
+SessionSendQueue::SessionSendQueue(SessionSendQueueConfig config, Clock::time_point now)
+    : m_config(config),
+      m_rate(std::clamp(config.initial_rate_bytes_per_second, config.min_rate_bytes_per_second,
+                        config.max_rate_bytes_per_second)),
+      m_tokens(0.0),
+      m_lastRefill(now) {
+    m_tokens = BucketDepth();
+}
+
+SessionSendQueue::PushResult SessionSendQueue::Push(mmorpg::proto::PacketType type, Packet&& packet,
+                                                    Clock::time_point now) {
+    return PushImpl(type, ClassifyPacket(type).supersede_by_type, 0, std::move(packet), now);
+}
+
+SessionSendQueue::PushResult SessionSendQueue::PushLatest(mmorpg::proto::PacketType type, uint64_t supersede_key,
+                                                          Packet&& packet, Clock::time_point now) {
+    return PushImpl(type, true, supersede_key, std::move(packet), now);
+}
+
+SessionSendQueue::PushResult SessionSendQueue::PushImpl(mmorpg::proto::PacketType type, bool has_key,
+                                                        uint64_t supersede_key, Packet&& packet,
+                                                        Clock::time_point now) {
+    const size_t size = packet.Bytes().size();
+    ClassQueue& queue = m_classes[static_cast<size_t>(ClassifyPacket(type).priority)];
+
+    if (has_key) {
+        auto it = m_latest.find(LatestKey{type, supersede_key});
+        if (it != m_latest.end()) {
+            Entry& stale = queue.entries[it->second - queue.head_sequence];
+            const size_t stale_size = stale.packet.Bytes().size();
+            if (m_queuedBytes - stale_size + size > m_config.max_queued_bytes) {
+                ++m_stats.overflows;
+                Release(packet);
+                return PushResult::Overflow;
+            }
+            Release(stale.packet);
+            stale.packet = std::move(packet);
+            m_queuedBytes = m_queuedBytes - stale_size + size;
+            m_stats.max_queued_bytes = std::max(m_stats.max_queued_bytes, m_queuedBytes);
+            ++m_stats.packets_superseded;
+            return PushResult::Superseded;
+        }
+    }
+
+    if (m_queuedBytes + size > m_config.max_queued_bytes) {
+        ++m_stats.overflows;
+        Release(packet);
+        return PushResult::Overflow;
+    }
+    if (has_key) {
+        m_latest.emplace(LatestKey{type, supersede_key}, queue.head_sequence + queue.entries.size());
+    }
+    queue.entries.push_back(Entry{std::move(packet), now, type, supersede_key, has_key});
+    ++m_queuedPackets;
+    m_queuedBytes += size;
+    m_stats.max_queued_bytes = std::max(m_stats.max_queued_bytes, m_queuedBytes);
+    ++m_stats.packets_queued;
+    return PushResult::Queued;
+}
+
+size_t SessionSendQueue::TakeBatch(Clock::time_point now, size_t max_bytes, size_t max_messages,
+                                   std::vector<std::byte>& out) {
+    if (Empty()) return 0;
+    Refill(now);
+    if (m_tokens <= 0.0) {
+        ++m_stats.throttled;
+        return 0;
+    }
+
+    size_t taken = 0;
+    size_t batch_bytes = 0;
+    while (!Empty() && taken < max_messages) {
+        ClassQueue& queue = m_classes[PickClass(now)];
+        Entry& next = queue.entries.front();
+        const auto& bytes = next.packet.Bytes();
+        if (taken > 0) {
+            if (batch_bytes + bytes.size() > max_bytes) break;
+            if (static_cast<double>(bytes.size()) > m_tokens) {
+                ++m_stats.throttled;
+                break;
+            }
+        }
+        out.insert(out.end(), bytes.begin(), bytes.end());
+        batch_bytes += bytes.size();
+        // The first packet may overdraw the bucket; the debt delays the next batch
+        m_tokens -= static_cast<double>(bytes.size());
+        PopFront(queue);
+        ++taken;
+    }
+    m_stats.packets_sent += taken;
+    return taken;
+}
+
+SessionSendQueue::Clock::duration SessionSendQueue::NextSendDelay(Clock::time_point now) const {
+    const double elapsed = std::chrono::duration<double>(now - m_lastRefill).count();
+    const double tokens = std::min(BucketDepth(), m_tokens + m_rate * elapsed);
+    if (tokens > 0.0) return Clock::duration::zero();
+    // Wait until the debt is repaid and a little more, so the retry never lands a hair short
+    const double seconds = (1.0 - tokens) / m_rate;
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+void SessionSendQueue::OnWriteComplete(size_t bytes, Clock::duration elapsed) {
+    if (bytes == 0) return;
+    const double seconds = std::max(std::chrono::duration<double>(elapsed).count(), 1e-4);
+    const double target = m_config.rate_headroom * static_cast<double>(bytes) / seconds;
+    // Only a write that waited on a full send buffer measures the client; a quick one is a lower bound
+    if (elapsed >= m_config.congested_write_time || target > m_rate) {
+        m_rate += m_config.rate_smoothing * (target - m_rate);
+        m_rate = std::clamp(m_rate, m_config.min_rate_bytes_per_second, m_config.max_rate_bytes_per_second);
+        m_tokens = std::min(m_tokens, BucketDepth());
+    }
+}
+
+void SessionSendQueue::Clear() {
+    for (auto& queue : m_classes) {
+        for (auto& entry : queue.entries) Release(entry.packet);
+        queue.head_sequence += queue.entries.size();
+        queue.entries.clear();
+    }
+    m_latest.clear();
+    m_queuedPackets = 0;
+    m_queuedBytes = 0;
+}
+
+SessionSendQueueStats SessionSendQueue::GetStats() const {
+    SessionSendQueueStats stats = m_stats;
+    stats.queued_packets = m_queuedPackets;
+    stats.queued_bytes = m_queuedBytes;
+    stats.rate_bytes_per_second = m_rate;
+    for (size_t i = 0; i < kSendPriorityCount; ++i) stats.queued_by_priority[i] = m_classes[i].entries.size();
+    return stats;
+}
+
+void SessionSendQueue::Refill(Clock::time_point now) {
+    if (now <= m_lastRefill) return;
+    const double elapsed = std::chrono::duration<double>(now - m_lastRefill).count();
+    m_tokens = std::min(BucketDepth(), m_tokens + m_rate * elapsed);
+    m_lastRefill = now;
+}
+
+// The highest non-empty class, unless some class's oldest packet has waited max_wait: then the longest
+// waiting of those goes first
+size_t SessionSendQueue::PickClass(Clock::time_point now) {
+    size_t highest = kSendPriorityCount;
+    size_t starved = kSendPriorityCount;
+    for (size_t i = 0; i < kSendPriorityCount; ++i) {
+        const auto& entries = m_classes[i].entries;
+        if (entries.empty()) continue;
+        if (highest == kSendPriorityCount) highest = i;
+        if (now - entries.front().queued_at >= m_config.max_wait &&
+            (starved == kSendPriorityCount ||
+             entries.front().queued_at < m_classes[starved].entries.front().queued_at)) {
+            starved = i;
+        }
+    }
+    if (starved != kSendPriorityCount && starved != highest) {
+        ++m_stats.promoted;
+        return starved;
+    }
+    return highest;
+}
+
+void SessionSendQueue::PopFront(ClassQueue& queue) {
+    Entry& entry = queue.entries.front();
+    if (entry.has_key) {
+        auto it = m_latest.find(LatestKey{entry.type, entry.key});
+        if (it != m_latest.end() && it->second == queue.head_sequence) m_latest.erase(it);
+    }
+    m_queuedBytes -= entry.packet.Bytes().size();
+    --m_queuedPackets;
+    Release(entry.packet);
+    queue.entries.pop_front();
+    ++queue.head_sequence;
+}
+
+void SessionSendQueue::Release(Packet& packet) {
+    packet.shared.reset();
+    if (m_recycle && packet.owned.capacity() > 0) m_recycle(std::move(packet.owned));
+    packet.owned = {};
+}
+
+double SessionSendQueue::BucketDepth() const {
+    const double depth = m_rate * std::chrono::duration<double>(m_config.burst).count();
+    return std::max(depth, static_cast<double>(m_config.min_burst_bytes));
+}
+
+} // namespace mmorpg::network
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "proto/packet.pb.h"
+#include "network/packet_serializer.h"
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-287] Outbound traffic classes, most urgent first. Under congestion a class only gets the link
+// once every class above it is empty, except that a class whose oldest packet has waited too long is served
+// first (see SessionSendQueueConfig::max_wait), so chat is delayed but never starved.
+enum class SendPriority : uint8_t {
+    Critical,   // Login, logout, heartbeats, world entry
+    Combat,
+    Movement,   // Entity state and snapshots
+    Bulk,       // Chat, guild and duel traffic, anything unclassified
+    Count
+};
+
+inline constexpr size_t kSendPriorityCount = static_cast<size_t>(SendPriority::Count);
+
+// How the queue treats one packet type. A superseding type carries the full current state of whatever its
+// key names, so a queued packet of the same type and key is stale once a newer one arrives.
+struct SendClass {
+    SendPriority priority = SendPriority::Bulk;
+    bool supersede_by_type = false;   // Every packet of the type shares key 0
+};
+
+SendClass ClassifyPacket(mmorpg::proto::PacketType type);
+
+struct SessionSendQueueConfig {
+    size_t max_queued_bytes = 4 * 1024 * 1024;   // Hard cap; a client this far behind is disconnected
+    std::chrono::milliseconds max_wait{250};     // Age at which a lower class jumps the priority order
+
+    // Token bucket. The refill rate follows the throughput the socket actually drained, times headroom, so
+    // the queue rather than the kernel send buffer holds the backlog and priorities decide what goes next.
+    double initial_rate_bytes_per_second = 8.0 * 1024 * 1024;
+    double min_rate_bytes_per_second = 16.0 * 1024;
+    double max_rate_bytes_per_second = 16.0 * 1024 * 1024 * 1024;
+    double rate_headroom = 1.25;
+    double rate_smoothing = 0.25;               // EWMA weight of each new throughput sample
+    // A write that takes this long found the kernel send buffer full, so its throughput is the client's drain
+    // rate. Quicker writes only show the link is at least that fast and can only raise the estimate.
+    std::chrono::milliseconds congested_write_time{2};
+    std::chrono::milliseconds burst{50};        // Bucket depth, in time at the current rate
+    size_t min_burst_bytes = 16 * 1024;         // Floor on the bucket depth so small rates still batch
+};
+
+struct SessionSendQueueStats {
+    uint64_t packets_queued = 0;
+    uint64_t packets_sent = 0;
+    uint64_t packets_superseded = 0;   // Replaced in place by a newer packet with the same key
+    uint64_t promoted = 0;             // Sent ahead of a higher class because it had waited max_wait
+    uint64_t throttled = 0;            // Batches cut short or delayed by the token bucket
+    uint64_t overflows = 0;            // Pushes refused by max_queued_bytes
+    size_t queued_packets = 0;
+    size_t queued_bytes = 0;
+    size_t max_queued_bytes = 0;       // High-water mark
+    double rate_bytes_per_second = 0.0;
+    std::array<size_t, kSendPriorityCount> queued_by_priority{};
+};
+
+// [SEQUENCE: MVP19-288] Per-session outbound scheduler between Send() and the socket, replacing the plain FIFO.
+//
+//  - One FIFO per SendPriority; batches are filled from the highest non-empty class, oldest-starved first.
+//  - A packet pushed with a supersede key replaces the queued packet with the same type and key in place: it
+//    keeps the old packet's slot, so the newest state goes out no later than the stale one would have, and a
+//    slow client receives one position per entity instead of a backlog of them. Session uses only the per-type
+//    form (SendClass::supersede_by_type): entity movement goes out in per-tick batches that each hold only
+//    that tick's movers, so a newer batch cannot stand in for an unsent older one.
+//  - A token bucket meters how many bytes each batch may hand to the socket. Its rate is learned from write
+//    completions: a socket that drains quickly yields a high rate and the bucket stays out of the way.
+//  - Every queued byte counts against max_queued_bytes, shared broadcast buffers included since the session
+//    pins them. Push fails past the cap and the session is expected to disconnect.
+//
+// Not thread-safe; a session drives it from its strand.
+class SessionSendQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // A queued packet: a buffer owned by the queue or a broadcast buffer shared with other sessions
+    struct Packet {
+        std::vector<std::byte> owned;
+        SharedPacketBuffer shared;
+
+        const std::vector<std::byte>& Bytes() const { return shared ? *shared : owned; }
+    };
+
+    enum class PushResult : uint8_t {
+        Queued,
+        Superseded,   // Replaced an older queued packet
+        Overflow,     // Over max_queued_bytes; the packet was not queued
+    };
+
+    explicit SessionSendQueue(SessionSendQueueConfig config = {}, Clock::time_point now = Clock::now());
+
+    // Owned buffers leaving the queue without being sent, replaced or dropped, are handed back through this
+    // (the session returns them to the BufferPool). Unset, they are simply freed.
+    void SetRecycler(void (*recycle)(std::vector<std::byte>&&)) { m_recycle = recycle; }
+
+    PushResult Push(mmorpg::proto::PacketType type, Packet&& packet, Clock::time_point now);
+    // Same, replacing any queued packet of the same type and supersede_key
+    PushResult PushLatest(mmorpg::proto::PacketType type, uint64_t supersede_key, Packet&& packet,
+                          Clock::time_point now);
+
+    // Appends the next packets to out, in scheduling order, within max_messages, max_bytes and the bucket. At
+    // least one packet is taken whenever the bucket is not in debt, however large it is. Returns the number of
+    // packets appended; 0 with a non-empty queue means the caller should retry after NextSendDelay().
+    size_t TakeBatch(Clock::time_point now, size_t max_bytes, size_t max_messages, std::vector<std::byte>& out);
+    Clock::duration NextSendDelay(Clock::time_point now) const;
+
+    // Feeds the throughput estimate: bytes handed to the socket and how long the write took to complete
+    void OnWriteComplete(size_t bytes, Clock::duration elapsed);
+
+    // Drops everything queued, e.g. on disconnect
+    void Clear();
+
+    bool Empty() const { return m_queuedPackets == 0; }
+    size_t GetQueuedPackets() const { return m_queuedPackets; }
+    size_t GetQueuedBytes() const { return m_queuedBytes; }
+    double GetRate() const { return m_rate; }
+    SessionSendQueueStats GetStats() const;
+
+private:
+    struct Entry {
+        Packet packet;
+        Clock::time_point queued_at;
+        mmorpg::proto::PacketType type = mmorpg::proto::PACKET_UNKNOWN;
+        uint64_t key = 0;   // Supersede key, valid when has_key
+        bool has_key = false;
+    };
+    // Each class numbers its entries consecutively, so a sequence number locates an entry in O(1)
+    struct ClassQueue {
+        std::deque<Entry> entries;
+        uint64_t head_sequence = 0;
+    };
+    struct LatestKey {
+        mmorpg::proto::PacketType type;
+        uint64_t key;
+        bool operator==(const LatestKey&) const = default;
+    };
+    struct LatestKeyHash {
+        size_t operator()(const LatestKey& latest) const {
+            return static_cast<size_t>((latest.key * 0x9E3779B97F4A7C15ull) ^ static_cast<uint64_t>(latest.type));
+        }
+    };
+
+    PushResult PushImpl(mmorpg::proto::PacketType type, bool has_key, uint64_t supersede_key, Packet&& packet,
+                        Clock::time_point now);
+    void Refill(Clock::time_point now);
+    size_t PickClass(Clock::time_point now);
+    void PopFront(ClassQueue& queue);
+    void Release(Packet& packet);
+    double BucketDepth() const;
+
+    const SessionSendQueueConfig m_config;
+    void (*m_recycle)(std::vector<std::byte>&&) = nullptr;
+    std::array<ClassQueue, kSendPriorityCount> m_classes;
+    std::unordered_map<LatestKey, uint64_t, LatestKeyHash> m_latest;   // -> sequence of the queued packet
+    size_t m_queuedPackets = 0;
+    size_t m_queuedBytes = 0;
+
+    double m_rate;
+    double m_tokens;
+    Clock::time_point m_lastRefill;
+
+    SessionSendQueueStats m_stats;
+};
+
+} // namespace mmorpg::network
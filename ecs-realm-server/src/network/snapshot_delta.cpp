@@ -0,0 +1,319 @@
+#include "network/snapshot_delta.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mmorpg::network {
+
+namespace {
+
+constexpr std::array<unsigned, 4> kDeltaWidths = {4, 8, 16, 32};
+constexpr std::array<unsigned, 4> kVarWidths = {8, 16, 32, 64};
+
+// [SEQUENCE: MVP19-159] LSB-first bit packing. Fields are at most 32 bits per call, so a 64-bit accumulator
+// never overflows.
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<std::byte>& out) : m_out(out) { m_out.clear(); }
+
+    void Write(uint64_t value, unsigned bits) {
+        if (bits > 32) {
+            Write(value & 0xFFFFFFFFu, 32);
+            Write(value >> 32, bits - 32);
+            return;
+        }
+        m_accumulator |= (value & ((uint64_t{1} << bits) - 1)) << m_bitCount;
+        m_bitCount += bits;
+        while (m_bitCount >= 8) {
+            m_out.push_back(static_cast<std::byte>(m_accumulator & 0xFF));
+            m_accumulator >>= 8;
+            m_bitCount -= 8;
+        }
+    }
+
+    void WriteClassed(uint64_t value, const std::array<unsigned, 4>& widths) {
+        unsigned width_class = 0;
+        while (width_class < 3 && widths[width_class] < 64 && (value >> widths[width_class]) != 0) {
+            ++width_class;
+        }
+        Write(width_class, 2);
+        Write(value, widths[width_class]);
+    }
+
+    void Finish() {
+        if (m_bitCount > 0) {
+            m_out.push_back(static_cast<std::byte>(m_accumulator & 0xFF));
+            m_accumulator = 0;
+            m_bitCount = 0;
+        }
+    }
+
+private:
+    std::vector<std::byte>& m_out;
+    uint64_t m_accumulator = 0;
+    unsigned m_bitCount = 0;
+};
+
+class BitReader {
+public:
+    BitReader(const std::byte* data, size_t size) : m_data(data), m_size(size) {}
+
+    uint64_t Read(unsigned bits) {
+        if (bits > 32) {
+            const uint64_t low = Read(32);
+            return low | (Read(bits - 32) << 32);
+        }
+        while (m_bitCount < bits) {
+            if (m_position >= m_size) {
+                m_failed = true;
+                return 0;
+            }
+            m_accumulator |= static_cast<uint64_t>(m_data[m_position++]) << m_bitCount;
+            m_bitCount += 8;
+        }
+        const uint64_t value = m_accumulator & ((uint64_t{1} << bits) - 1);
+        m_accumulator >>= bits;
+        m_bitCount -= bits;
+        return value;
+    }
+
+    uint64_t ReadClassed(const std::array<unsigned, 4>& widths) {
+        return Read(widths[Read(2)]);
+    }
+
+    bool Failed() const { return m_failed; }
+    size_t RemainingBits() const { return (m_size - m_position) * 8 + m_bitCount; }
+
+private:
+    const std::byte* m_data;
+    size_t m_size;
+    size_t m_position = 0;
+    uint64_t m_accumulator = 0;
+    unsigned m_bitCount = 0;
+    bool m_failed = false;
+};
+
+// Wrapping difference, so any pair of int32 values round-trips.
+uint32_t ZigZagDelta(int32_t value, int32_t base) {
+    const auto delta = static_cast<int32_t>(static_cast<uint32_t>(value) - static_cast<uint32_t>(base));
+    return (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+}
+
+int32_t ApplyZigZagDelta(int32_t base, uint32_t zigzag) {
+    const uint32_t delta = (zigzag >> 1) ^ (0u - (zigzag & 1u));
+    return static_cast<int32_t>(static_cast<uint32_t>(base) + delta);
+}
+
+const EntitySyncState kEmptyState{};
+
+// Minimum encoded size of one changed entity / one removal, used to reject impossible counts before allocating.
+constexpr size_t kMinChangedBits = 2 + 8 + kSyncFieldCount;
+constexpr size_t kMinRemovedBits = 2 + 8;
+
+} // namespace
+
+void EntitySyncState::Set(SyncField field, float value) {
+    const auto index = static_cast<size_t>(field);
+    const double scaled = std::round(static_cast<double>(value) / kSyncFieldResolution[index]);
+    fields[index] = static_cast<int32_t>(std::clamp(scaled,
+        static_cast<double>(std::numeric_limits<int32_t>::min()),
+        static_cast<double>(std::numeric_limits<int32_t>::max())));
+}
+
+float EntitySyncState::Get(SyncField field) const {
+    const auto index = static_cast<size_t>(field);
+    return static_cast<float>(fields[index] * static_cast<double>(kSyncFieldResolution[index]));
+}
+
+void SyncSnapshot::SortById() {
+    std::sort(entities.begin(), entities.end(),
+              [](const EntitySyncState& a, const EntitySyncState& b) { return a.entity_id < b.entity_id; });
+}
+
+const EntitySyncState* SyncSnapshot::Find(uint64_t entity_id) const {
+    auto it = std::lower_bound(entities.begin(), entities.end(), entity_id,
+                               [](const EntitySyncState& state, uint64_t id) { return state.entity_id < id; });
+    return it != entities.end() && it->entity_id == entity_id ? &*it : nullptr;
+}
+
+ClientBaselineTracker::ClientBaselineTracker(size_t ring_size)
+    : m_ring(std::max<size_t>(ring_size, 2)) {}
+
+void ClientBaselineTracker::Acknowledge(uint32_t tick) {
+    if (tick > m_ackedTick && FindSent(tick) != nullptr) {
+        m_ackedTick = tick;
+    }
+}
+
+const SyncSnapshot* ClientBaselineTracker::FindSent(uint32_t tick) const {
+    const SyncSnapshot& slot = m_ring[tick % m_ring.size()];
+    return tick != 0 && slot.tick == tick ? &slot : nullptr;
+}
+
+// [SEQUENCE: MVP19-160] A merge walk over the two sorted entity lists decides what goes on the wire. The baseline
+// is only used while it is younger than the ring, so its slot can never be the one this snapshot overwrites.
+void ClientBaselineTracker::Encode(const SyncSnapshot& snapshot, std::vector<std::byte>& out) {
+    const SyncSnapshot* baseline = nullptr;
+    if (m_ackedTick != 0 && snapshot.tick > m_ackedTick && snapshot.tick - m_ackedTick < m_ring.size()) {
+        baseline = FindSent(m_ackedTick);
+    }
+    const std::vector<EntitySyncState> no_entities;
+    const auto& base_entities = baseline != nullptr ? baseline->entities : no_entities;
+
+    std::vector<std::pair<const EntitySyncState*, const EntitySyncState*>> changed;   // (current, base)
+    std::vector<uint64_t> removed;
+    changed.reserve(snapshot.entities.size());
+
+    size_t b = 0;
+    for (const auto& current : snapshot.entities) {
+        while (b < base_entities.size() && base_entities[b].entity_id < current.entity_id) {
+            removed.push_back(base_entities[b++].entity_id);
+        }
+        if (b < base_entities.size() && base_entities[b].entity_id == current.entity_id) {
+            if (base_entities[b].fields != current.fields) {
+                changed.emplace_back(&current, &base_entities[b]);
+            } else {
+                ++m_stats.entities_unchanged;
+            }
+            ++b;
+        } else {
+            changed.emplace_back(&current, &kEmptyState);
+        }
+    }
+    for (; b < base_entities.size(); ++b) {
+        removed.push_back(base_entities[b].entity_id);
+    }
+
+    BitWriter writer(out);
+    writer.Write(snapshot.tick, 32);
+    writer.Write(baseline != nullptr ? baseline->tick : 0, 32);
+    writer.WriteClassed(changed.size(), kVarWidths);
+    writer.WriteClassed(removed.size(), kVarWidths);
+
+    uint64_t previous_id = 0;
+    for (const auto& [current, base] : changed) {
+        writer.WriteClassed(current->entity_id - previous_id, kVarWidths);
+        previous_id = current->entity_id;
+
+        uint32_t mask = 0;
+        for (size_t f = 0; f < kSyncFieldCount; ++f) {
+            if (current->fields[f] != base->fields[f]) {
+                mask |= 1u << f;
+            }
+        }
+        writer.Write(mask, kSyncFieldCount);
+        for (size_t f = 0; f < kSyncFieldCount; ++f) {
+            if (mask & (1u << f)) {
+                writer.WriteClassed(ZigZagDelta(current->fields[f], base->fields[f]), kDeltaWidths);
+            }
+        }
+    }
+    previous_id = 0;
+    for (uint64_t id : removed) {
+        writer.WriteClassed(id - previous_id, kVarWidths);
+        previous_id = id;
+    }
+    writer.Finish();
+
+    SyncSnapshot& slot = m_ring[snapshot.tick % m_ring.size()];
+    slot.tick = snapshot.tick;
+    slot.entities.assign(snapshot.entities.begin(), snapshot.entities.end());
+
+    ++m_stats.snapshots_encoded;
+    if (baseline == nullptr) {
+        ++m_stats.full_snapshots;
+    }
+    m_stats.bytes_encoded += out.size();
+    m_stats.entities_written += changed.size();
+    m_stats.entities_removed += removed.size();
+}
+
+SnapshotDeltaDecoder::SnapshotDeltaDecoder(size_t ring_size)
+    : m_ring(std::max<size_t>(ring_size, 2)) {}
+
+// [SEQUENCE: MVP19-161] Decodes the changed entities against the baseline, then merges them with the baseline's
+// unchanged entities minus the removals. The result is kept as a baseline for later packets.
+bool SnapshotDeltaDecoder::Decode(const std::byte* data, size_t size, SyncSnapshot& out) {
+    BitReader reader(data, size);
+    const auto tick = static_cast<uint32_t>(reader.Read(32));
+    const auto baseline_tick = static_cast<uint32_t>(reader.Read(32));
+    const uint64_t changed_count = reader.ReadClassed(kVarWidths);
+    const uint64_t removed_count = reader.ReadClassed(kVarWidths);
+    if (reader.Failed() || tick == 0 ||
+        changed_count > reader.RemainingBits() / kMinChangedBits ||
+        removed_count > reader.RemainingBits() / kMinRemovedBits) {
+        return false;
+    }
+
+    const SyncSnapshot* baseline = nullptr;
+    if (baseline_tick != 0) {
+        const SyncSnapshot& slot = m_ring[baseline_tick % m_ring.size()];
+        if (slot.tick != baseline_tick || baseline_tick >= tick) {
+            return false;
+        }
+        baseline = &slot;
+    }
+
+    std::vector<EntitySyncState> changed(changed_count);
+    uint64_t id = 0;
+    for (auto& state : changed) {
+        const uint64_t gap = reader.ReadClassed(kVarWidths);
+        if (gap == 0 && &state != &changed.front()) {
+            return false;   // Ids must be strictly increasing
+        }
+        id += gap;
+        const EntitySyncState* base = baseline != nullptr ? baseline->Find(id) : nullptr;
+        state = base != nullptr ? *base : kEmptyState;
+        state.entity_id = id;
+
+        const auto mask = static_cast<uint32_t>(reader.Read(kSyncFieldCount));
+        for (size_t f = 0; f < kSyncFieldCount; ++f) {
+            if (mask & (1u << f)) {
+                state.fields[f] = ApplyZigZagDelta(state.fields[f],
+                                                   static_cast<uint32_t>(reader.ReadClassed(kDeltaWidths)));
+            }
+        }
+    }
+    std::vector<uint64_t> removed(removed_count);
+    id = 0;
+    for (auto& removed_id : removed) {
+        id += reader.ReadClassed(kVarWidths);
+        removed_id = id;
+    }
+    if (reader.Failed()) {
+        return false;
+    }
+
+    out.tick = tick;
+    out.entities.clear();
+    const std::vector<EntitySyncState> no_entities;
+    const auto& base_entities = baseline != nullptr ? baseline->entities : no_entities;
+    size_t b = 0, c = 0, r = 0;
+    while (b < base_entities.size() || c < changed.size()) {
+        const bool take_changed = b == base_entities.size() ||
+            (c < changed.size() && changed[c].entity_id <= base_entities[b].entity_id);
+        if (take_changed) {
+            if (b < base_entities.size() && base_entities[b].entity_id == changed[c].entity_id) {
+                ++b;
+            }
+            out.entities.push_back(changed[c++]);
+            continue;
+        }
+        const uint64_t base_id = base_entities[b].entity_id;
+        while (r < removed.size() && removed[r] < base_id) {
+            ++r;
+        }
+        if (r == removed.size() || removed[r] != base_id) {
+            out.entities.push_back(base_entities[b]);
+        }
+        ++b;
+    }
+
+    SyncSnapshot& slot = m_ring[tick % m_ring.size()];
+    slot.tick = out.tick;
+    slot.entities = out.entities;
+    return true;
+}
+
+} // namespace mmorpg::network
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-154] The fixed, typed schema of replicated entity state. Every field is quantized to a signed
+// 32-bit integer at the resolution below, so a baseline comparison is an integer compare and a delta is an
+// integer difference. Adding a field means appending it here and to kSyncFieldResolution.
+enum class SyncField : uint8_t {
+    PositionX, PositionY, PositionZ,   // metres
+    RotationX, RotationY, RotationZ,   // radians
+    VelocityX, VelocityY, VelocityZ,   // metres / second
+    Health, MaxHealth, Shield,
+    Count
+};
+
+inline constexpr size_t kSyncFieldCount = static_cast<size_t>(SyncField::Count);
+
+inline constexpr std::array<float, kSyncFieldCount> kSyncFieldResolution = {
+    0.01f, 0.01f, 0.01f,      // 1 cm
+    0.001f, 0.001f, 0.001f,   // 1 mrad
+    0.01f, 0.01f, 0.01f,      // 1 cm/s
+    0.1f, 0.1f, 0.1f,
+};
+
+// [SEQUENCE: MVP19-155] One entity's quantized state.
+struct EntitySyncState {
+    uint64_t entity_id = 0;
+    std::array<int32_t, kSyncFieldCount> fields{};
+
+    void Set(SyncField field, float value);
+    float Get(SyncField field) const;
+
+    bool operator==(const EntitySyncState& other) const = default;
+};
+
+// [SEQUENCE: MVP19-156] Everything one client can see at one tick, sorted by entity id.
+struct SyncSnapshot {
+    uint32_t tick = 0;
+    std::vector<EntitySyncState> entities;
+
+    void SortById();
+    const EntitySyncState* Find(uint64_t entity_id) const;
+};
+
+struct SnapshotDeltaStats {
+    uint64_t snapshots_encoded = 0;
+    uint64_t full_snapshots = 0;       // No usable baseline: first snapshot, nothing acked, or baseline expired
+    uint64_t bytes_encoded = 0;
+    uint64_t entities_written = 0;     // New or changed relative to the baseline
+    uint64_t entities_unchanged = 0;   // Identical to the baseline, not sent at all
+    uint64_t entities_removed = 0;
+};
+
+// [SEQUENCE: MVP19-157] Server side of per-client delta sync. Remembers the last ring_size snapshots sent to one
+// client and encodes each new one against the newest snapshot the client has acknowledged. Entities equal to the
+// baseline cost nothing, changed ones send only their changed fields as bit-packed zigzag deltas, and entities
+// that left the client's view are listed by id. With no acknowledged snapshot still in the ring, the snapshot is
+// encoded against an empty baseline, i.e. as full state.
+//
+// Wire format (bit stream, LSB first, padded to a byte):
+//   tick:32 baseline_tick:32 (0 = full state) changed_count:V removed_count:V
+//   changed_count x { id_gap:V field_mask:kSyncFieldCount { class:2 zigzag_delta:(4|8|16|32) } per set bit }
+//   removed_count x { id_gap:V }
+// where V is a 2-bit width class followed by 8, 16, 32 or 64 bits, and id gaps are from the previous id in the
+// same list (ids are sorted).
+class ClientBaselineTracker {
+public:
+    static constexpr size_t kDefaultRingSize = 32;
+
+    explicit ClientBaselineTracker(size_t ring_size = kDefaultRingSize);
+
+    // The client decoded the snapshot for tick. Older acknowledgements than the newest one are ignored.
+    void Acknowledge(uint32_t tick);
+    uint32_t GetAckedTick() const { return m_ackedTick; }
+
+    // Encodes snapshot (sorted by id, tick > 0 and increasing) into out and remembers it as a future baseline.
+    void Encode(const SyncSnapshot& snapshot, std::vector<std::byte>& out);
+
+    const SnapshotDeltaStats& GetStats() const { return m_stats; }
+
+private:
+    const SyncSnapshot* FindSent(uint32_t tick) const;
+
+    std::vector<SyncSnapshot> m_ring;   // Slot tick % ring size
+    uint32_t m_ackedTick = 0;
+    SnapshotDeltaStats m_stats;
+};
+
+// [SEQUENCE: MVP19-158] Client side: rebuilds full snapshots from deltas against its own copies of the baselines.
+class SnapshotDeltaDecoder {
+public:
+    explicit SnapshotDeltaDecoder(size_t ring_size = ClientBaselineTracker::kDefaultRingSize);
+
+    // Returns false for a malformed packet or one whose baseline this decoder no longer holds.
+    bool Decode(const std::byte* data, size_t size, SyncSnapshot& out);
+
+private:
+    std::vector<SyncSnapshot> m_ring;
+};
+
+} // namespace mmorpg::network
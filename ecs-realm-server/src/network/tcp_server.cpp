@@ -1,5 +1,6 @@
 #include "network/tcp_server.h"
 #include "network/session.h"
+#include "network/kernel_tls.h"
 #include "core/logger.h"
 
 namespace mmorpg::network {
@@ -12,11 +13,46 @@ TcpServer::TcpServer(boost::asio::io_context& io_context,
                    short port,
                    const std::string& cert_file,
                    const std::string& key_file)
-    : acceptor_(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port)),
-      ssl_context_(boost::asio::ssl::context::sslv23),
+    : ssl_context_(boost::asio::ssl::context::sslv23),
       session_manager_(session_manager),
       packet_handler_(packet_handler) {
+    auto acceptor = std::make_unique<Acceptor>(io_context);
+    acceptor->acceptor = boost::asio::ip::tcp::acceptor(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port));
+    acceptors_.push_back(std::move(acceptor));
+    init_ssl_context(cert_file, key_file);
+}
+
+// [SEQUENCE: MVP19-135] Binds every acceptor before any accept is issued, so a bind failure (port in use, or
+// SO_REUSEPORT refused) surfaces from the constructor like the single-acceptor case.
+TcpServer::TcpServer(IoContextPool& pool,
+                   std::shared_ptr<SessionManager> session_manager,
+                   std::shared_ptr<IPacketHandler> packet_handler,
+                   uint16_t port,
+                   const std::string& cert_file,
+                   const std::string& key_file)
+    : ssl_context_(boost::asio::ssl::context::sslv23),
+      session_manager_(session_manager),
+      packet_handler_(packet_handler) {
+    using reuse_port = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+    const bool shard = pool.GetContextCount() > 1;
+
+    for (size_t i = 0; i < pool.GetContextCount(); ++i) {
+        auto acceptor = std::make_unique<Acceptor>(pool.GetContext(i));
+        auto& socket = acceptor->acceptor;
+        socket.open(boost::asio::ip::tcp::v4());
+        socket.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+        if (shard) {
+            socket.set_option(reuse_port(true));
+        }
+        socket.bind(boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port));
+        socket.listen();
+        port = socket.local_endpoint().port();
+        acceptors_.push_back(std::move(acceptor));
+    }
+    init_ssl_context(cert_file, key_file);
+}
 
+void TcpServer::init_ssl_context(const std::string& cert_file, const std::string& key_file) {
     ssl_context_.set_options(
         boost::asio::ssl::context::default_workarounds |
         boost::asio::ssl::context::no_sslv2 |
@@ -31,28 +67,70 @@ TcpServer::TcpServer(boost::asio::io_context& io_context,
     }
 }
 
+// [SEQUENCE: MVP19-444] Probes kernel TLS once here rather than on the first handshake. When no cipher can be
+// offloaded, sessions are not prepared for it at all and keep their session tickets.
+void TcpServer::SetSessionWriteConfig(const SessionWriteConfig& config) {
+    session_write_config_ = config;
+    if (!config.kernel_tls) return;
+
+    const auto& support = kernel_tls::ProbeSupport();
+    if (!support.Any()) {
+        LOG_INFO("Kernel TLS unavailable ({}); sessions stay on userspace TLS.",
+                 support.ulp ? "no TLS 1.3 cipher accepted" : "tls ULP missing");
+        session_write_config_.kernel_tls = false;
+        return;
+    }
+    LOG_INFO("Kernel TLS offload: AES-128-GCM {}, AES-256-GCM {}, ChaCha20-Poly1305 {}.",
+             support.aes_128_gcm ? "yes" : "no", support.aes_256_gcm ? "yes" : "no",
+             support.chacha20_poly1305 ? "yes" : "no");
+    kernel_tls::InstallSecretCapture(ssl_context_.native_handle());
+}
+
 void TcpServer::run() {
-    LOG_INFO("Asynchronous SSL TCP server started on port {}", acceptor_.local_endpoint().port());
-    do_accept();
+    LOG_INFO("Asynchronous SSL TCP server started on port {} with {} acceptor(s)", port(), acceptors_.size());
+    for (auto& acceptor : acceptors_) {
+        do_accept(*acceptor);
+    }
 }
 
 void TcpServer::stop() {
-    acceptor_.close();
+    for (auto& acceptor : acceptors_) {
+        boost::system::error_code ec;
+        acceptor->acceptor.close(ec);
+    }
+}
+
+uint16_t TcpServer::port() const {
+    boost::system::error_code ec;
+    const auto endpoint = acceptors_.front()->acceptor.local_endpoint(ec);
+    return ec ? 0 : endpoint.port();
+}
+
+std::vector<uint64_t> TcpServer::accept_counts() const {
+    std::vector<uint64_t> counts;
+    counts.reserve(acceptors_.size());
+    for (const auto& acceptor : acceptors_) {
+        counts.push_back(acceptor->accepted.load(std::memory_order_relaxed));
+    }
+    return counts;
 }
 
 // [SEQUENCE: MVP6-11] The core accept loop. When a new connection is accepted, it creates a Session,
 // passes the SSL context to it, and calls Start() on the new session to initiate the handshake.
-void TcpServer::do_accept() {
-    acceptor_.async_accept(
-        [this](const boost::system::error_code& error, boost::asio::ip::tcp::socket socket) {
+// [SEQUENCE: MVP19-136] The accepted socket is bound to the acceptor's io_context, and so is the session's strand.
+void TcpServer::do_accept(Acceptor& acceptor) {
+    acceptor.acceptor.async_accept(
+        [this, &acceptor](const boost::system::error_code& error, boost::asio::ip::tcp::socket socket) {
             if (!error) {
+                acceptor.accepted.fetch_add(1, std::memory_order_relaxed);
                 try {
                     auto session_id = session_manager_->get_next_session_id();
                     auto new_session = std::make_shared<Session>(
                         std::move(socket),
                         ssl_context_,
                         session_id,
-                        packet_handler_);
+                        packet_handler_,
+                        session_write_config_);
                     
                     session_manager_->Register(new_session);
                     new_session->Start(); // The session itself will initiate the handshake
@@ -65,8 +143,8 @@ void TcpServer::do_accept() {
                 LOG_ERROR("Accept error: {}", error.message());
             }
 
-            if (acceptor_.is_open()) {
-                do_accept();
+            if (acceptor.acceptor.is_open()) {
+                do_accept(acceptor);
             }
         });
 }
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 #include <boost/asio.hpp>
 #include <boost/asio/ssl.hpp>
 
 #include "network/session_manager.h"
 #include "network/packet_handler.h"
+#include "network/session.h"
+#include "network/io_context_pool.h"
 
 namespace mmorpg::network {
 
@@ -20,17 +24,44 @@ public:
               short port,
               const std::string& cert_file,
               const std::string& key_file);
+    // [SEQUENCE: MVP19-134] One acceptor per pool context. With more than one context the acceptors share the
+    // port through SO_REUSEPORT, the kernel spreads incoming connections across them, and every session stays
+    // on the context (core) that accepted it. Port 0 binds the first acceptor to an ephemeral port.
+    TcpServer(IoContextPool& pool,
+              std::shared_ptr<SessionManager> session_manager,
+              std::shared_ptr<IPacketHandler> packet_handler,
+              uint16_t port,
+              const std::string& cert_file,
+              const std::string& key_file);
 
     void run();
     void stop();
 
+    // [SEQUENCE: MVP19-32] Write coalescing caps applied to every session accepted after this call.
+    // [SEQUENCE: MVP19-126] Enabling kernel_tls also registers traffic secret capture on the shared context.
+    void SetSessionWriteConfig(const SessionWriteConfig& config);
+
+    uint16_t port() const;
+    size_t acceptor_count() const { return acceptors_.size(); }
+    // Connections accepted so far by each acceptor, in pool context order.
+    std::vector<uint64_t> accept_counts() const;
+
 private:
-    void do_accept();
+    struct Acceptor {
+        explicit Acceptor(boost::asio::io_context& io_context) : acceptor(io_context) {}
+
+        boost::asio::ip::tcp::acceptor acceptor;
+        std::atomic<uint64_t> accepted{0};
+    };
+
+    void init_ssl_context(const std::string& cert_file, const std::string& key_file);
+    void do_accept(Acceptor& acceptor);
 
-    boost::asio::ip::tcp::acceptor acceptor_;
+    std::vector<std::unique_ptr<Acceptor>> acceptors_;
     boost::asio::ssl::context ssl_context_;
     std::shared_ptr<SessionManager> session_manager_;
     std::shared_ptr<IPacketHandler> packet_handler_;
+    SessionWriteConfig session_write_config_;
 };
 
 }
@@ -0,0 +1,166 @@
+#include "network/udp_datagram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace mmorpg::network {
+
+namespace {
+
+template <typename T>
+void StoreLE(std::byte* out, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out[i] = static_cast<std::byte>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+    }
+}
+
+template <typename T>
+T LoadLE(const std::byte* in) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<uint64_t>(std::to_integer<uint8_t>(in[i])) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+// Round to the nearest step and saturate to the target integer range.
+template <typename T>
+T Quantize(float value, float scale) {
+    const double scaled = std::round(static_cast<double>(value) * scale);
+    const double clamped = std::clamp(scaled, static_cast<double>(std::numeric_limits<T>::min()),
+                                      static_cast<double>(std::numeric_limits<T>::max()));
+    return static_cast<T>(clamped);
+}
+
+constexpr float kPositionScale = 100.0f;   // centimetres
+constexpr float kVelocityScale = 100.0f;   // cm/s
+constexpr float kTwoPi = 2.0f * std::numbers::pi_v<float>;
+
+constexpr int kRemoteShift = 32;
+constexpr uint64_t kHasRemote = uint64_t{1} << 48;
+
+} // namespace
+
+void EncodeUdpHeader(const UdpDatagramHeader& header, std::byte* out) {
+    StoreLE<uint16_t>(out + 0, UdpDatagramHeader::kMagic);
+    out[2] = static_cast<std::byte>(header.type);
+    out[3] = static_cast<std::byte>(header.flags);
+    StoreLE<uint64_t>(out + 4, header.session_token);
+    StoreLE<uint16_t>(out + 12, header.sequence);
+    StoreLE<uint16_t>(out + 14, header.ack);
+    StoreLE<uint32_t>(out + 16, header.ack_bits);
+}
+
+bool DecodeUdpHeader(const std::byte* data, size_t size, UdpDatagramHeader& header) {
+    if (size < UdpDatagramHeader::kSize || LoadLE<uint16_t>(data) != UdpDatagramHeader::kMagic) {
+        return false;
+    }
+    header.type = static_cast<UdpMessageType>(std::to_integer<uint8_t>(data[2]));
+    header.flags = std::to_integer<uint8_t>(data[3]);
+    header.session_token = LoadLE<uint64_t>(data + 4);
+    header.sequence = LoadLE<uint16_t>(data + 12);
+    header.ack = LoadLE<uint16_t>(data + 14);
+    header.ack_bits = LoadLE<uint32_t>(data + 16);
+    return true;
+}
+
+// [SEQUENCE: MVP19-63] Fixed-point movement codec. No allocation and no protobuf on either side.
+void EncodeMovement(const MovementSample& sample, std::byte* out) {
+    for (int axis = 0; axis < 3; ++axis) {
+        StoreLE<int32_t>(out + axis * 4, Quantize<int32_t>(sample.position[axis], kPositionScale));
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        StoreLE<int16_t>(out + 12 + axis * 2, Quantize<int16_t>(sample.velocity[axis], kVelocityScale));
+    }
+    // Wrap yaw into one turn before mapping it onto the full 16-bit range.
+    float turns = sample.yaw / kTwoPi;
+    turns -= std::floor(turns);
+    StoreLE<uint16_t>(out + 18, static_cast<uint16_t>(static_cast<uint32_t>(std::lround(turns * 65536.0f)) & 0xFFFF));
+    StoreLE<uint32_t>(out + 20, sample.client_time_ms);
+}
+
+bool DecodeMovement(const std::byte* data, size_t size, MovementSample& sample) {
+    if (size < kQuantizedMovementSize) {
+        return false;
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        sample.position[axis] = static_cast<float>(LoadLE<int32_t>(data + axis * 4)) / kPositionScale;
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        sample.velocity[axis] = static_cast<float>(LoadLE<int16_t>(data + 12 + axis * 2)) / kVelocityScale;
+    }
+    // Read the yaw fraction as signed so it lands in [-pi, pi).
+    sample.yaw = static_cast<float>(LoadLE<int16_t>(data + 18)) * (kTwoPi / 65536.0f);
+    sample.client_time_ms = LoadLE<uint32_t>(data + 20);
+    return true;
+}
+
+std::array<std::byte, UdpDatagramHeader::kSize + kQuantizedMovementSize> BuildMovementDatagram(
+    const UdpDatagramHeader& header, const MovementSample& sample) {
+    std::array<std::byte, UdpDatagramHeader::kSize + kQuantizedMovementSize> datagram{};
+    UdpDatagramHeader movement_header = header;
+    movement_header.type = UdpMessageType::Movement;
+    EncodeUdpHeader(movement_header, datagram.data());
+    EncodeMovement(sample, datagram.data() + UdpDatagramHeader::kSize);
+    return datagram;
+}
+
+// [SEQUENCE: MVP19-64] Slides the 32-packet receive window with a CAS loop. Only one ingest worker sees a
+// given flow, so the loop practically never retries; the atomic keeps the send path's GetAck consistent.
+UdpChannelState::ReceiveResult UdpChannelState::OnReceive(uint16_t sequence) {
+    uint64_t current = m_remote.load(std::memory_order_acquire);
+    while (true) {
+        ReceiveResult result;
+        uint64_t next;
+        const uint16_t newest = static_cast<uint16_t>(current >> kRemoteShift);
+        uint32_t bits = static_cast<uint32_t>(current);
+
+        if (!(current & kHasRemote)) {
+            result = ReceiveResult::Newest;
+            next = kHasRemote | (uint64_t{sequence} << kRemoteShift);
+        } else if (SequenceGreaterThan(sequence, newest)) {
+            const uint16_t shift = static_cast<uint16_t>(sequence - newest);
+            // The previous newest becomes bit (shift - 1); anything older than 32 falls off the window.
+            bits = shift > 32 ? 0 : static_cast<uint32_t>((uint64_t{bits} << shift) | (uint64_t{1} << (shift - 1)));
+            result = ReceiveResult::Newest;
+            next = kHasRemote | (uint64_t{sequence} << kRemoteShift) | bits;
+        } else {
+            const uint16_t distance = static_cast<uint16_t>(newest - sequence);
+            if (distance == 0 || distance > 32 || (bits & (uint32_t{1} << (distance - 1)))) {
+                return ReceiveResult::Duplicate;
+            }
+            bits |= uint32_t{1} << (distance - 1);
+            result = ReceiveResult::Late;
+            next = (current & ~uint64_t{0xFFFFFFFF}) | bits;
+        }
+
+        if (m_remote.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return result;
+        }
+    }
+}
+
+bool UdpChannelState::OnMovement(uint16_t sequence) {
+    constexpr uint32_t kHasMovement = uint32_t{1} << 16;
+    uint32_t current = m_movement.load(std::memory_order_acquire);
+    while (true) {
+        if ((current & kHasMovement) && !SequenceGreaterThan(sequence, static_cast<uint16_t>(current))) {
+            return false;
+        }
+        if (m_movement.compare_exchange_weak(current, kHasMovement | sequence, std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+            return true;
+        }
+    }
+}
+
+bool UdpChannelState::GetAck(uint16_t& ack, uint32_t& ack_bits) const {
+    const uint64_t current = m_remote.load(std::memory_order_acquire);
+    ack = static_cast<uint16_t>(current >> kRemoteShift);
+    ack_bits = static_cast<uint32_t>(current);
+    return (current & kHasRemote) != 0;
+}
+
+} // namespace mmorpg::network
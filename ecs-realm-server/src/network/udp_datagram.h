@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-58] Gameplay datagram types carried on the UDP channel. The type byte sits right
+// after the magic so a datagram can be routed without decoding the rest of the header.
+enum class UdpMessageType : uint8_t {
+    Handshake = 1,   // Payload: player_id (u64). Binds the source endpoint to the TCP session.
+    Movement = 2,    // Payload: QuantizedMovement.
+    // [SEQUENCE: MVP19-86] Reliability layer (udp_reliability.h).
+    Channel = 3,     // Payload: channel header + message or fragment.
+    Ack = 4,         // No payload. Carries acks when there is nothing else to send; never acked itself.
+};
+
+// [SEQUENCE: MVP19-59] Fixed 20-byte little-endian header in front of every gameplay datagram.
+//   magic(2) type(1) flags(1) session_token(8) sequence(2) ack(2) ack_bits(4)
+// session_token is the per-session secret handed out in LoginResponse.udp_token; a datagram whose token
+// does not match the session bound to its endpoint is dropped. sequence/ack/ack_bits follow the usual
+// scheme: ack is the newest remote sequence seen, bit i of ack_bits acknowledges (ack - 1 - i).
+struct UdpDatagramHeader {
+    static constexpr uint16_t kMagic = 0x4D52;  // "RM"
+    static constexpr size_t kSize = 20;
+    static constexpr uint8_t kFlagHasAck = 0x01;  // ack/ack_bits are meaningful (the sender has heard from us)
+
+    UdpMessageType type = UdpMessageType::Movement;
+    uint8_t flags = 0;
+    uint64_t session_token = 0;
+    uint16_t sequence = 0;
+    uint16_t ack = 0;
+    uint32_t ack_bits = 0;
+};
+
+// Writes the header into out[0, kSize). out must have room for UdpDatagramHeader::kSize bytes.
+void EncodeUdpHeader(const UdpDatagramHeader& header, std::byte* out);
+// Returns false if the datagram is too short or does not carry the magic.
+bool DecodeUdpHeader(const std::byte* data, size_t size, UdpDatagramHeader& header);
+
+// [SEQUENCE: MVP19-60] Movement sample quantized for the wire (24 bytes):
+//   position in centimetres (i32 x3), velocity in cm/s (i16 x3), yaw as a 16-bit fraction of a turn,
+//   and the client's timestamp in milliseconds.
+// Position error is bounded by 0.5cm per axis, velocity by 0.5cm/s, yaw by pi/65536 rad.
+struct MovementSample {
+    float position[3] = {0.0f, 0.0f, 0.0f};
+    float velocity[3] = {0.0f, 0.0f, 0.0f};
+    float yaw = 0.0f;                // Radians, any range; wrapped to [-pi, pi) on decode
+    uint32_t client_time_ms = 0;
+};
+
+inline constexpr size_t kQuantizedMovementSize = 24;
+
+void EncodeMovement(const MovementSample& sample, std::byte* out);
+bool DecodeMovement(const std::byte* data, size_t size, MovementSample& sample);
+
+// Builds a complete movement datagram (header + payload). Used by clients, bots and tests.
+std::array<std::byte, UdpDatagramHeader::kSize + kQuantizedMovementSize> BuildMovementDatagram(
+    const UdpDatagramHeader& header, const MovementSample& sample);
+
+// [SEQUENCE: MVP19-61] Wrap-around aware comparison of 16-bit sequence numbers.
+constexpr bool SequenceGreaterThan(uint16_t a, uint16_t b) {
+    return ((a > b) && (a - b <= 32768)) || ((a < b) && (b - a > 32768));
+}
+
+// [SEQUENCE: MVP19-62] Per-session UDP sequence state. The remote sequence and ack bitfield are packed
+// into one atomic word so the ingest worker can update them without a lock while the send path reads them.
+class UdpChannelState {
+public:
+    enum class ReceiveResult {
+        Newest,     // Newer than anything seen so far
+        Late,       // Older than the newest but not seen before (within the 32-packet window)
+        Duplicate,  // Already seen, or too old to tell
+    };
+
+    ReceiveResult OnReceive(uint16_t sequence);
+
+    // [SEQUENCE: MVP19-409] Newest movement sample seen, kept apart from the receive window: Channel and Ack
+    // datagrams share the sequence space, so a reliable datagram that arrived out of order must not make the
+    // next movement sample look stale. True if sequence is newer than every movement sample so far.
+    bool OnMovement(uint16_t sequence);
+
+    // Ack fields to piggyback on the next outbound datagram. Returns false until a packet has been received.
+    bool GetAck(uint16_t& ack, uint32_t& ack_bits) const;
+
+    uint16_t NextLocalSequence() { return m_localSequence.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+    // Layout: bit 48 = has_remote, bits 32..47 = newest remote sequence, bits 0..31 = ack_bits.
+    std::atomic<uint64_t> m_remote{0};
+    std::atomic<uint16_t> m_localSequence{0};
+    // Bit 16 = has_movement, bits 0..15 = newest movement sequence
+    std::atomic<uint32_t> m_movement{0};
+};
+
+} // namespace mmorpg::network
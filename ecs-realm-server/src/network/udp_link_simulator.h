@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-92] Impairments applied by UdpLinkSimulator. Jitter is uniform in [-jitter, +jitter] and is
+// what produces reordering; the seed makes a run reproducible.
+struct UdpLinkConditions {
+    double loss_rate = 0.0;
+    double duplicate_rate = 0.0;
+    std::chrono::milliseconds latency{0};
+    std::chrono::milliseconds jitter{0};
+    uint64_t seed = 1;
+};
+
+// [SEQUENCE: MVP19-93] One direction of a lossy, delaying link for loopback tests of the reliability layer.
+// Datagrams go in with Submit() and come out of Deliver() once their delivery time has passed. Driven by the
+// caller's clock, so tests can step simulated time instead of sleeping.
+class UdpLinkSimulator {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t dropped = 0;
+        uint64_t duplicated = 0;
+        uint64_t delivered = 0;
+    };
+
+    explicit UdpLinkSimulator(UdpLinkConditions conditions)
+        : m_conditions(conditions), m_random(conditions.seed) {}
+
+    void Submit(const std::byte* data, size_t size, Clock::time_point now) {
+        ++m_stats.submitted;
+        if (Roll() < m_conditions.loss_rate) {
+            ++m_stats.dropped;
+            return;
+        }
+        Schedule(data, size, now);
+        if (Roll() < m_conditions.duplicate_rate) {
+            ++m_stats.duplicated;
+            Schedule(data, size, now);
+        }
+    }
+
+    // Hands every datagram due at or before now to deliver(const std::byte*, size_t), in delivery-time order.
+    template <typename DeliverFn>
+    size_t Deliver(Clock::time_point now, DeliverFn&& deliver) {
+        size_t count = 0;
+        while (!m_inFlight.empty() && m_inFlight.top().due <= now) {
+            // priority_queue::top is const; the datagram is copied out before pop so deliver may Submit again.
+            InFlight datagram = m_inFlight.top();
+            m_inFlight.pop();
+            deliver(datagram.bytes.data(), datagram.bytes.size());
+            ++m_stats.delivered;
+            ++count;
+        }
+        return count;
+    }
+
+    size_t InFlightCount() const { return m_inFlight.size(); }
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct InFlight {
+        Clock::time_point due;
+        uint64_t order = 0;   // Ties keep submission order
+        std::vector<std::byte> bytes;
+
+        bool operator>(const InFlight& other) const {
+            return due != other.due ? due > other.due : order > other.order;
+        }
+    };
+
+    double Roll() { return std::uniform_real_distribution<double>(0.0, 1.0)(m_random); }
+
+    void Schedule(const std::byte* data, size_t size, Clock::time_point now) {
+        auto delay = std::chrono::duration_cast<Clock::duration>(m_conditions.latency);
+        if (m_conditions.jitter.count() > 0) {
+            const auto jitter = std::chrono::duration_cast<Clock::duration>(m_conditions.jitter).count();
+            delay += Clock::duration(std::uniform_int_distribution<Clock::rep>(-jitter, jitter)(m_random));
+        }
+        m_inFlight.push(InFlight{now + std::max(delay, Clock::duration::zero()), m_nextOrder++, std::vector<std::byte>(data, data + size)});
+    }
+
+    UdpLinkConditions m_conditions;
+    std::mt19937_64 m_random;
+    std::priority_queue<InFlight, std::vector<InFlight>, std::greater<InFlight>> m_inFlight;
+    uint64_t m_nextOrder = 0;
+    Stats m_stats;
+};
+
+} // namespace mmorpg::network
@@ -1,7 +1,7 @@
 #include "network/udp_packet_handler.h"
 #include "network/session_manager.h"
 #include "network/session.h"
-#include "proto/udp_handshake.pb.h"
+#include "network/movement_input_queue.h"
 #include "core/logger.h"
 
 #include <iostream>
@@ -13,30 +13,119 @@ UdpPacketHandler::UdpPacketHandler(SessionManager& session_manager)
     : m_session_manager(session_manager) {
 }
 
+UdpPacketHandler::UdpPacketHandler(SessionManager& session_manager, MovementInputQueue* movement_queue)
+    : m_session_manager(session_manager), m_movement_queue(movement_queue) {
+}
+
 // [SEQUENCE: MVP6-36] Handles an incoming raw UDP packet.
-// Its primary responsibility is to process the initial handshake packet.
+// [SEQUENCE: MVP19-71] The header is decoded once and the type byte selects the handler.
 void UdpPacketHandler::Handle(std::shared_ptr<Session> session, const boost::asio::ip::udp::endpoint& endpoint, const std::vector<std::byte>& buffer, size_t size) {
-    // First, try to parse the packet as a UdpHandshake message.
-    mmorpg::proto::UdpHandshake handshake;
-    if (handshake.ParseFromArray(buffer.data(), size)) {
-        // It's a valid handshake packet. Find the corresponding TCP session via the player_id.
-        auto player_id = handshake.player_id();
-        auto session_to_register = m_session_manager.GetSessionByPlayerId(player_id);
-        if (session_to_register) {
-            // If the session is found, register the UDP endpoint with it.
-            m_session_manager.RegisterUdpEndpoint(session_to_register->GetSessionId(), endpoint);
-            LOG_INFO("[UdpPacketHandler] UDP handshake processed for player {}", player_id);
-        }
+    UdpDatagramHeader header;
+    if (!DecodeUdpHeader(buffer.data(), size, header)) {
+        m_droppedMalformed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const std::byte* payload = buffer.data() + UdpDatagramHeader::kSize;
+    const size_t payload_size = size - UdpDatagramHeader::kSize;
+
+    if (header.type == UdpMessageType::Handshake) {
+        HandleHandshake(header, endpoint, payload, payload_size);
         return;
     }
 
-    // If it's not a handshake, it must be a gameplay packet from an already-registered endpoint.
+    // Gameplay packets are only accepted from an endpoint that completed the handshake,
+    // and only if they carry that session's token.
     if (!session) {
-        // A non-handshake packet from an unknown source is ignored for security.
+        m_droppedUnbound.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (header.session_token != session->GetUdpToken()) {
+        m_droppedBadToken.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    switch (header.type) {
+        case UdpMessageType::Movement:
+            HandleMovement(*session, header, payload, payload_size);
+            break;
+        case UdpMessageType::Channel:
+        case UdpMessageType::Ack:
+            session->GetUdpConnection().OnDatagram(header, payload, payload_size, std::chrono::steady_clock::now(),
+                [this, &session](UdpChannel channel, const std::byte* data, size_t length) {
+                    if (m_channelHandler) {
+                        m_channelHandler(session, channel, data, length);
+                    }
+                });
+            break;
+        default:
+            m_droppedMalformed.fetch_add(1, std::memory_order_relaxed);
+            break;
+    }
+}
+
+// [SEQUENCE: MVP19-72] Binds the source endpoint to the player's TCP session once the token checks out.
+void UdpPacketHandler::HandleHandshake(const UdpDatagramHeader& header, const boost::asio::ip::udp::endpoint& endpoint, const std::byte* payload, size_t size) {
+    if (size < sizeof(uint64_t)) {
+        m_droppedMalformed.fetch_add(1, std::memory_order_relaxed);
         return;
     }
+    uint64_t player_id = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+        player_id |= static_cast<uint64_t>(std::to_integer<uint8_t>(payload[i])) << (8 * i);
+    }
+
+    auto session_to_register = m_session_manager.GetSessionByPlayerId(player_id);
+    if (!session_to_register) {
+        m_droppedUnbound.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (header.session_token != session_to_register->GetUdpToken()) {
+        m_droppedBadToken.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    m_session_manager.RegisterUdpEndpoint(session_to_register->GetSessionId(), endpoint);
+    m_handshakes.fetch_add(1, std::memory_order_relaxed);
+    LOG_INFO("[UdpPacketHandler] UDP handshake processed for player {}", player_id);
+}
+
+// [SEQUENCE: MVP19-73] Movement is unreliable-sequenced: a sample older than the newest one already seen is
+// stale and dropped, since the newer position supersedes it. "Newest" is among movement samples only; the
+// datagram window, shared with the reliability channels, only rejects replays.
+void UdpPacketHandler::HandleMovement(Session& session, const UdpDatagramHeader& header, const std::byte* payload, size_t size) {
+    MovementInput input;
+    if (!DecodeMovement(payload, size, input.sample)) {
+        m_droppedMalformed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // Going through the connection also applies the acks piggybacked on the movement datagram.
+    if (session.GetUdpConnection().OnPacketReceived(header, std::chrono::steady_clock::now()) == UdpChannelState::ReceiveResult::Duplicate ||
+        !session.GetUdpChannel().OnMovement(header.sequence)) {
+        m_droppedStale.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (!m_movement_queue) {
+        return;
+    }
+
+    input.player_id = session.GetPlayerId();
+    input.session_id = session.GetSessionId();
+    input.sequence = header.sequence;
+    input.received_at = std::chrono::steady_clock::now();
+    if (m_movement_queue->Push(std::move(input))) {
+        m_movementAccepted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
 
-    // TODO: Handle other gameplay packets (e.g., movement) based on a packet type identifier.
+UdpPacketHandler::Stats UdpPacketHandler::GetStats() const {
+    Stats stats;
+    stats.handshakes = m_handshakes.load(std::memory_order_relaxed);
+    stats.movement_accepted = m_movementAccepted.load(std::memory_order_relaxed);
+    stats.dropped_malformed = m_droppedMalformed.load(std::memory_order_relaxed);
+    stats.dropped_unbound = m_droppedUnbound.load(std::memory_order_relaxed);
+    stats.dropped_bad_token = m_droppedBadToken.load(std::memory_order_relaxed);
+    stats.dropped_stale = m_droppedStale.load(std::memory_order_relaxed);
+    return stats;
 }
 
 }
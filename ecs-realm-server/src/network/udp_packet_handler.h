@@ -1,23 +1,63 @@
 #pragma once
 
 #include "network/i_udp_packet_handler.h"
+#include "network/udp_datagram.h"
+#include "network/udp_reliability.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
 
 // Forward declarations
 namespace mmorpg::network {
 class SessionManager;
+class MovementInputQueue;
 }
 
 namespace mmorpg::network {
 
 // [SEQUENCE: MVP6-34] The concrete implementation of the UDP packet handler.
+// [SEQUENCE: MVP19-69] Datagrams use the binary gameplay header (udp_datagram.h). Routing is by the header's
+// type byte, so nothing is parsed as protobuf on this path; movement samples are decoded from fixed-point
+// and pushed onto the simulation's MovementInputQueue. Safe to call from several ingest workers at once.
 class UdpPacketHandler : public IUdpPacketHandler {
 public:
+    // [SEQUENCE: MVP19-70] Drop counters, one per rejection reason.
+    struct Stats {
+        uint64_t handshakes = 0;
+        uint64_t movement_accepted = 0;
+        uint64_t dropped_malformed = 0;    // Bad magic, short payload, unknown type
+        uint64_t dropped_unbound = 0;      // Gameplay datagram from an endpoint without a session
+        uint64_t dropped_bad_token = 0;
+        uint64_t dropped_stale = 0;        // Duplicate or older than the newest movement sample
+    };
+
     explicit UdpPacketHandler(SessionManager& session_manager);
+    UdpPacketHandler(SessionManager& session_manager, MovementInputQueue* movement_queue);
 
     void Handle(std::shared_ptr<Session> session, const boost::asio::ip::udp::endpoint& endpoint, const std::vector<std::byte>& buffer, size_t size) override;
 
+    // [SEQUENCE: MVP19-100] Receives messages from the reliability channels, in order for ReliableOrdered.
+    // Called on the ingest worker thread. Set before the server starts.
+    using ChannelMessageHandler = std::function<void(const std::shared_ptr<Session>& session, UdpChannel channel, const std::byte* data, size_t size)>;
+    void SetChannelMessageHandler(ChannelMessageHandler handler) { m_channelHandler = std::move(handler); }
+
+    Stats GetStats() const;
+
 private:
+    void HandleHandshake(const UdpDatagramHeader& header, const boost::asio::ip::udp::endpoint& endpoint, const std::byte* payload, size_t size);
+    void HandleMovement(Session& session, const UdpDatagramHeader& header, const std::byte* payload, size_t size);
+
     SessionManager& m_session_manager;
+    MovementInputQueue* m_movement_queue = nullptr;
+    ChannelMessageHandler m_channelHandler;
+
+    std::atomic<uint64_t> m_handshakes{0};
+    std::atomic<uint64_t> m_movementAccepted{0};
+    std::atomic<uint64_t> m_droppedMalformed{0};
+    std::atomic<uint64_t> m_droppedUnbound{0};
+    std::atomic<uint64_t> m_droppedBadToken{0};
+    std::atomic<uint64_t> m_droppedStale{0};
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,339 @@
+#include "network/udp_reliability.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace mmorpg::network {
+
+namespace {
+
+uint64_t FragmentKey(uint64_t message_count, uint8_t fragment_index) {
+    return (message_count << 8) | fragment_index;
+}
+
+void WriteChannelHeader(std::byte* out, UdpChannel channel, uint16_t message_id, uint8_t index, uint8_t count) {
+    out[0] = static_cast<std::byte>(channel);
+    out[1] = static_cast<std::byte>(message_id & 0xFF);
+    out[2] = static_cast<std::byte>(message_id >> 8);
+    out[3] = static_cast<std::byte>(index);
+    out[4] = static_cast<std::byte>(count);
+}
+
+double ToMilliseconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+UdpReliableConnection::UdpReliableConnection(UdpChannelState& channel_state, uint64_t session_token, UdpReliabilityConfig config)
+    : m_channelState(channel_state),
+      m_sessionToken(session_token),
+      m_config(config),
+      m_rtoMs(static_cast<double>(config.initial_rto.count())) {
+    m_scratch.reserve(m_config.max_datagram_size);
+    m_bodyScratch.reserve(m_config.max_datagram_size);
+}
+
+// [SEQUENCE: MVP19-87] Splits reliable messages into MTU-sized fragments that are tracked and acked one by one.
+bool UdpReliableConnection::Send(UdpChannel channel, const std::byte* data, size_t size, Clock::time_point now, const DatagramSink& sink) {
+    const size_t max_fragment = m_config.max_datagram_size - UdpDatagramHeader::kSize - kChannelHeaderSize;
+    const size_t fragment_count = std::max<size_t>(1, (size + max_fragment - 1) / max_fragment);
+    std::array<std::byte, kChannelHeaderSize> channel_header;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_failed) return false;
+
+    if (channel != UdpChannel::ReliableOrdered) {
+        if (fragment_count > 1) return false;
+        const uint16_t message_id = channel == UdpChannel::UnreliableSequenced ? m_nextSequencedId++ : 0;
+        WriteChannelHeader(channel_header.data(), channel, message_id, 0, 1);
+        m_bodyScratch.assign(channel_header.begin(), channel_header.end());
+        m_bodyScratch.insert(m_bodyScratch.end(), data, data + size);
+        TransmitLocked(UdpMessageType::Channel, m_bodyScratch.data(), m_bodyScratch.size(), kNoFragment, now, sink);
+        return true;
+    }
+
+    if (fragment_count > kMaxFragments || m_pending.size() + fragment_count > m_config.max_pending_fragments) {
+        return false;
+    }
+    if (!m_pending.empty() && m_nextReliableCount - (m_pending.begin()->first >> 8) >= kReassemblyWindow) {
+        return false;
+    }
+
+    const uint64_t message_count = m_nextReliableCount++;
+    const auto message_id = static_cast<uint16_t>(message_count);
+    for (size_t index = 0; index < fragment_count; ++index) {
+        const size_t offset = index * max_fragment;
+        const size_t length = std::min(max_fragment, size - std::min(size, offset));
+
+        PendingFragment fragment;
+        fragment.bytes.resize(kChannelHeaderSize + length);
+        WriteChannelHeader(fragment.bytes.data(), channel, message_id, static_cast<uint8_t>(index), static_cast<uint8_t>(fragment_count));
+        if (length > 0) {
+            std::memcpy(fragment.bytes.data() + kChannelHeaderSize, data + offset, length);
+        }
+        fragment.last_send = now;
+        fragment.transmissions = 1;
+
+        const uint64_t key = FragmentKey(message_count, static_cast<uint8_t>(index));
+        auto& stored = m_pending[key] = std::move(fragment);
+        TransmitLocked(UdpMessageType::Channel, stored.bytes.data(), stored.bytes.size(), key, now, sink);
+    }
+    return true;
+}
+
+UdpDatagramHeader UdpReliableConnection::PrepareHeader(UdpMessageType type, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return PrepareHeaderLocked(type, now, kNoFragment);
+}
+
+// Every outbound datagram takes the next sequence and the freshest acks, so it also clears any owed ack.
+UdpDatagramHeader UdpReliableConnection::PrepareHeaderLocked(UdpMessageType type, Clock::time_point now, uint64_t fragment_key) {
+    UdpDatagramHeader header;
+    header.type = type;
+    header.session_token = m_sessionToken;
+    header.sequence = m_channelState.NextLocalSequence();
+    if (m_channelState.GetAck(header.ack, header.ack_bits)) {
+        header.flags |= UdpDatagramHeader::kFlagHasAck;
+    }
+
+    auto& sent = m_sentPackets[header.sequence % kSentPacketWindow];
+    sent.sequence = header.sequence;
+    sent.valid = type != UdpMessageType::Ack;
+    sent.acked = false;
+    sent.fragment_key = fragment_key;
+    sent.send_time = now;
+
+    m_ackPending = false;
+    m_lastSend = now;
+    ++m_stats.packets_sent;
+    return header;
+}
+
+void UdpReliableConnection::TransmitLocked(UdpMessageType type, const std::byte* body, size_t body_size, uint64_t fragment_key,
+                                           Clock::time_point now, const DatagramSink& sink) {
+    const UdpDatagramHeader header = PrepareHeaderLocked(type, now, fragment_key);
+    m_scratch.resize(UdpDatagramHeader::kSize + body_size);
+    EncodeUdpHeader(header, m_scratch.data());
+    if (body_size > 0) {
+        std::memcpy(m_scratch.data() + UdpDatagramHeader::kSize, body, body_size);
+    }
+    sink(m_scratch.data(), m_scratch.size());
+}
+
+UdpChannelState::ReceiveResult UdpReliableConnection::OnPacketReceived(const UdpDatagramHeader& header, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ProcessAcksLocked(header, now);
+    // Bare acks are not recorded, otherwise two idle peers would ack each other's acks forever.
+    if (header.type == UdpMessageType::Ack) {
+        return UdpChannelState::ReceiveResult::Newest;
+    }
+    const auto result = m_channelState.OnReceive(header.sequence);
+    if (result == UdpChannelState::ReceiveResult::Duplicate) {
+        ++m_stats.duplicates_dropped;
+    } else if (header.type == UdpMessageType::Channel) {
+        m_ackPending = true;
+    }
+    return result;
+}
+
+// [SEQUENCE: MVP19-88] Walks the ack and its 32-bit history. Only the newest ack is used as an RTT sample;
+// older bits may have been held back by the peer's ack delay.
+void UdpReliableConnection::ProcessAcksLocked(const UdpDatagramHeader& header, Clock::time_point now) {
+    if (!(header.flags & UdpDatagramHeader::kFlagHasAck)) return;
+
+    AckPacketLocked(header.ack, now, true);
+    for (uint16_t bit = 0; bit < 32; ++bit) {
+        if (header.ack_bits & (uint32_t{1} << bit)) {
+            AckPacketLocked(static_cast<uint16_t>(header.ack - 1 - bit), now, false);
+        }
+    }
+}
+
+void UdpReliableConnection::AckPacketLocked(uint16_t sequence, Clock::time_point now, bool sample_rtt) {
+    auto& sent = m_sentPackets[sequence % kSentPacketWindow];
+    if (!sent.valid || sent.acked || sent.sequence != sequence) return;
+
+    sent.acked = true;
+    ++m_stats.packets_acked;
+    if (sample_rtt) {
+        UpdateRttLocked(ToMilliseconds(now - sent.send_time));
+    }
+    if (sent.fragment_key != kNoFragment) {
+        m_pending.erase(sent.fragment_key);
+    }
+}
+
+// [SEQUENCE: MVP19-89] RFC 6298 smoothing: srtt/rttvar with gains 1/8 and 1/4, RTO = srtt + 4 * rttvar.
+void UdpReliableConnection::UpdateRttLocked(double sample_ms) {
+    if (!m_hasRtt) {
+        m_srttMs = sample_ms;
+        m_rttVarMs = sample_ms / 2.0;
+        m_hasRtt = true;
+    } else {
+        m_rttVarMs = 0.75 * m_rttVarMs + 0.25 * std::fabs(m_srttMs - sample_ms);
+        m_srttMs = 0.875 * m_srttMs + 0.125 * sample_ms;
+    }
+    m_rtoMs = std::clamp(m_srttMs + 4.0 * m_rttVarMs,
+                         static_cast<double>(m_config.min_rto.count()),
+                         static_cast<double>(m_config.max_rto.count()));
+}
+
+// Exponential backoff per fragment, capped at max_rto.
+UdpReliableConnection::Clock::duration UdpReliableConnection::RetransmitTimeoutLocked(uint32_t transmissions) const {
+    const double backoff = std::ldexp(m_rtoMs, static_cast<int>(std::min<uint32_t>(transmissions - 1, 6)));
+    const double timeout_ms = std::min(backoff, static_cast<double>(m_config.max_rto.count()));
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(timeout_ms));
+}
+
+bool UdpReliableConnection::Update(Clock::time_point now, const DatagramSink& sink) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_failed) return false;
+
+    size_t retransmit_budget = kMaxRetransmitsPerUpdate;
+    for (auto& [key, fragment] : m_pending) {
+        if (retransmit_budget == 0) break;
+        if (now - fragment.last_send < RetransmitTimeoutLocked(fragment.transmissions)) continue;
+        if (fragment.transmissions >= m_config.max_transmissions) {
+            m_failed = true;
+            m_pending.clear();
+            return false;
+        }
+        --retransmit_budget;
+        ++fragment.transmissions;
+        fragment.last_send = now;
+        ++m_stats.retransmits;
+        TransmitLocked(UdpMessageType::Channel, fragment.bytes.data(), fragment.bytes.size(), key, now, sink);
+    }
+
+    if (m_ackPending && now - m_lastSend >= m_config.ack_delay) {
+        TransmitLocked(UdpMessageType::Ack, nullptr, 0, kNoFragment, now, sink);
+    }
+    return true;
+}
+
+// [SEQUENCE: MVP19-90] Inbound channel payloads. Completed messages are copied out and handed to the sink
+// after the lock is released, so the sink may send on this connection.
+void UdpReliableConnection::OnDatagram(const UdpDatagramHeader& header, const std::byte* payload, size_t size, Clock::time_point now, const MessageSink& deliver) {
+    const auto result = OnPacketReceived(header, now);
+    if (header.type != UdpMessageType::Channel || result == UdpChannelState::ReceiveResult::Duplicate) return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (size < kChannelHeaderSize) {
+        ++m_stats.malformed_dropped;
+        return;
+    }
+    const auto channel = static_cast<UdpChannel>(std::to_integer<uint8_t>(payload[0]));
+    const uint16_t message_id = static_cast<uint16_t>(std::to_integer<uint8_t>(payload[1]) | (std::to_integer<uint8_t>(payload[2]) << 8));
+    const uint8_t index = std::to_integer<uint8_t>(payload[3]);
+    const uint8_t count = std::to_integer<uint8_t>(payload[4]);
+    const std::byte* data = payload + kChannelHeaderSize;
+    const size_t data_size = size - kChannelHeaderSize;
+
+    if (count == 0 || index >= count) {
+        ++m_stats.malformed_dropped;
+        return;
+    }
+
+    switch (channel) {
+        case UdpChannel::Unreliable:
+        case UdpChannel::UnreliableSequenced:
+            if (count != 1) {
+                ++m_stats.malformed_dropped;
+                return;
+            }
+            if (channel == UdpChannel::UnreliableSequenced) {
+                if (m_hasRecvSequenced && !SequenceGreaterThan(message_id, m_recvNewestSequenced)) {
+                    ++m_stats.stale_dropped;
+                    return;
+                }
+                m_hasRecvSequenced = true;
+                m_recvNewestSequenced = message_id;
+            }
+            ++m_stats.messages_delivered;
+            lock.unlock();
+            deliver(channel, data, data_size);
+            return;
+
+        case UdpChannel::ReliableOrdered: {
+            std::vector<std::vector<std::byte>> ready;
+            ReceiveReliableLocked(message_id, index, count, data, data_size, ready);
+            lock.unlock();
+            for (const auto& message : ready) {
+                deliver(UdpChannel::ReliableOrdered, message.data(), message.size());
+            }
+            return;
+        }
+    }
+    ++m_stats.malformed_dropped;
+}
+
+// [SEQUENCE: MVP19-91] Reassembles fragments into a window of kReassemblyWindow messages past the next expected
+// id, then releases every complete message at the head of the window in order.
+void UdpReliableConnection::ReceiveReliableLocked(uint16_t message_id, uint8_t index, uint8_t count, const std::byte* data, size_t size,
+                                                  std::vector<std::vector<std::byte>>& ready) {
+    const uint16_t distance = static_cast<uint16_t>(message_id - m_recvNextReliable);
+    if (distance >= kReassemblyWindow) {
+        // Already delivered (behind the window), or from a peer that ignores the in-flight cap Send() keeps
+        ++m_stats.duplicates_dropped;
+        return;
+    }
+
+    auto& slot = m_reassembly[message_id % kReassemblyWindow];
+    if (!slot.used) {
+        slot.used = true;
+        slot.message_id = message_id;
+        slot.fragment_count = count;
+        slot.received_count = 0;
+        slot.fragments.assign(count, {});
+        slot.received.assign(count, false);
+    } else if (slot.message_id != message_id || slot.fragment_count != count) {
+        ++m_stats.malformed_dropped;
+        return;
+    }
+    if (slot.received[index]) {
+        ++m_stats.duplicates_dropped;
+        return;
+    }
+    slot.received[index] = true;
+    slot.fragments[index].assign(data, data + size);
+    ++slot.received_count;
+    ++m_stats.fragments_received;
+
+    while (true) {
+        auto& head = m_reassembly[m_recvNextReliable % kReassemblyWindow];
+        if (!head.used || head.message_id != m_recvNextReliable || head.received_count != head.fragment_count) break;
+
+        if (head.fragment_count == 1) {
+            ready.push_back(std::move(head.fragments[0]));
+        } else {
+            std::vector<std::byte> message;
+            for (auto& fragment : head.fragments) {
+                message.insert(message.end(), fragment.begin(), fragment.end());
+            }
+            ready.push_back(std::move(message));
+        }
+        head.used = false;
+        head.fragments.clear();
+        ++m_stats.messages_delivered;
+        ++m_recvNextReliable;
+    }
+}
+
+UdpReliabilityStats UdpReliableConnection::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    UdpReliabilityStats stats = m_stats;
+    stats.pending_fragments = m_pending.size();
+    stats.srtt_ms = m_srttMs;
+    stats.rto_ms = m_rtoMs;
+    stats.failed = m_failed;
+    return stats;
+}
+
+bool UdpReliableConnection::HasFailed() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failed;
+}
+
+} // namespace mmorpg::network
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "network/udp_datagram.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace mmorpg::network {
+
+// [SEQUENCE: MVP19-83] Delivery guarantees offered per message.
+//   Unreliable           - fire and forget, may arrive out of order or not at all.
+//   UnreliableSequenced  - may be lost, but anything older than the newest delivered message is dropped.
+//   ReliableOrdered      - retransmitted until acked, delivered exactly once in send order, fragmented above the MTU.
+enum class UdpChannel : uint8_t {
+    Unreliable = 0,
+    UnreliableSequenced = 1,
+    ReliableOrdered = 2,
+};
+
+// [SEQUENCE: MVP19-84] Tuning for one connection. RTO bounds follow RFC 6298 with a lower floor suited to games.
+struct UdpReliabilityConfig {
+    size_t max_datagram_size = 1200;                  // Conservative path MTU budget, header included
+    std::chrono::milliseconds initial_rto{200};
+    std::chrono::milliseconds min_rto{40};
+    std::chrono::milliseconds max_rto{2000};
+    std::chrono::milliseconds ack_delay{20};          // Send a bare ack if nothing else went out within this window
+    size_t max_pending_fragments = 2048;              // Unacked reliable fragments before Send() refuses more
+    uint32_t max_transmissions = 16;                  // A fragment sent this often without an ack fails the connection
+};
+
+struct UdpReliabilityStats {
+    uint64_t packets_sent = 0;
+    uint64_t packets_acked = 0;
+    uint64_t retransmits = 0;
+    uint64_t messages_delivered = 0;
+    uint64_t fragments_received = 0;
+    uint64_t duplicates_dropped = 0;
+    uint64_t stale_dropped = 0;
+    uint64_t malformed_dropped = 0;
+    size_t pending_fragments = 0;
+    double srtt_ms = 0.0;
+    double rto_ms = 0.0;
+    bool failed = false;
+};
+
+// [SEQUENCE: MVP19-85] Reliability state for one UDP peer, layered on the gameplay header's sequence/ack fields.
+// Every outbound datagram gets a fresh packet sequence; a reliable fragment remembers the packets that carried
+// it and is dropped from the resend set as soon as any of them is acked. Packets are never resent as-is, so each
+// ack yields an unambiguous RTT sample (no Karn ambiguity), which drives the retransmit timeout. A datagram that
+// arrives more than 32 packets behind the newest one cannot be told from a duplicate and is dropped; for reliable
+// fragments that only costs a resend.
+//
+// Thread-safe: the ingest worker, the retransmit tick and game code may call in concurrently. Sinks are invoked
+// with the connection's lock held and must not call back into it; message sinks are invoked without the lock.
+class UdpReliableConnection {
+public:
+    using Clock = std::chrono::steady_clock;
+    using DatagramSink = std::function<void(const std::byte* data, size_t size)>;
+    using MessageSink = std::function<void(UdpChannel channel, const std::byte* data, size_t size)>;
+
+    // Channel payload header: channel(1) message_id(2) fragment_index(1) fragment_count(1).
+    static constexpr size_t kChannelHeaderSize = 5;
+    static constexpr size_t kMaxFragments = 255;
+
+    UdpReliableConnection(UdpChannelState& channel_state, uint64_t session_token, UdpReliabilityConfig config = {});
+
+    UdpReliableConnection(const UdpReliableConnection&) = delete;
+    UdpReliableConnection& operator=(const UdpReliableConnection&) = delete;
+
+    // Encodes and emits the message. Returns false if it cannot be sent: unreliable messages above one datagram,
+    // reliable messages above kMaxFragments fragments, a full resend window, or a failed connection.
+    // [SEQUENCE: MVP19-440] A reliable message is also refused while its id would be kReassemblyWindow or more
+    // past the oldest unacked one: the receiver drops fragments that far ahead after acking their packet, so
+    // they would never be resent. Callers retry once acks have moved the window.
+    bool Send(UdpChannel channel, const std::byte* data, size_t size, Clock::time_point now, const DatagramSink& sink);
+
+    // Records the packet for acking and applies the peer's piggybacked acks.
+    UdpChannelState::ReceiveResult OnPacketReceived(const UdpDatagramHeader& header, Clock::time_point now);
+
+    // Full inbound path for UdpMessageType::Channel and ::Ack datagrams whose token has been checked.
+    void OnDatagram(const UdpDatagramHeader& header, const std::byte* payload, size_t size, Clock::time_point now, const MessageSink& deliver);
+
+    // Retransmits overdue fragments and sends a bare ack when one is owed. Call every few milliseconds.
+    // Returns false once the connection has failed; a failed connection sends nothing more.
+    bool Update(Clock::time_point now, const DatagramSink& sink);
+
+    // Header for a datagram built outside the connection (e.g. movement). Assigns the next sequence and acks.
+    UdpDatagramHeader PrepareHeader(UdpMessageType type, Clock::time_point now);
+
+    UdpReliabilityStats GetStats() const;
+    bool HasFailed() const;
+
+private:
+    static constexpr size_t kSentPacketWindow = 1024;
+    static constexpr size_t kReassemblyWindow = 256;
+    // A datagram more than 32 packets behind the newest is never acked, so a retransmit burst longer than the
+    // ack history lets the oldest fragments, which go first, be overtaken and resent again and again
+    static constexpr size_t kMaxRetransmitsPerUpdate = 32;
+    static constexpr uint64_t kNoFragment = UINT64_MAX;
+
+    struct SentPacket {
+        uint16_t sequence = 0;
+        bool valid = false;
+        bool acked = false;
+        uint64_t fragment_key = kNoFragment;
+        Clock::time_point send_time;
+    };
+
+    struct PendingFragment {
+        std::vector<std::byte> bytes;   // Channel header + fragment data, ready to resend
+        Clock::time_point last_send;
+        uint32_t transmissions = 0;
+    };
+
+    struct ReassemblySlot {
+        bool used = false;
+        uint16_t message_id = 0;
+        uint8_t fragment_count = 0;
+        uint8_t received_count = 0;
+        std::vector<std::vector<std::byte>> fragments;
+        std::vector<bool> received;
+    };
+
+    UdpDatagramHeader PrepareHeaderLocked(UdpMessageType type, Clock::time_point now, uint64_t fragment_key);
+    void TransmitLocked(UdpMessageType type, const std::byte* body, size_t body_size, uint64_t fragment_key,
+                        Clock::time_point now, const DatagramSink& sink);
+    void ProcessAcksLocked(const UdpDatagramHeader& header, Clock::time_point now);
+    void AckPacketLocked(uint16_t sequence, Clock::time_point now, bool sample_rtt);
+    void UpdateRttLocked(double sample_ms);
+    Clock::duration RetransmitTimeoutLocked(uint32_t transmissions) const;
+    void ReceiveReliableLocked(uint16_t message_id, uint8_t index, uint8_t count, const std::byte* data, size_t size,
+                               std::vector<std::vector<std::byte>>& ready);
+
+    UdpChannelState& m_channelState;
+    const uint64_t m_sessionToken;
+    const UdpReliabilityConfig m_config;
+
+    mutable std::mutex m_mutex;
+    std::array<SentPacket, kSentPacketWindow> m_sentPackets{};
+    // key = reliable message count << 8 | fragment_index; the count does not wrap, so begin() is the oldest
+    std::map<uint64_t, PendingFragment> m_pending;
+    std::array<ReassemblySlot, kReassemblyWindow> m_reassembly{};
+    std::vector<std::byte> m_scratch;       // Encoded datagram handed to the sink
+    std::vector<std::byte> m_bodyScratch;   // Channel header + payload for unreliable sends
+
+    uint64_t m_nextReliableCount = 0;   // The wire message id is its low 16 bits
+    uint16_t m_nextSequencedId = 0;
+    uint16_t m_recvNextReliable = 0;
+    uint16_t m_recvNewestSequenced = 0;
+    bool m_hasRecvSequenced = false;
+
+    bool m_hasRtt = false;
+    double m_srttMs = 0.0;
+    double m_rttVarMs = 0.0;
+    double m_rtoMs = 0.0;
+
+    bool m_ackPending = false;
+    Clock::time_point m_lastSend{};
+    bool m_failed = false;
+    UdpReliabilityStats m_stats;
+};
+
+} // namespace mmorpg::network
@@ -1,19 +1,78 @@
 #include "network/udp_server.h"
 #include "network/session_manager.h"
 #include "network/i_udp_packet_handler.h"
+#include "network/buffer_pool.h"
+#include "network/session.h"
+#include "core/concurrent/lock_free_queue.h"
 #include "core/logger.h"
 
-#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 namespace mmorpg::network {
 
+namespace {
+
+struct OutboundDatagram {
+    udp::endpoint endpoint;
+    std::vector<std::byte> payload;
+};
+
+} // namespace
+
+struct UdpServer::Worker {
+    size_t index = 0;
+    int socket_fd = -1;
+    int wake_fd = -1;
+    std::thread thread;
+
+    // [SEQUENCE: MVP19-50] Receive slab and the mmsghdr/iovec arrays that point into it. Allocated once at Start().
+    std::vector<std::vector<std::byte>> slab;
+    std::vector<sockaddr_storage> recv_addrs;
+    std::vector<iovec> recv_iovecs;
+    std::vector<mmsghdr> recv_msgs;
+    udp::endpoint remote_endpoint;
+
+    // Outbound datagrams are produced by any thread and consumed only by this worker.
+    concurrent::LockFreeQueue<OutboundDatagram> outbound;
+    std::atomic<bool> wake_pending{false};
+    std::vector<OutboundDatagram> send_batch;
+    std::vector<iovec> send_iovecs;
+    std::vector<mmsghdr> send_msgs;
+
+    // One snapshot per SessionManager UDP shard
+    std::vector<std::shared_ptr<const UdpEndpointSnapshot>> snapshots;
+    uint64_t snapshot_version = 0;
+    std::chrono::steady_clock::time_point last_tick{};
+
+    std::atomic<uint64_t> datagrams_received{0};
+    std::atomic<uint64_t> datagrams_sent{0};
+    std::atomic<uint64_t> recv_batches{0};
+    std::atomic<uint64_t> send_batches{0};
+    std::atomic<uint64_t> dropped_oversize{0};
+    std::atomic<uint64_t> connections_failed{0};
+};
+
 // [SEQUENCE: MVP6-31] Constructor: Initializes the UDP server components.
 UdpServer::UdpServer(uint16_t port, SessionManager& session_manager)
-    : m_io_context(std::make_unique<boost::asio::io_context>()),
-      m_socket(*m_io_context),
-      m_port(port),
+    : UdpServer(Config{port}, session_manager) {
+}
+
+UdpServer::UdpServer(const Config& config, SessionManager& session_manager)
+    : m_config(config),
       m_session_manager(session_manager) {
-    m_recv_buffer.resize(65507); // Max UDP packet size
+    m_config.worker_count = std::max<size_t>(1, m_config.worker_count);
+    m_config.batch_size = std::max<size_t>(1, m_config.batch_size);
 }
 
 UdpServer::~UdpServer() {
@@ -21,63 +80,354 @@ UdpServer::~UdpServer() {
 }
 
 // [SEQUENCE: MVP6-32] Starts the UDP server, opens the socket, and runs the io_context in a new thread.
+// [SEQUENCE: MVP19-51] Opens one SO_REUSEPORT socket per worker, then starts the worker threads. If the
+// configured port is 0 the first socket picks an ephemeral port and the others bind to the same one.
 bool UdpServer::Start() {
-    try {
-        udp::endpoint endpoint(udp::v4(), m_port);
-        m_socket.open(endpoint.protocol());
-        m_socket.bind(endpoint);
-    } catch (const boost::system::system_error& e) {
-        LOG_ERROR("[UdpServer] Error starting server: {}", e.what());
-        return false;
+    if (m_running.exchange(true)) return true;
+
+    for (size_t i = 0; i < m_config.worker_count; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->index = i;
+        if (!OpenWorkerSocket(*worker)) {
+            CloseWorker(*worker);
+            m_running = false;
+            for (auto& opened : m_workers) {
+                CloseWorker(*opened);
+            }
+            m_workers.clear();
+            return false;
+        }
+        m_workers.push_back(std::move(worker));
     }
-    
-    LOG_INFO("[UdpServer] Started on port {}", m_port);
-    DoReceive();
 
-    m_thread = std::thread([this]() {
-        m_io_context->run();
-    });
+    for (auto& worker : m_workers) {
+        Worker* raw = worker.get();
+        raw->thread = std::thread([this, raw]() { RunWorker(*raw); });
+
+        if (m_config.pin_threads) {
+            const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            CPU_SET(raw->index % cores, &cpuset);
+            if (pthread_setaffinity_np(raw->thread.native_handle(), sizeof(cpuset), &cpuset) != 0) {
+                LOG_ERROR("[UdpServer] Failed to pin worker {} to core {}", raw->index, raw->index % cores);
+            }
+        }
+    }
 
+    LOG_INFO("[UdpServer] Started on port {} with {} worker(s), batch size {}",
+             m_config.port, m_workers.size(), m_config.batch_size);
     return true;
 }
 
 void UdpServer::Stop() {
-    if (m_io_context && !m_io_context->stopped()) {
-        m_io_context->stop();
+    if (!m_running.exchange(false)) return;
+
+    for (auto& worker : m_workers) {
+        uint64_t one = 1;
+        [[maybe_unused]] auto written = ::write(worker->wake_fd, &one, sizeof(one));
+    }
+    for (auto& worker : m_workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+        CloseWorker(*worker);
+    }
+    m_workers.clear();
+}
+
+bool UdpServer::OpenWorkerSocket(Worker& worker) {
+    worker.socket_fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (worker.socket_fd < 0) {
+        LOG_ERROR("[UdpServer] socket() failed: {}", std::strerror(errno));
+        return false;
+    }
+
+    int enable = 1;
+    if (::setsockopt(worker.socket_fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) != 0) {
+        LOG_ERROR("[UdpServer] SO_REUSEPORT failed: {}", std::strerror(errno));
+        return false;
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(m_config.port);
+    if (::bind(worker.socket_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        LOG_ERROR("[UdpServer] Error starting server: bind to port {} failed: {}", m_config.port, std::strerror(errno));
+        return false;
     }
-    if (m_thread.joinable()) {
-        m_thread.join();
+    if (m_config.port == 0) {
+        socklen_t len = sizeof(addr);
+        ::getsockname(worker.socket_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        m_config.port = ntohs(addr.sin_port);
     }
-    boost::system::error_code ec;
-    if (m_socket.is_open()) {
-        m_socket.close(ec);
+
+    worker.wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (worker.wake_fd < 0) {
+        LOG_ERROR("[UdpServer] eventfd() failed: {}", std::strerror(errno));
+        return false;
+    }
+
+    const size_t batch = m_config.batch_size;
+    worker.slab.assign(batch, std::vector<std::byte>(m_config.max_datagram_size));
+    worker.recv_addrs.resize(batch);
+    worker.recv_iovecs.resize(batch);
+    worker.recv_msgs.resize(batch);
+    worker.send_batch.reserve(batch);
+    worker.send_iovecs.resize(batch);
+    worker.send_msgs.resize(batch);
+    return true;
+}
+
+void UdpServer::CloseWorker(Worker& worker) {
+    if (worker.socket_fd >= 0) {
+        ::close(worker.socket_fd);
+        worker.socket_fd = -1;
+    }
+    if (worker.wake_fd >= 0) {
+        ::close(worker.wake_fd);
+        worker.wake_fd = -1;
     }
 }
 
 // [SEQUENCE: MVP6-33] The core asynchronous receive loop and its handler.
 // It waits for a packet, and upon receipt, delegates processing to the registered IUdpPacketHandler.
-void UdpServer::DoReceive() {
-    m_socket.async_receive_from(
-        boost::asio::buffer(m_recv_buffer),
-        m_remote_endpoint,
-        [this](const boost::system::error_code& ec, std::size_t bytes_recvd) {
-            HandleReceive(ec, bytes_recvd);
-        });
+// [SEQUENCE: MVP19-52] Each worker polls its socket and its wake eventfd. Readable sockets are drained with
+// recvmmsg until EAGAIN; a wake-up means SendTo() queued datagrams for this worker.
+void UdpServer::RunWorker(Worker& worker) {
+    pollfd fds[2];
+    fds[0] = {worker.socket_fd, POLLIN, 0};
+    fds[1] = {worker.wake_fd, POLLIN, 0};
+
+    const int timeout_ms = std::max(1, std::min(m_config.poll_timeout_ms, m_config.reliability_tick_ms));
+    while (m_running.load(std::memory_order_acquire)) {
+        const int ready = ::poll(fds, 2, timeout_ms);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR("[UdpServer] poll() failed on worker {}: {}", worker.index, std::strerror(errno));
+            break;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            uint64_t counter = 0;
+            [[maybe_unused]] auto consumed = ::read(worker.wake_fd, &counter, sizeof(counter));
+        }
+        if (fds[0].revents & POLLIN) {
+            ReceiveBatch(worker);
+        }
+        TickConnections(worker);
+        FlushOutbound(worker);
+    }
 }
 
-void UdpServer::HandleReceive(const boost::system::error_code& ec, std::size_t bytes_recvd) {
-    if (!ec && bytes_recvd > 0) {
+void UdpServer::ReceiveBatch(Worker& worker) {
+    const size_t batch = m_config.batch_size;
+
+    while (true) {
+        for (size_t i = 0; i < batch; ++i) {
+            worker.recv_iovecs[i].iov_base = worker.slab[i].data();
+            worker.recv_iovecs[i].iov_len = worker.slab[i].size();
+            auto& hdr = worker.recv_msgs[i].msg_hdr;
+            hdr = msghdr{};
+            hdr.msg_name = &worker.recv_addrs[i];
+            hdr.msg_namelen = sizeof(sockaddr_storage);
+            hdr.msg_iov = &worker.recv_iovecs[i];
+            hdr.msg_iovlen = 1;
+        }
+
+        const int received = ::recvmmsg(worker.socket_fd, worker.recv_msgs.data(), static_cast<unsigned>(batch), MSG_DONTWAIT, nullptr);
+        if (received <= 0) {
+            if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                LOG_ERROR("[UdpServer] recvmmsg() failed on worker {}: {}", worker.index, std::strerror(errno));
+            }
+            return;
+        }
+
+        worker.recv_batches.fetch_add(1, std::memory_order_relaxed);
+        worker.datagrams_received.fetch_add(static_cast<uint64_t>(received), std::memory_order_relaxed);
+
+        // [SEQUENCE: MVP19-53] Refresh the per-thread endpoint snapshot once per batch, only if it changed.
+        RefreshSnapshots(worker);
+
         if (m_packetHandler) {
-            // Look up the session associated with the incoming endpoint.
-            auto session = m_session_manager.GetSessionByUdpEndpoint(m_remote_endpoint);
-            // The handler is responsible for dealing with both known (session != nullptr) and unknown endpoints (e.g., for handshakes).
-            m_packetHandler->Handle(session, m_remote_endpoint, m_recv_buffer, bytes_recvd);
+            for (int i = 0; i < received; ++i) {
+                const auto& msg = worker.recv_msgs[i];
+                if (msg.msg_hdr.msg_flags & MSG_TRUNC) {
+                    worker.dropped_oversize.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                std::memcpy(worker.remote_endpoint.data(), &worker.recv_addrs[i], msg.msg_hdr.msg_namelen);
+                worker.remote_endpoint.resize(msg.msg_hdr.msg_namelen);
+
+                // The handler is responsible for dealing with both known (session != nullptr) and unknown endpoints (e.g., for handshakes).
+                std::shared_ptr<Session> session;
+                const auto& sessions = worker.snapshots[m_session_manager.UdpShardFor(worker.remote_endpoint)]->sessions;
+                auto it = sessions.find(worker.remote_endpoint);
+                if (it != sessions.end()) {
+                    session = it->second.lock();
+                }
+                m_packetHandler->Handle(session, worker.remote_endpoint, worker.slab[i], msg.msg_len);
+            }
+        }
+
+        if (static_cast<size_t>(received) < batch) {
+            return;
         }
     }
+}
+
+// [SEQUENCE: MVP19-407] Reloads only the shards that published since the last refresh. The global version is
+// read first, so a publish racing the refresh moves it again and is picked up next time.
+void UdpServer::RefreshSnapshots(Worker& worker) {
+    const uint64_t version = m_session_manager.GetUdpEndpointVersion();
+    if (!worker.snapshots.empty() && version == worker.snapshot_version) return;
+    worker.snapshots.resize(m_session_manager.GetUdpShardCount());
+    for (size_t shard = 0; shard < worker.snapshots.size(); ++shard) {
+        auto& snapshot = worker.snapshots[shard];
+        if (!snapshot || snapshot->version != m_session_manager.GetUdpShardVersion(shard)) {
+            snapshot = m_session_manager.GetUdpEndpointSnapshot(shard);
+        }
+    }
+    worker.snapshot_version = version;
+}
+
+// [SEQUENCE: MVP19-54] Queues the datagram on the worker owning the endpoint's shard, so one flow always leaves
+// through the same socket, and wakes that worker only if it is not already due to flush.
+void UdpServer::SendTo(const udp::endpoint& endpoint, const std::byte* data, size_t size) {
+    if (m_workers.empty() || size == 0) return;
+
+    Worker& worker = *m_workers[WorkerIndexFor(endpoint)];
+    EnqueueOutbound(worker, endpoint, data, size);
+
+    if (!worker.wake_pending.exchange(true, std::memory_order_acq_rel)) {
+        uint64_t one = 1;
+        [[maybe_unused]] auto written = ::write(worker.wake_fd, &one, sizeof(one));
+    }
+}
+
+size_t UdpServer::WorkerIndexFor(const udp::endpoint& endpoint) const {
+    return m_session_manager.UdpShardFor(endpoint) % m_workers.size();
+}
+
+void UdpServer::EnqueueOutbound(Worker& worker, const udp::endpoint& endpoint, const std::byte* data, size_t size) {
+    auto payload = BufferPool::Instance().Acquire();
+    payload.assign(data, data + size);
+    worker.outbound.Enqueue(OutboundDatagram{endpoint, std::move(payload)});
+}
+
+bool UdpServer::SendOnChannel(const std::shared_ptr<Session>& session, UdpChannel channel, const std::byte* data, size_t size) {
+    if (!session || m_workers.empty()) return false;
+    const auto endpoint = session->GetUdpEndpoint();
+    if (!endpoint) return false;
+
+    return session->GetUdpConnection().Send(channel, data, size, std::chrono::steady_clock::now(),
+        [this, &endpoint](const std::byte* datagram, size_t length) { SendTo(*endpoint, datagram, length); });
+}
+
+// [SEQUENCE: MVP19-102] Runs the retransmit and delayed-ack timers for the sessions whose flows this worker
+// sends on, at most once per reliability tick. Datagrams go straight onto the worker's own queue and leave with
+// the FlushOutbound that follows.
+// [SEQUENCE: MVP19-412] The worker walks only the endpoint shards it owns, so each session is visited by one
+// worker per tick instead of every worker hashing every endpoint. A connection that exhausted its retransmits
+// can no longer deliver what it promised; its session is disconnected, which unregisters the endpoint.
+void UdpServer::TickConnections(Worker& worker) {
+    const auto now = std::chrono::steady_clock::now();
+    if (now - worker.last_tick < std::chrono::milliseconds(m_config.reliability_tick_ms)) return;
+    worker.last_tick = now;
+
+    RefreshSnapshots(worker);
+    for (size_t shard = worker.index; shard < worker.snapshots.size(); shard += m_workers.size()) {
+        for (const auto& [endpoint, weak_session] : worker.snapshots[shard]->sessions) {
+            auto session = weak_session.lock();
+            if (!session || session->GetState() == SessionState::Disconnected) continue;
+            const bool alive = session->GetUdpConnection().Update(now, [this, &worker, &endpoint](const std::byte* datagram, size_t length) {
+                EnqueueOutbound(worker, endpoint, datagram, length);
+            });
+            if (!alive) {
+                worker.connections_failed.fetch_add(1, std::memory_order_relaxed);
+                LOG_ERROR("[UdpServer] Session {} stopped acking its reliable UDP channel; disconnecting", session->GetSessionId());
+                session->Disconnect();
+            }
+        }
+    }
+    if (m_packetHandler) {
+        m_packetHandler->OnWorkerTick(worker.index, m_workers.size(), now);
+    }
+}
+
+void UdpServer::FlushOutbound(Worker& worker) {
+    worker.wake_pending.store(false, std::memory_order_release);
+
+    OutboundDatagram datagram;
+    while (true) {
+        worker.send_batch.clear();
+        while (worker.send_batch.size() < m_config.batch_size && worker.outbound.Dequeue(datagram)) {
+            worker.send_batch.push_back(std::move(datagram));
+        }
+        if (worker.send_batch.empty()) return;
+
+        const size_t count = worker.send_batch.size();
+        for (size_t i = 0; i < count; ++i) {
+            auto& out = worker.send_batch[i];
+            worker.send_iovecs[i].iov_base = out.payload.data();
+            worker.send_iovecs[i].iov_len = out.payload.size();
+            auto& hdr = worker.send_msgs[i].msg_hdr;
+            hdr = msghdr{};
+            hdr.msg_name = out.endpoint.data();
+            hdr.msg_namelen = static_cast<socklen_t>(out.endpoint.size());
+            hdr.msg_iov = &worker.send_iovecs[i];
+            hdr.msg_iovlen = 1;
+        }
+
+        size_t offset = 0;
+        while (offset < count) {
+            const int sent = ::sendmmsg(worker.socket_fd, worker.send_msgs.data() + offset, static_cast<unsigned>(count - offset), 0);
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                // EAGAIN on a full socket buffer: drop the rest of this batch, as UDP would under congestion.
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    LOG_ERROR("[UdpServer] sendmmsg() failed on worker {}: {}", worker.index, std::strerror(errno));
+                }
+                break;
+            }
+            offset += static_cast<size_t>(sent);
+        }
+
+        worker.send_batches.fetch_add(1, std::memory_order_relaxed);
+        worker.datagrams_sent.fetch_add(offset, std::memory_order_relaxed);
+        for (auto& out : worker.send_batch) {
+            BufferPool::Instance().Release(std::move(out.payload));
+        }
+    }
+}
+
+UdpServer::WorkerStats UdpServer::GetWorkerStats(size_t worker_index) const {
+    WorkerStats stats;
+    if (worker_index >= m_workers.size()) return stats;
+    const auto& worker = *m_workers[worker_index];
+    stats.datagrams_received = worker.datagrams_received.load(std::memory_order_relaxed);
+    stats.datagrams_sent = worker.datagrams_sent.load(std::memory_order_relaxed);
+    stats.recv_batches = worker.recv_batches.load(std::memory_order_relaxed);
+    stats.send_batches = worker.send_batches.load(std::memory_order_relaxed);
+    stats.dropped_oversize = worker.dropped_oversize.load(std::memory_order_relaxed);
+    stats.connections_failed = worker.connections_failed.load(std::memory_order_relaxed);
+    return stats;
+}
 
-    if (m_socket.is_open()) {
-        DoReceive();
+UdpServer::WorkerStats UdpServer::GetTotalStats() const {
+    WorkerStats total;
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        const auto stats = GetWorkerStats(i);
+        total.datagrams_received += stats.datagrams_received;
+        total.datagrams_sent += stats.datagrams_sent;
+        total.recv_batches += stats.recv_batches;
+        total.send_batches += stats.send_batches;
+        total.dropped_oversize += stats.dropped_oversize;
+        total.connections_failed += stats.connections_failed;
     }
+    return total;
 }
 
 } // namespace mmorpg::network
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "network/i_udp_packet_handler.h"
-#include <boost/asio.hpp>
+#include "network/udp_reliability.h"
+#include <boost/asio/ip/udp.hpp>
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <thread>
@@ -11,6 +13,7 @@
 // Forward declarations
 namespace mmorpg::network {
 class SessionManager;
+struct UdpEndpointSnapshot;
 }
 
 namespace mmorpg::network {
@@ -19,31 +22,78 @@ using boost::asio::ip::udp;
 
 // [SEQUENCE: MVP6-29] A UDP server to handle real-time, unreliable data like player movement.
 // It runs in its own thread with its own io_context to avoid interfering with the main TCP server.
+// [SEQUENCE: MVP19-45] The single socket/thread loop is replaced by N workers. Each worker owns a socket bound
+// to the same port with SO_REUSEPORT (the kernel spreads flows across them), drains datagrams in batches with
+// recvmmsg into a preallocated slab, and flushes outbound datagrams with sendmmsg.
 class UdpServer {
 public:
+    // [SEQUENCE: MVP19-46] Engine configuration.
+    struct Config {
+        uint16_t port = 0;
+        size_t worker_count = 1;          // Sockets/threads sharing the port
+        size_t batch_size = 64;           // Datagrams per recvmmsg/sendmmsg call
+        size_t max_datagram_size = 2048;  // Slab slot size; larger datagrams are truncated and dropped
+        bool pin_threads = false;         // Pin worker i to core (i % hardware_concurrency)
+        int poll_timeout_ms = 100;        // Upper bound on how long Stop() waits for a worker to notice
+        int reliability_tick_ms = 10;     // How often workers run retransmit/ack timers for their sessions
+    };
+
+    // [SEQUENCE: MVP19-47] Per-worker counters, readable from any thread.
+    struct WorkerStats {
+        uint64_t datagrams_received = 0;
+        uint64_t datagrams_sent = 0;
+        uint64_t recv_batches = 0;
+        uint64_t send_batches = 0;
+        uint64_t dropped_oversize = 0;
+        uint64_t connections_failed = 0;   // Sessions disconnected for exhausting their retransmits
+    };
+
     UdpServer(uint16_t port, SessionManager& session_manager);
+    UdpServer(const Config& config, SessionManager& session_manager);
     ~UdpServer();
 
     bool Start();
     void Stop();
 
     // [SEQUENCE: MVP6-30] Sets the packet handler that will process incoming UDP data.
+    // With more than one worker the handler is invoked concurrently from several threads.
     void SetPacketHandler(std::shared_ptr<IUdpPacketHandler> handler) { m_packetHandler = std::move(handler); }
 
+    // [SEQUENCE: MVP19-48] Queues a datagram for the worker that owns the endpoint's flow. Thread-safe.
+    // [SEQUENCE: MVP19-411] A worker owns the endpoints of every SessionManager UDP shard s with
+    // s % worker_count == its index, so it sends and ticks them without hashing anything.
+    void SendTo(const udp::endpoint& endpoint, const std::byte* data, size_t size);
+
+    // [SEQUENCE: MVP19-101] Sends a message on one of the session's reliability channels. Returns false if the
+    // session has no UDP endpoint yet or its connection refused the message (see UdpReliableConnection::Send).
+    bool SendOnChannel(const std::shared_ptr<Session>& session, UdpChannel channel, const std::byte* data, size_t size);
+
+    uint16_t GetPort() const { return m_config.port; }
+    size_t GetWorkerCount() const { return m_workers.size(); }
+    WorkerStats GetWorkerStats(size_t worker_index) const;
+    WorkerStats GetTotalStats() const;
+
 private:
-    void DoReceive();
-    void HandleReceive(const boost::system::error_code& ec, std::size_t bytes_recvd);
+    // [SEQUENCE: MVP19-49] Per-thread worker state (socket, slab, outbound queue, endpoint snapshot). Defined in the .cpp
+    // so the Linux socket headers stay out of every includer.
+    struct Worker;
 
-    std::unique_ptr<boost::asio::io_context> m_io_context;
-    std::thread m_thread;
-    udp::socket m_socket;
-    uint16_t m_port;
+    bool OpenWorkerSocket(Worker& worker);
+    void RunWorker(Worker& worker);
+    void ReceiveBatch(Worker& worker);
+    void RefreshSnapshots(Worker& worker);
+    void FlushOutbound(Worker& worker);
+    void TickConnections(Worker& worker);
+    size_t WorkerIndexFor(const udp::endpoint& endpoint) const;
+    void EnqueueOutbound(Worker& worker, const udp::endpoint& endpoint, const std::byte* data, size_t size);
+    void CloseWorker(Worker& worker);
 
-    udp::endpoint m_remote_endpoint;
-    std::vector<std::byte> m_recv_buffer;
+    Config m_config;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<bool> m_running{false};
 
     SessionManager& m_session_manager;
     std::shared_ptr<IUdpPacketHandler> m_packetHandler;
 };
 
-} // namespace mmorpg::network
\ No newline at end of file
+} // namespace mmorpg::network
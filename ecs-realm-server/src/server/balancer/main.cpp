@@ -0,0 +1,73 @@
+#include "core/logger.h"
+#include "network/global_load_balancer.h"
+#include "network/load_balancer_service.h"
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+
+// [SEQUENCE: MVP19-333] Cluster load balancer: game nodes report their load here over UDP, and ask it where to
+// route a client or hand off a session. `mmorpg_balancer [port]`, 7000 by default.
+boost::asio::io_context* g_io_context = nullptr;
+
+void SignalHandler(int signal) {
+    if ((signal == SIGINT || signal == SIGTERM) && g_io_context) {
+        g_io_context->stop();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    mmorpg::core::Logger::Initialize();
+    std::signal(SIGINT, SignalHandler);
+    std::signal(SIGTERM, SignalHandler);
+
+    try {
+        const uint16_t port = static_cast<uint16_t>(argc > 1 ? std::atoi(argv[1]) : 7000);
+
+        boost::asio::io_context io_context;
+        g_io_context = &io_context;
+
+        mmorpg::network::GlobalLoadBalancer balancer;
+        auto service = std::make_shared<mmorpg::network::LoadBalancerService>(io_context, balancer);
+        if (!service->Start({boost::asio::ip::make_address("0.0.0.0"), port})) {
+            mmorpg::core::Logger::GetLogger()->error("Balancer could not bind UDP port {}", port);
+            return 1;
+        }
+        mmorpg::core::Logger::GetLogger()->info("Balancer listening on UDP port {}", port);
+
+        // Node table every five seconds, so a local cluster run shows where sessions go
+        boost::asio::steady_timer status_timer(io_context);
+        std::function<void()> print_status = [&] {
+            status_timer.expires_after(std::chrono::seconds(5));
+            status_timer.async_wait([&](const boost::system::error_code& ec) {
+                if (ec) return;
+                const auto stats = balancer.GetStatistics();
+                mmorpg::core::Logger::GetLogger()->info(
+                    "{}/{} nodes available, {} sessions, max load {:.2f}, {} routed, {} handoff targets",
+                    stats.available_servers, stats.total_servers, stats.total_sessions, stats.max_server_load,
+                    stats.successful_routings, stats.handoff_targets);
+                for (const auto& node : balancer.GetNodes()) {
+                    mmorpg::core::Logger::GetLogger()->info(
+                        "  {} {}:{} tick {:.1f}ms sessions {} (+{} pending) load {:.2f}{}", node.server_id, node.hostname,
+                        node.port, node.tick_ms, node.sessions, node.pending_sessions, node.GetLoadScore(),
+                        node.draining ? " draining" : "");
+                }
+                print_status();
+            });
+        };
+        print_status();
+
+        io_context.run();
+        service->Stop();
+        g_io_context = nullptr;
+    } catch (const std::exception& e) {
+        mmorpg::core::Logger::GetLogger()->critical("Balancer failed: {}", e.what());
+        return 1;
+    }
+
+    mmorpg::core::Logger::GetLogger()->info("Balancer stopped");
+    return 0;
+}
@@ -1,8 +1,14 @@
 #include "core/logger.h"
 #include "network/tcp_server.h"
+#include "network/io_context_pool.h"
 #include "network/udp_server.h"
 #include "network/packet_handler.h"
 #include "network/udp_packet_handler.h"
+#include "network/quic_protocol_handler.h"
+#include "network/load_balancer_service.h"
+#include "network/session_handoff.h"
+#include "network/movement_input_queue.h"
+#include "network/movement_relay.h"
 #include "network/session.h"
 #include "network/session_manager.h"
 #include "proto/auth.pb.h"
@@ -13,44 +19,90 @@
 #include "core/scripting/script_manager.h"
 
 #include <boost/asio.hpp>
+#include <algorithm>
 #include <atomic>
 #include <csignal>
+#include <cstdlib>
+#include <string>
 #include <iostream>
 #include <memory>
 #include <thread>
 #include <vector>
 #include <filesystem>
+#include <fstream>
 #include <chrono>
 
-// Global pointers for signal handling
+// Global pointers for shutdown
 std::shared_ptr<mmorpg::network::TcpServer> g_tcp_server;
 std::shared_ptr<mmorpg::network::UdpServer> g_udp_server;
-boost::asio::io_context* g_io_context = nullptr;
+std::shared_ptr<mmorpg::network::UdpServer> g_quic_server;
+mmorpg::network::IoContextPool* g_io_pool = nullptr;
+// [SEQUENCE: MVP19-328] Set by SIGUSR1: stop taking sessions and hand the current ones to other nodes
+std::atomic<bool> g_draining{false};
+// [SEQUENCE: MVP19-414] Set by SIGINT/SIGTERM. Stopping the servers takes locks, logs and joins threads, none of
+// which is async-signal-safe, so the handler only sets this flag and the main loop does the shutdown.
+std::atomic<bool> g_shutdown_requested{false};
+static_assert(std::atomic<bool>::is_always_lock_free);
 
 void SignalHandler(int signal) {
-    if (signal == SIGINT || signal == SIGTERM) {
-        mmorpg::core::Logger::GetLogger()->info("Received shutdown signal, stopping servers...");
+    if (signal == SIGUSR1) {
+        g_draining.store(true);
+    } else if (signal == SIGINT || signal == SIGTERM) {
+        g_shutdown_requested.store(true);
+    }
+}
 
-        // Shutdown managers
-        mmorpg::database::ConnectionPoolManager::Instance().ShutdownAll();
-        mmorpg::database::CacheManager::Instance().Shutdown();
+void StopServers() {
+    mmorpg::core::Logger::GetLogger()->info("Received shutdown signal, stopping servers...");
 
-        if (g_tcp_server) {
-            g_tcp_server->stop();
-        }
-        if (g_udp_server) {
-            g_udp_server->Stop();
-        }
-        if (g_io_context && !g_io_context->stopped()) {
-            g_io_context->stop();
+    // Shutdown managers
+    mmorpg::database::ConnectionPoolManager::Instance().ShutdownAll();
+    mmorpg::database::CacheManager::Instance().Shutdown();
+
+    if (g_tcp_server) {
+        g_tcp_server->stop();
+    }
+    if (g_udp_server) {
+        g_udp_server->Stop();
+    }
+    if (g_quic_server) {
+        g_quic_server->Stop();
+    }
+    if (g_io_pool) {
+        g_io_pool->Stop();
+    }
+}
+
+// [SEQUENCE: MVP19-420] The QUIC static key is configuration, like the TLS certificate: a file holding the X25519
+// private key as 64 hex digits. Clients pin its public half, so it has to survive restarts.
+bool LoadQuicKey(const std::string& path, mmorpg::network::QuicKeyPair& key) {
+    std::ifstream file(path);
+    std::string hex;
+    if (!(file >> hex) || hex.size() != key.private_key.size() * 2) {
+        return false;
+    }
+    const auto digit = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+    for (size_t i = 0; i < key.private_key.size(); ++i) {
+        const int high = digit(hex[2 * i]);
+        const int low = digit(hex[2 * i + 1]);
+        if (high < 0 || low < 0) {
+            return false;
         }
+        key.private_key[i] = static_cast<uint8_t>(high << 4 | low);
     }
+    return mmorpg::network::quic_crypto::DerivePublicKey(key.private_key, key.public_key);
 }
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
+int main(int argc, char* argv[]) {
     mmorpg::core::Logger::Initialize();
     std::signal(SIGINT, SignalHandler);
     std::signal(SIGTERM, SignalHandler);
+    std::signal(SIGUSR1, SignalHandler);
 
     try {
         // [SEQUENCE: MVP7-47] Initialize all database and distributed systems managers.
@@ -82,11 +134,58 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
             mmorpg::core::Logger::GetLogger()->info("Backend services initialized.");
         }
 
-        const uint16_t tcp_port = 8080;
-        const uint16_t udp_port = 8081;
+        // [SEQUENCE: MVP19-329] Cluster mode: `mmorpg_server <node_index> [balancer_host:port]`. Every node on a
+        // host takes its own block of ten ports, so several run side by side on loopback.
+        const int node_index = argc > 1 ? std::atoi(argv[1]) : 0;
+        const uint16_t port_offset = static_cast<uint16_t>(node_index * 10);
+        const std::string node_id = "node-" + std::to_string(node_index);
+        const std::string balancer_address = argc > 2 ? argv[2] : "127.0.0.1:7000";
+        // [SEQUENCE: MVP19-425] The secret signs handoff offers between nodes, so there is no default: a known one
+        // would let anyone who reaches the handoff port take over any player. The handoff listener binds the
+        // cluster-internal address only, since the connection itself is not encrypted.
+        const char* cluster_secret_env = std::getenv("MMORPG_CLUSTER_SECRET");
+        const std::string cluster_secret = cluster_secret_env ? cluster_secret_env : "";
+        const char* cluster_address_env = std::getenv("MMORPG_CLUSTER_ADDRESS");
+        const std::string cluster_address = cluster_address_env ? cluster_address_env : "127.0.0.1";
+        const size_t min_cluster_secret_size = 32;
+        const size_t max_sessions = 5000;
+        const size_t drain_handoffs_in_flight = 8;
+
+        const uint16_t tcp_port = 8080 + port_offset;
+        const uint16_t udp_port = 8081 + port_offset;
+        // [SEQUENCE: MVP19-285] QUIC listener: the same game sessions over connection-id routed, 0-RTT capable UDP
+        // Off until clients take the static key from LoginResponse.quic_public_key instead of a build-time pin
+        // [SEQUENCE: MVP19-455] and only available in builds configured with MMORPG_EXPERIMENTAL_QUIC, since the
+        // handshake is a custom, unreviewed protocol (see QUICProtocolHandler).
+#ifdef MMORPG_EXPERIMENTAL_QUIC
+        const bool enable_quic = true;
+#else
+        const bool enable_quic = false;
+#endif
+        const std::string quic_key_file = "quic_static.key";
+        const uint16_t quic_port = 8082 + port_offset;
+        const uint16_t handoff_port = 8083 + port_offset;
         const size_t thread_pool_size = 4;
         const std::string cert_file = "server.crt";
         const std::string key_file = "server.key";
+        const bool enable_kernel_tls = false;
+        // [SEQUENCE: MVP19-137] io_context-per-core mode: one io_context, thread and SO_REUSEPORT acceptor per
+        // core. 0 cores means one per hardware thread. Shared mode keeps one io_context run by every thread.
+        const bool per_core_io = false;
+        const size_t io_core_count = 0;
+        const bool pin_io_threads = false;
+
+        if (cluster_secret.size() < min_cluster_secret_size) {
+            mmorpg::core::Logger::GetLogger()->error("MMORPG_CLUSTER_SECRET must be set to at least {} characters!", min_cluster_secret_size);
+            mmorpg::core::Logger::GetLogger()->error("Please generate one using: openssl rand -hex 32");
+            return 1;
+        }
+        boost::system::error_code cluster_address_error;
+        const auto cluster_ip = boost::asio::ip::make_address(cluster_address, cluster_address_error);
+        if (cluster_address_error) {
+            mmorpg::core::Logger::GetLogger()->error("Invalid MMORPG_CLUSTER_ADDRESS '{}'", cluster_address);
+            return 1;
+        }
 
         if (!std::filesystem::exists(cert_file) || !std::filesystem::exists(key_file)) {
              mmorpg::core::Logger::GetLogger()->error("SSL certificate or key file not found!");
@@ -94,64 +193,217 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
              return 1;
         }
 
-        boost::asio::io_context io_context(thread_pool_size);
-        g_io_context = &io_context;
+        mmorpg::network::IoContextPool::Config io_config;
+        io_config.mode = per_core_io ? mmorpg::network::IoContextPool::Mode::PerCore : mmorpg::network::IoContextPool::Mode::Shared;
+        io_config.thread_count = per_core_io ? io_core_count : thread_pool_size;
+        io_config.pin_threads = pin_io_threads;
+        mmorpg::network::IoContextPool io_pool(io_config);
+        g_io_pool = &io_pool;
 
         auto session_manager = std::make_shared<mmorpg::network::SessionManager>();
         auto tcp_packet_handler = std::make_shared<mmorpg::network::PacketHandler>();
         auto pvp_manager = std::make_shared<mmorpg::game::systems::PvpManager>();
 
+        std::shared_ptr<mmorpg::network::QUICProtocolHandler> quic_handler;
+        std::shared_ptr<mmorpg::network::SessionHandoffService> handoff_service;
+
         static std::atomic<uint64_t> g_next_player_id{1};
-        tcp_packet_handler->RegisterHandler(mmorpg::proto::LoginRequest::descriptor(),
-            [session_manager](std::shared_ptr<mmorpg::network::Session> session, const google::protobuf::Message& message) {
-                const auto& req = static_cast<const mmorpg::proto::LoginRequest&>(message);
+        // [SEQUENCE: MVP19-16] Handlers are registered by message type so they land in the dense dispatch table.
+        tcp_packet_handler->RegisterHandler<mmorpg::proto::LoginRequest>(
+            [session_manager, &quic_handler](std::shared_ptr<mmorpg::network::Session> session, const mmorpg::proto::LoginRequest& req) {
                 mmorpg::proto::LoginResponse resp;
                 resp.set_success(true);
                 uint64_t player_id = g_next_player_id++;
                 resp.set_player_id(player_id);
                 resp.set_session_token("dummy-token-for-load-test");
+                resp.set_udp_token(session->GetUdpToken());
+                if (quic_handler) {
+                    const auto& quic_key = quic_handler->GetPublicKey();
+                    resp.set_quic_public_key(quic_key.data(), quic_key.size());
+                }
                 session->SetPlayerId(player_id);
                 session_manager->SetPlayerIdForSession(session->GetSessionId(), player_id);
                 session->Send(resp);
+                // A QUIC client gets a ticket so its next reconnect resumes in 0-RTT already logged in
+                if (quic_handler && session->GetTransportKind() == mmorpg::network::SessionTransportKind::Quic) {
+                    quic_handler->IssueResumptionTicket(*session);
+                }
                 mmorpg::core::Logger::GetLogger()->info("Processed login for user '{}', assigned player_id {}", req.username(), player_id);
             });
+        // A client redirected here by another node claims its player instead of logging in
+        tcp_packet_handler->RegisterHandler<mmorpg::proto::HandoffClaim>(
+            [&handoff_service](std::shared_ptr<mmorpg::network::Session> session, const mmorpg::proto::HandoffClaim& claim) {
+                if (handoff_service) handoff_service->HandleClaim(session, claim);
+            });
 
-        g_tcp_server = std::make_shared<mmorpg::network::TcpServer>(io_context, session_manager, tcp_packet_handler, tcp_port, cert_file, key_file);
+        g_tcp_server = std::make_shared<mmorpg::network::TcpServer>(io_pool, session_manager, tcp_packet_handler, tcp_port, cert_file, key_file);
+        // [SEQUENCE: MVP19-127] Kernel TLS is opt-in; sessions fall back to userspace TLS where it is unavailable.
+        mmorpg::network::SessionWriteConfig session_config;
+        session_config.kernel_tls = enable_kernel_tls;
+        g_tcp_server->SetSessionWriteConfig(session_config);
         g_tcp_server->run();
 
-        auto udp_packet_handler = std::make_shared<mmorpg::network::UdpPacketHandler>(*session_manager);
-        g_udp_server = std::make_shared<mmorpg::network::UdpServer>(udp_port, *session_manager);
+        // [SEQUENCE: MVP19-75] Movement arrives over UDP and is handed to the simulation through a per-tick queue.
+        auto movement_queue = std::make_shared<mmorpg::network::MovementInputQueue>();
+        auto udp_packet_handler = std::make_shared<mmorpg::network::UdpPacketHandler>(*session_manager, movement_queue.get());
+        // [SEQUENCE: MVP19-57] One ingest worker per two TCP threads; the kernel spreads client flows across them.
+        mmorpg::network::UdpServer::Config udp_config;
+        udp_config.port = udp_port;
+        udp_config.worker_count = std::max<size_t>(1, thread_pool_size / 2);
+        g_udp_server = std::make_shared<mmorpg::network::UdpServer>(udp_config, *session_manager);
         g_udp_server->SetPacketHandler(udp_packet_handler);
         g_udp_server->Start();
 
+        // [SEQUENCE: MVP19-286] QUIC sessions share the TCP packet handler, so every game handler serves both
+        // transports. The static key is loaded from quic_key_file; tickets are sealed with a per-process key, so
+        // those from before a restart are simply refused.
+        if (enable_quic) {
+            mmorpg::core::Logger::GetLogger()->warn("Experimental QUIC transport enabled on port {}: custom handshake, not security reviewed", quic_port);
+            mmorpg::network::QuicKeyPair quic_key;
+            if (!LoadQuicKey(quic_key_file, quic_key)) {
+                mmorpg::core::Logger::GetLogger()->error("QUIC static key '{}' is missing or invalid!", quic_key_file);
+                mmorpg::core::Logger::GetLogger()->error("Please generate it using: openssl rand -hex 32 > {}", quic_key_file);
+                return 1;
+            }
+            quic_handler = std::make_shared<mmorpg::network::QUICProtocolHandler>(
+                quic_key, *session_manager, tcp_packet_handler, io_pool.GetContext(0).get_executor());
+            quic_handler->SetMovementQueue(movement_queue.get());
+            mmorpg::network::UdpServer::Config quic_config;
+            quic_config.port = quic_port;
+            quic_config.worker_count = udp_config.worker_count;
+            g_quic_server = std::make_shared<mmorpg::network::UdpServer>(quic_config, *session_manager);
+            quic_handler->SetDatagramSender(
+                [server = g_quic_server.get()](const mmorpg::network::QUICProtocolHandler::Endpoint& to,
+                                               const std::byte* data, size_t size) { server->SendTo(to, data, size); });
+            g_quic_server->SetPacketHandler(quic_handler);
+            g_quic_server->Start();
+        }
+
+        // [SEQUENCE: MVP19-330] Session handoff between nodes. This process does not host an ECS world yet, so the
+        // handed-off state is empty and a moved player is only its session binding; a world-hosting server exports
+        // and imports with game::handoff::PlayerStateCodec.
+        mmorpg::network::SessionHandoffConfig handoff_config;
+        handoff_config.node_id = node_id;
+        handoff_config.cluster_secret = cluster_secret;
+        handoff_config.advertised_port = tcp_port;
+        handoff_service = std::make_shared<mmorpg::network::SessionHandoffService>(io_pool.GetContext(0), *session_manager, handoff_config);
+        handoff_service->SetStateExporter([](uint64_t) { return std::optional<std::string>(std::string{}); });
+        handoff_service->SetStateImporter([](uint64_t, const std::string&) { return true; });
+        handoff_service->SetHandedOffCallback([](uint64_t player_id, const std::string& target_node) {
+            mmorpg::core::Logger::GetLogger()->info("Handed off player {} to {}", player_id, target_node);
+        });
+        handoff_service->SetClaimedCallback([&quic_handler](const std::shared_ptr<mmorpg::network::Session>& session, uint64_t player_id) {
+            if (quic_handler && session->GetTransportKind() == mmorpg::network::SessionTransportKind::Quic) {
+                quic_handler->IssueResumptionTicket(*session);
+            }
+            mmorpg::core::Logger::GetLogger()->info("Player {} arrived by handoff", player_id);
+        });
+        if (!handoff_service->Listen({cluster_ip, handoff_port})) {
+            return 1;
+        }
+
+        // [SEQUENCE: MVP19-331] Load reports: tick time from the loop below, sessions, and egress bytes
+        static std::atomic<double> g_tick_ms{0.0};
+        std::shared_ptr<mmorpg::network::NodeLoadReporter> load_reporter;
+        {
+            const auto colon = balancer_address.rfind(':');
+            boost::system::error_code ec;
+            const auto balancer_ip = boost::asio::ip::make_address(balancer_address.substr(0, colon), ec);
+            if (colon == std::string::npos || ec) {
+                mmorpg::core::Logger::GetLogger()->error("Invalid balancer address '{}'; not reporting load", balancer_address);
+            } else {
+                mmorpg::network::NodeLoadReporter::Config reporter_config;
+                reporter_config.node_id = node_id;
+                reporter_config.game_port = tcp_port;
+                reporter_config.handoff_port = handoff_port;
+                reporter_config.max_sessions = max_sessions;
+                load_reporter = std::make_shared<mmorpg::network::NodeLoadReporter>(
+                    io_pool.GetContext(0), reporter_config,
+                    boost::asio::ip::udp::endpoint(balancer_ip, static_cast<uint16_t>(std::atoi(balancer_address.c_str() + colon + 1))),
+                    [session_manager] {
+                        mmorpg::network::NodeLoadSample sample;
+                        sample.tick_ms = g_tick_ms.load(std::memory_order_relaxed);
+                        sample.sessions = static_cast<uint32_t>(session_manager->GetSessionCount());
+                        sample.egress_bytes_total = mmorpg::network::Session::GetProcessBytesFlushed();
+                        sample.draining = g_draining.load();
+                        return sample;
+                    });
+                load_reporter->Start();
+            }
+        }
+
+        mmorpg::core::Logger::GetLogger()->info("Node {} ready (game port {}, handoff port {}); SIGUSR1 drains it", node_id, tcp_port, handoff_port);
         mmorpg::core::Logger::GetLogger()->info("Press Ctrl+C to stop the servers");
 
-        std::vector<std::thread> threads;
-        for (size_t i = 0; i < thread_pool_size; ++i) {
-            threads.emplace_back([&io_context]() {
-                io_context.run();
+        // [SEQUENCE: MVP19-448] One entity update batch per session per tick, from the relay's shared records
+        mmorpg::network::MovementRelay movement_relay({},
+            [session_manager](uint64_t session_id, const mmorpg::network::SharedPacketBuffer& batch) {
+                session_manager->SendToSession(static_cast<uint32_t>(session_id), batch);
             });
-        }
+
+        io_pool.Run();
 
         auto last_time = std::chrono::high_resolution_clock::now();
-        while (!io_context.stopped()) {
+        std::vector<mmorpg::network::MovementInput> movement_inputs;
+        std::unique_ptr<mmorpg::network::HandoffDrainer> drainer;
+        if (load_reporter) {
+            drainer = std::make_unique<mmorpg::network::HandoffDrainer>(handoff_service, *session_manager, drain_handoffs_in_flight,
+                [load_reporter](mmorpg::network::HandoffDrainer::TargetCallback callback) {
+                    load_reporter->RequestHandoffTarget([callback = std::move(callback)](const mmorpg::proto::RouteResponse& target) {
+                        boost::system::error_code ec;
+                        const auto address = boost::asio::ip::make_address(target.host(), ec);
+                        if (!target.success() || ec) {
+                            callback(std::nullopt);
+                            return;
+                        }
+                        callback(boost::asio::ip::tcp::endpoint(address, static_cast<uint16_t>(target.handoff_port())));
+                    });
+                });
+        }
+        bool announced_drain = false;
+        while (io_pool.IsRunning()) {
+            if (g_shutdown_requested.load()) {
+                StopServers();
+                break;
+            }
             auto current_time = std::chrono::high_resolution_clock::now();
             float delta_time = std::chrono::duration<float>(current_time - last_time).count();
             last_time = current_time;
 
+            // This process does not host an ECS world yet, so the tick relays each player's newest input to the
+            // players near it. A world-hosting server hands the queue to MovementSystem::SetInputQueue instead.
+            movement_queue->DrainTick(movement_inputs);
+            movement_relay.Tick(movement_inputs, std::chrono::steady_clock::now());
+
             pvp_manager->Update(delta_time);
 
+            // [SEQUENCE: MVP19-332] A draining node moves its players a few at a time, each to a target the
+            // balancer picks, until none are left
+            if (g_draining.load() && drainer) {
+                if (!announced_drain) {
+                    announced_drain = true;
+                    load_reporter->ReportNow();
+                    mmorpg::core::Logger::GetLogger()->info("Node {} draining", node_id);
+                }
+                drainer->Tick();
+            }
+
+            g_tick_ms.store(0.9 * g_tick_ms.load(std::memory_order_relaxed) +
+                                0.1 * std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - current_time).count(),
+                            std::memory_order_relaxed);
+
             std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
         }
 
-        for (auto& t : threads) {
-            if (t.joinable()) {
-                t.join();
-            }
-        }
+        io_pool.Join();
+        g_io_pool = nullptr;
 
         g_tcp_server.reset();
         g_udp_server.reset();
+        g_quic_server.reset();
+        quic_handler.reset();
+        load_reporter.reset();
+        handoff_service.reset();
 
         mmorpg::core::Logger::GetLogger()->info("Game server shutdown complete");
 
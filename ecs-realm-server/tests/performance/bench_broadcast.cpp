@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include "network/packet_serializer.h"
+#include "proto/game.pb.h"
+
+#include <vector>
+
+using namespace mmorpg::network;
+
+namespace {
+
+mmorpg::proto::ChatMessage MakeWorldChat() {
+    mmorpg::proto::ChatMessage chat;
+    chat.set_sender_id(1);
+    chat.set_sender_name("GameMaster");
+    chat.set_channel(mmorpg::proto::ChatMessage::CHANNEL_GLOBAL);
+    chat.set_message("Server maintenance begins in 10 minutes. Please find a safe place to log out.");
+    chat.set_timestamp(1700000000);
+    return chat;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-40] Serialization cost of a world-chat broadcast when every session re-serializes the message.
+static void BM_Broadcast_SerializePerSession(benchmark::State& state) {
+    const auto chat = MakeWorldChat();
+    const auto sessions = static_cast<size_t>(state.range(0));
+    std::vector<std::vector<std::byte>> queued;
+    queued.reserve(sessions);
+
+    for (auto _ : state) {
+        queued.clear();
+        for (size_t i = 0; i < sessions; ++i) {
+            queued.push_back(PacketSerializer::Serialize(chat));
+        }
+        benchmark::DoNotOptimize(queued.data());
+    }
+    state.SetItemsProcessed(state.iterations() * sessions);
+}
+BENCHMARK(BM_Broadcast_SerializePerSession)->Arg(500)->Arg(5000);
+
+// [SEQUENCE: MVP19-41] Same broadcast with one shared framed buffer referenced by every session's queue.
+static void BM_Broadcast_SerializeOnce(benchmark::State& state) {
+    const auto chat = MakeWorldChat();
+    const auto sessions = static_cast<size_t>(state.range(0));
+    std::vector<SharedPacketBuffer> queued;
+    queued.reserve(sessions);
+
+    for (auto _ : state) {
+        queued.clear();
+        auto packet = PacketSerializer::SerializeShared(chat);
+        for (size_t i = 0; i < sessions; ++i) {
+            queued.push_back(packet);
+        }
+        benchmark::DoNotOptimize(queued.data());
+    }
+    state.SetItemsProcessed(state.iterations() * sessions);
+}
+BENCHMARK(BM_Broadcast_SerializeOnce)->Arg(500)->Arg(5000);
@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+
+#include "game/components/health_component.h"
+#include "game/components/transform_component.h"
+#include "game/systems/scheduling/parallel_iteration.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace mmorpg::game::components;
+using namespace mmorpg::game::systems::scheduling;
+using mmorpg::core::ecs::EntityId;
+
+namespace {
+
+// The movement system's data: packed velocity and transform arrays filled in different orders, as arrays
+// whose components were added at different times are, and the entity-to-index map GetComponent looks in
+struct MovementWorld {
+    std::vector<VelocityComponent> velocities;
+    std::vector<EntityId> velocity_entities;
+    std::vector<TransformComponent> transforms;
+    std::vector<EntityId> transform_entities;
+    std::unordered_map<EntityId, uint32_t> transform_index;
+
+    explicit MovementWorld(size_t count) {
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> speed(-15.0f, 15.0f);
+        velocities.resize(count);
+        velocity_entities.resize(count);
+        std::iota(velocity_entities.begin(), velocity_entities.end(), EntityId{1});
+        for (auto& v : velocities) v.linear = {speed(rng), speed(rng), 0.0f};
+        transform_entities = velocity_entities;
+        std::shuffle(transform_entities.begin(), transform_entities.end(), rng);
+        transforms.resize(count);
+        transform_index.reserve(count);
+        for (uint32_t j = 0; j < count; ++j) transform_index[transform_entities[j]] = j;
+    }
+
+    uint32_t Find(EntityId entity) const {
+        const auto it = transform_index.find(entity);
+        return it == transform_index.end() ? ComponentJoin::kMissing : it->second;
+    }
+};
+
+void Clamp(VelocityComponent* velocities, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        auto& vel = velocities[i];
+        const float speed_sq = vel.linear.x * vel.linear.x + vel.linear.y * vel.linear.y + vel.linear.z * vel.linear.z;
+        if (speed_sq > vel.max_speed * vel.max_speed) {
+            const float scale = vel.max_speed / std::sqrt(speed_sq);
+            vel.linear.x *= scale;
+            vel.linear.y *= scale;
+            vel.linear.z *= scale;
+        }
+    }
+}
+
+void Move(TransformComponent& transform, const VelocityComponent& velocity, float dt) {
+    transform.position.x += velocity.linear.x * dt;
+    transform.position.y += velocity.linear.y * dt;
+    transform.position.z += velocity.linear.z * dt;
+    transform.rotation.z += velocity.angular.z * dt;
+    if (transform.rotation.z > 3.14159f) transform.rotation.z -= 6.28318f;
+}
+
+std::unique_ptr<WorkStealingPool> MakePool(int64_t workers) {
+    return workers < 0 ? nullptr : std::make_unique<WorkStealingPool>(static_cast<size_t>(workers));
+}
+
+void Arguments(benchmark::internal::Benchmark* bench) {
+    const auto workers = static_cast<int64_t>(WorkStealingPool::DefaultWorkerCount());
+    for (const int64_t count : {10000, 100000, 1000000}) {
+        bench->Args({count, -1});   // No pool: the calling thread alone
+        if (workers > 0) bench->Args({count, workers});
+    }
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-399] Movement as it was: 64-element batches on one thread, a hash lookup per transform
+static void BM_MovementLookup(benchmark::State& state) {
+    MovementWorld world(static_cast<size_t>(state.range(0)));
+    const size_t count = world.velocities.size();
+    for (auto _ : state) {
+        for (size_t begin = 0; begin < count; begin += 64) {
+            const size_t end = std::min(begin + 64, count);
+            Clamp(world.velocities.data() + begin, end - begin);
+            for (size_t i = begin; i < end; ++i) {
+                const uint32_t j = world.Find(world.velocity_entities[i]);
+                if (j != ComponentJoin::kMissing) Move(world.transforms[j], world.velocities[i], 0.05f);
+            }
+        }
+        benchmark::DoNotOptimize(world.transforms.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_MovementLookup)->Arg(10000)->Arg(100000)->Arg(1000000);
+
+// [SEQUENCE: MVP19-400] Movement as it is now: L1-sized chunks across the pool, transforms through the join
+static void BM_MovementJoined(benchmark::State& state) {
+    MovementWorld world(static_cast<size_t>(state.range(0)));
+    auto pool = MakePool(state.range(1));
+    const size_t count = world.velocities.size();
+    constexpr size_t kChunk = ChunkSize<VelocityComponent, TransformComponent, EntityId, EntityId, uint32_t>();
+    ComponentJoin join;
+    auto find = [&world](EntityId entity) { return world.Find(entity); };
+    for (auto _ : state) {
+        join.Prepare(count);
+        ParallelForChunks(pool.get(), count, kChunk, [&](size_t begin, size_t end) {
+            Clamp(world.velocities.data() + begin, end - begin);
+            join.ForRange(begin, end, world.velocity_entities, world.transform_entities, find,
+                          [&](size_t i, size_t j) { Move(world.transforms[j], world.velocities[i], 0.05f); });
+        });
+        benchmark::DoNotOptimize(world.transforms.data());
+    }
+    state.counters["lookups"] = static_cast<double>(join.GetLastLookups());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_MovementJoined)->Apply(Arguments)->UseRealTime();
+
+// [SEQUENCE: MVP19-401] Regeneration over the dense health array, a quarter of it wounded
+static void BM_RegenChunks(benchmark::State& state) {
+    std::vector<HealthComponent> healths(static_cast<size_t>(state.range(0)));
+    for (size_t i = 0; i < healths.size(); i += 4) healths[i].current_hp = 10.0f;
+    auto pool = MakePool(state.range(1));
+    constexpr size_t kChunk = ChunkSize<HealthComponent, EntityId>();
+    for (auto _ : state) {
+        ParallelForChunks(pool.get(), healths.size(), kChunk, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                auto& health = healths[i];
+                health.Regenerate(0.05f);
+                if (health.current_hp >= health.max_hp && i % 4 == 0) health.current_hp = 10.0f;
+            }
+        });
+        benchmark::DoNotOptimize(healths.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RegenChunks)->Apply(Arguments)->UseRealTime();
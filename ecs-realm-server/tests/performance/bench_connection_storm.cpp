@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+
+#include "network/tcp_server.h"
+#include "network/io_context_pool.h"
+#include "network/session_manager.h"
+#include "tls_test_certificate.h"
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace mmorpg;
+using namespace mmorpg::network;
+using boost::asio::ip::tcp;
+
+namespace {
+
+struct CertificateFiles {
+    CertificateFiles() {
+        const auto dir = std::filesystem::temp_directory_path();
+        cert_path = (dir / "bench_connection_storm.crt").string();
+        key_path = (dir / "bench_connection_storm.key").string();
+        certificate.WritePem(cert_path, key_path);
+    }
+
+    bench::SelfSignedCertificate certificate;
+    std::string cert_path;
+    std::string key_path;
+};
+
+// [SEQUENCE: MVP19-138] Opens total TLS connections with at most in_flight handshakes outstanding. Each
+// connection is reset right after its handshake (SO_LINGER 0) so the run does not exhaust ephemeral ports.
+class HandshakeStorm {
+public:
+    HandshakeStorm(uint16_t port, size_t total, size_t in_flight, size_t threads)
+        : m_endpoint(boost::asio::ip::address_v4::loopback(), port),
+          m_total(total),
+          m_inFlight(in_flight),
+          m_threads(threads) {
+        m_context.set_verify_mode(boost::asio::ssl::verify_none);
+    }
+
+    // Returns the number of handshakes that failed.
+    size_t Run() {
+        for (size_t i = 0; i < std::min(m_inFlight, m_total); ++i) {
+            Launch();
+        }
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < m_threads; ++i) {
+            threads.emplace_back([this] { m_io.run(); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return m_failed.load();
+    }
+
+private:
+    using Stream = boost::asio::ssl::stream<tcp::socket>;
+
+    void Launch() {
+        if (m_launched.fetch_add(1) >= m_total) return;
+        auto stream = std::make_shared<Stream>(m_io, m_context);
+        stream->next_layer().async_connect(m_endpoint, [this, stream](const boost::system::error_code& ec) {
+            if (ec) {
+                Finish(*stream, false);
+                return;
+            }
+            stream->async_handshake(boost::asio::ssl::stream_base::client,
+                [this, stream](const boost::system::error_code& handshake_ec) { Finish(*stream, !handshake_ec); });
+        });
+    }
+
+    void Finish(Stream& stream, bool ok) {
+        if (!ok) m_failed.fetch_add(1);
+        boost::system::error_code ec;
+        stream.next_layer().set_option(boost::asio::socket_base::linger(true, 0), ec);
+        stream.next_layer().close(ec);
+        Launch();
+    }
+
+    boost::asio::io_context m_io;
+    boost::asio::ssl::context m_context{boost::asio::ssl::context::tls_client};
+    const tcp::endpoint m_endpoint;
+    const size_t m_total;
+    const size_t m_inFlight;
+    const size_t m_threads;
+    std::atomic<size_t> m_launched{0};
+    std::atomic<size_t> m_failed{0};
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-139] 10k TLS handshakes against the TCP server in shared mode (0: one io_context run by every
+// core) and per-core mode (1: an io_context and SO_REUSEPORT acceptor per core). busiest_acceptor_share shows
+// how evenly the kernel spread the storm (1.0 with a single acceptor).
+static void BM_ConnectionStorm(benchmark::State& state) {
+    static const CertificateFiles files;
+    constexpr size_t kHandshakes = 10000;
+    constexpr size_t kInFlight = 256;
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+
+    IoContextPool::Config config;
+    config.mode = state.range(0) != 0 ? IoContextPool::Mode::PerCore : IoContextPool::Mode::Shared;
+    config.thread_count = cores;
+
+    size_t failed = 0;
+    double busiest_share = 0.0;
+    for (auto _ : state) {
+        IoContextPool pool(config);
+        auto manager = std::make_shared<SessionManager>();
+        TcpServer server(pool, manager, nullptr, 0, files.cert_path, files.key_path);
+        server.run();
+        pool.Run();
+
+        HandshakeStorm storm(server.port(), kHandshakes, kInFlight, cores);
+        const auto start = std::chrono::steady_clock::now();
+        failed += storm.Run();
+        state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+        server.stop();
+        pool.Stop();
+        pool.Join();
+
+        const auto counts = server.accept_counts();
+        uint64_t total = 0;
+        for (auto count : counts) total += count;
+        busiest_share = total ? static_cast<double>(*std::max_element(counts.begin(), counts.end())) / total : 0.0;
+    }
+
+    state.counters["handshakes_per_sec"] = benchmark::Counter(static_cast<double>(kHandshakes * state.iterations()), benchmark::Counter::kIsRate);
+    state.counters["failed"] = static_cast<double>(failed);
+    state.counters["acceptors"] = static_cast<double>(config.mode == IoContextPool::Mode::PerCore ? cores : 1);
+    state.counters["busiest_acceptor_share"] = busiest_share;
+}
+BENCHMARK(BM_ConnectionStorm)->Arg(0)->Arg(1)->Iterations(1)->UseManualTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include "network/entity_update_batcher.h"
+#include "network/packet_serializer.h"
+#include "proto/game.pb.h"
+
+#include <unordered_map>
+#include <vector>
+
+using namespace mmorpg::network;
+
+namespace {
+
+// Every observer sees every entity: the worst case for a crowded area.
+void FillUpdate(mmorpg::proto::EntityUpdate& update, uint64_t entity) {
+    update.set_entity_id(entity);
+    auto* movement = update.mutable_movement();
+    movement->set_entity_id(entity);
+    movement->mutable_position()->set_x(static_cast<float>(entity));
+    movement->mutable_position()->set_y(12.5f);
+    movement->mutable_position()->set_z(-3.0f);
+    movement->mutable_velocity()->set_x(1.0f);
+    movement->set_timestamp(1234.5f);
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-152] The previous sync shape: an EntityUpdate per dirty entity, copied by value into every
+// observer's vector, then each session's updates serialized into a batch.
+static void BM_EntitySync_CopyPerObserver(benchmark::State& state) {
+    const auto entities = static_cast<uint64_t>(state.range(0));
+    const auto observers = static_cast<uint64_t>(state.range(1));
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::unordered_map<uint64_t, std::vector<mmorpg::proto::EntityUpdate>> updates_by_session;
+        for (uint64_t entity = 0; entity < entities; ++entity) {
+            mmorpg::proto::EntityUpdate update;
+            FillUpdate(update, entity);
+            for (uint64_t session = 1; session <= observers; ++session) {
+                updates_by_session[session].push_back(update);
+            }
+        }
+        for (auto& [session, updates] : updates_by_session) {
+            mmorpg::proto::EntityUpdateBatch batch;
+            for (auto& update : updates) {
+                *batch.add_updates() = update;
+            }
+            auto packet = PacketSerializer::SerializeShared(batch);
+            bytes += packet->size();
+            benchmark::DoNotOptimize(packet);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * entities * observers);
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_EntitySync_CopyPerObserver)->Args({200, 50})->Args({1000, 100});
+
+// [SEQUENCE: MVP19-153] EntityUpdateBatcher: arena-allocated updates encoded once, per-session batches
+// assembled from the shared records.
+static void BM_EntitySync_EncodeOnce(benchmark::State& state) {
+    const auto entities = static_cast<uint64_t>(state.range(0));
+    const auto observers = static_cast<uint64_t>(state.range(1));
+    EntityUpdateBatcher batcher;
+    uint32_t tick = 0;
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        batcher.BeginTick(++tick);
+        for (uint64_t entity = 0; entity < entities; ++entity) {
+            auto* update = batcher.NewUpdate();
+            FillUpdate(*update, entity);
+            const auto record = batcher.Encode(*update);
+            for (uint64_t session = 1; session <= observers; ++session) {
+                batcher.AddRecipient(session, record);
+            }
+        }
+        batcher.Flush([&](uint64_t, const SharedPacketBuffer& packet) {
+            bytes += packet->size();
+            benchmark::DoNotOptimize(packet);
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * entities * observers);
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_EntitySync_EncodeOnce)->Args({200, 50})->Args({1000, 100});
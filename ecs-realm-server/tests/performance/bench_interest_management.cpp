@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include "game/world/grid/interest_manager.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace mmorpg::game::world::grid;
+using mmorpg::core::ecs::EntityId;
+using mmorpg::core::utils::Vector3;
+
+namespace {
+
+constexpr size_t kUpdateBytes = 16;   // A moving entity in MovementCodec
+
+} // namespace
+
+// [SEQUENCE: MVP19-198] A siege: every player is a connected observer packed into a 200 m square, walking each
+// tick. One iteration is one 60 Hz sync tick: grid and interest updates for every player, then CollectDue for
+// every observer. Reports what each client is sent against the budget and what an untiered sync would send.
+static void BM_InterestSiegeTick(benchmark::State& state) {
+    const auto players = static_cast<EntityId>(state.range(0));
+
+    WorldGrid::Config grid_config;
+    grid_config.cell_size = 25.0f;
+    grid_config.grid_width = 40;
+    grid_config.grid_height = 40;
+    WorldGrid grid(grid_config);
+    InterestManager::Config interest_config;
+    interest_config.view_cell_range = 6;
+    InterestManager interest(grid, interest_config);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coord(400.0f, 600.0f);
+    std::uniform_real_distribution<float> step(-0.15f, 0.15f);   // ~5 m/s at 60 Hz
+    std::vector<Vector3> positions(players + 1);
+    for (EntityId player = 1; player <= players; ++player) {
+        positions[player] = {coord(rng), coord(rng), 0.0f};
+        grid.AddEntity(player, positions[player]);
+        interest.AddEntity(player, positions[player]);
+    }
+    for (EntityId player = 1; player <= players; ++player) {
+        interest.AddObserver(player);
+    }
+
+    std::vector<EntityId> due;
+    uint32_t tick = 0;
+    uint64_t visible_pairs = 0;
+    interest.ResetStats();
+    for (auto _ : state) {
+        ++tick;
+        for (EntityId player = 1; player <= players; ++player) {
+            const Vector3 next{std::clamp(positions[player].x + step(rng), 400.0f, 600.0f),
+                               std::clamp(positions[player].y + step(rng), 400.0f, 600.0f), 0.0f};
+            grid.UpdateEntity(player, positions[player], next);
+            interest.UpdateEntity(player, next);
+            positions[player] = next;
+        }
+        for (EntityId player = 1; player <= players; ++player) {
+            interest.CollectDue(player, tick, [](EntityId) { return kUpdateBytes; }, due);
+            visible_pairs += interest.GetInterestSetSize(player);
+        }
+    }
+
+    const auto& stats = interest.GetStats();
+    const double client_ticks = static_cast<double>(tick) * static_cast<double>(players);
+    state.counters["bytes_per_client_tick"] = static_cast<double>(stats.bytes) / client_ticks;
+    state.counters["budget_per_client_tick"] = static_cast<double>(interest_config.budget_bytes_per_tick);
+    state.counters["untiered_bytes_per_client_tick"] =
+        static_cast<double>(visible_pairs * kUpdateBytes) / client_ticks;
+    state.counters["deferred_per_client_tick"] = static_cast<double>(stats.deferred) / client_ticks;
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(players));
+}
+BENCHMARK(BM_InterestSiegeTick)->Arg(200)->Arg(1000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,309 @@
+#include <benchmark/benchmark.h>
+
+#include "network/hit_validation_pipeline.h"
+#include "network/rewind_history.h"
+
+#include <cmath>
+#include <deque>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace mmorpg::network;
+using mmorpg::core::utils::Vector3;
+using Clock = RewindHistory::Clock;
+
+namespace {
+
+constexpr size_t kEntities = 5000;
+constexpr int kFrames = 72;   // A little over one second at 60 Hz
+constexpr auto kFrame = std::chrono::microseconds(16667);
+const Vector3 kHalfExtents{0.4f, 0.4f, 0.9f};
+
+// 5000 entities milling about a 1 km square
+struct World {
+    explicit World(uint32_t seed) : rng(seed) {
+        std::uniform_real_distribution<float> coord(0.0f, 1000.0f);
+        positions.resize(kEntities);
+        for (auto& p : positions) p = {coord(rng), coord(rng), 0.0f};
+    }
+
+    void Step() {
+        std::uniform_real_distribution<float> step(-0.1f, 0.1f);
+        for (auto& p : positions) {
+            p.x += step(rng);
+            p.y += step(rng);
+        }
+    }
+
+    std::mt19937 rng;
+    std::vector<Vector3> positions;
+};
+
+// The previous LagCompensation layout: a map of full entity states per frame in a deque, a linear scan for the
+// frames around the time, then a third map holding every entity interpolated.
+struct MapSnapshot {
+    struct State {
+        Vector3 position, velocity;
+        Vector3 lo, hi;
+        bool alive;
+    };
+    Clock::time_point timestamp;
+    std::unordered_map<uint64_t, State> states;
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-208] Writing one frame of 5000 entities into the ring. Reports the fixed footprint.
+static void BM_RewindRecordFrame(benchmark::State& state) {
+    World world(1);
+    RewindHistory history;
+    auto now = Clock::now();
+    for (auto _ : state) {
+        now += kFrame;
+        history.BeginFrame(now);
+        for (size_t i = 0; i < kEntities; ++i) {
+            history.Record(i + 1, world.positions[i], {}, kHalfExtents, true);
+        }
+    }
+    state.counters["footprint_mb"] = static_cast<double>(history.GetMemoryFootprint()) / (1024.0 * 1024.0);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kEntities));
+}
+BENCHMARK(BM_RewindRecordFrame)->Unit(benchmark::kMicrosecond);
+
+static void BM_MapSnapshotRecordFrame(benchmark::State& state) {
+    World world(1);
+    std::deque<MapSnapshot> snapshots;
+    auto now = Clock::now();
+    for (auto _ : state) {
+        now += kFrame;
+        MapSnapshot snapshot;
+        snapshot.timestamp = now;
+        for (size_t i = 0; i < kEntities; ++i) {
+            const auto& p = world.positions[i];
+            snapshot.states[i + 1] = {p, {}, {p.x - 0.4f, p.y - 0.4f, p.z - 0.9f}, {p.x + 0.4f, p.y + 0.4f, p.z + 0.9f},
+                                      true};
+        }
+        snapshots.push_back(std::move(snapshot));
+        if (snapshots.size() > static_cast<size_t>(kFrames)) snapshots.pop_front();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kEntities));
+}
+BENCHMARK(BM_MapSnapshotRecordFrame)->Unit(benchmark::kMicrosecond);
+
+// [SEQUENCE: MVP19-209] One hit validation: a 100 m shot from a random player at a random time in the last second,
+// against the full rewound world.
+static void BM_RewindRaycast(benchmark::State& state) {
+    World world(2);
+    RewindHistory history;
+    const auto start = Clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        world.Step();
+        history.BeginFrame(start + kFrame * frame);
+        for (size_t i = 0; i < kEntities; ++i) {
+            history.Record(i + 1, world.positions[i], {}, kHalfExtents, true);
+        }
+    }
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<size_t> shooter(0, kEntities - 1);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::uniform_int_distribution<int> back(0, kFrames - 2);
+    size_t hits = 0;
+    const uint64_t rewound_before = history.GetStats().entities_rewound;
+    for (auto _ : state) {
+        const size_t from = shooter(rng);
+        const float heading = angle(rng);
+        const auto time = start + kFrame * back(rng) + kFrame / 3;
+        auto hit = history.RaycastAt(time, world.positions[from], {std::cos(heading), std::sin(heading), 0.0f},
+                                     100.0f, from + 1);
+        hits += hit.has_value();
+        benchmark::DoNotOptimize(hit);
+    }
+    const double shots = static_cast<double>(state.iterations());
+    state.counters["hit_rate"] = static_cast<double>(hits) / shots;
+    state.counters["rewound_per_shot"] =
+        static_cast<double>(history.GetStats().entities_rewound - rewound_before) / shots;
+}
+BENCHMARK(BM_RewindRaycast)->Unit(benchmark::kMicrosecond);
+
+// Validating a claimed victim only needs that one entity.
+static void BM_RewindEntityAt(benchmark::State& state) {
+    World world(2);
+    RewindHistory history;
+    const auto start = Clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        history.BeginFrame(start + kFrame * frame);
+        for (size_t i = 0; i < kEntities; ++i) {
+            history.Record(i + 1, world.positions[i], {}, kHalfExtents, true);
+        }
+    }
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<uint64_t> victim(1, kEntities);
+    std::uniform_int_distribution<int> back(0, kFrames - 2);
+    for (auto _ : state) {
+        auto rewound = history.GetEntityAt(victim(rng), start + kFrame * back(rng) + kFrame / 3);
+        benchmark::DoNotOptimize(rewound);
+    }
+}
+BENCHMARK(BM_RewindEntityAt)->Unit(benchmark::kMicrosecond);
+
+static void BM_MapSnapshotRaycast(benchmark::State& state) {
+    World world(2);
+    std::deque<MapSnapshot> snapshots;
+    const auto start = Clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        world.Step();
+        MapSnapshot snapshot;
+        snapshot.timestamp = start + kFrame * frame;
+        for (size_t i = 0; i < kEntities; ++i) {
+            const auto& p = world.positions[i];
+            snapshot.states[i + 1] = {p, {}, {p.x - 0.4f, p.y - 0.4f, p.z - 0.9f}, {p.x + 0.4f, p.y + 0.4f, p.z + 0.9f},
+                                      true};
+        }
+        snapshots.push_back(std::move(snapshot));
+    }
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<size_t> shooter(0, kEntities - 1);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::uniform_int_distribution<int> back(0, kFrames - 2);
+    for (auto _ : state) {
+        const size_t from = shooter(rng);
+        const float heading = angle(rng);
+        const auto time = start + kFrame * back(rng) + kFrame / 3;
+        const Vector3 origin = world.positions[from];
+        const float dx = std::cos(heading), dy = std::sin(heading);
+
+        const MapSnapshot* before = nullptr;
+        const MapSnapshot* after = nullptr;
+        for (size_t i = 0; i + 1 < snapshots.size(); ++i) {
+            if (snapshots[i].timestamp <= time && snapshots[i + 1].timestamp > time) {
+                before = &snapshots[i];
+                after = &snapshots[i + 1];
+                break;
+            }
+        }
+        const float t = std::chrono::duration<float>(time - before->timestamp).count() /
+                        std::chrono::duration<float>(after->timestamp - before->timestamp).count();
+        MapSnapshot interpolated;
+        for (const auto& [id, s] : before->states) {
+            auto it = after->states.find(id);
+            auto blended = s;
+            if (it != after->states.end()) {
+                blended.lo = {s.lo.x + (it->second.lo.x - s.lo.x) * t, s.lo.y + (it->second.lo.y - s.lo.y) * t,
+                              s.lo.z};
+                blended.hi = {s.hi.x + (it->second.hi.x - s.hi.x) * t, s.hi.y + (it->second.hi.y - s.hi.y) * t,
+                              s.hi.z};
+            }
+            interpolated.states[id] = blended;
+        }
+
+        float best = 100.0f;
+        uint64_t best_id = 0;
+        for (const auto& [id, s] : interpolated.states) {
+            if (id == from + 1) continue;
+            float near = 0.0f, far = best;
+            const float o[2] = {origin.x, origin.y}, d[2] = {dx, dy};
+            const float l[2] = {s.lo.x, s.lo.y}, h[2] = {s.hi.x, s.hi.y};
+            bool hit = true;
+            for (int axis = 0; axis < 2 && hit; ++axis) {
+                float t0 = (l[axis] - o[axis]) / d[axis], t1 = (h[axis] - o[axis]) / d[axis];
+                if (t0 > t1) std::swap(t0, t1);
+                near = std::max(near, t0);
+                far = std::min(far, t1);
+                hit = near <= far;
+            }
+            if (hit) {
+                best = near;
+                best_id = id;
+            }
+        }
+        benchmark::DoNotOptimize(best_id);
+    }
+}
+BENCHMARK(BM_MapSnapshotRaycast)->Unit(benchmark::kMicrosecond);
+
+namespace {
+
+constexpr size_t kClaims = 1000;
+
+// 5000 entities over a full history, and 1000 shots from random players at a neighbour 5-30 m away, each from a
+// client 20-200 ms behind, with the aim a little off so some miss.
+struct HitClaimScenario {
+    HitClaimScenario() : world(5) {
+        const auto start = Clock::now();
+        for (int frame = 0; frame < kFrames; ++frame) {
+            world.Step();
+            history.BeginFrame(start + kFrame * frame);
+            for (size_t i = 0; i < kEntities; ++i) {
+                history.Record(i + 1, world.positions[i], {}, kHalfExtents, true);
+            }
+        }
+        const auto newest = *history.GetNewestTime();
+
+        std::mt19937 rng(6);
+        std::uniform_int_distribution<size_t> shooter(0, kEntities - 1);
+        std::uniform_int_distribution<int> latency_ms(20, 200);
+        std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> jitter(-0.03f, 0.03f);
+        claims.resize(kClaims);
+        for (size_t i = 0; i < kClaims; ++i) {
+            const size_t from = shooter(rng);
+            const auto& origin = world.positions[from];
+            const Vector3 aim{origin.x + 15.0f * offset(rng), origin.y + 15.0f * offset(rng), 0.0f};
+            claims[i].claim_id = i + 1;
+            claims[i].attacker_id = from + 1;
+            claims[i].origin = origin;
+            claims[i].direction = {aim.x - origin.x + jitter(rng), aim.y - origin.y + jitter(rng), 0.0f};
+            claims[i].max_range = 100.0f;
+            claims[i].rewind_time = newest - std::chrono::milliseconds(latency_ms(rng));
+        }
+    }
+
+    World world;
+    RewindHistory history;
+    std::vector<HitClaim> claims;
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-226] 1000 claims validated one RaycastAt at a time, the way HitRegistration did it.
+static void BM_HitClaimsOneByOne(benchmark::State& state) {
+    HitClaimScenario scenario;
+    size_t valid = 0;
+    for (auto _ : state) {
+        for (const auto& claim : scenario.claims) {
+            auto hit = scenario.history.RaycastAt(claim.rewind_time, claim.origin, claim.direction, claim.max_range,
+                                                  claim.attacker_id);
+            valid += hit.has_value();
+        }
+    }
+    state.counters["valid_per_batch"] = static_cast<double>(valid) / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kClaims));
+}
+BENCHMARK(BM_HitClaimsOneByOne)->Unit(benchmark::kMicrosecond);
+
+// [SEQUENCE: MVP19-227] The same 1000 claims through the pipeline with 0, 1 and 3 extra workers, with the
+// per-stage wall times it exports.
+static void BM_HitClaimBatch(benchmark::State& state) {
+    HitClaimScenario scenario;
+    HitValidationConfig config;
+    config.worker_count = static_cast<size_t>(state.range(0));
+    HitValidationPipeline pipeline(scenario.history, config);
+    std::vector<HitVerdict> verdicts;
+    for (auto _ : state) {
+        for (const auto& claim : scenario.claims) pipeline.Submit(claim);
+        pipeline.ValidatePending(verdicts);
+    }
+    const auto& stats = pipeline.GetStats();
+    const double batches = static_cast<double>(stats.batches);
+    state.counters["group_us"] = stats.total.group_us / batches;
+    state.counters["rewind_us"] = stats.total.rewind_us / batches;
+    state.counters["narrow_us"] = stats.total.narrow_us / batches;
+    state.counters["groups_per_batch"] = static_cast<double>(stats.groups) / batches;
+    state.counters["rewound_per_batch"] = static_cast<double>(stats.entities_rewound) / batches;
+    state.counters["valid_per_batch"] = static_cast<double>(stats.valid) / batches;
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kClaims));
+}
+BENCHMARK(BM_HitClaimBatch)->Arg(0)->Arg(1)->Arg(3)->Unit(benchmark::kMicrosecond)->UseRealTime();
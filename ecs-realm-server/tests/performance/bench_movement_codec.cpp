@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include "network/movement_codec.h"
+#include "proto/game.pb.h"
+
+#include <random>
+#include <vector>
+
+using namespace mmorpg::network;
+
+namespace {
+
+// A crowd in a 2 km square, ids in update-list order, three quarters of it moving.
+MovementBatch MakeCrowd(size_t count) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> ground(0.0f, 2000.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    MovementBatch batch;
+    batch.Resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        batch.entity_ids[i] = 10000 + i * 3;
+        batch.sequences[i] = 5000 + static_cast<uint32_t>(i % 17);
+        batch.x[i] = ground(rng);
+        batch.y[i] = ground(rng);
+        batch.z[i] = 40.0f + unit(rng) * 5.0f;
+        batch.yaw[i] = unit(rng) * 3.14159f;
+        if (i % 4 != 0) {
+            batch.vx[i] = unit(rng) * 6.0f;
+            batch.vy[i] = unit(rng) * 6.0f;
+        }
+    }
+    return batch;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-181] What movement costs today: one MovementUpdate per entity with Vector3 floats and a float
+// timestamp, serialized as an EntityUpdateBatch.
+static void BM_MovementEncode_Proto(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto crowd = MakeCrowd(count);
+    mmorpg::proto::EntityUpdateBatch batch;
+    for (size_t i = 0; i < count; ++i) {
+        auto* movement = batch.add_updates()->mutable_movement();
+        movement->set_entity_id(crowd.entity_ids[i]);
+        movement->set_sequence_number(crowd.sequences[i]);
+        movement->set_timestamp(1234.5f);
+        movement->mutable_position()->set_x(crowd.x[i]);
+        movement->mutable_position()->set_y(crowd.y[i]);
+        movement->mutable_position()->set_z(crowd.z[i]);
+        movement->mutable_rotation()->set_z(crowd.yaw[i]);
+        movement->mutable_velocity()->set_x(crowd.vx[i]);
+        movement->mutable_velocity()->set_y(crowd.vy[i]);
+    }
+    std::string out;
+    for (auto _ : state) {
+        out.clear();
+        batch.SerializeToString(&out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["bytes_per_entity"] = static_cast<double>(out.size()) / static_cast<double>(count);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_MovementEncode_Proto)->Arg(500)->Arg(5000);
+
+// [SEQUENCE: MVP19-182] MovementCodec on the same crowd, encode and decode.
+static void BM_MovementEncode_Codec(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto crowd = MakeCrowd(count);
+    MovementCodec codec;
+    std::vector<std::byte> out;
+    for (auto _ : state) {
+        codec.Encode(crowd, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["bytes_per_entity"] = static_cast<double>(out.size()) / static_cast<double>(count);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_MovementEncode_Codec)->Arg(500)->Arg(5000);
+
+static void BM_MovementDecode_Codec(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    MovementCodec codec;
+    std::vector<std::byte> packet;
+    codec.Encode(MakeCrowd(count), packet);
+    MovementBatch decoded;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(codec.Decode(packet.data(), packet.size(), decoded));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_MovementDecode_Codec)->Arg(500)->Arg(5000);
@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+
+#include "game/world/octree/loose_octree.h"
+#include "game/world/octree/octree_world.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mmorpg::game::world;
+using mmorpg::core::ecs::EntityId;
+using mmorpg::core::utils::Vector3;
+
+namespace {
+
+// The test_spatial_octree scenario: a 4 km x 4 km x 1 km world, 300 m spheres and 400 x 400 x 200 m boxes,
+// a fifth of the entities moving up to 50 m (25 m vertically) per update
+constexpr float kHalfWidth = 2000.0f;
+constexpr float kHalfHeight = 500.0f;
+
+enum class Backend { OctreeWorld, LooseOctree };
+
+std::unique_ptr<ISpatialIndex> MakeIndex(Backend backend) {
+    const Vector3 world_min{-kHalfWidth, -kHalfWidth, -kHalfHeight};
+    const Vector3 world_max{kHalfWidth, kHalfWidth, kHalfHeight};
+    if (backend == Backend::OctreeWorld) {
+        octree::OctreeWorld::Config config;
+        config.world_min = world_min;
+        config.world_max = world_max;
+        return std::make_unique<octree::OctreeWorld>(config);
+    }
+    octree::LooseOctree::Config config;
+    config.world_min = world_min;
+    config.world_max = world_max;
+    return std::make_unique<octree::LooseOctree>(config);
+}
+
+std::vector<Vector3> Populate(ISpatialIndex& index, size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> xy(-kHalfWidth, kHalfWidth);
+    std::uniform_real_distribution<float> z(-kHalfHeight, kHalfHeight);
+    std::vector<Vector3> positions(count);
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = {xy(rng), xy(rng), z(rng)};
+        index.AddEntity(static_cast<EntityId>(i + 1), positions[i]);
+    }
+    return positions;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-357] Update throughput: each iteration moves every fifth entity, a different fifth each time
+static void BM_OctreeUpdate(benchmark::State& state, Backend backend) {
+    const auto count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(1);
+    auto index = MakeIndex(backend);
+    auto positions = Populate(*index, count, rng);
+    std::uniform_real_distribution<float> step(-50.0f, 50.0f);
+    std::vector<Vector3> steps(4096);
+    for (auto& s : steps) s = {step(rng), step(rng), step(rng) * 0.5f};
+
+    size_t phase = 0;
+    size_t moved = 0;
+    for (auto _ : state) {
+        for (size_t i = phase; i < count; i += 5) {
+            const Vector3& s = steps[(i + moved) % steps.size()];
+            const Vector3 next{std::clamp(positions[i].x + s.x, -kHalfWidth, kHalfWidth),
+                               std::clamp(positions[i].y + s.y, -kHalfWidth, kHalfWidth),
+                               std::clamp(positions[i].z + s.z, -kHalfHeight, kHalfHeight)};
+            index->UpdateEntity(static_cast<EntityId>(i + 1), positions[i], next);
+            positions[i] = next;
+            ++moved;
+        }
+        phase = (phase + 1) % 5;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(moved));
+}
+BENCHMARK_CAPTURE(BM_OctreeUpdate, octree_world, Backend::OctreeWorld)->Arg(1000)->Arg(10000)->Arg(50000);
+BENCHMARK_CAPTURE(BM_OctreeUpdate, loose_octree, Backend::LooseOctree)->Arg(1000)->Arg(10000)->Arg(50000);
+
+// [SEQUENCE: MVP19-358] Query throughput: alternating sphere and box queries at random points
+static void BM_OctreeQuery(benchmark::State& state, Backend backend) {
+    const auto count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(2);
+    auto index = MakeIndex(backend);
+    Populate(*index, count, rng);
+    std::uniform_real_distribution<float> xy(-kHalfWidth, kHalfWidth);
+    std::uniform_real_distribution<float> z(-kHalfHeight, kHalfHeight);
+    std::vector<Vector3> centers(4096);
+    for (auto& c : centers) c = {xy(rng), xy(rng), z(rng)};
+
+    bool sphere = true;
+    size_t found = 0;
+    size_t next = 0;
+    for (auto _ : state) {
+        const Vector3& c = centers[next++ % centers.size()];
+        auto results = sphere ? index->GetEntitiesInRadius(c, 300.0f)
+                              : index->GetEntitiesInBox({c.x - 200, c.y - 200, c.z - 100}, {c.x + 200, c.y + 200, c.z + 100});
+        found += results.size();
+        benchmark::DoNotOptimize(results.data());
+        sphere = !sphere;
+    }
+    state.counters["found_per_query"] = static_cast<double>(found) / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_OctreeQuery, octree_world, Backend::OctreeWorld)->Arg(1000)->Arg(10000)->Arg(50000);
+BENCHMARK_CAPTURE(BM_OctreeQuery, loose_octree, Backend::LooseOctree)->Arg(1000)->Arg(10000)->Arg(50000);
+
+// [SEQUENCE: MVP19-359] Ray and cone queries, which OctreeWorld does not implement
+static void BM_LooseOctreeRayAndFrustum(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(3);
+    octree::LooseOctree::Config config;
+    config.world_min = {-kHalfWidth, -kHalfWidth, -kHalfHeight};
+    config.world_max = {kHalfWidth, kHalfWidth, kHalfHeight};
+    config.entity_radius = 2.0f;
+    octree::LooseOctree tree(config);
+    Populate(tree, count, rng);
+    std::uniform_real_distribution<float> xy(-kHalfWidth, kHalfWidth);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    for (auto _ : state) {
+        const Vector3 origin{xy(rng), xy(rng), 0.0f};
+        const Vector3 direction{unit(rng), unit(rng), 0.1f * unit(rng)};
+        auto hits = tree.GetEntitiesAlongRay(origin, direction, 500.0f);
+        auto visible = tree.GetEntitiesInFrustum(origin, direction, 1.2f, 1.0f, 300.0f);
+        benchmark::DoNotOptimize(hits.data());
+        benchmark::DoNotOptimize(visible.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_LooseOctreeRayAndFrustum)->Arg(10000)->Arg(50000);
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include "network/packet_dispatch.h"
+#include "network/packet_handler.h"
+#include "network/packet_serializer.h"
+#include "proto/game.pb.h"
+#include "proto/packet.pb.h"
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mmorpg::network;
+
+namespace {
+
+// [SEQUENCE: MVP19-17] Builds a framed MovementUpdate body exactly as Session::DoReadBody sees it (without the length prefix).
+std::vector<std::byte> MakeMovementBody() {
+    mmorpg::proto::MovementUpdate movement;
+    movement.set_entity_id(424242);
+    movement.mutable_position()->set_x(1024.5f);
+    movement.mutable_position()->set_y(12.0f);
+    movement.mutable_position()->set_z(-731.25f);
+    movement.mutable_velocity()->set_x(3.5f);
+    movement.mutable_velocity()->set_z(-1.0f);
+    movement.mutable_rotation()->set_y(1.57f);
+    movement.set_timestamp(12345.678f);
+    movement.set_sequence_number(77);
+
+    auto framed = PacketSerializer::Serialize(movement);
+    return std::vector<std::byte>(framed.begin() + 4, framed.end());
+}
+
+// The pre-MVP19 receive path: full Packet parse, name lookup in the descriptor pool, a fresh heap message
+// and a second parse out of the copied payload string.
+std::string LegacyTypeName(mmorpg::proto::PacketType type) {
+    switch (type) {
+        case mmorpg::proto::PACKET_MOVEMENT_UPDATE:
+            return "mmorpg.proto.MovementUpdate";
+        case mmorpg::proto::PACKET_COMBAT_ACTION:
+            return "mmorpg.proto.CombatAction";
+        default:
+            return "";
+    }
+}
+
+void LegacyProcessPacket(const std::vector<std::byte>& data, PacketHandler& handler) {
+    auto packet = PacketSerializer::Deserialize(data.data(), data.size());
+    if (!packet) return;
+
+    std::string type_name = LegacyTypeName(packet->header().type());
+    const auto* descriptor = google::protobuf::DescriptorPool::generated_pool()->FindMessageTypeByName(type_name);
+    if (!descriptor) return;
+
+    auto message = std::shared_ptr<google::protobuf::Message>(
+        google::protobuf::MessageFactory::generated_factory()->GetPrototype(descriptor)->New());
+    if (!message->ParseFromString(packet->payload())) return;
+
+    handler.Handle(nullptr, *message);
+}
+
+std::shared_ptr<PacketHandler> MakeHandler(uint64_t& sink) {
+    auto handler = std::make_shared<PacketHandler>();
+    handler->RegisterHandler<mmorpg::proto::MovementUpdate>(
+        [&sink](std::shared_ptr<Session>, const mmorpg::proto::MovementUpdate& movement) {
+            sink += movement.sequence_number();
+        });
+    return handler;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-18] Baseline: the descriptor-name dispatch that Session::ProcessPacket used before.
+static void BM_PacketDispatch_Legacy(benchmark::State& state) {
+    const auto body = MakeMovementBody();
+    uint64_t sink = 0;
+    auto handler = MakeHandler(sink);
+
+    for (auto _ : state) {
+        LegacyProcessPacket(body, *handler);
+    }
+    benchmark::DoNotOptimize(sink);
+    state.SetItemsProcessed(state.iterations());
+    state.counters["packets_per_sec"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_PacketDispatch_Legacy);
+
+// [SEQUENCE: MVP19-19] Dense-table dispatch with in-place envelope parsing and a reused per-session message.
+static void BM_PacketDispatch_DenseTable(benchmark::State& state) {
+    const auto body = MakeMovementBody();
+    uint64_t sink = 0;
+    auto handler = MakeHandler(sink);
+    PacketMessageCache cache;
+    const std::shared_ptr<Session> no_session;
+
+    for (auto _ : state) {
+        PacketSerializer::PacketEnvelope envelope;
+        if (PacketSerializer::ParseEnvelope(body.data(), body.size(), envelope)) {
+            handler->Dispatch(no_session, envelope.type, envelope.payload, envelope.payload_size, cache);
+        }
+    }
+    benchmark::DoNotOptimize(sink);
+    state.SetItemsProcessed(state.iterations());
+    state.counters["packets_per_sec"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_PacketDispatch_DenseTable);
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include "network/quic_connection.h"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace mmorpg::network;
+using Clock = QuicConnection::Clock;
+using Endpoint = QuicConnection::Endpoint;
+
+namespace {
+
+// Both ends of one connection, with datagrams passed straight across so only protocol CPU is measured
+class HandshakeRun {
+public:
+    HandshakeRun(QuicServerContext& context, Clock::time_point now, const QuicResumption* resumption)
+        : m_context(context), m_now(now) {
+        m_client = std::make_unique<QuicConnection>(QuicConfig{}, context.GetStaticKey().public_key, m_serverEndpoint,
+                                                    now, resumption);
+    }
+
+    // Runs until both ends are established. A resumed client sends a login-sized request as 0-RTT data.
+    bool Complete(bool send_early_request) {
+        if (send_early_request) {
+            const std::vector<std::byte> request(96, std::byte{0x5A});
+            m_client->SendStream(0, request.data(), request.size());
+        }
+        for (int round = 0; round < 8; ++round) {
+            if (m_server && m_server->GetState() == QuicConnectionState::Established &&
+                m_client->GetState() == QuicConnectionState::Established) {
+                return true;
+            }
+            m_client->Flush(m_now, [&](const Endpoint&, const std::byte* data, size_t size) {
+                if (!m_server) {
+                    uint64_t destination = 0;
+                    bool is_initial = false;
+                    quic_wire::PeekDestination(data, size, destination, is_initial);
+                    m_server = std::make_unique<QuicConnection>(QuicConfig{}, m_context, m_clientEndpoint,
+                                                                destination, m_now);
+                }
+                m_server->OnDatagram(data, size, m_clientEndpoint, m_now, [](const QuicEvent&) {});
+            });
+            if (!m_server) return false;
+            m_server->Flush(m_now, [&](const Endpoint&, const std::byte* data, size_t size) {
+                m_client->OnDatagram(data, size, m_serverEndpoint, m_now, [](const QuicEvent&) {});
+            });
+        }
+        return false;
+    }
+
+    // The ticket the next reconnect will use, issued the way the handler does after login or resumption
+    std::optional<QuicResumption> NextTicket() {
+        m_server->IssueTicket(7, m_now);
+        m_server->Flush(m_now, [&](const Endpoint&, const std::byte* data, size_t size) {
+            m_client->OnDatagram(data, size, m_serverEndpoint, m_now, [](const QuicEvent&) {});
+        });
+        return m_client->GetResumption();
+    }
+
+private:
+    QuicServerContext& m_context;
+    Clock::time_point m_now;
+    Endpoint m_serverEndpoint{boost::asio::ip::make_address("10.0.0.1"), 8082};
+    Endpoint m_clientEndpoint{boost::asio::ip::make_address("192.168.1.20"), 50000};
+    std::unique_ptr<QuicConnection> m_client;
+    std::unique_ptr<QuicConnection> m_server;
+};
+
+QuicKeyPair MakeServerKey() {
+    QuicKeyPair key;
+    quic_crypto::GenerateKeyPair(key);
+    return key;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-283] CPU for a fresh connection, both ends: three X25519 operations per side, key
+// schedule, and the Initial/1-RTT packet exchange up to handshake confirmation.
+static void BM_QuicFullHandshake(benchmark::State& state) {
+    QuicServerContext context(MakeServerKey());
+    auto now = Clock::now();
+    for (auto _ : state) {
+        HandshakeRun run(context, now, nullptr);
+        if (!run.Complete(false)) state.SkipWithError("handshake did not complete");
+        now += std::chrono::milliseconds(1);
+    }
+}
+BENCHMARK(BM_QuicFullHandshake)->Unit(benchmark::kMicrosecond);
+
+// [SEQUENCE: MVP19-284] A mobile reconnect: ticket redemption, the PSK-bound handshake, the first request
+// carried as 0-RTT data, and the replacement ticket. Each ticket is single use, so every iteration spends the
+// one issued by the iteration before it.
+static void BM_QuicZeroRttResume(benchmark::State& state) {
+    QuicServerContext context(MakeServerKey());
+    auto now = Clock::now();
+    std::optional<QuicResumption> ticket;
+    {
+        HandshakeRun first(context, now, nullptr);
+        first.Complete(false);
+        ticket = first.NextTicket();
+    }
+    for (auto _ : state) {
+        if (!ticket) {
+            state.SkipWithError("no resumption ticket");
+            break;
+        }
+        now += std::chrono::milliseconds(1);
+        HandshakeRun run(context, now, &*ticket);
+        if (!run.Complete(true)) state.SkipWithError("resumption did not complete");
+        ticket = run.NextTicket();
+    }
+}
+BENCHMARK(BM_QuicZeroRttResume)->Unit(benchmark::kMicrosecond);
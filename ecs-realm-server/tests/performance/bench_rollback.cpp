@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include "game/systems/pvp/arena_rollback_world.h"
+#include "network/rollback_session.h"
+
+using namespace mmorpg::network;
+using mmorpg::game::systems::pvp::ArenaRollbackWorld;
+
+namespace {
+
+// Cheap stand-in for real input: a hash of (player, frame / 12), so input generation stays out of the timings
+TickInput ArenaInput(size_t player, uint32_t frame, uint32_t salt = 0) {
+    uint64_t x = (player * 100003 + frame / 12 + salt) * 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 31)) * 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 29;
+    auto unit = [&x](int shift) { return static_cast<float>((x >> shift) & 0xFFFF) / 32767.5f - 1.0f; };
+    TickInput input;
+    input.move_x = 0.2f * unit(0);
+    input.move_z = unit(16);
+    input.yaw = (player < 3 ? 1.5707964f : -1.5707964f) + 0.15f * unit(32);
+    if ((x >> 48) % 3 == 0) input.flags |= TickInput::kPrimary;
+    if ((x >> 52) % 5 == 0) input.flags |= TickInput::kSprint;
+    return input;
+}
+
+// Fills the history with a second of on-time play so projectiles are flying
+void WarmUp(ArenaRollbackWorld& world) {
+    auto& session = world.Session();
+    for (uint32_t frame = 0; frame < 60; ++frame) {
+        for (size_t player = 0; player < ArenaRollbackWorld::kPlayers; ++player) {
+            session.AddInput(player, frame, ArenaInput(player, frame));
+        }
+        session.AdvanceFrame();
+    }
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-257] 3v3 arena tick with every input on time: no rollback, only the frame's dirty pages saved.
+static void BM_ArenaTickOnTime(benchmark::State& state) {
+    ArenaRollbackWorld world;
+    WarmUp(world);
+    auto& session = world.Session();
+    for (auto _ : state) {
+        const uint32_t frame = session.GetCurrentFrame();
+        for (size_t player = 0; player < ArenaRollbackWorld::kPlayers; ++player) {
+            session.AddInput(player, frame, ArenaInput(player, frame));
+        }
+        session.AdvanceFrame();
+    }
+    state.counters["pages/frame"] = static_cast<double>(session.GetStats().pages_saved) /
+                                    static_cast<double>(session.GetStats().frames);
+}
+BENCHMARK(BM_ArenaTickOnTime)->Unit(benchmark::kMicrosecond);
+
+// [SEQUENCE: MVP19-258] Worst case at the budget: every tick one player's input lands 8 frames late and
+// contradicts the prediction, so each tick restores 8 frames and simulates 9.
+static void BM_ArenaTickRollback8(benchmark::State& state) {
+    ArenaRollbackWorld world;
+    WarmUp(world);
+    auto& session = world.Session();
+    for (auto _ : state) {
+        const uint32_t frame = session.GetCurrentFrame();
+        for (size_t player = 0; player + 1 < ArenaRollbackWorld::kPlayers; ++player) {
+            session.AddInput(player, frame, ArenaInput(player, frame));
+        }
+        session.AddInput(5, frame - 8, ArenaInput(5, frame - 8, frame));
+        session.AdvanceFrame();
+    }
+    const auto& stats = session.GetStats();
+    state.counters["resim/tick"] = static_cast<double>(stats.frames_resimulated) / static_cast<double>(stats.rollbacks);
+    state.counters["state_bytes"] = static_cast<double>(sizeof(mmorpg::game::systems::pvp::ArenaPlayer) *
+                                                            ArenaRollbackWorld::kPlayers +
+                                                        sizeof(mmorpg::game::systems::pvp::ArenaProjectile) *
+                                                            ArenaRollbackWorld::kMaxProjectiles);
+    state.counters["history_bytes"] = static_cast<double>(session.GetMemoryFootprint());
+}
+BENCHMARK(BM_ArenaTickRollback8)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include "network/session_manager.h"
+#include "network/session.h"
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace mmorpg::network;
+
+namespace {
+
+struct SessionFixture {
+    explicit SessionFixture(size_t count) {
+        for (uint32_t id = 1; id <= count; ++id) {
+            auto session = std::make_shared<Session>(boost::asio::ip::tcp::socket(io_context), ssl_context, id, nullptr);
+            manager.Register(session);
+            manager.SetPlayerIdForSession(id, 1000000 + id);
+            sessions.push_back(std::move(session));
+        }
+    }
+
+    boost::asio::io_context io_context;
+    boost::asio::ssl::context ssl_context{boost::asio::ssl::context::tls_server};
+    SessionManager manager;
+    std::vector<std::shared_ptr<Session>> sessions;
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-115] Player -> session lookup cost against session count. Should stay flat.
+static void BM_GetSessionByPlayerId(benchmark::State& state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    SessionFixture fixture(count);
+
+    uint32_t id = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fixture.manager.GetSessionByPlayerId(1000000 + id));
+        id = id % count + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetSessionByPlayerId)->Arg(1000)->Arg(20000);
+
+// [SEQUENCE: MVP19-116] The same lookups while a second thread runs a login/logout storm.
+static void BM_GetSessionByPlayerIdDuringLoginStorm(benchmark::State& state) {
+    constexpr uint32_t kSessions = 20000;
+    SessionFixture fixture(kSessions);
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> logins{0};
+    std::thread storm([&] {
+        uint32_t id = kSessions + 1;
+        while (!stop.load(std::memory_order_relaxed)) {
+            auto session = std::make_shared<Session>(boost::asio::ip::tcp::socket(fixture.io_context), fixture.ssl_context, id, nullptr);
+            fixture.manager.Register(session);
+            fixture.manager.SetPlayerIdForSession(id, 1000000 + id);
+            fixture.manager.Unregister(id);
+            logins.fetch_add(1, std::memory_order_relaxed);
+            id = id < kSessions + 50000 ? id + 1 : kSessions + 1;
+        }
+    });
+
+    uint32_t id = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fixture.manager.GetSessionByPlayerId(1000000 + id));
+        id = id % kSessions + 1;
+    }
+    stop = true;
+    storm.join();
+
+    const auto stats = fixture.manager.GetStats();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["logins"] = static_cast<double>(logins.load());
+    state.counters["write_contentions"] = static_cast<double>(stats.write_contentions);
+}
+BENCHMARK(BM_GetSessionByPlayerIdDuringLoginStorm)->UseRealTime();
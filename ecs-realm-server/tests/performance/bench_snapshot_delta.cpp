@@ -0,0 +1,192 @@
+#include <benchmark/benchmark.h>
+
+#include "network/snapshot_delta.h"
+#include "proto/game.pb.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace mmorpg::network;
+
+namespace {
+
+constexpr uint32_t kReplayTicks = 300;   // 10 s at 30 Hz
+constexpr float kTickSeconds = 1.0f / 30.0f;
+constexpr float kViewRadius = 50.0f;
+constexpr uint32_t kAckDelayTicks = 3;   // ~100 ms RTT
+constexpr double kAckLossRate = 0.05;
+
+// [SEQUENCE: MVP19-170] A replayable crowd: a seeded population in a 200 m square where most players stand
+// around, some walk and turn, and a few take damage each tick. The first `clients` entities are players with a
+// connection; each sees everything within kViewRadius. The same seed always replays the same ticks, so the
+// encoders below are compared on identical input.
+class CrowdScenario {
+public:
+    CrowdScenario(uint32_t seed, size_t entities, size_t clients) : m_rng(seed), m_clients(clients) {
+        std::uniform_real_distribution<float> coord(0.0f, 200.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        m_entities.resize(entities);
+        for (size_t i = 0; i < entities; ++i) {
+            auto& e = m_entities[i];
+            e.id = 1000 + i * 7;
+            e.x = coord(m_rng);
+            e.z = coord(m_rng);
+            e.yaw = unit(m_rng) * 6.2832f;
+            e.walking = unit(m_rng) < 0.3f;
+            e.hp = 1000.0f;
+        }
+    }
+
+    void Step() {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        for (auto& e : m_entities) {
+            if (unit(m_rng) < 0.01f) e.walking = !e.walking;
+            if (e.walking) {
+                if (unit(m_rng) < 0.05f) e.yaw += (unit(m_rng) - 0.5f) * 1.5f;
+                e.x = std::clamp(e.x + std::cos(e.yaw) * 5.0f * kTickSeconds, 0.0f, 200.0f);
+                e.z = std::clamp(e.z + std::sin(e.yaw) * 5.0f * kTickSeconds, 0.0f, 200.0f);
+            }
+            if (unit(m_rng) < 0.02f) e.hp = std::max(0.0f, e.hp - unit(m_rng) * 50.0f);
+        }
+    }
+
+    void Snapshot(size_t client, uint32_t tick, SyncSnapshot& out) const {
+        const auto& self = m_entities[client];
+        out.tick = tick;
+        out.entities.clear();
+        for (const auto& e : m_entities) {
+            const float dx = e.x - self.x;
+            const float dz = e.z - self.z;
+            if (dx * dx + dz * dz <= kViewRadius * kViewRadius) {
+                out.entities.push_back(ToState(e));
+            }
+        }
+        out.SortById();   // Already in id order; kept for parity with the server path
+    }
+
+    size_t ClientCount() const { return m_clients; }
+
+private:
+    struct Entity {
+        uint64_t id;
+        float x, z, yaw;
+        bool walking;
+        float hp;
+    };
+
+    static EntitySyncState ToState(const Entity& e) {
+        EntitySyncState state;
+        state.entity_id = e.id;
+        state.Set(SyncField::PositionX, e.x);
+        state.Set(SyncField::PositionY, 12.0f);
+        state.Set(SyncField::PositionZ, e.z);
+        state.Set(SyncField::RotationY, e.yaw);
+        if (e.walking) {
+            state.Set(SyncField::VelocityX, std::cos(e.yaw) * 5.0f);
+            state.Set(SyncField::VelocityZ, std::sin(e.yaw) * 5.0f);
+        }
+        state.Set(SyncField::Health, e.hp);
+        state.Set(SyncField::MaxHealth, 1000.0f);
+        return state;
+    }
+
+    std::mt19937 m_rng;
+    size_t m_clients;
+    std::vector<Entity> m_entities;
+};
+
+void FillProtoUpdate(const EntitySyncState& state, mmorpg::proto::EntityUpdate& update) {
+    update.set_entity_id(state.entity_id);
+    auto* movement = update.mutable_movement();
+    movement->set_entity_id(state.entity_id);
+    movement->set_timestamp(1234567);
+    movement->mutable_position()->set_x(state.Get(SyncField::PositionX));
+    movement->mutable_position()->set_y(state.Get(SyncField::PositionY));
+    movement->mutable_position()->set_z(state.Get(SyncField::PositionZ));
+    movement->mutable_rotation()->set_y(state.Get(SyncField::RotationY));
+    movement->mutable_velocity()->set_x(state.Get(SyncField::VelocityX));
+    movement->mutable_velocity()->set_z(state.Get(SyncField::VelocityZ));
+}
+
+void ReportBytes(benchmark::State& state, uint64_t bytes, size_t clients) {
+    const double client_ticks = static_cast<double>(state.iterations()) * kReplayTicks * clients;
+    state.counters["bytes_per_client_tick"] = static_cast<double>(bytes) / client_ticks;
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-171] The dirty-flag path: an EntityUpdate with full floats for every visible entity whose state
+// changed since the previous tick, batched per client.
+static void BM_CrowdSync_ProtoDirty(benchmark::State& state) {
+    const auto entities = static_cast<size_t>(state.range(0));
+    const auto clients = static_cast<size_t>(state.range(1));
+    uint64_t bytes = 0;
+
+    for (auto _ : state) {
+        CrowdScenario crowd(42, entities, clients);
+        std::vector<std::unordered_map<uint64_t, EntitySyncState>> last_seen(clients);
+        SyncSnapshot snapshot;
+        for (uint32_t tick = 1; tick <= kReplayTicks; ++tick) {
+            state.PauseTiming();
+            crowd.Step();
+            state.ResumeTiming();
+            for (size_t c = 0; c < clients; ++c) {
+                crowd.Snapshot(c, tick, snapshot);
+                mmorpg::proto::EntityUpdateBatch batch;
+                batch.set_tick(tick);
+                for (const auto& entity : snapshot.entities) {
+                    auto [it, inserted] = last_seen[c].try_emplace(entity.entity_id, entity);
+                    if (inserted || it->second.fields != entity.fields) {
+                        it->second = entity;
+                        FillProtoUpdate(entity, *batch.add_updates());
+                    }
+                }
+                bytes += batch.ByteSizeLong();
+            }
+        }
+    }
+    ReportBytes(state, bytes, clients);
+}
+BENCHMARK(BM_CrowdSync_ProtoDirty)->Args({500, 50})->Args({2000, 100})->Unit(benchmark::kMillisecond);
+
+// [SEQUENCE: MVP19-172] Per-client baseline deltas with acks arriving kAckDelayTicks late and kAckLossRate of
+// them lost, so some snapshots are encoded against older baselines.
+static void BM_CrowdSync_BaselineDelta(benchmark::State& state) {
+    const auto entities = static_cast<size_t>(state.range(0));
+    const auto clients = static_cast<size_t>(state.range(1));
+    uint64_t bytes = 0;
+    uint64_t full_snapshots = 0;
+
+    for (auto _ : state) {
+        CrowdScenario crowd(42, entities, clients);
+        std::mt19937 loss_rng(7);
+        std::bernoulli_distribution lost(kAckLossRate);
+        std::vector<ClientBaselineTracker> trackers(clients);
+        std::vector<std::byte> packet;
+        SyncSnapshot snapshot;
+        for (uint32_t tick = 1; tick <= kReplayTicks; ++tick) {
+            state.PauseTiming();
+            crowd.Step();
+            state.ResumeTiming();
+            for (size_t c = 0; c < clients; ++c) {
+                if (tick > kAckDelayTicks && !lost(loss_rng)) {
+                    trackers[c].Acknowledge(tick - kAckDelayTicks);
+                }
+                crowd.Snapshot(c, tick, snapshot);
+                trackers[c].Encode(snapshot, packet);
+                bytes += packet.size();
+            }
+        }
+        for (const auto& tracker : trackers) {
+            full_snapshots += tracker.GetStats().full_snapshots;
+        }
+    }
+    ReportBytes(state, bytes, clients);
+    state.counters["full_snapshots"] = benchmark::Counter(static_cast<double>(full_snapshots),
+                                                          benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_CrowdSync_BaselineDelta)->Args({500, 50})->Args({2000, 100})->Unit(benchmark::kMillisecond);
@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+
+#include "game/world/grid/flat_world_grid.h"
+#include "game/world/grid/world_grid.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mmorpg::game::world;
+using mmorpg::core::ecs::EntityId;
+using mmorpg::core::utils::Vector3;
+
+namespace {
+
+// A 4 km square of 40 m cells, populated uniformly
+constexpr float kWorldSize = 4000.0f;
+constexpr float kCellSize = 40.0f;
+constexpr float kQueryRadius = 50.0f;   // Typical AoI / AoE radius
+constexpr size_t kQueriesPerTick = 1000;
+
+enum class Backend { WorldGrid, FlatWorldGrid };
+
+std::unique_ptr<ISpatialIndex> MakeIndex(Backend backend) {
+    const int cells = static_cast<int>(kWorldSize / kCellSize);
+    if (backend == Backend::WorldGrid) {
+        grid::WorldGrid::Config config;
+        config.cell_size = kCellSize;
+        config.grid_width = cells;
+        config.grid_height = cells;
+        return std::make_unique<grid::WorldGrid>(config);
+    }
+    grid::FlatWorldGrid::Config config;
+    config.cell_size = kCellSize;
+    config.grid_width = cells;
+    config.grid_height = cells;
+    return std::make_unique<grid::FlatWorldGrid>(config);
+}
+
+std::vector<Vector3> Populate(ISpatialIndex& index, size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> coord(0.0f, kWorldSize);
+    std::vector<Vector3> positions(count);
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = {coord(rng), coord(rng), 0.0f};
+        index.AddEntity(static_cast<EntityId>(i + 1), positions[i]);
+    }
+    index.Commit();
+    return positions;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-345] Radius queries around random entities. WorldGrid returns every entity in the touched
+// cells and leaves the distance test to the caller, so its time includes that test for a like-for-like result.
+static void BM_SpatialRadiusQuery(benchmark::State& state, Backend backend) {
+    const auto count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(1);
+    auto index = MakeIndex(backend);
+    const auto positions = Populate(*index, count, rng);
+    std::uniform_int_distribution<size_t> pick(0, count - 1);
+
+    size_t found = 0;
+    for (auto _ : state) {
+        const Vector3& center = positions[pick(rng)];
+        auto candidates = index->GetEntitiesInRadius(center, kQueryRadius);
+        if (backend == Backend::WorldGrid) {
+            size_t within = 0;
+            for (EntityId id : candidates) {
+                const Vector3& p = positions[id - 1];
+                const float dx = p.x - center.x, dy = p.y - center.y;
+                within += dx * dx + dy * dy <= kQueryRadius * kQueryRadius;
+            }
+            found += within;
+        } else {
+            found += candidates.size();
+        }
+        benchmark::DoNotOptimize(candidates.data());
+    }
+    state.counters["found_per_query"] = static_cast<double>(found) / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_SpatialRadiusQuery, world_grid, Backend::WorldGrid)->Arg(10000)->Arg(50000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_SpatialRadiusQuery, flat_world_grid, Backend::FlatWorldGrid)->Arg(10000)->Arg(50000)->Arg(100000);
+
+// [SEQUENCE: MVP19-346] One server tick: every entity moves a little, the index is committed, then a batch of
+// radius queries. The flat grid pays its full rebuild here; WorldGrid pays per-move cell locking.
+static void BM_SpatialTick(benchmark::State& state, Backend backend) {
+    const auto count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(2);
+    auto index = MakeIndex(backend);
+    auto positions = Populate(*index, count, rng);
+    std::uniform_real_distribution<float> step(-0.1f, 0.1f);
+    std::uniform_int_distribution<size_t> pick(0, count - 1);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            const Vector3 next{std::clamp(positions[i].x + step(rng), 0.0f, kWorldSize - 1.0f),
+                               std::clamp(positions[i].y + step(rng), 0.0f, kWorldSize - 1.0f), 0.0f};
+            index->UpdateEntity(static_cast<EntityId>(i + 1), positions[i], next);
+            positions[i] = next;
+        }
+        index->Commit();
+        for (size_t q = 0; q < kQueriesPerTick; ++q) {
+            auto found = index->GetEntitiesInRadius(positions[pick(rng)], kQueryRadius);
+            benchmark::DoNotOptimize(found.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK_CAPTURE(BM_SpatialTick, world_grid, Backend::WorldGrid)
+    ->Arg(10000)->Arg(50000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SpatialTick, flat_world_grid, Backend::FlatWorldGrid)
+    ->Arg(10000)->Arg(50000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// [SEQUENCE: MVP19-368] Perception-style load: every entity queries around itself once per tick. One query at a
+// time against FlatWorldGrid, one vector per query, versus the whole tick as one batch into a reused buffer.
+static void BM_PerEntityQueries(benchmark::State& state, bool batched) {
+    const auto count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(3);
+    auto index = MakeIndex(Backend::FlatWorldGrid);
+    const auto positions = Populate(*index, count, rng);
+    std::vector<RadiusQuery> queries;
+    for (const auto& p : positions) queries.push_back({p, kQueryRadius, kAllLayers});
+
+    SpatialQueryResults results;
+    size_t found = 0;
+    for (auto _ : state) {
+        if (batched) {
+            index->QueryRadiusBatch(queries, results);
+            found += results.ids.size();
+        } else {
+            for (const auto& query : queries) {
+                auto ids = index->GetEntitiesInRadius(query.center, query.radius);
+                found += ids.size();
+                benchmark::DoNotOptimize(ids.data());
+            }
+        }
+    }
+    state.counters["found_per_query"] =
+        static_cast<double>(found) / static_cast<double>(state.iterations() * count);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK_CAPTURE(BM_PerEntityQueries, single, false)
+    ->Arg(10000)->Arg(50000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_PerEntityQueries, batched, true)
+    ->Arg(10000)->Arg(50000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include "game/systems/scheduling/system_scheduler.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace mmorpg::game::systems::scheduling;
+
+namespace {
+
+// Component stand-ins for the access declarations
+struct Transform {};
+struct Velocity {};
+struct Health {};
+struct StatusEffects {};
+struct Grid {};
+
+// A frame shaped like the game's systems and their access declarations. Each system does arithmetic over its
+// own array of `work` floats.
+class Frame {
+public:
+    explicit Frame(size_t work) : data_(5, std::vector<float>(work, 1.0f)) {}
+
+    SystemScheduler::UpdateFunction System(size_t index) {
+        return [this, index](float delta_time) {
+            for (float& value : data_[index]) value = std::sqrt(value * value + delta_time);
+            benchmark::DoNotOptimize(data_[index].data());
+        };
+    }
+
+    void AddTo(SystemScheduler& scheduler) {
+        scheduler.AddSystem("movement", SystemAccess().Writes<Transform, Velocity>(), System(0));
+        scheduler.AddSystem("grid", SystemAccess().Reads<Transform>().Writes<Grid>(), System(1));
+        scheduler.AddSystem("combat", SystemAccess().Reads<Grid>().Writes<Transform, Health>(), System(2));
+        scheduler.AddSystem("regen", SystemAccess().Writes<Health>(), System(3));
+        scheduler.AddSystem("status", SystemAccess().Writes<StatusEffects>(), System(4));
+    }
+
+private:
+    std::vector<std::vector<float>> data_;
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-384] A frame of five systems run one after the other, as the main loop does today
+static void BM_SystemFrameSequential(benchmark::State& state) {
+    Frame frame(static_cast<size_t>(state.range(0)));
+    std::vector<SystemScheduler::UpdateFunction> systems;
+    for (size_t i = 0; i < 5; ++i) systems.push_back(frame.System(i));
+    for (auto _ : state) {
+        for (auto& system : systems) system(0.05f);
+    }
+}
+BENCHMARK(BM_SystemFrameSequential)->Arg(0)->Arg(20000)->Arg(200000);
+
+// The same frame through the scheduler. Regen heals after combat damages, so movement -> grid -> combat -> regen
+// is the critical path and status effects run beside it.
+static void BM_SystemFrameScheduled(benchmark::State& state) {
+    Frame frame(static_cast<size_t>(state.range(0)));
+    WorkStealingPool pool(WorkStealingPool::DefaultWorkerCount());
+    SystemScheduler scheduler(pool);
+    frame.AddTo(scheduler);
+    for (auto _ : state) {
+        scheduler.Update(0.05f);
+    }
+    const auto& stats = scheduler.GetFrameStats();
+    state.counters["critical_path_us"] = stats.critical_path_us;
+    state.counters["serial_us"] = stats.serial_us;
+    state.counters["threads"] = static_cast<double>(pool.GetConcurrency());
+}
+BENCHMARK(BM_SystemFrameScheduled)->Arg(0)->Arg(20000)->Arg(200000)->UseRealTime();
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include "network/session.h"
+#include "network/kernel_tls.h"
+#include "tls_test_certificate.h"
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+
+#include <pthread.h>
+#include <time.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace mmorpg;
+using namespace mmorpg::network;
+using boost::asio::ip::tcp;
+
+namespace {
+
+int64_t ThreadCpuNanos(std::thread& thread) {
+    clockid_t clock;
+    timespec now{};
+    if (pthread_getcpuclockid(thread.native_handle(), &clock) != 0 || clock_gettime(clock, &now) != 0) return 0;
+    return static_cast<int64_t>(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+}
+
+// [SEQUENCE: MVP19-129] One server Session on its own io thread and a blocking userspace-TLS client on loopback.
+// The client side is identical in both modes, so the difference in server thread CPU is the record layer.
+struct TlsLoopback {
+    explicit TlsLoopback(bool kernel_tls) {
+        server_context.set_options(boost::asio::ssl::context::default_workarounds | boost::asio::ssl::context::no_tlsv1 |
+                                   boost::asio::ssl::context::no_tlsv1_1 | boost::asio::ssl::context::no_tlsv1_2);
+        certificate.Use(server_context);
+        if (kernel_tls) kernel_tls::InstallSecretCapture(server_context.native_handle());
+        client_context.set_verify_mode(boost::asio::ssl::verify_none);
+
+        tcp::acceptor acceptor(io_context, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+        client.next_layer().connect(acceptor.local_endpoint());
+        client.next_layer().set_option(tcp::no_delay(true));
+        tcp::socket accepted = acceptor.accept();
+        accepted.set_option(tcp::no_delay(true));
+        SessionWriteConfig config;
+        config.kernel_tls = kernel_tls;
+        session = std::make_shared<Session>(std::move(accepted), server_context, 1, nullptr, config);
+        session->Start();
+
+        io_thread = std::thread([this] { io_context.run(); });
+        client.handshake(boost::asio::ssl::stream_base::client);
+        // The server finishes its side only after reading the client's Finished.
+        while (session->GetState() != SessionState::Connected) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    ~TlsLoopback() {
+        session->Disconnect();
+        work.reset();
+        io_context.stop();
+        io_thread.join();
+    }
+
+    bench::SelfSignedCertificate certificate;
+    boost::asio::io_context io_context;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work{io_context.get_executor()};
+    boost::asio::ssl::context server_context{boost::asio::ssl::context::tls_server};
+    boost::asio::ssl::context client_context{boost::asio::ssl::context::tls_client};
+    boost::asio::ssl::stream<tcp::socket> client{io_context, client_context};
+    std::shared_ptr<Session> session;
+    std::thread io_thread;
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-130] Bulk server -> client transfer, ssl::stream (mode 0) against kernel TLS (mode 1), for
+// state-sync-sized and snapshot-sized packets. ktls_active reports whether the offload actually engaged; where
+// the kernel lacks the tls ULP, mode 1 measures the fallback path.
+static void BM_TlsSessionSend(benchmark::State& state) {
+    const bool kernel_tls = state.range(0) != 0;
+    const auto packet_size = static_cast<size_t>(state.range(1));
+    constexpr size_t kPacketsPerIteration = 64;
+
+    TlsLoopback loopback(kernel_tls);
+    auto packet = std::make_shared<const std::vector<std::byte>>(packet_size, std::byte{0x5A});
+    std::vector<std::byte> sink(packet_size * kPacketsPerIteration);
+
+    const int64_t cpu_start = ThreadCpuNanos(loopback.io_thread);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kPacketsPerIteration; ++i) {
+            loopback.session->SendShared(packet);
+        }
+        boost::asio::read(loopback.client, boost::asio::buffer(sink));
+    }
+    const int64_t cpu_used = ThreadCpuNanos(loopback.io_thread) - cpu_start;
+
+    const auto bytes = static_cast<double>(state.iterations() * kPacketsPerIteration * packet_size);
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.SetLabel(ToString(loopback.session->GetKernelTlsStatus()));
+    state.counters["ktls_active"] = loopback.session->IsKernelTlsActive() ? 1.0 : 0.0;
+    state.counters["server_cpu_ns_per_kb"] = bytes > 0 ? static_cast<double>(cpu_used) / (bytes / 1024.0) : 0.0;
+}
+BENCHMARK(BM_TlsSessionSend)->ArgsProduct({{0, 1}, {1024, 16 * 1024}})->UseRealTime();
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include "network/udp_server.h"
+#include "network/session_manager.h"
+#include "network/i_udp_packet_handler.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace mmorpg::network;
+
+namespace {
+
+// [SEQUENCE: MVP19-55] Counts datagrams; stands in for the movement handler so only ingest cost is measured.
+class CountingUdpHandler : public IUdpPacketHandler {
+public:
+    void Handle(std::shared_ptr<Session>, const boost::asio::ip::udp::endpoint&, const std::vector<std::byte>&, size_t) override {
+        received.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::atomic<uint64_t> received{0};
+};
+
+// Blasts 64-byte datagrams at the server from several sockets so SO_REUSEPORT has distinct flows to spread.
+void BlastDatagrams(uint16_t port, int sockets_per_sender, std::atomic<bool>& stop) {
+    std::vector<int> fds;
+    for (int i = 0; i < sockets_per_sender; ++i) {
+        fds.push_back(::socket(AF_INET, SOCK_DGRAM, 0));
+    }
+    sockaddr_in target{};
+    target.sin_family = AF_INET;
+    target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    target.sin_port = htons(port);
+
+    constexpr size_t kBatch = 64;
+    std::byte payload[64] = {};
+    iovec iov{payload, sizeof(payload)};
+    std::vector<mmsghdr> msgs(kBatch);
+    for (auto& msg : msgs) {
+        msg.msg_hdr = msghdr{};
+        msg.msg_hdr.msg_name = &target;
+        msg.msg_hdr.msg_namelen = sizeof(target);
+        msg.msg_hdr.msg_iov = &iov;
+        msg.msg_hdr.msg_iovlen = 1;
+    }
+
+    size_t next = 0;
+    while (!stop.load(std::memory_order_relaxed)) {
+        ::sendmmsg(fds[next++ % fds.size()], msgs.data(), kBatch, 0);
+    }
+    for (int fd : fds) {
+        ::close(fd);
+    }
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-56] Loopback ingest rate against worker count. Reported as datagrams_per_sec.
+static void BM_UdpIngest(benchmark::State& state) {
+    SessionManager session_manager;
+    UdpServer::Config config;
+    config.port = 0;
+    config.worker_count = static_cast<size_t>(state.range(0));
+    config.batch_size = 64;
+
+    UdpServer server(config, session_manager);
+    auto handler = std::make_shared<CountingUdpHandler>();
+    server.SetPacketHandler(handler);
+    if (!server.Start()) {
+        state.SkipWithError("UdpServer failed to start");
+        return;
+    }
+
+    const int sender_threads = static_cast<int>(std::max<int64_t>(2, state.range(0)));
+    for (auto _ : state) {
+        std::atomic<bool> stop{false};
+        const uint64_t before = handler->received.load();
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> senders;
+        for (int i = 0; i < sender_threads; ++i) {
+            senders.emplace_back(BlastDatagrams, server.GetPort(), 8, std::ref(stop));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        stop = true;
+        for (auto& sender : senders) {
+            sender.join();
+        }
+
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        state.SetIterationTime(elapsed);
+        state.counters["datagrams_per_sec"] = benchmark::Counter(
+            static_cast<double>(handler->received.load() - before) / elapsed, benchmark::Counter::kAvgIterations);
+    }
+
+    const auto totals = server.GetTotalStats();
+    state.counters["avg_batch"] = totals.recv_batches ? static_cast<double>(totals.datagrams_received) / totals.recv_batches : 0.0;
+    server.Stop();
+}
+BENCHMARK(BM_UdpIngest)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseManualTime()->Iterations(3)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <boost/asio/ssl.hpp>
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include <cstdio>
+#include <string>
+
+namespace mmorpg::bench {
+
+// [SEQUENCE: MVP19-128] Throwaway self-signed P-256 certificate so TLS benchmarks need no files checked in.
+class SelfSignedCertificate {
+public:
+    SelfSignedCertificate() : m_key(EVP_EC_gen("P-256")), m_cert(X509_new()) {
+        ASN1_INTEGER_set(X509_get_serialNumber(m_cert), 1);
+        X509_gmtime_adj(X509_getm_notBefore(m_cert), 0);
+        X509_gmtime_adj(X509_getm_notAfter(m_cert), 3600);
+        X509_set_pubkey(m_cert, m_key);
+        X509_NAME* name = X509_get_subject_name(m_cert);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("bench"), -1, -1, 0);
+        X509_set_issuer_name(m_cert, name);
+        X509_sign(m_cert, m_key, EVP_sha256());
+    }
+
+    ~SelfSignedCertificate() {
+        X509_free(m_cert);
+        EVP_PKEY_free(m_key);
+    }
+
+    SelfSignedCertificate(const SelfSignedCertificate&) = delete;
+    SelfSignedCertificate& operator=(const SelfSignedCertificate&) = delete;
+
+    void Use(boost::asio::ssl::context& context) const {
+        SSL_CTX_use_certificate(context.native_handle(), m_cert);
+        SSL_CTX_use_PrivateKey(context.native_handle(), m_key);
+    }
+
+    // For code that only takes PEM paths (TcpServer).
+    bool WritePem(const std::string& cert_path, const std::string& key_path) const {
+        FILE* cert_file = std::fopen(cert_path.c_str(), "w");
+        FILE* key_file = std::fopen(key_path.c_str(), "w");
+        const bool ok = cert_file && key_file && PEM_write_X509(cert_file, m_cert) == 1 &&
+                        PEM_write_PrivateKey(key_file, m_key, nullptr, nullptr, 0, nullptr, nullptr) == 1;
+        if (cert_file) std::fclose(cert_file);
+        if (key_file) std::fclose(key_file);
+        return ok;
+    }
+
+private:
+    EVP_PKEY* m_key;
+    X509* m_cert;
+};
+
+} // namespace mmorpg::bench
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+
+#include "network/buffer_pool.h"
+
+#include <thread>
+
+using namespace mmorpg::network;
+
+// [SEQUENCE: MVP19-435] Buffers released on one thread reach another through the shared list: a releasing
+// thread spills its surplus, and its remaining cache when it exits.
+TEST(BufferPoolTest, BuffersReleasedOnOneThreadAreReusedOnAnother) {
+    auto& pool = BufferPool::Instance();
+    const size_t released = BufferPool::kCacheCapacity * 3;
+    const size_t pooled_before = pool.GetPooledCount();
+
+    std::thread producer([&] {
+        for (size_t i = 0; i < released; ++i) {
+            std::vector<std::byte> buffer;
+            buffer.reserve(256);
+            pool.Release(std::move(buffer));
+        }
+    });
+    producer.join();
+    EXPECT_EQ(pool.GetPooledCount(), pooled_before + released);
+
+    std::thread consumer([&] {
+        for (size_t i = 0; i < released; ++i) {
+            auto buffer = pool.Acquire();
+            EXPECT_GE(buffer.capacity(), 256u);
+            EXPECT_TRUE(buffer.empty());
+        }
+    });
+    consumer.join();
+}
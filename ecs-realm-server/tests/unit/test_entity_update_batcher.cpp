@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include "network/entity_update_batcher.h"
+#include "network/packet_serializer.h"
+#include "proto/game.pb.h"
+
+#include <map>
+
+using namespace mmorpg::network;
+
+namespace {
+
+EntityUpdateBatcher::RecordId EncodeMovement(EntityUpdateBatcher& batcher, uint64_t entity_id, float x) {
+    auto* update = batcher.NewUpdate();
+    update->set_entity_id(entity_id);
+    update->mutable_movement()->set_entity_id(entity_id);
+    update->mutable_movement()->mutable_position()->set_x(x);
+    return batcher.Encode(*update);
+}
+
+std::map<uint64_t, mmorpg::proto::EntityUpdateBatch> FlushAndParse(EntityUpdateBatcher& batcher) {
+    std::map<uint64_t, mmorpg::proto::EntityUpdateBatch> batches;
+    batcher.Flush([&](uint64_t session_id, const SharedPacketBuffer& packet) {
+        PacketSerializer::PacketEnvelope envelope;
+        ASSERT_TRUE(PacketSerializer::ParseEnvelope(packet->data() + 4, packet->size() - 4, envelope));
+        ASSERT_EQ(envelope.type, mmorpg::proto::PACKET_ENTITY_UPDATE_BATCH);
+        ASSERT_TRUE(batches[session_id].ParseFromArray(envelope.payload, static_cast<int>(envelope.payload_size)));
+    });
+    return batches;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-150] Each session's packet parses as an EntityUpdateBatch holding exactly its records, in the
+// order they were added, while every update was serialized only once.
+TEST(EntityUpdateBatcherTest, BuildsOneBatchPerSessionFromSharedRecords) {
+    EntityUpdateBatcher batcher;
+    batcher.BeginTick(42);
+    const auto a = EncodeMovement(batcher, 100, 1.0f);
+    const auto b = EncodeMovement(batcher, 200, 2.0f);
+    const auto c = EncodeMovement(batcher, 300, 3.0f);
+    batcher.AddRecipient(1, a);
+    batcher.AddRecipient(1, c);
+    batcher.AddRecipient(2, b);
+    batcher.AddRecipient(2, a);
+    batcher.AddRecipient(3, c);
+
+    auto batches = FlushAndParse(batcher);
+    ASSERT_EQ(batches.size(), 3u);
+    EXPECT_EQ(batches[1].tick(), 42u);
+    ASSERT_EQ(batches[1].updates_size(), 2);
+    EXPECT_EQ(batches[1].updates(0).entity_id(), 100u);
+    EXPECT_EQ(batches[1].updates(1).entity_id(), 300u);
+    EXPECT_FLOAT_EQ(batches[1].updates(1).movement().position().x(), 3.0f);
+    ASSERT_EQ(batches[2].updates_size(), 2);
+    EXPECT_EQ(batches[2].updates(0).entity_id(), 200u);
+    EXPECT_EQ(batches[2].updates(1).entity_id(), 100u);
+    ASSERT_EQ(batches[3].updates_size(), 1);
+    EXPECT_EQ(batches[3].updates(0).entity_id(), 300u);
+
+    const auto& stats = batcher.GetTickStats();
+    EXPECT_EQ(stats.records_encoded, 3u);
+    EXPECT_EQ(stats.record_references, 5u);
+    EXPECT_EQ(stats.packets_built, 3u);
+}
+
+// [SEQUENCE: MVP19-151] A new tick starts empty: sessions from the previous tick get nothing unless re-added.
+TEST(EntityUpdateBatcherTest, TicksAreIndependent) {
+    EntityUpdateBatcher batcher(4096);   // Small first block so the arena has to grow and reset
+    batcher.BeginTick(1);
+    for (uint64_t i = 0; i < 500; ++i) {
+        batcher.AddRecipient(7, EncodeMovement(batcher, i, static_cast<float>(i)));
+    }
+    auto first = FlushAndParse(batcher);
+    ASSERT_EQ(first[7].updates_size(), 500);
+
+    batcher.BeginTick(2);
+    batcher.AddRecipient(8, EncodeMovement(batcher, 9, 9.0f));
+    auto second = FlushAndParse(batcher);
+    ASSERT_EQ(second.size(), 1u);
+    ASSERT_EQ(second[8].updates_size(), 1);
+    EXPECT_EQ(second[8].tick(), 2u);
+    EXPECT_EQ(second[8].updates(0).entity_id(), 9u);
+    EXPECT_EQ(batcher.GetTickStats().records_encoded, 1u);
+}
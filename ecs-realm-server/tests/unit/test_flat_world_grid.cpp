@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "game/world/grid/flat_world_grid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace mmorpg::game::world;
+using mmorpg::core::ecs::EntityId;
+using mmorpg::core::utils::Vector3;
+
+namespace {
+
+grid::FlatWorldGrid::Config SmallWorld() {
+    grid::FlatWorldGrid::Config config;
+    config.cell_size = 10.0f;
+    config.grid_width = 50;
+    config.grid_height = 50;
+    return config;
+}
+
+std::vector<EntityId> Sorted(std::vector<EntityId> ids) {
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-342] Radius and box queries return exactly the entities a brute-force scan finds, across
+// cell, row and span boundaries and for spans shorter than one SIMD step.
+TEST(FlatWorldGridTest, QueriesMatchBruteForce) {
+    grid::FlatWorldGrid index(SmallWorld());
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coord(0.0f, 500.0f);
+    std::uniform_real_distribution<float> height(-20.0f, 20.0f);
+    std::unordered_map<EntityId, Vector3> positions;
+    for (EntityId id = 1; id <= 3000; ++id) {
+        positions[id] = {coord(rng), coord(rng), height(rng)};
+        index.AddEntity(id, positions[id]);
+    }
+    index.Commit();
+    ASSERT_EQ(index.GetEntityCount(), 3000u);
+
+    std::uniform_real_distribution<float> radius(0.0f, 60.0f);
+    for (int query = 0; query < 200; ++query) {
+        const Vector3 center{coord(rng), coord(rng), height(rng)};
+        const float r = radius(rng);
+        std::vector<EntityId> expected;
+        for (const auto& [id, p] : positions) {
+            const float dx = p.x - center.x, dy = p.y - center.y, dz = p.z - center.z;
+            if (dx * dx + dy * dy + dz * dz <= r * r) expected.push_back(id);
+        }
+        EXPECT_EQ(Sorted(index.GetEntitiesInRadius(center, r)), Sorted(expected));
+
+        const Vector3 lo{center.x - r, center.y - r / 2, -5.0f};
+        const Vector3 hi{center.x + r, center.y + r / 2, 5.0f};
+        expected.clear();
+        for (const auto& [id, p] : positions) {
+            if (p.x >= lo.x && p.x <= hi.x && p.y >= lo.y && p.y <= hi.y && p.z >= lo.z && p.z <= hi.z) {
+                expected.push_back(id);
+            }
+        }
+        EXPECT_EQ(Sorted(index.GetEntitiesInBox(lo, hi)), Sorted(expected));
+    }
+}
+
+// [SEQUENCE: MVP19-343] Changes are staged until Commit; entities that leave the world stop being indexed and
+// come back when they return.
+TEST(FlatWorldGridTest, ChangesBecomeVisibleAtCommit) {
+    grid::FlatWorldGrid index(SmallWorld());
+    index.AddEntity(1, {5, 5, 0});
+    index.AddEntity(2, {6, 5, 0});
+    EXPECT_TRUE(index.GetEntitiesInRadius({5, 5, 0}, 3.0f).empty());
+    index.Commit();
+    EXPECT_EQ(Sorted(index.GetEntitiesInRadius({5, 5, 0}, 3.0f)), (std::vector<EntityId>{1, 2}));
+
+    index.UpdateEntity(1, {5, 5, 0}, {255, 255, 0});
+    index.RemoveEntity(2);
+    EXPECT_EQ(index.GetEntitiesInRadius({5, 5, 0}, 3.0f).size(), 2u);
+    index.Commit();
+    EXPECT_TRUE(index.GetEntitiesInRadius({5, 5, 0}, 3.0f).empty());
+    EXPECT_EQ(index.GetEntitiesInRadius({255, 255, 0}, 1.0f), (std::vector<EntityId>{1}));
+
+    index.UpdateEntity(1, {255, 255, 0}, {-1, 5, 0});
+    index.Commit();
+    EXPECT_EQ(index.GetEntityCount(), 0u);
+    EXPECT_TRUE(index.GetEntitiesInRadius({0, 5, 0}, 5.0f).empty());
+    index.UpdateEntity(1, {-1, 5, 0}, {1, 5, 0});
+    index.Commit();
+    EXPECT_EQ(index.GetEntitiesInRadius({0, 5, 0}, 5.0f), (std::vector<EntityId>{1}));
+}
+
+// [SEQUENCE: MVP19-344] Queries from many threads within a tick while other threads stage the next tick's
+// movement: every query sees the committed positions only.
+TEST(FlatWorldGridTest, ConcurrentQueriesSeeCommittedState) {
+    grid::FlatWorldGrid index(SmallWorld());
+    for (EntityId id = 1; id <= 500; ++id) {
+        index.AddEntity(id, {static_cast<float>(id % 50) * 10.0f + 5.0f, static_cast<float>(id / 50) * 10.0f + 5.0f, 0});
+    }
+    index.Commit();
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            std::vector<EntityId> found;
+            for (int i = 0; i < 2000; ++i) {
+                found.clear();
+                index.QueryBox({0, 0, -1}, {500, 500, 1}, found);
+                if (found.size() != 500) ++mismatches;
+            }
+        });
+    }
+    threads.emplace_back([&] {
+        for (EntityId id = 1; id <= 500; ++id) index.UpdateEntity(id, {}, {-100, -100, 0});
+    });
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(mismatches.load(), 0);
+
+    index.Commit();
+    EXPECT_EQ(index.GetEntityCount(), 0u);
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include "network/global_load_balancer.h"
+#include "network/load_balancer_service.h"
+
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <map>
+#include <thread>
+
+using namespace mmorpg::network;
+using Clock = GlobalLoadBalancer::Clock;
+using namespace std::chrono_literals;
+
+namespace {
+
+mmorpg::proto::NodeLoadReport Report(const std::string& id, uint64_t sequence, double tick_ms, uint32_t sessions,
+                                     const std::string& region = "eu") {
+    mmorpg::proto::NodeLoadReport report;
+    report.set_node_id(id);
+    report.set_region(region);
+    report.set_host("127.0.0.1");
+    report.set_game_port(8000);
+    report.set_handoff_port(9000);
+    report.set_sequence(sequence);
+    report.set_tick_ms(tick_ms);
+    report.set_tick_budget_ms(16.0);
+    report.set_sessions(sessions);
+    report.set_max_sessions(1000);
+    return report;
+}
+
+GlobalLoadBalancer::LoadBalancerConfig SeededConfig() {
+    GlobalLoadBalancer::LoadBalancerConfig config;
+    config.seed = 12345;
+    config.enable_sticky_sessions = false;
+    return config;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-322] A node's load is its worst ratio: a node with few sessions but a tick over budget, or a
+// saturated link, takes no new sessions, and the lightly loaded node takes the burst.
+TEST(GlobalLoadBalancerTest, RoutesByWorstLoadRatio) {
+    GlobalLoadBalancer balancer(SeededConfig());
+    const auto now = Clock::now();
+    balancer.UpdateNodeLoad(Report("cpu-bound", 1, 15.5, 50), now);
+    auto saturated = Report("link-bound", 1, 4.0, 50);
+    saturated.set_egress_bytes_per_second(95e6);
+    saturated.set_egress_capacity_bytes_per_second(100e6);
+    balancer.UpdateNodeLoad(saturated, now);
+    balancer.UpdateNodeLoad(Report("light", 1, 4.0, 300), now);
+    balancer.UpdateNodeLoad(Report("busy", 1, 8.0, 600), now);
+
+    std::map<std::string, int> placed;
+    for (int i = 0; i < 100; ++i) {
+        const auto result = balancer.RouteClient("client" + std::to_string(i), "", now);
+        ASSERT_TRUE(result.success);
+        ++placed[result.selected_server_id];
+    }
+    EXPECT_EQ(placed.count("cpu-bound"), 0u);
+    EXPECT_EQ(placed.count("link-bound"), 0u);
+    EXPECT_EQ(placed["light"], 100);   // 400/1000 after the burst is still below busy's 0.6
+    EXPECT_EQ(placed.count("busy"), 0u);
+}
+
+// [SEQUENCE: MVP19-323] Between reports, pending sessions raise a node's load, so a login burst spreads evenly
+// over equal nodes instead of landing on whichever one last reported least.
+TEST(GlobalLoadBalancerTest, TwoChoicesSpreadsBurstBetweenReports) {
+    GlobalLoadBalancer balancer(SeededConfig());
+    const auto now = Clock::now();
+    for (int i = 0; i < 10; ++i) balancer.UpdateNodeLoad(Report("node" + std::to_string(i), 1, 2.0, 100), now);
+
+    std::map<std::string, int> placed;
+    for (int i = 0; i < 2000; ++i) ++placed[balancer.RouteClient("", "", now).selected_server_id];
+    ASSERT_EQ(placed.size(), 10u);
+    const auto [low, high] = std::minmax_element(placed.begin(), placed.end(),
+                                                 [](const auto& a, const auto& b) { return a.second < b.second; });
+    EXPECT_LE(high->second - low->second, 4);
+
+    // A report resets the node's pending count to what it actually has
+    balancer.UpdateNodeLoad(Report("node0", 2, 2.0, 100), now);
+    const auto nodes = balancer.GetNodes();
+    const auto node0 = std::find_if(nodes.begin(), nodes.end(), [](const auto& n) { return n.server_id == "node0"; });
+    EXPECT_EQ(node0->pending_sessions, 0u);
+}
+
+// [SEQUENCE: MVP19-324] Only fresh, healthy, non-draining nodes are candidates; reordered reports are ignored;
+// region preference and stickiness are honoured while the node stays available.
+TEST(GlobalLoadBalancerTest, SkipsUnavailableNodesAndHonoursRegionAndAffinity) {
+    auto config = SeededConfig();
+    config.enable_sticky_sessions = true;
+    GlobalLoadBalancer balancer(config);
+    auto now = Clock::now();
+
+    balancer.UpdateNodeLoad(Report("eu-1", 5, 2.0, 100, "eu"), now);
+    balancer.UpdateNodeLoad(Report("eu-2", 1, 2.0, 100, "eu"), now);
+    balancer.UpdateNodeLoad(Report("us-1", 1, 2.0, 100, "us"), now);
+    EXPECT_FALSE(balancer.UpdateNodeLoad(Report("eu-1", 4, 15.9, 999, "eu"), now));
+
+    auto draining = Report("eu-2", 2, 2.0, 100, "eu");
+    draining.set_draining(true);
+    balancer.UpdateNodeLoad(draining, now);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(balancer.RouteClient("c" + std::to_string(i), "eu", now).selected_server_id, "eu-1");
+    }
+
+    const auto first = balancer.RouteClient("player", "us", now);
+    EXPECT_EQ(first.selected_server_id, "us-1");
+    const auto again = balancer.RouteClient("player", "eu", now);
+    EXPECT_EQ(again.selected_server_id, "us-1");
+    EXPECT_EQ(again.routing_reason, "sticky");
+
+    // us-1 goes silent: the sticky client falls back to its preferred region
+    now += 5s;
+    balancer.UpdateNodeLoad(Report("eu-1", 6, 2.0, 100, "eu"), now);
+    EXPECT_EQ(balancer.RouteClient("player", "us", now).selected_server_id, "eu-1");
+    balancer.SetServerHealthStatus("eu-1", false);
+    EXPECT_FALSE(balancer.RouteClient("player", "eu", now).success);
+
+    const auto stats = balancer.GetStatistics(now);
+    EXPECT_EQ(stats.stale_reports, 1u);
+    EXPECT_EQ(stats.available_servers, 0u);
+}
+
+// [SEQUENCE: MVP19-325] Handoff targets must be clearly less loaded than the source; a draining source may
+// shed to any node with room.
+TEST(GlobalLoadBalancerTest, SelectsHandoffTargetsOnlyWithMargin) {
+    GlobalLoadBalancer balancer(SeededConfig());
+    const auto now = Clock::now();
+    balancer.UpdateNodeLoad(Report("hot", 1, 14.0, 500), now);     // 0.875
+    balancer.UpdateNodeLoad(Report("warm", 1, 13.5, 400), now);    // 0.84
+    balancer.UpdateNodeLoad(Report("cool", 1, 6.0, 200), now);     // 0.375
+
+    const auto target = balancer.SelectHandoffTarget("hot", now);
+    ASSERT_TRUE(target.success);
+    EXPECT_EQ(target.selected_server_id, "cool");
+    EXPECT_EQ(target.handoff_port, 9000);
+    EXPECT_FALSE(balancer.SelectHandoffTarget("cool", now).success);
+
+    auto draining = Report("cool", 2, 6.0, 200);
+    draining.set_draining(true);
+    balancer.UpdateNodeLoad(draining, now);
+    std::map<std::string, int> targets;
+    for (int i = 0; i < 10; ++i) ++targets[balancer.SelectHandoffTarget("cool", now).selected_server_id];
+    EXPECT_EQ(targets["hot"] + targets["warm"], 10);
+}
+
+// [SEQUENCE: MVP19-326] Reporters and the balancer service over loopback UDP: reports register the nodes, and a
+// loaded node's handoff request comes back naming the other node.
+TEST(LoadBalancerServiceTest, ReportsAndHandoffRequestsOverLoopback) {
+    boost::asio::io_context io_context;
+    auto work = boost::asio::make_work_guard(io_context);
+    std::thread io_thread([&] { io_context.run(); });
+
+    GlobalLoadBalancer balancer(SeededConfig());
+    auto service = std::make_shared<LoadBalancerService>(io_context, balancer);
+    ASSERT_TRUE(service->Start({boost::asio::ip::make_address("127.0.0.1"), 0}));
+    const auto balancer_endpoint = service->GetLocalEndpoint();
+
+    std::atomic<double> busy_tick{15.0};
+    auto make_reporter = [&](const std::string& id, uint16_t port, std::function<NodeLoadSample()> sampler) {
+        NodeLoadReporter::Config config;
+        config.node_id = id;
+        config.game_port = port;
+        config.handoff_port = port + 1;
+        config.interval = 20ms;
+        return std::make_shared<NodeLoadReporter>(io_context, config, balancer_endpoint, std::move(sampler));
+    };
+    auto busy = make_reporter("busy", 8000, [&] { return NodeLoadSample{busy_tick.load(), 800, 0, false}; });
+    auto idle = make_reporter("idle", 8010, [] { return NodeLoadSample{2.0, 10, 0, false}; });
+    ASSERT_TRUE(busy->Start());
+    ASSERT_TRUE(idle->Start());
+
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (balancer.GetStatistics().available_servers < 1 || balancer.GetNodes().size() < 2) {
+        ASSERT_LT(std::chrono::steady_clock::now(), deadline);
+        std::this_thread::sleep_for(5ms);
+    }
+
+    std::promise<mmorpg::proto::RouteResponse> answer;
+    busy->RequestHandoffTarget([&](const mmorpg::proto::RouteResponse& response) { answer.set_value(response); });
+    const auto response = answer.get_future().get();
+    EXPECT_TRUE(response.success()) << response.reason();
+    EXPECT_EQ(response.node_id(), "idle");
+    EXPECT_EQ(response.port(), 8010u);
+    EXPECT_EQ(response.handoff_port(), 8011u);
+    EXPECT_GE(service->GetStats().reports, 2u);
+    EXPECT_EQ(service->GetStats().handoff_requests, 1u);
+
+    busy->Stop();
+    idle->Stop();
+    service->Stop();
+    work.reset();
+    io_thread.join();
+}
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include "network/hit_validation_pipeline.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace mmorpg::network;
+using mmorpg::core::utils::Vector3;
+using Clock = RewindHistory::Clock;
+
+namespace {
+
+constexpr auto kFrame = std::chrono::milliseconds(16);
+const Vector3 kHalfExtents{0.5f, 0.5f, 1.0f};
+
+// [SEQUENCE: MVP19-222] 800 entities walking in a 150 m square for 60 frames, every ninth one dead, and a batch of
+// unnamed-victim claims from random entities at random whole-millisecond times inside the history.
+class HitValidationPipelineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        RewindHistoryConfig config;
+        config.max_entities = 1000;
+        history = std::make_unique<RewindHistory>(config);
+
+        std::mt19937 rng(15);
+        std::uniform_real_distribution<float> coord(0.0f, 150.0f);
+        std::uniform_real_distribution<float> step(-0.3f, 0.3f);
+        positions.resize(800);
+        for (auto& p : positions) p = {coord(rng), coord(rng), 0.0f};
+        start = Clock::time_point(std::chrono::seconds(1000));
+        for (int frame = 0; frame < 60; ++frame) {
+            history->BeginFrame(start + kFrame * frame);
+            for (size_t i = 0; i < positions.size(); ++i) {
+                positions[i].x += step(rng);
+                positions[i].y += step(rng);
+                history->Record(i + 1, positions[i], {}, kHalfExtents, (i + 1) % 9 != 0);
+            }
+        }
+    }
+
+    std::vector<HitClaim> MakeRayClaims(size_t count, uint32_t seed) const {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<size_t> shooter(0, positions.size() - 1);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+        std::uniform_int_distribution<int> at(0, 59 * 16);
+        std::vector<HitClaim> claims(count);
+        for (size_t i = 0; i < count; ++i) {
+            const size_t from = shooter(rng);
+            const float heading = angle(rng);
+            claims[i].claim_id = 1000 + i;
+            claims[i].attacker_id = from + 1;
+            claims[i].origin = {positions[from].x, positions[from].y, 0.5f};
+            claims[i].direction = {std::cos(heading), std::sin(heading), -0.01f};
+            claims[i].max_range = 40.0f;
+            claims[i].rewind_time = start + std::chrono::milliseconds(at(rng));
+        }
+        return claims;
+    }
+
+    std::unique_ptr<RewindHistory> history;
+    std::vector<Vector3> positions;
+    Clock::time_point start;
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-223] Batched verdicts equal one RaycastAt per claim, in submission order.
+TEST_F(HitValidationPipelineTest, MatchesPerClaimRaycast) {
+    HitValidationConfig config;
+    config.worker_count = 2;
+    HitValidationPipeline pipeline(*history, config);
+    const auto claims = MakeRayClaims(400, 1);
+    for (const auto& claim : claims) pipeline.Submit(claim);
+    EXPECT_EQ(pipeline.GetPendingCount(), claims.size());
+
+    std::vector<HitVerdict> verdicts;
+    pipeline.ValidatePending(verdicts);
+    ASSERT_EQ(verdicts.size(), claims.size());
+    EXPECT_EQ(pipeline.GetPendingCount(), 0u);
+
+    size_t hits = 0;
+    for (size_t i = 0; i < claims.size(); ++i) {
+        const auto& claim = claims[i];
+        auto expected = history->RaycastAt(claim.rewind_time, claim.origin, claim.direction, claim.max_range,
+                                           claim.attacker_id);
+        EXPECT_EQ(verdicts[i].claim_id, claim.claim_id);
+        ASSERT_EQ(verdicts[i].valid, expected.has_value()) << i;
+        if (expected) {
+            EXPECT_EQ(verdicts[i].victim_id, expected->entity_id) << i;
+            EXPECT_FLOAT_EQ(verdicts[i].distance, expected->distance) << i;
+            EXPECT_NE(verdicts[i].victim_id % 9, 0u);   // Dead entities are never hit
+            ++hits;
+        } else {
+            EXPECT_EQ(verdicts[i].rejection, HitRejection::Missed);
+        }
+    }
+    EXPECT_GT(hits, 50u);
+    EXPECT_LT(hits, claims.size());
+}
+
+// [SEQUENCE: MVP19-224] Worker count changes nothing but the timings; claims sharing a millisecond share a group.
+TEST_F(HitValidationPipelineTest, DeterministicForAnyWorkerCount) {
+    const auto claims = MakeRayClaims(600, 2);
+    std::vector<std::vector<HitVerdict>> results;
+    for (size_t workers : {0u, 1u, 3u}) {
+        HitValidationConfig config;
+        config.worker_count = workers;
+        HitValidationPipeline pipeline(*history, config);
+        for (int round = 0; round < 2; ++round) {   // Reused scratch must not leak between batches
+            for (const auto& claim : claims) pipeline.Submit(claim);
+            results.emplace_back();
+            pipeline.ValidatePending(results.back());
+        }
+        const auto& stats = pipeline.GetStats();
+        EXPECT_EQ(stats.batches, 2u);
+        EXPECT_EQ(stats.claims, 2 * claims.size());
+        EXPECT_EQ(stats.valid + stats.rejected, stats.claims);
+        EXPECT_LT(stats.groups, stats.claims);
+        EXPECT_GT(stats.last.total_us, 0.0);
+    }
+    for (size_t r = 1; r < results.size(); ++r) {
+        ASSERT_EQ(results[r].size(), results[0].size());
+        for (size_t i = 0; i < results[0].size(); ++i) {
+            EXPECT_EQ(results[r][i].valid, results[0][i].valid);
+            EXPECT_EQ(results[r][i].victim_id, results[0][i].victim_id);
+            EXPECT_EQ(results[r][i].distance, results[0][i].distance);
+        }
+    }
+}
+
+// [SEQUENCE: MVP19-225] A claim naming its victim is checked against that victim alone, with a reason on failure.
+TEST_F(HitValidationPipelineTest, NamedVictimVerdicts) {
+    HitValidationPipeline pipeline(*history);
+    const auto time = start + kFrame * 30;
+    auto aim = [&](uint64_t attacker, uint64_t victim) {
+        const auto target = history->GetEntityAt(victim, time);
+        const auto& from = positions[attacker - 1];
+        HitClaim claim;
+        claim.claim_id = victim;
+        claim.attacker_id = attacker;
+        claim.victim_id = victim;
+        claim.origin = {from.x, from.y, 0.0f};
+        claim.direction = {target->position.x - from.x, target->position.y - from.y, 0.0f};
+        claim.max_range = 500.0f;
+        claim.rewind_time = time;
+        return claim;
+    };
+
+    pipeline.Submit(aim(1, 2));          // Alive, aimed at: valid
+    pipeline.Submit(aim(1, 9));          // Dead
+    auto away = aim(1, 3);
+    away.direction = {-away.direction.x, -away.direction.y, 0.0f};
+    pipeline.Submit(away);               // Aimed the other way
+    auto far = aim(1, 4);
+    far.max_range = 0.01f;
+    pipeline.Submit(far);                // Out of range
+    auto unknown = aim(1, 5);
+    unknown.victim_id = 99999;
+    pipeline.Submit(unknown);
+
+    std::vector<HitVerdict> verdicts;
+    pipeline.ValidatePending(verdicts);
+    ASSERT_EQ(verdicts.size(), 5u);
+    EXPECT_TRUE(verdicts[0].valid);
+    EXPECT_EQ(verdicts[0].victim_id, 2u);
+    EXPECT_EQ(verdicts[1].rejection, HitRejection::VictimDead);
+    EXPECT_EQ(verdicts[2].rejection, HitRejection::Missed);
+    EXPECT_EQ(verdicts[3].rejection, HitRejection::Missed);
+    EXPECT_EQ(verdicts[4].rejection, HitRejection::VictimNotFound);
+
+    RewindHistory empty;
+    HitValidationPipeline nothing(empty);
+    nothing.Submit(aim(1, 2));
+    nothing.ValidatePending(verdicts);
+    ASSERT_EQ(verdicts.size(), 1u);
+    EXPECT_EQ(verdicts[0].rejection, HitRejection::NoHistory);
+}
@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+
+#include "network/input_jitter_buffer.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace mmorpg::network;
+
+namespace {
+
+constexpr double kTick = 1.0 / 60.0;
+
+TickInput MakeInput(uint32_t sequence) {
+    // A scripted player: runs in slowly turning directions, sprints now and then, jumps every two seconds
+    TickInput input;
+    input.sequence = sequence;
+    const float phase = static_cast<float>(sequence % 240) / 240.0f;
+    input.move_x = (sequence / 90) % 4 == 3 ? 0.0f : 1.0f - 2.0f * phase;
+    input.move_z = (sequence / 90) % 4 == 3 ? 0.0f : phase;
+    input.yaw = phase * 6.2831853f;
+    if ((sequence / 150) % 2 == 1) input.flags |= TickInput::kSprint;
+    if (sequence % 120 == 7) input.flags |= TickInput::kJump;
+    return input;
+}
+
+struct Delivery {
+    double arrival;
+    TickInput input;
+};
+
+// Input i leaves the client at i * kTick and arrives after latency_ms plus uniform jitter.
+std::vector<Delivery> SimulateNetwork(uint32_t count, double latency_ms, double jitter_ms, uint32_t seed,
+                                      uint32_t first = 0) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> jitter(0.0, jitter_ms);
+    std::vector<Delivery> deliveries;
+    for (uint32_t i = first; i < first + count; ++i) {
+        deliveries.push_back({i * kTick + (latency_ms + jitter(rng)) / 1000.0, MakeInput(i)});
+    }
+    std::stable_sort(deliveries.begin(), deliveries.end(),
+                     [](const Delivery& a, const Delivery& b) { return a.arrival < b.arrival; });
+    return deliveries;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-235] Inputs come out in sequence order, one per tick, whatever order they arrived in.
+TEST(InputJitterBufferTest, OrdersBySequenceAndConsumesOnePerTick) {
+    InputJitterBufferConfig config;
+    config.min_depth = 3;
+    InputJitterBuffer buffer(config);
+    std::vector<InputJitterBuffer::ConsumedInput> out;
+
+    EXPECT_EQ(buffer.Push(MakeInput(12), 0.0), InputJitterBuffer::PushResult::Accepted);
+    EXPECT_EQ(buffer.Push(MakeInput(11), 0.0), InputJitterBuffer::PushResult::Accepted);
+    buffer.ConsumeTick(out);
+    EXPECT_TRUE(out.empty());   // Priming until three are buffered
+    EXPECT_FALSE(buffer.IsPrimed());
+    EXPECT_EQ(buffer.Push(MakeInput(10), 0.0), InputJitterBuffer::PushResult::Accepted);
+    EXPECT_EQ(buffer.Push(MakeInput(11), 0.0), InputJitterBuffer::PushResult::Duplicate);
+
+    for (uint32_t expected = 10; expected <= 12; ++expected) {
+        buffer.ConsumeTick(out);
+        ASSERT_EQ(out.size(), 1u);
+        EXPECT_EQ(out[0].input, MakeInput(expected));
+        EXPECT_FALSE(out[0].replayed);
+    }
+    EXPECT_EQ(buffer.GetBufferedCount(), 0u);
+
+    buffer.ConsumeTick(out);   // Nothing buffered: wait, never invent input
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(buffer.GetStats().stall_ticks, 1u);
+
+    EXPECT_EQ(buffer.Push(MakeInput(11), 0.1), InputJitterBuffer::PushResult::Late);
+    EXPECT_EQ(buffer.Push(MakeInput(13 + 64), 0.1), InputJitterBuffer::PushResult::TooFarAhead);
+    EXPECT_EQ(buffer.Push(MakeInput(13), 0.1), InputJitterBuffer::PushResult::Accepted);
+    buffer.ConsumeTick(out);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0].input.sequence, 13u);
+    EXPECT_EQ(buffer.GetStats().consumed, 4u);
+}
+
+// [SEQUENCE: MVP19-236] A lost input is waited for, then stood in for by the last one; when it turns up late its
+// difference from the stand-in is counted as a correction.
+TEST(InputJitterBufferTest, MissingInputIsReplayedAndCorrectionCounted) {
+    InputJitterBufferConfig config;
+    config.max_wait_ticks = 2;
+    InputJitterBuffer buffer(config);
+    std::vector<InputJitterBuffer::ConsumedInput> out;
+
+    TickInput first = MakeInput(1);
+    buffer.Push(first, 0.0);
+    buffer.ConsumeTick(out);
+    ASSERT_EQ(out.size(), 1u);
+    const size_t target = buffer.GetTargetDepth();
+
+    TickInput lost = MakeInput(2);
+    lost.move_x = -first.move_x;   // Not what a replay of 1 would guess
+    buffer.Push(MakeInput(3), 2 * kTick);
+    buffer.Push(MakeInput(4), 3 * kTick);
+    for (int wait = 0; wait < 2; ++wait) {
+        buffer.ConsumeTick(out);
+        EXPECT_TRUE(out.empty());
+    }
+    EXPECT_EQ(buffer.GetTargetDepth(), target + 1);   // Grown once for the gap
+
+    buffer.ConsumeTick(out);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_TRUE(out[0].replayed);
+    EXPECT_EQ(out[0].input.sequence, 2u);
+    EXPECT_EQ(out[0].input.move_x, first.move_x);
+
+    buffer.ConsumeTick(out);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0].input.sequence, 3u);
+
+    EXPECT_EQ(buffer.Push(lost, 5 * kTick), InputJitterBuffer::PushResult::Late);
+    EXPECT_EQ(buffer.Push(lost, 5 * kTick), InputJitterBuffer::PushResult::Late);
+    const auto& stats = buffer.GetStats();
+    EXPECT_EQ(stats.replayed, 1u);
+    EXPECT_EQ(stats.corrections, 1u);   // Settled once
+    EXPECT_EQ(stats.stall_ticks, 2u);
+
+    InputBufferSummary summary;
+    summary.Add(buffer);
+    EXPECT_DOUBLE_EQ(summary.CorrectionRate(), 1.0 / 3.0);
+}
+
+// [SEQUENCE: MVP19-237] Target depth rises with measured jitter, and after the network calms down falls back and
+// the surplus is drained.
+TEST(InputJitterBufferTest, DepthAdaptsToJitter) {
+    InputJitterBuffer buffer;
+    std::vector<InputJitterBuffer::ConsumedInput> out;
+    std::vector<Delivery> deliveries = SimulateNetwork(600, 40.0, 1.0, 1);
+    for (const auto& d : SimulateNetwork(900, 40.0, 120.0, 2, 600)) deliveries.push_back(d);
+    for (const auto& d : SimulateNetwork(1800, 40.0, 1.0, 3, 1500)) deliveries.push_back(d);
+    std::stable_sort(deliveries.begin(), deliveries.end(),
+                     [](const Delivery& a, const Delivery& b) { return a.arrival < b.arrival; });
+
+    size_t calm_target = 0, stormy_target = 0;
+    uint32_t expected = 0;
+    size_t next_delivery = 0;
+    for (int tick = 0; tick < 3400; ++tick) {
+        const double now = tick * kTick + 0.5 * kTick;
+        while (next_delivery < deliveries.size() && deliveries[next_delivery].arrival <= now) {
+            buffer.Push(deliveries[next_delivery].input, deliveries[next_delivery].arrival);
+            ++next_delivery;
+        }
+        buffer.ConsumeTick(out);
+        for (const auto& consumed : out) {
+            EXPECT_EQ(consumed.input.sequence, expected++);
+        }
+        if (tick == 590) calm_target = buffer.GetTargetDepth();
+        if (tick == 1490) stormy_target = buffer.GetTargetDepth();
+    }
+
+    const auto& stats = buffer.GetStats();
+    EXPECT_LE(calm_target, 2u);
+    EXPECT_GE(stormy_target, calm_target + 4);
+    EXPECT_LE(stormy_target, buffer.GetConfig().max_depth);
+    EXPECT_LE(buffer.GetTargetDepth(), 2u);
+    EXPECT_LE(buffer.GetBufferedCount(), 3u);
+    EXPECT_GT(stats.drained, 0u);
+    EXPECT_EQ(stats.consumed, expected);
+}
+
+// [SEQUENCE: MVP19-238] The server, consuming jittered and reordered inputs through the buffer, passes through
+// exactly the states the client predicted for each input - no divergence to correct.
+TEST(InputJitterBufferTest, ResimulationMatchesClientPrediction) {
+    std::vector<MoveState> predicted(1);   // predicted[n] = client state after inputs 0..n-1
+    for (uint32_t i = 0; i < 1200; ++i) {
+        predicted.push_back(StepMovement(predicted.back(), MakeInput(i)));
+    }
+    bool jumped = false;
+    for (const auto& state : predicted) jumped |= state.position.y > 0.5f;
+    EXPECT_TRUE(jumped);
+
+    InputJitterBufferConfig config;
+    config.max_wait_ticks = 30;   // Longer than any delay below, so nothing is ever replayed
+    config.first_sequence = 0;
+    InputJitterBuffer buffer(config);
+    const auto deliveries = SimulateNetwork(1200, 30.0, 90.0, 4);
+    std::vector<InputJitterBuffer::ConsumedInput> out;
+    MoveState server;
+    uint32_t applied = 0;
+    size_t next_delivery = 0;
+    for (int tick = 0; applied < 1200 && tick < 1400; ++tick) {
+        const double now = tick * kTick + 0.25 * kTick;
+        while (next_delivery < deliveries.size() && deliveries[next_delivery].arrival <= now) {
+            buffer.Push(deliveries[next_delivery].input, deliveries[next_delivery].arrival);
+            ++next_delivery;
+        }
+        buffer.ConsumeTick(out);
+        for (const auto& consumed : out) {
+            ASSERT_EQ(consumed.input.sequence, applied);
+            server = StepMovement(server, consumed.input);
+            ++applied;
+            ASSERT_EQ(server.position.x, predicted[applied].position.x) << applied;
+            ASSERT_EQ(server.position.y, predicted[applied].position.y) << applied;
+            ASSERT_EQ(server.position.z, predicted[applied].position.z) << applied;
+            ASSERT_EQ(server.velocity.x, predicted[applied].velocity.x) << applied;
+        }
+    }
+    EXPECT_EQ(applied, 1200u);
+    EXPECT_EQ(buffer.GetStats().replayed, 0u);
+    EXPECT_GT(buffer.GetTargetDepth(), 2u);   // 90 ms of jitter needs a deeper buffer than the default
+}
+
+// [SEQUENCE: MVP19-453] A player placed away from the origin is resimulated from where it was placed, and a
+// Reset part-way re-places it: the server follows the client's prediction from each placement, not from (0,0,0).
+TEST(InputJitterBufferTest, ResimulationStartsFromThePlayersState) {
+    MoveState spawn;
+    spawn.position = mmorpg::core::utils::Vector3(250.0f, 0.0f, -120.0f);
+    spawn.yaw = 1.0f;
+    MoveState teleport;
+    teleport.position = mmorpg::core::utils::Vector3(-40.0f, 0.0f, 300.0f);
+
+    InputJitterBufferConfig config;
+    config.first_sequence = 0;
+    ResimulatedMovement movement(spawn, config);
+    std::vector<InputJitterBuffer::ConsumedInput> scratch;
+    MoveState predicted = spawn;
+    for (uint32_t i = 0; i < 120; ++i) {
+        if (i == 60) {
+            movement.Reset(teleport);
+            predicted = teleport;
+        }
+        movement.GetBuffer().Push(MakeInput(i), i * kTick);
+        ASSERT_TRUE(movement.AdvanceTick(scratch)) << i;
+        predicted = StepMovement(predicted, MakeInput(i));
+        ASSERT_EQ(movement.GetState().position.x, predicted.position.x) << i;
+        ASSERT_EQ(movement.GetState().position.z, predicted.position.z) << i;
+        EXPECT_EQ(movement.GetLastProcessedInput(), i);
+        if (i == 59) {
+            EXPECT_GT(movement.GetState().position.x, 200.0f);   // Near the spawn point, nowhere near the origin
+        }
+    }
+    EXPECT_GT(movement.GetState().position.z, 250.0f);
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include "game/world/grid/interest_manager.h"
+#include <algorithm>
+#include <map>
+#include <random>
+
+using namespace mmorpg::game::world::grid;
+using mmorpg::core::ecs::EntityId;
+using mmorpg::core::utils::Vector3;
+
+// [SEQUENCE: MVP19-190] Test fixture: a 10 m grid with the grid and interest manager updated together per entity,
+// the way GridSpatialSystem drives them.
+class InterestManagerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        WorldGrid::Config grid_config;
+        grid_config.cell_size = 10.0f;
+        grid_config.grid_width = 50;
+        grid_config.grid_height = 50;
+        grid = std::make_unique<WorldGrid>(grid_config);
+    }
+
+    void MakeManager(const InterestManager::Config& config) {
+        interest = std::make_unique<InterestManager>(*grid, config);
+    }
+
+    void Spawn(EntityId entity, const Vector3& position) {
+        grid->AddEntity(entity, position);
+        interest->AddEntity(entity, position);
+        positions[entity] = position;
+    }
+
+    void Move(EntityId entity, const Vector3& position) {
+        grid->UpdateEntity(entity, positions[entity], position);
+        interest->UpdateEntity(entity, position);
+        positions[entity] = position;
+    }
+
+    std::vector<EntityId> Due(EntityId observer, uint32_t tick, size_t cost = 16) {
+        std::vector<EntityId> due;
+        interest->CollectDue(observer, tick, [cost](EntityId) { return cost; }, due);
+        return due;
+    }
+
+    std::unique_ptr<WorldGrid> grid;
+    std::unique_ptr<InterestManager> interest;
+    std::map<EntityId, Vector3> positions;
+};
+
+// [SEQUENCE: MVP19-191] After a random walk with many cell crossings, every observer's incrementally maintained
+// set equals a from-scratch scan of its cell window.
+TEST_F(InterestManagerTest, IncrementalSetsMatchWindowScan) {
+    InterestManager::Config config;
+    config.view_cell_range = 2;
+    MakeManager(config);
+
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> coord(0.0f, 499.0f);
+    std::uniform_real_distribution<float> step(-6.0f, 6.0f);
+    for (EntityId entity = 1; entity <= 300; ++entity) {
+        Spawn(entity, {coord(rng), coord(rng), 0.0f});
+    }
+    for (EntityId observer = 1; observer <= 40; ++observer) {
+        interest->AddObserver(observer);
+    }
+    for (int round = 0; round < 50; ++round) {
+        for (EntityId entity = 1; entity <= 300; ++entity) {
+            auto p = positions[entity];
+            Move(entity, {std::clamp(p.x + step(rng), 0.0f, 499.0f), std::clamp(p.y + step(rng), 0.0f, 499.0f), 0.0f});
+        }
+    }
+    EXPECT_GT(interest->GetStats().cell_crossings, 1000u);
+
+    for (EntityId observer = 1; observer <= 40; ++observer) {
+        const auto center = grid->GetCellCoordinates(positions[observer]);
+        size_t expected = 0;
+        for (const auto& [entity, position] : positions) {
+            const auto cell = grid->GetCellCoordinates(position);
+            const bool in_window = entity != observer && std::abs(cell.first - center.first) <= 2 &&
+                                   std::abs(cell.second - center.second) <= 2;
+            EXPECT_EQ(interest->IsInterested(observer, entity), in_window) << observer << " -> " << entity;
+            expected += in_window;
+        }
+        EXPECT_EQ(interest->GetInterestSetSize(observer), expected);
+    }
+}
+
+// [SEQUENCE: MVP19-192] Each tier is sent at its own interval; a party member or the current target is High even
+// outside the view window, and unpinning drops it again.
+TEST_F(InterestManagerTest, TiersSetUpdateRateAndPinsStayHigh) {
+    InterestManager::Config config;
+    config.view_cell_range = 15;
+    config.view_distance = 150.0f;
+    MakeManager(config);
+
+    Spawn(1, {250, 250, 0});    // Observer
+    Spawn(2, {260, 250, 0});    // 10 m: High
+    Spawn(3, {310, 250, 0});    // 60 m: Medium
+    Spawn(4, {370, 250, 0});    // 120 m: Low
+    Spawn(5, {10, 10, 0});      // Out of view, party member
+    Spawn(6, {490, 490, 0});    // Out of view, current target
+    interest->AddObserver(1);
+    interest->SetPartyMembers(1, {5});
+    interest->SetCurrentTarget(1, 6);
+
+    std::map<EntityId, int> sends;
+    for (uint32_t tick = 1; tick <= 36; ++tick) {
+        for (auto target : Due(1, tick)) {
+            ++sends[target];
+        }
+    }
+    EXPECT_EQ(sends[2], 36);
+    EXPECT_EQ(sends[3], 12);   // First tick, then every third
+    EXPECT_EQ(sends[4], 3);    // First tick, then every twelfth
+    EXPECT_EQ(sends[5], 36);
+    EXPECT_EQ(sends[6], 36);
+
+    interest->SetPartyMembers(1, {});
+    interest->SetCurrentTarget(1, mmorpg::core::ecs::INVALID_ENTITY);
+    EXPECT_FALSE(interest->IsInterested(1, 5));
+    EXPECT_FALSE(interest->IsInterested(1, 6));
+}
+
+// [SEQUENCE: MVP19-193] Over budget, the most overdue targets go first and deferred ones catch up: with room
+// for ten of forty each tick, everyone is sent once every four ticks.
+TEST_F(InterestManagerTest, ByteBudgetDefersAndRotates) {
+    InterestManager::Config config;
+    config.view_cell_range = 2;
+    config.budget_bytes_per_tick = 1000;
+    MakeManager(config);
+
+    Spawn(1, {250, 250, 0});
+    for (EntityId entity = 100; entity < 140; ++entity) {
+        Spawn(entity, {250.0f + static_cast<float>(entity - 100) * 0.25f, 255, 0});
+    }
+    interest->AddObserver(1);
+
+    std::map<EntityId, int> sends;
+    for (uint32_t tick = 1; tick <= 40; ++tick) {
+        const auto due = Due(1, tick, 100);
+        EXPECT_EQ(due.size(), 10u);
+        for (auto target : due) {
+            ++sends[target];
+        }
+    }
+    for (EntityId entity = 100; entity < 140; ++entity) {
+        EXPECT_EQ(sends[entity], 10) << entity;
+    }
+    EXPECT_EQ(interest->GetStats().sent, 400u);
+    EXPECT_EQ(interest->GetStats().bytes, 40000u);
+}
+
+// [SEQUENCE: MVP19-417] A pinned entity that despawns leaves no trace in its observers' pins, so logging an
+// observer out or re-pinning afterwards does not touch pin lists that no longer exist.
+TEST_F(InterestManagerTest, DespawnedPinThenLogout) {
+    InterestManager::Config config;
+    config.view_cell_range = 2;
+    MakeManager(config);
+
+    Spawn(1, {250, 250, 0});    // Observer, logs out
+    Spawn(2, {10, 10, 0});      // Pinned by both observers, despawns
+    Spawn(3, {490, 490, 0});    // Pinned by both observers
+    Spawn(4, {255, 250, 0});    // Observer, re-pins
+    interest->AddObserver(1);
+    interest->AddObserver(4);
+    interest->SetPartyMembers(1, {2, 3});
+    interest->SetCurrentTarget(1, 2);
+    interest->SetPartyMembers(4, {2, 3});
+    ASSERT_TRUE(interest->IsInterested(1, 2));
+
+    grid->RemoveEntity(2);
+    interest->RemoveEntity(2);
+    EXPECT_FALSE(interest->IsInterested(1, 2));
+    EXPECT_FALSE(interest->IsInterested(4, 2));
+
+    grid->RemoveEntity(1);
+    interest->RemoveEntity(1);
+    EXPECT_FALSE(interest->IsInterested(4, 1));
+    EXPECT_TRUE(interest->IsInterested(4, 3));
+
+    interest->SetPartyMembers(4, {});
+    interest->SetCurrentTarget(4, 3);
+    EXPECT_TRUE(interest->IsInterested(4, 3));
+    interest->SetCurrentTarget(4, mmorpg::core::ecs::INVALID_ENTITY);
+    EXPECT_FALSE(interest->IsInterested(4, 3));
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "game/world/octree/loose_octree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace mmorpg::game::world;
+using mmorpg::core::ecs::EntityId;
+using mmorpg::core::utils::Vector3;
+
+namespace {
+
+octree::LooseOctree::Config World() {
+    octree::LooseOctree::Config config;
+    config.world_min = {-2000, -2000, -500};
+    config.world_max = {2000, 2000, 500};
+    return config;
+}
+
+std::vector<EntityId> Sorted(std::vector<EntityId> ids) {
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+// Brute-force references for the queries, over the positions the test tracks
+class Reference {
+public:
+    std::unordered_map<EntityId, Vector3> positions;
+
+    template <typename Pred>
+    std::vector<EntityId> Where(Pred pred) const {
+        std::vector<EntityId> ids;
+        for (const auto& [id, p] : positions) {
+            if (pred(p)) ids.push_back(id);
+        }
+        return Sorted(ids);
+    }
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-354] Radius, box, ray and frustum queries match a brute-force scan while entities move by
+// small steps, jump across the world, leave it and get removed, so leaves split, merge and relocate throughout.
+TEST(LooseOctreeTest, QueriesMatchBruteForceUnderMovement) {
+    auto config = World();
+    config.max_entities_per_node = 8;
+    octree::LooseOctree tree(config);
+    Reference reference;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> xy(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> z(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> step(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (EntityId id = 1; id <= 4000; ++id) {
+        reference.positions[id] = {xy(rng), xy(rng), z(rng)};
+        tree.AddEntity(id, reference.positions[id]);
+    }
+
+    for (int round = 0; round < 20; ++round) {
+        for (auto it = reference.positions.begin(); it != reference.positions.end();) {
+            const EntityId id = it->first;
+            const int roll = static_cast<int>(rng() % 100);
+            if (roll == 0) {
+                tree.RemoveEntity(id);
+                it = reference.positions.erase(it);
+                continue;
+            }
+            Vector3 next = roll < 3 ? Vector3(xy(rng), xy(rng), z(rng))
+                                    : Vector3(it->second.x + step(rng), it->second.y + step(rng), it->second.z + step(rng));
+            tree.UpdateEntity(id, it->second, next);
+            const bool inside = std::abs(next.x) <= 2000 && std::abs(next.y) <= 2000 && std::abs(next.z) <= 500;
+            if (!inside) {
+                it = reference.positions.erase(it);
+                continue;
+            }
+            it->second = next;
+            ++it;
+        }
+        ASSERT_EQ(tree.GetEntityCount(), reference.positions.size());
+
+        for (int query = 0; query < 10; ++query) {
+            const Vector3 c{xy(rng), xy(rng), z(rng)};
+            const float r = 50.0f + 300.0f * std::abs(unit(rng));
+            EXPECT_EQ(Sorted(tree.GetEntitiesInRadius(c, r)), reference.Where([&](const Vector3& p) {
+                const float dx = p.x - c.x, dy = p.y - c.y, dz = p.z - c.z;
+                return dx * dx + dy * dy + dz * dz <= r * r;
+            }));
+
+            const Vector3 lo{c.x - r, c.y - r, c.z - r / 4}, hi{c.x + r, c.y + r / 2, c.z + r / 4};
+            EXPECT_EQ(Sorted(tree.GetEntitiesInBox(lo, hi)), reference.Where([&](const Vector3& p) {
+                return p.x >= lo.x && p.x <= hi.x && p.y >= lo.y && p.y <= hi.y && p.z >= lo.z && p.z <= hi.z;
+            }));
+
+            Vector3 d{unit(rng), unit(rng), 0.2f * unit(rng)};
+            const float len = std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+            d = {d.x / len, d.y / len, d.z / len};
+            const float fov = 0.3f + std::abs(unit(rng));
+            EXPECT_EQ(Sorted(tree.GetEntitiesInFrustum(c, d, fov, 10.0f, 800.0f)), reference.Where([&](const Vector3& p) {
+                const float vx = p.x - c.x, vy = p.y - c.y, vz = p.z - c.z;
+                const float along = vx * d.x + vy * d.y + vz * d.z;
+                if (along < 10.0f - config.entity_radius || along > 800.0f + config.entity_radius) return false;
+                const float perp = std::sqrt(std::max(vx * vx + vy * vy + vz * vz - along * along, 0.0f));
+                return perp * std::cos(fov / 2) - along * std::sin(fov / 2) <= config.entity_radius;
+            }));
+        }
+    }
+
+    const auto stats = tree.GetStats();
+    EXPECT_GT(stats.splits, 0u);
+    EXPECT_GT(stats.merges, 0u);
+    EXPECT_GT(stats.relocations, 0u);
+}
+
+// [SEQUENCE: MVP19-355] Ray queries return the entities the segment passes within entity_radius of, nearest
+// first, including along axis-parallel rays.
+TEST(LooseOctreeTest, RayReturnsHitsNearestFirst) {
+    octree::LooseOctree tree(World());
+    for (EntityId id = 1; id <= 40; ++id) {
+        tree.AddEntity(id, {static_cast<float>(id) * 25.0f, 0.3f, 0.0f});     // On the ray, within radius
+        tree.AddEntity(id + 100, {static_cast<float>(id) * 25.0f, 2.0f, 0.0f});   // Beside it
+    }
+    const auto hits = tree.GetEntitiesAlongRay({0, 0, 0}, {1, 0, 0}, 510.0f);
+    std::vector<EntityId> expected;
+    for (EntityId id = 1; id <= 20; ++id) expected.push_back(id);
+    EXPECT_EQ(hits, expected);
+
+    const auto backwards = tree.GetEntitiesAlongRay({1000, 0, 0}, {-2, 0, 0}, 60.0f);
+    EXPECT_EQ(backwards, (std::vector<EntityId>{40, 39, 38}));
+    EXPECT_TRUE(tree.GetEntitiesAlongRay({0, 0, 0}, {0, 0, 0}, 100.0f).empty());
+}
+
+// [SEQUENCE: MVP19-356] Looseness absorbs jitter across node boundaries: entities pacing back and forth over a
+// split plane never change leaves, where a tight octree would relocate them on every crossing.
+TEST(LooseOctreeTest, SmallMovesAcrossBoundariesDoNotRelocate) {
+    octree::LooseOctree tree(World());
+    for (EntityId id = 1; id <= 2000; ++id) {
+        tree.AddEntity(id, {static_cast<float>(id % 40) * 50.0f - 1000.0f, static_cast<float>(id / 40) * 50.0f - 1000.0f, 0});
+    }
+    size_t nodes_before, leaves_before, entities_before;
+    tree.GetTreeStats(nodes_before, leaves_before, entities_before);
+    const auto before = tree.GetStats();
+
+    for (int tick = 0; tick < 50; ++tick) {
+        const float offset = (tick % 2 == 0) ? 0.5f : -0.5f;
+        for (EntityId id = 1; id <= 2000; ++id) {
+            const Vector3 home{static_cast<float>(id % 40) * 50.0f - 1000.0f, static_cast<float>(id / 40) * 50.0f - 1000.0f, 0};
+            tree.UpdateEntity(id, home, {home.x + offset, home.y + offset, offset});
+        }
+    }
+    const auto after = tree.GetStats();
+    EXPECT_EQ(after.relocations, before.relocations);
+    EXPECT_EQ(after.splits, before.splits);
+    EXPECT_EQ(after.merges, before.merges);
+
+    size_t nodes, leaves, entities;
+    tree.GetTreeStats(nodes, leaves, entities);
+    EXPECT_EQ(nodes, nodes_before);
+    EXPECT_EQ(entities, 2000u);
+    EXPECT_EQ(tree.GetEntitiesInRadius({-950.5f, -1000.5f, -0.5f}, 1.0f), (std::vector<EntityId>{1}));
+}
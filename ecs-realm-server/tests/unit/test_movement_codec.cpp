@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "network/movement_codec.h"
+
+#include <cmath>
+#include <random>
+
+using namespace mmorpg::network;
+
+namespace {
+
+constexpr float kTwoPi = 6.28318530717958647692f;
+
+MovementBatch MakeRandomBatch(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> ground(-3000.0f, 9000.0f);
+    std::uniform_real_distribution<float> height(-100.0f, 800.0f);
+    std::uniform_real_distribution<float> angle(-2.0f * kTwoPi, 2.0f * kTwoPi);
+    std::uniform_real_distribution<float> speed(-40.0f, 40.0f);
+    std::uniform_int_distribution<uint64_t> id_step(1, 5000);
+
+    MovementBatch batch;
+    batch.Resize(count);
+    uint64_t id = 1;
+    for (size_t i = 0; i < count; ++i) {
+        id += id_step(rng);
+        batch.entity_ids[i] = i % 7 == 3 ? id / 2 : id;        // Not sorted everywhere
+        batch.sequences[i] = 0xFFFFFF00u + static_cast<uint32_t>(i * 3);   // Wraps within the batch
+        batch.x[i] = ground(rng);
+        batch.y[i] = ground(rng);
+        batch.z[i] = height(rng);
+        batch.yaw[i] = angle(rng);
+        const bool moving = i % 4 != 0;
+        batch.vx[i] = moving ? speed(rng) : 0.0f;
+        batch.vy[i] = moving ? speed(rng) : 0.0f;
+        batch.vz[i] = moving ? speed(rng) * 0.1f : 0.0f;
+    }
+    return batch;
+}
+
+float AngleError(float a, float b) {
+    const float diff = std::fmod(std::fabs(a - b), kTwoPi);
+    return std::min(diff, kTwoPi - diff);
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-178] Every decoded field is within half a quantization step of its input (plus float rounding
+// at large coordinates), ids and sequence numbers are exact, and the batch size is not a multiple of four so the
+// scalar tail is covered alongside the SIMD body.
+TEST(MovementCodecTest, RoundTripStaysWithinErrorBounds) {
+    MovementCodecConfig config;
+    MovementCodec encoder(config);
+    MovementCodec decoder(config);
+    const auto input = MakeRandomBatch(503, 11);
+
+    std::vector<std::byte> packet;
+    encoder.Encode(input, packet);
+    MovementBatch output;
+    ASSERT_TRUE(decoder.Decode(packet.data(), packet.size(), output));
+    ASSERT_EQ(output.Size(), input.Size());
+
+    const float ground_step = config.cell_size / 65535.0f;
+    const float height_step = (config.max_height - config.min_height) / 65535.0f;
+    const float yaw_step = kTwoPi / 256.0f;
+    for (size_t i = 0; i < input.Size(); ++i) {
+        SCOPED_TRACE(i);
+        EXPECT_EQ(output.entity_ids[i], input.entity_ids[i]);
+        EXPECT_EQ(output.sequences[i], input.sequences[i]);
+        EXPECT_LE(std::fabs(output.x[i] - input.x[i]), ground_step * 0.5f + std::fabs(input.x[i]) * 2e-6f);
+        EXPECT_LE(std::fabs(output.y[i] - input.y[i]), ground_step * 0.5f + std::fabs(input.y[i]) * 2e-6f);
+        EXPECT_LE(std::fabs(output.z[i] - input.z[i]), height_step * 0.5f + 1e-4f);
+        EXPECT_LE(AngleError(output.yaw[i], input.yaw[i]), yaw_step * 0.5f + 1e-5f);
+        EXPECT_LE(std::fabs(output.vx[i] - input.vx[i]), MovementCodec::kVelocityResolution * 0.5f + 1e-5f);
+        EXPECT_LE(std::fabs(output.vy[i] - input.vy[i]), MovementCodec::kVelocityResolution * 0.5f + 1e-5f);
+        EXPECT_LE(std::fabs(output.vz[i] - input.vz[i]), MovementCodec::kVelocityResolution * 0.5f + 1e-5f);
+    }
+    // 7 fixed bytes plus velocity on three quarters of the records, varints and flags on top.
+    EXPECT_LT(packet.size(), input.Size() * 24);
+}
+
+// [SEQUENCE: MVP19-179] Out-of-range heights and speeds saturate instead of wrapping.
+TEST(MovementCodecTest, SaturatesOutOfRangeValues) {
+    MovementCodec codec;
+    MovementBatch input;
+    input.Resize(5);
+    for (size_t i = 0; i < 5; ++i) {
+        input.entity_ids[i] = i + 1;
+        input.z[i] = i % 2 ? 1e6f : -1e6f;
+        input.vx[i] = i % 2 ? 1e4f : -1e4f;
+    }
+    std::vector<std::byte> packet;
+    codec.Encode(input, packet);
+    MovementBatch output;
+    ASSERT_TRUE(codec.Decode(packet.data(), packet.size(), output));
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_NEAR(output.z[i], i % 2 ? codec.GetConfig().max_height : codec.GetConfig().min_height, 0.05f);
+        EXPECT_NEAR(output.vx[i], i % 2 ? 327.67f : -327.67f, 0.01f);
+    }
+}
+
+// [SEQUENCE: MVP19-180] Every truncation of a valid packet is rejected without reading past the end.
+TEST(MovementCodecTest, RejectsTruncatedPackets) {
+    MovementCodec codec;
+    std::vector<std::byte> packet;
+    codec.Encode(MakeRandomBatch(9, 3), packet);
+    MovementBatch output;
+    for (size_t size = 0; size < packet.size(); ++size) {
+        EXPECT_FALSE(codec.Decode(packet.data(), size, output)) << size;
+    }
+    EXPECT_TRUE(codec.Decode(packet.data(), packet.size(), output));
+}
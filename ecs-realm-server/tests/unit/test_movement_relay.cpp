@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "network/movement_relay.h"
+#include "network/packet_serializer.h"
+#include "proto/game.pb.h"
+
+#include <map>
+
+using namespace mmorpg::network;
+
+namespace {
+
+MovementInput MakeInput(uint64_t player_id, uint32_t session_id, float x) {
+    MovementInput input;
+    input.player_id = player_id;
+    input.session_id = session_id;
+    input.sample.position[0] = x;
+    return input;
+}
+
+struct RelayFixture {
+    explicit RelayFixture(MovementRelay::Config config = {})
+        : relay(config, [this](uint64_t session_id, const SharedPacketBuffer& packet) {
+              PacketSerializer::PacketEnvelope envelope;
+              ASSERT_TRUE(PacketSerializer::ParseEnvelope(packet->data() + 4, packet->size() - 4, envelope));
+              ASSERT_EQ(envelope.type, mmorpg::proto::PACKET_ENTITY_UPDATE_BATCH);
+              ASSERT_EQ(batches.count(session_id), 0u);   // One packet per session per tick
+              ASSERT_TRUE(batches[session_id].ParseFromArray(envelope.payload, static_cast<int>(envelope.payload_size)));
+          }) {}
+
+    void Tick(const std::vector<MovementInput>& inputs, std::chrono::steady_clock::time_point now) {
+        batches.clear();
+        relay.Tick(inputs, now);
+    }
+
+    std::map<uint64_t, mmorpg::proto::EntityUpdateBatch> batches;
+    MovementRelay relay;
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-449] Each mover's update reaches the other players within the radius, in one batch per
+// session, and is encoded once however many players see it.
+TEST(MovementRelayTest, BatchesEachUpdateToNearbyPlayersOnly) {
+    RelayFixture fixture;
+    const auto now = std::chrono::steady_clock::now();
+    fixture.Tick({MakeInput(1, 11, 0.0f), MakeInput(2, 12, 50.0f), MakeInput(3, 13, 90.0f), MakeInput(4, 14, 500.0f)},
+                 now);
+
+    // 1 sees 2 and 3; 2 sees 1 and 3; 3 sees 1 and 2; 4 is alone
+    ASSERT_EQ(fixture.batches.size(), 3u);
+    ASSERT_EQ(fixture.batches[11].updates_size(), 2);
+    EXPECT_EQ(fixture.batches[11].updates(0).entity_id(), 2u);
+    EXPECT_FLOAT_EQ(fixture.batches[11].updates(0).movement().position().x(), 50.0f);
+    EXPECT_EQ(fixture.batches[11].updates(1).entity_id(), 3u);
+    EXPECT_EQ(fixture.batches[12].updates_size(), 2);
+    EXPECT_EQ(fixture.batches[13].updates_size(), 2);
+    EXPECT_EQ(fixture.batches.count(14), 0u);
+
+    const auto& stats = fixture.relay.GetLastTickStats();
+    EXPECT_EQ(stats.records_encoded, 4u);
+    EXPECT_EQ(stats.record_references, 6u);
+    EXPECT_EQ(stats.packets_built, 3u);
+}
+
+// [SEQUENCE: MVP19-450] A player who stopped sending still receives others' movement at its last position until
+// forget_after passes without input.
+TEST(MovementRelayTest, IdlePlayersReceiveUntilForgotten) {
+    MovementRelay::Config config;
+    config.forget_after = std::chrono::milliseconds(1000);
+    RelayFixture fixture(config);
+    const auto start = std::chrono::steady_clock::now();
+    fixture.Tick({MakeInput(1, 11, 0.0f), MakeInput(2, 12, 10.0f)}, start);
+
+    fixture.Tick({MakeInput(2, 12, 20.0f)}, start + std::chrono::milliseconds(500));
+    ASSERT_EQ(fixture.batches.size(), 1u);
+    ASSERT_EQ(fixture.batches[11].updates_size(), 1);
+    EXPECT_FLOAT_EQ(fixture.batches[11].updates(0).movement().position().x(), 20.0f);
+
+    fixture.Tick({MakeInput(2, 12, 30.0f)}, start + std::chrono::milliseconds(1500));
+    EXPECT_TRUE(fixture.batches.empty());
+    EXPECT_EQ(fixture.relay.GetTrackedPlayerCount(), 1u);
+}
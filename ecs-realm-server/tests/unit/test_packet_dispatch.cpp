@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "network/packet_dispatch.h"
+#include "network/packet_handler.h"
+#include "network/packet_serializer.h"
+#include "proto/game.pb.h"
+
+#include <cstring>
+
+using namespace mmorpg::network;
+
+// [SEQUENCE: MVP19-21] Every dispatchable message resolves to a unique slot that round-trips through its PacketType.
+TEST(PacketDispatchTest, SlotTableIsConsistent) {
+    static_assert(PacketSlot(mmorpg::proto::PACKET_UNKNOWN) == kInvalidPacketSlot);
+    static_assert(PacketSlot(mmorpg::proto::PACKET_MOVEMENT_UPDATE) == PacketSlotOf<mmorpg::proto::MovementUpdate>());
+
+    for (size_t slot = 0; slot < kPacketSlotCount; ++slot) {
+        ASSERT_NE(GetPacketPrototype(static_cast<int>(slot)), nullptr);
+    }
+    EXPECT_EQ(PacketSlot(static_cast<mmorpg::proto::PacketType>(9999)), kInvalidPacketSlot);
+}
+
+// [SEQUENCE: MVP19-22] The in-place envelope parser yields the same type and payload bytes as the full Packet parse.
+TEST(PacketDispatchTest, EnvelopeMatchesFullDeserialize) {
+    mmorpg::proto::CombatAction action;
+    action.set_attacker_id(7);
+    action.set_target_id(9);
+    action.set_skill_id(1001);
+
+    auto framed = PacketSerializer::Serialize(action);
+    ASSERT_GT(framed.size(), 4u);
+    const std::byte* body = framed.data() + 4;
+    const size_t body_size = framed.size() - 4;
+
+    PacketSerializer::PacketEnvelope envelope;
+    ASSERT_TRUE(PacketSerializer::ParseEnvelope(body, body_size, envelope));
+    auto packet = PacketSerializer::Deserialize(body, body_size);
+    ASSERT_NE(packet, nullptr);
+
+    EXPECT_EQ(envelope.type, packet->header().type());
+    ASSERT_EQ(envelope.payload_size, packet->payload().size());
+    EXPECT_EQ(0, memcmp(envelope.payload, packet->payload().data(), envelope.payload_size));
+}
+
+// [SEQUENCE: MVP19-23] Typed handlers receive the concrete message, and the cached message is reused across packets.
+TEST(PacketDispatchTest, TypedHandlerReusesCachedMessage) {
+    PacketHandler handler;
+    std::vector<uint32_t> sequences;
+    const google::protobuf::Message* first_seen = nullptr;
+    handler.RegisterHandler<mmorpg::proto::MovementUpdate>(
+        [&](std::shared_ptr<Session>, const mmorpg::proto::MovementUpdate& movement) {
+            if (!first_seen) first_seen = &movement;
+            EXPECT_EQ(first_seen, &movement);
+            sequences.push_back(movement.sequence_number());
+        });
+
+    PacketMessageCache cache;
+    for (uint32_t seq = 1; seq <= 3; ++seq) {
+        mmorpg::proto::MovementUpdate movement;
+        movement.set_sequence_number(seq);
+        auto framed = PacketSerializer::Serialize(movement);
+
+        PacketSerializer::PacketEnvelope envelope;
+        ASSERT_TRUE(PacketSerializer::ParseEnvelope(framed.data() + 4, framed.size() - 4, envelope));
+        handler.Dispatch(nullptr, envelope.type, envelope.payload, envelope.payload_size, cache);
+    }
+
+    EXPECT_EQ(sequences, (std::vector<uint32_t>{1, 2, 3}));
+}
+
+// [SEQUENCE: MVP19-433] Packets of an unregistered or unknown type are dropped and counted, not handled
+TEST(PacketDispatchTest, UnhandledTypesAreCountedAndDropped) {
+    PacketHandler handler;
+    int handled = 0;
+    handler.RegisterHandler<mmorpg::proto::MovementUpdate>(
+        [&](std::shared_ptr<Session>, const mmorpg::proto::MovementUpdate&) { ++handled; });
+
+    PacketMessageCache cache;
+    mmorpg::proto::CombatAction action;
+    const std::string payload = action.SerializeAsString();
+    const auto* bytes = reinterpret_cast<const std::byte*>(payload.data());
+    for (int i = 0; i < 1000; ++i) {
+        handler.Dispatch(nullptr, mmorpg::proto::PACKET_COMBAT_ACTION, bytes, payload.size(), cache);
+        handler.Dispatch(nullptr, static_cast<mmorpg::proto::PacketType>(9999), bytes, payload.size(), cache);
+    }
+    EXPECT_EQ(handler.GetUnhandledCount(), 2000u);
+    EXPECT_EQ(handled, 0);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "game/systems/scheduling/parallel_iteration.h"
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+using namespace mmorpg::game::systems::scheduling;
+using mmorpg::core::ecs::EntityId;
+
+namespace {
+
+// A packed component array the way the ECS keeps one: dense data and entity ids, an entity-to-index map, and
+// removal by moving the last element into the hole
+template <typename T>
+class DenseArray {
+public:
+    void Add(EntityId entity, T value) {
+        index_[entity] = data_.size();
+        data_.push_back(value);
+        entities_.push_back(entity);
+    }
+
+    void Remove(EntityId entity) {
+        const size_t hole = index_.at(entity);
+        data_[hole] = data_.back();
+        entities_[hole] = entities_.back();
+        index_[entities_[hole]] = hole;
+        data_.pop_back();
+        entities_.pop_back();
+        index_.erase(entity);
+    }
+
+    uint32_t IndexOf(EntityId entity) const {
+        const auto it = index_.find(entity);
+        return it == index_.end() ? ComponentJoin::kMissing : static_cast<uint32_t>(it->second);
+    }
+
+    std::vector<T>& Data() { return data_; }
+    std::span<const EntityId> Entities() const { return entities_; }
+
+private:
+    std::vector<T> data_;
+    std::vector<EntityId> entities_;
+    std::unordered_map<EntityId, size_t> index_;
+};
+
+struct Big {
+    char bytes[4096];
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-397] Chunks cover every index exactly once, in ranges of the chunk size, on a pool and on
+// the calling thread alone; chunk sizes stay multiples of 16 elements and never drop below 64.
+TEST(ParallelIterationTest, ChunksCoverEveryIndexOnce) {
+    static_assert(ChunkSize<float>() == kChunkBytes / sizeof(float));
+    static_assert(ChunkSize<float, double, EntityId>() % 16 == 0);
+    static_assert(ChunkSize<Big>() == 64);
+
+    WorkStealingPool pool(3);
+    for (WorkStealingPool* executor : {&pool, static_cast<WorkStealingPool*>(nullptr)}) {
+        for (const size_t count : {size_t{0}, size_t{1}, size_t{63}, size_t{64}, size_t{1000}, size_t{100003}}) {
+            std::vector<std::atomic<int>> hits(count);
+            std::atomic<bool> aligned{true};
+            ParallelForChunks(executor, count, 64, [&](size_t begin, size_t end) {
+                if (begin % 64 != 0 || end - begin > 64 || (end - begin < 64 && end != count)) aligned = false;
+                for (size_t i = begin; i < end; ++i) hits[i].fetch_add(1);
+            });
+            EXPECT_TRUE(aligned.load());
+            for (const auto& hit : hits) ASSERT_EQ(hit.load(), 1) << "count " << count;
+        }
+    }
+}
+
+// [SEQUENCE: MVP19-398] A join pairs every entity present in both arrays, skips the ones missing from the
+// other, and after the first pass looks up only the entities whose element moved or is new.
+TEST(ParallelIterationTest, JoinLooksUpOnlyWhatMoved) {
+    DenseArray<float> velocities;
+    DenseArray<float> transforms;
+    for (EntityId id = 1; id <= 20000; ++id) {
+        velocities.Add(id, static_cast<float>(id));
+        if (id % 10 != 0) transforms.Add(id, 0.0f);   // Every tenth entity has no transform
+    }
+
+    WorkStealingPool pool(3);
+    ComponentJoin join;
+    std::atomic<size_t> lookups{0};
+    auto lookup = [&](EntityId entity) {
+        lookups.fetch_add(1);
+        return transforms.IndexOf(entity);
+    };
+    auto pass = [&] {
+        lookups = 0;
+        auto& velocity = velocities.Data();
+        auto& transform = transforms.Data();
+        join.ForEach(&pool, 256, velocities.Entities(), transforms.Entities(), lookup,
+                     [&](size_t i, size_t j) { transform[j] += velocity[i]; });
+        EXPECT_EQ(join.GetLastLookups(), lookups.load());
+    };
+
+    pass();
+    EXPECT_EQ(lookups.load(), 20000u);
+    pass();
+    EXPECT_EQ(lookups.load(), 2000u);   // Only the entities without a transform
+
+    // Removing transforms moves the last ones into the holes; a new velocity appends one driver element
+    for (EntityId id = 1; id <= 55; ++id) {
+        if (id % 10 != 0) transforms.Remove(id);
+    }
+    velocities.Add(20001, 20001.0f);
+    transforms.Add(20001, 0.0f);
+    pass();
+    EXPECT_EQ(lookups.load(), 2000u + 50u + 50u + 1u);   // Missing, moved, new
+    pass();
+    EXPECT_EQ(lookups.load(), 2050u);
+
+    // Every transform received its own entity's velocity once per pass it was paired in
+    auto& transform = transforms.Data();
+    const auto entities = transforms.Entities();
+    for (size_t j = 0; j < entities.size(); ++j) {
+        const float passes = entities[j] == 20001 ? 2.0f : 4.0f;
+        ASSERT_EQ(transform[j], passes * static_cast<float>(entities[j])) << "entity " << entities[j];
+    }
+}
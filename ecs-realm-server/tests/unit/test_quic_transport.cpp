@@ -0,0 +1,501 @@
+#include <gtest/gtest.h>
+
+#include "network/quic_connection.h"
+#include "network/quic_protocol_handler.h"
+#include "network/packet_handler.h"
+#include "network/packet_serializer.h"
+#include "network/session.h"
+#include "network/session_manager.h"
+#include "network/udp_link_simulator.h"
+#include "proto/auth.pb.h"
+
+#include <boost/asio/io_context.hpp>
+#include <arpa/inet.h>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace mmorpg::network;
+using Clock = QuicConnection::Clock;
+using Endpoint = QuicConnection::Endpoint;
+using namespace std::chrono_literals;
+
+namespace {
+
+QuicKeyPair MakeServerKey() {
+    QuicKeyPair key;
+    EXPECT_TRUE(quic_crypto::GenerateKeyPair(key));
+    return key;
+}
+
+struct Side {
+    std::map<uint64_t, std::vector<std::byte>> streams;
+    std::map<uint64_t, bool> finished;
+    std::vector<std::vector<std::byte>> datagrams;
+    std::vector<QuicEvent> events;   // data pointers cleared; payloads are in streams/datagrams
+
+    size_t Count(QuicEvent::Type type) const {
+        size_t count = 0;
+        for (const auto& event : events) count += event.type == type;
+        return count;
+    }
+
+    QuicConnection::EventSink Sink() {
+        return [this](const QuicEvent& event) {
+            if (event.type == QuicEvent::Type::StreamData) {
+                auto& bytes = streams[event.stream_id];
+                bytes.insert(bytes.end(), event.data, event.data + event.size);
+                if (event.fin) finished[event.stream_id] = true;
+            } else if (event.type == QuicEvent::Type::Datagram) {
+                datagrams.emplace_back(event.data, event.data + event.size);
+            }
+            QuicEvent copy = event;
+            copy.data = nullptr;
+            events.push_back(copy);
+        };
+    }
+};
+
+// [SEQUENCE: MVP19-276] A client and a lazily created server connection joined by simulated links, stepped in
+// simulated time. The client's address can be changed mid-connection and its sends can be dropped on demand.
+class QuicPair {
+public:
+    explicit QuicPair(std::chrono::milliseconds one_way = 20ms, QuicServerContext* shared_context = nullptr)
+        : own_context(shared_context ? nullptr : std::make_unique<QuicServerContext>(MakeServerKey())),
+          context(shared_context ? *shared_context : *own_context),
+          to_server(Conditions(one_way, 1)),
+          to_client(Conditions(one_way, 2)) {}
+
+    void Connect(const QuicResumption* resumption = nullptr) {
+        client = std::make_unique<QuicConnection>(config, context.GetStaticKey().public_key, server_endpoint, now,
+                                                  resumption);
+        client->Flush(now, ClientSink());
+    }
+
+    void Step(std::chrono::milliseconds dt) {
+        now += dt;
+        to_server.Deliver(now, [&](const std::byte* data, size_t size) { DeliverToServer(data, size); });
+        to_client.Deliver(now, [&](const std::byte* data, size_t size) {
+            client->OnDatagram(data, size, server_endpoint, now, client_side.Sink());
+        });
+        client->Update(now, ClientSink(), client_side.Sink());
+        if (server) server->Update(now, ServerSink(), server_side.Sink());
+    }
+
+    bool StepUntil(const std::function<bool()>& done, std::chrono::milliseconds limit = 5000ms,
+                   std::chrono::milliseconds dt = 1ms) {
+        for (auto elapsed = 0ms; elapsed < limit; elapsed += dt) {
+            if (done()) return true;
+            Step(dt);
+        }
+        return done();
+    }
+
+    void Handshake() {
+        Connect();
+        ASSERT_TRUE(StepUntil([&] {
+            return server && server->GetState() == QuicConnectionState::Established &&
+                   client->GetState() == QuicConnectionState::Established;
+        }));
+    }
+
+    void DeliverToServer(const std::byte* data, size_t size) {
+        if (!server) {
+            uint64_t destination = 0;
+            bool is_initial = false;
+            ASSERT_TRUE(quic_wire::PeekDestination(data, size, destination, is_initial));
+            ASSERT_TRUE(is_initial);
+            server = std::make_unique<QuicConnection>(config, context, client_endpoint, destination, now);
+        }
+        server->OnDatagram(data, size, client_endpoint, now, server_side.Sink());
+    }
+
+    QuicConnection::DatagramSink ClientSink() {
+        return [this](const Endpoint& to, const std::byte* data, size_t size) {
+            EXPECT_EQ(to, server_endpoint);
+            client_sent.emplace_back(data, data + size);
+            if (drop_client_sends) return;
+            if (drop_next_client_sends > 0) {
+                --drop_next_client_sends;
+                return;
+            }
+            to_server.Submit(data, size, now);
+        };
+    }
+
+    QuicConnection::DatagramSink ServerSink() {
+        return [this](const Endpoint& to, const std::byte* data, size_t size) {
+            server_destinations.push_back(to);
+            to_client.Submit(data, size, now);
+        };
+    }
+
+    static UdpLinkConditions Conditions(std::chrono::milliseconds latency, uint64_t seed) {
+        UdpLinkConditions conditions;
+        conditions.latency = latency;
+        conditions.seed = seed;
+        return conditions;
+    }
+
+    QuicConfig config;
+    std::unique_ptr<QuicServerContext> own_context;
+    QuicServerContext& context;
+    Clock::time_point now = Clock::time_point{} + 1h;
+    Endpoint server_endpoint{boost::asio::ip::make_address("10.0.0.1"), 8082};
+    Endpoint client_endpoint{boost::asio::ip::make_address("192.168.1.20"), 50000};
+    UdpLinkSimulator to_server;
+    UdpLinkSimulator to_client;
+    std::unique_ptr<QuicConnection> client;
+    std::unique_ptr<QuicConnection> server;
+    Side client_side;
+    Side server_side;
+    bool drop_client_sends = false;
+    size_t drop_next_client_sends = 0;
+    std::vector<std::vector<std::byte>> client_sent;
+    std::vector<Endpoint> server_destinations;
+};
+
+std::vector<std::byte> MakeBytes(size_t size, uint8_t seed) {
+    std::vector<std::byte> bytes(size);
+    for (size_t i = 0; i < size; ++i) bytes[i] = static_cast<std::byte>((seed + i * 7) & 0xFF);
+    return bytes;
+}
+
+constexpr uint64_t kMovementStream = 4;
+constexpr uint64_t kChatStream = 12;
+
+} // namespace
+
+// [SEQUENCE: MVP19-277] Chat lost on the wire does not hold back movement sent after it: movement lands one
+// one-way delay later, and the chat follows once loss recovery resends it.
+TEST(QuicTransportTest, LostStreamDoesNotBlockOtherStreams) {
+    QuicPair pair;
+    pair.Handshake();
+    EXPECT_FALSE(pair.client->IsResumed());
+
+    const auto chat = MakeBytes(3000, 1);
+    const auto movement = MakeBytes(48, 2);
+    pair.drop_client_sends = true;
+    ASSERT_TRUE(pair.client->SendStream(kChatStream, chat.data(), chat.size()));
+    pair.client->Flush(pair.now, pair.ClientSink());
+    pair.drop_client_sends = false;
+    ASSERT_TRUE(pair.client->SendStream(kMovementStream, movement.data(), movement.size()));
+    pair.client->Flush(pair.now, pair.ClientSink());
+
+    pair.Step(20ms);
+    EXPECT_EQ(pair.server_side.streams[kMovementStream], movement);
+    EXPECT_TRUE(pair.server_side.streams[kChatStream].empty());
+
+    ASSERT_TRUE(pair.StepUntil([&] { return pair.server_side.streams[kChatStream].size() == chat.size(); }));
+    EXPECT_EQ(pair.server_side.streams[kChatStream], chat);
+    EXPECT_GE(pair.client->GetStats().packets_lost, 1u);
+    EXPECT_GT(pair.client->GetStats().stream_bytes_retransmitted, 0u);
+
+    // Datagrams are delivered once and never retransmitted
+    const auto sample = MakeBytes(20, 3);
+    ASSERT_TRUE(pair.client->SendDatagram(sample.data(), sample.size()));
+    pair.client->Flush(pair.now, pair.ClientSink());
+    pair.Step(20ms);
+    ASSERT_EQ(pair.server_side.datagrams.size(), 1u);
+    EXPECT_EQ(pair.server_side.datagrams[0], sample);
+}
+
+// [SEQUENCE: MVP19-278] A new port on the same address is a NAT rebinding and keeps congestion state; a new
+// address is a migration that restarts it. Either way the connection keeps going on the new path once the
+// path challenge is answered, and a client can move to a fresh connection id.
+TEST(QuicTransportTest, FollowsRebindingAndMigration) {
+    QuicPair pair;
+    pair.Handshake();
+    ASSERT_TRUE(pair.StepUntil([&] { return pair.server_side.Count(QuicEvent::Type::ConnectionIdIssued) == 2; }));
+    EXPECT_EQ(pair.server->GetLocalConnectionIds().size(), 3u);
+    pair.StepUntil([] { return false; }, 200ms);
+
+    const auto bulk = MakeBytes(40000, 4);
+    ASSERT_TRUE(pair.server->SendStream(kMovementStream, bulk.data(), bulk.size()));
+    ASSERT_TRUE(pair.StepUntil([&] { return pair.client_side.streams[kMovementStream].size() == bulk.size(); }));
+    const auto before = pair.server->GetStats();
+    EXPECT_GT(before.congestion_window, pair.config.initial_window_packets * pair.config.max_datagram_size);
+
+    // Rebinding: same address, new port
+    pair.client_endpoint.port(50001);
+    const auto ping = MakeBytes(10, 5);
+    ASSERT_TRUE(pair.client->SendStream(kChatStream, ping.data(), ping.size()));
+    pair.client->Flush(pair.now, pair.ClientSink());
+    pair.Step(20ms);
+    auto after = pair.server->GetStats();
+    EXPECT_EQ(after.rebindings, 1u);
+    EXPECT_EQ(after.migrations, 0u);
+    EXPECT_EQ(pair.server->GetPeerEndpoint(), pair.client_endpoint);
+    EXPECT_GE(after.congestion_window, before.congestion_window);
+    EXPECT_GT(after.srtt_ms, 0.0);
+
+    // Migration: new address and a fresh connection id
+    ASSERT_TRUE(pair.client->RotateConnectionId());
+    pair.client_endpoint = Endpoint(boost::asio::ip::make_address("172.16.4.9"), 40000);
+    ASSERT_TRUE(pair.client->SendStream(kChatStream, ping.data(), ping.size()));
+    pair.client->Flush(pair.now, pair.ClientSink());
+    pair.Step(20ms);
+    after = pair.server->GetStats();
+    EXPECT_EQ(after.migrations, 1u);
+    EXPECT_EQ(after.congestion_window, pair.config.initial_window_packets * pair.config.max_datagram_size);
+    EXPECT_EQ(pair.server->GetPeerEndpoint(), pair.client_endpoint);
+    EXPECT_EQ(pair.server_side.Count(QuicEvent::Type::PathChanged), 2u);
+
+    // More than the amplification limit allows flows once the new path is validated
+    pair.client_side.streams[kMovementStream].clear();
+    ASSERT_TRUE(pair.server->SendStream(kMovementStream, bulk.data(), bulk.size()));
+    ASSERT_TRUE(pair.StepUntil([&] { return pair.client_side.streams[kMovementStream].size() == bulk.size(); }));
+    EXPECT_EQ(pair.client_side.streams[kMovementStream], bulk);
+    EXPECT_EQ(pair.server_destinations.back(), pair.client_endpoint);
+    EXPECT_EQ(pair.server_side.streams[kChatStream].size(), 2 * ping.size());
+}
+
+// [SEQUENCE: MVP19-279] A ticket from one connection lets the next one deliver data with its first flight and
+// restores the player's identity; the same ticket is refused the second time, and that client's early data
+// still arrives through the full handshake.
+TEST(QuicTransportTest, ZeroRttResumptionIsSingleUse) {
+    QuicPair first;
+    first.Handshake();
+    ASSERT_TRUE(first.server->IssueTicket(42, first.now));
+    ASSERT_TRUE(first.StepUntil([&] { return first.client_side.Count(QuicEvent::Type::TicketReceived) == 1; }));
+    const auto resumption = first.client->GetResumption();
+    ASSERT_TRUE(resumption.has_value());
+
+    // The resumed connection runs against the same server context, as a reconnect to the same process would
+    QuicPair second(20ms, &first.context);
+    second.now = first.now;
+    second.Connect(&*resumption);
+    const auto hello = MakeBytes(64, 6);
+    ASSERT_TRUE(second.client->SendStream(0, hello.data(), hello.size()));
+    second.client->Flush(second.now, second.ClientSink());
+    const auto first_flight = second.client_sent;
+    ASSERT_GE(first_flight.size(), 2u);   // Initial + 0-RTT
+
+    // The early data is delivered one one-way delay in, before the client has heard anything back
+    second.Step(20ms);
+    EXPECT_EQ(second.server_side.streams[0], hello);
+    EXPECT_EQ(second.client->GetState(), QuicConnectionState::Handshaking);
+    EXPECT_TRUE(second.server->IsResumed());
+    EXPECT_EQ(second.server->GetResumedPlayerId(), 42u);
+    ASSERT_TRUE(second.StepUntil([&] { return second.client->GetState() == QuicConnectionState::Established; }));
+    EXPECT_TRUE(second.client->IsResumed());
+    EXPECT_TRUE(second.client->GetStats().zero_rtt_accepted);
+
+    // Replaying the captured flight: the ticket is spent, so no early data is accepted
+    uint64_t destination = 0;
+    bool is_initial = false;
+    ASSERT_TRUE(quic_wire::PeekDestination(first_flight[0].data(), first_flight[0].size(), destination, is_initial));
+    QuicConnection replayed(QuicConfig{}, first.context, second.client_endpoint, destination, second.now);
+    Side replay_side;
+    for (const auto& datagram : first_flight) {
+        replayed.OnDatagram(datagram.data(), datagram.size(), second.client_endpoint, second.now, replay_side.Sink());
+    }
+    EXPECT_TRUE(replay_side.streams.empty());
+    EXPECT_EQ(replay_side.Count(QuicEvent::Type::HandshakeComplete), 0u);
+    EXPECT_FALSE(replayed.IsResumed());
+
+    // A client whose ticket is refused completes a full handshake and resends its early data as 1-RTT
+    QuicPair refused(20ms, &first.context);
+    refused.now = first.now;
+    refused.Connect(&*resumption);
+    ASSERT_TRUE(refused.client->SendStream(0, hello.data(), hello.size()));
+    ASSERT_TRUE(refused.StepUntil([&] { return refused.server_side.streams[0] == hello; }));
+    EXPECT_FALSE(refused.client->IsResumed());
+    EXPECT_FALSE(refused.server->IsResumed());
+}
+
+// [SEQUENCE: MVP19-422] A ticket sniffed off the wire, without the resumption secret it was issued with, is
+// redeemed but completes nothing: no packet sealed with the guessed keys opens, so no session starts.
+TEST(QuicTransportTest, StolenTicketWithoutSecretNeverCompletes) {
+    QuicPair first;
+    first.Handshake();
+    ASSERT_TRUE(first.server->IssueTicket(42, first.now));
+    ASSERT_TRUE(first.StepUntil([&] { return first.client_side.Count(QuicEvent::Type::TicketReceived) == 1; }));
+    auto stolen = first.client->GetResumption();
+    ASSERT_TRUE(stolen.has_value());
+    stolen->secret[0] ^= 0x01;
+
+    QuicPair attacker(20ms, &first.context);
+    attacker.now = first.now;
+    attacker.Connect(&*stolen);
+    const auto hello = MakeBytes(64, 7);
+    ASSERT_TRUE(attacker.client->SendStream(0, hello.data(), hello.size()));
+    attacker.client->Flush(attacker.now, attacker.ClientSink());
+    attacker.StepUntil([] { return false; }, 500ms);
+
+    ASSERT_TRUE(attacker.server);
+    EXPECT_TRUE(attacker.server->IsResumed());   // The ticket itself was valid
+    EXPECT_EQ(attacker.server_side.Count(QuicEvent::Type::HandshakeComplete), 0u);
+    EXPECT_TRUE(attacker.server_side.streams.empty());
+    EXPECT_NE(attacker.server->GetState(), QuicConnectionState::Established);
+}
+
+// [SEQUENCE: MVP19-280] One flush sends at most the pacer's burst, later flushes are spread over the RTT, and a
+// loss halves the congestion window.
+TEST(QuicTransportTest, PacesSendsAndHalvesWindowOnLoss) {
+    QuicPair pair(25ms);
+    pair.Handshake();
+    pair.StepUntil([] { return false; }, 300ms);
+
+    const auto bulk = MakeBytes(200000, 7);
+    ASSERT_TRUE(pair.client->SendStream(kMovementStream, bulk.data(), bulk.size()));
+    const size_t sent_before = pair.client_sent.size();
+    pair.client->Flush(pair.now, pair.ClientSink());
+    const size_t burst = pair.client_sent.size() - sent_before;
+    EXPECT_GT(burst, 0u);
+    EXPECT_LE(burst, pair.config.initial_window_packets);
+    pair.client->Flush(pair.now, pair.ClientSink());
+    EXPECT_EQ(pair.client_sent.size() - sent_before, burst);
+    EXPECT_GT(pair.client->GetStats().pacing_waits, 0u);
+
+    // Drop one packet once the window has grown, then check the reaction
+    size_t window_before_loss = 0;
+    size_t window_after_loss = 0;
+    bool dropped = false;
+    for (int step = 0; step < 5000 && pair.server_side.streams[kMovementStream].size() < bulk.size(); ++step) {
+        const auto stats = pair.client->GetStats();
+        if (!dropped && stats.congestion_window >= 4 * pair.config.initial_window_packets * 1200) {
+            pair.drop_next_client_sends = 1;
+            dropped = true;
+        }
+        pair.Step(1ms);
+        const auto after = pair.client->GetStats();
+        if (after.congestion_events == 1 && window_after_loss == 0) {
+            window_before_loss = stats.congestion_window;
+            window_after_loss = after.congestion_window;
+        }
+    }
+    EXPECT_EQ(pair.server_side.streams[kMovementStream], bulk);
+    ASSERT_TRUE(dropped);
+    ASSERT_GT(window_after_loss, 0u);
+    EXPECT_LE(window_after_loss, window_before_loss * 3 / 4);
+    EXPECT_EQ(pair.client->GetStats().congestion_events, 1u);
+}
+
+namespace {
+
+// [SEQUENCE: MVP19-282] A client connection talking to a real QUICProtocolHandler. Datagrams are queued in both
+// directions and pumped on the caller's thread, in wall-clock time because the handler reads the clock itself.
+struct HandlerLoop {
+    explicit HandlerLoop(QUICProtocolHandler& quic) : handler(quic) {
+        handler.SetDatagramSender([this](const Endpoint&, const std::byte* data, size_t size) {
+            to_client.emplace_back(data, data + size);
+        });
+    }
+
+    void Connect(const QuicResumption* resumption = nullptr) {
+        client = std::make_unique<QuicConnection>(QuicConfig{}, handler.GetPublicKey(), server_endpoint,
+                                                  Clock::now(), resumption);
+    }
+
+    void Send(uint64_t stream_id, const google::protobuf::Message& message) {
+        const auto packet = mmorpg::network::PacketSerializer::Serialize(message);
+        ASSERT_TRUE(client->SendStream(stream_id, packet.data(), packet.size()));
+    }
+
+    bool PumpUntil(const std::function<bool()>& done) {
+        for (int round = 0; round < 200; ++round) {
+            if (done()) return true;
+            client->Flush(Clock::now(), [&](const Endpoint&, const std::byte* data, size_t size) {
+                to_server.emplace_back(data, data + size);
+            });
+            while (!to_server.empty()) {
+                const auto datagram = std::move(to_server.front());
+                to_server.pop_front();
+                handler.Handle(nullptr, client_endpoint, datagram, datagram.size());
+            }
+            while (!to_client.empty()) {
+                const auto datagram = std::move(to_client.front());
+                to_client.pop_front();
+                client->OnDatagram(datagram.data(), datagram.size(), server_endpoint, Clock::now(), events.Sink());
+            }
+        }
+        return done();
+    }
+
+    // Packet types received on a stream, in order
+    std::vector<mmorpg::proto::PacketType> Packets(uint64_t stream_id) {
+        std::vector<mmorpg::proto::PacketType> types;
+        const auto& bytes = events.streams[stream_id];
+        for (size_t offset = 0; bytes.size() - offset >= 4;) {
+            uint32_t body_size = 0;
+            std::memcpy(&body_size, bytes.data() + offset, sizeof(body_size));
+            body_size = ntohl(body_size);
+            if (bytes.size() - offset - 4 < body_size) break;
+            mmorpg::network::PacketSerializer::PacketEnvelope envelope;
+            if (mmorpg::network::PacketSerializer::ParseEnvelope(bytes.data() + offset + 4, body_size, envelope)) {
+                types.push_back(envelope.type);
+            }
+            offset += 4 + body_size;
+        }
+        return types;
+    }
+
+    QUICProtocolHandler& handler;
+    Endpoint server_endpoint{boost::asio::ip::make_address("10.0.0.1"), 8082};
+    Endpoint client_endpoint{boost::asio::ip::make_address("192.168.1.20"), 50000};
+    std::unique_ptr<QuicConnection> client;
+    Side events;
+    std::deque<std::vector<std::byte>> to_server;
+    std::deque<std::vector<std::byte>> to_client;
+};
+
+} // namespace
+
+// Sessions over QUIC run the ordinary packet handlers. A login answers on the control stream and earns a
+// resumption ticket; the reconnect sends its heartbeat as 0-RTT data and the session receiving it is already
+// logged in as the same player.
+TEST(QuicTransportTest, HandlerResumesAuthenticatedSession) {
+    constexpr uint64_t kPlayerId = 4242;
+    boost::asio::io_context io_context;
+    SessionManager session_manager;
+    auto packet_handler = std::make_shared<PacketHandler>();
+    std::unique_ptr<QUICProtocolHandler> quic;
+
+    packet_handler->RegisterHandler<mmorpg::proto::LoginRequest>(
+        [&](std::shared_ptr<Session> session, const mmorpg::proto::LoginRequest&) {
+            session->SetPlayerId(kPlayerId);
+            session->Authenticate();
+            mmorpg::proto::LoginResponse response;
+            response.set_success(true);
+            response.set_player_id(kPlayerId);
+            session->Send(response);
+            if (session->GetTransportKind() == SessionTransportKind::Quic) quic->IssueResumptionTicket(*session);
+        });
+    std::vector<std::pair<bool, uint64_t>> heartbeats;   // Authenticated, player id
+    packet_handler->RegisterHandler<mmorpg::proto::HeartbeatRequest>(
+        [&](std::shared_ptr<Session> session, const mmorpg::proto::HeartbeatRequest&) {
+            heartbeats.emplace_back(session->IsAuthenticated(), session->GetPlayerId());
+        });
+
+    QuicKeyPair key;
+    ASSERT_TRUE(quic_crypto::GenerateKeyPair(key));
+    quic = std::make_unique<QUICProtocolHandler>(key, session_manager, packet_handler, io_context.get_executor());
+
+    HandlerLoop first(*quic);
+    first.Connect();
+    ASSERT_TRUE(first.PumpUntil([&] { return first.client->GetState() == QuicConnectionState::Established; }));
+    first.Send(QUICProtocolHandler::kControlStream, mmorpg::proto::LoginRequest{});
+    ASSERT_TRUE(first.PumpUntil([&] { return first.client->GetResumption().has_value(); }));
+    EXPECT_EQ(first.Packets(QUICProtocolHandler::kControlStream),
+              std::vector<mmorpg::proto::PacketType>{mmorpg::proto::PACKET_LOGIN_RESPONSE});
+    const auto resumption = first.client->GetResumption();
+
+    HandlerLoop second(*quic);
+    second.client_endpoint = Endpoint(boost::asio::ip::make_address("172.16.0.9"), 41000);
+    second.Connect(&*resumption);
+    mmorpg::proto::HeartbeatRequest heartbeat;
+    heartbeat.set_player_id(kPlayerId);
+    second.Send(QUICProtocolHandler::kControlStream, heartbeat);
+    ASSERT_TRUE(second.PumpUntil([&] { return !heartbeats.empty(); }));
+    EXPECT_TRUE(second.client->IsResumed());
+    EXPECT_EQ(heartbeats[0], std::make_pair(true, kPlayerId));
+
+    const auto stats = quic->GetStats();
+    EXPECT_EQ(stats.sessions_created, 2u);
+    EXPECT_EQ(stats.sessions_resumed, 1u);
+    EXPECT_EQ(stats.tickets_issued, 2u);
+    EXPECT_EQ(stats.active_connections, 2u);
+}
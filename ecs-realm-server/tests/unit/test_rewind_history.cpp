@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include "network/rewind_history.h"
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace mmorpg::network;
+using mmorpg::core::utils::Vector3;
+using Clock = RewindHistory::Clock;
+
+namespace {
+
+constexpr auto kFrame = std::chrono::milliseconds(16);
+const Vector3 kHalfExtents{0.5f, 0.5f, 1.0f};
+
+struct ReferenceFrame {
+    Clock::time_point time;
+    std::map<uint64_t, std::pair<Vector3, bool>> entities;   // Position, alive
+};
+
+// Independent model of the history: whole frames kept by value, searched linearly, every entity rewound and
+// slab-tested. RaycastAt must agree with it.
+std::optional<RewindRayHit> ReferenceRaycast(const std::vector<ReferenceFrame>& frames, Clock::time_point time,
+                                             const Vector3& origin, const Vector3& unit, float max_distance) {
+    size_t before = 0;
+    while (before + 1 < frames.size() && frames[before + 1].time <= time) ++before;
+    const size_t after = std::min(before + 1, frames.size() - 1);
+    const float t = after == before ? 0.0f
+        : std::chrono::duration<float>(time - frames[before].time).count() /
+          std::chrono::duration<float>(frames[after].time - frames[before].time).count();
+
+    std::optional<RewindRayHit> best;
+    for (const auto& [id, state] : frames[before].entities) {
+        auto later = frames[after].entities.find(id);
+        const auto& to = later != frames[after].entities.end() ? later->second : state;
+        if (!to.second) continue;
+        const float c[3] = {state.first.x + (to.first.x - state.first.x) * t,
+                            state.first.y + (to.first.y - state.first.y) * t,
+                            state.first.z + (to.first.z - state.first.z) * t};
+        const float e[3] = {kHalfExtents.x, kHalfExtents.y, kHalfExtents.z};
+        const float o[3] = {origin.x, origin.y, origin.z};
+        const float d[3] = {unit.x, unit.y, unit.z};
+        float near = 0.0f, far = max_distance;
+        bool hit = true;
+        for (int axis = 0; axis < 3 && hit; ++axis) {
+            float t0 = (c[axis] - e[axis] - o[axis]) / d[axis];
+            float t1 = (c[axis] + e[axis] - o[axis]) / d[axis];
+            if (t0 > t1) std::swap(t0, t1);
+            near = std::max(near, t0);
+            far = std::min(far, t1);
+            hit = near <= far;
+        }
+        if (hit && (!best || near < best->distance - 1e-4f)) {
+            best = RewindRayHit{id, near, {}};
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-205] A time between two frames blends them; before the oldest clamps, past the newest
+// extrapolates by velocity up to the limit.
+TEST(RewindHistoryTest, InterpolatesClampsAndExtrapolates) {
+    RewindHistory history;
+    const auto start = Clock::now();
+    for (int frame = 0; frame < 10; ++frame) {
+        history.BeginFrame(start + kFrame * frame);
+        history.Record(7, {static_cast<float>(frame) * 10.0f, 0, 0}, {625.0f, 0, 0}, kHalfExtents, true);
+    }
+
+    auto mid = history.GetEntityAt(7, start + kFrame * 4 + kFrame / 4);
+    ASSERT_TRUE(mid);
+    EXPECT_NEAR(mid->position.x, 42.5f, 1e-3f);
+    EXPECT_TRUE(mid->alive);
+
+    auto early = history.GetEntityAt(7, start - std::chrono::seconds(1));
+    ASSERT_TRUE(early);
+    EXPECT_FLOAT_EQ(early->position.x, 0.0f);
+
+    auto late = history.GetEntityAt(7, start + kFrame * 9 + std::chrono::seconds(5));
+    ASSERT_TRUE(late);
+    EXPECT_NEAR(late->position.x, 90.0f + 625.0f * 0.2f, 1e-2f);   // 200 ms limit
+
+    EXPECT_FALSE(history.GetEntityAt(8, start));
+}
+
+// [SEQUENCE: MVP19-206] The ring keeps the newest frame_capacity frames in the memory it was built with, and an
+// entity absent from a frame is absent when rewound to it.
+TEST(RewindHistoryTest, RingOverwritesOldestInFixedFootprint) {
+    RewindHistoryConfig config;
+    config.frame_capacity = 4;
+    config.max_entities = 8;
+    RewindHistory history(config);
+    const size_t footprint = history.GetMemoryFootprint();
+
+    const auto start = Clock::now();
+    for (int frame = 0; frame < 10; ++frame) {
+        history.BeginFrame(start + kFrame * frame);
+        history.Record(1, {static_cast<float>(frame), 0, 0}, {}, kHalfExtents, true);
+        if (frame == 8) history.Record(2, {100, 0, 0}, {}, kHalfExtents, true);
+    }
+    EXPECT_EQ(history.GetFrameCount(), 4u);
+    EXPECT_EQ(*history.GetOldestTime(), start + kFrame * 6);
+    EXPECT_EQ(*history.GetNewestTime(), start + kFrame * 9);
+    EXPECT_EQ(history.GetMemoryFootprint(), footprint);
+
+    EXPECT_FLOAT_EQ(history.GetEntityAt(1, start + kFrame * 7)->position.x, 7.0f);
+    EXPECT_FALSE(history.GetEntityAt(2, start + kFrame * 7));
+    EXPECT_FLOAT_EQ(history.GetEntityAt(2, start + kFrame * 8)->position.x, 100.0f);
+    // Despawned between frames 8 and 9: the earlier frame's state is used for the whole interval
+    EXPECT_FLOAT_EQ(history.GetEntityAt(2, start + kFrame * 8 + kFrame / 2)->position.x, 100.0f);
+
+    // Slots are bounded by max_entities
+    for (uint64_t id = 10; id < 20; ++id) {
+        history.Record(id, {}, {}, kHalfExtents, true);
+    }
+    EXPECT_EQ(history.GetTrackedEntityCount(), 8u);
+    EXPECT_EQ(history.GetStats().slots_exhausted, 4u);
+}
+
+// [SEQUENCE: MVP19-207] With entities dying, despawning and their slots going to new ids, RaycastAt finds the same
+// nearest hit as rewinding every entity in a by-value model of the frames, while interpolating only a fraction.
+TEST(RewindHistoryTest, RaycastMatchesReference) {
+    RewindHistoryConfig config;
+    config.max_entities = 600;
+    RewindHistory history(config);
+
+    std::mt19937 rng(14);
+    std::uniform_real_distribution<float> coord(0.0f, 200.0f);
+    std::uniform_real_distribution<float> step(-0.3f, 0.3f);
+    std::vector<uint64_t> ids;
+    std::vector<Vector3> positions;
+    for (uint64_t id = 1; id <= 500; ++id) {
+        ids.push_back(id);
+        positions.push_back({coord(rng), coord(rng), coord(rng) * 0.005f});
+    }
+
+    const auto start = Clock::now();
+    std::vector<ReferenceFrame> frames;
+    uint64_t next_id = 501;
+    for (int frame = 0; frame < 90; ++frame) {
+        const auto time = start + kFrame * frame;
+        history.BeginFrame(time);
+        frames.push_back({time, {}});
+        for (size_t i = 0; i < ids.size(); ++i) {
+            positions[i].x += step(rng);
+            positions[i].y += step(rng);
+            const bool alive = (ids[i] + static_cast<uint64_t>(frame / 30)) % 9 != 0;
+            history.Record(ids[i], positions[i], {}, kHalfExtents, alive);
+            frames.back().entities[ids[i]] = {positions[i], alive};
+        }
+        if (frame % 10 == 5) {   // Despawn a few; new ids take the freed slots from the next frame
+            for (size_t i = static_cast<size_t>(frame % 7); i < ids.size(); i += 50) {
+                history.RemoveEntity(ids[i]);
+                ids[i] = next_id++;
+            }
+        }
+    }
+    frames.erase(frames.begin(), frames.end() - static_cast<std::ptrdiff_t>(config.frame_capacity));
+
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::uniform_int_distribution<int> back(0, 70 * 16);
+    const auto newest = *history.GetNewestTime();
+    const uint64_t rewound_before = history.GetStats().entities_rewound;
+    size_t hits = 0;
+    for (int shot = 0; shot < 300; ++shot) {
+        const auto time = newest - std::chrono::milliseconds(back(rng));
+        const Vector3 origin{coord(rng), coord(rng), 1.0f};
+        const float heading = angle(rng);
+        const Vector3 unit{std::cos(heading), std::sin(heading), 0.001f};
+
+        auto fast = history.RaycastAt(time, origin, unit, 60.0f);
+        auto reference = ReferenceRaycast(frames, time, origin, unit, 60.0f);
+        ASSERT_EQ(fast.has_value(), reference.has_value()) << shot;
+        if (fast) {
+            EXPECT_EQ(fast->entity_id, reference->entity_id) << shot;
+            EXPECT_NEAR(fast->distance, reference->distance, 1e-3f) << shot;
+            ++hits;
+        }
+    }
+    EXPECT_GT(hits, 100u);
+    // Rewinding everything would be 300 * 500; the broad phase keeps it to entities near each ray
+    EXPECT_LT(history.GetStats().entities_rewound - rewound_before, 300u * 500u / 4u);
+}
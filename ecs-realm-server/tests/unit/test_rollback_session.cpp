@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include "game/systems/pvp/arena_rollback_world.h"
+#include "network/rollback_session.h"
+
+#include <random>
+#include <vector>
+
+using namespace mmorpg::network;
+using mmorpg::game::systems::pvp::ArenaRollbackWorld;
+
+namespace {
+
+// Scripted arena inputs: each player strafes across its lane, aims roughly at the other team and fires in bursts
+TickInput ArenaInput(size_t player, uint32_t frame) {
+    std::mt19937 rng(static_cast<uint32_t>(player * 100003 + frame / 12));
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    TickInput input;
+    input.move_x = 0.2f * unit(rng);
+    input.move_z = unit(rng);
+    input.yaw = (player < 3 ? 1.5707964f : -1.5707964f) + 0.15f * unit(rng);
+    if (rng() % 3 == 0) input.flags |= TickInput::kPrimary;
+    if (rng() % 5 == 0) input.flags |= TickInput::kSprint;
+    if (frame % 97 == player) input.flags |= TickInput::kJump;
+    return input;
+}
+
+struct Arrival {
+    uint32_t tick;   // Delivered just before this frame is simulated
+    size_t player;
+    uint32_t frame;
+};
+
+std::vector<Arrival> DelayedArrivals(uint32_t frames, uint32_t max_delay, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> delay(0, max_delay);
+    std::vector<Arrival> arrivals;
+    for (uint32_t frame = 0; frame < frames; ++frame) {
+        for (size_t player = 0; player < ArenaRollbackWorld::kPlayers; ++player) {
+            arrivals.push_back({frame + delay(rng), player, frame});
+        }
+    }
+    std::stable_sort(arrivals.begin(), arrivals.end(),
+                     [](const Arrival& a, const Arrival& b) { return a.tick < b.tick; });
+    return arrivals;
+}
+
+// Runs an arena for `ticks` frames, delivering inputs as scheduled; returns the checksum after every frame
+std::vector<uint64_t> RunArena(ArenaRollbackWorld& world, const std::vector<Arrival>& arrivals, uint32_t ticks) {
+    std::vector<uint64_t> checksums;
+    size_t next = 0;
+    for (uint32_t tick = 0; tick < ticks; ++tick) {
+        while (next < arrivals.size() && arrivals[next].tick <= tick) {
+            const auto& arrival = arrivals[next++];
+            world.Session().AddInput(arrival.player, arrival.frame, ArenaInput(arrival.player, arrival.frame));
+        }
+        world.Session().AdvanceFrame();
+        checksums.push_back(world.Session().ComputeChecksum());
+    }
+    return checksums;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-254] Only dirtied pages are saved, and a rollback restores them exactly before resimulating.
+TEST(RollbackSessionTest, SavesDirtyPagesAndRestoresExactly) {
+    std::vector<int32_t> cells(1024, 0);   // 4 KiB: 32 pages of 128 bytes
+    RollbackColumn<int32_t> column;
+    RollbackSession session(1, [&](uint32_t frame, const TickInput* inputs, size_t) {
+        column.Write(frame % 1024) += static_cast<int32_t>(inputs[0].move_x) + 1;
+        column.Write((frame * 37) % 1024) ^= static_cast<int32_t>(frame);
+    });
+    column = session.RegisterColumn(cells.data(), cells.size());
+    EXPECT_EQ(column.size(), 1024u);
+
+    for (uint32_t frame = 0; frame < 20; ++frame) {
+        TickInput input;
+        input.move_x = 1.0f;
+        session.AddInput(0, frame, input);
+        session.AdvanceFrame();
+    }
+    const uint64_t on_time = session.ComputeChecksum();
+    EXPECT_LE(session.GetStats().pages_saved, 40u);   // At most two pages per frame, never the whole array
+    const size_t footprint = session.GetMemoryFootprint();
+
+    // Replay the same frames with frame 14's input arriving late and different from the prediction
+    std::vector<int32_t> cells2(1024, 0);
+    RollbackColumn<int32_t> column2;
+    RollbackSession late(1, [&](uint32_t frame, const TickInput* inputs, size_t) {
+        column2.Write(frame % 1024) += static_cast<int32_t>(inputs[0].move_x) + 1;
+        column2.Write((frame * 37) % 1024) ^= static_cast<int32_t>(frame);
+    });
+    column2 = late.RegisterColumn(cells2.data(), cells2.size());
+    for (uint32_t frame = 0; frame < 20; ++frame) {
+        TickInput input;
+        input.move_x = 1.0f;
+        if (frame != 14) late.AddInput(0, frame, input);
+        if (frame == 19) {
+            TickInput correction;
+            correction.move_x = 5.0f;
+            EXPECT_EQ(late.AddInput(0, 14, correction), RollbackSession::InputResult::Mispredicted);
+            EXPECT_EQ(late.AddInput(0, 14, correction), RollbackSession::InputResult::Duplicate);
+        }
+        late.AdvanceFrame();
+    }
+    EXPECT_EQ(late.GetStats().rollbacks, 1u);
+    EXPECT_EQ(late.GetStats().frames_resimulated, 5u);
+    EXPECT_NE(late.ComputeChecksum(), on_time);
+    EXPECT_EQ(cells2[14], 6);
+    cells2[14] = cells[14];
+    EXPECT_EQ(cells2, cells);   // Nothing else differs
+    EXPECT_EQ(session.GetMemoryFootprint(), footprint);
+}
+
+// [SEQUENCE: MVP19-255] An arena fed inputs up to eight frames late, out of order, ends in the state of one fed
+// every input on time, and replaying the recorded arrivals reproduces every frame's checksum.
+TEST(RollbackSessionTest, ArenaReplayMatchesOnTimeRun) {
+    constexpr uint32_t kFrames = 900;
+    ArenaRollbackWorld on_time;
+    const auto reference = RunArena(on_time, DelayedArrivals(kFrames, 0, 1), kFrames + 10);
+    EXPECT_EQ(on_time.Session().GetStats().rollbacks, 0u);
+
+    bool someone_hit = false;
+    for (size_t i = 0; i < ArenaRollbackWorld::kPlayers; ++i) {
+        someone_hit |= on_time.GetPlayer(i).health < 100.0f || !on_time.GetPlayer(i).alive;
+    }
+    EXPECT_TRUE(someone_hit);
+
+    const auto arrivals = DelayedArrivals(kFrames, 8, 2);
+    ArenaRollbackWorld late;
+    const auto rolled = RunArena(late, arrivals, kFrames + 10);
+    const auto& stats = late.Session().GetStats();
+    EXPECT_GT(stats.rollbacks, 100u);
+    EXPECT_EQ(stats.max_rollback_depth, 8u);
+    EXPECT_EQ(stats.beyond_budget, 0u);
+    EXPECT_EQ(rolled.back(), reference.back());
+    for (size_t i = 0; i < ArenaRollbackWorld::kPlayers; ++i) {
+        EXPECT_EQ(late.GetPlayer(i).move.position.x, on_time.GetPlayer(i).move.position.x);
+        EXPECT_EQ(late.GetPlayer(i).health, on_time.GetPlayer(i).health);
+    }
+
+    ArenaRollbackWorld replay;
+    EXPECT_EQ(RunArena(replay, arrivals, kFrames + 10), rolled);
+}
+
+// [SEQUENCE: MVP19-256] Inputs older than the rollback budget are not applied to their frame; the session keeps
+// going from the oldest frame it holds, within its fixed memory.
+TEST(RollbackSessionTest, DegradesPastRollbackBudget) {
+    RollbackConfig config;
+    config.max_rollback_frames = 4;
+    ArenaRollbackWorld world(config);
+    const size_t footprint = world.Session().GetMemoryFootprint();
+
+    std::vector<Arrival> arrivals = DelayedArrivals(300, 0, 3);
+    for (auto& arrival : arrivals) {
+        if (arrival.player == 5) arrival.tick += 10;   // One player on a very bad connection
+    }
+    std::stable_sort(arrivals.begin(), arrivals.end(),
+                     [](const Arrival& a, const Arrival& b) { return a.tick < b.tick; });
+    RunArena(world, arrivals, 320);
+
+    const auto& stats = world.Session().GetStats();
+    EXPECT_GT(stats.beyond_budget, 250u);
+    EXPECT_LE(stats.max_rollback_depth, 4u);
+    EXPECT_EQ(world.Session().GetCurrentFrame(), 320u);
+    EXPECT_EQ(world.Session().GetOldestRestorableFrame(), 316u);
+    EXPECT_EQ(world.Session().GetMemoryFootprint(), footprint);
+    EXPECT_EQ(world.Session().AddInput(0, 320 + 64, TickInput{}), RollbackSession::InputResult::TooFarAhead);
+}
+
+// [SEQUENCE: MVP19-418] State registered after the first frame could not be restored by the frames already
+// recorded, so registering it is an error rather than a column that silently does nothing.
+TEST(RollbackSessionTest, RegisterAfterFirstFrameThrows) {
+    std::vector<int32_t> cells(16, 0);
+    RollbackSession session(1, [](uint32_t, const TickInput*, size_t) {});
+    auto column = session.RegisterColumn(cells.data(), cells.size());
+    EXPECT_EQ(column.size(), 16u);
+    session.AdvanceFrame();
+    EXPECT_THROW(session.RegisterColumn(cells.data(), cells.size()), std::logic_error);
+}
@@ -0,0 +1,425 @@
+#include <gtest/gtest.h>
+
+#include "game/handoff/player_state_codec.h"
+#include "network/cluster_framing.h"
+#include "network/packet_handler.h"
+#include "network/packet_serializer.h"
+#include "network/session.h"
+#include "network/session_handoff.h"
+#include "network/session_manager.h"
+
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <any>
+#include <array>
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <typeindex>
+#include <vector>
+
+using namespace mmorpg::network;
+using mmorpg::core::ecs::EntityId;
+namespace components = mmorpg::game::components;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Just enough of a World for the codec: components in a map per type
+class FakeWorld {
+public:
+    EntityId CreateEntity() { return ++m_nextEntity; }
+
+    template <typename T>
+    T* GetComponent(EntityId entity) {
+        auto it = m_components.find({std::type_index(typeid(T)), entity});
+        return it == m_components.end() ? nullptr : std::any_cast<T>(&it->second);
+    }
+
+    template <typename T>
+    T& AddComponent(EntityId entity, const T& component) {
+        auto& slot = m_components[{std::type_index(typeid(T)), entity}];
+        slot = component;
+        return *std::any_cast<T>(&slot);
+    }
+
+    size_t ComponentCount() const { return m_components.size(); }
+
+private:
+    EntityId m_nextEntity = 0;
+    std::map<std::pair<std::type_index, EntityId>, std::any> m_components;
+};
+
+// Captures what a session sends instead of writing it to a socket
+class CapturingTransport : public SessionTransport {
+public:
+    void SendPacket(mmorpg::proto::PacketType, const std::byte* data, size_t size) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_packets.emplace_back(data, data + size);
+    }
+    void Close() override {}
+    std::string GetRemoteAddress() const override { return "test"; }
+    SessionTransportKind GetKind() const override { return SessionTransportKind::Quic; }
+
+    // The most recent packet of type T
+    template <typename T>
+    bool Find(T& message) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_packets.rbegin(); it != m_packets.rend(); ++it) {
+            if (cluster_framing::ParseFrame(it->data(), it->size(), message)) return true;
+        }
+        return false;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::vector<std::byte>> m_packets;
+};
+
+template <typename Predicate>
+bool WaitFor(Predicate predicate, std::chrono::milliseconds timeout = 2000ms) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+// One game server process: its sessions, packet handler, world and handoff service
+struct Node {
+    Node(boost::asio::io_context& io_context, const std::string& id, uint16_t game_port, const std::string& secret)
+        : io(io_context), packet_handler(std::make_shared<PacketHandler>()) {
+        SessionHandoffConfig config;
+        config.node_id = id;
+        config.cluster_secret = secret;
+        config.advertised_port = game_port;
+        config.claim_timeout = 300ms;
+        handoff = std::make_shared<SessionHandoffService>(io, session_manager, config);
+        handoff->SetStateExporter([this](uint64_t player_id) -> std::optional<std::string> {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = players.find(player_id);
+            if (it == players.end()) return std::nullopt;
+            return codec.Encode(world, it->second);
+        });
+        handoff->SetStateImporter([this](uint64_t player_id, const std::string& state) {
+            std::lock_guard<std::mutex> lock(mutex);
+            const EntityId entity = world.CreateEntity();
+            if (!codec.Decode(world, entity, state)) return false;
+            players[player_id] = entity;
+            return true;
+        });
+        handoff->SetStateDiscarder([this](uint64_t player_id) {
+            std::lock_guard<std::mutex> lock(mutex);
+            players.erase(player_id);
+        });
+        handoff->SetHandedOffCallback([this](uint64_t player_id, const std::string&) {
+            std::lock_guard<std::mutex> lock(mutex);
+            players.erase(player_id);
+        });
+        packet_handler->RegisterHandler<mmorpg::proto::HandoffClaim>(
+            [this](std::shared_ptr<Session> session, const mmorpg::proto::HandoffClaim& claim) {
+                handoff->HandleClaim(session, claim);
+            });
+        EXPECT_TRUE(handoff->Listen({boost::asio::ip::make_address("127.0.0.1"), 0}));
+    }
+
+    // The service's callbacks point into this node; let the stop land before it goes away
+    ~Node() {
+        handoff->Stop();
+        for (int i = 0; i < 2; ++i) {
+            std::promise<void> drained;
+            boost::asio::post(io, [&] { drained.set_value(); });
+            drained.get_future().wait();
+        }
+    }
+
+    std::shared_ptr<Session> Connect(const std::shared_ptr<CapturingTransport>& transport) {
+        auto session = std::make_shared<Session>(io.get_executor(), session_manager.get_next_session_id(),
+                                                 packet_handler, transport);
+        session_manager.Register(session);
+        return session;
+    }
+
+    void Deliver(const std::shared_ptr<Session>& session, const google::protobuf::Message& message) {
+        const auto framed = PacketSerializer::Serialize(message);
+        session->DeliverTransportPacket(framed.data() + 4, framed.size() - 4);
+    }
+
+    bool HasPlayer(uint64_t player_id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return players.count(player_id) != 0;
+    }
+
+    boost::asio::io_context& io;
+    SessionManager session_manager;
+    std::shared_ptr<PacketHandler> packet_handler;
+    std::shared_ptr<SessionHandoffService> handoff;
+    mmorpg::game::handoff::PlayerStateCodec<FakeWorld> codec =
+        mmorpg::game::handoff::MakeDefaultPlayerStateCodec<FakeWorld>();
+    std::mutex mutex;
+    FakeWorld world;
+    std::map<uint64_t, EntityId> players;
+};
+
+class SessionHandoffTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_thread = std::thread([this] { m_io.run(); });
+    }
+    void TearDown() override {
+        m_work.reset();
+        m_io.stop();
+        m_thread.join();
+    }
+
+    std::pair<bool, std::string> HandOff(Node& from, Node& to, uint64_t player_id) {
+        std::promise<std::pair<bool, std::string>> result;
+        from.handoff->HandOff(player_id, {boost::asio::ip::make_address("127.0.0.1"), to.handoff->GetListenPort()},
+                              [&](bool success, const std::string& reason) { result.set_value({success, reason}); });
+        return result.get_future().get();
+    }
+
+    // Plays a source node by hand: one offer on a fresh connection, and the reply
+    mmorpg::proto::HandoffAccept SendOffer(Node& to, const mmorpg::proto::HandoffOffer& offer) {
+        boost::asio::io_context io;
+        boost::asio::ip::tcp::socket socket(io);
+        socket.connect({boost::asio::ip::make_address("127.0.0.1"), to.handoff->GetListenPort()});
+        boost::asio::write(socket, boost::asio::buffer(PacketSerializer::Serialize(offer)));
+        std::array<std::byte, 4> header{};
+        boost::asio::read(socket, boost::asio::buffer(header));
+        std::vector<std::byte> body(cluster_framing::FrameBodySize(header.data()));
+        boost::asio::read(socket, boost::asio::buffer(body));
+        mmorpg::proto::HandoffAccept accept;
+        EXPECT_TRUE(cluster_framing::ParseBody(body.data(), body.size(), accept));
+        return accept;
+    }
+
+    boost::asio::io_context m_io;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_work{m_io.get_executor()};
+    std::thread m_thread;
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-319] Components survive the round trip; a truncated or mis-sized state adds nothing, and
+// components the receiver does not know are skipped.
+TEST(PlayerStateCodecTest, RoundTripsComponentsAndRejectsMalformedState) {
+    auto codec = mmorpg::game::handoff::MakeDefaultPlayerStateCodec<FakeWorld>();
+    FakeWorld source;
+    const EntityId player = source.CreateEntity();
+    source.AddComponent(player, components::TransformComponent{{12.5f, 0.0f, -40.0f}, {0.0f, 1.5f, 0.0f}, {1, 1, 1}});
+    components::HealthComponent health;
+    health.current_hp = 37.0f;
+    health.shield = 5.0f;
+    source.AddComponent(player, health);
+    const std::string state = codec.Encode(source, player);
+
+    FakeWorld target;
+    const EntityId copy = target.CreateEntity();
+    ASSERT_TRUE(codec.Decode(target, copy, state));
+    ASSERT_NE(target.GetComponent<components::TransformComponent>(copy), nullptr);
+    EXPECT_FLOAT_EQ(target.GetComponent<components::TransformComponent>(copy)->position.z, -40.0f);
+    EXPECT_FLOAT_EQ(target.GetComponent<components::TransformComponent>(copy)->rotation.y, 1.5f);
+    EXPECT_FLOAT_EQ(target.GetComponent<components::HealthComponent>(copy)->current_hp, 37.0f);
+    EXPECT_FLOAT_EQ(target.GetComponent<components::HealthComponent>(copy)->shield, 5.0f);
+    EXPECT_EQ(target.GetComponent<components::VelocityComponent>(copy), nullptr);
+
+    FakeWorld untouched;
+    const EntityId other = untouched.CreateEntity();
+    EXPECT_FALSE(codec.Decode(untouched, other, std::string_view(state).substr(0, state.size() - 1)));
+    std::string resized = state;
+    resized[6 + 2] = static_cast<char>(resized[6 + 2] + 1);   // First component's size field
+    EXPECT_FALSE(codec.Decode(untouched, other, resized));
+    EXPECT_EQ(untouched.ComponentCount(), 0u);
+
+    // An older build knows only transforms and ignores the rest
+    mmorpg::game::handoff::PlayerStateCodec<FakeWorld> older;
+    older.RegisterComponent<components::TransformComponent>(1);
+    FakeWorld old_world;
+    const EntityId old_copy = old_world.CreateEntity();
+    EXPECT_TRUE(older.Decode(old_world, old_copy, state));
+    EXPECT_EQ(old_world.ComponentCount(), 1u);
+}
+
+// [SEQUENCE: MVP19-320] A player moves between two nodes over loopback: the source redirects its client and
+// drops the player, the target parks it until the client claims it with the redirect's token, and the claiming
+// connection comes up logged in as that player without a login.
+TEST_F(SessionHandoffTest, HandsOffPlayerToAnotherNode) {
+    constexpr uint64_t kPlayerId = 77;
+    Node source(m_io, "node-a", 9000, "secret");
+    Node target(m_io, "node-b", 9010, "secret");
+
+    auto old_transport = std::make_shared<CapturingTransport>();
+    auto old_session = source.Connect(old_transport);
+    old_session->SetPlayerId(kPlayerId);
+    source.session_manager.SetPlayerIdForSession(old_session->GetSessionId(), kPlayerId);
+    {
+        std::lock_guard<std::mutex> lock(source.mutex);
+        const EntityId entity = source.world.CreateEntity();
+        components::TransformComponent transform;
+        transform.SetPosition(100.0f, 2.0f, 300.0f);
+        source.world.AddComponent(entity, transform);
+        source.players[kPlayerId] = entity;
+    }
+
+    const auto [success, reason] = HandOff(source, target, kPlayerId);
+    ASSERT_TRUE(success) << reason;
+    EXPECT_EQ(reason, "node-b");
+    EXPECT_FALSE(source.HasPlayer(kPlayerId));
+    EXPECT_TRUE(target.HasPlayer(kPlayerId));
+    EXPECT_EQ(old_session->GetPlayerId(), 0u);
+    EXPECT_TRUE(source.session_manager.GetPlayerIds().empty());
+
+    mmorpg::proto::HandoffRedirect redirect;
+    ASSERT_TRUE(WaitFor([&] { return old_transport->Find(redirect); }));
+    EXPECT_EQ(redirect.host(), "127.0.0.1");
+    EXPECT_EQ(redirect.port(), 9010u);
+    EXPECT_EQ(redirect.player_id(), kPlayerId);
+
+    // A token for another player, or a made-up one, claims nothing
+    auto new_transport = std::make_shared<CapturingTransport>();
+    auto new_session = target.Connect(new_transport);
+    mmorpg::proto::HandoffClaim claim;
+    claim.set_token(redirect.token());
+    claim.set_player_id(kPlayerId + 1);
+    target.Deliver(new_session, claim);
+    claim.set_player_id(kPlayerId);
+    claim.set_token(redirect.token() + 1);
+    target.Deliver(new_session, claim);
+    ASSERT_TRUE(WaitFor([&] { return target.handoff->GetStats().claims == 2; }));
+    EXPECT_EQ(new_session->GetPlayerId(), 0u);
+
+    claim.set_token(redirect.token());
+    target.Deliver(new_session, claim);
+    mmorpg::proto::HandoffClaimResponse response;
+    ASSERT_TRUE(WaitFor([&] { return new_transport->Find(response) && response.success(); }));
+    EXPECT_EQ(new_session->GetPlayerId(), kPlayerId);
+    EXPECT_TRUE(new_session->IsAuthenticated());
+    EXPECT_EQ(target.session_manager.GetSessionByPlayerId(kPlayerId), new_session);
+    {
+        std::lock_guard<std::mutex> lock(target.mutex);
+        const auto* transform = target.world.GetComponent<components::TransformComponent>(target.players[kPlayerId]);
+        ASSERT_NE(transform, nullptr);
+        EXPECT_FLOAT_EQ(transform->position.x, 100.0f);
+        EXPECT_FLOAT_EQ(transform->position.z, 300.0f);
+    }
+
+    // Single use: a replay, even on another connection, is refused
+    auto replay_session = target.Connect(std::make_shared<CapturingTransport>());
+    target.Deliver(replay_session, claim);
+    ASSERT_TRUE(WaitFor([&] { return target.handoff->GetStats().claims == 4; }));
+    EXPECT_EQ(replay_session->GetPlayerId(), 0u);
+
+    const auto stats = target.handoff->GetStats();
+    EXPECT_EQ(stats.offers_received, 1u);
+    EXPECT_EQ(stats.claims_refused, 3u);
+    EXPECT_EQ(stats.parked, 0u);
+    EXPECT_EQ(source.handoff->GetStats().handoffs_completed, 1u);
+}
+
+// [SEQUENCE: MVP19-321] A wrong cluster secret or an unclaimed player leaves nothing behind: the refused offer
+// keeps the player on the source, and an accepted but unclaimed one is discarded on the target.
+TEST_F(SessionHandoffTest, RefusedAndUnclaimedHandoffsLeaveNoPlayerBehind) {
+    Node source(m_io, "node-a", 9000, "secret");
+    Node impostor_target(m_io, "node-x", 9020, "other-secret");
+    Node target(m_io, "node-b", 9010, "secret");
+
+    for (uint64_t player_id : {1u, 2u}) {
+        auto session = source.Connect(std::make_shared<CapturingTransport>());
+        session->SetPlayerId(player_id);
+        source.session_manager.SetPlayerIdForSession(session->GetSessionId(), player_id);
+        std::lock_guard<std::mutex> lock(source.mutex);
+        source.players[player_id] = source.world.CreateEntity();
+    }
+
+    auto [refused, refusal] = HandOff(source, impostor_target, 1);
+    EXPECT_FALSE(refused);
+    EXPECT_EQ(refusal, "bad_secret");
+    EXPECT_TRUE(source.HasPlayer(1));
+    EXPECT_FALSE(impostor_target.HasPlayer(1));
+
+    auto [unknown, unknown_reason] = HandOff(source, target, 3);
+    EXPECT_FALSE(unknown);
+    EXPECT_EQ(unknown_reason, "no_session");
+
+    auto [moved, node] = HandOff(source, target, 2);
+    ASSERT_TRUE(moved);
+    EXPECT_TRUE(target.HasPlayer(2));
+    ASSERT_TRUE(WaitFor([&] { return !target.HasPlayer(2); }));
+    EXPECT_EQ(target.handoff->GetStats().claims_expired, 1u);
+    EXPECT_EQ(target.handoff->GetStats().parked, 0u);
+}
+
+// [SEQUENCE: MVP19-426] The cluster secret never travels: an offer signed under another secret, signed too long
+// ago, replayed byte for byte, or altered after signing is refused, and an accepted one comes back signed.
+TEST_F(SessionHandoffTest, RefusesForgedStaleAndReplayedOffers) {
+    Node target(m_io, "node-b", 9010, "secret");
+    FakeWorld world;
+    const auto now_ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+
+    mmorpg::proto::HandoffOffer offer;
+    offer.set_handoff_id(1);
+    offer.set_source_node("node-a");
+    offer.set_player_id(5);
+    offer.set_entity_state(target.codec.Encode(world, world.CreateEntity()));
+    offer.set_timestamp_ms(now_ms);
+    offer.set_mac(SessionHandoffService::OfferMac("not-the-secret", offer));
+    EXPECT_EQ(SendOffer(target, offer).reason(), "bad_secret");
+
+    offer.set_timestamp_ms(now_ms - 60000);
+    offer.set_mac(SessionHandoffService::OfferMac("secret", offer));
+    EXPECT_EQ(SendOffer(target, offer).reason(), "stale");
+
+    offer.set_timestamp_ms(now_ms);
+    offer.set_mac(SessionHandoffService::OfferMac("secret", offer));
+    const auto accept = SendOffer(target, offer);
+    ASSERT_TRUE(accept.accepted()) << accept.reason();
+    EXPECT_EQ(accept.mac(), SessionHandoffService::AcceptMac("secret", accept));
+    EXPECT_TRUE(target.HasPlayer(5));
+    EXPECT_EQ(SendOffer(target, offer).reason(), "replayed");
+
+    offer.set_player_id(6);
+    EXPECT_EQ(SendOffer(target, offer).reason(), "bad_secret");
+    EXPECT_FALSE(target.HasPlayer(6));
+    EXPECT_EQ(target.handoff->GetStats().offers_refused, 4u);
+}
+
+// [SEQUENCE: MVP19-460] A draining node with more players than it hands off at once moves every one of them:
+// each handed-off player leaves the source's player list, so the next batch is the players still there.
+TEST_F(SessionHandoffTest, DrainerMovesEveryPlayerInBatches) {
+    constexpr uint64_t kPlayers = 20;
+    constexpr size_t kMaxInFlight = 8;
+    Node source(m_io, "node-a", 9000, "secret");
+    Node target(m_io, "node-b", 9010, "secret");
+
+    for (uint64_t player_id = 1; player_id <= kPlayers; ++player_id) {
+        auto session = source.Connect(std::make_shared<CapturingTransport>());
+        session->SetPlayerId(player_id);
+        source.session_manager.SetPlayerIdForSession(session->GetSessionId(), player_id);
+        std::lock_guard<std::mutex> lock(source.mutex);
+        source.players[player_id] = source.world.CreateEntity();
+    }
+
+    const boost::asio::ip::tcp::endpoint target_endpoint(boost::asio::ip::make_address("127.0.0.1"),
+                                                         target.handoff->GetListenPort());
+    HandoffDrainer drainer(source.handoff, source.session_manager, kMaxInFlight,
+                           [&](HandoffDrainer::TargetCallback callback) { callback(target_endpoint); });
+    size_t max_seen_in_flight = 0;
+    ASSERT_TRUE(WaitFor([&] {
+        drainer.Tick();
+        max_seen_in_flight = std::max(max_seen_in_flight, drainer.GetInFlight());
+        return source.session_manager.GetPlayerIds().empty() && drainer.GetInFlight() == 0;
+    }, 5000ms));
+
+    EXPECT_LE(max_seen_in_flight, kMaxInFlight);
+    for (uint64_t player_id = 1; player_id <= kPlayers; ++player_id) {
+        EXPECT_FALSE(source.HasPlayer(player_id));
+        EXPECT_TRUE(target.HasPlayer(player_id));
+    }
+    EXPECT_EQ(source.handoff->GetStats().offers_sent, kPlayers);
+    EXPECT_EQ(source.handoff->GetStats().handoffs_completed, kPlayers);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include "network/session_manager.h"
+#include "network/session.h"
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mmorpg::network;
+
+namespace {
+
+// [SEQUENCE: MVP19-111] Unconnected sessions are enough for the index; nothing is read or written on the socket.
+class SessionManagerTest : public ::testing::Test {
+protected:
+    std::shared_ptr<Session> MakeSession(uint32_t session_id) {
+        return std::make_shared<Session>(boost::asio::ip::tcp::socket(io_context), ssl_context, session_id, nullptr);
+    }
+
+    boost::asio::io_context io_context;
+    boost::asio::ssl::context ssl_context{boost::asio::ssl::context::tls_server};
+    SessionManager manager{8};
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-112] Both directions of the player index follow rebinds and unregistration.
+TEST_F(SessionManagerTest, PlayerIndexIsBidirectional) {
+    auto first = MakeSession(1);
+    auto second = MakeSession(2);
+    manager.Register(first);
+    manager.Register(second);
+    EXPECT_EQ(manager.GetSessionCount(), 2u);
+
+    manager.SetPlayerIdForSession(1, 700);
+    EXPECT_EQ(manager.GetSessionByPlayerId(700), first);
+    EXPECT_EQ(manager.GetPlayerIdForSession(1), 700u);
+
+    // The same player logs in again on another connection: the old session loses the binding.
+    manager.SetPlayerIdForSession(2, 700);
+    EXPECT_EQ(manager.GetSessionByPlayerId(700), second);
+    EXPECT_EQ(manager.GetPlayerIdForSession(1), 0u);
+
+    // Unregistering the stale session must not remove the live binding.
+    manager.Unregister(1);
+    EXPECT_EQ(manager.GetSessionByPlayerId(700), second);
+
+    manager.Unregister(2);
+    EXPECT_EQ(manager.GetSessionByPlayerId(700), nullptr);
+    EXPECT_EQ(manager.GetSession(2), nullptr);
+    EXPECT_EQ(manager.GetSessionCount(), 0u);
+}
+
+// [SEQUENCE: MVP19-113] UDP endpoint lookups come from the published snapshot and disappear with the session.
+TEST_F(SessionManagerTest, UdpEndpointFollowsSession) {
+    auto session = MakeSession(5);
+    manager.Register(session);
+    const boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::make_address("127.0.0.1"), 40000);
+    const uint64_t version = manager.GetUdpEndpointVersion();
+
+    manager.RegisterUdpEndpoint(5, endpoint);
+    EXPECT_GT(manager.GetUdpEndpointVersion(), version);
+    EXPECT_EQ(manager.GetSessionByUdpEndpoint(endpoint), session);
+
+    manager.Unregister(5);
+    EXPECT_EQ(manager.GetSessionByUdpEndpoint(endpoint), nullptr);
+}
+
+// [SEQUENCE: MVP19-114] Readers run against a writer churning sessions; every hit is the session it was bound to.
+TEST_F(SessionManagerTest, ConcurrentReadersDuringChurn) {
+    constexpr uint32_t kStable = 1000;
+    std::vector<std::shared_ptr<Session>> stable;
+    for (uint32_t id = 1; id <= kStable; ++id) {
+        stable.push_back(MakeSession(id));
+        manager.Register(stable.back());
+        manager.SetPlayerIdForSession(id, 100000 + id);
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> mismatches{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&, r] {
+            uint32_t id = 1 + r;
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto session = manager.GetSessionByPlayerId(100000 + id);
+                if (!session || session->GetSessionId() != id) {
+                    mismatches.fetch_add(1);
+                }
+                id = id % kStable + 1;
+            }
+        });
+    }
+
+    for (uint32_t id = kStable + 1; id <= kStable + 2000; ++id) {
+        auto session = MakeSession(id);
+        manager.Register(session);
+        manager.SetPlayerIdForSession(id, 500000 + id);
+        manager.Unregister(id);
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(mismatches.load(), 0u);
+    EXPECT_EQ(manager.GetSessionCount(), kStable);
+    const auto stats = manager.GetStats();
+    EXPECT_EQ(stats.shard_count, 8u);
+    EXPECT_GT(stats.writes, 0u);
+}
+
+// [SEQUENCE: MVP19-408] A UDP registration copies one shard of endpoints, not the whole table, and rebinding a
+// session to a new endpoint moves it between shards without leaving the old endpoint behind.
+TEST_F(SessionManagerTest, UdpRegistrationCopiesOneShard) {
+    constexpr uint32_t kSessions = 800;
+    std::vector<std::shared_ptr<Session>> sessions;
+    for (uint32_t id = 1; id <= kSessions; ++id) {
+        sessions.push_back(MakeSession(id));
+        manager.Register(sessions.back());
+    }
+    const auto address = boost::asio::ip::make_address("10.0.0.1");
+    const uint64_t copied_before = manager.GetStats().copied_entries;
+    for (uint32_t id = 1; id <= kSessions; ++id) {
+        manager.RegisterUdpEndpoint(id, {address, static_cast<uint16_t>(20000 + id)});
+    }
+    // A single table would copy 0 + 1 + ... + 799 entries; eight shards copy about an eighth of that
+    const uint64_t copied = manager.GetStats().copied_entries - copied_before;
+    EXPECT_LT(copied, kSessions * kSessions / 8);
+
+    const boost::asio::ip::udp::endpoint old_endpoint(address, 20001);
+    const boost::asio::ip::udp::endpoint new_endpoint(address, 30001);
+    manager.RegisterUdpEndpoint(1, new_endpoint);
+    EXPECT_EQ(manager.GetSessionByUdpEndpoint(new_endpoint), sessions[0]);
+    EXPECT_EQ(manager.GetSessionByUdpEndpoint(old_endpoint), nullptr);
+
+    size_t endpoints = 0;
+    for (size_t shard = 0; shard < manager.GetUdpShardCount(); ++shard) {
+        const auto snapshot = manager.GetUdpEndpointSnapshot(shard);
+        EXPECT_EQ(snapshot->version, manager.GetUdpShardVersion(shard));
+        for (const auto& [endpoint, session] : snapshot->sessions) {
+            EXPECT_EQ(manager.UdpShardFor(endpoint), shard);
+            ++endpoints;
+        }
+    }
+    EXPECT_EQ(endpoints, kSessions);
+}
+
+// [SEQUENCE: MVP19-437] Re-registrations of one session racing each other, and an Unregister racing them, leave
+// the endpoint table with the session's current endpoint only, or nothing once it is unregistered.
+TEST_F(SessionManagerTest, ConcurrentUdpRebindsLeaveNoStaleEndpoints) {
+    const auto address = boost::asio::ip::make_address("10.0.0.2");
+    auto count_bound = [&](const std::shared_ptr<Session>& session) {
+        size_t bound = 0;
+        for (size_t shard = 0; shard < manager.GetUdpShardCount(); ++shard) {
+            for (const auto& [endpoint, weak] : manager.GetUdpEndpointSnapshot(shard)->sessions) {
+                if (weak.lock() == session) ++bound;
+            }
+        }
+        return bound;
+    };
+
+    for (uint32_t round = 0; round < 50; ++round) {
+        const uint32_t id = 100 + round;
+        auto session = MakeSession(id);
+        manager.Register(session);
+        std::vector<std::thread> threads;
+        for (uint16_t t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                for (uint16_t k = 0; k < 50; ++k) {
+                    manager.RegisterUdpEndpoint(id, {address, static_cast<uint16_t>(10000 + t * 1000 + k)});
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        ASSERT_EQ(count_bound(session), 1u);
+        EXPECT_EQ(manager.GetSessionByUdpEndpoint(*session->GetUdpEndpoint()), session);
+
+        std::thread rebinder([&] {
+            for (uint16_t k = 0; k < 50; ++k) manager.RegisterUdpEndpoint(id, {address, static_cast<uint16_t>(20000 + k)});
+        });
+        manager.Unregister(id);
+        rebinder.join();
+        EXPECT_EQ(count_bound(session), 0u);
+    }
+}
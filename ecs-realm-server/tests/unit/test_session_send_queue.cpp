@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include "network/session_send_queue.h"
+
+#include <memory>
+#include <vector>
+
+using namespace mmorpg::network;
+using mmorpg::proto::PacketType;
+using Clock = SessionSendQueue::Clock;
+using namespace std::chrono_literals;
+
+namespace {
+
+// A framed packet whose first byte tags it, so the send order can be read back from the flushed bytes
+SessionSendQueue::Packet MakePacket(size_t size, uint8_t tag) {
+    SessionSendQueue::Packet packet;
+    packet.owned.assign(size, std::byte{0});
+    packet.owned[0] = static_cast<std::byte>(tag);
+    return packet;
+}
+
+std::vector<uint8_t> Tags(const std::vector<std::byte>& flushed, size_t packet_size) {
+    std::vector<uint8_t> tags;
+    for (size_t offset = 0; offset < flushed.size(); offset += packet_size) {
+        tags.push_back(static_cast<uint8_t>(flushed[offset]));
+    }
+    return tags;
+}
+
+SessionSendQueueConfig UnthrottledConfig() {
+    SessionSendQueueConfig config;
+    config.min_burst_bytes = 1 << 30;
+    return config;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-294] Higher classes drain first, FIFO within a class, and a packet that has waited max_wait
+// goes ahead of newer higher-class traffic.
+TEST(SessionSendQueueTest, SendsByPriorityWithoutStarvingBulk) {
+    const auto start = Clock::time_point{} + 1h;
+    SessionSendQueue queue(UnthrottledConfig(), start);
+
+    queue.Push(mmorpg::proto::PACKET_CHAT_MESSAGE, MakePacket(32, 1), start);
+    queue.Push(mmorpg::proto::PACKET_ENTITY_UPDATE_BATCH, MakePacket(32, 2), start);
+    queue.Push(mmorpg::proto::PACKET_COMBAT_RESULT, MakePacket(32, 3), start);
+    queue.Push(mmorpg::proto::PACKET_HEARTBEAT_RESPONSE, MakePacket(32, 4), start);
+    queue.Push(mmorpg::proto::PACKET_COMBAT_RESULT, MakePacket(32, 5), start);
+
+    std::vector<std::byte> flushed;
+    EXPECT_EQ(queue.TakeBatch(start, 1 << 20, 256, flushed), 5u);
+    EXPECT_EQ(Tags(flushed, 32), (std::vector<uint8_t>{4, 3, 5, 2, 1}));
+    EXPECT_TRUE(queue.Empty());
+
+    // Chat queued first, then a steady stream of combat: chat waits until it is max_wait old, no longer
+    queue.Push(mmorpg::proto::PACKET_CHAT_MESSAGE, MakePacket(32, 10), start);
+    size_t chat_sent_at_ms = 0;
+    for (size_t ms = 0; ms < 400 && chat_sent_at_ms == 0; ms += 10) {
+        const auto now = start + std::chrono::milliseconds(ms);
+        queue.Push(mmorpg::proto::PACKET_COMBAT_RESULT, MakePacket(32, 11), now);
+        queue.Push(mmorpg::proto::PACKET_COMBAT_RESULT, MakePacket(32, 11), now);
+        flushed.clear();
+        queue.TakeBatch(now, 1 << 20, 1, flushed);
+        if (Tags(flushed, 32)[0] == 10) chat_sent_at_ms = ms;
+    }
+    EXPECT_EQ(chat_sent_at_ms, 250u);
+    EXPECT_EQ(queue.GetStats().promoted, 1u);
+}
+
+// [SEQUENCE: MVP19-295] Newer state replaces queued state in the older packet's slot; once sent, the key is
+// free again. Delta snapshots supersede each other without a key.
+TEST(SessionSendQueueTest, NewerStateSupersedesQueuedState) {
+    const auto now = Clock::time_point{} + 1h;
+    SessionSendQueue queue(UnthrottledConfig(), now);
+
+    EXPECT_EQ(queue.PushLatest(mmorpg::proto::PACKET_MOVEMENT_UPDATE, 7, MakePacket(40, 1), now),
+              SessionSendQueue::PushResult::Queued);
+    queue.PushLatest(mmorpg::proto::PACKET_MOVEMENT_UPDATE, 8, MakePacket(40, 2), now);
+    queue.Push(mmorpg::proto::PACKET_MOVEMENT_UPDATE, MakePacket(40, 3), now);
+    EXPECT_EQ(queue.PushLatest(mmorpg::proto::PACKET_MOVEMENT_UPDATE, 7, MakePacket(40, 4), now),
+              SessionSendQueue::PushResult::Superseded);
+    EXPECT_EQ(queue.PushLatest(mmorpg::proto::PACKET_MOVEMENT_UPDATE, 7, MakePacket(40, 5), now),
+              SessionSendQueue::PushResult::Superseded);
+    // Same key, different type: unrelated state
+    queue.PushLatest(mmorpg::proto::PACKET_ENTITY_UPDATE, 7, MakePacket(40, 6), now);
+    EXPECT_EQ(queue.GetQueuedPackets(), 4u);
+    EXPECT_EQ(queue.GetQueuedBytes(), 160u);
+
+    std::vector<std::byte> flushed;
+    queue.TakeBatch(now, 1 << 20, 256, flushed);
+    EXPECT_EQ(Tags(flushed, 40), (std::vector<uint8_t>{5, 2, 3, 6}));
+
+    EXPECT_EQ(queue.PushLatest(mmorpg::proto::PACKET_MOVEMENT_UPDATE, 7, MakePacket(40, 7), now),
+              SessionSendQueue::PushResult::Queued);
+    queue.Push(mmorpg::proto::PACKET_ENTITY_DELTA_SNAPSHOT, MakePacket(40, 8), now);
+    EXPECT_EQ(queue.Push(mmorpg::proto::PACKET_ENTITY_DELTA_SNAPSHOT, MakePacket(40, 9), now),
+              SessionSendQueue::PushResult::Superseded);
+    flushed.clear();
+    queue.TakeBatch(now, 1 << 20, 256, flushed);
+    EXPECT_EQ(Tags(flushed, 40), (std::vector<uint8_t>{7, 9}));
+    EXPECT_EQ(queue.GetStats().packets_superseded, 3u);
+}
+
+// [SEQUENCE: MVP19-296] Slow write completions pull the bucket rate down to the client's drain rate, which
+// then meters each batch; quick completions raise it again.
+TEST(SessionSendQueueTest, TokenBucketFollowsObservedThroughput) {
+    auto now = Clock::time_point{} + 1h;
+    SessionSendQueueConfig config;
+    config.initial_rate_bytes_per_second = 1024.0 * 1024;
+    SessionSendQueue queue(config, now);
+
+    // 64 KiB writes taking two seconds each: the client drains 32 KiB/s
+    for (int i = 0; i < 40; ++i) queue.OnWriteComplete(64 * 1024, 2s);
+    EXPECT_NEAR(queue.GetRate(), 1.25 * 32 * 1024, 1024);
+
+    for (uint8_t i = 0; i < 100; ++i) queue.Push(mmorpg::proto::PACKET_ENTITY_UPDATE_BATCH, MakePacket(1024, i), now);
+    std::vector<std::byte> flushed;
+    const size_t first = queue.TakeBatch(now, 1 << 20, 256, flushed);
+    EXPECT_EQ(first, config.min_burst_bytes / 1024);
+
+    // Empty bucket: nothing until it refills
+    EXPECT_EQ(queue.TakeBatch(now, 1 << 20, 256, flushed), 0u);
+    const auto delay = queue.NextSendDelay(now);
+    EXPECT_GT(delay, 0ms);
+    now += 100ms;
+    const size_t second = queue.TakeBatch(now, 1 << 20, 256, flushed);
+    EXPECT_GE(second, 3u);
+    EXPECT_LE(second, 5u);
+    EXPECT_GE(queue.GetStats().throttled, 2u);
+
+    // A fast link shows itself as soon as writes complete quickly
+    for (int i = 0; i < 40; ++i) queue.OnWriteComplete(64 * 1024, 1ms);
+    EXPECT_GT(queue.GetRate(), 32.0 * 1024 * 1024);
+    now += 100ms;
+    flushed.clear();
+    EXPECT_EQ(queue.TakeBatch(now, 1 << 20, 256, flushed), 100 - first - second);
+}
+
+// [SEQUENCE: MVP19-297] The memory cap counts shared broadcast buffers too and refuses the push that would
+// cross it, including a superseding one that grows the queue.
+TEST(SessionSendQueueTest, RefusesPushesOverMemoryCap) {
+    const auto now = Clock::time_point{} + 1h;
+    SessionSendQueueConfig config;
+    config.max_queued_bytes = 4096;
+    SessionSendQueue queue(config, now);
+
+    auto broadcast = std::make_shared<const std::vector<std::byte>>(1024, std::byte{1});
+    for (int i = 0; i < 3; ++i) {
+        SessionSendQueue::Packet packet;
+        packet.shared = broadcast;
+        EXPECT_EQ(queue.Push(mmorpg::proto::PACKET_ENTITY_UPDATE_BATCH, std::move(packet), now),
+                  SessionSendQueue::PushResult::Queued);
+    }
+    queue.PushLatest(mmorpg::proto::PACKET_MOVEMENT_UPDATE, 1, MakePacket(512, 1), now);
+    EXPECT_EQ(queue.PushLatest(mmorpg::proto::PACKET_MOVEMENT_UPDATE, 1, MakePacket(2048, 2), now),
+              SessionSendQueue::PushResult::Overflow);
+    EXPECT_EQ(queue.Push(mmorpg::proto::PACKET_CHAT_MESSAGE, MakePacket(1024, 3), now),
+              SessionSendQueue::PushResult::Overflow);
+    EXPECT_EQ(queue.Push(mmorpg::proto::PACKET_CHAT_MESSAGE, MakePacket(512, 4), now),
+              SessionSendQueue::PushResult::Queued);
+    EXPECT_EQ(queue.GetQueuedBytes(), 4096u);
+    EXPECT_EQ(queue.GetStats().overflows, 2u);
+
+    queue.Clear();
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_EQ(broadcast.use_count(), 1);
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include "network/session.h"
+#include "network/kernel_tls.h"
+#include "../performance/tls_test_certificate.h"
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace mmorpg;
+using namespace mmorpg::network;
+using boost::asio::ip::tcp;
+
+namespace {
+
+// One server Session with the given flush caps on its own io thread, and a blocking TLS client on loopback
+struct WriteLoopback {
+    explicit WriteLoopback(SessionWriteConfig config, const char* client_ciphersuites = nullptr) {
+        certificate.Use(server_context);
+        if (config.kernel_tls) kernel_tls::InstallSecretCapture(server_context.native_handle());
+        client_context.set_verify_mode(boost::asio::ssl::verify_none);
+        if (client_ciphersuites) SSL_CTX_set_ciphersuites(client_context.native_handle(), client_ciphersuites);
+
+        tcp::acceptor acceptor(io_context, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+        client.next_layer().connect(acceptor.local_endpoint());
+        config.send_queue.min_burst_bytes = 1 << 30;   // Only the flush caps limit a batch
+        session = std::make_shared<Session>(acceptor.accept(), server_context, 1, nullptr, config);
+        session->Start();
+
+        io_thread = std::thread([this] { io_context.run(); });
+        client.handshake(boost::asio::ssl::stream_base::client);
+        while (session->GetState() != SessionState::Connected ||
+               (config.kernel_tls && session->GetKernelTlsStatus() == KernelTlsStatus::Disabled)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    ~WriteLoopback() {
+        session->Disconnect();
+        work.reset();
+        io_context.stop();
+        io_thread.join();
+    }
+
+    // Queues every packet while the io thread is held, so all but the first wait behind an in-flight write,
+    // then reads back everything the session sent
+    std::vector<std::byte> SendAll(const std::vector<SharedPacketBuffer>& packets) {
+        std::promise<void> release;
+        boost::asio::post(io_context, [held = release.get_future().share()] { held.wait(); });
+        size_t total = 0;
+        for (const auto& packet : packets) {
+            session->SendShared(packet);
+            total += packet->size();
+        }
+        release.set_value();
+
+        std::vector<std::byte> received(total);
+        boost::asio::read(client, boost::asio::buffer(received));
+        return received;
+    }
+
+    bench::SelfSignedCertificate certificate;
+    boost::asio::io_context io_context;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work{io_context.get_executor()};
+    boost::asio::ssl::context server_context{boost::asio::ssl::context::tls_server};
+    boost::asio::ssl::context client_context{boost::asio::ssl::context::tls_client};
+    boost::asio::ssl::stream<tcp::socket> client{io_context, client_context};
+    std::shared_ptr<Session> session;
+    std::thread io_thread;
+};
+
+std::vector<SharedPacketBuffer> MakePackets(size_t count, size_t size) {
+    std::vector<SharedPacketBuffer> packets;
+    for (size_t i = 0; i < count; ++i) {
+        packets.push_back(std::make_shared<const std::vector<std::byte>>(size, static_cast<std::byte>(i)));
+    }
+    return packets;
+}
+
+SessionWriteConfig Caps(size_t max_flush_bytes, size_t max_flush_messages) {
+    SessionWriteConfig config;
+    config.max_flush_bytes = max_flush_bytes;
+    config.max_flush_messages = max_flush_messages;
+    return config;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-402] Packets queued behind a write go out together, never more per flush than
+// max_flush_messages, and in the order they were sent.
+TEST(SessionWriteTest, FlushStopsAtMessageCap) {
+    WriteLoopback loopback(Caps(64 * 1024, 8));
+    const auto packets = MakePackets(100, 64);
+    const auto received = loopback.SendAll(packets);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        ASSERT_EQ(received[i * 64], static_cast<std::byte>(i));
+    }
+
+    const auto stats = loopback.session->GetWriteStats();
+    EXPECT_EQ(stats.messages_flushed, 100u);
+    EXPECT_EQ(stats.bytes_flushed, 100u * 64u);
+    EXPECT_EQ(stats.max_flush_messages, 8u);
+    EXPECT_GE(stats.flushes, 1u + 99u / 8u);   // The first packet goes alone, the rest in batches of 8
+    EXPECT_LT(stats.flushes, 100u);
+    EXPECT_GT(stats.max_queue_depth, 8u);
+}
+
+// [SEQUENCE: MVP19-403] A flush takes packets only while they fit in max_flush_bytes: six 600-byte packets fit
+// in 4 KiB, a seventh would not.
+TEST(SessionWriteTest, FlushStopsAtByteCap) {
+    WriteLoopback loopback(Caps(4096, 256));
+    loopback.SendAll(MakePackets(60, 600));
+
+    const auto stats = loopback.session->GetWriteStats();
+    EXPECT_EQ(stats.messages_flushed, 60u);
+    EXPECT_EQ(stats.bytes_flushed, 60u * 600u);
+    EXPECT_EQ(stats.max_flush_messages, 4096u / 600u);
+    EXPECT_GE(stats.flushes, 1u + 59u / 6u);
+}
+
+// [SEQUENCE: MVP19-404] A packet larger than max_flush_bytes is still sent, in a flush of its own.
+TEST(SessionWriteTest, OversizePacketIsSentAlone) {
+    WriteLoopback loopback(Caps(4096, 256));
+    auto packets = MakePackets(3, 100);
+    packets.insert(packets.begin() + 1, std::make_shared<const std::vector<std::byte>>(10000, std::byte{0x7F}));
+    const auto received = loopback.SendAll(packets);
+    EXPECT_EQ(received[100], std::byte{0x7F});
+    EXPECT_EQ(received[10099], std::byte{0x7F});
+    EXPECT_EQ(received[10100], std::byte{1});
+
+    const auto stats = loopback.session->GetWriteStats();
+    EXPECT_EQ(stats.messages_flushed, 4u);
+    EXPECT_EQ(stats.bytes_flushed, 10300u);
+    // The first packet, then the oversize one, which fills its flush, then the last two together
+    EXPECT_EQ(stats.flushes, 3u);
+    EXPECT_EQ(stats.max_flush_messages, 2u);
+}
+
+// [SEQUENCE: MVP19-445] Whatever this kernel supports, a kernel TLS session offloads exactly the ciphers the probe
+// accepted and stays on userspace TLS for the rest; it is never closed, and the client reads the same bytes.
+TEST(SessionWriteTest, KernelTlsOffloadsOnlyProbedCiphers) {
+    const KernelTlsSupport& support = kernel_tls::ProbeSupport();
+    const std::pair<const char*, bool> suites[] = {
+        {"TLS_AES_128_GCM_SHA256", support.aes_128_gcm},
+        {"TLS_AES_256_GCM_SHA384", support.aes_256_gcm},
+        {"TLS_CHACHA20_POLY1305_SHA256", support.chacha20_poly1305},
+    };
+    for (const auto& [suite, offloaded] : suites) {
+        SCOPED_TRACE(suite);
+        SessionWriteConfig config;
+        config.kernel_tls = true;
+        WriteLoopback loopback(config, suite);
+        EXPECT_EQ(loopback.session->IsKernelTlsActive(), offloaded);
+        EXPECT_NE(loopback.session->GetKernelTlsStatus(), KernelTlsStatus::KeyInstallFailed);
+
+        const auto packets = MakePackets(20, 300);
+        const auto received = loopback.SendAll(packets);
+        for (size_t i = 0; i < packets.size(); ++i) {
+            ASSERT_EQ(received[i * 300], static_cast<std::byte>(i));
+        }
+        EXPECT_EQ(loopback.session->GetState(), SessionState::Connected);
+    }
+}
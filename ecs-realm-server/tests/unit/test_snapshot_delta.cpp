@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "network/snapshot_delta.h"
+
+#include <cmath>
+
+using namespace mmorpg::network;
+
+namespace {
+
+EntitySyncState MakeState(uint64_t entity_id, float x, float hp) {
+    EntitySyncState state;
+    state.entity_id = entity_id;
+    state.Set(SyncField::PositionX, x);
+    state.Set(SyncField::PositionY, 5.0f);
+    state.Set(SyncField::RotationY, 1.5f);
+    state.Set(SyncField::Health, hp);
+    state.Set(SyncField::MaxHealth, 100.0f);
+    return state;
+}
+
+SyncSnapshot MakeSnapshot(uint32_t tick, std::vector<EntitySyncState> entities) {
+    SyncSnapshot snapshot{tick, std::move(entities)};
+    snapshot.SortById();
+    return snapshot;
+}
+
+void ExpectSameEntities(const SyncSnapshot& expected, const SyncSnapshot& actual) {
+    EXPECT_EQ(actual.tick, expected.tick);
+    ASSERT_EQ(actual.entities.size(), expected.entities.size());
+    for (size_t i = 0; i < expected.entities.size(); ++i) {
+        EXPECT_EQ(actual.entities[i], expected.entities[i]) << "entity " << expected.entities[i].entity_id;
+    }
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-166] Dequantized values stay within half a resolution step of the input.
+TEST(SnapshotDeltaTest, QuantizationErrorIsBounded) {
+    EntitySyncState state;
+    for (float value : {0.0f, 0.004f, -0.004f, 123.456f, -9876.543f, 3.14159f}) {
+        for (size_t f = 0; f < kSyncFieldCount; ++f) {
+            const auto field = static_cast<SyncField>(f);
+            state.Set(field, value);
+            EXPECT_LE(std::fabs(state.Get(field) - value), kSyncFieldResolution[f] * 0.5f + 1e-3f);
+        }
+    }
+}
+
+// [SEQUENCE: MVP19-167] Moved, added, removed and unchanged entities all survive a delta round trip, and a
+// delta is much smaller than the full snapshot it replaces.
+TEST(SnapshotDeltaTest, RoundTripsDeltaAgainstAckedBaseline) {
+    ClientBaselineTracker tracker;
+    SnapshotDeltaDecoder decoder;
+    std::vector<std::byte> packet;
+    SyncSnapshot decoded;
+
+    std::vector<EntitySyncState> crowd;
+    for (uint64_t id = 1; id <= 50; ++id) {
+        crowd.push_back(MakeState(id * 3, static_cast<float>(id), 100.0f));
+    }
+    const auto first = MakeSnapshot(1, crowd);
+    tracker.Encode(first, packet);
+    const size_t full_size = packet.size();
+    ASSERT_TRUE(decoder.Decode(packet.data(), packet.size(), decoded));
+    ExpectSameEntities(first, decoded);
+    tracker.Acknowledge(1);
+
+    crowd[4] = MakeState(crowd[4].entity_id, 42.0f, 100.0f);   // Moved
+    crowd[9] = MakeState(crowd[9].entity_id, 10.0f, 55.5f);    // Damaged
+    crowd.erase(crowd.begin() + 20);                           // Left view
+    crowd.push_back(MakeState(1000, -7.0f, 80.0f));            // Entered view
+    const auto second = MakeSnapshot(2, crowd);
+    tracker.Encode(second, packet);
+    ASSERT_TRUE(decoder.Decode(packet.data(), packet.size(), decoded));
+    ExpectSameEntities(second, decoded);
+
+    EXPECT_LT(packet.size() * 5, full_size);
+    const auto& stats = tracker.GetStats();
+    EXPECT_EQ(stats.full_snapshots, 1u);
+    EXPECT_EQ(stats.entities_written, 50u + 3u);
+    EXPECT_EQ(stats.entities_unchanged, 47u);
+    EXPECT_EQ(stats.entities_removed, 1u);
+}
+
+// [SEQUENCE: MVP19-168] Until a newer ack arrives, every snapshot is a delta against the same baseline; once that
+// baseline has aged out of the ring the tracker falls back to full state, which the decoder accepts as is.
+TEST(SnapshotDeltaTest, FallsBackToFullStateWhenBaselineExpires) {
+    ClientBaselineTracker tracker(4);
+    SnapshotDeltaDecoder decoder(4);
+    std::vector<std::byte> packet;
+    SyncSnapshot decoded;
+
+    tracker.Encode(MakeSnapshot(1, {MakeState(7, 0.0f, 100.0f)}), packet);
+    ASSERT_TRUE(decoder.Decode(packet.data(), packet.size(), decoded));
+    tracker.Acknowledge(1);
+
+    for (uint32_t tick = 2; tick <= 6; ++tick) {
+        const auto snapshot = MakeSnapshot(tick, {MakeState(7, static_cast<float>(tick), 100.0f)});
+        tracker.Encode(snapshot, packet);
+        ASSERT_TRUE(decoder.Decode(packet.data(), packet.size(), decoded)) << "tick " << tick;
+        ExpectSameEntities(snapshot, decoded);
+    }
+    // Ticks 2-4 are within the ring of 4 from the ack at tick 1; 5 and 6 are not.
+    EXPECT_EQ(tracker.GetStats().full_snapshots, 3u);
+
+    // An ack for a snapshot that was never sent (or was already overwritten) is ignored.
+    tracker.Acknowledge(2);
+    EXPECT_EQ(tracker.GetAckedTick(), 1u);
+    tracker.Acknowledge(6);
+    EXPECT_EQ(tracker.GetAckedTick(), 6u);
+}
+
+// [SEQUENCE: MVP19-169] A delta whose baseline the client does not hold, or a truncated packet, is rejected.
+TEST(SnapshotDeltaTest, RejectsUnknownBaselineAndTruncatedPackets) {
+    ClientBaselineTracker tracker;
+    std::vector<std::byte> first;
+    std::vector<std::byte> second;
+    tracker.Encode(MakeSnapshot(1, {MakeState(1, 1.0f, 10.0f), MakeState(2, 2.0f, 20.0f)}), first);
+    tracker.Acknowledge(1);
+    tracker.Encode(MakeSnapshot(2, {MakeState(1, 1.5f, 10.0f), MakeState(2, 2.0f, 20.0f)}), second);
+
+    SnapshotDeltaDecoder decoder;
+    SyncSnapshot decoded;
+    EXPECT_FALSE(decoder.Decode(second.data(), second.size(), decoded));
+    EXPECT_FALSE(decoder.Decode(first.data(), first.size() - 3, decoded));
+    ASSERT_TRUE(decoder.Decode(first.data(), first.size(), decoded));
+    ASSERT_TRUE(decoder.Decode(second.data(), second.size(), decoded));
+    EXPECT_FLOAT_EQ(decoded.Find(1)->Get(SyncField::PositionX), 1.5f);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "game/world/grid/flat_world_grid.h"
+#include "game/world/grid/world_grid.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace mmorpg::game::world;
+using mmorpg::core::ecs::EntityId;
+using mmorpg::core::utils::Vector3;
+
+namespace {
+
+std::vector<EntityId> Sorted(std::span<const EntityId> ids) {
+    std::vector<EntityId> sorted(ids.begin(), ids.end());
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+
+// Runs every task on its own thread
+BatchQueryOptions ThreadPerTask(size_t queries_per_task) {
+    BatchQueryOptions options;
+    options.queries_per_task = queries_per_task;
+    options.parallel_for = [](size_t task_count, const std::function<void(size_t)>& task) {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < task_count; ++t) threads.emplace_back(task, t);
+        for (auto& thread : threads) thread.join();
+    };
+    return options;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-366] Every query of a batch finds what a brute-force scan finds under its layer mask, with
+// many queries per cell and centres outside the grid, serially and split across threads, and the results buffer
+// is reused from one batch to the next.
+TEST(SpatialQueryBatchTest, FlatGridBatchMatchesBruteForce) {
+    grid::FlatWorldGrid::Config config;
+    config.cell_size = 10.0f;
+    config.grid_width = 50;
+    config.grid_height = 50;
+    grid::FlatWorldGrid index(config);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coord(0.0f, 500.0f);
+    std::uniform_real_distribution<float> height(-10.0f, 10.0f);
+    std::unordered_map<EntityId, std::pair<Vector3, uint32_t>> entities;
+    for (EntityId id = 1; id <= 4000; ++id) {
+        const Vector3 p{coord(rng), coord(rng), height(rng)};
+        const uint32_t layers = id % 3 == 0 ? kAllLayers : 1u << (id % 4);
+        entities[id] = {p, layers};
+        index.AddEntity(id, p);
+        if (layers != kAllLayers) index.SetEntityLayers(id, layers);
+    }
+    index.Commit();
+
+    // Clusters of queries around a few points, so many share a centre cell, plus scattered and degenerate ones
+    std::vector<RadiusQuery> queries;
+    std::uniform_real_distribution<float> jitter(-4.0f, 4.0f);
+    std::uniform_real_distribution<float> radius(0.0f, 40.0f);
+    for (int cluster = 0; cluster < 30; ++cluster) {
+        const Vector3 c{coord(rng), coord(rng), 0.0f};
+        for (int k = 0; k < 12; ++k) {
+            queries.push_back({{c.x + jitter(rng), c.y + jitter(rng), height(rng)}, radius(rng),
+                               static_cast<uint32_t>(rng() % 3 == 0 ? kAllLayers : (rng() % 15) + 1)});
+        }
+    }
+    for (int k = 0; k < 100; ++k) queries.push_back({{coord(rng), coord(rng), 0.0f}, radius(rng), kAllLayers});
+    queries.push_back({{-30.0f, 250.0f, 0.0f}, 45.0f, kAllLayers});   // Centre outside, reaching in
+    queries.push_back({{250.0f, 250.0f, 0.0f}, 30.0f, 0});              // Matches nothing
+    queries.push_back({{250.0f, 250.0f, 0.0f}, -1.0f, kAllLayers});     // Matches nothing
+
+    auto expect_matches = [&](const SpatialQueryResults& results) {
+        ASSERT_EQ(results.QueryCount(), queries.size());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            const auto& q = queries[i];
+            std::vector<EntityId> expected;
+            for (const auto& [id, entity] : entities) {
+                const auto& [p, layers] = entity;
+                const float dx = p.x - q.center.x, dy = p.y - q.center.y, dz = p.z - q.center.z;
+                if (dx * dx + dy * dy + dz * dz <= q.radius * q.radius && (layers & q.layer_mask) != 0) {
+                    expected.push_back(id);
+                }
+            }
+            std::sort(expected.begin(), expected.end());
+            EXPECT_EQ(Sorted(results[i]), expected) << "query " << i;
+        }
+    };
+
+    SpatialQueryResults results;
+    index.QueryRadiusBatch(queries, results);
+    expect_matches(results);
+    index.QueryRadiusBatch(queries, results, ThreadPerTask(64));
+    expect_matches(results);
+
+    // Layers survive position updates
+    index.UpdateEntity(3, entities[3].first, {100.0f, 100.0f, 0.0f});
+    entities[3].first = {100.0f, 100.0f, 0.0f};
+    index.Commit();
+    index.QueryRadiusBatch(queries, results, ThreadPerTask(1000));
+    expect_matches(results);
+}
+
+// [SEQUENCE: MVP19-367] WorldGrid's batch returns the same broad-phase candidates as its per-query calls
+TEST(SpatialQueryBatchTest, WorldGridBatchMatchesSingleQueries) {
+    grid::WorldGrid::Config config;
+    config.cell_size = 20.0f;
+    config.grid_width = 20;
+    config.grid_height = 20;
+    grid::WorldGrid index(config);
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> coord(0.0f, 400.0f);
+    for (EntityId id = 1; id <= 1000; ++id) index.AddEntity(id, {coord(rng), coord(rng), 0.0f});
+
+    std::vector<RadiusQuery> queries;
+    for (int k = 0; k < 50; ++k) queries.push_back({{coord(rng), coord(rng), 0.0f}, 30.0f, kAllLayers});
+    queries.push_back({{200.0f, 200.0f, 0.0f}, 30.0f, 0});
+
+    SpatialQueryResults results;
+    index.QueryRadiusBatch(queries, results);
+    ASSERT_EQ(results.QueryCount(), queries.size());
+    for (size_t i = 0; i + 1 < queries.size(); ++i) {
+        const auto single = index.GetEntitiesInRadius(queries[i].center, queries[i].radius);
+        EXPECT_EQ(Sorted(results[i]), Sorted(single));
+    }
+    EXPECT_TRUE(results[queries.size() - 1].empty());
+}
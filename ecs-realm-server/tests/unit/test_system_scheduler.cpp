@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include "game/systems/scheduling/system_scheduler.h"
+#include "game/systems/scheduling/work_stealing_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace mmorpg::game::systems::scheduling;
+
+namespace {
+
+// Component stand-ins; only their types matter to the scheduler
+struct Transform {};
+struct Velocity {};
+struct Health {};
+struct Grid {};
+
+// Each system's update as a start and end stamp from one counter, so the test can see what overlapped
+class Trace {
+public:
+    struct Span {
+        int start = -1;
+        int end = -1;
+    };
+
+    explicit Trace(size_t systems) : spans_(systems) {}
+
+    SystemScheduler::UpdateFunction Record(size_t system, std::function<void()> work = {}) {
+        return [this, system, work](float) {
+            spans_[system].start = clock_.fetch_add(1);
+            if (work) work();
+            spans_[system].end = clock_.fetch_add(1);
+        };
+    }
+
+    bool Before(size_t a, size_t b) const { return spans_[a].end < spans_[b].start; }
+    void Reset() {
+        clock_ = 0;
+        for (auto& span : spans_) span = {};
+    }
+
+private:
+    std::vector<Span> spans_;
+    std::atomic<int> clock_{0};
+};
+
+// Spins until both sides have arrived, or gives up after a while; true if they met
+class Rendezvous {
+public:
+    bool Arrive() {
+        arrived_.fetch_add(1);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (arrived_.load() < 2) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::yield();
+        }
+        return true;
+    }
+    void Reset() { arrived_ = 0; }
+
+private:
+    std::atomic<int> arrived_{0};
+};
+
+// A system whose declared access is that of PostUpdate, like GridSpatialSystem
+struct StagedSystem {
+    SystemAccess GetComponentAccess() const { return SystemAccess().Reads<Transform>().Writes<Grid>(); }
+    void Update(float) { updates.fetch_add(1); }
+    void PostUpdate(float) { post_updates.fetch_add(1); }
+
+    std::atomic<int> updates{0};
+    std::atomic<int> post_updates{0};
+};
+
+} // namespace
+
+// [SEQUENCE: MVP19-380] Systems that conflict run in the order they were added, frame after frame, and systems
+// that do not conflict run at the same time: movement and effects meet mid-update.
+TEST(SystemSchedulerTest, ConflictsKeepAddedOrderAndTheRestOverlap) {
+    WorkStealingPool pool(3);
+    SystemScheduler scheduler(pool);
+    Trace trace(5);
+    Rendezvous rendezvous;
+    std::atomic<int> met{0};
+
+    const auto movement = scheduler.AddSystem("movement", SystemAccess().Writes<Transform, Velocity>(),
+                                              trace.Record(0, [&] { met += rendezvous.Arrive(); }));
+    const auto grid = scheduler.AddSystem("grid", SystemAccess().Reads<Transform>().Writes<Grid>(), trace.Record(1));
+    const auto status = scheduler.AddSystem("status", SystemAccess().Writes<Velocity>().Reads<Velocity>(),
+                                            trace.Record(2));
+    const auto effects = scheduler.AddSystem("effects", SystemAccess().Reads<Health>(),
+                                             trace.Record(3, [&] { met += rendezvous.Arrive(); }));
+    const auto combat = scheduler.AddSystem("combat", SystemAccess().Reads<Grid>().Writes<Health>(), trace.Record(4));
+
+    for (int frame = 0; frame < 50; ++frame) {
+        trace.Reset();
+        rendezvous.Reset();
+        scheduler.Update(0.05f);
+
+        EXPECT_TRUE(trace.Before(movement, grid));
+        EXPECT_TRUE(trace.Before(movement, status));
+        EXPECT_TRUE(trace.Before(grid, combat));
+        EXPECT_TRUE(trace.Before(effects, combat));
+    }
+    EXPECT_EQ(met.load(), 100);
+
+    EXPECT_EQ(scheduler.GetDependencies(movement), std::vector<SystemScheduler::SystemHandle>{});
+    EXPECT_EQ(scheduler.GetDependencies(grid), std::vector<SystemScheduler::SystemHandle>{movement});
+    EXPECT_EQ(scheduler.GetDependencies(status), std::vector<SystemScheduler::SystemHandle>{movement});
+    EXPECT_EQ(scheduler.GetDependencies(effects), std::vector<SystemScheduler::SystemHandle>{});
+    EXPECT_EQ(scheduler.GetDependencies(combat), (std::vector<SystemScheduler::SystemHandle>{grid, effects}));
+    EXPECT_EQ(scheduler.GetFrameStats().dependencies, 4u);
+    EXPECT_EQ(scheduler.GetFrameStats().frames, 50u);
+    EXPECT_EQ(scheduler.GetTiming(combat).runs, 50u);
+
+    // A system changing entities is ordered against everything
+    scheduler.SetEnabled(effects, false);
+    scheduler.AddSystem("spawner", SystemAccess().ChangesEntities(), [](float) {});
+    scheduler.Update(0.05f);
+    EXPECT_EQ(scheduler.GetDependencies(scheduler.GetSystemCount() - 1),
+              (std::vector<SystemScheduler::SystemHandle>{movement, grid, status, combat}));
+    EXPECT_EQ(scheduler.GetTiming(effects).runs, 50u);
+}
+
+// [SEQUENCE: MVP19-381] The critical path is the longest chain of dependent systems by measured time, and is
+// what bounds the frame: here a 30 ms chain of two beside a 20 ms system on its own.
+TEST(SystemSchedulerTest, MeasuresCriticalPath) {
+    WorkStealingPool pool(2);
+    SystemScheduler scheduler(pool);
+    auto sleep_ms = [](int ms) {
+        return [ms](float) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); };
+    };
+    const auto movement = scheduler.AddSystem("movement", SystemAccess().Writes<Transform>(), sleep_ms(15));
+    scheduler.AddSystem("regen", SystemAccess().Writes<Health>(), sleep_ms(20));
+    const auto grid = scheduler.AddSystem("grid", SystemAccess().Reads<Transform>(), sleep_ms(15));
+    scheduler.Update(0.05f);
+
+    const auto& frame = scheduler.GetFrameStats();
+    EXPECT_EQ(frame.critical_path, (std::vector<SystemScheduler::SystemHandle>{movement, grid}));
+    EXPECT_GE(frame.critical_path_us, 30000.0);
+    EXPECT_GE(frame.serial_us, 50000.0);
+    EXPECT_GE(frame.wall_us, frame.critical_path_us);
+    EXPECT_LT(frame.wall_us, frame.serial_us);
+    EXPECT_GE(scheduler.GetTiming(grid).start_us, scheduler.GetTiming(movement).last_us);
+
+    mmorpg::monitoring::MetricsCollector metrics;
+    scheduler.ExportMetrics(metrics);
+}
+
+// [SEQUENCE: MVP19-382] With no workers the calling thread runs the whole frame, and a throwing system neither
+// stops the frame nor the systems after it; its exception surfaces from Update.
+TEST(SystemSchedulerTest, RunsWithoutWorkersAndRethrows) {
+    WorkStealingPool pool(0);
+    SystemScheduler scheduler(pool);
+    std::vector<int> order;
+    scheduler.AddSystem("a", SystemAccess().Writes<Transform>(), [&](float) { order.push_back(0); });
+    scheduler.AddSystem("b", SystemAccess().Writes<Transform>(), [&](float) {
+        order.push_back(1);
+        throw std::runtime_error("system failed");
+    });
+    scheduler.AddSystem("c", SystemAccess().Reads<Transform>(), [&](float) { order.push_back(2); });
+    scheduler.AddSystem("d", SystemAccess().Writes<Health>(), [&](float) { order.push_back(3); });
+
+    EXPECT_THROW(scheduler.Update(0.05f), std::runtime_error);
+    std::sort(order.begin(), order.end());
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+}
+
+// [SEQUENCE: MVP19-383] ParallelFor covers every index once, also when nested in a task of another ParallelFor
+// (waiting threads run queued work instead of blocking), and rethrows what its body threw.
+TEST(WorkStealingPoolTest, NestedParallelForCoversEveryIndex) {
+    WorkStealingPool pool(3);
+    std::vector<std::atomic<int>> hits(64 * 100);
+    pool.ParallelFor(64, [&](size_t outer) {
+        pool.ParallelFor(100, [&](size_t inner) { hits[outer * 100 + inner].fetch_add(1); });
+    });
+    for (const auto& hit : hits) ASSERT_EQ(hit.load(), 1);
+
+    std::atomic<size_t> ran{0};
+    EXPECT_THROW(pool.ParallelFor(1000, [&](size_t i) {
+        ran.fetch_add(1);
+        if (i == 500) throw std::runtime_error("body failed");
+    }), std::runtime_error);
+    EXPECT_EQ(ran.load(), 1000u);
+
+    // Submitted tasks run even when nobody waits on them
+    std::atomic<int> submitted{0};
+    for (int i = 0; i < 100; ++i) pool.Submit([&] { submitted.fetch_add(1); });
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (submitted.load() < 100 && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+    EXPECT_EQ(submitted.load(), 100);
+    EXPECT_GE(pool.GetStats().executed, 100u);
+}
+
+// [SEQUENCE: MVP19-462] A system added by reference runs the stage it was added with, and only that one.
+TEST(SystemSchedulerTest, RunsTheStageASystemWasAddedWith) {
+    WorkStealingPool pool(1);
+    SystemScheduler scheduler(pool);
+    StagedSystem system;
+    const auto grid = scheduler.AddSystem("grid", system, &StagedSystem::PostUpdate);
+    const auto combat = scheduler.AddSystem("combat", SystemAccess().Reads<Grid>(), [](float) {});
+
+    scheduler.Update(0.05f);
+    scheduler.Update(0.05f);
+    EXPECT_EQ(system.post_updates.load(), 2);
+    EXPECT_EQ(system.updates.load(), 0);
+    EXPECT_EQ(scheduler.GetDependencies(combat), (std::vector<SystemScheduler::SystemHandle>{grid}));
+}
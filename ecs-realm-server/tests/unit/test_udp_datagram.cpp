@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include "network/udp_datagram.h"
+#include "network/movement_input_queue.h"
+
+#include <cmath>
+#include <numbers>
+
+using namespace mmorpg::network;
+
+// [SEQUENCE: MVP19-79] Header fields survive a round trip; anything without the magic or too short is rejected.
+TEST(UdpDatagramTest, HeaderRoundTrip) {
+    UdpDatagramHeader header;
+    header.type = UdpMessageType::Handshake;
+    header.flags = 0x5A;
+    header.session_token = 0x0123456789ABCDEFull;
+    header.sequence = 65535;
+    header.ack = 42;
+    header.ack_bits = 0x80000001u;
+
+    std::byte buffer[UdpDatagramHeader::kSize];
+    EncodeUdpHeader(header, buffer);
+
+    UdpDatagramHeader decoded;
+    ASSERT_TRUE(DecodeUdpHeader(buffer, sizeof(buffer), decoded));
+    EXPECT_EQ(decoded.type, header.type);
+    EXPECT_EQ(decoded.flags, header.flags);
+    EXPECT_EQ(decoded.session_token, header.session_token);
+    EXPECT_EQ(decoded.sequence, header.sequence);
+    EXPECT_EQ(decoded.ack, header.ack);
+    EXPECT_EQ(decoded.ack_bits, header.ack_bits);
+
+    EXPECT_FALSE(DecodeUdpHeader(buffer, sizeof(buffer) - 1, decoded));
+    buffer[0] = std::byte{0};
+    EXPECT_FALSE(DecodeUdpHeader(buffer, sizeof(buffer), decoded));
+}
+
+// [SEQUENCE: MVP19-80] Quantization error stays within half a step on every field.
+TEST(UdpDatagramTest, MovementQuantizationErrorIsBounded) {
+    MovementSample sample;
+    sample.position[0] = 1234.5678f;
+    sample.position[1] = -87.654f;
+    sample.position[2] = 0.004f;
+    sample.velocity[0] = 7.891f;
+    sample.velocity[1] = -3.333f;
+    sample.velocity[2] = 0.0f;
+    sample.yaw = 3.0f * std::numbers::pi_v<float>;  // Wraps to -pi
+    sample.client_time_ms = 123456789;
+
+    auto datagram = BuildMovementDatagram(UdpDatagramHeader{}, sample);
+
+    UdpDatagramHeader header;
+    ASSERT_TRUE(DecodeUdpHeader(datagram.data(), datagram.size(), header));
+    EXPECT_EQ(header.type, UdpMessageType::Movement);
+
+    MovementSample decoded;
+    ASSERT_TRUE(DecodeMovement(datagram.data() + UdpDatagramHeader::kSize, kQuantizedMovementSize, decoded));
+    for (int axis = 0; axis < 3; ++axis) {
+        EXPECT_NEAR(decoded.position[axis], sample.position[axis], 0.005f + 1e-4f);
+        EXPECT_NEAR(decoded.velocity[axis], sample.velocity[axis], 0.005f + 1e-4f);
+    }
+    const float yaw_error = std::remainder(decoded.yaw - sample.yaw, 2.0f * std::numbers::pi_v<float>);
+    EXPECT_LE(std::fabs(yaw_error), std::numbers::pi_v<float> / 65536.0f + 1e-5f);
+    EXPECT_EQ(decoded.client_time_ms, sample.client_time_ms);
+
+    EXPECT_FALSE(DecodeMovement(datagram.data(), kQuantizedMovementSize - 1, decoded));
+}
+
+// [SEQUENCE: MVP19-81] The receive window classifies newer, late and duplicate sequences across the 16-bit wrap.
+TEST(UdpDatagramTest, ChannelStateTracksWindowAcrossWrap) {
+    UdpChannelState channel;
+    EXPECT_EQ(channel.OnReceive(65534), UdpChannelState::ReceiveResult::Newest);
+    EXPECT_EQ(channel.OnReceive(1), UdpChannelState::ReceiveResult::Newest);   // Wrapped, 3 ahead
+    EXPECT_EQ(channel.OnReceive(65535), UdpChannelState::ReceiveResult::Late);
+    EXPECT_EQ(channel.OnReceive(65535), UdpChannelState::ReceiveResult::Duplicate);
+    EXPECT_EQ(channel.OnReceive(1), UdpChannelState::ReceiveResult::Duplicate);
+
+    uint16_t ack = 0;
+    uint32_t ack_bits = 0;
+    EXPECT_TRUE(channel.GetAck(ack, ack_bits));
+    EXPECT_EQ(ack, 1);
+    // 0 missing (bit 0), 65535 received (bit 1), 65534 received (bit 2).
+    EXPECT_EQ(ack_bits, 0b110u);
+
+    EXPECT_EQ(channel.OnReceive(100), UdpChannelState::ReceiveResult::Newest);
+    EXPECT_EQ(channel.OnReceive(1), UdpChannelState::ReceiveResult::Duplicate);  // Fell out of the window
+}
+
+// [SEQUENCE: MVP19-410] A movement sample overtaken by a reliable datagram is late in the shared window but
+// still the newest movement; only older movement samples are stale.
+TEST(UdpDatagramTest, MovementIsNewestAmongMovementOnly) {
+    UdpChannelState channel;
+    EXPECT_EQ(channel.OnReceive(11), UdpChannelState::ReceiveResult::Newest);   // Channel datagram
+    EXPECT_EQ(channel.OnReceive(10), UdpChannelState::ReceiveResult::Late);     // Movement sent before it
+    EXPECT_TRUE(channel.OnMovement(10));
+    EXPECT_FALSE(channel.OnMovement(10));
+    EXPECT_FALSE(channel.OnMovement(9));
+    EXPECT_TRUE(channel.OnMovement(12));
+
+    UdpChannelState wrapped;
+    EXPECT_TRUE(wrapped.OnMovement(65534));
+    EXPECT_TRUE(wrapped.OnMovement(1));
+    EXPECT_FALSE(wrapped.OnMovement(65535));
+}
+
+// [SEQUENCE: MVP19-82] A tick drain keeps only the newest sample per player.
+TEST(UdpDatagramTest, InputQueueDrainSupersedesOlderSamples) {
+    MovementInputQueue queue(4);
+    for (uint16_t sequence : {10, 12, 11}) {
+        MovementInput input;
+        input.player_id = 7;
+        input.sequence = sequence;
+        input.sample.position[0] = sequence;
+        EXPECT_TRUE(queue.Push(input));
+    }
+    MovementInput other;
+    other.player_id = 8;
+    EXPECT_TRUE(queue.Push(other));
+    EXPECT_FALSE(queue.Push(other));  // Over max_pending
+    EXPECT_EQ(queue.GetDroppedCount(), 1u);
+
+    std::vector<MovementInput> drained;
+    EXPECT_EQ(queue.DrainTick(drained), 4u);
+    ASSERT_EQ(drained.size(), 2u);
+    EXPECT_EQ(drained[0].player_id, 7u);
+    EXPECT_EQ(drained[0].sequence, 12);
+    EXPECT_EQ(queue.GetPendingCount(), 0u);
+    EXPECT_EQ(queue.GetSupersededCount(), 2u);
+}
@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+
+#include "network/udp_reliability.h"
+#include "network/udp_link_simulator.h"
+
+#include <vector>
+
+using namespace mmorpg::network;
+using Clock = UdpReliableConnection::Clock;
+
+namespace {
+
+struct Received {
+    UdpChannel channel;
+    std::vector<std::byte> bytes;
+};
+
+// [SEQUENCE: MVP19-94] Two connections joined by a simulated link in each direction, stepped in simulated time.
+class LinkedPeers {
+public:
+    LinkedPeers(const UdpLinkConditions& conditions, UdpReliabilityConfig config = {})
+        : a(a_state, 1111, config),
+          b(b_state, 2222, config),
+          a_to_b(conditions),
+          b_to_a([&] { auto reverse = conditions; reverse.seed += 1; return reverse; }()) {}
+
+    void SendFromA(UdpChannel channel, const std::vector<std::byte>& bytes) {
+        ASSERT_TRUE(a.Send(channel, bytes.data(), bytes.size(), now, SinkInto(a_to_b)));
+    }
+
+    bool TrySendFromA(UdpChannel channel, const std::vector<std::byte>& bytes) {
+        return a.Send(channel, bytes.data(), bytes.size(), now, SinkInto(a_to_b));
+    }
+
+    void Step(std::chrono::milliseconds dt) {
+        now += dt;
+        a_to_b.Deliver(now, [&](const std::byte* data, size_t size) { Receive(b, data, size, &b_received); });
+        b_to_a.Deliver(now, [&](const std::byte* data, size_t size) { Receive(a, data, size, nullptr); });
+        a.Update(now, SinkInto(a_to_b));
+        b.Update(now, SinkInto(b_to_a));
+    }
+
+    Clock::time_point now = Clock::time_point{} + std::chrono::hours(1);
+    UdpChannelState a_state;
+    UdpChannelState b_state;
+    UdpReliableConnection a;
+    UdpReliableConnection b;
+    UdpLinkSimulator a_to_b;
+    UdpLinkSimulator b_to_a;
+    std::vector<Received> b_received;
+
+private:
+    UdpReliableConnection::DatagramSink SinkInto(UdpLinkSimulator& link) {
+        return [this, &link](const std::byte* data, size_t size) { link.Submit(data, size, now); };
+    }
+
+    void Receive(UdpReliableConnection& connection, const std::byte* data, size_t size, std::vector<Received>* out) {
+        UdpDatagramHeader header;
+        ASSERT_TRUE(DecodeUdpHeader(data, size, header));
+        connection.OnDatagram(header, data + UdpDatagramHeader::kSize, size - UdpDatagramHeader::kSize, now,
+                              [out](UdpChannel channel, const std::byte* bytes, size_t length) {
+                                  if (out) out->push_back({channel, std::vector<std::byte>(bytes, bytes + length)});
+                              });
+    }
+};
+
+std::vector<std::byte> MakeMessage(size_t index, size_t size) {
+    std::vector<std::byte> bytes(size);
+    for (size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<std::byte>((index * 31 + i) & 0xFF);
+    }
+    return bytes;
+}
+
+} // namespace
+
+// [SEQUENCE: MVP19-95] Under 20% loss, duplication and heavy jitter every reliable message arrives exactly once,
+// in order, including ones fragmented across many datagrams.
+TEST(UdpReliabilityTest, ReliableOrderedSurvivesLossAndReordering) {
+    UdpLinkConditions conditions;
+    conditions.loss_rate = 0.2;
+    conditions.duplicate_rate = 0.05;
+    conditions.latency = std::chrono::milliseconds(40);
+    conditions.jitter = std::chrono::milliseconds(30);
+    LinkedPeers peers(conditions);
+
+    std::vector<std::vector<std::byte>> sent;
+    for (size_t i = 0; i < 200; ++i) {
+        const size_t size = (i % 10 == 0) ? 5000 + i : 16 + i;   // Every tenth message spans several datagrams
+        sent.push_back(MakeMessage(i, size));
+        peers.SendFromA(UdpChannel::ReliableOrdered, sent.back());
+        peers.Step(std::chrono::milliseconds(5));
+    }
+    for (int step = 0; step < 4000 && peers.b_received.size() < sent.size(); ++step) {
+        peers.Step(std::chrono::milliseconds(5));
+    }
+
+    ASSERT_EQ(peers.b_received.size(), sent.size());
+    for (size_t i = 0; i < sent.size(); ++i) {
+        EXPECT_EQ(peers.b_received[i].channel, UdpChannel::ReliableOrdered);
+        EXPECT_EQ(peers.b_received[i].bytes, sent[i]) << "message " << i;
+    }
+
+    // Let the last acks drain, then nothing is left to resend.
+    for (int step = 0; step < 400; ++step) {
+        peers.Step(std::chrono::milliseconds(5));
+    }
+    const auto stats = peers.a.GetStats();
+    EXPECT_EQ(stats.pending_fragments, 0u);
+    EXPECT_GT(stats.retransmits, 0u);
+    EXPECT_FALSE(stats.failed);
+}
+
+// [SEQUENCE: MVP19-96] The smoothed RTT tracks the link's round trip plus at most one ack delay.
+TEST(UdpReliabilityTest, RttConvergesToLinkLatency) {
+    UdpLinkConditions conditions;
+    conditions.latency = std::chrono::milliseconds(50);
+    LinkedPeers peers(conditions);
+
+    for (size_t i = 0; i < 100; ++i) {
+        peers.SendFromA(UdpChannel::ReliableOrdered, MakeMessage(i, 32));
+        peers.Step(std::chrono::milliseconds(10));
+    }
+    for (int step = 0; step < 50; ++step) {
+        peers.Step(std::chrono::milliseconds(10));
+    }
+
+    const auto stats = peers.a.GetStats();
+    EXPECT_GE(stats.srtt_ms, 100.0);
+    EXPECT_LE(stats.srtt_ms, 100.0 + 30.0);
+    EXPECT_EQ(stats.retransmits, 0u);
+}
+
+// [SEQUENCE: MVP19-97] Under reordering, sequenced messages are only ever delivered in increasing order; stale
+// ones are dropped instead of overwriting newer state.
+TEST(UdpReliabilityTest, SequencedChannelDropsStaleMessages) {
+    UdpLinkConditions conditions;
+    conditions.latency = std::chrono::milliseconds(30);
+    conditions.jitter = std::chrono::milliseconds(10);
+    conditions.seed = 7;
+    LinkedPeers peers(conditions);
+
+    for (uint16_t i = 0; i < 300; ++i) {
+        std::vector<std::byte> message{static_cast<std::byte>(i & 0xFF), static_cast<std::byte>(i >> 8)};
+        peers.SendFromA(UdpChannel::UnreliableSequenced, message);
+        peers.Step(std::chrono::milliseconds(1));
+    }
+    for (int step = 0; step < 100; ++step) {
+        peers.Step(std::chrono::milliseconds(1));
+    }
+
+    int previous = -1;
+    for (const auto& received : peers.b_received) {
+        ASSERT_EQ(received.channel, UdpChannel::UnreliableSequenced);
+        const int index = std::to_integer<int>(received.bytes[0]) | (std::to_integer<int>(received.bytes[1]) << 8);
+        EXPECT_GT(index, previous);
+        previous = index;
+    }
+    EXPECT_LT(peers.b_received.size(), 300u);
+    EXPECT_GT(peers.b.GetStats().stale_dropped, 0u);
+}
+
+// [SEQUENCE: MVP19-98] Unreliable messages must fit one datagram; reliable ones stop at the resend window.
+TEST(UdpReliabilityTest, SendRejectsWhatItCannotDeliver) {
+    UdpChannelState state;
+    UdpReliabilityConfig config;
+    config.max_pending_fragments = 4;
+    UdpReliableConnection connection(state, 1, config);
+    size_t datagrams = 0;
+    auto sink = [&](const std::byte*, size_t size) {
+        EXPECT_LE(size, config.max_datagram_size);
+        ++datagrams;
+    };
+    const auto now = Clock::now();
+
+    const auto big = MakeMessage(0, 3000);
+    EXPECT_FALSE(connection.Send(UdpChannel::Unreliable, big.data(), big.size(), now, sink));
+    EXPECT_TRUE(connection.Send(UdpChannel::ReliableOrdered, big.data(), big.size(), now, sink));   // 3 fragments
+    EXPECT_EQ(datagrams, 3u);
+    EXPECT_FALSE(connection.Send(UdpChannel::ReliableOrdered, big.data(), big.size(), now, sink));  // Would exceed 4
+}
+
+// [SEQUENCE: MVP19-413] A peer that never acks fails the connection after max_transmissions sends of a fragment;
+// Update reports it and the connection stops sending.
+TEST(UdpReliabilityTest, UpdateReportsFailedConnection) {
+    UdpChannelState state;
+    UdpReliabilityConfig config;
+    config.max_transmissions = 4;
+    UdpReliableConnection connection(state, 1, config);
+    size_t datagrams = 0;
+    auto sink = [&](const std::byte*, size_t) { ++datagrams; };
+    auto now = Clock::now();
+
+    const auto message = MakeMessage(0, 100);
+    ASSERT_TRUE(connection.Send(UdpChannel::ReliableOrdered, message.data(), message.size(), now, sink));
+    bool alive = true;
+    for (int step = 0; step < 200 && alive; ++step) {
+        now += std::chrono::milliseconds(50);
+        alive = connection.Update(now, sink);
+    }
+    EXPECT_FALSE(alive);
+    EXPECT_TRUE(connection.HasFailed());
+    EXPECT_EQ(datagrams, 4u);
+
+    now += std::chrono::seconds(5);
+    EXPECT_FALSE(connection.Update(now, sink));
+    EXPECT_FALSE(connection.Send(UdpChannel::ReliableOrdered, message.data(), message.size(), now, sink));
+    EXPECT_EQ(datagrams, 4u);
+}
+
+// [SEQUENCE: MVP19-441] With more messages queued than the receiver's reassembly window, under loss, the sender
+// holds the excess back until acks move the window, so every message still arrives once and in order.
+TEST(UdpReliabilityTest, MoreMessagesThanReassemblyWindowSurviveLoss) {
+    UdpLinkConditions conditions;
+    conditions.loss_rate = 0.2;
+    conditions.latency = std::chrono::milliseconds(30);
+    conditions.jitter = std::chrono::milliseconds(10);
+    LinkedPeers peers(conditions);
+
+    std::vector<std::vector<std::byte>> sent;
+    for (size_t i = 0; i < 600; ++i) sent.push_back(MakeMessage(i, 24 + i % 50));
+    size_t next = 0;
+    size_t refused = 0;
+    for (int step = 0; step < 8000 && peers.b_received.size() < sent.size(); ++step) {
+        while (next < sent.size()) {
+            if (!peers.TrySendFromA(UdpChannel::ReliableOrdered, sent[next])) {
+                ++refused;
+                break;
+            }
+            ++next;
+        }
+        peers.Step(std::chrono::milliseconds(5));
+    }
+
+    EXPECT_GT(refused, 0u);
+    ASSERT_EQ(peers.b_received.size(), sent.size());
+    for (size_t i = 0; i < sent.size(); ++i) {
+        EXPECT_EQ(peers.b_received[i].bytes, sent[i]) << "message " << i;
+    }
+    EXPECT_FALSE(peers.a.GetStats().failed);
+}